@@ -93,6 +93,7 @@ Assembler::Assembler(Runtime* runtime) noexcept
     _errorHandler(nullptr),
     _arch(kArchNone),
     _regSize(0),
+    _fixedBuffer(0),
     _reserved(0),
     _asmOptions(0),
     _instOptions(0),
@@ -103,11 +104,19 @@ Assembler::Assembler(Runtime* runtime) noexcept
     _buffer(nullptr),
     _end(nullptr),
     _cursor(nullptr),
+    _chunk(nullptr),
     _trampolinesSize(0),
+    _sectionId(kSectionDefault),
     _comment(nullptr),
-    _unusedLinks(nullptr),
-    _labels(),
-    _relocations() {}
+    _unusedLinks(kInvalidValue),
+    _checkpointDepth(0),
+    _labelOffsets(),
+    _labelLinkHeads(),
+    _labelSections(),
+    _labelExData(),
+    _labelLinks(),
+    _relocations(),
+    _undoLog() {}
 
 Assembler::~Assembler() noexcept {
   reset(true);
@@ -116,17 +125,97 @@ Assembler::~Assembler() noexcept {
     _errorHandler->release();
 }
 
+// ============================================================================
+// [asmjit::Assembler - Chunks]
+// ============================================================================
+
+//! \internal
+//!
+//! Minimum size of a chunk allocated by `Assembler::_growChunk()`.
+static const size_t kAssemblerChunkMinSize = 65536;
+
+//! \internal
+//!
+//! Copy `length` bytes of all chunks (ending with `last`) to `dst`.
+static void Assembler_copyChunks(const CodeChunk* last, uint8_t* dst, size_t length) noexcept {
+  for (const CodeChunk* chunk = last; chunk != nullptr; chunk = chunk->prev) {
+    size_t chunkLength = (chunk == last) ? length - chunk->offset : chunk->length;
+    ::memcpy(dst + chunk->offset, chunk->data, chunkLength);
+  }
+}
+
+//! \internal
+//!
+//! Release data of all chunks (ending with `last`). If `keepFirst` is true
+//! the first chunk is not released and returned.
+static CodeChunk* Assembler_freeChunks(CodeChunk* last, bool keepFirst) noexcept {
+  CodeChunk* chunk = last;
+
+  while (chunk != nullptr) {
+    CodeChunk* prev = chunk->prev;
+    if (prev == nullptr && keepFirst)
+      return chunk;
+
+    ASMJIT_FREE(chunk->data);
+    chunk = prev;
+  }
+
+  return nullptr;
+}
+
 // ============================================================================
 // [asmjit::Assembler - Reset]
 // ============================================================================
 
 void Assembler::reset(bool releaseMemory) noexcept {
+  // The fixed code-buffer is owned by the caller.
+  if (_fixedBuffer) {
+    _buffer = nullptr;
+    _end = nullptr;
+    _fixedBuffer = 0;
+  }
+
   _asmOptions = 0;
   _instOptions = 0;
   _lastError = kErrorOk;
   _exIdGenerator = 0;
   _exCountAttached = 0;
 
+  // Sections other than the default one own their buffers, which have to be
+  // released as the sections are allocated by the zone allocator.
+  size_t sectionsCount = _sections.getLength();
+  CodeChunk* textChunk = _chunk;
+
+  if (sectionsCount != 0) {
+    for (size_t i = 1; i < sectionsCount; i++) {
+      Section* section = _sections[i];
+
+      uint8_t* data = (i == _sectionId) ? _buffer : section->content.data;
+      CodeChunk* chunk = (i == _sectionId) ? _chunk : section->chunk;
+
+      if (chunk != nullptr)
+        Assembler_freeChunks(chunk, false);
+      else if (data != nullptr)
+        ASMJIT_FREE(data);
+    }
+
+    if (_sectionId != kSectionDefault) {
+      Section* text = _sections[kSectionDefault];
+      _buffer = text->content.data;
+      _end = _buffer + text->content.capacity;
+      _sectionId = kSectionDefault;
+      textChunk = text->chunk;
+    }
+  }
+
+  // Only the first chunk is kept, it becomes a regular code-buffer.
+  if (textChunk != nullptr) {
+    CodeChunk* first = Assembler_freeChunks(textChunk, true);
+    _buffer = first->data;
+    _end = _buffer + first->capacity;
+    _chunk = nullptr;
+  }
+
   _zoneAllocator.reset(releaseMemory);
 
   if (releaseMemory && _buffer != nullptr) {
@@ -139,11 +228,17 @@ void Assembler::reset(bool releaseMemory) noexcept {
   _trampolinesSize = 0;
 
   _comment = nullptr;
-  _unusedLinks = nullptr;
+  _unusedLinks = kInvalidValue;
+  _checkpointDepth = 0;
 
   _sections.reset(releaseMemory);
-  _labels.reset(releaseMemory);
+  _labelOffsets.reset(releaseMemory);
+  _labelLinkHeads.reset(releaseMemory);
+  _labelSections.reset(releaseMemory);
+  _labelExData.reset(releaseMemory);
+  _labelLinks.reset(releaseMemory);
   _relocations.reset(releaseMemory);
+  _undoLog.reset(releaseMemory);
 }
 
 // ============================================================================
@@ -201,7 +296,36 @@ Error Assembler::setErrorHandler(ErrorHandler* handler) noexcept {
 // [asmjit::Assembler - Buffer]
 // ============================================================================
 
+//! \internal
+//!
+//! Count of labels reserved by `Assembler::setFixedBuffer()`.
+static const size_t kAssemblerFixedLabelCount = 16;
+
+//! \internal
+//!
+//! Count of label links reserved by `Assembler::setFixedBuffer()`.
+static const size_t kAssemblerFixedLinkCount = 16;
+
+//! \internal
+//!
+//! Count of relocations reserved by `Assembler::setFixedBuffer()`.
+static const size_t kAssemblerFixedRelocCount = 8;
+
+//! \internal
+//!
+//! Count of undo records reserved by `Assembler::setFixedBuffer()`.
+static const size_t kAssemblerFixedUndoCount = 8;
+
 Error Assembler::_grow(size_t n) noexcept {
+  if (_fixedBuffer) {
+    if (getRemainingSpace() < n)
+      return setLastError(kErrorCodeTooLarge);
+    return kErrorOk;
+  }
+
+  if (hasAsmOption(kOptionChunkedBuffer))
+    return _growChunk(n);
+
   size_t capacity = getCapacity();
   size_t after = getOffset() + n;
 
@@ -241,6 +365,18 @@ Error Assembler::_reserve(size_t n) noexcept {
   if (n <= capacity)
     return kErrorOk;
 
+  if (_fixedBuffer)
+    return setLastError(kErrorCodeTooLarge);
+
+  // Chunks are never reallocated.
+  if (_chunk != nullptr) {
+    size_t offset = getOffset();
+    if (n <= offset)
+      return kErrorOk;
+
+    return _growChunk(n - offset);
+  }
+
   uint8_t* newBuffer;
   if (_buffer == nullptr)
     newBuffer = static_cast<uint8_t*>(ASMJIT_ALLOC(n));
@@ -259,56 +395,216 @@ Error Assembler::_reserve(size_t n) noexcept {
   return kErrorOk;
 }
 
+Error Assembler::_growChunk(size_t n) noexcept {
+  size_t offset = getOffset();
+
+  // Turn the current code-buffer into the first chunk, if not done yet.
+  CodeChunk* last = _chunk;
+  if (last == nullptr && _buffer != nullptr) {
+    last = _zoneAllocator.allocT<CodeChunk>();
+    if (last == nullptr)
+      return setLastError(kErrorNoHeapMemory);
+
+    last->prev = nullptr;
+    last->data = _buffer;
+    last->offset = 0;
+    last->length = 0;
+    last->capacity = getCapacity();
+  }
+
+  // Each chunk is at least as large as the code emitted so far (up to the grow
+  // threshold), so the number of chunks grows logarithmically.
+  size_t capacity = Utils::iMin<size_t>(Utils::iMax<size_t>(offset, kAssemblerChunkMinSize), kMemAllocGrowMax);
+  capacity = Utils::iMax<size_t>(capacity - kMemAllocOverhead, n);
+
+  CodeChunk* chunk = _zoneAllocator.allocT<CodeChunk>();
+  uint8_t* data = static_cast<uint8_t*>(ASMJIT_ALLOC(capacity));
+
+  if (chunk == nullptr || data == nullptr) {
+    if (data != nullptr)
+      ASMJIT_FREE(data);
+    return setLastError(kErrorNoHeapMemory);
+  }
+
+  if (last != nullptr)
+    last->length = offset - last->offset;
+
+  chunk->prev = last;
+  chunk->data = data;
+  chunk->offset = offset;
+  chunk->length = 0;
+  chunk->capacity = capacity;
+
+  _chunk = chunk;
+  _buffer = reinterpret_cast<uint8_t*>((uintptr_t)data - offset);
+  _end = data + capacity;
+  _cursor = data;
+
+  return kErrorOk;
+}
+
+Error Assembler::_flatten() noexcept {
+  CodeChunk* last = _chunk;
+  if (last == nullptr)
+    return kErrorOk;
+
+  size_t length = getOffset();
+  size_t capacity = length + getRemainingSpace();
+
+  uint8_t* data = static_cast<uint8_t*>(ASMJIT_ALLOC(capacity));
+  if (data == nullptr)
+    return setLastError(kErrorNoHeapMemory);
+
+  Assembler_copyChunks(last, data, length);
+  Assembler_freeChunks(last, false);
+
+  _chunk = nullptr;
+  _buffer = data;
+  _end = data + capacity;
+  _cursor = data + length;
+
+  return kErrorOk;
+}
+
+static size_t Assembler_getBufferSize(const uint8_t* data, size_t capacity, const CodeChunk* chunk) noexcept {
+  if (chunk == nullptr)
+    return data != nullptr ? capacity : size_t(0);
+
+  size_t size = 0;
+  do {
+    size += chunk->capacity;
+    chunk = chunk->prev;
+  } while (chunk != nullptr);
+  return size;
+}
+
+size_t Assembler::getMemorySize() const noexcept {
+  size_t size = _zoneAllocator.getMemorySize();
+
+  if (!_fixedBuffer)
+    size += Assembler_getBufferSize(_buffer, getCapacity(), _chunk);
+
+  size_t sectionsCount = _sections.getLength();
+  for (size_t i = 0; i < sectionsCount; i++) {
+    const Section* section = _sections[i];
+    if (i != _sectionId)
+      size += Assembler_getBufferSize(section->content.data, section->content.capacity, section->chunk);
+  }
+
+  size += _sections.getHeapSize();
+  size += _labelOffsets.getHeapSize();
+  size += _labelLinkHeads.getHeapSize();
+  size += _labelSections.getHeapSize();
+  size += _labelExData.getHeapSize();
+  size += _labelLinks.getHeapSize();
+  size += _relocations.getHeapSize();
+  size += _undoLog.getHeapSize();
+
+  return size;
+}
+
+Error Assembler::setFixedBuffer(void* buffer, size_t capacity) noexcept {
+  if (buffer == nullptr)
+    return setLastError(kErrorInvalidArgument);
+
+  if (getOffset() != 0 || _chunk != nullptr || _sections.getLength() != 0 ||
+      hasAsmOption(kOptionChunkedBuffer | kOptionRelaxBranches))
+    return setLastError(kErrorInvalidState);
+
+  // Arrays are reserved here, so only assemblers that use a fixed buffer pay
+  // for them and nothing is allocated while emitting.
+  if (_labelOffsets._reserve(kAssemblerFixedLabelCount) != kErrorOk ||
+      _labelLinkHeads._reserve(kAssemblerFixedLabelCount) != kErrorOk ||
+      _labelSections._reserve(kAssemblerFixedLabelCount) != kErrorOk ||
+      _labelExData._reserve(kAssemblerFixedLabelCount) != kErrorOk ||
+      _labelLinks._reserve(kAssemblerFixedLinkCount) != kErrorOk ||
+      _relocations._reserve(kAssemblerFixedRelocCount) != kErrorOk ||
+      _undoLog._reserve(kAssemblerFixedUndoCount) != kErrorOk) {
+    return setLastError(kErrorNoHeapMemory);
+  }
+
+  if (_buffer != nullptr && !_fixedBuffer)
+    ASMJIT_FREE(_buffer);
+
+  _buffer = static_cast<uint8_t*>(buffer);
+  _end = _buffer + capacity;
+  _cursor = _buffer;
+  _fixedBuffer = 1;
+
+  return kErrorOk;
+}
+
+uint8_t* Assembler::_getChunkPtrAt(size_t pos) const noexcept {
+  const CodeChunk* chunk = _chunk;
+  while (pos < chunk->offset) {
+    chunk = chunk->prev;
+    ASMJIT_ASSERT(chunk != nullptr);
+  }
+  return chunk->data + (pos - chunk->offset);
+}
+
 // ============================================================================
 // [asmjit::Assembler - Label]
 // ============================================================================
 
 Error Assembler::_newLabelId() noexcept {
-  LabelData* data = _zoneAllocator.allocT<LabelData>();
+  size_t index = _labelOffsets.getLength();
 
-  data->offset = -1;
-  data->links = nullptr;
-  data->exId = 0;
-  data->exData = nullptr;
+  // All label arrays have the same length, only the first one that fails to
+  // grow has to be handled.
+  LabelExData exData;
+  exData.exId = 0;
+  exData.exData = nullptr;
 
-  uint32_t id = OperandUtil::makeLabelId(static_cast<uint32_t>(_labels.getLength()));
-  Error error = _labels.append(data);
+  Error error = _append<intptr_t>(_labelOffsets, -1);
+  if (error == kErrorOk) error = _append<uint32_t>(_labelLinkHeads, kInvalidValue);
+  if (error == kErrorOk) error = _append<uint32_t>(_labelSections, kSectionDefault);
+  if (error == kErrorOk) error = _append<LabelExData>(_labelExData, exData);
 
   if (error != kErrorOk) {
-    setLastError(kErrorNoHeapMemory);
+    _labelOffsets.truncate(index);
+    _labelLinkHeads.truncate(index);
+    _labelSections.truncate(index);
+
+    setLastError(error);
     return kInvalidValue;
   }
 
-  return id;
+  return OperandUtil::makeLabelId(static_cast<uint32_t>(index));
 }
 
-LabelLink* Assembler::_newLabelLink() noexcept {
-  LabelLink* link = _unusedLinks;
+uint32_t Assembler::_newLabelLink() noexcept {
+  uint32_t index = _unusedLinks;
 
-  if (link) {
-    _unusedLinks = link->prev;
+  // Links are not reused while a checkpoint is active, see `rollback()`.
+  if (index != kInvalidValue && _checkpointDepth == 0) {
+    _unusedLinks = _labelLinks[index].prev;
   }
   else {
-    link = _zoneAllocator.allocT<LabelLink>();
-    if (link == nullptr)
-      return nullptr;
+    index = static_cast<uint32_t>(_labelLinks.getLength());
+
+    LabelLink dummy;
+    if (_append(_labelLinks, dummy) != kErrorOk)
+      return kInvalidValue;
   }
 
-  link->prev = nullptr;
-  link->offset = 0;
-  link->displacement = 0;
-  link->relocId = -1;
+  LabelLink& link = _labelLinks[index];
+  link.offset = 0;
+  link.displacement = 0;
+  link.relocId = -1;
+  link.sectionId = _sectionId;
+  link.prev = kInvalidValue;
 
-  return link;
+  return index;
 }
 
 Error Assembler::bind(const Label& label) noexcept {
   // Get label data based on label id.
   uint32_t index = label.getId();
-  LabelData* data = getLabelData(index);
+  ASMJIT_ASSERT(isLabelValid(index));
 
   // Label can be bound only once.
-  if (data->offset != -1)
+  if (_labelOffsets[index] != -1)
     return setLastError(kErrorLabelAlreadyBound);
 
 #if !defined(ASMJIT_DISABLE_LOGGER)
@@ -328,16 +624,52 @@ Error Assembler::bind(const Label& label) noexcept {
   Error error = kErrorOk;
   size_t pos = getOffset();
 
-  LabelLink* link = data->links;
-  LabelLink* prev = nullptr;
+  LabelLink* links = _labelLinks.getData();
+  uint32_t linkIndex = _labelLinkHeads[index];
+  uint32_t crossLinks = kInvalidValue;
+
+  // Everything the loop below changes has to be recorded if a checkpoint is
+  // active, the space is reserved first so recording can't fail.
+  bool recordUndo = _checkpointDepth != 0;
+  if (recordUndo) {
+    size_t n = 1;
+    for (uint32_t i = linkIndex; i != kInvalidValue; i = links[i].prev)
+      n++;
+
+    if (_fixedBuffer && _undoLog.getCapacity() - _undoLog.getLength() < n)
+      return setLastError(kErrorCodeTooLarge);
+
+    if (_undoLog._grow(n) != kErrorOk)
+      return setLastError(kErrorNoHeapMemory);
+    _addUndoRecord(kUndoBind, index, linkIndex, _labelSections[index], 0);
+  }
 
-  while (link) {
+  while (linkIndex != kInvalidValue) {
+    LabelLink* link = &links[linkIndex];
+    uint32_t next = link->prev;
     intptr_t offset = link->offset;
 
     if (link->relocId != -1) {
       // Handle RelocData - We have to update RelocData information instead of
-      // patching the displacement in LabelData.
-      _relocations[link->relocId].data += static_cast<Ptr>(pos);
+      // patching the displacement in the code.
+      RelocData& rd = _relocations[link->relocId];
+      if (recordUndo)
+        _addUndoRecord(kUndoReloc, static_cast<uint32_t>(link->relocId), rd.dataSection, 0, rd.data);
+
+      rd.data += static_cast<Ptr>(pos);
+      rd.dataSection = _sectionId;
+    }
+    else if (link->sectionId != _sectionId) {
+      // The displacement is in another section, keep the link so it can be
+      // patched by `relocCode()` when addresses of both sections are known.
+      if (recordUndo)
+        _addUndoRecord(kUndoLinkPrev, linkIndex, link->prev, 0, 0);
+
+      link->prev = crossLinks;
+      crossLinks = linkIndex;
+
+      linkIndex = next;
+      continue;
     }
     else {
       // Not using relocId, this means that we are overwriting a real
@@ -349,35 +681,32 @@ Error Assembler::bind(const Label& label) noexcept {
       uint32_t size = readU8At(offset);
       ASMJIT_ASSERT(size == 1 || size == 4);
 
+      if (recordUndo)
+        _addUndoRecord(kUndoPatch, _sectionId, size == 4 ? readU32At(offset) : size, size, static_cast<uint64_t>(offset));
+
       if (size == 4) {
         writeI32At(offset, patchedValue);
       }
       else {
         ASMJIT_ASSERT(size == 1);
+        // Short jumps that don't fit are enlarged by `relax()`.
         if (Utils::isInt8(patchedValue))
           writeU8At(offset, static_cast<uint32_t>(patchedValue) & 0xFF);
-        else
+        else if (!hasAsmOption(kOptionRelaxBranches))
           error = kErrorIllegalDisplacement;
       }
     }
 
-    prev = link->prev;
-    link = prev;
-  }
-
-  // Chain unused links.
-  link = data->links;
-  if (link) {
-    if (prev == nullptr)
-      prev = link;
+    // Chain unused link.
+    _releaseLabelLink(linkIndex);
 
-    prev->prev = _unusedLinks;
-    _unusedLinks = link;
+    linkIndex = next;
   }
 
-  // Set as bound (offset is zero or greater and no links).
-  data->offset = pos;
-  data->links = nullptr;
+  // Set as bound (offset is zero or greater and only cross-section links).
+  _labelOffsets[index] = pos;
+  _labelLinkHeads[index] = crossLinks;
+  _labelSections[index] = _sectionId;
 
   if (error != kErrorOk)
     return setLastError(error);
@@ -386,6 +715,325 @@ Error Assembler::bind(const Label& label) noexcept {
   return error;
 }
 
+// ============================================================================
+// [asmjit::Assembler - Section]
+// ============================================================================
+
+static Assembler::Section* Assembler_newSection(Zone* zone, uint32_t id, const char* name, uint32_t flags, uint32_t alignment) noexcept {
+  Assembler::Section* section = zone->allocT<Assembler::Section>();
+  if (section == nullptr)
+    return nullptr;
+
+  size_t nameLength = name ? Utils::iMin<size_t>(::strlen(name), ASMJIT_ARRAY_SIZE(section->name) - 1) : size_t(0);
+
+  section->id = id;
+  section->flags = flags;
+  ::memcpy(section->name, name, nameLength);
+  section->name[nameLength] = '\0';
+  section->alignment = alignment;
+  section->trampolinesSize = 0;
+  section->chunk = nullptr;
+
+  section->content.data = nullptr;
+  section->content.capacity = 0;
+  section->content.length = 0;
+  section->content.offset = 0;
+
+  return section;
+}
+
+size_t Assembler::getSectionSize(uint32_t id) const noexcept {
+  if (_sections.getLength() == 0)
+    return getOffset() + getTrampolinesSize();
+  else
+    return getSectionLength(id) + _sections[id]->trampolinesSize;
+}
+
+uint32_t Assembler::newSection(const char* name, uint32_t flags, uint32_t alignment) noexcept {
+  if (alignment > 1 && !Utils::isPowerOf2(alignment)) {
+    setLastError(kErrorInvalidArgument);
+    return kInvalidValue;
+  }
+
+  // Sections are never removed, so they can't be created speculatively, and
+  // they require memory, which is not allocated if the code-buffer is fixed.
+  if (_checkpointDepth != 0 || _fixedBuffer) {
+    setLastError(kErrorInvalidState);
+    return kInvalidValue;
+  }
+
+  // The default section is created on-demand so the assembler doesn't have
+  // to maintain any section if only one is used.
+  if (_sections.getLength() == 0) {
+    Section* text = Assembler_newSection(&_zoneAllocator, kSectionDefault, ".text", kSectionFlagExec, 0);
+    if (text == nullptr || _sections.append(text) != kErrorOk) {
+      setLastError(kErrorNoHeapMemory);
+      return kInvalidValue;
+    }
+    text->trampolinesSize = _trampolinesSize;
+  }
+
+  uint32_t id = static_cast<uint32_t>(_sections.getLength());
+  Section* section = Assembler_newSection(&_zoneAllocator, id, name, flags, alignment);
+
+  if (section == nullptr || _sections.append(section) != kErrorOk) {
+    setLastError(kErrorNoHeapMemory);
+    return kInvalidValue;
+  }
+
+  return id;
+}
+
+Error Assembler::section(uint32_t id) noexcept {
+  if (id >= getSectionsCount())
+    return setLastError(kErrorInvalidArgument);
+
+  if (id == _sectionId)
+    return kErrorOk;
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  if (_logger)
+    _logger->logFormat(Logger::kStyleDirective, ".section %s\n", _sections[id]->name);
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  if (_checkpointDepth != 0) {
+    Section* section = _sections[id];
+    Error error = _addUndoRecord(kUndoSection, id, section->trampolinesSize, 0, section->content.length);
+
+    if (error != kErrorOk)
+      return setLastError(error);
+  }
+
+  _switchSection(id);
+  return kErrorOk;
+}
+
+void Assembler::_switchSection(uint32_t id) noexcept {
+  if (id == _sectionId)
+    return;
+
+  Section* cur = _sections[_sectionId];
+  Section* section = _sections[id];
+
+  cur->chunk = _chunk;
+  cur->content.data = _buffer;
+  cur->content.capacity = getCapacity();
+  cur->content.length = getOffset();
+  cur->content.offset = getOffset();
+
+  _buffer = section->content.data;
+  _end = _buffer + section->content.capacity;
+  _cursor = _buffer + section->content.length;
+  _chunk = section->chunk;
+  _sectionId = id;
+}
+
+void Assembler::_copySectionData(uint32_t id, uint8_t* dst) const noexcept {
+  size_t length = getSectionLength(id);
+
+  const uint8_t* data = _buffer;
+  const CodeChunk* chunk = _chunk;
+
+  if (id != _sectionId) {
+    data = _sections[id]->content.data;
+    chunk = _sections[id]->chunk;
+  }
+
+  // The fixed code-buffer can be relocated in place.
+  if (chunk != nullptr)
+    Assembler_copyChunks(chunk, dst, length);
+  else if (dst != data && length != 0)
+    ::memcpy(dst, data, length);
+}
+
+size_t Assembler::_layoutSections(Ptr* offsets) const noexcept {
+  size_t count = getSectionsCount();
+  size_t offset = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    uint32_t alignment = i ? _sections[i]->alignment : uint32_t(0);
+    if (alignment > 1)
+      offset = Utils::alignTo<size_t>(offset, alignment);
+
+    if (offsets != nullptr)
+      offsets[i] = static_cast<Ptr>(offset);
+    offset += getSectionSize(static_cast<uint32_t>(i));
+  }
+
+  return offset;
+}
+
+// ============================================================================
+// [asmjit::Assembler - Checkpoint]
+// ============================================================================
+
+Error Assembler::checkpoint(Checkpoint& cp) noexcept {
+  uint32_t sectionId = _sectionId;
+
+  cp.depth = ++_checkpointDepth;
+  cp.sectionId = sectionId;
+  cp.offset = getOffset();
+  cp.trampolinesSize = _trampolinesSize;
+  cp.sectionTrampolinesSize = _sections.getLength() ? _sections[sectionId]->trampolinesSize : uint32_t(0);
+  cp.labelCount = _labelOffsets.getLength();
+  cp.linkCount = _labelLinks.getLength();
+  cp.relocCount = _relocations.getLength();
+  cp.undoCount = _undoLog.getLength();
+  cp.lastError = _lastError;
+  cp.instOptions = _instOptions;
+  cp.comment = _comment;
+  cp.archData[0] = 0;
+  cp.archData[1] = 0;
+
+  return kErrorOk;
+}
+
+Error Assembler::rollback(const Checkpoint& cp) noexcept {
+  if (cp.depth == 0 || cp.depth != _checkpointDepth)
+    return setLastError(kErrorInvalidState);
+
+  // Undo changes of the state that existed before the checkpoint in reverse
+  // order. Everything created after the checkpoint is still valid here and
+  // discarded afterwards.
+  const UndoRecord* records = _undoLog.getData();
+  size_t i = _undoLog.getLength();
+
+  while (i > cp.undoCount) {
+    const UndoRecord& record = records[--i];
+
+    switch (record.type) {
+      case kUndoLinkHead:
+        _labelLinkHeads[record.id] = record.a;
+        break;
+
+      case kUndoLinkPrev:
+        _labelLinks[record.id].prev = record.a;
+        break;
+
+      case kUndoBind:
+        _labelOffsets[record.id] = -1;
+        _labelLinkHeads[record.id] = record.a;
+        _labelSections[record.id] = record.b;
+        break;
+
+      case kUndoPatch: {
+        size_t offset = static_cast<size_t>(record.value);
+        _switchSection(record.id);
+
+        if (record.size == 4)
+          writeU32At(offset, record.a);
+        else
+          writeU8At(offset, record.a);
+        break;
+      }
+
+      case kUndoReloc: {
+        RelocData& rd = _relocations[record.id];
+        rd.data = static_cast<Ptr>(record.value);
+        rd.dataSection = record.a;
+        break;
+      }
+
+      case kUndoSection:
+        _switchSection(record.id);
+        _truncate(static_cast<size_t>(record.value));
+        _sections[record.id]->trampolinesSize = record.a;
+        break;
+    }
+  }
+
+  _switchSection(cp.sectionId);
+  _truncate(cp.offset);
+
+  if (_sections.getLength() != 0)
+    _sections[cp.sectionId]->trampolinesSize = cp.sectionTrampolinesSize;
+  _trampolinesSize = cp.trampolinesSize;
+
+  // Links created after the checkpoint are only referenced by chains that
+  // were restored above, links are neither reused nor released while a
+  // checkpoint is active, so the chain of unused links is unchanged.
+  _labelOffsets.truncate(cp.labelCount);
+  _labelLinkHeads.truncate(cp.labelCount);
+  _labelSections.truncate(cp.labelCount);
+  _labelExData.truncate(cp.labelCount);
+  _labelLinks.truncate(cp.linkCount);
+  _relocations.truncate(cp.relocCount);
+  _undoLog.truncate(cp.undoCount);
+
+  _lastError = cp.lastError;
+  _instOptions = cp.instOptions;
+  _comment = cp.comment;
+  _checkpointDepth--;
+
+  return kErrorOk;
+}
+
+Error Assembler::commit(const Checkpoint& cp) noexcept {
+  if (cp.depth == 0 || cp.depth != _checkpointDepth)
+    return setLastError(kErrorInvalidState);
+
+  // Records are kept for the enclosing checkpoint, if any.
+  if (--_checkpointDepth != 0)
+    return kErrorOk;
+
+  // Links of labels bound while checkpoints were active can be reused now.
+  // Links of labels that kept cross-section links are not released, their
+  // chains were rewritten by `bind()`.
+  const UndoRecord* records = _undoLog.getData();
+  size_t count = _undoLog.getLength();
+
+  for (size_t i = 0; i < count; i++) {
+    const UndoRecord& record = records[i];
+    if (record.type != kUndoBind || _labelLinkHeads[record.id] != kInvalidValue)
+      continue;
+
+    uint32_t linkIndex = record.a;
+    while (linkIndex != kInvalidValue) {
+      uint32_t next = _labelLinks[linkIndex].prev;
+      _releaseLabelLink(linkIndex);
+      linkIndex = next;
+    }
+  }
+
+  _undoLog.truncate(0);
+  return kErrorOk;
+}
+
+Error Assembler::_addUndoRecord(uint32_t type, uint32_t id, uint32_t a, uint32_t b, uint64_t value) noexcept {
+  UndoRecord record;
+  record.type = static_cast<uint8_t>(type);
+  record.size = static_cast<uint8_t>(type == kUndoPatch ? b : uint32_t(0));
+  record.reserved = 0;
+  record.id = id;
+  record.a = a;
+  record.b = b;
+  record.value = value;
+
+  return _append(_undoLog, record);
+}
+
+void Assembler::_truncate(size_t offset) noexcept {
+  ASMJIT_ASSERT(offset <= getOffset());
+  CodeChunk* chunk = _chunk;
+
+  if (chunk == nullptr) {
+    _cursor = _buffer + offset;
+    return;
+  }
+
+  while (chunk->offset > offset) {
+    CodeChunk* prev = chunk->prev;
+    ASMJIT_FREE(chunk->data);
+    chunk = prev;
+  }
+
+  _chunk = chunk;
+  _buffer = reinterpret_cast<uint8_t*>((uintptr_t)chunk->data - chunk->offset);
+  _end = chunk->data + chunk->capacity;
+
+  _cursor = _buffer + offset;
+}
+
 // ============================================================================
 // [asmjit::Assembler - Embed]
 // ============================================================================
@@ -409,6 +1057,15 @@ Error Assembler::embed(const void* data, uint32_t size) noexcept {
   return kErrorOk;
 }
 
+// ============================================================================
+// [asmjit::Assembler - Relax]
+// ============================================================================
+
+Error Assembler::relax() noexcept {
+  // Nothing to relax by default, handled by architecture specific assemblers.
+  return kErrorOk;
+}
+
 // ============================================================================
 // [asmjit::Assembler - Reloc]
 // ============================================================================
@@ -416,7 +1073,46 @@ Error Assembler::embed(const void* data, uint32_t size) noexcept {
 size_t Assembler::relocCode(void* dst, Ptr baseAddress) const noexcept {
   if (baseAddress == kNoBaseAddress)
     baseAddress = static_cast<Ptr>((uintptr_t)dst);
-  return _relocCode(dst, baseAddress);
+
+  size_t count = _sections.getLength();
+  if (ASMJIT_LIKELY(count == 0)) {
+    size_t size = _relocSection(kSectionDefault, dst, &baseAddress);
+    return size != kInvalidIndex ? size : size_t(0);
+  }
+
+  Ptr* baseAddresses = static_cast<Ptr*>(ASMJIT_ALLOC(count * sizeof(Ptr)));
+  if (baseAddresses == nullptr)
+    return 0;
+
+  _layoutSections(baseAddresses);
+  for (size_t i = 0; i < count; i++)
+    baseAddresses[i] += baseAddress;
+
+  uint8_t* p = static_cast<uint8_t*>(dst);
+  size_t size = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    size_t offset = static_cast<size_t>(baseAddresses[i] - baseAddress);
+
+    // Zero the alignment gap and unused trampolines of the previous section.
+    ::memset(p + size, 0, offset - size);
+
+    size_t sectionSize = _relocSection(static_cast<uint32_t>(i), p + offset, baseAddresses);
+    if (sectionSize == kInvalidIndex) {
+      size = 0;
+      break;
+    }
+
+    size = offset + sectionSize;
+  }
+
+  ASMJIT_FREE(baseAddresses);
+  return size;
+}
+
+size_t Assembler::relocSection(uint32_t id, void* dst, const Ptr* baseAddresses) const noexcept {
+  ASMJIT_ASSERT(id < getSectionsCount());
+  return _relocSection(id, dst, baseAddresses);
 }
 
 // ============================================================================
@@ -428,6 +1124,9 @@ void* Assembler::make() noexcept {
   if (_lastError != kErrorOk || getCodeSize() == 0)
     return nullptr;
 
+  if (hasAsmOption(kOptionRelaxBranches) && relax() != kErrorOk)
+    return nullptr;
+
   void* p;
   Error error = _runtime->add(&p, this);
 
@@ -497,6 +1196,21 @@ Error Assembler::emit(uint32_t code, const Operand& o0, const Operand& o1, const
 
 #undef NA
 
+// ============================================================================
+// [asmjit::Assembler - Emit (Batch)]
+// ============================================================================
+
+Error Assembler::_emitBatch(const InstRecord* records, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const InstRecord& record = records[i];
+
+    _instOptions = record.options;
+    ASMJIT_PROPAGATE_ERROR(_emit(record.instId, record.o0, record.o1, record.o2, record.o3));
+  }
+
+  return kErrorOk;
+}
+
 } // asmjit namespace
 
 // [Api-End]
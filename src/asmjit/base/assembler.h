@@ -155,7 +155,30 @@ ASMJIT_ENUM(RelocMode) {
   //! Relocate an absolute address to a relative address.
   kRelocAbsToRel = 2,
   //! Relocate an absolute address to a relative address or use trampoline.
-  kRelocTrampoline = 3
+  kRelocTrampoline = 3,
+  //! Store an absolute address to the global offset table and relocate it to
+  //! a relative address of the table entry (position independent code).
+  kRelocAbsToGot = 4
+};
+
+// ============================================================================
+// [asmjit::CodeChunk]
+// ============================================================================
+
+//! \internal
+//!
+//! Chunk of a code-buffer, used if `Assembler::kOptionChunkedBuffer` is enabled.
+struct CodeChunk {
+  //! Previous chunk.
+  CodeChunk* prev;
+  //! Chunk data.
+  uint8_t* data;
+  //! Offset of the chunk in the code-buffer.
+  size_t offset;
+  //! Number of bytes used (only valid if the chunk is not the last one).
+  size_t length;
+  //! Capacity of `data`.
+  size_t capacity;
 };
 
 // ============================================================================
@@ -165,30 +188,33 @@ ASMJIT_ENUM(RelocMode) {
 //! \internal
 //!
 //! Data structure used to link labels.
+//!
+//! Links are pooled in a single array owned by `Assembler` and chained by
+//! index, unused links are chained the same way and reused.
 struct LabelLink {
-  //! Previous link.
-  LabelLink* prev;
   //! Offset.
   intptr_t offset;
   //! Inlined displacement.
   intptr_t displacement;
   //! RelocId in case the link has to be absolute after relocated.
   intptr_t relocId;
+  //! Section that contains the displacement.
+  uint32_t sectionId;
+  //! Index of the previous link, `kInvalidValue` terminates the chain.
+  uint32_t prev;
 };
 
 // ============================================================================
-// [asmjit::LabelData]
+// [asmjit::LabelExData]
 // ============================================================================
 
 //! \internal
 //!
-//! Label data.
-struct LabelData {
-  //! Label offset.
-  intptr_t offset;
-  //! Label links chain.
-  LabelLink* links;
-
+//! Label data associated by `ExternalTool`.
+//!
+//! Kept apart from offsets, links, and sections of labels, which `Assembler`
+//! accesses while emitting and binding.
+struct LabelExData {
   //! External tool ID, if linked to any.
   uint64_t exId;
   //! Pointer to a data that `ExternalTool` associated with the label.
@@ -211,18 +237,72 @@ struct LabelData {
 //! code we are always using relative addressing model for referencing labels
 //! and embedded data. In 32-bit mode we must patch all references to absolute
 //! address before we can call generated function.
+//!
+//! Relocations are recorded for each call, jump and RIP relative access, so
+//! the record is kept small - sections are never larger than 4GB, thus `from`
+//! is a 32-bit offset.
 struct RelocData {
   //! Type of relocation.
-  uint32_t type;
+  uint8_t type;
   //! Size of relocation (4 or 8 bytes).
-  uint32_t size;
+  uint8_t size;
+  //! \internal
+  uint16_t reserved;
 
-  //! Offset from the initial code address.
-  Ptr from;
+  //! Section that contains `from`.
+  uint32_t fromSection;
+  //! Section that `data` is relative to (`kRelocRelToAbs` only).
+  uint32_t dataSection;
+
+  //! Offset from the start of `fromSection`.
+  uint32_t from;
   //! Relative displacement from the initial code address or from the absolute address.
   Ptr data;
 };
 
+// ============================================================================
+// [asmjit::InstRecord]
+// ============================================================================
+
+//! Instruction record, used by `Assembler::emitBatch()`.
+//!
+//! The record contains everything the assembler needs to encode a single
+//! instruction - instruction id, instruction options (see \ref InstOptions
+//! and architecture specific options), and up to four operands. Unused
+//! operands must be none, which is what the default constructor does.
+struct InstRecord {
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE InstRecord() noexcept
+    : instId(kInstIdNone),
+      options(0) {}
+
+  ASMJIT_INLINE InstRecord(uint32_t instId_,
+    const Operand& o0_ = noOperand, const Operand& o1_ = noOperand,
+    const Operand& o2_ = noOperand, const Operand& o3_ = noOperand,
+    uint32_t options_ = 0) noexcept
+    : instId(instId_),
+      options(options_),
+      o0(o0_),
+      o1(o1_),
+      o2(o2_),
+      o3(o3_) {}
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Instruction id.
+  uint32_t instId;
+  //! Instruction options.
+  uint32_t options;
+
+  //! Operands.
+  Operand o0, o1, o2, o3;
+};
+
 // ============================================================================
 // [asmjit::ErrorHandler]
 // ============================================================================
@@ -430,7 +510,7 @@ class ASMJIT_VIRTAPI Assembler {
     //! for alignment between 1 to 11 bytes. Also when `X86Compiler` is used,
     //! it can add REX prefixes into the code to make some instructions greater
     //! so no alignment sequence is needed.
-    kOptionOptimizedAlign = 0,
+    kOptionOptimizedAlign = 0x00000001,
 
     //! Emit jump-prediction hints (`Assembler` and `Compiler`).
     //!
@@ -449,7 +529,109 @@ class ASMJIT_VIRTAPI Assembler {
     //! This feature is disabled by default, because the only processor that
     //! used to take into consideration prediction hints was P4. Newer processors
     //! implement heuristics for branch prediction that ignores any static hints.
-    kOptionPredictedJumps = 1
+    kOptionPredictedJumps = 0x00000002,
+
+    //! Relax span-dependent instructions before the code is relocated.
+    //!
+    //! Default `false`.
+    //!
+    //! X86/X64 Specific
+    //! ----------------
+    //!
+    //! Jumps to labels that are not bound yet are always emitted in their
+    //! long form (rel32), because the displacement is not known at the time
+    //! the instruction is encoded. If this option is enabled the assembler
+    //! records all jmp/jcc instructions that target a label together with all
+    //! other label-relative displacements and alignment directives. The
+    //! `relax()` function (called automatically by `make()`) then computes a
+    //! fixpoint layout in which every such jump uses the shortest encoding
+    //! (rel8 if possible) and rewrites the code-buffer accordingly.
+    //!
+    //! Jumps that use `kInstOptionLongForm` are never relaxed, jumps that use
+    //! `kInstOptionShortForm` are enlarged if their target doesn't fit into
+    //! rel8 instead of failing with `kErrorIllegalDisplacement`.
+    kOptionRelaxBranches = 0x00000004,
+
+    //! Use a chunked code-buffer.
+    //!
+    //! Default `false`.
+    //!
+    //! The code-buffer is a single block of memory, which is reallocated (and
+    //! copied) each time it's full. If this option is enabled the assembler
+    //! appends a new chunk instead, so the code emitted so far is never moved.
+    //! Chunks are gathered by `relocCode()`. An instruction never crosses a
+    //! chunk boundary, so displacements can be patched as usual.
+    //!
+    //! NOTE: `getBuffer()` doesn't point to a valid memory if the code-buffer
+    //! consists of multiple chunks, use `readXXAt()` and `writeXXAt()` to access
+    //! the code. Branch relaxation gathers all chunks into a single one.
+    kOptionChunkedBuffer = 0x00000008,
+
+    //! Align branches so they don't cross or end on a 32-byte boundary.
+    //!
+    //! Default `false`.
+    //!
+    //! X86/X64 Specific
+    //! ----------------
+    //!
+    //! Mitigates the performance impact of the JCC erratum, which affects
+    //! Skylake derived processors, see `CpuInfo::hasX86JccErratum()`. Each
+    //! jmp, jcc, call and ret that would cross or end on a 32-byte boundary
+    //! is moved to the next boundary by inserting multi-byte NOPs before it.
+    //! If a jcc directly follows an instruction it can be macro-fused with
+    //! (cmp, test, add, sub, and, inc, dec) the padding is inserted before
+    //! the pair, unless that instruction references a label or RIP. The
+    //! padding is recalculated by `relax()` if `kOptionRelaxBranches` is
+    //! enabled.
+    kOptionAlignBranches = 0x00000010,
+
+    //! Use the shortest encoding of each instruction.
+    //!
+    //! Default `false`.
+    //!
+    //! X86/X64 Specific
+    //! ----------------
+    //!
+    //! Operands are rewritten if a shorter encoding has exactly the same
+    //! effect, including flags:
+    //!
+    //!   - 64-bit `mov` of an immediate that fits into uint32, `and` and `test`
+    //!     of an immediate that fits into int32 (positive), `xor` and `sub` of
+    //!     a register with itself and `movzx` use the 32-bit form (no REX.W).
+    //!   - 16-bit and 32-bit arithmetic of an unsigned immediate that is a
+    //!     sign-extended 8-bit value (like `and eax, 0xFFFFFFF0`) uses imm8.
+    //!   - `[rbp + index]` and `[r13 + index]` are encoded as `[index + rbp]`
+    //!     and `[index + r13]` in 64-bit mode, which doesn't need disp8.
+    //!
+    //! Instructions that would change flags differently (`add reg, 1` vs
+    //! `inc` or `lea`) are never rewritten. The count of bytes saved is
+    //! available through `X86Assembler::getBytesSaved()`.
+    kOptionShortestEncoding = 0x00000020,
+
+    //! Generate position independent code.
+    //!
+    //! Default `false`.
+    //!
+    //! Code relocated by `relocCode()` normally contains absolute addresses,
+    //! so it only works at the address it was relocated to. If this option is
+    //! enabled the relocated code doesn't depend on its address and can be
+    //! copied anywhere by `memcpy()` without any fixups, which makes it
+    //! possible to share or cache it.
+    //!
+    //! X86/X64 Specific
+    //! ----------------
+    //!
+    //! 64-bit mode only, the option has no effect in 32-bit mode, which has no
+    //! RIP-relative addressing. Labels are always referenced RIP-relative and
+    //! absolute addresses used by memory operands are encoded as disp32. A
+    //! `jmp` or `call` to an absolute address is emitted as `jmp [rip + disp]`
+    //! or `call [rip + disp]` that reads the target from a global offset table
+    //! (GOT), which is placed after the code of the section and contains each
+    //! target only once. `embedLabel()` fails with `kErrorIllegalAddresing`,
+    //! because the address of a label is not position independent.
+    //!
+    //! The option must be set before anything is emitted.
+    kOptionPositionIndependent = 0x00000040
   };
 
   // --------------------------------------------------------------------------
@@ -472,7 +654,24 @@ class ASMJIT_VIRTAPI Assembler {
   // [Section]
   // --------------------------------------------------------------------------
 
+  //! Section flags.
+  ASMJIT_ENUM(SectionFlags) {
+    //! Section contains executable code.
+    kSectionFlagExec = 0x00000001,
+    //! Section contains read-only data (constants, jump tables).
+    kSectionFlagConst = 0x00000002
+  };
+
+  //! Predefined section ids.
+  ASMJIT_ENUM(SectionId) {
+    //! Default section (`.text`), which always exists.
+    kSectionDefault = 0
+  };
+
   //! Code or data section.
+  //!
+  //! NOTE: The `content` of the current section is only updated when another
+  //! section is selected, use `getSectionLength()` to get its actual length.
   struct Section {
     //! Section id.
     uint32_t id;
@@ -482,10 +681,86 @@ class ASMJIT_VIRTAPI Assembler {
     char name[36];
     //! Section alignment requirements (0 if no requirements).
     uint32_t alignment;
+    //! Size of trampolines (and GOT entries) reserved by the section.
+    uint32_t trampolinesSize;
+    //! Last chunk of the section (chunked code-buffer only).
+    CodeChunk* chunk;
     //! Section content.
     Buffer content;
   };
 
+  //! Assembler state captured by `checkpoint()`.
+  //!
+  //! The checkpoint is valid only until it's passed to `rollback()` or
+  //! `commit()` of the assembler that created it.
+  struct Checkpoint {
+    //! Depth of the checkpoint (1 for the outermost one).
+    uint32_t depth;
+    //! Current section.
+    uint32_t sectionId;
+    //! Offset in the current section.
+    size_t offset;
+    //! Size of all trampolines.
+    uint32_t trampolinesSize;
+    //! Size of trampolines of the current section.
+    uint32_t sectionTrampolinesSize;
+    //! Count of labels.
+    size_t labelCount;
+    //! Count of label links.
+    size_t linkCount;
+    //! Count of relocations.
+    size_t relocCount;
+    //! Length of the undo log.
+    size_t undoCount;
+    //! Last error.
+    uint32_t lastError;
+    //! Instruction options.
+    uint32_t instOptions;
+    //! Inline comment.
+    const char* comment;
+    //! Architecture specific state.
+    size_t archData[2];
+  };
+
+  //! \internal
+  //!
+  //! Type of `UndoRecord`.
+  ASMJIT_ENUM(UndoType) {
+    //! Link head of the label `id` was `a`.
+    kUndoLinkHead = 0,
+    //! Previous link of the link `id` was `a`.
+    kUndoLinkPrev = 1,
+    //! Label `id` was bound, its link head was `a` and its section `b`.
+    kUndoBind = 2,
+    //! `size` bytes at `value` in the section `id` were `a`.
+    kUndoPatch = 3,
+    //! Relocation `id` had data `value` in the section `a`.
+    kUndoReloc = 4,
+    //! Section `id` was entered, its length was `value` and its trampolines
+    //! size `a`.
+    kUndoSection = 5
+  };
+
+  //! \internal
+  //!
+  //! Change of the state that existed before a checkpoint, see `rollback()`.
+  struct UndoRecord {
+    //! Type, see `UndoType`.
+    uint8_t type;
+    //! Size of the patched value (`kUndoPatch`).
+    uint8_t size;
+    //! \internal
+    uint16_t reserved;
+    //! Label, link, relocation, or section id.
+    uint32_t id;
+    //! First value.
+    uint32_t a;
+    //! Second value.
+    uint32_t b;
+    //! Offset, length, or relocation data.
+    uint64_t value;
+  };
+
   // --------------------------------------------------------------------------
   // [Construction / Destruction]
   // --------------------------------------------------------------------------
@@ -502,7 +777,7 @@ class ASMJIT_VIRTAPI Assembler {
   //! Reset the assembler.
   //!
   //! If `releaseMemory` is true all buffers will be released to the system.
-  ASMJIT_API void reset(bool releaseMemory = false) noexcept;
+  ASMJIT_API virtual void reset(bool releaseMemory = false) noexcept;
 
   // --------------------------------------------------------------------------
   // [Runtime]
@@ -638,6 +913,66 @@ class ASMJIT_VIRTAPI Assembler {
   //! Reserve the code-buffer to at least `n` bytes.
   ASMJIT_API Error _reserve(size_t n) noexcept;
 
+  //! Get the number of bytes of memory retained by the assembler - the code
+  //! buffers, zone, and arrays (the result is approximate).
+  ASMJIT_API virtual size_t getMemorySize() const noexcept;
+
+  //! Get whether the code-buffer is fixed, see `setFixedBuffer()`.
+  ASMJIT_INLINE bool isFixedBuffer() const noexcept { return _fixedBuffer != 0; }
+
+  //! Emit to a fixed `buffer` of `capacity` bytes provided by the caller.
+  //!
+  //! The assembler doesn't allocate any memory in this mode. The code-buffer
+  //! never grows and arrays of labels, links, relocations, and undo records
+  //! are reserved by this function (at least 16 labels, 16 unresolved links,
+  //! 8 relocations, and 8 undo records), `kErrorCodeTooLarge` is returned
+  //! instead of growing any of them. Sections, `kOptionChunkedBuffer`, and
+  //! `kOptionRelaxBranches` can't be used.
+  //!
+  //! NOTE: An instruction is encoded only if the code-buffer has space for the
+  //! longest instruction possible, so the buffer should be a bit larger than
+  //! the code. The code can be relocated in place by passing `buffer` to
+  //! `relocCode()`, the buffer must have space for trampolines in such case,
+  //! see `getCodeSize()`.
+  //!
+  //! The assembler must be empty, the code-buffer it owned is released.
+  //! `reset()` detaches the fixed buffer.
+  ASMJIT_API Error setFixedBuffer(void* buffer, size_t capacity) noexcept;
+
+  //! \internal
+  //!
+  //! Append `item` to `vec`, returns `kErrorCodeTooLarge` if `vec` would have
+  //! to grow and the code-buffer is fixed.
+  template<typename T>
+  ASMJIT_INLINE Error _append(PodVector<T>& vec, const T& item) noexcept {
+    if (ASMJIT_UNLIKELY(_fixedBuffer) && vec.getLength() == vec.getCapacity())
+      return kErrorCodeTooLarge;
+    return vec.append(item);
+  }
+
+  //! \internal
+  //!
+  //! Append a new chunk that has at least `n` bytes, see `kOptionChunkedBuffer`.
+  ASMJIT_API Error _growChunk(size_t n) noexcept;
+
+  //! \internal
+  //!
+  //! Gather all chunks of the current section into a single one.
+  ASMJIT_API Error _flatten() noexcept;
+
+  //! \internal
+  //!
+  //! Get a pointer to the code-buffer at `pos`, which can be in any chunk.
+  ASMJIT_INLINE uint8_t* _getPtrAt(size_t pos) const noexcept {
+    if (ASMJIT_LIKELY(_chunk == nullptr || pos >= _chunk->offset))
+      return _buffer + pos;
+    else
+      return _getChunkPtrAt(pos);
+  }
+
+  //! \internal
+  ASMJIT_API uint8_t* _getChunkPtrAt(size_t pos) const noexcept;
+
   //! Get capacity of the code-buffer.
   ASMJIT_INLINE size_t getCapacity() const noexcept {
     return (size_t)(_end - _buffer);
@@ -647,9 +982,15 @@ class ASMJIT_VIRTAPI Assembler {
     return (size_t)(_end - _cursor);
   }
 
-  //! Get current offset in buffer, same as `getOffset() + getTramplineSize()`.
+  //! Get the size of the code, same as `getOffset() + getTramplineSize()`.
+  //!
+  //! If multiple sections are used the size includes all sections laid out
+  //! one after another, see `relocCode()`.
   ASMJIT_INLINE size_t getCodeSize() const noexcept {
-    return getOffset() + getTrampolinesSize();
+    if (ASMJIT_LIKELY(_sections.getLength() == 0))
+      return getOffset() + getTrampolinesSize();
+    else
+      return _layoutSections(nullptr);
   }
 
   //! Get size of all possible trampolines.
@@ -657,10 +998,13 @@ class ASMJIT_VIRTAPI Assembler {
   //! Trampolines are needed to successfuly generate relative jumps to absolute
   //! addresses. This value is only non-zero if jmp of call instructions were
   //! used with immediate operand (this means jumping or calling an absolute
-  //! address directly).
+  //! address directly). It also includes the global offset table of position
+  //! independent code, see `kOptionPositionIndependent`.
   ASMJIT_INLINE size_t getTrampolinesSize() const noexcept { return _trampolinesSize; }
 
   //! Get code-buffer.
+  //!
+  //! NOTE: See `kOptionChunkedBuffer` for restrictions of chunked code-buffer.
   ASMJIT_INLINE uint8_t* getBuffer() const noexcept { return _buffer; }
   //! Get the end of the code-buffer (points to the first byte that is invalid).
   ASMJIT_INLINE uint8_t* getEnd() const noexcept { return _end; }
@@ -678,6 +1022,7 @@ class ASMJIT_VIRTAPI Assembler {
   //! Set the current offset in the buffer to `offset` and return the previous value.
   ASMJIT_INLINE size_t setOffset(size_t offset) noexcept {
     ASMJIT_ASSERT(offset < getCapacity());
+    ASMJIT_ASSERT(_chunk == nullptr || offset >= _chunk->offset);
 
     size_t oldOffset = (size_t)(_cursor - _buffer);
     _cursor = _buffer + offset;
@@ -687,97 +1032,97 @@ class ASMJIT_VIRTAPI Assembler {
   //! Read `int8_t` at index `pos`.
   ASMJIT_INLINE int32_t readI8At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    return Utils::readI8(_buffer + pos);
+    return Utils::readI8(_getPtrAt(pos));
   }
 
   //! Read `uint8_t` at index `pos`.
   ASMJIT_INLINE uint32_t readU8At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    return Utils::readU8(_buffer + pos);
+    return Utils::readU8(_getPtrAt(pos));
   }
 
   //! Read `int16_t` at index `pos`.
   ASMJIT_INLINE int32_t readI16At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    return Utils::readI16u(_buffer + pos);
+    return Utils::readI16u(_getPtrAt(pos));
   }
 
   //! Read `uint16_t` at index `pos`.
   ASMJIT_INLINE uint32_t readU16At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    return Utils::readU16u(_buffer + pos);
+    return Utils::readU16u(_getPtrAt(pos));
   }
 
   //! Read `int32_t` at index `pos`.
   ASMJIT_INLINE int32_t readI32At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    return Utils::readI32u(_buffer + pos);
+    return Utils::readI32u(_getPtrAt(pos));
   }
 
   //! Read `uint32_t` at index `pos`.
   ASMJIT_INLINE uint32_t readU32At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    return Utils::readU32u(_buffer + pos);
+    return Utils::readU32u(_getPtrAt(pos));
   }
 
   //! Read `uint64_t` at index `pos`.
   ASMJIT_INLINE int64_t readI64At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    return Utils::readI64u(_buffer + pos);
+    return Utils::readI64u(_getPtrAt(pos));
   }
 
   //! Read `uint64_t` at index `pos`.
   ASMJIT_INLINE uint64_t readU64At(size_t pos) const noexcept {
     ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    return Utils::readU64u(_buffer + pos);
+    return Utils::readU64u(_getPtrAt(pos));
   }
 
   //! Write `int8_t` at index `pos`.
   ASMJIT_INLINE void writeI8At(size_t pos, int32_t x) noexcept {
     ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    Utils::writeI8(_buffer + pos, x);
+    Utils::writeI8(_getPtrAt(pos), x);
   }
 
   //! Write `uint8_t` at index `pos`.
   ASMJIT_INLINE void writeU8At(size_t pos, uint32_t x) noexcept {
     ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    Utils::writeU8(_buffer + pos, x);
+    Utils::writeU8(_getPtrAt(pos), x);
   }
 
   //! Write `int8_t` at index `pos`.
   ASMJIT_INLINE void writeI16At(size_t pos, int32_t x) noexcept {
     ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    Utils::writeI16u(_buffer + pos, x);
+    Utils::writeI16u(_getPtrAt(pos), x);
   }
 
   //! Write `uint8_t` at index `pos`.
   ASMJIT_INLINE void writeU16At(size_t pos, uint32_t x) noexcept {
     ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    Utils::writeU16u(_buffer + pos, x);
+    Utils::writeU16u(_getPtrAt(pos), x);
   }
 
   //! Write `int32_t` at index `pos`.
   ASMJIT_INLINE void writeI32At(size_t pos, int32_t x) noexcept {
     ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    Utils::writeI32u(_buffer + pos, x);
+    Utils::writeI32u(_getPtrAt(pos), x);
   }
 
   //! Write `uint32_t` at index `pos`.
   ASMJIT_INLINE void writeU32At(size_t pos, uint32_t x) noexcept {
     ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    Utils::writeU32u(_buffer + pos, x);
+    Utils::writeU32u(_getPtrAt(pos), x);
   }
 
   //! Write `int64_t` at index `pos`.
   ASMJIT_INLINE void writeI64At(size_t pos, int64_t x) noexcept {
     ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    Utils::writeI64u(_buffer + pos, x);
+    Utils::writeI64u(_getPtrAt(pos), x);
   }
 
   //! Write `uint64_t` at index `pos`.
   ASMJIT_INLINE void writeU64At(size_t pos, uint64_t x) noexcept {
     ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    Utils::writeU64u(_buffer + pos, x);
+    Utils::writeU64u(_getPtrAt(pos), x);
   }
 
   // --------------------------------------------------------------------------
@@ -803,7 +1148,7 @@ class ASMJIT_VIRTAPI Assembler {
 
   //! Get number of labels created.
   ASMJIT_INLINE size_t getLabelsCount() const noexcept {
-    return _labels.getLength();
+    return _labelOffsets.getLength();
   }
 
   //! Get whether the `label` is valid (i.e. registered).
@@ -812,7 +1157,7 @@ class ASMJIT_VIRTAPI Assembler {
   }
   //! Get whether the label `id` is valid (i.e. registered).
   ASMJIT_INLINE bool isLabelValid(uint32_t id) const noexcept {
-    return static_cast<size_t>(id) < _labels.getLength();
+    return static_cast<size_t>(id) < _labelOffsets.getLength();
   }
 
   //! Get whether the `label` is bound.
@@ -827,7 +1172,7 @@ class ASMJIT_VIRTAPI Assembler {
   //! \overload
   ASMJIT_INLINE bool isLabelBound(uint32_t id) const noexcept {
     ASMJIT_ASSERT(isLabelValid(id));
-    return _labels[id]->offset != -1;
+    return _labelOffsets[id] != -1;
   }
 
   //! Get a `label` offset or -1 if the label is not yet bound.
@@ -837,17 +1182,27 @@ class ASMJIT_VIRTAPI Assembler {
   //! \overload
   ASMJIT_INLINE intptr_t getLabelOffset(uint32_t id) const noexcept {
     ASMJIT_ASSERT(isLabelValid(id));
-    return _labels[id]->offset;
+    return _labelOffsets[id];
   }
 
-  //! Get `LabelData` by `label`.
-  ASMJIT_INLINE LabelData* getLabelData(const Label& label) const noexcept {
-    return getLabelData(label.getId());
+  //! Get a section where the `label` is bound.
+  ASMJIT_INLINE uint32_t getLabelSectionId(const Label& label) const noexcept {
+    return getLabelSectionId(label.getId());
   }
   //! \overload
-  ASMJIT_INLINE LabelData* getLabelData(uint32_t id) const noexcept {
+  ASMJIT_INLINE uint32_t getLabelSectionId(uint32_t id) const noexcept {
     ASMJIT_ASSERT(isLabelValid(id));
-    return const_cast<LabelData*>(_labels[id]);
+    return _labelSections[id];
+  }
+
+  //! Get `LabelExData` by `label`.
+  ASMJIT_INLINE LabelExData* getLabelExData(const Label& label) const noexcept {
+    return getLabelExData(label.getId());
+  }
+  //! \overload
+  ASMJIT_INLINE LabelExData* getLabelExData(uint32_t id) const noexcept {
+    ASMJIT_ASSERT(isLabelValid(id));
+    return const_cast<LabelExData*>(&_labelExData[id]);
   }
 
   //! \internal
@@ -857,8 +1212,54 @@ class ASMJIT_VIRTAPI Assembler {
 
   //! \internal
   //!
-  //! New LabelLink instance.
-  ASMJIT_API LabelLink* _newLabelLink() noexcept;
+  //! Get a new `LabelLink` and return its index or `kInvalidValue` if out of
+  //! memory. References to links are invalidated when a new link is created.
+  ASMJIT_API uint32_t _newLabelLink() noexcept;
+
+  //! \internal
+  //!
+  //! Get `LabelLink` of `index`.
+  ASMJIT_INLINE LabelLink& _getLabelLink(uint32_t index) noexcept {
+    return _labelLinks[index];
+  }
+  //! \overload
+  ASMJIT_INLINE const LabelLink& _getLabelLink(uint32_t index) const noexcept {
+    return _labelLinks[index];
+  }
+
+  //! \internal
+  //!
+  //! Return the link of `index` to the pool of unused links.
+  //!
+  //! Links are not released while a checkpoint is active, as the link can be
+  //! a part of a chain restored by `rollback()`.
+  ASMJIT_INLINE void _releaseLabelLink(uint32_t index) noexcept {
+    if (_checkpointDepth != 0)
+      return;
+
+    _labelLinks[index].prev = _unusedLinks;
+    _unusedLinks = index;
+  }
+
+  //! \internal
+  //!
+  //! Chain a new `LabelLink` with the label `id` and return the link or
+  //! nullptr if out of memory (or out of links if the code-buffer is fixed).
+  //! The link is valid until a new link is created.
+  ASMJIT_INLINE LabelLink* _linkLabel(uint32_t id) noexcept {
+    if (ASMJIT_UNLIKELY(_checkpointDepth != 0) &&
+        _addUndoRecord(kUndoLinkHead, id, _labelLinkHeads[id], 0, 0) != kErrorOk)
+      return nullptr;
+
+    uint32_t index = _newLabelLink();
+    if (index == kInvalidValue)
+      return nullptr;
+
+    LabelLink* link = &_labelLinks[index];
+    link->prev = _labelLinkHeads[id];
+    _labelLinkHeads[id] = index;
+    return link;
+  }
 
   //! Create and return a new `Label`.
   ASMJIT_INLINE Label newLabel() noexcept { return Label(_newLabelId()); }
@@ -868,6 +1269,134 @@ class ASMJIT_VIRTAPI Assembler {
   //! NOTE: Label can be bound only once!
   ASMJIT_API virtual Error bind(const Label& label) noexcept;
 
+  //! \internal
+  //!
+  //! Get whether the label `id` is bound in the current section, which means
+  //! that a displacement to it can be calculated at the time it's referenced.
+  ASMJIT_INLINE bool _isLabelLocal(uint32_t id) const noexcept {
+    return _labelOffsets[id] != -1 && _labelSections[id] == _sectionId;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Section]
+  // --------------------------------------------------------------------------
+
+  //! Get the number of sections, at least one (`kSectionDefault`).
+  ASMJIT_INLINE size_t getSectionsCount() const noexcept {
+    size_t count = _sections.getLength();
+    return count ? count : size_t(1);
+  }
+
+  //! Get the id of the current section.
+  ASMJIT_INLINE uint32_t getSectionId() const noexcept { return _sectionId; }
+
+  //! Get the section of the given `id`, `nullptr` if only the default section
+  //! exists and no other section has been created yet.
+  ASMJIT_INLINE Section* getSection(uint32_t id) const noexcept {
+    ASMJIT_ASSERT(id < getSectionsCount());
+    return _sections.getLength() ? _sections[id] : static_cast<Section*>(nullptr);
+  }
+
+  //! Get the number of bytes emitted into the section `id`.
+  ASMJIT_INLINE size_t getSectionLength(uint32_t id) const noexcept {
+    ASMJIT_ASSERT(id < getSectionsCount());
+    return id == _sectionId ? getOffset() : _sections[id]->content.length;
+  }
+
+  //! Get the number of bytes required by `relocSection()` to relocate the
+  //! section `id`, including space reserved for possible trampolines.
+  ASMJIT_API size_t getSectionSize(uint32_t id) const noexcept;
+
+  //! Create a new section and return its id.
+  //!
+  //! All sections are relocated together by `relocCode()`, which places them
+  //! one after another (each aligned to its `alignment` relative to the
+  //! beginning of the code), or separately by `relocSection()`. Labels can be
+  //! referenced across sections, such displacements are patched when the code
+  //! is relocated.
+  //!
+  //! Returns `kInvalidValue` on failure.
+  ASMJIT_API uint32_t newSection(const char* name, uint32_t flags = 0, uint32_t alignment = 0) noexcept;
+
+  //! Switch to the section `id`, the following code will be emitted into it.
+  ASMJIT_API Error section(uint32_t id) noexcept;
+
+  //! \internal
+  //!
+  //! Switch to the section `id` without validation and logging.
+  ASMJIT_API void _switchSection(uint32_t id) noexcept;
+
+  //! \internal
+  //!
+  //! Calculate the offset of each section in the flat layout used by
+  //! `relocCode()` and store it to `offsets` (if not null). Returns the size
+  //! of the whole layout.
+  ASMJIT_API size_t _layoutSections(Ptr* offsets) const noexcept;
+
+  //! \internal
+  //!
+  //! Copy the content of the section `id` to `dst`.
+  ASMJIT_API void _copySectionData(uint32_t id, uint8_t* dst) const noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Checkpoint]
+  // --------------------------------------------------------------------------
+
+  //! Get the number of active checkpoints (not rolled back or committed yet).
+  ASMJIT_INLINE uint32_t getCheckpointDepth() const noexcept { return _checkpointDepth; }
+
+  //! Capture the current state of the assembler to `cp`.
+  //!
+  //! Everything emitted after the checkpoint - code, data, new labels, labels
+  //! bound, links to labels, and relocations - is either discarded by
+  //! `rollback()` or kept by `commit()`. Nothing is copied when a checkpoint
+  //! is created, while it's active the assembler only records changes made to
+  //! the state that existed before (labels bound and displacements patched),
+  //! so speculative code can be emitted directly instead of being emitted by
+  //! a scratch assembler and copied.
+  //!
+  //! Checkpoints can be nested, but must be ended in the reverse order they
+  //! were created. New sections can't be created and `relax()` can't be used
+  //! while a checkpoint is active. The output of the logger is not rolled
+  //! back.
+  ASMJIT_API virtual Error checkpoint(Checkpoint& cp) noexcept;
+
+  //! Restore the state captured by `checkpoint()` and end the checkpoint.
+  //!
+  //! Returns `kErrorInvalidState` if `cp` is not the innermost checkpoint.
+  ASMJIT_API virtual Error rollback(const Checkpoint& cp) noexcept;
+
+  //! Keep everything emitted after `checkpoint()` and end the checkpoint.
+  //!
+  //! Returns `kErrorInvalidState` if `cp` is not the innermost checkpoint.
+  ASMJIT_API Error commit(const Checkpoint& cp) noexcept;
+
+  //! \internal
+  //!
+  //! Record a change of the state that existed before the innermost
+  //! checkpoint, see `UndoRecord`. The error is not reported.
+  ASMJIT_API Error _addUndoRecord(uint32_t type, uint32_t id, uint32_t a, uint32_t b, uint64_t value) noexcept;
+
+  //! \internal
+  //!
+  //! Discard everything emitted to the current section after `offset`.
+  ASMJIT_API void _truncate(size_t offset) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Relax]
+  // --------------------------------------------------------------------------
+
+  //! Relax span-dependent instructions recorded so far.
+  //!
+  //! Does nothing unless `kOptionRelaxBranches` was enabled before the code
+  //! was emitted. Relaxation changes the layout of the code-buffer, so all
+  //! label offsets and relocations are updated, however, offsets obtained
+  //! through `getOffset()` before the relaxation are invalidated.
+  //!
+  //! NOTE: `make()` calls `relax()` automatically, call it explicitly only
+  //! if you use `relocCode()` directly.
+  ASMJIT_API virtual Error relax() noexcept;
+
   // --------------------------------------------------------------------------
   // [Reloc]
   // --------------------------------------------------------------------------
@@ -889,12 +1418,27 @@ class ASMJIT_VIRTAPI Assembler {
   //!
   //! A given buffer will be overwritten, to get the number of bytes required,
   //! use `getCodeSize()`.
+  //!
+  //! If multiple sections are used they are placed one after another in the
+  //! order they were created, each aligned to its alignment relative to `dst`.
+  //! Returns zero if a displacement between sections doesn't fit.
   ASMJIT_API size_t relocCode(void* dst, Ptr baseAddress = kNoBaseAddress) const noexcept;
 
+  //! Relocate the section `id` and copy it to `dst`.
+  //!
+  //! \param baseAddresses Array of base addresses of all sections (see
+  //! `getSectionsCount()`), which is required to resolve references between
+  //! sections. Each section can be placed anywhere, however, the distance
+  //! between sections that reference each other must fit into 32 bits.
+  //!
+  //! \retval The number of bytes actually used, at most `getSectionSize(id)`,
+  //! or `kInvalidIndex` if a displacement between sections doesn't fit.
+  ASMJIT_API size_t relocSection(uint32_t id, void* dst, const Ptr* baseAddresses) const noexcept;
+
   //! \internal
   //!
-  //! Reloc code.
-  virtual size_t _relocCode(void* dst, Ptr baseAddress) const noexcept = 0;
+  //! Reloc section.
+  virtual size_t _relocSection(uint32_t id, void* dst, const Ptr* baseAddresses) const noexcept = 0;
 
   // --------------------------------------------------------------------------
   // [Make]
@@ -938,6 +1482,25 @@ class ASMJIT_VIRTAPI Assembler {
   //! \overload
   ASMJIT_API Error emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, int64_t o3);
 
+  //! Emit a batch of instructions (virtual).
+  //!
+  //! The default implementation calls `_emit()` for each record, assemblers
+  //! override it to reserve the code-buffer once and to encode all records
+  //! in a single loop.
+  ASMJIT_API virtual Error _emitBatch(const InstRecord* records, size_t count);
+
+  //! Emit `count` instructions described by `records`.
+  //!
+  //! This is equivalent to calling `emit()` for each record, but it's faster
+  //! as there is only a single virtual call and a single check of the code
+  //! buffer capacity per batch. Options of each instruction are taken from
+  //! `InstRecord::options`, options set before calling `emitBatch()` are
+  //! discarded. Emitting stops at the first error, which is returned, all
+  //! records before it are already emitted.
+  ASMJIT_INLINE Error emitBatch(const InstRecord* records, size_t count) {
+    return _emitBatch(records, count);
+  }
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -953,8 +1516,10 @@ class ASMJIT_VIRTAPI Assembler {
   uint8_t _arch;
   //! Target architecture GP register size in bytes (4 or 8).
   uint8_t _regSize;
+  //! Whether the code-buffer is provided by `setFixedBuffer()`.
+  uint8_t _fixedBuffer;
   //! \internal
-  uint16_t _reserved;
+  uint8_t _reserved;
 
   //! Assembler options, used by \ref getAsmOptions() and \ref hasAsmOption().
   uint32_t _asmOptions;
@@ -977,21 +1542,44 @@ class ASMJIT_VIRTAPI Assembler {
   uint8_t* _end;
   //! The current position in `_buffer` of the current section.
   uint8_t* _cursor;
+  //! Last chunk of the current section (chunked code-buffer only).
+  //!
+  //! If not null `_buffer` is not a real pointer, it's calculated so that
+  //! `_cursor - _buffer` is the offset in the code-buffer.
+  CodeChunk* _chunk;
 
   //! Size of all possible trampolines.
   uint32_t _trampolinesSize;
+  //! Current section id.
+  uint32_t _sectionId;
 
   //! Inline comment that will be logged by the next instruction and set to nullptr.
   const char* _comment;
-  //! Unused `LabelLink` structures pool.
-  LabelLink* _unusedLinks;
+  //! Chain of unused links in `_labelLinks`.
+  uint32_t _unusedLinks;
+  //! Count of active checkpoints.
+  uint32_t _checkpointDepth;
 
   //! Assembler sections.
   PodVectorTmp<Section*, 4> _sections;
-  //! Assembler labels.
-  PodVectorTmp<LabelData*, 16> _labels;
+
+  //! Label offsets, -1 if the label is not bound (indexed by label id).
+  PodVectorTmp<intptr_t, 16> _labelOffsets;
+  //! Label link chains, index to `_labelLinks` (indexed by label id).
+  //!
+  //! If the label is bound the chain contains only links from other sections,
+  //! which are resolved by `relocCode()`.
+  PodVectorTmp<uint32_t, 16> _labelLinkHeads;
+  //! Label sections (indexed by label id).
+  PodVectorTmp<uint32_t, 16> _labelSections;
+  //! Label data associated by `ExternalTool` (indexed by label id).
+  PodVector<LabelExData> _labelExData;
+  //! Pool of label links.
+  PodVector<LabelLink> _labelLinks;
   //! Table of relocations.
   PodVector<RelocData> _relocations;
+  //! Changes to undo by `rollback()`, recorded while a checkpoint is active.
+  PodVector<UndoRecord> _undoLog;
 };
 
 //! \}
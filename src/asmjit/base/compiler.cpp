@@ -99,6 +99,14 @@ void Compiler::reset(bool releaseMemory) noexcept {
   _varList.reset(releaseMemory);
 }
 
+size_t Compiler::getMemorySize() const noexcept {
+  return _zoneAllocator.getMemorySize() +
+         _varAllocator.getMemorySize() +
+         _stringAllocator.getMemorySize() +
+         _constAllocator.getMemorySize() +
+         _varList.getHeapSize();
+}
+
 // ============================================================================
 // [asmjit::Compiler - Node-Factory]
 // ============================================================================
@@ -126,7 +134,7 @@ HLLabel* Compiler::newLabelNode() noexcept {
   if (assembler == nullptr) return nullptr;
 
   uint32_t id = assembler->_newLabelId();
-  LabelData* ld = assembler->getLabelData(id);
+  LabelExData* ld = assembler->getLabelExData(id);
 
   HLLabel* node = newNode<HLLabel>(id);
   if (node == nullptr) return nullptr;
@@ -370,7 +378,7 @@ HLLabel* Compiler::getHLLabel(uint32_t id) const noexcept {
   Assembler* assembler = getAssembler();
   if (assembler == nullptr) return nullptr;
 
-  LabelData* ld = assembler->getLabelData(id);
+  LabelExData* ld = assembler->getLabelExData(id);
   if (ld->exId == _exId)
     return static_cast<HLLabel*>(ld->exData);
   else
@@ -158,6 +158,10 @@ class ASMJIT_VIRTAPI Compiler : public ExternalTool {
   //! \override
   ASMJIT_API virtual void reset(bool releaseMemory) noexcept;
 
+  //! Get the number of bytes of memory retained by the compiler - zones and
+  //! arrays (the result is approximate).
+  ASMJIT_API size_t getMemorySize() const noexcept;
+
   // --------------------------------------------------------------------------
   // [Compiler Features]
   // --------------------------------------------------------------------------
@@ -407,11 +407,13 @@ static void x86DetectCpuInfo(CpuInfo* cpuInfo) noexcept {
     cpuInfo->_model    = (regs.eax >> 4) & 0x0F;
     cpuInfo->_stepping = (regs.eax     ) & 0x0F;
 
-    // Use extended family and model fields.
-    if (cpuInfo->_family == 0x0F) {
+    // Use extended family and model fields. Extended model is also used by
+    // family 6, which covers all Intel Core processors.
+    if (cpuInfo->_family == 0x0F)
       cpuInfo->_family += ((regs.eax >> 20) & 0xFF);
+
+    if (cpuInfo->_family == 0x06 || cpuInfo->_family >= 0x0F)
       cpuInfo->_model  += ((regs.eax >> 16) & 0x0F) << 4;
-    }
 
     cpuInfo->_x86Data._processorType        = ((regs.eax >> 12) & 0x03);
     cpuInfo->_x86Data._brandIndex           = ((regs.ebx      ) & 0xFF);
@@ -473,6 +475,7 @@ static void x86DetectCpuInfo(CpuInfo* cpuInfo) noexcept {
 
   if (maxId >= 0x7) {
     x86CallCpuId(&regs, 0x7);
+    uint32_t maxSubId = regs.eax;
 
     if (regs.ebx & 0x00000001U) cpuInfo->addFeature(CpuInfo::kX86FeatureFSGSBASE);
     if (regs.ebx & 0x00000008U) cpuInfo->addFeature(CpuInfo::kX86FeatureBMI);
@@ -512,8 +515,25 @@ static void x86DetectCpuInfo(CpuInfo* cpuInfo) noexcept {
         if (regs.ebx & 0x40000000U) cpuInfo->addFeature(CpuInfo::kX86FeatureAVX512BW);
         if (regs.ebx & 0x80000000U) cpuInfo->addFeature(CpuInfo::kX86FeatureAVX512VL);
         if (regs.ecx & 0x00000002U) cpuInfo->addFeature(CpuInfo::kX86FeatureAVX512VBMI);
+        if (regs.ecx & 0x00000800U) cpuInfo->addFeature(CpuInfo::kX86FeatureAVX512VNNI);
       }
     }
+
+    // Detect AVX-VNNI, AVX512-BF16, and APX (CPUID EAX=0x7 ECX=0x1).
+    if (maxSubId >= 0x1) {
+      x86CallCpuId(&regs, 0x7, 0x1);
+
+      // - XCR0[19] == 1b
+      //   State of R16..R31 (APX) needs to be enabled by the OS.
+      if (xcr0.eax & 0x00080000U)
+        if (regs.edx & 0x00200000U) cpuInfo->addFeature(CpuInfo::kX86FeatureAPX_F);
+
+      if (cpuInfo->hasFeature(CpuInfo::kX86FeatureAVX))
+        if (regs.eax & 0x00000010U) cpuInfo->addFeature(CpuInfo::kX86FeatureAVX_VNNI);
+
+      if (cpuInfo->hasFeature(CpuInfo::kX86FeatureAVX512F))
+        if (regs.eax & 0x00000020U) cpuInfo->addFeature(CpuInfo::kX86FeatureAVX512BF16);
+    }
   }
 
   // --------------------------------------------------------------------------
@@ -624,6 +644,29 @@ void CpuInfo::detect() noexcept {
 #endif // ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64
 }
 
+// ============================================================================
+// [asmjit::CpuInfo - X86]
+// ============================================================================
+
+bool CpuInfo::hasX86JccErratum() const noexcept {
+  if (_vendorId != kVendorIntel || _family != 0x06)
+    return false;
+
+  switch (_model) {
+    case 0x4E: // Skylake (Mobile).
+    case 0x55: // Skylake (Server), Cascade Lake, Cooper Lake.
+    case 0x5E: // Skylake (Desktop).
+    case 0x8E: // Kaby Lake, Amber Lake, Whiskey Lake, Comet Lake (Mobile).
+    case 0x9E: // Kaby Lake, Coffee Lake (Desktop).
+    case 0xA5: // Comet Lake.
+    case 0xA6: // Comet Lake (Mobile).
+      return true;
+
+    default:
+      return false;
+  }
+}
+
 // ============================================================================
 // [asmjit::CpuInfo - GetHost]
 // ============================================================================
@@ -137,6 +137,10 @@ class CpuInfo {
     kX86FeatureAVX512VL,                 //!< CPU has AVX VL (vector length extensions).
     kX86FeatureAVX512IFMA,               //!< CPU has AVX IFMA (integer fused multiply add using 52-bit precision).
     kX86FeatureAVX512VBMI,               //!< CPU has AVX VBMI (vector byte manipulation instructions).
+    kX86FeatureAVX512VNNI,               //!< CPU has AVX-512 VNNI (vector neural network instructions).
+    kX86FeatureAVX512BF16,               //!< CPU has AVX-512 BF16 (BFLOAT16 conversion and dot-product).
+    kX86FeatureAVX_VNNI,                 //!< CPU has AVX VNNI (VEX encoded VNNI, XMM/YMM only).
+    kX86FeatureAPX_F,                    //!< CPU has APX (R16..R31 registers, REX2, NDD and NF forms).
 
     kX86FeaturesCount                    //!< Count of X86/X64 CPU features.
   };
@@ -263,6 +267,13 @@ class CpuInfo {
     return _x86Data._maxLogicalProcessors;
   }
 
+  //! Get whether the CPU is affected by the JCC erratum (Intel SKX102).
+  //!
+  //! Skylake derived cores with the microcode update that mitigates the
+  //! erratum don't cache jumps that cross or end on a 32-byte boundary in
+  //! the decoded ICache, see `Assembler::kOptionAlignBranches`.
+  ASMJIT_API bool hasX86JccErratum() const noexcept;
+
   // --------------------------------------------------------------------------
   // [Statics]
   // --------------------------------------------------------------------------
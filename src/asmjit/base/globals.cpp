@@ -36,6 +36,7 @@ static const char errorMessages[] = {
   "Illegal addressing\0"
   "Illegal displacement\0"
   "Overlapped arguments\0"
+  "Invalid syntax\0"
   "Unknown error\0"
 };
 
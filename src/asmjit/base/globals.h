@@ -552,6 +552,9 @@ ASMJIT_ENUM(ErrorCode) {
   //! A variable has been assigned more than once to a function argument (Compiler).
   kErrorOverlappedArgs,
 
+  //! Invalid syntax of an assembly text (`X86AsmParser`).
+  kErrorInvalidSyntax,
+
   //! Count of AsmJit error codes.
   kErrorCount
 };
@@ -185,6 +185,88 @@ void StringLogger::logString(uint32_t style, const char* buf, size_t len) noexce
   _stringBuilder.appendString(buf, len);
 }
 
+// ============================================================================
+// [asmjit::BinaryLogger - Construction / Destruction]
+// ============================================================================
+
+BinaryLogger::BinaryLogger(size_t capacity) noexcept
+  : _records(nullptr),
+    _mask(0),
+    _position(0),
+    _formatFunc(nullptr) {
+
+  _options = kOptionDeferred;
+
+  if (capacity == 0)
+    return;
+
+  capacity = Utils::alignToPowerOf2<size_t>(capacity);
+  _records = static_cast<LogRecord*>(ASMJIT_ALLOC(capacity * sizeof(LogRecord)));
+
+  if (_records != nullptr)
+    _mask = capacity - 1;
+}
+
+BinaryLogger::~BinaryLogger() noexcept {
+  if (_records != nullptr)
+    ASMJIT_FREE(_records);
+}
+
+// ============================================================================
+// [asmjit::BinaryLogger - Format]
+// ============================================================================
+
+Error BinaryLogger::format(StringBuilder& sb) const noexcept {
+  size_t count = getCount();
+
+  for (size_t i = 0; i < count; i++) {
+    const LogRecord& record = getRecord(i);
+
+    if (record.isText()) {
+      if (!sb.appendString(record.getText(), record.size))
+        return kErrorNoHeapMemory;
+    }
+    else {
+      // Columns are aligned by `LogUtil::formatLine()` from the beginning of
+      // the string, so each instruction is formatted separately.
+      StringBuilderTmp<512> line;
+      if (!line.appendString(_indentation) || !_formatFunc(line, record, _options))
+        return kErrorNoHeapMemory;
+
+      if (!sb.appendString(line.getData(), line.getLength()))
+        return kErrorNoHeapMemory;
+    }
+  }
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::BinaryLogger - Logging]
+// ============================================================================
+
+void BinaryLogger::logString(uint32_t style, const char* buf, size_t len) noexcept {
+  if (_records == nullptr)
+    return;
+
+  if (len == kInvalidIndex)
+    len = strlen(buf);
+
+  // Long text is split into as many records as needed.
+  while (len != 0) {
+    size_t n = Utils::iMin<size_t>(len, LogRecord::kMaxTextLength);
+    LogRecord& record = _records[_position++ & _mask];
+
+    record.type = LogRecord::kTypeText;
+    record.arch = static_cast<uint8_t>(style);
+    record.size = static_cast<uint32_t>(n);
+    ::memcpy(record.getText(), buf, n);
+
+    buf += n;
+    len -= n;
+  }
+}
+
 } // asmjit namespace
 
 // [Api-End]
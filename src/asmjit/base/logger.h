@@ -12,6 +12,7 @@
 
 // [Dependencies]
 #include "../base/containers.h"
+#include "../base/operand.h"
 #include <stdarg.h>
 
 // [Api-Begin]
@@ -69,7 +70,8 @@ class ASMJIT_VIRTAPI Logger {
   ASMJIT_ENUM(Options) {
     kOptionBinaryForm      = 0x00000001, //! Output instructions also in binary form.
     kOptionHexImmediate    = 0x00000002, //! Output immediates as hexadecimal numbers.
-    kOptionHexDisplacement = 0x00000004  //! Output displacements as hexadecimal numbers.
+    kOptionHexDisplacement = 0x00000004, //! Output displacements as hexadecimal numbers.
+    kOptionDeferred        = 0x00000008  //! Record instructions in binary form (read-only, set by `BinaryLogger`).
   };
 
   // --------------------------------------------------------------------------
@@ -253,6 +255,195 @@ class ASMJIT_VIRTAPI StringLogger : public Logger {
   //! Output.
   StringBuilder _stringBuilder;
 };
+
+// ============================================================================
+// [asmjit::LogRecord]
+// ============================================================================
+
+//! Instruction or text recorded by `BinaryLogger`.
+struct LogRecord {
+  //! Record type.
+  ASMJIT_ENUM(Type) {
+    //! Instruction, see `instId`, `operands`, and `binary`.
+    kTypeInst = 0,
+    //! Text passed to `Logger::logString()`, see `getText()`.
+    kTypeText = 1
+  };
+
+  enum {
+    //! Maximum count of instruction bytes kept by the record.
+    kMaxBinaryLength = 16,
+    //! Maximum length of text kept by a single record, longer text is split.
+    kMaxTextLength = static_cast<int>(sizeof(Operand)) * 4
+  };
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get whether the record is an instruction.
+  ASMJIT_INLINE bool isInst() const noexcept { return type == kTypeInst; }
+  //! Get whether the record is a text.
+  ASMJIT_INLINE bool isText() const noexcept { return type == kTypeText; }
+
+  //! Get the text of a text record (not null terminated, see `size`).
+  ASMJIT_INLINE char* getText() noexcept { return reinterpret_cast<char*>(operands); }
+  //! \overload
+  ASMJIT_INLINE const char* getText() const noexcept { return reinterpret_cast<const char*>(operands); }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Record type, see \ref Type.
+  uint8_t type;
+  //! Architecture of an instruction or style of a text.
+  uint8_t arch;
+  //! Size of the displacement or relative target of an instruction.
+  uint8_t dispSize;
+  //! Size of the immediate value of an instruction.
+  uint8_t immSize;
+  //! Count of instruction bytes kept in `binary` or length of a text.
+  uint32_t size;
+
+  //! Instruction id.
+  uint32_t instId;
+  //! Instruction options.
+  uint32_t options;
+
+  //! Offset of the instruction in the code buffer.
+  Ptr offset;
+  //! Comment of the instruction, the pointer is only stored.
+  const char* comment;
+
+  //! Instruction bytes.
+  uint8_t binary[kMaxBinaryLength];
+  //! Instruction operands, also used to store a text.
+  Operand operands[4];
+};
+
+//! \internal
+//!
+//! Function that formats an instruction record, provided by the assembler
+//! that recorded it.
+typedef bool (*LogFormatFunc)(StringBuilder& sb, const LogRecord& record, uint32_t loggerOptions);
+
+// ============================================================================
+// [asmjit::BinaryLogger]
+// ============================================================================
+
+//! Binary logger.
+//!
+//! Logger that records instructions into a ring buffer in binary form (id,
+//! options, operands, offset, encoded bytes, and a comment pointer) instead
+//! of formatting them. Formatting is the most expensive part of logging, so
+//! `BinaryLogger` is cheap enough to be always attached and the text is only
+//! created by `format()` when it's needed, for example after a failure.
+//!
+//! The ring buffer keeps only the most recent records, the older ones are
+//! overwritten. Labels, directives, and other text logged by `logString()`
+//! are copied into the ring buffer as they are.
+//!
+//! NOTE: Comments are not copied, only pointers to them are recorded, so
+//! they must outlive the logger or at least the call to `format()`.
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! JitRuntime runtime;
+//! X86Assembler a(&runtime);
+//!
+//! BinaryLogger logger(1024);
+//! a.setLogger(&logger);
+//!
+//! // ... Emit code ...
+//!
+//! StringBuilder sb;
+//! logger.format(sb);
+//! ~~~
+class ASMJIT_VIRTAPI BinaryLogger : public Logger {
+ public:
+  ASMJIT_NO_COPY(BinaryLogger)
+
+  //! Default count of records kept in the ring buffer.
+  enum { kDefaultCapacity = 4096 };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a new `BinaryLogger` that keeps at most `capacity` records, the
+  //! capacity is rounded up to a power of 2.
+  ASMJIT_API BinaryLogger(size_t capacity = kDefaultCapacity) noexcept;
+
+  //! Destroy the `BinaryLogger`.
+  ASMJIT_API virtual ~BinaryLogger() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the count of records the ring buffer can hold, zero if the buffer
+  //! couldn't be allocated.
+  ASMJIT_INLINE size_t getCapacity() const noexcept {
+    return _records != nullptr ? _mask + 1 : 0;
+  }
+
+  //! Get the count of records kept in the ring buffer.
+  ASMJIT_INLINE size_t getCount() const noexcept {
+    return Utils::iMin<size_t>(_position, getCapacity());
+  }
+
+  //! Get the count of records that were overwritten.
+  ASMJIT_INLINE size_t getDroppedCount() const noexcept { return _position - getCount(); }
+
+  //! Get the record at `index`, the oldest record kept has index zero.
+  ASMJIT_INLINE const LogRecord& getRecord(size_t index) const noexcept {
+    ASMJIT_ASSERT(index < getCount());
+    return _records[(_position - getCount() + index) & _mask];
+  }
+
+  //! Remove all records.
+  ASMJIT_INLINE void clear() noexcept { _position = 0; }
+
+  // --------------------------------------------------------------------------
+  // [Format]
+  // --------------------------------------------------------------------------
+
+  //! Format all records kept in the ring buffer and append them to `sb`.
+  ASMJIT_API Error format(StringBuilder& sb) const noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Logging]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_API virtual void logString(uint32_t style, const char* buf, size_t len = kInvalidIndex) noexcept;
+
+  //! \internal
+  //!
+  //! Get a new record, called by the assembler for each instruction. Returns
+  //! `nullptr` if the ring buffer couldn't be allocated.
+  ASMJIT_INLINE LogRecord* _newRecord(LogFormatFunc formatFunc) noexcept {
+    if (_records == nullptr)
+      return nullptr;
+
+    _formatFunc = formatFunc;
+    return &_records[_position++ & _mask];
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Ring buffer.
+  LogRecord* _records;
+  //! Capacity of the ring buffer minus one.
+  size_t _mask;
+  //! Count of records recorded since `clear()`.
+  size_t _position;
+  //! Function that formats instruction records.
+  LogFormatFunc _formatFunc;
+};
 #else
 struct Logger;
 #endif // !ASMJIT_DISABLE_LOGGER
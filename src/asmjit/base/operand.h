@@ -361,6 +361,15 @@ class Operand {
 
   explicit ASMJIT_INLINE Operand(const _NoInit&) noexcept {}
 
+  // --------------------------------------------------------------------------
+  // [Operator Overload]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE Operand& operator=(const Operand& other) noexcept {
+    _copy(other);
+    return *this;
+  }
+
   // --------------------------------------------------------------------------
   // [Base]
   // --------------------------------------------------------------------------
@@ -123,6 +123,16 @@ public:
   ASMJIT_INLINE size_t getLength() const noexcept { return _d->length; }
   //! Get capacity.
   ASMJIT_INLINE size_t getCapacity() const noexcept { return _d->capacity; }
+
+  //! Get the number of bytes allocated on the heap, zero if the vector uses
+  //! the null data or the static data of `PodVectorTmp<T, N>`.
+  ASMJIT_INLINE size_t getHeapSize() const noexcept {
+    const Data* d = _d;
+    if (d == &_nullData || static_cast<const void*>(static_cast<const PodVectorBase*>(this) + 1) == d)
+      return 0;
+    return sizeof(Data) + d->capacity * sizeof(T);
+  }
+
   //! Get data.
   ASMJIT_INLINE T* getData() noexcept { return static_cast<T*>(_d->getData()); }
   //! \overload
@@ -190,6 +200,12 @@ public:
     return kErrorOk;
   }
 
+  //! Truncate the vector to at most `n` items.
+  ASMJIT_INLINE void truncate(size_t n) noexcept {
+    if (n < _d->length)
+      _d->length = n;
+  }
+
   //! Get index of `val` or `kInvalidIndex` if not found.
   size_t indexOf(const T& val) const noexcept {
     Data* d = _d;
@@ -263,6 +279,21 @@ class PodVectorTmp : public PodVector<T> {
   //! Destroy the `PodVectorTmp<T>` and its data.
   ASMJIT_INLINE ~PodVectorTmp() noexcept {}
 
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  //! Reset the vector, the embedded data is used again if the memory is
+  //! released.
+  ASMJIT_INLINE void reset(bool releaseMemory = false) noexcept {
+    PodVectorBase::reset(releaseMemory);
+
+    if (releaseMemory) {
+      _staticData.length = 0;
+      this->_d = &_staticData;
+    }
+  }
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
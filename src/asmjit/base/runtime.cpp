@@ -10,10 +10,21 @@
 // [Dependencies]
 #include "../base/assembler.h"
 #include "../base/runtime.h"
+#include "../base/utils.h"
 
 // TODO: Rename this, or make call conv independent of CompilerFunc.
 #include "../base/compilerfunc.h"
 
+#if ASMJIT_OS_POSIX
+# include <sys/types.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif // ASMJIT_OS_POSIX
+
+#if ASMJIT_OS_LINUX
+# include <sys/syscall.h>
+#endif // ASMJIT_OS_LINUX
+
 // [Api-Begin]
 #include "../apibegin.h"
 
@@ -67,6 +78,148 @@ static ASMJIT_INLINE void hostFlushInstructionCache(void* p, size_t size) noexce
 #endif // !ASMJIT_ARCH_X86 && !ASMJIT_ARCH_X64
 }
 
+// ============================================================================
+// [asmjit::Runtime - Serialize]
+// ============================================================================
+
+// `membarrier()` commands, defined here as they are not available in older
+// kernel headers (values are part of the stable Linux ABI).
+#if ASMJIT_OS_LINUX && defined(__NR_membarrier)
+enum {
+  kMembarrierCmdQuery = 0,
+  kMembarrierCmdPrivateExpedited = 8,
+  kMembarrierCmdRegisterPrivateExpedited = 16,
+  kMembarrierCmdPrivateExpeditedSyncCore = 32,
+  kMembarrierCmdRegisterPrivateExpeditedSyncCore = 64
+};
+
+static ASMJIT_INLINE int hostMembarrier(int cmd) noexcept {
+  return static_cast<int>(::syscall(__NR_membarrier, cmd, 0));
+}
+#endif // ASMJIT_OS_LINUX && __NR_membarrier
+
+//! \internal
+//!
+//! Mechanism used by `hostSerializeAllCores()`, detected the first time
+//! it's needed.
+ASMJIT_ENUM(HostSerializeMode) {
+  kHostSerializeNotDetected = 0,
+  kHostSerializeSyncCore = 1,
+  kHostSerializeExpedited = 2,
+  kHostSerializeProtect = 3,
+  kHostSerializeFlushWriteBuffers = 4,
+  kHostSerializeUnsupported = 5
+};
+
+struct HostSerializeState {
+  ASMJIT_NO_COPY(HostSerializeState)
+
+  ASMJIT_INLINE HostSerializeState() noexcept
+    : mode(kHostSerializeNotDetected),
+      page(nullptr) {}
+
+  //! Lock, protects detection and `page` protection changes.
+  Lock lock;
+  //! Detected mechanism, see `HostSerializeMode`.
+  volatile uint32_t mode;
+  //! Page used by `kHostSerializeProtect` mode.
+  void* page;
+};
+static HostSerializeState hostSerializeState;
+
+static uint32_t hostDetectSerializeMode(HostSerializeState& state) noexcept {
+#if ASMJIT_OS_WINDOWS
+  return kHostSerializeFlushWriteBuffers;
+#else
+# if ASMJIT_OS_LINUX && defined(__NR_membarrier)
+  int supported = hostMembarrier(kMembarrierCmdQuery);
+  if (supported != -1) {
+    // Registration is required by the expedited commands and is idempotent.
+    if ((supported & kMembarrierCmdPrivateExpeditedSyncCore) != 0 &&
+        hostMembarrier(kMembarrierCmdRegisterPrivateExpeditedSyncCore) == 0)
+      return kHostSerializeSyncCore;
+
+#  if ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64
+    if ((supported & kMembarrierCmdPrivateExpedited) != 0 &&
+        hostMembarrier(kMembarrierCmdRegisterPrivateExpedited) == 0)
+      return kHostSerializeExpedited;
+#  endif // ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64
+  }
+# endif // ASMJIT_OS_LINUX && __NR_membarrier
+
+  // Fallback - a page that is locked in memory (so it's never swapped out and
+  // its TLB entry can't be dropped lazily). Changing its protection forces the
+  // kernel to send TLB shootdown IPIs to all cores that run the process.
+  size_t pageSize = VMemUtil::getPageSize();
+  void* page = ::mmap(nullptr, pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+
+  if (page == MAP_FAILED)
+    return kHostSerializeUnsupported;
+
+  if (::mlock(page, pageSize) != 0) {
+    ::munmap(page, pageSize);
+    return kHostSerializeUnsupported;
+  }
+
+  state.page = page;
+  return kHostSerializeProtect;
+#endif // ASMJIT_OS_WINDOWS
+}
+
+static Error hostSerializeAllCores() noexcept {
+  HostSerializeState& state = hostSerializeState;
+  uint32_t mode = state.mode;
+
+  if (ASMJIT_UNLIKELY(mode == kHostSerializeNotDetected)) {
+    AutoLock locked(state.lock);
+
+    mode = state.mode;
+    if (mode == kHostSerializeNotDetected)
+      state.mode = mode = hostDetectSerializeMode(state);
+  }
+
+  switch (mode) {
+#if ASMJIT_OS_LINUX && defined(__NR_membarrier)
+    case kHostSerializeSyncCore:
+      if (hostMembarrier(kMembarrierCmdPrivateExpeditedSyncCore) != 0)
+        return kErrorInvalidState;
+      return kErrorOk;
+
+    case kHostSerializeExpedited:
+      if (hostMembarrier(kMembarrierCmdPrivateExpedited) != 0)
+        return kErrorInvalidState;
+      return kErrorOk;
+#endif // ASMJIT_OS_LINUX && __NR_membarrier
+
+#if ASMJIT_OS_POSIX
+    case kHostSerializeProtect: {
+      AutoLock locked(state.lock);
+      size_t pageSize = VMemUtil::getPageSize();
+
+      // Touch the page so the TLB entry of this core is populated, otherwise
+      // the kernel may decide that there is nothing to shoot down.
+      if (::mprotect(state.page, pageSize, PROT_READ | PROT_WRITE) != 0)
+        return kErrorInvalidState;
+
+      static_cast<volatile uint32_t*>(state.page)[0]++;
+
+      if (::mprotect(state.page, pageSize, PROT_NONE) != 0)
+        return kErrorInvalidState;
+      return kErrorOk;
+    }
+#endif // ASMJIT_OS_POSIX
+
+#if ASMJIT_OS_WINDOWS
+    case kHostSerializeFlushWriteBuffers:
+      ::FlushProcessWriteBuffers();
+      return kErrorOk;
+#endif // ASMJIT_OS_WINDOWS
+
+    default:
+      return kErrorInvalidState;
+  }
+}
+
 // ============================================================================
 // [asmjit::Runtime - Construction / Destruction]
 // ============================================================================
@@ -107,6 +260,11 @@ void HostRuntime::flush(void* p, size_t size) noexcept {
   hostFlushInstructionCache(p, size);
 }
 
+Error HostRuntime::publish(void* p, size_t size) noexcept {
+  flush(p, size);
+  return hostSerializeAllCores();
+}
+
 // ============================================================================
 // [asmjit::StaticRuntime - Construction / Destruction]
 // ============================================================================
@@ -139,10 +297,11 @@ Error StaticRuntime::add(void** dst, Assembler* assembler) noexcept {
   uint8_t* p = static_cast<uint8_t*>((void*)static_cast<uintptr_t>(baseAddress));
 
   // Since the base address is known the `relocSize` returned should be equal
-  // to `codeSize`. It's better to fail if they don't match instead of passsing
-  // silently.
+  // to `codeSize`, however, sections other than the default one can reserve
+  // space for trampolines that is not used. It's better to fail if it's more
+  // instead of passsing silently.
   size_t relocSize = assembler->relocCode(p, baseAddress);
-  if (relocSize == 0 || codeSize != relocSize) {
+  if (relocSize == 0 || relocSize > codeSize) {
     *dst = nullptr;
     return kErrorInvalidState;
   }
@@ -208,6 +367,41 @@ Error JitRuntime::release(void* p) noexcept {
   return _memMgr.release(p);
 }
 
+// ============================================================================
+// [asmjit::HostRuntime - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+UNIT(base_runtime_publish) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  uint8_t* p = static_cast<uint8_t*>(runtime.getMemMgr()->alloc(16));
+
+  EXPECT(p != nullptr,
+    "Couldn't allocate virtual memory.");
+
+  // mov eax, 1; ret
+  static const uint8_t code[] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 };
+  ::memcpy(p, code, sizeof(code));
+  runtime.flush(p, sizeof(code));
+
+  INFO("Calling the original function.");
+  EXPECT(asmjit_cast<Func>(p)() == 1,
+    "Original function should return 1.");
+
+  INFO("Patching the immediate and publishing the change.");
+  Utils::writeU32u(p + 1, 2);
+  EXPECT(runtime.publish(p + 1, 4) == kErrorOk,
+    "HostRuntime::publish() failed.");
+
+  EXPECT(asmjit_cast<Func>(p)() == 2,
+    "Patched function should return 2.");
+
+  runtime.release(p);
+}
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+
 } // asmjit namespace
 
 // [Api-End]
@@ -162,6 +162,31 @@ class ASMJIT_VIRTAPI HostRuntime : public Runtime {
   //! This function can also be overridden to improve compatibility with tools
   //! such as Valgrind, however, it's not an official part of AsmJit.
   ASMJIT_API virtual void flush(void* p, size_t size) noexcept;
+
+  //! Publish code that has been patched while other threads may execute it.
+  //!
+  //! `flush()` is enough for a freshly generated code, because no thread can
+  //! execute it before its address is published. However, if the code is
+  //! modified in place (live patching of inline caches, entry stubs, etc...)
+  //! other cores may still execute stale instructions that were prefetched
+  //! or decoded before the modification. This function calls `flush()` and
+  //! then forces all cores that run threads of the current process to
+  //! serialize their instruction stream.
+  //!
+  //! The following mechanisms are used, the first available wins:
+  //!
+  //!   - Linux - `membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED_SYNC_CORE)`.
+  //!   - Linux - `membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED)`, which is core
+  //!     serializing on X86/X64 as it returns from an IPI via IRET.
+  //!   - POSIX - Changing protection of a private locked page, which causes
+  //!     the kernel to send TLB shootdown IPIs to all cores using the process.
+  //!   - Windows - `FlushProcessWriteBuffers()`.
+  //!
+  //! NOTE: The modification itself must be atomic from the perspective of an
+  //! executing thread, for example by writing an aligned 4 or 8 byte value
+  //! that doesn't cross a cache-line. This function only guarantees that once
+  //! it returns no core executes the code that was there before the patch.
+  ASMJIT_API virtual Error publish(void* p, size_t size) noexcept;
 };
 
 // ============================================================================
@@ -74,6 +74,26 @@ void Zone::reset(bool releaseMemory) noexcept {
   }
 }
 
+// ============================================================================
+// [asmjit::Zone - Accessors]
+// ============================================================================
+
+size_t Zone::getMemorySize() const noexcept {
+  const Block* cur = _block;
+  if (cur == &Zone_zeroBlock)
+    return 0;
+
+  // The current block can be in the middle of the double-linked list.
+  size_t size = 0;
+  for (const Block* block = cur; block != nullptr; block = block->prev)
+    size += block->getBlockSize();
+
+  for (const Block* block = cur->next; block != nullptr; block = block->next)
+    size += block->getBlockSize();
+
+  return size;
+}
+
 // ============================================================================
 // [asmjit::Zone - Alloc]
 // ============================================================================
@@ -119,6 +119,9 @@ class Zone {
     return _blockSize;
   }
 
+  //! Get the size of all blocks, including blocks kept by `reset(false)`.
+  ASMJIT_API size_t getMemorySize() const noexcept;
+
   // --------------------------------------------------------------------------
   // [Alloc]
   // --------------------------------------------------------------------------
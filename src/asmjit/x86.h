@@ -11,11 +11,17 @@
 // [Dependencies]
 #include "./base.h"
 
+#include "./x86/x86asmparser.h"
+#include "./x86/x86asmpool.h"
 #include "./x86/x86assembler.h"
 #include "./x86/x86compiler.h"
 #include "./x86/x86compilerfunc.h"
+#include "./x86/x86decoder.h"
+#include "./x86/x86fixed.h"
 #include "./x86/x86inst.h"
 #include "./x86/x86operand.h"
+#include "./x86/x86peephole.h"
+#include "./x86/x86stencil.h"
 
 // [Guard]
 #endif // _ASMJIT_X86_H
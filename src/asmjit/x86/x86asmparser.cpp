@@ -0,0 +1,1357 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Export]
+#define ASMJIT_EXPORTS
+
+// [Guard]
+#include "../build.h"
+#if !defined(ASMJIT_DISABLE_TEXT) && (defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64))
+
+// [Dependencies]
+#include "../base/utils.h"
+#include "../x86/x86asmparser.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+// ============================================================================
+// [asmjit::X86AsmParser - Helpers]
+// ============================================================================
+
+//! \internal
+//!
+//! Maximum length of a name matched against instructions, registers, and
+//! keywords, longer names can only be labels or symbols.
+enum { kX86AsmParserMaxName = 32 };
+
+static ASMJIT_INLINE bool X86AsmParser_isSpace(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+static ASMJIT_INLINE bool X86AsmParser_isDigit(char c) noexcept {
+  return static_cast<uint32_t>(static_cast<uint8_t>(c) - '0') < 10;
+}
+
+static ASMJIT_INLINE bool X86AsmParser_isNameStart(char c) noexcept {
+  return static_cast<uint32_t>((static_cast<uint8_t>(c) | 0x20) - 'a') < 26 || c == '_';
+}
+
+static ASMJIT_INLINE bool X86AsmParser_isNameChar(char c) noexcept {
+  return X86AsmParser_isNameStart(c) || X86AsmParser_isDigit(c) || c == '.';
+}
+
+static ASMJIT_INLINE uint32_t X86AsmParser_hexValue(char c) noexcept {
+  uint32_t d = static_cast<uint32_t>(static_cast<uint8_t>(c) - '0');
+  if (d < 10)
+    return d;
+
+  d = static_cast<uint32_t>((static_cast<uint8_t>(c) | 0x20) - 'a');
+  return d < 6 ? d + 10 : 16;
+}
+
+// Skip spaces and return whether the end of the line (or a comment) follows.
+static ASMJIT_INLINE bool X86AsmParser_skip(const char*& p, const char* end) noexcept {
+  while (p != end && X86AsmParser_isSpace(*p))
+    p++;
+  return p == end || *p == ';';
+}
+
+// Read a name and return its length.
+static ASMJIT_INLINE size_t X86AsmParser_readName(const char*& p, const char* end) noexcept {
+  const char* start = p;
+  while (p != end && X86AsmParser_isNameChar(*p))
+    p++;
+  return (size_t)(p - start);
+}
+
+// Copy `len` characters of `src` to `dst` as lower-case, fails if the name is
+// too long to be an instruction, a register, or a keyword.
+static ASMJIT_INLINE bool X86AsmParser_toLower(char* dst, const char* src, size_t len) noexcept {
+  if (len >= kX86AsmParserMaxName)
+    return false;
+
+  for (size_t i = 0; i < len; i++) {
+    char c = src[i];
+    dst[i] = static_cast<uint32_t>(static_cast<uint8_t>(c) - 'A') < 26 ? static_cast<char>(c + 0x20) : c;
+  }
+
+  dst[len] = '\0';
+  return true;
+}
+
+// Get whether `s` of `len` characters matches a null terminated keyword `kw`.
+static ASMJIT_INLINE bool X86AsmParser_eq(const char* s, size_t len, const char* kw) noexcept {
+  for (size_t i = 0; i < len; i++)
+    if (s[i] != kw[i])
+      return false;
+  return kw[len] == '\0';
+}
+
+static ASMJIT_INLINE uint32_t X86AsmParser_hashName(const char* name, size_t len) noexcept {
+  uint32_t hashCode = 0x811C9DC5U;
+  for (size_t i = 0; i < len; i++)
+    hashCode = (hashCode ^ static_cast<uint8_t>(name[i])) * 0x01000193U;
+  return hashCode;
+}
+
+// Parse a decimal, `0x` prefixed hexadecimal, or `h` suffixed hexadecimal
+// number.
+static bool X86AsmParser_parseNumber(const char*& p, const char* end, uint64_t& out) noexcept {
+  const char* s = p;
+  uint64_t value = 0;
+
+  if (s == end || !X86AsmParser_isDigit(*s))
+    return false;
+
+  if ((size_t)(end - s) >= 2 && s[0] == '0' && (s[1] | 0x20) == 'x') {
+    s += 2;
+
+    const char* start = s;
+    uint32_t d;
+
+    while (s != end && (d = X86AsmParser_hexValue(*s)) < 16) {
+      value = (value << 4) | d;
+      s++;
+    }
+
+    if (s == start)
+      return false;
+  }
+  else {
+    const char* start = s;
+    uint32_t d;
+
+    while (s != end && (d = X86AsmParser_hexValue(*s)) < 16) {
+      value = (value << 4) | d;
+      s++;
+    }
+
+    if (s != end && (*s | 0x20) == 'h') {
+      s++;
+    }
+    else {
+      value = 0;
+      for (s = start; s != end && X86AsmParser_isDigit(*s); s++)
+        value = value * 10 + static_cast<uint32_t>(*s - '0');
+    }
+  }
+
+  if (s != end && X86AsmParser_isNameChar(*s))
+    return false;
+
+  p = s;
+  out = value;
+  return true;
+}
+
+// Parse a register from a lower-case `name`.
+static bool X86AsmParser_parseReg(Operand& out, const char* name, size_t len) noexcept {
+  static const char legacyNames[] = "axcxdxbxspbpsidi";
+  static const char segNames[] = "\0\0" "es" "cs" "ss" "ds" "fs" "gs";
+
+  size_t i = 0;
+  while (i < len && !X86AsmParser_isDigit(name[i]))
+    i++;
+
+  // Registers without a number.
+  if (i == len) {
+    if (len < 2 || len > 3)
+      return false;
+
+    const char* s = len == 3 ? name + 1 : name;
+    uint32_t index;
+
+    for (index = 0; index < 8; index++)
+      if (legacyNames[index * 2] == s[0] && legacyNames[index * 2 + 1] == s[1])
+        break;
+
+    if (len == 2) {
+      if (index < 8) {
+        out = x86RegData.gpw[index];
+        return true;
+      }
+
+      static const char gpbNames[] = "acdb";
+      for (index = 0; index < 4; index++) {
+        if (gpbNames[index] == name[0]) {
+          if (name[1] == 'l') { out = x86RegData.gpbLo[index]; return true; }
+          if (name[1] == 'h') { out = x86RegData.gpbHi[index]; return true; }
+        }
+      }
+
+      for (index = 1; index < 7; index++) {
+        if (segNames[index * 2] == name[0] && segNames[index * 2 + 1] == name[1]) {
+          out = x86RegData.seg[index];
+          return true;
+        }
+      }
+
+      if (name[0] == 's' && name[1] == 't') {
+        out = x86RegData.fp[0];
+        return true;
+      }
+
+      return false;
+    }
+
+    // 3 characters.
+    if (index < 8) {
+      if (name[0] == 'e') { out = x86RegData.gpd[index]; return true; }
+      if (name[0] == 'r') { out = x86RegData.gpq[index]; return true; }
+    }
+
+    // `spl`, `bpl`, `sil`, and `dil`.
+    if (name[2] == 'l') {
+      for (index = 4; index < 8; index++) {
+        if (legacyNames[index * 2] == name[0] && legacyNames[index * 2 + 1] == name[1]) {
+          out = x86RegData.gpbLo[index];
+          return true;
+        }
+      }
+    }
+
+    if (X86AsmParser_eq(name, len, "rip")) {
+      out = x86RegData.rip;
+      return true;
+    }
+
+    return false;
+  }
+
+  // Registers with a number, at most 2 digits.
+  size_t prefixLen = i;
+  uint32_t index = static_cast<uint32_t>(name[i++] - '0');
+
+  if (i < len && X86AsmParser_isDigit(name[i])) {
+    if (index == 0)
+      return false;
+    index = index * 10 + static_cast<uint32_t>(name[i++] - '0');
+  }
+
+  size_t suffixLen = len - i;
+  if (suffixLen > 1)
+    return false;
+
+  if (prefixLen == 1 && name[0] == 'r') {
+    if (index < 8 || index >= 32)
+      return false;
+
+    if (suffixLen == 0) { out = x86RegData.gpq[index]; return true; }
+
+    switch (name[i]) {
+      case 'b': out = x86RegData.gpbLo[index]; return true;
+      case 'w': out = x86RegData.gpw[index]; return true;
+      case 'd': out = x86RegData.gpd[index]; return true;
+    }
+    return false;
+  }
+
+  if (suffixLen != 0)
+    return false;
+
+  if (prefixLen == 3 && name[1] == 'm' && name[2] == 'm' && index < 32) {
+    switch (name[0]) {
+      case 'x': out = x86RegData.xmm[index]; return true;
+      case 'y': out = x86RegData.ymm[index]; return true;
+      case 'z': out = x86RegData.zmm[index]; return true;
+    }
+    return false;
+  }
+
+  if (index >= 8)
+    return false;
+
+  if (prefixLen == 1 && name[0] == 'k') {
+    out = x86RegData.k[index];
+    return true;
+  }
+
+  if (prefixLen == 2) {
+    if (name[0] == 'm' && name[1] == 'm') { out = x86RegData.mm[index]; return true; }
+    if (name[0] == 'f' && name[1] == 'p') { out = x86RegData.fp[index]; return true; }
+    if (name[0] == 's' && name[1] == 't') { out = x86RegData.fp[index]; return true; }
+  }
+
+  return false;
+}
+
+// Get the size of a lower-case memory size keyword, zero if it's not a keyword.
+static uint32_t X86AsmParser_parseMemSize(const char* name, size_t len) noexcept {
+  static const struct { char name[8]; uint32_t size; } sizes[] = {
+    { "byte"   , 1  },
+    { "word"   , 2  },
+    { "dword"  , 4  },
+    { "qword"  , 8  },
+    { "tword"  , 10 },
+    { "dqword" , 16 },
+    { "oword"  , 16 },
+    { "xmmword", 16 },
+    { "yword"  , 32 },
+    { "ymmword", 32 },
+    { "zword"  , 64 },
+    { "zmmword", 64 }
+  };
+
+  if (len < 4 || len > 7)
+    return 0;
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(sizes); i++)
+    if (X86AsmParser_eq(name, len, sizes[i].name))
+      return sizes[i].size;
+
+  return 0;
+}
+
+// Parse a decorator `{...}` and add it to `options`.
+static bool X86AsmParser_parseDecorator(const char*& p, const char* end, uint32_t& options) noexcept {
+  const char* s = p + 1;
+  const char* start = s;
+
+  while (s != end && *s != '}')
+    s++;
+
+  if (s == end)
+    return false;
+
+  char name[kX86AsmParserMaxName];
+  size_t len = (size_t)(s - start);
+
+  if (!X86AsmParser_toLower(name, start, len))
+    return false;
+
+  p = s + 1;
+
+  if (len == 2 && name[0] == 'k' && name[1] >= '1' && name[1] <= '7') {
+    options |= static_cast<uint32_t>(name[1] - '0') << kX86InstOptionEvexK_Shift;
+    return true;
+  }
+
+  if (len >= 4 && name[0] == '1' && name[1] == 't' && name[2] == 'o') {
+    options |= kX86InstOptionEvexOneN;
+    return true;
+  }
+
+  static const struct { char name[8]; uint32_t option; } decorators[] = {
+    { "z"     , kX86InstOptionEvexZero  },
+    { "sae"   , kX86InstOptionEvexSae   },
+    { "rn-sae", kX86InstOptionEvexRnSae },
+    { "rd-sae", kX86InstOptionEvexRdSae },
+    { "ru-sae", kX86InstOptionEvexRuSae },
+    { "rz-sae", kX86InstOptionEvexRzSae },
+    { "nf"    , kX86InstOptionNf        },
+    { "vex3"  , kX86InstOptionVex3      },
+    { "evex"  , kX86InstOptionEvex      }
+  };
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(decorators); i++) {
+    if (X86AsmParser_eq(name, len, decorators[i].name)) {
+      options |= decorators[i].option;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// ============================================================================
+// [asmjit::X86AsmParser - Target]
+// ============================================================================
+
+static Error X86AsmParser_emit(X86AsmParser* self, uint32_t code, uint32_t options, const Operand* ops, uint32_t opCount) noexcept {
+  if (self->_assembler != nullptr) {
+    self->_assembler->setInstOptions(options);
+    return self->_assembler->emit(code, ops[0], ops[1], ops[2], ops[3]);
+  }
+
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  // Compiler keeps the count of operands, which must match the instruction.
+  X86Compiler* compiler = self->_compiler;
+  compiler->setInstOptions(options);
+
+  HLInst* node;
+  switch (opCount) {
+    case 0 : node = compiler->emit(code); break;
+    case 1 : node = compiler->emit(code, ops[0]); break;
+    case 2 : node = compiler->emit(code, ops[0], ops[1]); break;
+    case 3 : node = compiler->emit(code, ops[0], ops[1], ops[2]); break;
+    default: node = compiler->emit(code, ops[0], ops[1], ops[2], ops[3]); break;
+  }
+
+  if (node == nullptr) {
+    Error error = compiler->getLastError();
+    return error != kErrorOk ? error : static_cast<Error>(kErrorNoHeapMemory);
+  }
+#else
+  ASMJIT_UNUSED(opCount);
+#endif // !ASMJIT_DISABLE_COMPILER
+
+  return kErrorOk;
+}
+
+static Label X86AsmParser_newLabel(X86AsmParser* self) noexcept {
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  if (self->_compiler != nullptr)
+    return self->_compiler->newLabel();
+#endif // !ASMJIT_DISABLE_COMPILER
+  return self->_assembler->newLabel();
+}
+
+static Error X86AsmParser_bind(X86AsmParser* self, const Label& label) noexcept {
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  if (self->_compiler != nullptr)
+    return self->_compiler->bind(label);
+#endif // !ASMJIT_DISABLE_COMPILER
+  return self->_assembler->bind(label);
+}
+
+static Error X86AsmParser_align(X86AsmParser* self, uint32_t offset) noexcept {
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  if (self->_compiler != nullptr)
+    return self->_compiler->align(kAlignCode, offset);
+#endif // !ASMJIT_DISABLE_COMPILER
+  return self->_assembler->align(kAlignCode, offset);
+}
+
+static Error X86AsmParser_embed(X86AsmParser* self, const void* data, uint32_t size) noexcept {
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  if (self->_compiler != nullptr)
+    return self->_compiler->embed(data, size);
+#endif // !ASMJIT_DISABLE_COMPILER
+  return self->_assembler->embed(data, size);
+}
+
+// ============================================================================
+// [asmjit::X86AsmParser - Symbols]
+// ============================================================================
+
+static X86AsmParser::Symbol* X86AsmParser_findSymbol(X86AsmParser* self, const char* name, size_t len, uint32_t hashCode) noexcept {
+  if (self->_symbolCapacity == 0)
+    return nullptr;
+
+  size_t mask = self->_symbolCapacity - 1;
+  size_t i = hashCode & mask;
+
+  for (;;) {
+    X86AsmParser::Symbol* symbol = &self->_symbols[i];
+    if (symbol->name == nullptr)
+      return nullptr;
+
+    if (symbol->hashCode == hashCode && symbol->length == len && ::memcmp(symbol->name, name, len) == 0)
+      return symbol;
+
+    i = (i + 1) & mask;
+  }
+}
+
+static X86AsmParser::Symbol* X86AsmParser_newSymbol(X86AsmParser* self, const char* name, size_t len, uint32_t hashCode, const Operand& op) noexcept {
+  // Keep the table at most half full.
+  if ((self->_symbolCount + 1) * 2 > self->_symbolCapacity) {
+    size_t newCapacity = self->_symbolCapacity != 0 ? self->_symbolCapacity * 2 : 64;
+    X86AsmParser::Symbol* newSymbols = static_cast<X86AsmParser::Symbol*>(
+      ASMJIT_ALLOC(newCapacity * sizeof(X86AsmParser::Symbol)));
+
+    if (newSymbols == nullptr)
+      return nullptr;
+
+    for (size_t i = 0; i < newCapacity; i++)
+      new(&newSymbols[i]) X86AsmParser::Symbol();
+
+    X86AsmParser::Symbol* oldSymbols = self->_symbols;
+    size_t oldCapacity = self->_symbolCapacity;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+      if (oldSymbols[i].name == nullptr)
+        continue;
+
+      size_t j = oldSymbols[i].hashCode & (newCapacity - 1);
+      while (newSymbols[j].name != nullptr)
+        j = (j + 1) & (newCapacity - 1);
+      newSymbols[j] = oldSymbols[i];
+    }
+
+    if (oldSymbols != nullptr)
+      ASMJIT_FREE(oldSymbols);
+
+    self->_symbols = newSymbols;
+    self->_symbolCapacity = newCapacity;
+  }
+
+  char* nameCopy = static_cast<char*>(self->_zone.alloc(len + 1));
+  if (nameCopy == nullptr)
+    return nullptr;
+
+  ::memcpy(nameCopy, name, len);
+  nameCopy[len] = '\0';
+
+  size_t mask = self->_symbolCapacity - 1;
+  size_t i = hashCode & mask;
+
+  while (self->_symbols[i].name != nullptr)
+    i = (i + 1) & mask;
+
+  X86AsmParser::Symbol* symbol = &self->_symbols[i];
+  symbol->name = nameCopy;
+  symbol->length = static_cast<uint32_t>(len);
+  symbol->hashCode = hashCode;
+  symbol->op = op;
+
+  self->_symbolCount++;
+  return symbol;
+}
+
+// Get the operand of a symbol or a label `name`, creates a label if the name
+// is not known.
+static Error X86AsmParser_getSymbol(X86AsmParser* self, const char* name, size_t len, Operand& out) noexcept {
+  uint32_t hashCode = X86AsmParser_hashName(name, len);
+  X86AsmParser::Symbol* symbol = X86AsmParser_findSymbol(self, name, len, hashCode);
+
+  if (symbol == nullptr) {
+    Label label = X86AsmParser_newLabel(self);
+    if (!label.isInitialized())
+      return kErrorNoHeapMemory;
+
+    symbol = X86AsmParser_newSymbol(self, name, len, hashCode, label);
+    if (symbol == nullptr)
+      return kErrorNoHeapMemory;
+  }
+
+  out = symbol->op;
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86AsmParser - Construction / Destruction]
+// ============================================================================
+
+X86AsmParser::X86AsmParser(X86Assembler* assembler) noexcept
+  : _assembler(assembler),
+#if !defined(ASMJIT_DISABLE_COMPILER)
+    _compiler(nullptr),
+#endif // !ASMJIT_DISABLE_COMPILER
+    _lineCount(0),
+    _errorLine(0),
+    _symbols(nullptr),
+    _symbolCapacity(0),
+    _symbolCount(0),
+    _zone(4096 - Zone::kZoneOverhead) {}
+
+#if !defined(ASMJIT_DISABLE_COMPILER)
+X86AsmParser::X86AsmParser(X86Compiler* compiler) noexcept
+  : _assembler(nullptr),
+    _compiler(compiler),
+    _lineCount(0),
+    _errorLine(0),
+    _symbols(nullptr),
+    _symbolCapacity(0),
+    _symbolCount(0),
+    _zone(4096 - Zone::kZoneOverhead) {}
+#endif // !ASMJIT_DISABLE_COMPILER
+
+X86AsmParser::~X86AsmParser() noexcept {
+  reset(true);
+}
+
+// ============================================================================
+// [asmjit::X86AsmParser - Reset]
+// ============================================================================
+
+void X86AsmParser::reset(bool releaseMemory) noexcept {
+  if (releaseMemory && _symbols != nullptr) {
+    ASMJIT_FREE(_symbols);
+    _symbols = nullptr;
+    _symbolCapacity = 0;
+  }
+  else if (_symbolCount != 0) {
+    for (size_t i = 0; i < _symbolCapacity; i++)
+      _symbols[i] = Symbol();
+  }
+
+  _lineCount = 0;
+  _errorLine = 0;
+  _symbolCount = 0;
+  _zone.reset(releaseMemory);
+}
+
+// ============================================================================
+// [asmjit::X86AsmParser - Symbols]
+// ============================================================================
+
+Error X86AsmParser::addSymbol(const char* name, const Operand& op) noexcept {
+  size_t len = ::strlen(name);
+  uint32_t hashCode = X86AsmParser_hashName(name, len);
+
+  Symbol* symbol = X86AsmParser_findSymbol(this, name, len, hashCode);
+  if (symbol != nullptr) {
+    symbol->op = op;
+    return kErrorOk;
+  }
+
+  if (X86AsmParser_newSymbol(this, name, len, hashCode, op) == nullptr)
+    return kErrorNoHeapMemory;
+
+  return kErrorOk;
+}
+
+Label X86AsmParser::getLabel(const char* name, size_t len) noexcept {
+  if (len == kInvalidIndex)
+    len = ::strlen(name);
+
+  Operand op;
+  if (X86AsmParser_getSymbol(this, name, len, op) != kErrorOk || !op.isLabel())
+    return Label();
+
+  return static_cast<const Label&>(op);
+}
+
+// ============================================================================
+// [asmjit::X86AsmParser - Parse]
+// ============================================================================
+
+// Parse a memory operand starting at `[`.
+static Error X86AsmParser_parseMem(X86AsmParser* self, const char*& p, const char* end, Operand& out, uint32_t size, uint32_t seg) noexcept {
+  Operand base;
+  Operand index;
+  uint32_t shift = 0;
+  int64_t disp = 0;
+  bool first = true;
+
+  char name[kX86AsmParserMaxName];
+  p++;
+
+  for (;;) {
+    if (X86AsmParser_skip(p, end))
+      return kErrorInvalidSyntax;
+
+    if (*p == ']') {
+      if (first)
+        return kErrorInvalidSyntax;
+      p++;
+      break;
+    }
+
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+      negative = *p == '-';
+      p++;
+      if (X86AsmParser_skip(p, end))
+        return kErrorInvalidSyntax;
+    }
+    else if (!first) {
+      return kErrorInvalidSyntax;
+    }
+    first = false;
+
+    // Displacement or `scale * index`.
+    uint64_t value;
+    if (X86AsmParser_parseNumber(p, end, value)) {
+      if (X86AsmParser_skip(p, end) || *p != '*') {
+        disp = negative ? disp - static_cast<int64_t>(value) : disp + static_cast<int64_t>(value);
+        continue;
+      }
+
+      p++;
+      if (X86AsmParser_skip(p, end) || negative || !index.isNone())
+        return kErrorInvalidSyntax;
+
+      const char* start = p;
+      size_t len = X86AsmParser_readName(p, end);
+
+      if (!X86AsmParser_toLower(name, start, len) || !X86AsmParser_parseReg(index, name, len))
+        return kErrorInvalidSyntax;
+
+      switch (value) {
+        case 1: shift = 0; break;
+        case 2: shift = 1; break;
+        case 4: shift = 2; break;
+        case 8: shift = 3; break;
+        default: return kErrorInvalidSyntax;
+      }
+      continue;
+    }
+
+    // Register, label, or symbol.
+    if (!X86AsmParser_isNameStart(*p) || negative)
+      return kErrorInvalidSyntax;
+
+    const char* start = p;
+    size_t len = X86AsmParser_readName(p, end);
+
+    Operand op;
+    if (!X86AsmParser_toLower(name, start, len) || !X86AsmParser_parseReg(op, name, len))
+      ASMJIT_PROPAGATE_ERROR(X86AsmParser_getSymbol(self, start, len, op));
+
+    // A label or a memory symbol is always the base.
+    if (op.isLabel() || op.isMem()) {
+      if (!base.isNone())
+        return kErrorInvalidSyntax;
+      base = op;
+      continue;
+    }
+
+    if (!op.isReg() && !op.isVar())
+      return kErrorInvalidSyntax;
+
+    // `index * scale`.
+    if (!X86AsmParser_skip(p, end) && *p == '*') {
+      p++;
+      if (X86AsmParser_skip(p, end) || !index.isNone() || !X86AsmParser_parseNumber(p, end, value))
+        return kErrorInvalidSyntax;
+
+      switch (value) {
+        case 1: shift = 0; break;
+        case 2: shift = 1; break;
+        case 4: shift = 2; break;
+        case 8: shift = 3; break;
+        default: return kErrorInvalidSyntax;
+      }
+
+      index = op;
+      continue;
+    }
+
+    if (base.isNone())
+      base = op;
+    else if (index.isNone())
+      index = op;
+    else
+      return kErrorInvalidSyntax;
+  }
+
+  X86Mem m;
+  int32_t disp32 = static_cast<int32_t>(disp);
+
+  if (!base.isNone() && !Utils::isInt32(disp))
+    return kErrorIllegalDisplacement;
+
+  if (base.isNone()) {
+    if (index.isNone())
+      m = x86::ptr_abs(static_cast<Ptr>(disp), 0, size);
+    else if (index.isReg())
+      m = x86::ptr_abs(static_cast<Ptr>(disp), static_cast<const X86Reg&>(index), shift, 0, size);
+    else
+      return kErrorIllegalAddresing;
+  }
+  else if (base.isMem()) {
+    // Memory symbol, only displacement can be added.
+    if (!index.isNone())
+      return kErrorIllegalAddresing;
+
+    m = static_cast<const X86Mem&>(base);
+    m.adjust(disp32);
+    if (size != 0)
+      m.setSize(size);
+  }
+  else if (base.isLabel()) {
+    const Label& label = static_cast<const Label&>(base);
+
+    if (index.isNone())
+      m = X86Mem(label, disp32, size);
+    else if (index.isReg() && static_cast<const X86Reg&>(index).isGp())
+      m = X86Mem(label, static_cast<const X86GpReg&>(index), shift, disp32, size);
+#if !defined(ASMJIT_DISABLE_COMPILER)
+    else if (index.isVar() && static_cast<const X86Var&>(index).isGp())
+      m = X86Mem(label, static_cast<const X86GpVar&>(index), shift, disp32, size);
+#endif // !ASMJIT_DISABLE_COMPILER
+    else
+      return kErrorIllegalAddresing;
+  }
+  else if (base.isReg()) {
+    const X86Reg& baseReg = static_cast<const X86Reg&>(base);
+
+    if (baseReg.getRegType() == kX86RegTypeRip) {
+      if (!index.isNone())
+        return kErrorIllegalAddresing;
+      m = X86Mem(static_cast<const X86RipReg&>(baseReg), disp32, size);
+    }
+    else if (!baseReg.isGp() || (!index.isNone() && !index.isReg())) {
+      return kErrorIllegalAddresing;
+    }
+    else if (index.isNone()) {
+      m = X86Mem(static_cast<const X86GpReg&>(baseReg), disp32, size);
+    }
+    else {
+      const X86Reg& indexReg = static_cast<const X86Reg&>(index);
+
+      if (indexReg.isGp())
+        m = X86Mem(static_cast<const X86GpReg&>(baseReg), static_cast<const X86GpReg&>(indexReg), shift, disp32, size);
+      else if (indexReg.isXmm())
+        m = X86Mem(static_cast<const X86GpReg&>(baseReg), static_cast<const X86XmmReg&>(indexReg), shift, disp32, size);
+      else if (indexReg.isYmm())
+        m = X86Mem(static_cast<const X86GpReg&>(baseReg), static_cast<const X86YmmReg&>(indexReg), shift, disp32, size);
+      else
+        return kErrorIllegalAddresing;
+    }
+  }
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  else {
+    const X86Var& baseVar = static_cast<const X86Var&>(base);
+
+    if (!baseVar.isGp() || (!index.isNone() && !index.isVar()))
+      return kErrorIllegalAddresing;
+
+    if (index.isNone()) {
+      m = X86Mem(static_cast<const X86GpVar&>(baseVar), disp32, size);
+    }
+    else {
+      const X86Var& indexVar = static_cast<const X86Var&>(index);
+
+      if (indexVar.isGp())
+        m = X86Mem(static_cast<const X86GpVar&>(baseVar), static_cast<const X86GpVar&>(indexVar), shift, disp32, size);
+      else if (indexVar.isXmm())
+        m = X86Mem(static_cast<const X86GpVar&>(baseVar), static_cast<const X86XmmVar&>(indexVar), shift, disp32, size);
+      else if (indexVar.isYmm())
+        m = X86Mem(static_cast<const X86GpVar&>(baseVar), static_cast<const X86YmmVar&>(indexVar), shift, disp32, size);
+      else
+        return kErrorIllegalAddresing;
+    }
+  }
+#else
+  else {
+    return kErrorIllegalAddresing;
+  }
+#endif // !ASMJIT_DISABLE_COMPILER
+
+  if (seg != kX86SegDefault)
+    m.setSegment(seg);
+
+  out = m;
+  return kErrorOk;
+}
+
+// Parse an operand.
+static Error X86AsmParser_parseOperand(X86AsmParser* self, const char*& p, const char* end, Operand& out) noexcept {
+  char c = *p;
+
+  if (c == '[')
+    return X86AsmParser_parseMem(self, p, end, out, 0, kX86SegDefault);
+
+  // Immediate.
+  if (c == '-' || c == '+' || X86AsmParser_isDigit(c)) {
+    bool negative = c == '-';
+    if (!X86AsmParser_isDigit(c)) {
+      p++;
+      X86AsmParser_skip(p, end);
+    }
+
+    uint64_t value;
+    if (!X86AsmParser_parseNumber(p, end, value))
+      return kErrorInvalidSyntax;
+
+    out = Imm(negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value));
+    return kErrorOk;
+  }
+
+  if (!X86AsmParser_isNameStart(c))
+    return kErrorInvalidSyntax;
+
+  const char* start = p;
+  size_t len = X86AsmParser_readName(p, end);
+
+  char name[kX86AsmParserMaxName];
+  if (!X86AsmParser_toLower(name, start, len))
+    return X86AsmParser_getSymbol(self, start, len, out);
+
+  // Register or segment override.
+  if (X86AsmParser_parseReg(out, name, len)) {
+    const X86Reg& reg = static_cast<const X86Reg&>(out);
+
+    if (reg.getRegType() == kX86RegTypeSeg) {
+      const char* s = p;
+      if (!X86AsmParser_skip(s, end) && *s == ':') {
+        s++;
+        if (X86AsmParser_skip(s, end) || *s != '[')
+          return kErrorInvalidSyntax;
+
+        p = s;
+        return X86AsmParser_parseMem(self, p, end, out, 0, reg.getRegIndex());
+      }
+    }
+
+    if (reg.getRegType() == kX86RegTypeRip)
+      return kErrorInvalidSyntax;
+
+    return kErrorOk;
+  }
+
+  // `size [ptr] [seg:][...]`.
+  uint32_t size = X86AsmParser_parseMemSize(name, len);
+  if (size != 0) {
+    uint32_t seg = kX86SegDefault;
+
+    if (X86AsmParser_skip(p, end))
+      return kErrorInvalidSyntax;
+
+    if (X86AsmParser_isNameStart(*p)) {
+      start = p;
+      len = X86AsmParser_readName(p, end);
+
+      if (!X86AsmParser_toLower(name, start, len))
+        return kErrorInvalidSyntax;
+
+      if (X86AsmParser_eq(name, len, "ptr")) {
+        if (X86AsmParser_skip(p, end))
+          return kErrorInvalidSyntax;
+
+        if (X86AsmParser_isNameStart(*p)) {
+          start = p;
+          len = X86AsmParser_readName(p, end);
+
+          if (!X86AsmParser_toLower(name, start, len))
+            return kErrorInvalidSyntax;
+        }
+        else {
+          len = 0;
+        }
+      }
+
+      if (len != 0) {
+        Operand segReg;
+        if (!X86AsmParser_parseReg(segReg, name, len) || !static_cast<const X86Reg&>(segReg).isRegType(kX86RegTypeSeg))
+          return kErrorInvalidSyntax;
+
+        seg = static_cast<const X86Reg&>(segReg).getRegIndex();
+        if (X86AsmParser_skip(p, end) || *p != ':')
+          return kErrorInvalidSyntax;
+
+        p++;
+        if (X86AsmParser_skip(p, end))
+          return kErrorInvalidSyntax;
+      }
+    }
+
+    if (*p != '[')
+      return kErrorInvalidSyntax;
+
+    return X86AsmParser_parseMem(self, p, end, out, size, seg);
+  }
+
+  return X86AsmParser_getSymbol(self, start, len, out);
+}
+
+// Parse a directive starting at `.`.
+static Error X86AsmParser_parseDirective(X86AsmParser* self, const char*& p, const char* end) noexcept {
+  char name[kX86AsmParserMaxName];
+
+  const char* start = ++p;
+  size_t len = X86AsmParser_readName(p, end);
+
+  if (!X86AsmParser_toLower(name, start, len))
+    return kErrorInvalidSyntax;
+
+  uint64_t value;
+
+  if (X86AsmParser_eq(name, len, "align")) {
+    if (X86AsmParser_skip(p, end) || !X86AsmParser_parseNumber(p, end, value) || value > 64)
+      return kErrorInvalidSyntax;
+
+    if (!X86AsmParser_skip(p, end))
+      return kErrorInvalidSyntax;
+
+    return X86AsmParser_align(self, static_cast<uint32_t>(value));
+  }
+
+  uint32_t size;
+  if (X86AsmParser_eq(name, len, "db"))
+    size = 1;
+  else if (X86AsmParser_eq(name, len, "dw"))
+    size = 2;
+  else if (X86AsmParser_eq(name, len, "dd"))
+    size = 4;
+  else if (X86AsmParser_eq(name, len, "dq"))
+    size = 8;
+  else
+    return kErrorInvalidSyntax;
+
+  // Values are collected and embedded in chunks.
+  uint8_t buffer[128];
+  uint32_t length = 0;
+
+  for (;;) {
+    if (X86AsmParser_skip(p, end))
+      return kErrorInvalidSyntax;
+
+    bool negative = *p == '-';
+    if (negative) {
+      p++;
+      X86AsmParser_skip(p, end);
+    }
+
+    if (!X86AsmParser_parseNumber(p, end, value))
+      return kErrorInvalidSyntax;
+
+    if (negative)
+      value = static_cast<uint64_t>(-static_cast<int64_t>(value));
+
+    if (length + size > sizeof(buffer)) {
+      ASMJIT_PROPAGATE_ERROR(X86AsmParser_embed(self, buffer, length));
+      length = 0;
+    }
+
+    for (uint32_t i = 0; i < size; i++)
+      buffer[length++] = static_cast<uint8_t>(value >> (i * 8));
+
+    if (X86AsmParser_skip(p, end))
+      break;
+
+    if (*p != ',')
+      return kErrorInvalidSyntax;
+    p++;
+  }
+
+  return X86AsmParser_embed(self, buffer, length);
+}
+
+// Parse a single line (without the line terminator).
+static Error X86AsmParser_parseLine(X86AsmParser* self, const char* p, const char* end) noexcept {
+  if (X86AsmParser_skip(p, end))
+    return kErrorOk;
+
+  if (*p == '.')
+    return X86AsmParser_parseDirective(self, p, end);
+
+  char name[kX86AsmParserMaxName * 2];
+  size_t len;
+
+  uint32_t options = 0;
+  uint32_t code;
+
+  // Labels and prefixes.
+  for (;;) {
+    if (*p == '{') {
+      if (!X86AsmParser_parseDecorator(p, end, options))
+        return kErrorInvalidSyntax;
+
+      if (X86AsmParser_skip(p, end))
+        return kErrorInvalidSyntax;
+      continue;
+    }
+
+    if (!X86AsmParser_isNameStart(*p))
+      return kErrorInvalidSyntax;
+
+    const char* start = p;
+    len = X86AsmParser_readName(p, end);
+
+    const char* s = p;
+    bool isEnd = X86AsmParser_skip(s, end);
+
+    if (!isEnd && *s == ':') {
+      if (options != 0)
+        return kErrorInvalidSyntax;
+
+      Operand label;
+      ASMJIT_PROPAGATE_ERROR(X86AsmParser_getSymbol(self, start, len, label));
+
+      if (!label.isLabel())
+        return kErrorInvalidSyntax;
+
+      ASMJIT_PROPAGATE_ERROR(X86AsmParser_bind(self, static_cast<const Label&>(label)));
+
+      p = s + 1;
+      if (X86AsmParser_skip(p, end))
+        return kErrorOk;
+      continue;
+    }
+
+    if (!X86AsmParser_toLower(name, start, len))
+      return kErrorUnknownInst;
+
+    p = s;
+
+    uint32_t prefix = 0;
+    switch (len) {
+      case 3:
+        if (X86AsmParser_eq(name, len, "rex")) prefix = kX86InstOptionRex;
+        break;
+      case 4:
+        if (X86AsmParser_eq(name, len, "lock")) prefix = kX86InstOptionLock;
+        else if (X86AsmParser_eq(name, len, "rex2")) prefix = kX86InstOptionRex2;
+        else if (X86AsmParser_eq(name, len, "long")) prefix = kInstOptionLongForm;
+        break;
+      case 5:
+        if (X86AsmParser_eq(name, len, "short")) prefix = kInstOptionShortForm;
+        break;
+    }
+
+    if (prefix == 0)
+      break;
+
+    if (isEnd)
+      return kErrorInvalidSyntax;
+
+    options |= prefix;
+  }
+
+  code = X86Util::getInstIdByName(name, len);
+
+  // Instructions like `rep movs_b` have a space in their names.
+  if (code == kInstIdNone && name[0] == 'r' && !X86AsmParser_skip(p, end) && X86AsmParser_isNameStart(*p)) {
+    const char* start = p;
+    size_t nextLen = X86AsmParser_readName(p, end);
+
+    name[len] = ' ';
+    if (nextLen >= kX86AsmParserMaxName || !X86AsmParser_toLower(name + len + 1, start, nextLen))
+      return kErrorUnknownInst;
+
+    code = X86Util::getInstIdByName(name, len + 1 + nextLen);
+  }
+
+  if (code == kInstIdNone)
+    return kErrorUnknownInst;
+
+  // Operands.
+  Operand ops[4];
+  uint32_t opCount = 0;
+
+  if (!X86AsmParser_skip(p, end)) {
+    for (;;) {
+      if (*p == '{') {
+        // `{sae}` and rounding modes are written as the last operand.
+        if (!X86AsmParser_parseDecorator(p, end, options))
+          return kErrorInvalidSyntax;
+      }
+      else {
+        if (opCount == ASMJIT_ARRAY_SIZE(ops))
+          return kErrorInvalidSyntax;
+
+        ASMJIT_PROPAGATE_ERROR(X86AsmParser_parseOperand(self, p, end, ops[opCount]));
+        opCount++;
+
+        // Opmask, zeroing, and broadcast decorators.
+        while (!X86AsmParser_skip(p, end) && *p == '{') {
+          if (!X86AsmParser_parseDecorator(p, end, options))
+            return kErrorInvalidSyntax;
+        }
+      }
+
+      if (X86AsmParser_skip(p, end))
+        break;
+
+      if (*p != ',')
+        return kErrorInvalidSyntax;
+
+      p++;
+      if (X86AsmParser_skip(p, end))
+        return kErrorInvalidSyntax;
+    }
+  }
+
+  return X86AsmParser_emit(self, code, options, ops, opCount);
+}
+
+Error X86AsmParser::parse(const char* input, size_t size) noexcept {
+  if (size == kInvalidIndex)
+    size = ::strlen(input);
+
+  const char* p = input;
+  const char* end = input + size;
+
+  uint32_t line = 0;
+  _errorLine = 0;
+
+  while (p != end) {
+    const char* eol = static_cast<const char*>(::memchr(p, '\n', (size_t)(end - p)));
+    if (eol == nullptr)
+      eol = end;
+
+    line++;
+    Error error = X86AsmParser_parseLine(this, p, eol);
+
+    if (error != kErrorOk) {
+      _lineCount += line;
+      _errorLine = line;
+      return error;
+    }
+
+    p = eol;
+    if (p != end)
+      p++;
+  }
+
+  _lineCount += line;
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86AsmParser - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+UNIT(x86_asm_parser) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+
+  // Parse and run a simple loop.
+  {
+    X86Assembler a(&runtime);
+    X86AsmParser parser(&a);
+
+    Error err = parser.parse(
+      "  xor eax, eax        ; Sum.\n"
+      "  mov ecx, 10\n"
+      "L_Loop:\n"
+      "  add eax, ecx\n"
+      "  dec ecx\n"
+      "  jnz L_Loop\n"
+      "  ret\n");
+
+    EXPECT(err == kErrorOk,
+      "Parsing failed at line %u: %s.", parser.getErrorLine(), DebugUtils::errorAsString(err));
+    EXPECT(parser.getLineCount() == 7,
+      "Parser should count 7 lines, not %u.", parser.getLineCount());
+
+    Func func = asmjit_cast<Func>(a.make());
+    EXPECT(func != nullptr,
+      "Couldn't make the function.");
+
+    int result = func();
+    EXPECT(result == 55,
+      "Function returned %d instead of 55.", result);
+
+    runtime.release((void*)func);
+  }
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  // Logger output parsed back must encode to the same bytes.
+  {
+    StringLogger logger;
+    X86Assembler a(&runtime);
+    X86Assembler b(&runtime);
+    X86AsmParser parser(&b);
+
+    a.setLogger(&logger);
+
+    Label L = a.newLabel();
+    a.bind(L);
+    a.mov(a.zax, a.zcx);
+    a.add(a.zax, x86::ptr(a.zsi, a.zcx, 2, -16));
+    a.lea(x86::edx, x86::ptr(x86::edx, 0x12345));
+    a.mov(x86::byte_ptr(a.zdi), 0x7F);
+    a.lock().inc(x86::dword_ptr(a.zdx));
+    a.mov(x86::eax, x86::dword_ptr_abs(0x1000).setSegment(x86::fs));
+    a.movzx(x86::ecx, x86::byte_ptr(x86::ecx));
+    a.shl(x86::cl, 3);
+    a.test(x86::ah, x86::bh);
+    a.movaps(x86::xmm1, x86::ptr(a.zsp, 32));
+    a.vpaddd(x86::ymm0, x86::ymm1, x86::ymm2);
+    a.vpaddd(x86::zmm0, x86::zmm1, x86::zmm2);
+    a.k(x86::k1).z().vaddps(x86::zmm3, x86::zmm4, x86::zmm5);
+    a.fld(x86::fp1);
+    a.rep_movsb();
+    a.align(kAlignCode, 16);
+    a.jnz(L);
+    a.call(L);
+    a.ret(8);
+
+    EXPECT(a.getLastError() == kErrorOk,
+      "Emitting failed.");
+
+    const char* text = logger.getString();
+    Error err = parser.parse(text);
+
+    EXPECT(err == kErrorOk,
+      "Parsing failed at line %u: %s.\n%s", parser.getErrorLine(), DebugUtils::errorAsString(err), text);
+    EXPECT(a.getCodeSize() == b.getCodeSize() && ::memcmp(a.getBuffer(), b.getBuffer(), a.getCodeSize()) == 0,
+      "Parsed code doesn't match the original code:\n%s", text);
+  }
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  // Errors are reported with the line where they occurred.
+  {
+    X86Assembler a(&runtime);
+    X86AsmParser parser(&a);
+
+    Error err = parser.parse("nop\n\n  mov eax, [eax +]\nret\n");
+    EXPECT(err == kErrorInvalidSyntax && parser.getErrorLine() == 3,
+      "Expected invalid syntax at line 3, got %s at line %u.", DebugUtils::errorAsString(err), parser.getErrorLine());
+
+    err = parser.parse("nop\nmovx eax, ecx\n");
+    EXPECT(err == kErrorUnknownInst && parser.getErrorLine() == 2,
+      "Expected unknown instruction at line 2, got %s at line %u.", DebugUtils::errorAsString(err), parser.getErrorLine());
+
+    err = parser.parse("MOV EAX, [EAX + 0x10]\n.db 1, 2, 0xFF\n.align 4\nret");
+    EXPECT(err == kErrorOk && parser.getErrorLine() == 0,
+      "Parsing failed at line %u: %s.", parser.getErrorLine(), DebugUtils::errorAsString(err));
+  }
+
+  // Symbols survive growing of the table and are forgotten by `reset()`.
+  {
+    X86Assembler a(&runtime);
+    X86AsmParser parser(&a);
+
+    enum { kSymbolCount = 200 };
+    uint32_t labelIds[kSymbolCount];
+    char name[16];
+    uint32_t i;
+
+    for (i = 0; i < kSymbolCount; i++) {
+      snprintf(name, ASMJIT_ARRAY_SIZE(name), "L%u", i);
+      labelIds[i] = parser.getLabel(name).getId();
+    }
+
+    for (i = 0; i < kSymbolCount; i++) {
+      snprintf(name, ASMJIT_ARRAY_SIZE(name), "L%u", i);
+      EXPECT(parser.getLabel(name).getId() == labelIds[i],
+        "Symbol '%s' should refer to the same label.", name);
+    }
+
+    parser.reset();
+    EXPECT(parser.getLabel("L0").getId() != labelIds[0],
+      "Symbols should be forgotten by reset().");
+  }
+
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  // Symbols refer to compiler variables.
+  {
+    X86Assembler a(&runtime);
+    X86Compiler c(&a);
+    X86AsmParser parser(&c);
+
+    c.addFunc(FuncBuilder0<int>(kCallConvHost));
+
+    X86GpVar x = c.newInt32("x");
+    X86GpVar y = c.newInt32("y");
+
+    parser.addSymbol("x", x);
+    parser.addSymbol("y", y);
+
+    Error err = parser.parse(
+      "mov x, 6\n"
+      "mov y, 7\n"
+      "imul x, y\n");
+
+    EXPECT(err == kErrorOk,
+      "Parsing failed at line %u: %s.", parser.getErrorLine(), DebugUtils::errorAsString(err));
+
+    c.ret(x);
+    c.endFunc();
+    c.finalize();
+
+    Func func = asmjit_cast<Func>(a.make());
+    EXPECT(func != nullptr,
+      "Couldn't make the function.");
+
+    int result = func();
+    EXPECT(result == 42,
+      "Function returned %d instead of 42.", result);
+
+    runtime.release((void*)func);
+  }
+#endif // !ASMJIT_DISABLE_COMPILER
+}
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // !ASMJIT_DISABLE_TEXT && (ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64)
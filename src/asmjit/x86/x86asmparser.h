@@ -0,0 +1,196 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Guard]
+#ifndef _ASMJIT_X86_X86ASMPARSER_H
+#define _ASMJIT_X86_X86ASMPARSER_H
+
+#include "../build.h"
+#if !defined(ASMJIT_DISABLE_TEXT)
+
+// [Dependencies]
+#include "../base/zone.h"
+#include "../x86/x86assembler.h"
+#include "../x86/x86compiler.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+//! \addtogroup asmjit_x86
+//! \{
+
+// ============================================================================
+// [asmjit::X86AsmParser]
+// ============================================================================
+
+//! X86/X64 assembly text parser.
+//!
+//! Parser reads Intel syntax assembly and emits it to `X86Assembler` or
+//! `X86Compiler` as it goes - instructions are never stored, operands live
+//! on the stack and instruction names are looked up by a perfect hash (see
+//! `X86Util::getInstIdByName()`), so parsing doesn't allocate any memory
+//! except the first time a label or a symbol name is seen.
+//!
+//! The syntax is the one used by `Logger`, so the output of a logger can be
+//! parsed back:
+//!
+//!   - One instruction per line, `;` starts a comment.
+//!   - `name:` binds a label, labels are created when first seen and can be
+//!     referenced before they are bound.
+//!   - Prefixes `lock`, `rex`, `rex2`, `{nf}`, `short`, and `long`.
+//!   - Registers as printed by `Logger`, `st0..st7` are accepted as well.
+//!   - Immediates in decimal, `0x` or `h` suffixed hexadecimal, optionally
+//!     negative.
+//!   - Memory `[size ptr] [seg:][base + index * scale +/- disp]`, where base
+//!     can be a register, `rip`, a label, or a symbol, and the size is one of
+//!     `byte`, `word`, `dword`, `qword`, `tword`, `dqword`/`oword`/`xmmword`,
+//!     `yword`/`ymmword`, and `zword`/`zmmword`.
+//!   - AVX-512 `{k1}`, `{z}`, `{1toN}`, and `{sae}`/`{rn-sae}`/... decorators.
+//!   - Directives `.align N` and `.db`, `.dw`, `.dd`, `.dq` followed by a
+//!     comma separated list of numbers.
+//!
+//! Names are case insensitive except labels and symbols. Symbols are named
+//! operands added by `addSymbol()`, which is mostly useful with `X86Compiler`
+//! to refer to variables.
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! JitRuntime runtime;
+//! X86Assembler a(&runtime);
+//! X86AsmParser parser(&a);
+//!
+//! Error err = parser.parse(
+//!   "  mov eax, 1\n"
+//!   "L_Loop:\n"
+//!   "  add eax, eax\n"
+//!   "  cmp eax, 64\n"
+//!   "  jb L_Loop\n"
+//!   "  ret\n");
+//!
+//! if (err != kErrorOk)
+//!   printf("Error at line %u\n", parser.getErrorLine());
+//! ~~~
+class X86AsmParser {
+ public:
+  ASMJIT_NO_COPY(X86AsmParser)
+
+  //! \internal
+  //!
+  //! Named operand (label or symbol).
+  struct Symbol {
+    //! Name (not null terminated).
+    const char* name;
+    //! Length of the name.
+    uint32_t length;
+    //! Hash of the name.
+    uint32_t hashCode;
+    //! Operand.
+    Operand op;
+  };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a `X86AsmParser` that emits to `assembler`.
+  ASMJIT_API X86AsmParser(X86Assembler* assembler) noexcept;
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  //! Create a `X86AsmParser` that emits to `compiler`.
+  ASMJIT_API X86AsmParser(X86Compiler* compiler) noexcept;
+#endif // !ASMJIT_DISABLE_COMPILER
+  //! Destroy the `X86AsmParser` instance.
+  ASMJIT_API ~X86AsmParser() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  //! Forget all labels and symbols, must be called if the target is reset.
+  ASMJIT_API void reset(bool releaseMemory = false) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the `X86Assembler` the parser emits to (null if it emits to compiler).
+  ASMJIT_INLINE X86Assembler* getAssembler() const noexcept { return _assembler; }
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  //! Get the `X86Compiler` the parser emits to (null if it emits to assembler).
+  ASMJIT_INLINE X86Compiler* getCompiler() const noexcept { return _compiler; }
+#endif // !ASMJIT_DISABLE_COMPILER
+
+  //! Get the line of the last error (1 based) in the input passed to `parse()`,
+  //! zero if there was no error.
+  ASMJIT_INLINE uint32_t getErrorLine() const noexcept { return _errorLine; }
+
+  //! Get count of lines parsed since `reset()`.
+  ASMJIT_INLINE uint32_t getLineCount() const noexcept { return _lineCount; }
+
+  // --------------------------------------------------------------------------
+  // [Symbols]
+  // --------------------------------------------------------------------------
+
+  //! Add a symbol `name` that refers to `op`, which can be a register, a
+  //! variable, a label, or a memory operand. Symbols and labels share the same
+  //! namespace, an existing symbol or label is replaced.
+  ASMJIT_API Error addSymbol(const char* name, const Operand& op) noexcept;
+
+  //! Get a label of the given `name`, the label is created if it doesn't
+  //! exist yet. Returns an invalid label if the name refers to a symbol that
+  //! is not a label or if the system runs out of memory.
+  ASMJIT_API Label getLabel(const char* name, size_t len = kInvalidIndex) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Parse]
+  // --------------------------------------------------------------------------
+
+  //! Parse `input` of `size` bytes (null terminated if `size` is not given)
+  //! and emit it.
+  //!
+  //! Returns `kErrorInvalidSyntax` if the input is malformed, `kErrorUnknownInst`
+  //! if the instruction doesn't exist, or any error reported by the target.
+  //! Parsing stops at the first error, see `getErrorLine()`.
+  ASMJIT_API Error parse(const char* input, size_t size = kInvalidIndex) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Assembler (if emitting to assembler).
+  X86Assembler* _assembler;
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  //! Compiler (if emitting to compiler).
+  X86Compiler* _compiler;
+#endif // !ASMJIT_DISABLE_COMPILER
+
+  //! Count of lines parsed.
+  uint32_t _lineCount;
+  //! Line of the last error.
+  uint32_t _errorLine;
+
+  //! Open addressing hash table of symbols and labels.
+  Symbol* _symbols;
+  //! Capacity of `_symbols` (power of 2).
+  size_t _symbolCapacity;
+  //! Count of symbols in `_symbols`.
+  size_t _symbolCount;
+  //! Zone used to store names.
+  Zone _zone;
+};
+
+//! \}
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // !ASMJIT_DISABLE_TEXT
+#endif // _ASMJIT_X86_X86ASMPARSER_H
@@ -0,0 +1,399 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Export]
+#define ASMJIT_EXPORTS
+
+// [Guard]
+#include "../build.h"
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+
+// [Dependencies]
+#include "../x86/x86asmpool.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+// ============================================================================
+// [asmjit::X86AsmPool - Helpers]
+// ============================================================================
+
+static X86AsmPool::Entry* X86AsmPool_newEntry(X86AsmPool* self) noexcept {
+  void* p = ASMJIT_ALLOC(sizeof(X86AsmPool::Entry));
+  if (p == nullptr)
+    return nullptr;
+  return new(p) X86AsmPool::Entry(self->getRuntime(), self->getArch());
+}
+
+static void X86AsmPool_destroyEntry(X86AsmPool::Entry* entry) noexcept {
+  entry->~Entry();
+  ASMJIT_FREE(entry);
+}
+
+// ============================================================================
+// [asmjit::X86AsmPool - Construction / Destruction]
+// ============================================================================
+
+X86AsmPool::X86AsmPool(Runtime* runtime, uint32_t arch, size_t maxRetainedSize) noexcept
+  : _runtime(runtime),
+    _arch(arch),
+    _maxRetainedSize(maxRetainedSize),
+    _pooled(nullptr),
+    _pooledCount(0),
+    _acquiredCount(0) {}
+
+X86AsmPool::~X86AsmPool() noexcept {
+  ASMJIT_ASSERT(_acquiredCount == 0);
+  clear();
+}
+
+// ============================================================================
+// [asmjit::X86AsmPool - Accessors]
+// ============================================================================
+
+size_t X86AsmPool::getPooledCount() const noexcept {
+  AutoLock locked(_lock);
+  return _pooledCount;
+}
+
+size_t X86AsmPool::getAcquiredCount() const noexcept {
+  AutoLock locked(_lock);
+  return _acquiredCount;
+}
+
+// ============================================================================
+// [asmjit::X86AsmPool - Pool]
+// ============================================================================
+
+X86AsmPool::Entry* X86AsmPool::acquire() noexcept {
+  {
+    AutoLock locked(_lock);
+    Entry* entry = _pooled;
+
+    if (entry != nullptr) {
+      _pooled = entry->next;
+      _pooledCount--;
+      _acquiredCount++;
+
+      entry->next = nullptr;
+      return entry;
+    }
+  }
+
+  // The pool is empty, a new entry is created outside of the lock.
+  Entry* entry = X86AsmPool_newEntry(this);
+  if (entry == nullptr)
+    return nullptr;
+
+  AutoLock locked(_lock);
+  _acquiredCount++;
+  return entry;
+}
+
+void X86AsmPool::release(Entry* entry) noexcept {
+  ASMJIT_ASSERT(entry != nullptr);
+  X86Assembler& a = entry->assembler;
+
+  // Reset outside of the lock, the compiler has to be detached first.
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  entry->compiler.reset(false);
+#endif // !ASMJIT_DISABLE_COMPILER
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  a.setLogger(nullptr);
+#endif // !ASMJIT_DISABLE_LOGGER
+  a.setErrorHandler(nullptr);
+  a.reset(false);
+
+  if (a.getArch() != _arch)
+    a._setArch(_arch);
+
+  if (entry->getMemorySize() > _maxRetainedSize) {
+#if !defined(ASMJIT_DISABLE_COMPILER)
+    entry->compiler.reset(true);
+#endif // !ASMJIT_DISABLE_COMPILER
+    a.reset(true);
+  }
+
+  AutoLock locked(_lock);
+  ASMJIT_ASSERT(_acquiredCount > 0);
+
+  entry->next = _pooled;
+  _pooled = entry;
+
+  _pooledCount++;
+  _acquiredCount--;
+}
+
+Error X86AsmPool::warmUp(size_t count, size_t codeSize) noexcept {
+  size_t pooledCount = getPooledCount();
+  if (pooledCount >= count)
+    return kErrorOk;
+
+  // New entries are created outside of the lock and added at once.
+  Entry* first = nullptr;
+  Entry* last = nullptr;
+  Error error = kErrorOk;
+
+  size_t i;
+  for (i = pooledCount; i < count; i++) {
+    Entry* entry = X86AsmPool_newEntry(this);
+    if (entry == nullptr) {
+      error = kErrorNoHeapMemory;
+      break;
+    }
+
+    if (codeSize != 0 && entry->assembler._reserve(codeSize) != kErrorOk) {
+      X86AsmPool_destroyEntry(entry);
+      error = kErrorNoHeapMemory;
+      break;
+    }
+
+    entry->next = first;
+    first = entry;
+
+    if (last == nullptr)
+      last = entry;
+  }
+
+  if (first != nullptr) {
+    AutoLock locked(_lock);
+
+    last->next = _pooled;
+    _pooled = first;
+    _pooledCount += i - pooledCount;
+  }
+
+  return error;
+}
+
+void X86AsmPool::clear() noexcept {
+  Entry* entry;
+  {
+    AutoLock locked(_lock);
+    entry = _pooled;
+
+    _pooled = nullptr;
+    _pooledCount = 0;
+  }
+
+  while (entry != nullptr) {
+    Entry* next = entry->next;
+    X86AsmPool_destroyEntry(entry);
+    entry = next;
+  }
+}
+
+// ============================================================================
+// [asmjit::X86AsmPool - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+UNIT(x86_asm_pool) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86AsmPool pool(&runtime, kArchHost, 64 * 1024);
+
+  INFO("Checking the memory retained by a new entry.");
+  X86AsmPool::Entry* entry = pool.acquire();
+  EXPECT(entry != nullptr && entry->assembler.getMemorySize() == 0,
+    "A new assembler shouldn't retain any memory, not %u bytes.",
+    entry != nullptr ? static_cast<unsigned int>(entry->assembler.getMemorySize()) : 0U);
+  pool.release(entry);
+  pool.clear();
+
+  INFO("Warming up the pool.");
+  EXPECT(pool.warmUp(1, 4096) == kErrorOk && pool.warmUp(2, 4096) == kErrorOk && pool.getPooledCount() == 2,
+    "Pool should contain 2 entries.");
+
+  X86AsmPool::Entry* e0 = pool.acquire();
+  X86AsmPool::Entry* e1 = pool.acquire();
+  EXPECT(e0 != nullptr && e1 != nullptr && e0 != e1 && pool.getPooledCount() == 0,
+    "Couldn't acquire pooled entries.");
+  EXPECT(e0->assembler.getCapacity() >= 4096 && e1->assembler.getCapacity() >= 4096,
+    "Pooled entries should have a code-buffer reserved.");
+  pool.release(e1);
+
+  // The compiler is detached and the memory retained when released.
+#if !defined(ASMJIT_DISABLE_COMPILER)
+  for (uint32_t i = 0; i < 2; i++) {
+    X86Assembler& a = e0->assembler;
+    X86Compiler& c = e0->compiler;
+
+    c.attach(&a);
+    c.addFunc(FuncBuilder0<int>(kCallConvHost));
+
+    X86GpVar v = c.newInt32("v");
+    c.mov(v, static_cast<int>(i + 1));
+    c.ret(v);
+
+    c.endFunc();
+    c.finalize();
+
+    Func func = asmjit_cast<Func>(a.make());
+    EXPECT(func != nullptr,
+      "Couldn't make the function.");
+
+    int result = func();
+    EXPECT(result == static_cast<int>(i + 1),
+      "Function returned %d instead of %d.", result, static_cast<int>(i + 1));
+    runtime.release((void*)func);
+
+    c.attach(&a);
+    pool.release(e0);
+
+    entry = pool.acquire();
+    EXPECT(entry == e0 && e0->compiler.getAssembler() == nullptr && e0->assembler.getOffset() == 0,
+      "The last entry released should have been acquired and reset.");
+    EXPECT(e0->getMemorySize() != 0,
+      "Memory should have been retained.");
+  }
+#endif // !ASMJIT_DISABLE_COMPILER
+
+  // Memory over the limit is released.
+  X86Assembler& a = e0->assembler;
+  for (uint32_t i = 0; i < 50000; i++)
+    a.add(x86::eax, x86::ecx);
+
+  EXPECT(e0->getMemorySize() > pool.getMaxRetainedSize(),
+    "The entry should retain more memory than allowed.");
+  pool.release(e0);
+
+  EXPECT(pool.getAcquiredCount() == 0 && pool.getPooledCount() == 2,
+    "Pool should contain 2 entries.");
+  EXPECT(e0->getMemorySize() <= pool.getMaxRetainedSize() && a.getCapacity() == 0,
+    "Memory over the limit should have been released.");
+
+  pool.clear();
+  EXPECT(pool.getPooledCount() == 0,
+    "Pool should be empty.");
+}
+
+enum {
+  kX86AsmPoolTestThreadCount = 4,
+  kX86AsmPoolTestJobCount = 200
+};
+
+struct X86AsmPoolTestThread {
+  X86AsmPool* pool;
+  uint32_t id;
+  uint32_t failed;
+};
+
+// Acquires an entry for each job, makes and calls a function returning a
+// value unique to the job, and releases the entry back to the shared pool.
+static void X86AsmPool_testJobs(X86AsmPoolTestThread* thread) noexcept {
+  typedef int (*Func)(void);
+
+  X86AsmPool* pool = thread->pool;
+  Runtime* runtime = pool->getRuntime();
+
+  for (uint32_t i = 0; i < kX86AsmPoolTestJobCount; i++) {
+    X86AsmPool::Entry* entry = pool->acquire();
+    if (entry == nullptr) {
+      thread->failed++;
+      continue;
+    }
+
+    X86Assembler& a = entry->assembler;
+    int expected = static_cast<int>(thread->id * kX86AsmPoolTestJobCount + i);
+
+    if (a.getOffset() != 0)
+      thread->failed++;
+
+    a.mov(x86::eax, expected);
+    a.ret();
+
+    Func func = asmjit_cast<Func>(a.make());
+    if (func == nullptr || func() != expected)
+      thread->failed++;
+
+    if (func != nullptr)
+      runtime->release((void*)func);
+    pool->release(entry);
+  }
+}
+
+#if ASMJIT_OS_WINDOWS
+static DWORD WINAPI X86AsmPool_testThreadEntry(LPVOID arg) {
+  X86AsmPool_testJobs(static_cast<X86AsmPoolTestThread*>(arg));
+  return 0;
+}
+#else
+static void* X86AsmPool_testThreadEntry(void* arg) {
+  X86AsmPool_testJobs(static_cast<X86AsmPoolTestThread*>(arg));
+  return nullptr;
+}
+#endif // ASMJIT_OS_WINDOWS
+
+UNIT(x86_asm_pool_threads) {
+  JitRuntime runtime;
+  X86AsmPool pool(&runtime);
+
+  X86AsmPoolTestThread threads[kX86AsmPoolTestThreadCount];
+#if ASMJIT_OS_WINDOWS
+  HANDLE handles[kX86AsmPoolTestThreadCount];
+#else
+  pthread_t handles[kX86AsmPoolTestThreadCount];
+#endif // ASMJIT_OS_WINDOWS
+
+  INFO("Acquiring and releasing entries from %u threads.",
+    static_cast<unsigned int>(kX86AsmPoolTestThreadCount));
+
+  uint32_t i;
+  uint32_t started = 0;
+
+  for (i = 0; i < kX86AsmPoolTestThreadCount; i++) {
+    threads[i].pool = &pool;
+    threads[i].id = i;
+    threads[i].failed = 0;
+
+#if ASMJIT_OS_WINDOWS
+    handles[i] = ::CreateThread(nullptr, 0, X86AsmPool_testThreadEntry, &threads[i], 0, nullptr);
+    if (handles[i] == nullptr)
+      break;
+#else
+    if (::pthread_create(&handles[i], nullptr, X86AsmPool_testThreadEntry, &threads[i]) != 0)
+      break;
+#endif // ASMJIT_OS_WINDOWS
+    started++;
+  }
+
+  for (i = 0; i < started; i++) {
+#if ASMJIT_OS_WINDOWS
+    ::WaitForSingleObject(handles[i], INFINITE);
+    ::CloseHandle(handles[i]);
+#else
+    ::pthread_join(handles[i], nullptr);
+#endif // ASMJIT_OS_WINDOWS
+  }
+
+  EXPECT(started == kX86AsmPoolTestThreadCount,
+    "Couldn't start thread #%u.", started);
+
+  for (i = 0; i < started; i++) {
+    EXPECT(threads[i].failed == 0,
+      "Thread #%u failed %u jobs.", i, threads[i].failed);
+  }
+
+  EXPECT(pool.getAcquiredCount() == 0,
+    "All entries should have been released.");
+  EXPECT(pool.getPooledCount() != 0 && pool.getPooledCount() <= kX86AsmPoolTestThreadCount,
+    "Pool should contain at most one entry per thread, not %u.",
+    static_cast<unsigned int>(pool.getPooledCount()));
+}
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64
@@ -0,0 +1,188 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Guard]
+#ifndef _ASMJIT_X86_X86ASMPOOL_H
+#define _ASMJIT_X86_X86ASMPOOL_H
+
+// [Dependencies]
+#include "../base/runtime.h"
+#include "../base/utils.h"
+#include "../x86/x86assembler.h"
+#include "../x86/x86compiler.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+//! \addtogroup asmjit_x86
+//! \{
+
+// ============================================================================
+// [asmjit::X86AsmPool]
+// ============================================================================
+
+//! Thread-safe pool of reusable `X86Assembler` and `X86Compiler` pairs.
+//!
+//! Creating an assembler and a compiler for each job allocates their zones,
+//! arrays, and code-buffers, which are all released when they are destroyed.
+//! The pool keeps entries that were released, each is reset without releasing
+//! its memory, so the next job that acquires it doesn't allocate anything
+//! unless it needs more memory than the previous ones. An entry that retains
+//! more than `getMaxRetainedSize()` bytes is reset with its memory released.
+//!
+//! `acquire()` and `release()` can be called from any thread, entries are not
+//! thread-safe and must be used by one thread at a time.
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! JitRuntime runtime;
+//! X86AsmPool pool(&runtime);
+//!
+//! // Worker thread.
+//! X86AsmPool::Entry* entry = pool.acquire();
+//! if (entry != nullptr) {
+//!   X86Assembler& a = entry->assembler;
+//!   X86Compiler& c = entry->compiler;
+//!
+//!   c.attach(&a);
+//!   // ... generate code ...
+//!   c.finalize();
+//!
+//!   void* func = a.make();
+//!   pool.release(entry);
+//! }
+//! ~~~
+class X86AsmPool {
+ public:
+  ASMJIT_NO_COPY(X86AsmPool)
+
+  enum {
+    //! Default limit of memory retained by a single entry.
+    kDefaultMaxRetainedSize = 1024 * 1024
+  };
+
+  //! Assembler and compiler handed out by the pool.
+  //!
+  //! The compiler is not attached to the assembler.
+  struct Entry {
+    ASMJIT_INLINE Entry(Runtime* runtime, uint32_t arch) noexcept
+      : assembler(runtime, arch),
+        next(nullptr) {}
+
+    //! Get the number of bytes of memory retained by the entry.
+    ASMJIT_INLINE size_t getMemorySize() const noexcept {
+      size_t size = assembler.getMemorySize();
+#if !defined(ASMJIT_DISABLE_COMPILER)
+      size += compiler.getMemorySize();
+#endif // !ASMJIT_DISABLE_COMPILER
+      return size;
+    }
+
+    //! Assembler.
+    X86Assembler assembler;
+#if !defined(ASMJIT_DISABLE_COMPILER)
+    //! Compiler.
+    X86Compiler compiler;
+#endif // !ASMJIT_DISABLE_COMPILER
+
+    //! \internal
+    //!
+    //! Next entry in the pool.
+    Entry* next;
+  };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a new `X86AsmPool` of assemblers targeting `runtime` and `arch`.
+  ASMJIT_API X86AsmPool(Runtime* runtime, uint32_t arch
+#if ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64
+    = kArchHost
+#endif // ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64
+    , size_t maxRetainedSize = kDefaultMaxRetainedSize) noexcept;
+
+  //! Destroy the `X86AsmPool` and all entries in the pool.
+  //!
+  //! NOTE: All acquired entries must be released before.
+  ASMJIT_API ~X86AsmPool() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the runtime of assemblers.
+  ASMJIT_INLINE Runtime* getRuntime() const noexcept { return _runtime; }
+  //! Get the architecture of assemblers.
+  ASMJIT_INLINE uint32_t getArch() const noexcept { return _arch; }
+
+  //! Get the maximum number of bytes an entry can retain when it's released.
+  ASMJIT_INLINE size_t getMaxRetainedSize() const noexcept { return _maxRetainedSize; }
+  //! Set the maximum number of bytes an entry can retain when it's released,
+  //! it should be set before the pool is shared by multiple threads.
+  ASMJIT_INLINE void setMaxRetainedSize(size_t size) noexcept { _maxRetainedSize = size; }
+
+  //! Get the number of entries in the pool.
+  ASMJIT_API size_t getPooledCount() const noexcept;
+  //! Get the number of entries acquired and not released yet.
+  ASMJIT_API size_t getAcquiredCount() const noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Pool]
+  // --------------------------------------------------------------------------
+
+  //! Get an entry from the pool or create a new one if the pool is empty.
+  //!
+  //! Returns `nullptr` if out of memory.
+  ASMJIT_API Entry* acquire() noexcept;
+
+  //! Reset `entry` and return it to the pool.
+  //!
+  //! The compiler is detached and reset, the assembler is reset and its
+  //! logger and error handler are removed. Memory is retained unless the entry
+  //! retains more than `getMaxRetainedSize()` bytes.
+  ASMJIT_API void release(Entry* entry) noexcept;
+
+  //! Add entries to the pool so it has at least `count` entries, each with a
+  //! code-buffer of at least `codeSize` bytes.
+  ASMJIT_API Error warmUp(size_t count, size_t codeSize = 0) noexcept;
+
+  //! Destroy all entries in the pool.
+  ASMJIT_API void clear() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Runtime.
+  Runtime* _runtime;
+  //! Architecture.
+  uint32_t _arch;
+  //! Maximum memory retained by an entry.
+  size_t _maxRetainedSize;
+
+  //! Lock guarding the pool.
+  mutable Lock _lock;
+  //! Entries in the pool.
+  Entry* _pooled;
+  //! Count of entries in the pool.
+  size_t _pooledCount;
+  //! Count of entries acquired.
+  size_t _acquiredCount;
+};
+
+//! \}
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // _ASMJIT_X86_X86ASMPOOL_H
@@ -19,6 +19,7 @@
 #include "../base/utils.h"
 #include "../base/vmem.h"
 #include "../x86/x86assembler.h"
+#include "../x86/x86fixed.h"
 
 // [Api-Begin]
 #include "../apibegin.h"
@@ -31,6 +32,29 @@ namespace asmjit {
 
 enum { kX86RexNoRexMask = kX86InstOptionRex | _kX86InstOptionNoRex };
 
+//! \internal
+//!
+//! Number of bytes that must be available in the code-buffer before a single
+//! instruction is encoded (the longest X86/X64 instruction is 15 bytes).
+enum { kX86InstMaxSize = 16 };
+
+//! \internal
+//!
+//! Size of the longest NOP used by code alignment by default, and the longest
+//! NOP recommended by AMD.
+enum {
+  kX86NopMaxSize = 9,
+  kX86NopMaxSizeAMD = 11
+};
+
+//! \internal
+//!
+//! Number of bytes that must be available in the code-buffer before a single
+//! instruction is encoded if `kOptionAlignBranches` is enabled. It includes
+//! the padding (up to 31 bytes) and a macro-fused instruction, which is moved
+//! together with the branch.
+enum { kX86PaddedInstMaxSize = 64 };
+
 //! \internal
 //!
 //! X86/X64 bytes used to encode important prefixes.
@@ -41,6 +65,13 @@ enum X86Byte {
   //! 1-byte REX.W component.
   kX86ByteRexW = 0x08,
 
+  //! 2-byte REX2 prefix (APX):
+  //!   - `[0]` - `0xD5`.
+  //!   - `[1]` - `[M0 R4 X4 B4 W R3 X3 B3]`.
+  //!
+  //! `M0` selects the legacy opcode map 1 (`0F`), which is not emitted then.
+  kX86ByteRex2 = 0xD5,
+
   //! 2-byte VEX prefix:
   //!   - `[0]` - `0xC5`.
   //!   - `[1]` - `RvvvvLpp`.
@@ -89,6 +120,26 @@ enum VexVVVV {
   kVexVVVVMask = 0xF << kVexVVVVShift
 };
 
+//! \internal
+//!
+//! All instruction options that can only be encoded by EVEX prefix.
+enum X86EvexOptions {
+  kX86EvexOptions = kX86InstOptionEvex      |
+                    kX86InstOptionEvexZero  |
+                    kX86InstOptionEvexOneN  |
+                    kX86InstOptionEvexSae   |
+                    kX86InstOptionEvexRnSae |
+                    kX86InstOptionEvexRdSae |
+                    kX86InstOptionEvexRuSae |
+                    kX86InstOptionEvexRzSae |
+                    kX86InstOptionEvexK_Mask,
+
+  kX86EvexRounding = kX86InstOptionEvexRnSae |
+                     kX86InstOptionEvexRdSae |
+                     kX86InstOptionEvexRuSae |
+                     kX86InstOptionEvexRzSae
+};
+
 //! \internal
 //!
 //! Instruction 2-byte/3-byte opcode prefix definition.
@@ -200,6 +251,40 @@ static ASMJIT_INLINE bool x86IsYmm(const X86Reg* reg) { return reg->isYmm(); }
 static ASMJIT_INLINE bool x86IsZmm(const Operand* op) { return op->isRegType(kX86RegTypeZmm); }
 static ASMJIT_INLINE bool x86IsZmm(const X86Reg* reg) { return reg->isZmm(); }
 
+//! Get whether an AVX instruction has to be encoded by using EVEX prefix.
+//!
+//! EVEX is required if any AVX-512 option is used or if any operand is a ZMM
+//! register or a vector register having index 16-31 (`regs` is a combination
+//! of register indexes and VVVV, see `x86RegAndVvvv()`).
+static ASMJIT_INLINE bool x86NeedsEvex(uint32_t options, uint32_t regs,
+  const Operand* o0, const Operand* o1, const Operand* o2, const Operand* o3) {
+
+  return (options & kX86EvexOptions) != 0 ||
+         (regs & (0x10 | (0x10 << kVexVVVVShift))) != 0 ||
+         (x86IsZmm(o0) | x86IsZmm(o1) | x86IsZmm(o2) | x86IsZmm(o3));
+}
+
+//! Get bits 3 and 4 of a GP register index used by a memory operand, zero if
+//! the register is not used (REX2 and EVEX extend base and index to 5 bits).
+static ASMJIT_INLINE uint32_t x86MemRegBits(uint32_t index) {
+  return index < 32 ? index & 0x18 : 0;
+}
+
+//! Get whether a memory operand uses R16..R31 (APX) base or index register,
+//! which can't be encoded by VEX and XOP prefixes.
+static ASMJIT_INLINE bool x86MemHasApxReg(const X86Mem* mem) {
+  uint32_t bits = x86MemRegBits(mem->getIndex());
+  if (mem->isBaseIndexType())
+    bits |= x86MemRegBits(mem->getBase());
+  return (bits & 0x10) != 0;
+}
+
+//! Get whether `disp` can be encoded as 8-bit displacement scaled by `1 << shift`
+//! (EVEX compressed displacement, `disp8*N`, `shift` is always zero if not EVEX).
+static ASMJIT_INLINE bool x86IsDisp8(int32_t disp, uint32_t shift) {
+  return (disp & ((1 << shift) - 1)) == 0 && Utils::isInt8(disp >> shift);
+}
+
 // ============================================================================
 // [Macros]
 // ============================================================================
@@ -275,6 +360,21 @@ static ASMJIT_INLINE bool x86IsZmm(const X86Reg* reg) { return reg->isZmm(); }
     cursor++; \
   } while (0)
 
+// REX2 prefix, `_Hi_` contains `R4`, `X4`, and `B4` bits. REX2 can only be
+// used by instructions of legacy maps 0 and 1, the `0F` escape is part of it.
+#define EMIT_REX2(_Rex_, _Hi_) \
+  do { \
+    uint32_t rex2Map = (opCode >> kX86InstOpCode_MM_Shift) & (kX86InstOpCode_MM_Mask >> kX86InstOpCode_MM_Shift); \
+    \
+    if (rex2Map > 1 || x86RexIsInvalid(_Rex_)) \
+      goto _IllegalInst; \
+    \
+    cursor[0] = kX86ByteRex2; \
+    cursor[1] = static_cast<uint8_t>((rex2Map << 7) | (_Hi_) | ((_Rex_) & 0x0F)); \
+    cursor += 2; \
+    opCode &= ~static_cast<uint32_t>(kX86InstOpCode_MM_Mask); \
+  } while (0)
+
 #define EMIT_MM(_Val_) \
   do { \
     uint32_t mmIndex = ((_Val_) >> kX86InstOpCode_MM_Shift) & (kX86InstOpCode_MM_Mask >> kX86InstOpCode_MM_Shift); \
@@ -288,12 +388,140 @@ static ASMJIT_INLINE bool x86IsZmm(const X86Reg* reg) { return reg->isZmm(); }
     cursor += mmCode.len; \
   } while (0)
 
+// ============================================================================
+// [asmjit::X86RelocEntryMap]
+// ============================================================================
+
+//! \internal
+//!
+//! Maps an absolute address and a section to its trampoline or GOT entry, so
+//! all relocations of the same target share a single 8-byte entry. Targets
+//! are usually few, the table starts embedded and only grows on demand.
+//!
+//! The relocator stores the entry offset in `Slot::value`. `X86Assembler`
+//! uses its own map to reserve entries while emitting and stores the index
+//! of the relocation that reserved the entry plus one.
+struct X86RelocEntryMap {
+  ASMJIT_NO_COPY(X86RelocEntryMap)
+
+  enum { kEmbeddedCount = 64 };
+
+  struct Slot {
+    //! Absolute address.
+    uint64_t data;
+    //! Section of the relocation.
+    uint32_t section;
+    //! Value, zero if the slot is empty.
+    size_t value;
+  };
+
+  ASMJIT_INLINE X86RelocEntryMap() noexcept
+    : _slots(_embedded),
+      _mask(kEmbeddedCount - 1),
+      _count(0) {
+    ::memset(_embedded, 0, sizeof(_embedded));
+  }
+
+  ASMJIT_INLINE ~X86RelocEntryMap() noexcept {
+    if (_slots != _embedded)
+      ASMJIT_FREE(_slots);
+  }
+
+  static ASMJIT_INLINE size_t hash(uint64_t data, uint32_t section) noexcept {
+    // Targets are often aligned and close to each other, mix the high bits.
+    return static_cast<size_t>((data * ASMJIT_UINT64_C(0x9E3779B97F4A7C15)) >> 32) + section;
+  }
+
+  //! Get the number of bytes allocated by the map, excluding the map itself.
+  ASMJIT_INLINE size_t getHeapSize() const noexcept {
+    return _slots != _embedded ? (_mask + 1) * sizeof(Slot) : size_t(0);
+  }
+
+  //! Remove all targets, keeps the capacity.
+  ASMJIT_INLINE void clear() noexcept {
+    if (_count == 0)
+      return;
+
+    ::memset(_slots, 0, (_mask + 1) * sizeof(Slot));
+    _count = 0;
+  }
+
+  //! Get the slot of `data` and `section`, which is empty if they are not in
+  //! the map.
+  ASMJIT_INLINE Slot* find(uint64_t data, uint32_t section) noexcept {
+    size_t i = hash(data, section) & _mask;
+    while (_slots[i].value != 0 && (_slots[i].data != data || _slots[i].section != section))
+      i = (i + 1) & _mask;
+    return &_slots[i];
+  }
+
+  //! Store `value` to an empty `slot` returned by `find()`, returns false
+  //! if the map couldn't grow.
+  ASMJIT_INLINE bool add(Slot* slot, uint64_t data, uint32_t section, size_t value) noexcept {
+    slot->data = data;
+    slot->section = section;
+    slot->value = value;
+
+    // Keep the load factor below 1/2.
+    if (++_count <= (_mask >> 1))
+      return true;
+
+    size_t capacity = (_mask + 1) * 2;
+    Slot* newSlots = static_cast<Slot*>(ASMJIT_ALLOC(capacity * sizeof(Slot)));
+    if (newSlots == nullptr)
+      return false;
+    ::memset(newSlots, 0, capacity * sizeof(Slot));
+
+    Slot* oldSlots = _slots;
+    size_t oldCapacity = _mask + 1;
+
+    _slots = newSlots;
+    _mask = capacity - 1;
+
+    for (size_t i = 0; i < oldCapacity; i++)
+      if (oldSlots[i].value != 0)
+        *find(oldSlots[i].data, oldSlots[i].section) = oldSlots[i];
+
+    if (oldSlots != _embedded)
+      ASMJIT_FREE(oldSlots);
+    return true;
+  }
+
+  Slot* _slots;
+  size_t _mask;
+  size_t _count;
+  Slot _embedded[kEmbeddedCount];
+};
+
+//! \internal
+//!
+//! Release the map of reserved GOT entries and trampolines.
+static ASMJIT_INLINE void X86Assembler_releaseRelocEntries(X86Assembler* self) noexcept {
+  X86RelocEntryMap* map = self->_relocEntries;
+  if (map == nullptr)
+    return;
+
+  map->~X86RelocEntryMap();
+  ASMJIT_FREE(map);
+  self->_relocEntries = nullptr;
+}
+
 // ============================================================================
 // [asmjit::X86Assembler - Construction / Destruction]
 // ============================================================================
 
 X86Assembler::X86Assembler(Runtime* runtime, uint32_t arch)
   : Assembler(runtime),
+    _refSites(nullptr),
+    _relocEntries(nullptr),
+    _fusibleOffset(-1),
+    _fusibleSize(0),
+    _fusibleSectionId(0),
+    _funcAlign(0),
+    _loopAlign(0),
+    _maxAlignPadding(0),
+    _nopMaxSize(kX86NopMaxSize),
+    _bytesSaved(0),
     zax(NoInit),
     zcx(NoInit),
     zdx(NoInit),
@@ -307,7 +535,75 @@ X86Assembler::X86Assembler(Runtime* runtime, uint32_t arch)
   _setArch(arch);
 }
 
-X86Assembler::~X86Assembler() {}
+X86Assembler::~X86Assembler() {
+  X86Assembler_releaseRelocEntries(this);
+}
+
+// ============================================================================
+// [asmjit::X86Assembler - Reset]
+// ============================================================================
+
+void X86Assembler::reset(bool releaseMemory) noexcept {
+  Assembler::reset(releaseMemory);
+  _relaxItems.reset(releaseMemory);
+  _fusibleOffset = -1;
+
+  if (releaseMemory)
+    X86Assembler_releaseRelocEntries(this);
+  else if (_relocEntries != nullptr)
+    _relocEntries->clear();
+
+  _funcAlign = 0;
+  _loopAlign = 0;
+  _maxAlignPadding = 0;
+  _nopMaxSize = kX86NopMaxSize;
+  _bytesSaved = 0;
+}
+
+// ============================================================================
+// [asmjit::X86Assembler - Memory]
+// ============================================================================
+
+size_t X86Assembler::getMemorySize() const noexcept {
+  size_t size = Assembler::getMemorySize() + _relaxItems.getHeapSize();
+
+  if (_relocEntries != nullptr)
+    size += sizeof(X86RelocEntryMap) + _relocEntries->getHeapSize();
+
+  return size;
+}
+
+// ============================================================================
+// [asmjit::X86Assembler - Tune]
+// ============================================================================
+
+void X86Assembler::tuneFor(const CpuInfo& cpuInfo) noexcept {
+  if (cpuInfo.hasX86JccErratum())
+    addAsmOptions(kOptionAlignBranches);
+
+  // Padding of loop heads is executed, it must use multi-byte NOPs.
+  addAsmOptions(kOptionOptimizedAlign);
+
+  uint32_t vendorId = cpuInfo.getVendorId();
+  uint32_t family = cpuInfo.getFamily();
+
+  // Software Optimization Guide for AMD Family 15h/17h Processors - Code
+  // Padding with Operand-Size Override and Multibyte NOP.
+  if (vendorId == CpuInfo::kVendorAMD && family >= 0x15)
+    _nopMaxSize = 11;
+  else
+    _nopMaxSize = kX86NopMaxSize;
+
+  // Zen fetches and caches decoded instructions in 32-byte windows, older AMD
+  // and Intel processors decode 16-byte blocks. Loop heads are only aligned
+  // if the padding is smaller than an average loop body.
+  if (vendorId == CpuInfo::kVendorAMD && family >= 0x17)
+    setAutoAlign(32, 32, 15);
+  else if (vendorId == CpuInfo::kVendorIntel || vendorId == CpuInfo::kVendorAMD)
+    setAutoAlign(16, 16, 10);
+  else
+    setAutoAlign(16, 16, 7);
+}
 
 // ============================================================================
 // [asmjit::X86Assembler - Arch]
@@ -357,11 +653,16 @@ Error X86Assembler::embedLabel(const Label& op) {
   ASMJIT_ASSERT(op.getId() != kInvalidValue);
   uint32_t regSize = _regSize;
 
+  // Absolute address of a label would have to be relocated.
+  if (getArch() == kArchX64 && hasAsmOption(kOptionPositionIndependent))
+    return setLastError(kErrorIllegalAddresing);
+
   if (getRemainingSpace() < regSize)
     ASMJIT_PROPAGATE_ERROR(_grow(regSize));
 
   uint8_t* cursor = getCursor();
-  LabelData* label = getLabelData(op.getId());
+  uint32_t labelId = op.getId();
+  intptr_t labelOffset = getLabelOffset(labelId);
   RelocData rd;
 
 #if !defined(ASMJIT_DISABLE_LOGGER)
@@ -370,28 +671,31 @@ Error X86Assembler::embedLabel(const Label& op) {
 #endif // !ASMJIT_DISABLE_LOGGER
 
   rd.type = kRelocRelToAbs;
-  rd.size = regSize;
-  rd.from = static_cast<Ptr>(getOffset());
+  rd.size = static_cast<uint8_t>(regSize);
+  rd.reserved = 0;
+  rd.fromSection = _sectionId;
+  rd.dataSection = getLabelSectionId(labelId);
+  rd.from = static_cast<uint32_t>(getOffset());
   rd.data = 0;
 
-  if (label->offset != -1) {
+  if (labelOffset != -1) {
     // Bound label.
-    rd.data = static_cast<Ptr>(static_cast<SignedPtr>(label->offset));
+    rd.data = static_cast<Ptr>(static_cast<SignedPtr>(labelOffset));
   }
   else {
     // Non-bound label. Need to chain.
-    LabelLink* link = _newLabelLink();
+    LabelLink* link = _linkLabel(labelId);
+    if (link == nullptr)
+      return setLastError(isFixedBuffer() ? kErrorCodeTooLarge : kErrorNoHeapMemory);
 
-    link->prev = (LabelLink*)label->links;
     link->offset = getOffset();
     link->displacement = 0;
     link->relocId = _relocations.getLength();
-
-    label->links = link;
   }
 
-  if (_relocations.append(rd) != kErrorOk)
-    return setLastError(kErrorNoHeapMemory);
+  Error error = _append(_relocations, rd);
+  if (error != kErrorOk)
+    return setLastError(error);
 
   // Emit dummy intptr_t (4 or 8 bytes; depends on the address size).
   EMIT_DWORD(0);
@@ -403,42 +707,70 @@ Error X86Assembler::embedLabel(const Label& op) {
 }
 
 // ============================================================================
-// [asmjit::X86Assembler - Align]
+// [asmjit::X86Assembler - Label]
 // ============================================================================
 
-Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
-#if !defined(ASMJIT_DISABLE_LOGGER)
-  if (_logger)
-    _logger->logFormat(Logger::kStyleDirective,
-      "%s.align %u\n", _logger->getIndentation(), static_cast<unsigned int>(offset));
-#endif // !ASMJIT_DISABLE_LOGGER
+Error X86Assembler::bind(const Label& label) noexcept {
+  // A label between a cmp/test and jcc prevents moving the pair as a whole.
+  _fusibleOffset = -1;
+  return Assembler::bind(label);
+}
 
-  if (alignMode > kAlignZero)
-    return setLastError(kErrorInvalidArgument);
+Error X86Assembler::bindFunc(const Label& label) noexcept {
+  if (_funcAlign > 1)
+    ASMJIT_PROPAGATE_ERROR(_align(kAlignCode, _funcAlign, _funcAlign - 1));
+  return bind(label);
+}
 
-  if (offset <= 1)
-    return kErrorOk;
+Error X86Assembler::bindLoop(const Label& label) noexcept {
+  if (_loopAlign > 1)
+    ASMJIT_PROPAGATE_ERROR(_align(kAlignCode, _loopAlign, _maxAlignPadding));
+  return bind(label);
+}
 
-  if (!Utils::isPowerOf2(offset) || offset > 64)
-    return setLastError(kErrorInvalidArgument);
+// ============================================================================
+// [asmjit::X86Assembler - Checkpoint]
+// ============================================================================
 
-  uint32_t i = static_cast<uint32_t>(Utils::alignDiff<size_t>(getOffset(), offset));
-  if (i == 0)
-    return kErrorOk;
+Error X86Assembler::checkpoint(Checkpoint& cp) noexcept {
+  ASMJIT_PROPAGATE_ERROR(Assembler::checkpoint(cp));
 
-  if (getRemainingSpace() < i)
-    ASMJIT_PROPAGATE_ERROR(_grow(i));
+  // The instruction before the checkpoint can't be fused with a jcc emitted
+  // after it, the pair would be moved across the checkpoint.
+  _fusibleOffset = -1;
 
-  uint8_t* cursor = getCursor();
+  cp.archData[0] = _relaxItems.getLength();
+  cp.archData[1] = _bytesSaved;
+  return kErrorOk;
+}
+
+Error X86Assembler::rollback(const Checkpoint& cp) noexcept {
+  ASMJIT_PROPAGATE_ERROR(Assembler::rollback(cp));
+
+  _fusibleOffset = -1;
+  _relaxItems.truncate(cp.archData[0]);
+  _bytesSaved = cp.archData[1];
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Assembler - Align]
+// ============================================================================
+
+//! \internal
+//!
+//! Fill `i` bytes at `cursor` by a sequence specified by `alignMode` and
+//! return the cursor advanced by `i`. Code is filled by NOPs of at most
+//! `nopMaxSize` bytes.
+static uint8_t* X86Assembler_fillAlign(uint8_t* cursor, uint32_t i, uint32_t alignMode, uint32_t nopMaxSize) noexcept {
   uint8_t pattern = 0x00;
 
   switch (alignMode) {
     case kAlignCode: {
-      if (hasAsmOption(kOptionOptimizedAlign)) {
-        // Intel 64 and IA-32 Architectures Software Developer's Manual - Volume 2B (NOP).
-        enum { kMaxNopSize = 9 };
-
-        static const uint8_t nopData[kMaxNopSize][kMaxNopSize] = {
+      if (nopMaxSize > 1) {
+        // Intel 64 and IA-32 Architectures Software Developer's Manual - Volume 2B (NOP),
+        // 10 and 11 bytes from Software Optimization Guide for AMD Family 17h Processors.
+        static const uint8_t nopData[kX86NopMaxSizeAMD][kX86NopMaxSizeAMD] = {
           { 0x90 },
           { 0x66, 0x90 },
           { 0x0F, 0x1F, 0x00 },
@@ -447,18 +779,20 @@ Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
           { 0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00 },
           { 0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00 },
           { 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 },
-          { 0x66, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 }
+          { 0x66, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 },
+          { 0x66, 0x2E, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 },
+          { 0x66, 0x66, 0x2E, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 }
         };
 
-        do {
-          uint32_t n = Utils::iMin<uint32_t>(i, kMaxNopSize);
+        while (i) {
+          uint32_t n = Utils::iMin<uint32_t>(i, nopMaxSize);
           const uint8_t* p = nopData[n - 1];
 
           i -= n;
           do {
             EMIT_BYTE(*p++);
           } while (--n);
-        } while (i);
+        }
       }
 
       pattern = 0x90;
@@ -481,125 +815,755 @@ Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
     i--;
   }
 
-  setCursor(cursor);
-  return kErrorOk;
+  return cursor;
 }
 
-// ============================================================================
-// [asmjit::X86Assembler - Reloc]
-// ============================================================================
+//! \internal
+//!
+//! Get the padding needed to align `offset` to `alignment`, or zero if it's
+//! larger than `maxSize`.
+static ASMJIT_INLINE uint32_t X86Assembler_alignPadding(intptr_t offset, uint32_t alignment, uint32_t maxSize) noexcept {
+  uint32_t i = static_cast<uint32_t>(Utils::alignDiff<intptr_t>(offset, alignment));
+  return i <= maxSize ? i : 0;
+}
 
-size_t X86Assembler::_relocCode(void* _dst, Ptr baseAddress) const noexcept {
-  uint32_t arch = getArch();
-  uint8_t* dst = static_cast<uint8_t*>(_dst);
+//! \internal
+//!
+//! Get the size of the longest NOP used by `align()`.
+static ASMJIT_INLINE uint32_t X86Assembler_getAlignNopSize(const X86Assembler* self) noexcept {
+  return self->hasAsmOption(Assembler::kOptionOptimizedAlign) ? self->getNopMaxSize() : 1;
+}
+
+Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
+  return _align(alignMode, offset, offset - 1);
+}
+
+Error X86Assembler::_align(uint32_t alignMode, uint32_t offset, uint32_t maxSize) noexcept {
+  _fusibleOffset = -1;
 
 #if !defined(ASMJIT_DISABLE_LOGGER)
-  Logger* logger = getLogger();
-#endif // ASMJIT_DISABLE_LOGGER
+  if (_logger) {
+    if (offset > 1 && maxSize < offset - 1)
+      _logger->logFormat(Logger::kStyleDirective,
+        "%s.align %u, max %u\n", _logger->getIndentation(), static_cast<unsigned int>(offset), static_cast<unsigned int>(maxSize));
+    else
+      _logger->logFormat(Logger::kStyleDirective,
+        "%s.align %u\n", _logger->getIndentation(), static_cast<unsigned int>(offset));
+  }
+#endif // !ASMJIT_DISABLE_LOGGER
 
-  size_t minCodeSize = getOffset();   // Current offset is the minimum code size.
-  size_t maxCodeSize = getCodeSize(); // Includes all possible trampolines.
+  if (alignMode > kAlignZero)
+    return setLastError(kErrorInvalidArgument);
 
-  // We will copy the exact size of the generated code. Extra code for trampolines
-  // is generated on-the-fly by the relocator (this code doesn't exist at the moment).
-  ::memcpy(dst, _buffer, minCodeSize);
+  if (offset <= 1)
+    return kErrorOk;
 
-  // Trampoline pointer.
-  uint8_t* tramp = dst + minCodeSize;
+  if (!Utils::isPowerOf2(offset) || offset > 64)
+    return setLastError(kErrorInvalidArgument);
 
-  // Relocate all recorded locations.
-  size_t relocCount = _relocations.getLength();
-  const RelocData* rdList = _relocations.getData();
+  uint32_t i = X86Assembler_alignPadding(static_cast<intptr_t>(getOffset()), offset, maxSize);
 
-  for (size_t i = 0; i < relocCount; i++) {
-    const RelocData& rd = rdList[i];
+  // The padding has to be recalculated if the code before it is relaxed, even
+  // if there is no padding at the moment.
+  if (hasAsmOption(kOptionRelaxBranches))
+    ASMJIT_PROPAGATE_ERROR(_addRelaxItem(kX86RelaxAlign, i, alignMode, offset, static_cast<intptr_t>(getOffset()), maxSize));
 
-    // Make sure that the `RelocData` is correct.
-    Ptr ptr = rd.data;
+  if (i == 0)
+    return kErrorOk;
 
-    size_t offset = static_cast<size_t>(rd.from);
-    ASMJIT_ASSERT(offset + rd.size <= static_cast<Ptr>(maxCodeSize));
+  if (getRemainingSpace() < i)
+    ASMJIT_PROPAGATE_ERROR(_grow(i));
 
-    // Whether to use trampoline, can be only used if relocation type is
-    // kRelocAbsToRel on 64-bit.
-    bool useTrampoline = false;
+  setCursor(X86Assembler_fillAlign(getCursor(), i, alignMode, X86Assembler_getAlignNopSize(this)));
+  return kErrorOk;
+}
 
-    switch (rd.type) {
-      case kRelocAbsToAbs:
-        break;
+Error X86Assembler::setAutoAlign(uint32_t funcAlign, uint32_t loopAlign, uint32_t maxPadding) noexcept {
+  if (funcAlign > 64 || loopAlign > 64 || maxPadding > 63 ||
+      (funcAlign > 1 && !Utils::isPowerOf2(funcAlign)) ||
+      (loopAlign > 1 && !Utils::isPowerOf2(loopAlign))) {
+    return setLastError(kErrorInvalidArgument);
+  }
 
-      case kRelocRelToAbs:
-        ptr += baseAddress;
-        break;
+  _funcAlign = static_cast<uint8_t>(funcAlign);
+  _loopAlign = static_cast<uint8_t>(loopAlign);
+  _maxAlignPadding = static_cast<uint8_t>(maxPadding);
+  return kErrorOk;
+}
 
-      case kRelocAbsToRel:
-        ptr -= baseAddress + rd.from + 4;
-        break;
+Error X86Assembler::setNopMaxSize(uint32_t nopMaxSize) noexcept {
+  if (nopMaxSize < 1 || nopMaxSize > kX86NopMaxSizeAMD)
+    return setLastError(kErrorInvalidArgument);
 
-      case kRelocTrampoline:
-        ptr -= baseAddress + rd.from + 4;
-        if (!Utils::isInt32(static_cast<SignedPtr>(ptr))) {
-          ptr = (Ptr)tramp - (baseAddress + rd.from + 4);
-          useTrampoline = true;
-        }
-        break;
+  _nopMaxSize = static_cast<uint8_t>(nopMaxSize);
+  return kErrorOk;
+}
 
-      default:
-        ASMJIT_NOT_REACHED();
-    }
+// ============================================================================
+// [asmjit::X86Assembler - Relax]
+// ============================================================================
 
-    switch (rd.size) {
-      case 4:
-        Utils::writeU32u(dst + offset, static_cast<int32_t>(static_cast<SignedPtr>(ptr)));
-        break;
+enum {
+  //! Size of a short jmp/jcc (rel8).
+  kX86RelaxShortSize = 2,
+  //! Size of a long jmp (rel32).
+  kX86RelaxLongJmpSize = 5,
+  //! Size of a long jcc (rel32).
+  kX86RelaxLongJccSize = 6
+};
 
-      case 8:
-        Utils::writeI64u(dst + offset, static_cast<int64_t>(ptr));
-        break;
+//! \internal
+//!
+//! Layout of a single `X86RelaxItem` computed by `X86Assembler::relax()`.
+struct X86RelaxLayout {
+  //! New offset of the item.
+  intptr_t offset;
+  //! Sum of size differences of all items before this one.
+  intptr_t delta;
+  //! New size of the item.
+  uint32_t size;
+  //! The jump has been enlarged and must not be shrunk again.
+  uint32_t locked;
+};
 
-      default:
-        ASMJIT_NOT_REACHED();
+//! \internal
+//!
+//! Translate `offset` of the code-buffer before relaxation to the new offset.
+//!
+//! All items that start before `offset` are taken into account. An alignment
+//! that starts exactly at `offset` is considered to be before it, because it
+//! precedes a label or instruction that has been emitted after it.
+static intptr_t X86Assembler_relaxMap(const X86RelaxItem* items, const X86RelaxLayout* layout, size_t count, intptr_t offset) noexcept {
+  size_t lo = 0;
+  size_t n = count;
+
+  while (n) {
+    size_t half = n / 2;
+    if (items[lo + half].offset < offset) {
+      lo += half + 1;
+      n -= half + 1;
     }
+    else {
+      n = half;
+    }
+  }
 
-    // Handle the trampoline case.
-    if (useTrampoline) {
-      // Bytes that replace [REX, OPCODE] bytes.
-      uint32_t byte0 = 0xFF;
-      uint32_t byte1 = dst[offset - 1];
-
-      // Call, patch to FF/2 (-> 0x15).
-      if (byte1 == 0xE8)
-        byte1 = x86EncodeMod(0, 2, 5);
-      // Jmp, patch to FF/4 (-> 0x25).
-      else if (byte1 == 0xE9)
-        byte1 = x86EncodeMod(0, 4, 5);
+  while (lo < count && items[lo].offset == offset && (items[lo].type == kX86RelaxAlign || items[lo].type == kX86RelaxPad))
+    lo++;
 
-      // Patch `jmp/call` instruction.
-      ASMJIT_ASSERT(offset >= 2);
-      dst[offset - 2] = byte0;
-      dst[offset - 1] = byte1;
+  return offset + layout[lo].delta;
+}
 
-      // Absolute address.
-      Utils::writeU64u(tramp, static_cast<uint64_t>(rd.data));
+static ASMJIT_INLINE uint32_t X86Assembler_relaxLongSize(uint32_t type) noexcept {
+  return type == kX86RelaxJmp ? kX86RelaxLongJmpSize : kX86RelaxLongJccSize;
+}
 
-      // Advance trampoline pointer.
-      tramp += 8;
+//! \internal
+//!
+//! Get the size of the padding needed by a branch (or a macro-fused pair) of
+//! `size` bytes at `offset` so it doesn't cross or end on a 32-byte boundary.
+static ASMJIT_INLINE uint32_t X86Assembler_branchPadding(intptr_t offset, intptr_t size) noexcept {
+  if ((offset >> 5) == ((offset + size) >> 5))
+    return 0;
+  return static_cast<uint32_t>(Utils::alignDiff<intptr_t>(offset, 32));
+}
 
-#if !defined(ASMJIT_DISABLE_LOGGER)
-      if (logger)
-        logger->logFormat(Logger::kStyleComment, "; Trampoline %llX\n", rd.data);
-#endif // !ASMJIT_DISABLE_LOGGER
-    }
+//! \internal
+//!
+//! Get the padding of `kX86RelaxPad` item at `i`, which starts at `offset`.
+//!
+//! The padded code contains an optional macro-fused instruction and a branch,
+//! which can be relaxed as well, in that case it's the next item.
+static uint32_t X86Assembler_relaxPadding(const X86RelaxItem* items, const X86RelaxLayout* layout, size_t count, size_t i, intptr_t offset) noexcept {
+  const X86RelaxItem& item = items[i];
+  intptr_t size = static_cast<intptr_t>(item.id);
+
+  if (i + 1 < count) {
+    const X86RelaxItem& next = items[i + 1];
+    if (next.type <= kX86RelaxJcc && next.offset == item.offset + item.size + item.opCode)
+      size += static_cast<intptr_t>(layout[i + 1].size) - static_cast<intptr_t>(next.size);
   }
 
-  if (arch == kArchX64)
-    return (size_t)(tramp - dst);
-  else
-    return (size_t)(minCodeSize);
+  return X86Assembler_branchPadding(offset, size);
 }
 
-// ============================================================================
-// [asmjit::X86Assembler - Logging]
+//! \internal
+//!
+//! Get offset of the label `id` if it's bound in the current section, -1 otherwise.
+static ASMJIT_INLINE intptr_t X86Assembler_relaxTarget(const X86Assembler* self, uint32_t id) noexcept {
+  return self->_isLabelLocal(id) ? self->getLabelOffset(id) : intptr_t(-1);
+}
+
+Error X86Assembler::_addRelaxItem(uint32_t type, uint32_t size, uint32_t opCode, uint32_t id, intptr_t offset, intptr_t displacement) noexcept {
+  X86RelaxItem item;
+
+  item.type = static_cast<uint8_t>(type);
+  item.size = static_cast<uint8_t>(size);
+  item.opCode = static_cast<uint8_t>(opCode);
+  item.reserved = 0;
+  item.id = id;
+  item.sectionId = _sectionId;
+  item.offset = offset;
+  item.displacement = displacement;
+
+  Error error = _append(_relaxItems, item);
+  if (error != kErrorOk)
+    return setLastError(error);
+
+  return kErrorOk;
+}
+
+Error X86Assembler::relax() noexcept {
+  size_t count = _relaxItems.getLength();
+  if (count == 0)
+    return kErrorOk;
+
+  if (_lastError != kErrorOk)
+    return _lastError;
+
+  // Relaxation moves code that existed before the checkpoint.
+  if (_checkpointDepth != 0)
+    return setLastError(kErrorInvalidState);
+
+  X86RelaxItem* items = _relaxItems.getData();
+  size_t sectionsCount = getSectionsCount();
+
+  if (sectionsCount == 1)
+    return _relaxSection(items, count);
+
+  // Group items by section, each section is relaxed separately. The order of
+  // items within a section is kept, which means that they stay sorted.
+  size_t* starts = static_cast<size_t*>(ASMJIT_ALLOC((sectionsCount + 1) * sizeof(size_t)));
+  X86RelaxItem* sorted = static_cast<X86RelaxItem*>(ASMJIT_ALLOC(count * sizeof(X86RelaxItem)));
+
+  if (starts == nullptr || sorted == nullptr) {
+    if (starts != nullptr) ASMJIT_FREE(starts);
+    if (sorted != nullptr) ASMJIT_FREE(sorted);
+    return setLastError(kErrorNoHeapMemory);
+  }
+
+  size_t i;
+  ::memset(starts, 0, (sectionsCount + 1) * sizeof(size_t));
+
+  for (i = 0; i < count; i++)
+    starts[items[i].sectionId + 1]++;
+  for (i = 0; i < sectionsCount; i++)
+    starts[i + 1] += starts[i];
+  for (i = 0; i < count; i++)
+    sorted[starts[items[i].sectionId]++] = items[i];
+
+  ::memcpy(items, sorted, count * sizeof(X86RelaxItem));
+  ASMJIT_FREE(sorted);
+
+  // `starts[i]` now points to the end of the section `i`.
+  uint32_t sectionId = _sectionId;
+  Error error = kErrorOk;
+  size_t start = 0;
+
+  for (i = 0; i < sectionsCount && error == kErrorOk; i++) {
+    size_t end = starts[i];
+    if (start == end)
+      continue;
+
+    _switchSection(static_cast<uint32_t>(i));
+    error = _relaxSection(items + start, end - start);
+    start = end;
+  }
+
+  _switchSection(sectionId);
+  ASMJIT_FREE(starts);
+
+  return error;
+}
+
+Error X86Assembler::_relaxSection(X86RelaxItem* items, size_t count) noexcept {
+  // The code-buffer is rewritten as a whole, chunks have to be gathered first.
+  ASMJIT_PROPAGATE_ERROR(_flatten());
+
+  size_t i;
+
+  // Layout has one more entry that holds the total delta.
+  X86RelaxLayout* layout = static_cast<X86RelaxLayout*>(
+    ASMJIT_ALLOC((count + 1) * sizeof(X86RelaxLayout)));
+
+  if (layout == nullptr)
+    return setLastError(kErrorNoHeapMemory);
+
+  for (i = 0; i < count; i++) {
+    layout[i].size = items[i].size;
+    layout[i].locked = false;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Fixpoint]
+  // --------------------------------------------------------------------------
+
+  // Jumps start in the form they were emitted (long if the label was not bound
+  // yet) and are shrunk as long as their target fits into rel8. Shrinking only
+  // decreases distances, however, an alignment or branch padding can grow as
+  // the code before it shrinks. A short jump that doesn't fit anymore is
+  // enlarged and locked, which guarantees that the iteration terminates.
+  bool changed;
+  do {
+    intptr_t delta = 0;
+
+    for (i = 0; i < count; i++) {
+      const X86RelaxItem& item = items[i];
+      X86RelaxLayout& cur = layout[i];
+
+      cur.offset = item.offset + delta;
+      cur.delta = delta;
+
+      if (item.type == kX86RelaxAlign)
+        cur.size = X86Assembler_alignPadding(cur.offset, item.id, static_cast<uint32_t>(item.displacement));
+      else if (item.type == kX86RelaxPad)
+        cur.size = X86Assembler_relaxPadding(items, layout, count, i, cur.offset);
+
+      delta += static_cast<intptr_t>(cur.size) - static_cast<intptr_t>(item.size);
+    }
+    layout[count].delta = delta;
+
+    changed = false;
+    for (i = 0; i < count; i++) {
+      const X86RelaxItem& item = items[i];
+      X86RelaxLayout& cur = layout[i];
+
+      if (item.type > kX86RelaxJcc)
+        continue;
+
+      intptr_t target = X86Assembler_relaxTarget(this, item.id);
+      if (target == -1)
+        continue;
+
+      target = X86Assembler_relaxMap(items, layout, count, target);
+
+      if (cur.size == kX86RelaxShortSize) {
+        if (!Utils::isInt8(target - (cur.offset + kX86RelaxShortSize))) {
+          cur.size = X86Assembler_relaxLongSize(item.type);
+          cur.locked = true;
+          changed = true;
+        }
+      }
+      else if (!cur.locked) {
+        // Target of a forward jump moves as well when the jump is shrunk.
+        if (target > cur.offset)
+          target -= static_cast<intptr_t>(cur.size) - kX86RelaxShortSize;
+
+        if (Utils::isInt8(target - (cur.offset + kX86RelaxShortSize))) {
+          cur.size = kX86RelaxShortSize;
+          changed = true;
+        }
+      }
+    }
+  } while (changed);
+
+  // --------------------------------------------------------------------------
+  // [Rewrite]
+  // --------------------------------------------------------------------------
+
+  intptr_t totalDelta = layout[count].delta;
+  size_t oldSize = getOffset();
+  size_t newSize = static_cast<size_t>(static_cast<intptr_t>(oldSize) + totalDelta);
+  size_t newCapacity = Utils::iMax<size_t>(getCapacity(), newSize);
+
+  Error error = kErrorOk;
+  uint32_t relaxedCount = 0;
+
+  for (i = 0; i < count; i++) {
+    if (items[i].type <= kX86RelaxJcc && layout[i].size != items[i].size)
+      relaxedCount++;
+  }
+
+  uint8_t* newBuffer = static_cast<uint8_t*>(ASMJIT_ALLOC(newCapacity));
+  if (newBuffer == nullptr) {
+    ASMJIT_FREE(layout);
+    return setLastError(kErrorNoHeapMemory);
+  }
+
+  uint8_t* cursor = newBuffer;
+  size_t src = 0;
+
+  for (i = 0; i < count; i++) {
+    const X86RelaxItem& item = items[i];
+    const X86RelaxLayout& cur = layout[i];
+
+    if (item.type == kX86RelaxDisp)
+      continue;
+
+    size_t itemOffset = static_cast<size_t>(item.offset);
+    ::memcpy(cursor, _buffer + src, itemOffset - src);
+    cursor += itemOffset - src;
+    src = itemOffset + item.size;
+
+    ASMJIT_ASSERT(cursor == newBuffer + cur.offset);
+
+    if (item.type == kX86RelaxAlign) {
+      cursor = X86Assembler_fillAlign(cursor, cur.size, item.opCode, X86Assembler_getAlignNopSize(this));
+      continue;
+    }
+
+    if (item.type == kX86RelaxPad) {
+      cursor = X86Assembler_fillAlign(cursor, cur.size, kAlignCode, _nopMaxSize);
+      continue;
+    }
+
+    intptr_t target = X86Assembler_relaxTarget(this, item.id);
+    if (target == -1) {
+      // Not bound yet (or bound in another section), the jump is patched
+      // through `LabelLink`.
+      ::memcpy(cursor, _buffer + itemOffset, item.size);
+      cursor += item.size;
+      continue;
+    }
+
+    intptr_t disp = X86Assembler_relaxMap(items, layout, count, target) - (cur.offset + cur.size);
+    if (cur.size == kX86RelaxShortSize) {
+      EMIT_BYTE(item.opCode);
+      EMIT_BYTE(disp);
+    }
+    else {
+      if (item.type == kX86RelaxJmp) {
+        EMIT_BYTE(0xE9);
+      }
+      else {
+        EMIT_BYTE(0x0F);
+        EMIT_BYTE(item.opCode + 0x10);
+      }
+      EMIT_DWORD(static_cast<int32_t>(disp));
+    }
+  }
+
+  ::memcpy(cursor, _buffer + src, oldSize - src);
+  cursor += oldSize - src;
+  ASMJIT_ASSERT(cursor == newBuffer + newSize);
+
+  // Patch displacements that have a fixed size.
+  for (i = 0; i < count; i++) {
+    const X86RelaxItem& item = items[i];
+    if (item.type != kX86RelaxDisp)
+      continue;
+
+    intptr_t target = X86Assembler_relaxTarget(this, item.id);
+    if (target == -1)
+      continue;
+
+    intptr_t offset = layout[i].offset;
+    intptr_t disp = X86Assembler_relaxMap(items, layout, count, target) - offset + item.displacement;
+
+    if (item.size == 4) {
+      Utils::writeI32u(newBuffer + offset, static_cast<int32_t>(disp));
+    }
+    else {
+      ASMJIT_ASSERT(item.size == 1);
+      if (!Utils::isInt8(disp))
+        error = kErrorIllegalDisplacement;
+      else
+        newBuffer[offset] = static_cast<uint8_t>(disp & 0xFF);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Update]
+  // --------------------------------------------------------------------------
+
+  // Relocations of labels that are not bound yet contain only a displacement,
+  // the label offset is added by `bind()`, so their data must stay intact.
+  size_t relocCount = _relocations.getLength();
+  uint8_t* relocPending = nullptr;
+
+  if (relocCount != 0) {
+    relocPending = static_cast<uint8_t*>(ASMJIT_ALLOC(relocCount));
+    if (relocPending == nullptr) {
+      ASMJIT_FREE(newBuffer);
+      ASMJIT_FREE(layout);
+      return setLastError(kErrorNoHeapMemory);
+    }
+    ::memset(relocPending, 0, relocCount);
+  }
+
+  uint32_t sectionId = _sectionId;
+  size_t labelCount = _labelOffsets.getLength();
+
+  intptr_t* labelOffsets = _labelOffsets.getData();
+  const uint32_t* labelLinkHeads = _labelLinkHeads.getData();
+  const uint32_t* labelSections = _labelSections.getData();
+  LabelLink* links = _labelLinks.getData();
+
+  for (i = 0; i < labelCount; i++) {
+    if (labelOffsets[i] != -1 && labelSections[i] == sectionId)
+      labelOffsets[i] = X86Assembler_relaxMap(items, layout, count, labelOffsets[i]);
+
+    // Bound labels can have links from other sections, see `Assembler::bind()`.
+    for (uint32_t linkIndex = labelLinkHeads[i]; linkIndex != kInvalidValue; linkIndex = links[linkIndex].prev) {
+      LabelLink& link = links[linkIndex];
+      if (link.sectionId == sectionId)
+        link.offset = X86Assembler_relaxMap(items, layout, count, link.offset);
+      if (labelOffsets[i] == -1 && link.relocId != -1)
+        relocPending[link.relocId] = 1;
+    }
+  }
+
+  RelocData* rdList = _relocations.getData();
+  for (i = 0; i < relocCount; i++) {
+    RelocData& rd = rdList[i];
+
+    if (rd.fromSection == sectionId)
+      rd.from = static_cast<uint32_t>(X86Assembler_relaxMap(items, layout, count, static_cast<intptr_t>(rd.from)));
+    if (rd.type == kRelocRelToAbs && rd.dataSection == sectionId && !relocPending[i])
+      rd.data = static_cast<Ptr>(X86Assembler_relaxMap(items, layout, count, static_cast<intptr_t>(rd.data)));
+  }
+
+  for (i = 0; i < count; i++) {
+    items[i].offset = layout[i].offset;
+    items[i].size = static_cast<uint8_t>(layout[i].size);
+  }
+
+  if (relocPending != nullptr)
+    ASMJIT_FREE(relocPending);
+  ASMJIT_FREE(layout);
+
+  ASMJIT_FREE(_buffer);
+  _buffer = newBuffer;
+  _end = newBuffer + newCapacity;
+  _cursor = newBuffer + newSize;
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  if (_logger && relaxedCount != 0)
+    _logger->logFormat(Logger::kStyleComment,
+      "; Relaxed %u jumps, code size %u -> %u.\n",
+      relaxedCount,
+      static_cast<unsigned int>(oldSize),
+      static_cast<unsigned int>(newSize));
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  if (error != kErrorOk)
+    return setLastError(error);
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Assembler - Reloc]
+// ============================================================================
+
+//! \internal
+//!
+//! Get the size of a GOT entry or trampoline that has to be reserved for a
+//! relocation of `data`, which is about to be added to the current section.
+//! Only the first relocation of each target reserves 8 bytes, the others
+//! share its entry, see `X86Assembler::_relocSection()`.
+static Error X86Assembler_reserveEntry(X86Assembler* self, uint64_t data, uint32_t& size) noexcept {
+  size = 8;
+
+  // Fixed mode must not allocate, the reservation is only an upper bound.
+  if (self->isFixedBuffer())
+    return kErrorOk;
+
+  X86RelocEntryMap* map = self->_relocEntries;
+  if (map == nullptr) {
+    void* p = ASMJIT_ALLOC(sizeof(X86RelocEntryMap));
+    if (p == nullptr)
+      return kErrorNoHeapMemory;
+
+    map = new(p) X86RelocEntryMap();
+    self->_relocEntries = map;
+  }
+
+  uint32_t section = self->_sectionId;
+  size_t relocIndex = self->_relocations.getLength();
+
+  X86RelocEntryMap::Slot* slot = map->find(data, section);
+  if (slot->value == 0)
+    return map->add(slot, data, section, relocIndex + 1) ? kErrorOk : kErrorNoHeapMemory;
+
+  // The relocation that reserved the entry could have been removed by
+  // `rollback()` or by branch alignment, reserve it again in that case.
+  size_t i = slot->value - 1;
+  if (i < relocIndex) {
+    const RelocData& rd = self->_relocations[i];
+    if ((rd.type == kRelocAbsToGot || rd.type == kRelocTrampoline) &&
+        rd.fromSection == section &&
+        static_cast<uint64_t>(rd.data) == data) {
+      size = 0;
+      return kErrorOk;
+    }
+  }
+
+  slot->value = relocIndex + 1;
+  return kErrorOk;
+}
+
+size_t X86Assembler::_relocSection(uint32_t id, void* _dst, const Ptr* baseAddresses) const noexcept {
+  uint32_t arch = getArch();
+  uint8_t* dst = static_cast<uint8_t*>(_dst);
+  Ptr baseAddress = baseAddresses[id];
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  Logger* logger = getLogger();
+#endif // ASMJIT_DISABLE_LOGGER
+
+  size_t minCodeSize = getSectionLength(id); // Section length is the minimum code size.
+  size_t maxCodeSize = getSectionSize(id);   // Includes all possible trampolines.
+
+  // We will copy the exact size of the generated code. Extra code for trampolines
+  // is generated on-the-fly by the relocator (this code doesn't exist at the moment).
+  _copySectionData(id, dst);
+
+  // Trampoline pointer.
+  uint8_t* tramp = dst + minCodeSize;
+
+  // Trampolines and GOT entries, one per target.
+  X86RelocEntryMap entries;
+
+  // Relocate all recorded locations.
+  size_t relocCount = _relocations.getLength();
+  const RelocData* rdList = _relocations.getData();
+
+  for (size_t i = 0; i < relocCount; i++) {
+    const RelocData& rd = rdList[i];
+    if (rd.fromSection != id)
+      continue;
+
+    // Make sure that the `RelocData` is correct.
+    Ptr ptr = rd.data;
+
+    size_t offset = static_cast<size_t>(rd.from);
+    ASMJIT_ASSERT(offset + rd.size <= static_cast<Ptr>(maxCodeSize));
+
+    // Whether to use trampoline, can be only used if relocation type is
+    // kRelocAbsToRel on 64-bit.
+    bool useTrampoline = false;
+
+    switch (rd.type) {
+      case kRelocAbsToAbs:
+        break;
+
+      case kRelocRelToAbs:
+        ptr += baseAddresses[rd.dataSection];
+        break;
+
+      case kRelocAbsToRel:
+        ptr -= baseAddress + rd.from + 4;
+        break;
+
+      case kRelocTrampoline:
+      case kRelocAbsToGot: {
+        if (rd.type == kRelocTrampoline) {
+          ptr -= baseAddress + rd.from + 4;
+          if (Utils::isInt32(static_cast<SignedPtr>(ptr)))
+            break;
+          useTrampoline = true;
+        }
+
+        // Each absolute address is stored only once and shared by all
+        // relocations of the same target, including trampolines. There is
+        // always enough space as `X86Assembler` reserves an entry for each
+        // target of the section.
+        X86RelocEntryMap::Slot* slot = entries.find(static_cast<uint64_t>(rd.data), id);
+        size_t entry = slot->value;
+
+        if (entry == 0) {
+          entry = (size_t)(tramp - dst);
+          Utils::writeU64u(tramp, static_cast<uint64_t>(rd.data));
+          tramp += 8;
+
+          if (!entries.add(slot, static_cast<uint64_t>(rd.data), id, entry))
+            return kInvalidIndex;
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+          if (logger && useTrampoline)
+            logger->logFormat(Logger::kStyleComment, "; Trampoline %llX\n", rd.data);
+#endif // !ASMJIT_DISABLE_LOGGER
+        }
+
+        // Relative to the code, so it doesn't depend on `baseAddress`.
+        ptr = static_cast<Ptr>(entry) - (rd.from + 4);
+        break;
+      }
+
+      default:
+        ASMJIT_NOT_REACHED();
+    }
+
+    switch (rd.size) {
+      case 4:
+        Utils::writeU32u(dst + offset, static_cast<int32_t>(static_cast<SignedPtr>(ptr)));
+        break;
+
+      case 8:
+        Utils::writeI64u(dst + offset, static_cast<int64_t>(ptr));
+        break;
+
+      default:
+        ASMJIT_NOT_REACHED();
+    }
+
+    // Handle the trampoline case.
+    if (useTrampoline) {
+      // Bytes that replace [REX, OPCODE] bytes.
+      uint32_t byte0 = 0xFF;
+      uint32_t byte1 = dst[offset - 1];
+
+      // Call, patch to FF/2 (-> 0x15).
+      if (byte1 == 0xE8)
+        byte1 = x86EncodeMod(0, 2, 5);
+      // Jmp, patch to FF/4 (-> 0x25).
+      else if (byte1 == 0xE9)
+        byte1 = x86EncodeMod(0, 4, 5);
+
+      // Patch `jmp/call` instruction.
+      ASMJIT_ASSERT(offset >= 2);
+      dst[offset - 2] = byte0;
+      dst[offset - 1] = byte1;
+    }
+  }
+
+  // Patch displacements that refer to labels bound in other sections.
+  if (_sections.getLength() != 0) {
+    size_t labelCount = _labelOffsets.getLength();
+
+    const intptr_t* labelOffsets = _labelOffsets.getData();
+    const uint32_t* labelLinkHeads = _labelLinkHeads.getData();
+    const uint32_t* labelSections = _labelSections.getData();
+    const LabelLink* links = _labelLinks.getData();
+
+    for (size_t i = 0; i < labelCount; i++) {
+      if (labelOffsets[i] == -1)
+        continue;
+
+      Ptr target = baseAddresses[labelSections[i]] + static_cast<Ptr>(labelOffsets[i]);
+      for (uint32_t linkIndex = labelLinkHeads[i]; linkIndex != kInvalidValue; linkIndex = links[linkIndex].prev) {
+        const LabelLink* link = &links[linkIndex];
+        if (link->sectionId != id)
+          continue;
+
+        size_t offset = static_cast<size_t>(link->offset);
+        SignedPtr disp = static_cast<SignedPtr>(target - (baseAddress + offset)) + link->displacement;
+
+        // Size of the value we are going to patch, see `Assembler::bind()`.
+        if (dst[offset] == 4) {
+          if (!Utils::isInt32(disp))
+            return kInvalidIndex;
+          Utils::writeI32u(dst + offset, static_cast<int32_t>(disp));
+        }
+        else {
+          ASMJIT_ASSERT(dst[offset] == 1);
+          if (!Utils::isInt8(disp))
+            return kInvalidIndex;
+          dst[offset] = static_cast<uint8_t>(disp & 0xFF);
+        }
+      }
+    }
+  }
+
+  if (arch == kArchX64)
+    return (size_t)(tramp - dst);
+  else
+    return (size_t)(minCodeSize);
+}
+
+// ============================================================================
+// [asmjit::X86Assembler - Logging]
 // ============================================================================
 
 #if !defined(ASMJIT_DISABLE_LOGGER)
@@ -779,6 +1743,7 @@ static void X86Assembler_dumpOperand(StringBuilder& sb, uint32_t arch, const Ope
       case kMemTypeAbsolute:
         // [absolute]
         isAbsolute = true;
+        sb._appendString("0x", 2);
         sb.appendUInt(static_cast<uint32_t>(m->getDisplacement()), 16);
         break;
 
@@ -831,8 +1796,10 @@ static void X86Assembler_dumpOperand(StringBuilder& sb, uint32_t arch, const Ope
     const Imm* i = static_cast<const Imm*>(op);
     int64_t val = i->getInt64();
 
-    if ((loggerOptions & Logger::kOptionHexImmediate) != 0 && static_cast<uint64_t>(val) > 9)
+    if ((loggerOptions & Logger::kOptionHexImmediate) != 0 && static_cast<uint64_t>(val) > 9) {
+      sb._appendString("0x", 2);
       sb.appendUInt(static_cast<uint64_t>(val), 16);
+    }
     else
       sb.appendInt(val, 10);
   }
@@ -844,6 +1811,28 @@ static void X86Assembler_dumpOperand(StringBuilder& sb, uint32_t arch, const Ope
   }
 }
 
+// Dump opmask `{k}` and zeroing `{z}` after the destination operand and the
+// broadcast `{1toN}` after a memory operand.
+static void X86Assembler_dumpEvexOptions(StringBuilder& sb, uint32_t code, uint32_t options, const Operand* op, uint32_t vecSize) {
+  if ((options & kX86InstOptionEvexK_Mask) != 0) {
+    sb._appendString(" {k", 3);
+    sb._appendUInt32((options & kX86InstOptionEvexK_Mask) >> kX86InstOptionEvexK_Shift);
+    sb._appendChar('}');
+
+    if ((options & kX86InstOptionEvexZero) != 0)
+      sb._appendString("{z}", 3);
+  }
+
+  if ((options & kX86InstOptionEvexOneN) != 0 && op->isMem()) {
+    uint32_t opCode = _x86InstInfo[code].getPrimaryOpCode();
+    uint32_t elementSize = (opCode & (kX86InstOpCode_W | kX86InstOpCode_EW)) ? 8 : 4;
+
+    sb._appendString(" {1to", 5);
+    sb._appendUInt32(vecSize / elementSize);
+    sb._appendChar('}');
+  }
+}
+
 static bool X86Assembler_dumpInstruction(StringBuilder& sb,
   uint32_t arch,
   uint32_t code,
@@ -861,6 +1850,12 @@ static bool X86Assembler_dumpInstruction(StringBuilder& sb,
   if (options & kX86InstOptionRex)
     sb._appendString("rex ", 4);
 
+  if (options & kX86InstOptionRex2)
+    sb._appendString("rex2 ", 5);
+
+  if (options & kX86InstOptionNf)
+    sb._appendString("{nf} ", 5);
+
   if (options & kX86InstOptionLock)
     sb._appendString("lock ", 5);
 
@@ -874,16 +1869,19 @@ static bool X86Assembler_dumpInstruction(StringBuilder& sb,
   if (!o0->isNone()) {
     sb._appendChar(' ');
     X86Assembler_dumpOperand(sb, arch, o0, loggerOptions);
+    X86Assembler_dumpEvexOptions(sb, code, options, o0, o0->getSize());
   }
 
   if (!o1->isNone()) {
     sb._appendString(", ", 2);
     X86Assembler_dumpOperand(sb, arch, o1, loggerOptions);
+    X86Assembler_dumpEvexOptions(sb, code, options & kX86InstOptionEvexOneN, o1, o0->getSize());
   }
 
   if (!o2->isNone()) {
     sb._appendString(", ", 2);
     X86Assembler_dumpOperand(sb, arch, o2, loggerOptions);
+    X86Assembler_dumpEvexOptions(sb, code, options & kX86InstOptionEvexOneN, o2, o0->getSize());
   }
 
   if (!o3->isNone()) {
@@ -891,8 +1889,77 @@ static bool X86Assembler_dumpInstruction(StringBuilder& sb,
     X86Assembler_dumpOperand(sb, arch, o3, loggerOptions);
   }
 
+  // Dump SAE and static rounding mode.
+  if (options & (kX86EvexRounding | kX86InstOptionEvexSae)) {
+    const char* sae = "{sae}";
+    if (options & kX86InstOptionEvexRnSae) sae = "{rn-sae}";
+    if (options & kX86InstOptionEvexRdSae) sae = "{rd-sae}";
+    if (options & kX86InstOptionEvexRuSae) sae = "{ru-sae}";
+    if (options & kX86InstOptionEvexRzSae) sae = "{rz-sae}";
+
+    sb._appendString(", ", 2);
+    sb._appendString(sae);
+  }
+
   return true;
 }
+
+//! \internal
+//!
+//! Format an instruction recorded by `BinaryLogger`, see `LogFormatFunc`.
+static bool X86Assembler_formatRecord(StringBuilder& sb, const LogRecord& record, uint32_t loggerOptions) {
+  const Operand* operands = record.operands;
+
+  if (!X86Assembler_dumpInstruction(sb, record.arch, record.instId, record.options,
+      &operands[0], &operands[1], &operands[2], &operands[3], loggerOptions))
+    return false;
+
+  if ((loggerOptions & Logger::kOptionBinaryForm) != 0)
+    return LogUtil::formatLine(sb, record.binary, record.size, record.dispSize, record.immSize, record.comment);
+  else
+    return LogUtil::formatLine(sb, nullptr, kInvalidIndex, 0, 0, record.comment);
+}
+
+//! \internal
+//!
+//! Record an instruction encoded from `self->_cursor` to `cursor` into the
+//! `BinaryLogger` attached to `self`.
+static ASMJIT_INLINE void X86Assembler_recordInstruction(X86Assembler* self,
+  uint32_t arch,
+  uint32_t code,
+  uint32_t options,
+  const Operand* o0,
+  const Operand* o1,
+  const Operand* o2,
+  const Operand* o3,
+  const uint8_t* cursor,
+  uint32_t dispSize,
+  uint32_t immSize) {
+
+  LogRecord* record = static_cast<BinaryLogger*>(self->_logger)->_newRecord(X86Assembler_formatRecord);
+  if (record == nullptr)
+    return;
+
+  uint32_t size = static_cast<uint32_t>((size_t)(cursor - self->_cursor));
+  if (size > LogRecord::kMaxBinaryLength)
+    size = LogRecord::kMaxBinaryLength;
+
+  record->type = LogRecord::kTypeInst;
+  record->arch = static_cast<uint8_t>(arch);
+  record->dispSize = static_cast<uint8_t>(dispSize);
+  record->immSize = static_cast<uint8_t>(immSize);
+  record->size = size;
+  record->instId = code;
+  record->options = options;
+  record->offset = self->getOffset();
+  record->comment = self->_comment;
+
+  ::memcpy(record->binary, self->_cursor, size);
+  record->operands[0] = *o0;
+  record->operands[1] = *o1;
+  record->operands[2] = *o2;
+  record->operands[3] = *o3;
+}
 #endif // !ASMJIT_DISABLE_LOGGER
 
 // ============================================================================
@@ -912,26 +1979,474 @@ static const Operand::VRegOp x86PatchedHiRegs[4] = {
 };
 #undef HI_REG
 
+// ============================================================================
+// [asmjit::X86Assembler - Emit - Fast Path]
+// ============================================================================
+
+//! \internal
+//!
+//! Operand signatures handled by the fast path.
+ASMJIT_ENUM(X86FastSig) {
+  kX86FastSigR = 0,                      //!< [Reg].
+  kX86FastSigRR = 1,                     //!< [Reg, Reg].
+  kX86FastSigRI = 2,                     //!< [Reg, Imm].
+  kX86FastSigRM = 3,                     //!< [Reg, Mem].
+  kX86FastSigMR = 4,                     //!< [Mem, Reg].
+  kX86FastSigCount = 5,                  //!< Count of fast signatures.
+  kX86FastSigNone = 0xFF                 //!< Signature not handled by the fast path.
+};
+
+//! \internal
+//!
+//! Rows of the fast path dispatch table.
+ASMJIT_ENUM(X86FastRow) {
+  kX86FastRowNone = 0,
+  kX86FastRowArith = 1,
+  kX86FastRowLea = 2,
+  kX86FastRowMov = 3,
+  kX86FastRowPush = 4,
+  kX86FastRowPop = 5,
+  kX86FastRowTest = 6,
+  kX86FastRowCount = 7
+};
+
+#define SIG(op0, op1) ((Operand::kType##op0) + ((Operand::kType##op1) << 3))
+//! \internal
+//!
+//! Map the first two operand types (each 3 bits) of an instruction, which
+//! has no other operands, to `X86FastSig`.
+static const uint8_t x86FastSigTable[64] = {
+#define S(index) ( \
+  (index) == SIG(Reg, None) ? kX86FastSigR  : \
+  (index) == SIG(Reg, Reg ) ? kX86FastSigRR : \
+  (index) == SIG(Reg, Imm ) ? kX86FastSigRI : \
+  (index) == SIG(Reg, Mem ) ? kX86FastSigRM : \
+  (index) == SIG(Mem, Reg ) ? kX86FastSigMR : kX86FastSigNone)
+  S( 0), S( 1), S( 2), S( 3), S( 4), S( 5), S( 6), S( 7),
+  S( 8), S( 9), S(10), S(11), S(12), S(13), S(14), S(15),
+  S(16), S(17), S(18), S(19), S(20), S(21), S(22), S(23),
+  S(24), S(25), S(26), S(27), S(28), S(29), S(30), S(31),
+  S(32), S(33), S(34), S(35), S(36), S(37), S(38), S(39),
+  S(40), S(41), S(42), S(43), S(44), S(45), S(46), S(47),
+  S(48), S(49), S(50), S(51), S(52), S(53), S(54), S(55),
+  S(56), S(57), S(58), S(59), S(60), S(61), S(62), S(63)
+#undef S
+};
+#undef SIG
+
+//! \internal
+//!
+//! Map `X86InstEncoding` to `X86FastRow`, encodings not listed here are
+//! always emitted by the generic path.
+static const uint8_t x86FastRowTable[_kX86InstEncodingCount] = {
+  kX86FastRowNone ,                      // kX86InstEncodingNone.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Op.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Op_66H.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Rm.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Rm_B.
+  kX86FastRowNone ,                      // kX86InstEncodingX86RmReg.
+  kX86FastRowNone ,                      // kX86InstEncodingX86RegRm.
+  kX86FastRowNone ,                      // kX86InstEncodingX86M.
+  kX86FastRowArith,                      // kX86InstEncodingX86Arith.
+  kX86FastRowNone ,                      // kX86InstEncodingX86BSwap.
+  kX86FastRowNone ,                      // kX86InstEncodingX86BTest.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Call.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Enter.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Imul.
+  kX86FastRowNone ,                      // kX86InstEncodingX86IncDec.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Int.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Jcc.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Jecxz.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Jmp.
+  kX86FastRowLea  ,                      // kX86InstEncodingX86Lea.
+  kX86FastRowMov  ,                      // kX86InstEncodingX86Mov.
+  kX86FastRowNone ,                      // kX86InstEncodingX86MovsxMovzx.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Movsxd.
+  kX86FastRowNone ,                      // kX86InstEncodingX86MovPtr.
+  kX86FastRowPush ,                      // kX86InstEncodingX86Push.
+  kX86FastRowPop  ,                      // kX86InstEncodingX86Pop.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Rep.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Ret.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Rot.
+  kX86FastRowNone ,                      // kX86InstEncodingX86Set.
+  kX86FastRowNone ,                      // kX86InstEncodingX86ShldShrd.
+  kX86FastRowTest                        // kX86InstEncodingX86Test.
+  // ... The remaining encodings are zero initialized (kX86FastRowNone) ...
+};
+
+//! \internal
+//!
+//! Fast path encoder, returns the advanced `cursor` or `nullptr` if the
+//! instruction has to be emitted by the generic path.
+typedef uint8_t* (*X86FastEmitFunc)(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1);
+
+//! \internal
+//!
+//! Fast path encoders of the most common GP forms - only 32-bit and 64-bit
+//! GP registers (the latter in 64-bit mode only) and simple `[base + index *
+//! scale + disp]` memory operands without segment override are accepted.
+//! Everything else is rejected and encoded by `X86Assembler_emit()`, which
+//! must produce exactly the same bytes for the forms accepted here.
 template<int Arch>
-static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, const Operand* o0, const Operand* o1, const Operand* o2, const Operand* o3) {
-  X86Assembler* self = static_cast<X86Assembler*>(self_);
-  uint32_t options = self->getInstOptionsAndReset();
+struct X86FastEmit {
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  //! Get the size of `op` if it's a GP register accepted by the fast path,
+  //! zero otherwise (R16..R31 require REX2 and are left to the generic path).
+  static ASMJIT_INLINE uint32_t gpSize(const Operand* op) noexcept {
+    uint32_t type = op->_vreg.type;
+    uint32_t regCount = Arch == kArchX86 ? 8 : 16;
+
+    if (op->_vreg.index >= regCount)
+      return 0;
+
+    if (type == kX86RegTypeGpd)
+      return 4;
+    if (Arch == kArchX64 && type == kX86RegTypeGpq)
+      return 8;
+    return 0;
+  }
+
+  //! Get whether `op` is a memory operand accepted by the fast path.
+  static ASMJIT_INLINE bool isMem(const Operand* op) noexcept {
+    const X86Mem* m = x86OpMem(op);
+    uint32_t flags = m->_vmem.flags & ~static_cast<uint32_t>(kX86MemShiftMask);
+
+    // 32-bit base (64-bit mode) and 16-bit base (32-bit mode) require 67H.
+    uint32_t expected = Arch == kArchX86 ? static_cast<uint32_t>(kX86MemGpdMask) : 0;
+
+    // Only registers encodable in the current mode are accepted.
+    uint32_t regCount = Arch == kArchX86 ? 8 : 16;
+
+    if (!m->isBaseIndexType() || flags != expected || m->_vmem.base >= regCount)
+      return false;
+
+    uint32_t index = m->_vmem.index;
+    return index == kInvalidValue || (index < regCount && (index & 0x07) != kX86RegIndexSp);
+  }
+
+  //! Emit REX prefix (64-bit only), single-byte opcode, and ModR/M of a
+  //! register form.
+  static ASMJIT_INLINE uint8_t* emitR(uint8_t* cursor, uint32_t opCode, uint32_t opReg, uint32_t rmReg, uint32_t size) noexcept {
+    if (Arch == kArchX64) {
+      uint32_t rex = (size == 8 ? 0x08 : 0) + ((opReg & 0x08) >> 1) + (rmReg >> 3);
+      if (rex)
+        *cursor++ = static_cast<uint8_t>(kX86ByteRex | rex);
+    }
+
+    cursor[0] = static_cast<uint8_t>(opCode);
+    cursor[1] = static_cast<uint8_t>(x86EncodeMod(3, opReg & 0x07, rmReg & 0x07));
+    return cursor + 2;
+  }
+
+  //! Emit REX prefix (64-bit only), single-byte opcode, ModR/M, SIB, and
+  //! displacement of a memory form.
+  static ASMJIT_INLINE uint8_t* emitM(uint8_t* cursor, uint32_t opCode, uint32_t opReg, const Operand* op, uint32_t size) noexcept {
+    const X86Mem* m = x86OpMem(op);
+
+    uint32_t mBase = m->_vmem.base;
+    uint32_t mIndex = m->_vmem.index;
+    int32_t dispOffset = m->_vmem.displacement;
+
+    if (Arch == kArchX64) {
+      uint32_t rex = (size == 8 ? 0x08 : 0) + ((opReg & 0x08) >> 1) +
+                     (static_cast<uint32_t>(mIndex - 8 < 8) << 1) +
+                     (static_cast<uint32_t>(mBase - 8 < 8));
+      if (rex)
+        *cursor++ = static_cast<uint8_t>(kX86ByteRex | rex);
+    }
+
+    *cursor++ = static_cast<uint8_t>(opCode);
+
+    opReg &= 0x07;
+    mBase &= 0x07;
+
+    uint32_t mod = (mBase != kX86RegIndexBp && dispOffset == 0) ? 0 : Utils::isInt8(dispOffset) ? 1 : 2;
+
+    if (mIndex == kInvalidValue) {
+      if (mBase == kX86RegIndexSp) {
+        cursor[0] = static_cast<uint8_t>(x86EncodeMod(mod, opReg, 4));
+        cursor[1] = static_cast<uint8_t>(x86EncodeSib(0, 4, 4));
+        cursor += 2;
+      }
+      else {
+        *cursor++ = static_cast<uint8_t>(x86EncodeMod(mod, opReg, mBase));
+      }
+    }
+    else {
+      cursor[0] = static_cast<uint8_t>(x86EncodeMod(mod, opReg, 4));
+      cursor[1] = static_cast<uint8_t>(x86EncodeSib(m->getShift(), mIndex & 0x07, mBase));
+      cursor += 2;
+    }
+
+    if (mod == 1) {
+      *cursor++ = static_cast<uint8_t>(static_cast<int8_t>(dispOffset));
+    }
+    else if (mod == 2) {
+      Utils::writeU32uLE(cursor, static_cast<uint32_t>(dispOffset));
+      cursor += 4;
+    }
+
+    return cursor;
+  }
+
+  static ASMJIT_INLINE uint8_t* emitImm(uint8_t* cursor, int64_t imVal, uint32_t imLen) noexcept {
+    if (imLen == 1)
+      *cursor++ = static_cast<uint8_t>(imVal & 0xFF);
+    else if (imLen == 4)
+      { Utils::writeU32uLE(cursor, static_cast<uint32_t>(imVal)); cursor += 4; }
+    else
+      { Utils::writeU64uLE(cursor, static_cast<uint64_t>(imVal)); cursor += 8; }
+    return cursor;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Arith]
+  // --------------------------------------------------------------------------
+
+  static uint8_t* arithRR(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    uint32_t size = gpSize(o0);
+    if (size == 0 || size != gpSize(o1))
+      return nullptr;
+    return emitR(cursor, (info.getPrimaryOpCode() & 0xFF) + 3, x86OpReg(o0), x86OpReg(o1), size);
+  }
+
+  static uint8_t* arithRI(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    uint32_t size = gpSize(o0);
+    if (size == 0)
+      return nullptr;
+
+    int64_t imVal = static_cast<const Imm*>(o1)->getInt64();
+    uint32_t imLen = Utils::isInt8(imVal) ? 1 : 4;
+    uint32_t opReg = x86ExtractO(info.getPrimaryOpCode());
+    uint32_t rmReg = x86OpReg(o0);
+
+    // Alternate Form - EAX, RAX.
+    if (rmReg == 0 && imLen != 1) {
+      if (Arch == kArchX64 && size == 8)
+        *cursor++ = static_cast<uint8_t>(kX86ByteRex | 0x08);
+      *cursor++ = static_cast<uint8_t>((opReg << 3) | 0x05);
+    }
+    else {
+      cursor = emitR(cursor, imLen != 1 ? 0x81 : 0x83, opReg, rmReg, size);
+    }
+
+    return emitImm(cursor, imVal, imLen);
+  }
+
+  static uint8_t* arithRM(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    uint32_t size = gpSize(o0);
+    if (size == 0 || !isMem(o1))
+      return nullptr;
+    return emitM(cursor, (info.getPrimaryOpCode() & 0xFF) + 3, x86OpReg(o0), o1, size);
+  }
+
+  static uint8_t* arithMR(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    uint32_t size = gpSize(o1);
+    if (size == 0 || !isMem(o0))
+      return nullptr;
+    return emitM(cursor, (info.getPrimaryOpCode() & 0xFF) + 1, x86OpReg(o1), o0, size);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Lea]
+  // --------------------------------------------------------------------------
+
+  static uint8_t* leaRM(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    uint32_t size = gpSize(o0);
+    if (size == 0 || !isMem(o1))
+      return nullptr;
+    return emitM(cursor, info.getPrimaryOpCode() & 0xFF, x86OpReg(o0), o1, size);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Mov]
+  // --------------------------------------------------------------------------
+
+  static uint8_t* movRR(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    ASMJIT_UNUSED(info);
+
+    uint32_t size = gpSize(o0);
+    if (size == 0 || size != gpSize(o1))
+      return nullptr;
+    return emitR(cursor, 0x8B, x86OpReg(o0), x86OpReg(o1), size);
+  }
+
+  static uint8_t* movRI(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    ASMJIT_UNUSED(info);
+
+    uint32_t size = gpSize(o0);
+    if (size == 0)
+      return nullptr;
+
+    int64_t imVal = static_cast<const Imm*>(o1)->getInt64();
+    uint32_t rmReg = x86OpReg(o0);
+
+    // Optimize instruction size by using 32-bit immediate if possible.
+    if (Arch == kArchX64 && size == 8 && Utils::isInt32(imVal)) {
+      cursor = emitR(cursor, 0xC7, 0, rmReg, 8);
+      return emitImm(cursor, imVal, 4);
+    }
+
+    if (Arch == kArchX64) {
+      uint32_t rex = (size == 8 ? 0x08 : 0) + (rmReg >> 3);
+      if (rex)
+        *cursor++ = static_cast<uint8_t>(kX86ByteRex | rex);
+    }
+
+    *cursor++ = static_cast<uint8_t>(0xB8 + (rmReg & 0x07));
+    return emitImm(cursor, imVal, size);
+  }
+
+  static uint8_t* movRM(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    ASMJIT_UNUSED(info);
+
+    uint32_t size = gpSize(o0);
+    if (size == 0 || !isMem(o1))
+      return nullptr;
+    return emitM(cursor, 0x8B, x86OpReg(o0), o1, size);
+  }
+
+  static uint8_t* movMR(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    ASMJIT_UNUSED(info);
+
+    uint32_t size = gpSize(o1);
+    if (size == 0 || !isMem(o0))
+      return nullptr;
+    return emitM(cursor, 0x89, x86OpReg(o1), o0, size);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Push / Pop]
+  // --------------------------------------------------------------------------
+
+  static uint8_t* pushPopR(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    ASMJIT_UNUSED(o1);
+
+    if (gpSize(o0) == 0)
+      return nullptr;
+
+    // PUSH/POP always use the native size, see `_GroupPop_Gp`.
+    uint32_t opReg = x86OpReg(o0);
+    if (Arch == kArchX64 && opReg >= 8)
+      *cursor++ = static_cast<uint8_t>(kX86ByteRex | 0x01);
+
+    *cursor++ = static_cast<uint8_t>((info.getSecondaryOpCode() & 0xFF) + (opReg & 0x07));
+    return cursor;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Test]
+  // --------------------------------------------------------------------------
+
+  static uint8_t* testRR(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    ASMJIT_UNUSED(info);
+
+    uint32_t size = gpSize(o0);
+    if (size == 0 || size != gpSize(o1))
+      return nullptr;
+    return emitR(cursor, 0x85, x86OpReg(o1), x86OpReg(o0), size);
+  }
+
+  static uint8_t* testRI(uint8_t* cursor, const X86InstInfo& info, const Operand* o0, const Operand* o1) noexcept {
+    ASMJIT_UNUSED(info);
+
+    uint32_t size = gpSize(o0);
+    if (size == 0)
+      return nullptr;
+
+    int64_t imVal = static_cast<const Imm*>(o1)->getInt64();
+    uint32_t rmReg = x86OpReg(o0);
+
+    // Alternate Form - EAX, RAX.
+    if (rmReg == 0) {
+      if (Arch == kArchX64 && size == 8)
+        *cursor++ = static_cast<uint8_t>(kX86ByteRex | 0x08);
+      *cursor++ = 0xA9;
+    }
+    else {
+      cursor = emitR(cursor, 0xF7, 0, rmReg, size);
+    }
+
+    return emitImm(cursor, imVal, 4);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Table]
+  // --------------------------------------------------------------------------
+
+  static const X86FastEmitFunc table[kX86FastRowCount][kX86FastSigCount];
+};
 
+template<int Arch>
+const X86FastEmitFunc X86FastEmit<Arch>::table[kX86FastRowCount][kX86FastSigCount] = {
+  // -------+----------+----------+----------+----------+----------+
+  // Row    | R        | RR       | RI       | RM       | MR       |
+  // -------+----------+----------+----------+----------+----------+
+  /* None */{ nullptr  , nullptr  , nullptr  , nullptr  , nullptr   },
+  /* Arith*/{ nullptr  , &arithRR , &arithRI , &arithRM , &arithMR  },
+  /* Lea  */{ nullptr  , nullptr  , nullptr  , &leaRM   , nullptr   },
+  /* Mov  */{ nullptr  , &movRR   , &movRI   , &movRM   , &movMR    },
+  /* Push */{ &pushPopR, nullptr  , nullptr  , nullptr  , nullptr   },
+  /* Pop  */{ &pushPopR, nullptr  , nullptr  , nullptr  , nullptr   },
+  /* Test */{ nullptr  , &testRR  , &testRI  , nullptr  , nullptr   }
+};
+
+//! \internal
+//!
+//! Encode a single instruction at the current cursor.
+//!
+//! The caller must make sure that there is at least `kX86InstMaxSize` bytes
+//! available in the code-buffer, see `X86Assembler_emit()` and
+//! `X86Assembler_emitBatch()`.
+template<int Arch>
+static Error X86Assembler_encode(X86Assembler* self, uint32_t code, uint32_t options, const Operand* o0, const Operand* o1, const Operand* o2, const Operand* o3) {
   // Invalid instruction.
   if (code >= _kX86InstIdCount) {
     self->_comment = nullptr;
     return self->setLastError(kErrorUnknownInst);
   }
 
+  uint8_t* cursor = self->getCursor();
+  ASMJIT_ASSERT(self->getRemainingSpace() >= kX86InstMaxSize);
+
   // --------------------------------------------------------------------------
-  // [Grow]
+  // [Fast-Path]
   // --------------------------------------------------------------------------
 
-  // Grow request happens rarely.
-  uint8_t* cursor = self->getCursor();
-  if (ASMJIT_UNLIKELY((size_t)(self->_end - cursor) < 16)) {
-    ASMJIT_PROPAGATE_ERROR(self->_grow(16));
-    cursor = self->getCursor();
+  // Common GP forms are dispatched by (encoding, operand signature) to one of
+  // `X86FastEmit<Arch>` encoders, which skip the generic operand decoding. The
+  // fast path is not used if there are instruction options or a logger, except
+  // `BinaryLogger` that doesn't need sizes of the displacement and immediate.
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  bool fastPath = self->_logger == nullptr ||
+    (self->_logger->getOptions() & (Logger::kOptionDeferred | Logger::kOptionBinaryForm)) == Logger::kOptionDeferred;
+#else
+  bool fastPath = true;
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  if (options == 0 && fastPath && o2->isNone()) {
+    uint32_t sig = x86FastSigTable[o0->getOp() + (o1->getOp() << 3)];
+
+    if (sig != kX86FastSigNone) {
+      const X86InstInfo& fastInfo = _x86InstInfo[code];
+      X86FastEmitFunc fastFunc = X86FastEmit<Arch>::table[x86FastRowTable[fastInfo.getEncoding()]][sig];
+
+      if (fastFunc != nullptr) {
+        uint8_t* fastCursor = fastFunc(cursor, fastInfo, o0, o1);
+        if (fastCursor != nullptr) {
+#if !defined(ASMJIT_DISABLE_LOGGER)
+          if (self->_logger != nullptr)
+            X86Assembler_recordInstruction(self, Arch, code, 0, o0, o1, o2, o3, fastCursor, 0, 0);
+#endif // !ASMJIT_DISABLE_LOGGER
+          self->_comment = nullptr;
+          self->setCursor(fastCursor);
+          return kErrorOk;
+        }
+      }
+    }
   }
 
   // --------------------------------------------------------------------------
@@ -965,14 +2480,27 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
   uint32_t mIndex;
 
   // Label.
-  LabelData* label;
+  uint32_t labelId;
   // Displacement offset
   int32_t dispOffset;
   // Displacement size.
   uint32_t dispSize = 0;
+  // Displacement scale of 8-bit displacement (EVEX `disp8*N` compression).
+  uint32_t dispShift = 0;
   // Displacement relocation id.
   intptr_t relocId;
 
+  // Relaxation item, see `X86RelaxItem`.
+  uint32_t relaxType = kInvalidValue;
+  uint32_t relaxSize = 0;
+  uint32_t relaxOpCode = 0;
+  uint32_t relaxId = 0;
+  intptr_t relaxOffset = 0;
+  intptr_t relaxDisp = 0;
+
+  // RIP relative displacement that is not label-relative.
+  bool ripRelative = false;
+
   bool assertIllegal = false;
 
   const X86InstInfo& info = _x86InstInfo[code];
@@ -1125,6 +2653,10 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
       break;
 
     case kX86InstEncodingX86Arith:
+      // APX - New data destination (NDD) and no flags (NF) forms.
+      if (!o2->isNone() || (options & kX86InstOptionNf) != 0)
+        goto _GroupArith_Apx;
+
       if (encoded == ENC_OPS(Reg, Reg, None)) {
         opCode += (o0->getSize() != 1) + 2;
         ADD_66H_P_BY_SIZE(o0->getSize());
@@ -1196,6 +2728,63 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
       }
       break;
 
+_GroupArith_Apx:
+      // CMP has neither NDD nor NF form.
+      if (Arch == kArchX86 || opReg == 7 || o2->isRegType(kX86RegTypeGpbHi))
+        goto _IllegalInst;
+
+      {
+        // NDD form uses `o0` as a destination (VVVV), `s0` and `s1` are sources
+        // encoded the same way as a two operand form.
+        const Operand* s0 = o0;
+        const Operand* s1 = o1;
+        uint32_t nddReg = 0;
+
+        if (!o2->isNone()) {
+          if (!o0->isReg())
+            goto _IllegalInst;
+
+          nddReg = x86OpReg(o0);
+          s0 = o1;
+          s1 = o2;
+        }
+
+        uint32_t size = o0->isReg() || !o1->isReg() ? o0->getSize() : o1->getSize();
+        if (size == 0)
+          goto _IllegalInst;
+
+        if (s1->isImm()) {
+          imVal = static_cast<const Imm*>(s1)->getInt64();
+          imLen = Utils::isInt8(imVal) ? static_cast<uint32_t>(1) : Utils::iMin<uint32_t>(size, 4);
+
+          opCode = 0x80 + (size != 1 ? (imLen != 1 ? 1 : 3) : 0);
+          opReg = x86RegAndVvvv(opReg, nddReg);
+        }
+        else {
+          if (!s0->isReg() && !s1->isReg())
+            goto _IllegalInst;
+
+          // Use `r, r/m` form if the first source is a register, `r/m, r` otherwise.
+          opCode += (size != 1) + (s0->isReg() ? 2 : 0);
+          opReg = x86RegAndVvvv(x86OpReg(s0->isReg() ? s0 : s1), nddReg);
+          s0 = s0->isReg() ? s1 : s0;
+        }
+
+        ADD_66H_P_BY_SIZE(size);
+        ADD_REX_W_BY_SIZE(size);
+
+        if (s0->isReg()) {
+          rmReg = x86OpReg(s0);
+          goto _EmitApxR;
+        }
+
+        if (s0->isMem()) {
+          rmMem = x86OpMem(s0);
+          goto _EmitApxM;
+        }
+      }
+      break;
+
     case kX86InstEncodingX86BSwap:
       if (encoded == ENC_OPS(Reg, None, None)) {
         if (o0->getSize() < 4)
@@ -1270,11 +2859,17 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
       }
 
       if (encoded == ENC_OPS(Label, None, None)) {
-        label = self->getLabelData(static_cast<const Label*>(o0)->getId());
-        if (label->offset != -1) {
+        relaxId = static_cast<const Label*>(o0)->getId();
+        relaxType = kX86RelaxDisp;
+        relaxOffset = (intptr_t)(cursor - self->_buffer) + 1;
+        relaxSize = 4;
+        relaxDisp = -4;
+
+        labelId = relaxId;
+        if (self->_isLabelLocal(labelId)) {
           // Bound label.
           static const intptr_t kRel32Size = 5;
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer);
+          intptr_t offs = self->getLabelOffset(labelId) - (intptr_t)(cursor - self->_buffer);
 
           ASMJIT_ASSERT(offs <= 0);
           EMIT_BYTE(opCode);
@@ -1442,7 +3037,8 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
 
     case kX86InstEncodingX86Jcc:
       if (encoded == ENC_OPS(Label, None, None)) {
-        label = self->getLabelData(static_cast<const Label*>(o0)->getId());
+        relaxId = static_cast<const Label*>(o0)->getId();
+        labelId = relaxId;
 
         if (self->hasAsmOption(Assembler::kOptionPredictedJumps)) {
           if (options & kInstOptionTaken)
@@ -1451,12 +3047,16 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
             EMIT_BYTE(0x2E);
         }
 
-        if (label->offset != -1) {
+        relaxType = kX86RelaxJcc;
+        relaxOpCode = opCode;
+        relaxOffset = (intptr_t)(cursor - self->_buffer);
+
+        if (self->_isLabelLocal(labelId)) {
           // Bound label.
           static const intptr_t kRel8Size = 2;
           static const intptr_t kRel32Size = 6;
 
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer);
+          intptr_t offs = self->getLabelOffset(labelId) - (intptr_t)(cursor - self->_buffer);
           ASMJIT_ASSERT(offs <= 0);
 
           if ((options & kInstOptionLongForm) == 0 && Utils::isInt8(offs - kRel8Size)) {
@@ -1507,11 +3107,18 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
         }
 
         EMIT_BYTE(0xE3);
-        label = self->getLabelData(static_cast<const Label*>(o1)->getId());
 
-        if (label->offset != -1) {
+        relaxId = static_cast<const Label*>(o1)->getId();
+        relaxType = kX86RelaxDisp;
+        relaxOffset = (intptr_t)(cursor - self->_buffer);
+        relaxSize = 1;
+        relaxDisp = -1;
+
+        labelId = relaxId;
+
+        if (self->_isLabelLocal(labelId)) {
           // Bound label.
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer) - 1;
+          intptr_t offs = self->getLabelOffset(labelId) - (intptr_t)(cursor - self->_buffer) - 1;
           if (!Utils::isInt8(offs))
             goto _IllegalInst;
 
@@ -1548,13 +3155,18 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
       }
 
       if (encoded == ENC_OPS(Label, None, None)) {
-        label = self->getLabelData(static_cast<const Label*>(o0)->getId());
-        if (label->offset != -1) {
+        relaxId = static_cast<const Label*>(o0)->getId();
+        relaxType = kX86RelaxJmp;
+        relaxOpCode = 0xEB;
+        relaxOffset = (intptr_t)(cursor - self->_buffer);
+
+        labelId = relaxId;
+        if (self->_isLabelLocal(labelId)) {
           // Bound label.
           const intptr_t kRel8Size = 2;
           const intptr_t kRel32Size = 5;
 
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer);
+          intptr_t offs = self->getLabelOffset(labelId) - (intptr_t)(cursor - self->_buffer);
 
           if ((options & kInstOptionLongForm) == 0 && Utils::isInt8(offs - kRel8Size)) {
             options |= kInstOptionShortForm;
@@ -3558,9 +5170,13 @@ _EmitX86OpWithOpReg:
   if (Arch == kArchX64) {
     uint32_t rex = x86RexFromOpCodeAndOptions(opCode, options);
 
-    rex += (opReg >> 3); // Rex.B (0x01).
+    rex += (opReg & 0x08) >> 3; // Rex.B (0x01).
 
-    if (rex & ~static_cast<uint32_t>(_kX86InstOptionNoRex)) {
+    if ((opReg & 0x10) != 0 || (options & kX86InstOptionRex2) != 0) {
+      EMIT_REX2(rex, opReg & 0x10);
+      opReg &= 0x07;
+    }
+    else if (rex & ~static_cast<uint32_t>(_kX86InstOptionNoRex)) {
       rex |= kX86ByteRex;
       opReg &= 0x07;
       EMIT_BYTE(rex);
@@ -3589,9 +5205,14 @@ _EmitX86R:
     uint32_t rex = x86RexFromOpCodeAndOptions(opCode, options);
 
     rex += static_cast<uint32_t>(opReg & 0x08) >> 1; // Rex.R (0x04).
-    rex += static_cast<uint32_t>(rmReg) >> 3;        // Rex.B (0x01).
+    rex += static_cast<uint32_t>(rmReg & 0x08) >> 3; // Rex.B (0x01).
 
-    if (rex & ~static_cast<uint32_t>(_kX86InstOptionNoRex)) {
+    if (((opReg | static_cast<uint32_t>(rmReg)) & 0x10) != 0 || (options & kX86InstOptionRex2) != 0) {
+      EMIT_REX2(rex, ((opReg & 0x10) << 2) | (static_cast<uint32_t>(rmReg) & 0x10));
+      opReg &= 0x07;
+      rmReg &= 0x07;
+    }
+    else if (rex & ~static_cast<uint32_t>(_kX86InstOptionNoRex)) {
       rex |= kX86ByteRex;
       opReg &= 0x07;
       rmReg &= 0x07;
@@ -3645,11 +5266,23 @@ _EmitX86M:
   if (Arch == kArchX64) {
     uint32_t rex = x86RexFromOpCodeAndOptions(opCode, options);
 
+    uint32_t mBaseBits = rmMem->isBaseIndexType() ? x86MemRegBits(mBase) : 0;
+    uint32_t mIndexBits = x86MemRegBits(mIndex);
+
     rex += static_cast<uint32_t>(opReg      & 8) >> 1; // Rex.R (0x04).
     rex += static_cast<uint32_t>(mIndex - 8 < 8) << 1; // Rex.X (0x02).
     rex += static_cast<uint32_t>(mBase  - 8 < 8);      // Rex.B (0x01).
 
-    if (rex & ~static_cast<uint32_t>(_kX86InstOptionNoRex)) {
+    if (((opReg | mBaseBits | mIndexBits) & 0x10) != 0 || (options & kX86InstOptionRex2) != 0) {
+      // Base and index R24..R31 have bit 3 set as well.
+      rex &= ~static_cast<uint32_t>(0x03);
+      rex += mIndexBits & 0x08 ? 0x02 : 0x00;
+      rex += mBaseBits  & 0x08 ? 0x01 : 0x00;
+
+      EMIT_REX2(rex, ((opReg & 0x10) << 2) | ((mIndexBits & 0x10) << 1) | (mBaseBits & 0x10));
+      opReg &= 0x07;
+    }
+    else if (rex & ~static_cast<uint32_t>(_kX86InstOptionNoRex)) {
       rex |= kX86ByteRex;
       opReg &= 0x07;
       EMIT_BYTE(rex);
@@ -3680,11 +5313,11 @@ _EmitSib:
           EMIT_BYTE(x86EncodeMod(0, opReg, 4));
           EMIT_BYTE(x86EncodeSib(0, 4, 4));
         }
-        else if (Utils::isInt8(dispOffset)) {
+        else if (x86IsDisp8(dispOffset, dispShift)) {
           // [Esp/Rsp/R12 + Disp8].
           EMIT_BYTE(x86EncodeMod(1, opReg, 4));
           EMIT_BYTE(x86EncodeSib(0, 4, 4));
-          EMIT_BYTE(static_cast<int8_t>(dispOffset));
+          EMIT_BYTE(static_cast<int8_t>(dispOffset >> dispShift));
         }
         else {
           // [Esp/Rsp/R12 + Disp32].
@@ -3697,10 +5330,10 @@ _EmitSib:
         // [Base].
         EMIT_BYTE(x86EncodeMod(0, opReg, mBase));
       }
-      else if (Utils::isInt8(dispOffset)) {
+      else if (x86IsDisp8(dispOffset, dispShift)) {
         // [Base + Disp8].
         EMIT_BYTE(x86EncodeMod(1, opReg, mBase));
-        EMIT_BYTE(static_cast<int8_t>(dispOffset));
+        EMIT_BYTE(static_cast<int8_t>(dispOffset >> dispShift));
       }
       else {
         // [Base + Disp32].
@@ -3720,11 +5353,11 @@ _EmitSib:
         EMIT_BYTE(x86EncodeMod(0, opReg, 4));
         EMIT_BYTE(x86EncodeSib(shift, mIndex, mBase));
       }
-      else if (Utils::isInt8(dispOffset)) {
+      else if (x86IsDisp8(dispOffset, dispShift)) {
         // [Base + Index * Scale + Disp8].
         EMIT_BYTE(x86EncodeMod(1, opReg, 4));
         EMIT_BYTE(x86EncodeSib(shift, mIndex, mBase));
-        EMIT_BYTE(static_cast<int8_t>(dispOffset));
+        EMIT_BYTE(static_cast<int8_t>(dispOffset >> dispShift));
       }
       else {
         // [Base + Index * Scale + Disp32].
@@ -3754,21 +5387,25 @@ _EmitSib:
     }
     else if (rmMem->getMemType() == kMemTypeLabel) {
       // Relative->Absolute [x86 mode].
-      label = self->getLabelData(rmMem->_vmem.base);
+      labelId = rmMem->_vmem.base;
       relocId = self->_relocations.getLength();
 
       RelocData rd;
       rd.type = kRelocRelToAbs;
       rd.size = 4;
-      rd.from = static_cast<Ptr>((uintptr_t)(cursor - self->_buffer));
+      rd.reserved = 0;
+      rd.fromSection = self->_sectionId;
+      rd.dataSection = self->getLabelSectionId(labelId);
+      rd.from = static_cast<uint32_t>((uintptr_t)(cursor - self->_buffer));
       rd.data = static_cast<SignedPtr>(dispOffset);
 
-      if (self->_relocations.append(rd) != kErrorOk)
-        return self->setLastError(kErrorNoHeapMemory);
+      Error error = self->_append(self->_relocations, rd);
+      if (error != kErrorOk)
+        return self->setLastError(error);
 
-      if (label->offset != -1) {
+      if (self->getLabelOffset(labelId) != -1) {
         // Bound label.
-        self->_relocations[relocId].data += static_cast<SignedPtr>(label->offset);
+        self->_relocations[relocId].data += static_cast<SignedPtr>(self->getLabelOffset(labelId));
         EMIT_DWORD(0);
       }
       else {
@@ -3785,11 +5422,15 @@ _EmitSib:
       RelocData rd;
       rd.type = kRelocRelToAbs;
       rd.size = 4;
-      rd.from = static_cast<Ptr>((uintptr_t)(cursor - self->_buffer));
+      rd.reserved = 0;
+      rd.fromSection = self->_sectionId;
+      rd.dataSection = self->_sectionId;
+      rd.from = static_cast<uint32_t>((uintptr_t)(cursor - self->_buffer));
       rd.data = rd.from + static_cast<SignedPtr>(dispOffset);
 
-      if (self->_relocations.append(rd) != kErrorOk)
-        return self->setLastError(kErrorNoHeapMemory);
+      Error error = self->_append(self->_relocations, rd);
+      if (error != kErrorOk)
+        return self->setLastError(error);
 
       EMIT_DWORD(0);
     }
@@ -3813,7 +5454,7 @@ _EmitSib:
     }
     else if (rmMem->getMemType() == kMemTypeLabel) {
       // [RIP + Disp32].
-      label = self->getLabelData(rmMem->_vmem.base);
+      labelId = rmMem->_vmem.base;
 
       // Indexing is invalid.
       if (mIndex < kInvalidReg)
@@ -3822,9 +5463,15 @@ _EmitSib:
       EMIT_BYTE(x86EncodeMod(0, opReg, 5));
       dispOffset -= (4 + imLen);
 
-      if (label->offset != -1) {
+      relaxId = rmMem->_vmem.base;
+      relaxType = kX86RelaxDisp;
+      relaxOffset = (intptr_t)(cursor - self->_buffer);
+      relaxSize = 4;
+      relaxDisp = dispOffset;
+
+      if (self->_isLabelLocal(labelId)) {
         // Bound label.
-        dispOffset += label->offset - static_cast<int32_t>((intptr_t)(cursor - self->_buffer));
+        dispOffset += self->getLabelOffset(labelId) - static_cast<int32_t>((intptr_t)(cursor - self->_buffer));
         EMIT_DWORD(static_cast<int32_t>(dispOffset));
       }
       else {
@@ -3843,6 +5490,7 @@ _EmitSib:
 
       EMIT_BYTE(x86EncodeMod(0, opReg, 5));
       EMIT_DWORD(static_cast<int32_t>(dispOffset));
+      ripRelative = true;
     }
   }
 
@@ -3955,6 +5603,13 @@ _EmitAvxOp:
   goto _EmitDone;
 
 _EmitAvxR:
+  if (extendedInfo.hasFlag(kX86InstFlagEvex) ||
+      x86NeedsEvex(options, opReg | static_cast<uint32_t>(rmReg), o0, o1, o2, o3)) {
+    if (!extendedInfo.isAvx512())
+      goto _IllegalInst;
+    goto _EmitEvexR;
+  }
+
   {
     uint32_t vex_XvvvvLpp;
     uint32_t vex_rxbmmmmm;
@@ -3998,10 +5653,20 @@ _EmitAvxR:
   goto _EmitDone;
 
 _EmitAvxM:
+  if (extendedInfo.hasFlag(kX86InstFlagEvex) || x86MemHasApxReg(rmMem) ||
+      x86NeedsEvex(options, opReg, o0, o1, o2, o3)) {
+    if (!extendedInfo.isAvx512())
+      goto _IllegalInst;
+    goto _EmitEvexM;
+  }
+
   EMIT_AVX_M
   goto _EmitSib;
 
 _EmitAvxV:
+  if (x86NeedsEvex(options, opReg, o0, o1, o2, o3) || x86MemHasApxReg(rmMem))
+    goto _IllegalInst;
+
   EMIT_AVX_M
 
   if (mIndex >= kInvalidReg)
@@ -4044,23 +5709,27 @@ _EmitAvxV:
         goto _IllegalAddr;
 
       // Relative->Absolute [x86 mode].
-      label = self->getLabelData(rmMem->_vmem.base);
+      labelId = rmMem->_vmem.base;
       relocId = self->_relocations.getLength();
 
       {
         RelocData rd;
         rd.type = kRelocRelToAbs;
         rd.size = 4;
-        rd.from = static_cast<Ptr>((uintptr_t)(cursor - self->_buffer));
+        rd.reserved = 0;
+        rd.fromSection = self->_sectionId;
+        rd.dataSection = self->getLabelSectionId(labelId);
+        rd.from = static_cast<uint32_t>((uintptr_t)(cursor - self->_buffer));
         rd.data = static_cast<SignedPtr>(dispOffset);
 
-        if (self->_relocations.append(rd) != kErrorOk)
-          return self->setLastError(kErrorNoHeapMemory);
+        Error error = self->_append(self->_relocations, rd);
+        if (error != kErrorOk)
+          return self->setLastError(error);
       }
 
-      if (label->offset != -1) {
+      if (self->getLabelOffset(labelId) != -1) {
         // Bound label.
-        self->_relocations[relocId].data += static_cast<SignedPtr>(label->offset);
+        self->_relocations[relocId].data += static_cast<SignedPtr>(self->getLabelOffset(labelId));
         EMIT_DWORD(0);
       }
       else {
@@ -4078,34 +5747,304 @@ _EmitAvxV:
   goto _EmitDone;
 
   // --------------------------------------------------------------------------
-  // [Xop]
+  // [Emit - Evex]
   // --------------------------------------------------------------------------
 
-#define EMIT_XOP_M \
-  ASMJIT_ASSERT(rmMem != nullptr); \
-  ASMJIT_ASSERT(rmMem->getOp() == Operand::kTypeMem); \
+  // Shared by register and memory forms. Validates masking options and creates
+  // `P1` (`[W  v  v  v  v  1  p  p]`) and the `z`, `V'`, and `aaa` fields of
+  // `P2` (`[z  L' L  b  V' a  a  a]`). Vector length is `L'L` (zero, one, or
+  // two), provided by `_OptL` encodings for YMM and promoted here for ZMM.
+#define EVEX_PREPARE() \
+  if ((options & kX86InstOptionEvexK_Mask) != 0 && !extendedInfo.hasFlag(kX86InstFlagAvx512KMask)) \
+    goto _IllegalInst; \
   \
-  if (rmMem->hasSegment()) { \
-    EMIT_BYTE(x86SegmentPrefix[rmMem->getSegment()]); \
-  } \
+  if ((options & kX86InstOptionEvexZero) != 0 && \
+      ((options & kX86InstOptionEvexK_Mask) == 0 || !extendedInfo.hasFlag(kX86InstFlagAvx512KZero))) \
+    goto _IllegalInst; \
   \
-  mBase = rmMem->getBase(); \
-  mIndex = rmMem->getIndex(); \
+  if ((options & kX86InstOptionEvexSae) != 0 && !extendedInfo.hasFlag(kX86InstFlagAvx512Sae)) \
+    goto _IllegalInst; \
   \
-  { \
-    uint32_t vex_XvvvvLpp; \
-    uint32_t vex_rxbmmmmm; \
-    \
-    vex_XvvvvLpp  = (opCode >> (kX86InstOpCode_W_Shift - 7)) & 0x80; \
-    vex_XvvvvLpp += (opCode >> (kX86InstOpCode_L_Shift - 2)) & 0x04; \
-    vex_XvvvvLpp += (opCode >> (kX86InstOpCode_PP_Shift   )) & 0x03; \
-    vex_XvvvvLpp += (opReg  >> (kVexVVVVShift          - 3)); \
-    \
-    vex_rxbmmmmm  = (opCode >> kX86InstOpCode_MM_Shift) & 0x0F; \
-    vex_rxbmmmmm += static_cast<uint32_t>(mBase  - 8 < 8) << 5; \
-    vex_rxbmmmmm += static_cast<uint32_t>(mIndex - 8 < 8) << 6; \
-    \
-    vex_rxbmmmmm |= static_cast<uint32_t>(opReg << 4) & 0x80; \
+  if ((options & kX86EvexRounding) != 0 && !extendedInfo.hasFlag(kX86InstFlagAvx512Rnd)) \
+    goto _IllegalInst; \
+  \
+  evex_LL = (opCode >> kX86InstOpCode_L_Shift) & 0x03; \
+  if (x86IsZmm(o0) | x86IsZmm(o1) | x86IsZmm(o2)) \
+    evex_LL = 2; \
+  \
+  evex_W  = ((opCode >> kX86InstOpCode_W_Shift) | (opCode >> kX86InstOpCode_EW_Shift)) & 0x01; \
+  \
+  evex_P1  = evex_W << 7; \
+  evex_P1 |= ((opReg >> kVexVVVVShift) & 0x0F) << 3; \
+  evex_P1 |= (opCode >> kX86InstOpCode_PP_Shift) & 0x03; \
+  evex_P1 ^= 0x7C; \
+  \
+  evex_P2  = (options & kX86InstOptionEvexZero) != 0 ? 0x80 : 0x00; \
+  evex_P2 |= (opReg >> (kVexVVVVShift + 1)) & 0x08; \
+  evex_P2 |= (options & kX86InstOptionEvexK_Mask) >> kX86InstOptionEvexK_Shift; \
+  evex_P2 ^= 0x08;
+
+_EmitEvexR:
+  {
+    uint32_t evex_P0;
+    uint32_t evex_P1;
+    uint32_t evex_P2;
+    uint32_t evex_LL;
+    uint32_t evex_W;
+
+    // Broadcast is only possible with a memory operand.
+    if ((options & kX86InstOptionEvexOneN) != 0)
+      goto _IllegalInst;
+
+    EVEX_PREPARE()
+
+    // `b` selects static rounding (`L'L` is the rounding mode) or SAE.
+    if ((options & kX86EvexRounding) != 0) {
+      evex_P2 |= 0x10;
+      evex_P2 |= ((options & (kX86InstOptionEvexRdSae | kX86InstOptionEvexRzSae)) != 0) << 5;
+      evex_P2 |= ((options & (kX86InstOptionEvexRuSae | kX86InstOptionEvexRzSae)) != 0) << 6;
+    }
+    else if ((options & kX86InstOptionEvexSae) != 0) {
+      evex_P2 |= 0x10;
+    }
+    else {
+      evex_P2 |= evex_LL << 5;
+    }
+
+    // `X` extends `rmReg` to 5 bits if the operand is a register.
+    evex_P0  = (opCode >> kX86InstOpCode_MM_Shift) & 0x03;
+    evex_P0 |= static_cast<uint32_t>(opReg & 0x08) << 4;
+    evex_P0 |= static_cast<uint32_t>(rmReg & 0x10) << 2;
+    evex_P0 |= static_cast<uint32_t>(rmReg & 0x08) << 2;
+    evex_P0 |= static_cast<uint32_t>(opReg & 0x10);
+    evex_P0 ^= 0xF0;
+
+    EMIT_BYTE(kX86ByteEvex);
+    EMIT_BYTE(evex_P0);
+    EMIT_BYTE(evex_P1);
+    EMIT_BYTE(evex_P2);
+    EMIT_BYTE(opCode);
+  }
+
+  EMIT_BYTE(x86EncodeMod(3, opReg & 0x07, static_cast<uint32_t>(rmReg) & 0x07));
+
+  if (imLen == 0)
+    goto _EmitDone;
+
+  EMIT_BYTE(imVal & 0xFF);
+  goto _EmitDone;
+
+_EmitEvexM:
+  ASMJIT_ASSERT(rmMem != nullptr);
+  ASMJIT_ASSERT(rmMem->getOp() == Operand::kTypeMem);
+
+  if (rmMem->hasSegment()) {
+    EMIT_BYTE(x86SegmentPrefix[rmMem->getSegment()]);
+  }
+
+  mBase = rmMem->getBase();
+  mIndex = rmMem->getIndex();
+
+  {
+    uint32_t evex_P0;
+    uint32_t evex_P1;
+    uint32_t evex_P2;
+    uint32_t evex_LL;
+    uint32_t evex_W;
+
+    // Static rounding and SAE are only possible with register operands.
+    if ((options & (kX86EvexRounding | kX86InstOptionEvexSae)) != 0)
+      goto _IllegalInst;
+
+    if ((options & kX86InstOptionEvexOneN) != 0 && !extendedInfo.hasFlag(kX86InstFlagAvx512BCast))
+      goto _IllegalInst;
+
+    EVEX_PREPARE()
+
+    // Down-converting instructions (`vcvtneps2bf16 ymm, m512`) have a smaller
+    // destination than the source, the vector length is given by the memory.
+    if ((options & kX86InstOptionEvexOneN) == 0) {
+      uint32_t memSize = rmMem->getSize();
+      if (memSize == 64)
+        evex_LL = 2;
+      else if (memSize == 32 && evex_LL == 0)
+        evex_LL = 1;
+    }
+
+    evex_P2 |= evex_LL << 5;
+
+    // Compressed displacement - `N` is the size of the element if the memory
+    // operand is broadcasted or scalar (Tuple1 Scalar), the size of the whole
+    // vector otherwise (Full and Full Mem).
+    if ((options & kX86InstOptionEvexOneN) != 0) {
+      evex_P2 |= 0x10;
+      dispShift = 2 + evex_W;
+    }
+    else if (extendedInfo.hasFlag(kX86InstFlagAvx512T1S)) {
+      dispShift = 2 + evex_W;
+    }
+    else {
+      dispShift = 4 + evex_LL;
+    }
+
+    // APX extends GP base and index to 5 bits by `B4` (`P0[3]`) and `X4`
+    // (inverted `P1[2]`).
+    uint32_t mBaseBits = rmMem->isBaseIndexType() ? x86MemRegBits(mBase) : 0;
+    uint32_t mIndexBits = x86MemRegBits(mIndex);
+
+    evex_P0  = (opCode >> kX86InstOpCode_MM_Shift) & 0x03;
+    evex_P0 |= static_cast<uint32_t>(opReg & 0x08) << 4;
+    evex_P0 |= (mIndexBits & 0x08) << 3;
+    evex_P0 |= (mBaseBits  & 0x08) << 2;
+    evex_P0 |= static_cast<uint32_t>(opReg & 0x10);
+    evex_P0 ^= 0xF0;
+    evex_P0 |= (mBaseBits  & 0x10) >> 1;
+    evex_P1 ^= (mIndexBits & 0x10) >> 2;
+
+    EMIT_BYTE(kX86ByteEvex);
+    EMIT_BYTE(evex_P0);
+    EMIT_BYTE(evex_P1);
+    EMIT_BYTE(evex_P2);
+    EMIT_BYTE(opCode);
+  }
+
+  mBase &= 0x07;
+  opReg &= 0x07;
+  goto _EmitSib;
+
+#undef EVEX_PREPARE
+
+  // --------------------------------------------------------------------------
+  // [Emit - Apx]
+  // --------------------------------------------------------------------------
+
+  // Legacy instructions promoted to EVEX (map 4) by APX, used by NDD and NF:
+  //   - `P0` - `[R3 X3 B3 R4 B4 1  0  0 ]` - All except `B4` inverted.
+  //   - `P1` - `[W  v  v  v  v  X4 p  p ]` - `vvvv` and `X4` inverted.
+  //   - `P2` - `[0  0  0  ND V4 NF 0  0 ]` - `V4` inverted.
+  //
+  // `ND` is set if the instruction has a new data destination (VVVV).
+#define APX_PREPARE() \
+  if ((options & _kX86InstOptionNoRex) != 0) \
+    goto _IllegalInst; \
+  \
+  apx_P1  = ((opCode >> kX86InstOpCode_W_Shift) & 0x01) << 7; \
+  apx_P1 |= ((opReg >> kVexVVVVShift) & 0x0F) << 3; \
+  apx_P1 |= (opCode >> kX86InstOpCode_PP_Shift) & 0x03; \
+  \
+  apx_P2  = static_cast<uint32_t>(!o2->isNone()) << 4; \
+  apx_P2 |= (opReg >> (kVexVVVVShift + 1)) & 0x08; \
+  apx_P2 |= (options & kX86InstOptionNf) != 0 ? 0x04 : 0x00; \
+  apx_P2 ^= 0x08;
+
+_EmitApxR:
+  {
+    uint32_t apx_P0;
+    uint32_t apx_P1;
+    uint32_t apx_P2;
+
+    APX_PREPARE()
+
+    apx_P0  = 0x04;
+    apx_P0 |= static_cast<uint32_t>(opReg & 0x08) << 4;
+    apx_P0 |= static_cast<uint32_t>(rmReg & 0x08) << 2;
+    apx_P0 |= static_cast<uint32_t>(opReg & 0x10);
+    apx_P0 ^= 0xF0;
+    apx_P0 |= static_cast<uint32_t>(rmReg & 0x10) >> 1;
+    apx_P1 ^= 0x7C;
+
+    EMIT_BYTE(kX86ByteEvex);
+    EMIT_BYTE(apx_P0);
+    EMIT_BYTE(apx_P1);
+    EMIT_BYTE(apx_P2);
+    EMIT_BYTE(opCode);
+  }
+
+  EMIT_BYTE(x86EncodeMod(3, opReg & 0x07, static_cast<uint32_t>(rmReg) & 0x07));
+
+  if (imLen != 0)
+    goto _EmitImm;
+  else
+    goto _EmitDone;
+
+_EmitApxM:
+  ASMJIT_ASSERT(rmMem != nullptr);
+  ASMJIT_ASSERT(rmMem->getOp() == Operand::kTypeMem);
+
+  mBase = rmMem->getBase();
+  mIndex = rmMem->getIndex();
+
+  // Size override prefix.
+  if (rmMem->hasBaseOrIndex() && rmMem->getMemType() != kMemTypeLabel && rmMem->hasGpdBase())
+    EMIT_BYTE(0x67);
+
+  // Segment override prefix.
+  if (rmMem->hasSegment()) {
+    EMIT_BYTE(x86SegmentPrefix[rmMem->getSegment()]);
+  }
+
+  {
+    uint32_t apx_P0;
+    uint32_t apx_P1;
+    uint32_t apx_P2;
+
+    uint32_t mBaseBits = rmMem->isBaseIndexType() ? x86MemRegBits(mBase) : 0;
+    uint32_t mIndexBits = x86MemRegBits(mIndex);
+
+    APX_PREPARE()
+
+    apx_P0  = 0x04;
+    apx_P0 |= static_cast<uint32_t>(opReg & 0x08) << 4;
+    apx_P0 |= (mIndexBits & 0x08) << 3;
+    apx_P0 |= (mBaseBits  & 0x08) << 2;
+    apx_P0 |= static_cast<uint32_t>(opReg & 0x10);
+    apx_P0 ^= 0xF0;
+    apx_P0 |= (mBaseBits  & 0x10) >> 1;
+    apx_P1 |= (mIndexBits & 0x10) >> 2;
+    apx_P1 ^= 0x7C;
+
+    EMIT_BYTE(kX86ByteEvex);
+    EMIT_BYTE(apx_P0);
+    EMIT_BYTE(apx_P1);
+    EMIT_BYTE(apx_P2);
+    EMIT_BYTE(opCode);
+  }
+
+  mBase &= 0x07;
+  opReg &= 0x07;
+  goto _EmitSib;
+
+#undef APX_PREPARE
+
+  // --------------------------------------------------------------------------
+  // [Xop]
+  // --------------------------------------------------------------------------
+
+#define EMIT_XOP_M \
+  ASMJIT_ASSERT(rmMem != nullptr); \
+  ASMJIT_ASSERT(rmMem->getOp() == Operand::kTypeMem); \
+  \
+  if (rmMem->hasSegment()) { \
+    EMIT_BYTE(x86SegmentPrefix[rmMem->getSegment()]); \
+  } \
+  \
+  mBase = rmMem->getBase(); \
+  mIndex = rmMem->getIndex(); \
+  \
+  { \
+    uint32_t vex_XvvvvLpp; \
+    uint32_t vex_rxbmmmmm; \
+    \
+    vex_XvvvvLpp  = (opCode >> (kX86InstOpCode_W_Shift - 7)) & 0x80; \
+    vex_XvvvvLpp += (opCode >> (kX86InstOpCode_L_Shift - 2)) & 0x04; \
+    vex_XvvvvLpp += (opCode >> (kX86InstOpCode_PP_Shift   )) & 0x03; \
+    vex_XvvvvLpp += (opReg  >> (kVexVVVVShift          - 3)); \
+    \
+    vex_rxbmmmmm  = (opCode >> kX86InstOpCode_MM_Shift) & 0x0F; \
+    vex_rxbmmmmm += static_cast<uint32_t>(mBase  - 8 < 8) << 5; \
+    vex_rxbmmmmm += static_cast<uint32_t>(mIndex - 8 < 8) << 6; \
+    \
+    vex_rxbmmmmm |= static_cast<uint32_t>(opReg << 4) & 0x80; \
     vex_rxbmmmmm ^= 0xE0; \
     vex_XvvvvLpp ^= 0x78; \
     \
@@ -4119,6 +6058,10 @@ _EmitAvxV:
   opReg &= 0x07;
 
 _EmitXopR:
+  // XOP can't encode R16..R31 (APX) and XMM16..XMM31 registers.
+  if (((opReg | static_cast<uint32_t>(rmReg)) & (0x10 | (0x10 << kVexVVVVShift))) != 0)
+    goto _IllegalInst;
+
   {
     uint32_t xop_XvvvvLpp;
     uint32_t xop_rxbmmmmm;
@@ -4152,6 +6095,9 @@ _EmitXopR:
   goto _EmitDone;
 
 _EmitXopM:
+  if ((opReg & (0x10 | (0x10 << kVexVVVVShift))) != 0 || x86MemHasApxReg(rmMem))
+    goto _IllegalInst;
+
   EMIT_XOP_M
   goto _EmitSib;
 
@@ -4174,18 +6120,48 @@ _EmitJmpOrCallAbs:
     RelocData rd;
     rd.type = kRelocAbsToRel;
     rd.size = 4;
-    rd.from = (intptr_t)(cursor - self->_buffer) + 1;
+    rd.reserved = 0;
+    rd.fromSection = self->_sectionId;
+    rd.dataSection = self->_sectionId;
+    rd.from = static_cast<uint32_t>((uintptr_t)(cursor - self->_buffer)) + 1;
     rd.data = static_cast<SignedPtr>(imVal);
 
     uint32_t trampolineSize = 0;
 
+    if (Arch == kArchX64 && self->hasAsmOption(Assembler::kOptionPositionIndependent)) {
+      // Position independent code reads the address from the GOT, patch to
+      // FF/2 (call) or FF/4 (jmp) that uses [RIP + Disp32].
+      rd.type = kRelocAbsToGot;
+      rd.from++;
+
+      EMIT_BYTE(0xFF);
+      EMIT_BYTE(x86EncodeMod(0, (opCode & 0xFF) == 0xE8 ? 2 : 4, 5));
+      EMIT_DWORD(0);
+
+      // Reserve a GOT entry if the address is not in the GOT of the section.
+      Error error = X86Assembler_reserveEntry(self, static_cast<uint64_t>(rd.data), trampolineSize);
+      if (error != kErrorOk)
+        return self->setLastError(error);
+
+      error = self->_append(self->_relocations, rd);
+      if (error != kErrorOk)
+        return self->setLastError(error);
+
+      self->_trampolinesSize += trampolineSize;
+      if (self->_sections.getLength() != 0)
+        self->_sections[self->_sectionId]->trampolinesSize += trampolineSize;
+      goto _EmitDone;
+    }
+
     if (Arch == kArchX64) {
       Ptr baseAddress = self->getRuntime()->getBaseAddress();
 
       // If the base address of the output is known, it's possible to determine
       // the need for a trampoline here. This saves possible REX prefix in
       // 64-bit mode and prevents reserving space needed for an absolute address.
-      if (baseAddress == kNoBaseAddress || !x64IsRelative(rd.data, baseAddress + rd.from + 4)) {
+      // The address of the section is only known if it's the default one.
+      if (baseAddress == kNoBaseAddress || self->_sectionId != Assembler::kSectionDefault ||
+          !x64IsRelative(rd.data, baseAddress + rd.from + 4)) {
         // Emit REX prefix so the instruction can be patched later on. The REX
         // prefix does nothing if not patched after, but allows to patch the
         // instruction in case where the trampoline is needed.
@@ -4193,7 +6169,11 @@ _EmitJmpOrCallAbs:
         rd.from++;
 
         EMIT_BYTE(kX86ByteRex);
-        trampolineSize = 8;
+
+        // Trampolines are shared by all relocations of the same target.
+        Error error = X86Assembler_reserveEntry(self, static_cast<uint64_t>(rd.data), trampolineSize);
+        if (error != kErrorOk)
+          return self->setLastError(error);
       }
     }
 
@@ -4202,11 +6182,14 @@ _EmitJmpOrCallAbs:
     EMIT_BYTE(opCode);
     EMIT_DWORD(0);
 
-    if (self->_relocations.append(rd) != kErrorOk)
-      return self->setLastError(kErrorNoHeapMemory);
+    Error error = self->_append(self->_relocations, rd);
+    if (error != kErrorOk)
+      return self->setLastError(error);
 
     // Reserve space for a possible trampoline.
     self->_trampolinesSize += trampolineSize;
+    if (self->_sections.getLength() != 0)
+      self->_sections[self->_sectionId]->trampolinesSize += trampolineSize;
   }
   goto _EmitDone;
 
@@ -4216,16 +6199,17 @@ _EmitJmpOrCallAbs:
 
 _EmitDisplacement:
   {
-    ASMJIT_ASSERT(label->offset == -1);
+    ASMJIT_ASSERT(!self->_isLabelLocal(labelId));
     ASMJIT_ASSERT(dispSize == 1 || dispSize == 4);
 
     // Chain with label.
-    LabelLink* link = self->_newLabelLink();
-    link->prev = label->links;
+    LabelLink* link = self->_linkLabel(labelId);
+    if (link == nullptr)
+      return self->setLastError(self->isFixedBuffer() ? kErrorCodeTooLarge : kErrorNoHeapMemory);
+
     link->offset = (intptr_t)(cursor - self->_buffer);
     link->displacement = dispOffset;
     link->relocId = relocId;
-    label->links = link;
 
     // Emit label size as dummy data.
     if (dispSize == 1)
@@ -4242,8 +6226,38 @@ _EmitDisplacement:
   // --------------------------------------------------------------------------
 
 _EmitDone:
+  if (ASMJIT_UNLIKELY(self->_refSites != nullptr) && (relaxType != kInvalidValue || ripRelative)) {
+    X86RefSite site;
+    site.labelId = ripRelative ? static_cast<uint32_t>(kInvalidValue) : relaxId;
+    site.sectionId = self->_sectionId;
+    site.end = (intptr_t)(cursor - self->_buffer);
+
+    Error error = self->_refSites->append(site);
+    if (error != kErrorOk)
+      return self->setLastError(error);
+  }
+
+  if (relaxType != kInvalidValue && self->hasAsmOption(Assembler::kOptionRelaxBranches)) {
+    if (relaxType != kX86RelaxDisp) {
+      relaxSize = static_cast<uint32_t>((intptr_t)(cursor - self->_buffer) - relaxOffset);
+
+      // Keep the form requested explicitly, only its displacement is patched.
+      if (options & kInstOptionLongForm) {
+        relaxType = kX86RelaxDisp;
+        relaxOffset += relaxSize - 4;
+        relaxSize = 4;
+        relaxDisp = -4;
+      }
+    }
+
+    ASMJIT_PROPAGATE_ERROR(self->_addRelaxItem(relaxType, relaxSize, relaxOpCode, relaxId, relaxOffset, relaxDisp));
+  }
+
 #if !defined(ASMJIT_DISABLE_LOGGER)
-  if (self->_logger || assertIllegal) {
+  if (self->_logger && !assertIllegal && self->_logger->hasOption(Logger::kOptionDeferred)) {
+    X86Assembler_recordInstruction(self, Arch, code, options, o0, o1, o2, o3, cursor, dispSize, imLen);
+  }
+  else if (self->_logger || assertIllegal) {
     StringBuilderTmp<512> sb;
     uint32_t loggerOptions = 0;
 
@@ -4280,20 +6294,1750 @@ _EmitDone:
   return kErrorOk;
 }
 
-Error X86Assembler::_emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3) {
-#if defined(ASMJIT_BUILD_X86) && !defined(ASMJIT_BUILD_X64)
-  ASMJIT_ASSERT(_arch == kArchX86);
-  return X86Assembler_emit<kArchX86>(this, code, &o0, &o1, &o2, &o3);
-#elif !defined(ASMJIT_BUILD_X86) && defined(ASMJIT_BUILD_X64)
-  ASMJIT_ASSERT(_arch == kArchX64);
-  return X86Assembler_emit<kArchX64>(this, code, &o0, &o1, &o2, &o3);
-#else
-  if (_arch == kArchX86)
-    return X86Assembler_emit<kArchX86>(this, code, &o0, &o1, &o2, &o3);
-  else
-    return X86Assembler_emit<kArchX64>(this, code, &o0, &o1, &o2, &o3);
-#endif
+// ============================================================================
+// [asmjit::X86Assembler - Emit - Interface]
+// ============================================================================
+
+//! \internal
+//!
+//! Class of an instruction, see `Assembler::kOptionAlignBranches`.
+ASMJIT_ENUM(X86BranchClass) {
+  //! Not a branch.
+  kX86BranchNone = 0,
+  //! Unconditional jump, call or return.
+  kX86BranchJump = 1,
+  //! Conditional jump, which can be macro-fused with the previous instruction.
+  kX86BranchJcc = 2,
+  //! Instruction that can be macro-fused with a following jcc.
+  kX86BranchFusible = 3
+};
+
+static ASMJIT_INLINE uint32_t X86Assembler_getBranchClass(uint32_t code) noexcept {
+  switch (_x86InstInfo[code].getEncoding()) {
+    case kX86InstEncodingX86Call:
+    case kX86InstEncodingX86Jecxz:
+    case kX86InstEncodingX86Jmp:
+    case kX86InstEncodingX86Ret:
+      return kX86BranchJump;
+
+    case kX86InstEncodingX86Jcc:
+      return kX86BranchJcc;
+
+    case kX86InstEncodingX86Arith:
+      if (code == kX86InstIdAdd || code == kX86InstIdAnd || code == kX86InstIdCmp || code == kX86InstIdSub)
+        return kX86BranchFusible;
+      return kX86BranchNone;
+
+    case kX86InstEncodingX86IncDec:
+    case kX86InstEncodingX86Test:
+      return kX86BranchFusible;
+
+    default:
+      return kX86BranchNone;
+  }
+}
+
+//! \internal
+//!
+//! Get whether the encoding of an instruction using `op` stays the same if
+//! the instruction is moved (the operand is not relative to the instruction).
+static ASMJIT_INLINE bool X86Assembler_isMovableOp(const Operand* op) noexcept {
+  if (op->isLabel())
+    return false;
+
+  if (op->isMem()) {
+    uint32_t memType = static_cast<const X86Mem*>(op)->getMemType();
+    return memType == kMemTypeBaseIndex || memType == kMemTypeStackIndex;
+  }
+
+  return true;
+}
+
+//! \internal
+//!
+//! Encode a single instruction if `kOptionAlignBranches` is enabled.
+//!
+//! A branch is encoded first, and if it crosses or ends on a 32-byte boundary
+//! everything the encoder did is undone and the branch is encoded again after
+//! the padding. The same happens if the branch has to be logged (so it's not
+//! logged twice) or relaxed (the padding has to precede the branch in the list
+//! of relax items).
+template<int Arch>
+static Error X86Assembler_emitPadded(X86Assembler* self, uint32_t code, uint32_t options, const Operand* o0, const Operand* o1, const Operand* o2, const Operand* o3) {
+  uint32_t branchClass = code < _kX86InstIdCount ? X86Assembler_getBranchClass(code) : static_cast<uint32_t>(kX86BranchNone);
+
+  // Offset of the instruction to be macro-fused with jcc, if it directly
+  // precedes it.
+  intptr_t fusedOffset = -1;
+  if (branchClass == kX86BranchJcc &&
+      self->_fusibleOffset != -1 &&
+      self->_fusibleSectionId == self->_sectionId &&
+      self->_fusibleOffset + static_cast<intptr_t>(self->_fusibleSize) == static_cast<intptr_t>(self->getOffset())) {
+    fusedOffset = self->_fusibleOffset;
+  }
+  self->_fusibleOffset = -1;
+
+  // The fused instruction was emitted with enough space for itself, the
+  // padding, and the jcc, so the code-buffer doesn't grow between them. If it
+  // grows anyway the fused instruction can be in another chunk.
+  size_t space = fusedOffset != -1 ? size_t(kX86PaddedInstMaxSize - kX86InstMaxSize) : size_t(kX86PaddedInstMaxSize);
+  if (ASMJIT_UNLIKELY(self->getRemainingSpace() < space)) {
+    ASMJIT_PROPAGATE_ERROR(self->_grow(space));
+    fusedOffset = -1;
+  }
+
+  intptr_t offset = static_cast<intptr_t>(self->getOffset());
+
+  if (branchClass == kX86BranchNone || branchClass == kX86BranchFusible) {
+    Error error = X86Assembler_encode<Arch>(self, code, options, o0, o1, o2, o3);
+
+    if (error == kErrorOk && branchClass == kX86BranchFusible && o2->isNone() &&
+        X86Assembler_isMovableOp(o0) && X86Assembler_isMovableOp(o1)) {
+      self->_fusibleOffset = offset;
+      self->_fusibleSize = static_cast<uint32_t>(static_cast<intptr_t>(self->getOffset()) - offset);
+      self->_fusibleSectionId = self->_sectionId;
+    }
+
+    return error;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Trial]
+  // --------------------------------------------------------------------------
+
+  intptr_t spanOffset = fusedOffset != -1 ? fusedOffset : offset;
+  bool relax = self->hasAsmOption(Assembler::kOptionRelaxBranches);
+
+  // Everything the encoder can change, so it can be undone. A label can be
+  // referenced by any operand (jecxz has it in `o1`).
+  const Operand* ops[4] = { o0, o1, o2, o3 };
+  uint32_t labelIds[4];
+  uint32_t labelLinks[4];
+
+  uint32_t i;
+  for (i = 0; i < 4; i++) {
+    const Operand* op = ops[i];
+    uint32_t labelId = kInvalidValue;
+
+    if (op->isLabel())
+      labelId = static_cast<const Label*>(op)->getId();
+    else if (op->isMem() && static_cast<const X86Mem*>(op)->getMemType() == kMemTypeLabel)
+      labelId = static_cast<const X86Mem*>(op)->_vmem.base;
+
+    if (!self->isLabelValid(labelId))
+      labelId = kInvalidValue;
+
+    labelIds[i] = labelId;
+    labelLinks[i] = labelId != kInvalidValue ? self->_labelLinkHeads[labelId] : static_cast<uint32_t>(kInvalidValue);
+  }
+
+  size_t relaxCount = self->_relaxItems.getLength();
+  size_t relocCount = self->_relocations.getLength();
+  size_t trampolinesSize = self->_trampolinesSize;
+
+  const char* comment = self->_comment;
+  Logger* logger = self->_logger;
+
+  self->_logger = nullptr;
+  Error error = X86Assembler_encode<Arch>(self, code, options, o0, o1, o2, o3);
+  self->_logger = logger;
+
+  if (error != kErrorOk)
+    return error;
+
+  intptr_t spanSize = static_cast<intptr_t>(self->getOffset()) - spanOffset;
+  uint32_t padding = X86Assembler_branchPadding(spanOffset, spanSize);
+
+  if (padding == 0 && logger == nullptr && !relax)
+    return kErrorOk;
+
+  // --------------------------------------------------------------------------
+  // [Undo]
+  // --------------------------------------------------------------------------
+
+  for (i = 0; i < 4; i++) {
+    uint32_t labelId = labelIds[i];
+    if (labelId == kInvalidValue)
+      continue;
+
+    // Links are prepended, remove all added since the trial started.
+    while (self->_labelLinkHeads[labelId] != labelLinks[i]) {
+      uint32_t linkIndex = self->_labelLinkHeads[labelId];
+      self->_labelLinkHeads[labelId] = self->_getLabelLink(linkIndex).prev;
+      self->_releaseLabelLink(linkIndex);
+    }
+  }
+
+  self->_relaxItems.truncate(relaxCount);
+  self->_relocations.truncate(relocCount);
+
+  if (self->_trampolinesSize != trampolinesSize) {
+    if (self->_sections.getLength() != 0)
+      self->_sections[self->_sectionId]->trampolinesSize -= static_cast<uint32_t>(self->_trampolinesSize - trampolinesSize);
+    self->_trampolinesSize = trampolinesSize;
+  }
+
+  self->_comment = comment;
+  self->setCursor(self->_buffer + offset);
+
+  // --------------------------------------------------------------------------
+  // [Pad]
+  // --------------------------------------------------------------------------
+
+  // The padding has to be recalculated if the code before it is relaxed, even
+  // if there is no padding at the moment.
+  if (relax)
+    ASMJIT_PROPAGATE_ERROR(self->_addRelaxItem(kX86RelaxPad, padding,
+      static_cast<uint32_t>(offset - spanOffset), static_cast<uint32_t>(spanSize), spanOffset, 0));
+
+  if (padding != 0) {
+    uint8_t* span = self->_buffer + spanOffset;
+    ::memmove(span + padding, span, static_cast<size_t>(offset - spanOffset));
+    X86Assembler_fillAlign(span, padding, kAlignCode, self->_nopMaxSize);
+    self->setCursor(self->_buffer + offset + padding);
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+    if (logger)
+      logger->logFormat(Logger::kStyleComment,
+        "%s; Branch padding %u.\n", logger->getIndentation(), padding);
+#endif // !ASMJIT_DISABLE_LOGGER
+  }
+
+  return X86Assembler_encode<Arch>(self, code, options, o0, o1, o2, o3);
+}
+
+//! \internal
+//!
+//! Rewrite operands of an instruction to get its shortest encoding, see
+//! `Assembler::kOptionShortestEncoding`. Returns true and stores the new
+//! first and second operand to `dst` if they have been rewritten.
+//!
+//! Instructions that reference a label or an address relative to them are
+//! never rewritten, encoding them links the label or adds a relocation.
+template<int Arch>
+static bool X86Assembler_shorten(uint32_t code, uint32_t options, const Operand* o0, const Operand* o1, const Operand* o2, Operand* dst) noexcept {
+  if (code >= _kX86InstIdCount || (options & ~static_cast<uint32_t>(kX86InstOptionLock)) != 0 || !o2->isNone())
+    return false;
+
+  if (!X86Assembler_isMovableOp(o0) || !X86Assembler_isMovableOp(o1))
+    return false;
+
+  bool changed = false;
+  dst[0] = *o0;
+  dst[1] = *o1;
+
+  // --------------------------------------------------------------------------
+  // [REX.W]
+  // --------------------------------------------------------------------------
+
+  // 32-bit operations zero the upper half of the destination register, flags
+  // are the same if the result has the upper half zero as well.
+  if (Arch == kArchX64 && o0->isRegType(kX86RegTypeGpq)) {
+    uint32_t index = x86OpReg(o0);
+    bool toGpd = false;
+
+    if (o1->isImm()) {
+      int64_t imVal = static_cast<const Imm*>(o1)->getInt64();
+
+      if (code == kX86InstIdMov)
+        toGpd = imVal >= 0 && imVal <= ASMJIT_INT64_C(0xFFFFFFFF);
+      else if (code == kX86InstIdAnd || code == kX86InstIdTest)
+        toGpd = imVal >= 0 && imVal <= ASMJIT_INT64_C(0x7FFFFFFF);
+    }
+    else if (o1->isRegType(kX86RegTypeGpq) && x86OpReg(o1) == index) {
+      toGpd = code == kX86InstIdXor || code == kX86InstIdSub;
+    }
+    else if (code == kX86InstIdMovzx) {
+      toGpd = true;
+    }
+
+    if (toGpd) {
+      dst[0] = x86::gpd(index);
+      if (o1->isReg())
+        dst[1] = o1->isRegType(kX86RegTypeGpq) ? Operand(x86::gpd(index)) : *o1;
+      changed = true;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Imm8]
+  // --------------------------------------------------------------------------
+
+  // The immediate is truncated to the operand size, so an unsigned value like
+  // 0xFFFFFFF0 has the same effect as a sign-extended -16.
+  if (dst[1].isImm() && _x86InstInfo[code].getEncoding() == kX86InstEncodingX86Arith) {
+    uint32_t size = dst[0].getSize();
+    int64_t imVal = static_cast<Imm&>(dst[1]).getInt64();
+
+    if ((size == 2 || size == 4) && !Utils::isInt8(imVal) &&
+        (static_cast<uint64_t>(imVal) >> (size * 8)) == 0) {
+      int64_t signedVal = size == 2 ? static_cast<int64_t>(static_cast<int16_t>(imVal))
+                                    : static_cast<int64_t>(static_cast<int32_t>(imVal));
+      if (Utils::isInt8(signedVal)) {
+        static_cast<Imm&>(dst[1]).setInt64(signedVal);
+        changed = true;
+      }
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Mem]
+  // --------------------------------------------------------------------------
+
+  // RBP and R13 as a base always need a displacement, but not as an index.
+  // Only in 64-bit mode, where the default segment (SS vs DS) doesn't matter.
+  if (Arch == kArchX64) {
+    for (uint32_t i = 0; i < 2; i++) {
+      if (!dst[i].isMem())
+        continue;
+
+      X86Mem& m = static_cast<X86Mem&>(dst[i]);
+      if (!m.isBaseIndexType() || !m.hasBase() || !m.hasIndex() ||
+          m.getVSib() != kX86MemVSibGpz || m.getShift() != 0 || m.getDisplacement() != 0)
+        continue;
+
+      uint32_t mBase = m.getBase();
+      uint32_t mIndex = m.getIndex();
+
+      if ((mBase & 0x07) == kX86RegIndexBp && (mIndex & 0x07) != kX86RegIndexBp && mBase < 16 && mIndex < 16) {
+        m.setBase(mIndex);
+        m.setIndex(mBase);
+        changed = true;
+      }
+    }
+  }
+
+  return changed;
+}
+
+//! \internal
+//!
+//! Encode a single instruction if any of the assembler options that need
+//! more than encoding it is enabled.
+template<int Arch>
+static Error X86Assembler_emitSlow(X86Assembler* self, uint32_t code, uint32_t options, const Operand* o0, const Operand* o1, const Operand* o2, const Operand* o3) {
+  Operand shortOps[2];
+
+  if (self->hasAsmOption(Assembler::kOptionShortestEncoding) &&
+      X86Assembler_shorten<Arch>(code, options, o0, o1, o2, shortOps)) {
+    if (ASMJIT_UNLIKELY(self->getRemainingSpace() < kX86InstMaxSize))
+      ASMJIT_PROPAGATE_ERROR(self->_grow(kX86InstMaxSize));
+
+    // Both forms are encoded to count the bytes saved, then discarded. They
+    // don't reference labels or relative addresses, see `X86Assembler_shorten()`,
+    // so there is nothing else to undo.
+    uint8_t* cursor = self->getCursor();
+    const char* comment = self->_comment;
+    Logger* logger = self->_logger;
+
+    self->_logger = nullptr;
+    Error error = X86Assembler_encode<Arch>(self, code, options, o0, o1, o2, o3);
+    size_t longSize = static_cast<size_t>(self->getCursor() - cursor);
+    self->setCursor(cursor);
+
+    if (error == kErrorOk) {
+      error = X86Assembler_encode<Arch>(self, code, options, &shortOps[0], &shortOps[1], o2, o3);
+      size_t shortSize = static_cast<size_t>(self->getCursor() - cursor);
+      self->setCursor(cursor);
+
+      if (error == kErrorOk && shortSize < longSize)
+        self->_bytesSaved += longSize - shortSize;
+    }
+
+    self->_logger = logger;
+    self->_comment = comment;
+
+    if (error != kErrorOk)
+      return error;
+
+    o0 = &shortOps[0];
+    o1 = &shortOps[1];
+  }
+
+  if (self->hasAsmOption(Assembler::kOptionAlignBranches))
+    return X86Assembler_emitPadded<Arch>(self, code, options, o0, o1, o2, o3);
+
+  if (ASMJIT_UNLIKELY(self->getRemainingSpace() < kX86InstMaxSize))
+    ASMJIT_PROPAGATE_ERROR(self->_grow(kX86InstMaxSize));
+
+  return X86Assembler_encode<Arch>(self, code, options, o0, o1, o2, o3);
+}
+
+template<int Arch>
+static ASMJIT_INLINE Error X86Assembler_emit(X86Assembler* self, uint32_t code, const Operand* o0, const Operand* o1, const Operand* o2, const Operand* o3) {
+  uint32_t options = self->getInstOptionsAndReset();
+
+  if (ASMJIT_UNLIKELY((self->getAsmOptions() & (Assembler::kOptionAlignBranches | Assembler::kOptionShortestEncoding)) != 0))
+    return X86Assembler_emitSlow<Arch>(self, code, options, o0, o1, o2, o3);
+
+  // Grow request happens rarely.
+  if (ASMJIT_UNLIKELY(self->getRemainingSpace() < kX86InstMaxSize))
+    ASMJIT_PROPAGATE_ERROR(self->_grow(kX86InstMaxSize));
+
+  return X86Assembler_encode<Arch>(self, code, options, o0, o1, o2, o3);
+}
+
+template<int Arch>
+static ASMJIT_INLINE Error X86Assembler_emitBatch(X86Assembler* self, const InstRecord* records, size_t count) {
+  self->setInstOptions(0);
+
+  bool padded = self->hasAsmOption(Assembler::kOptionAlignBranches);
+  bool slow = (self->getAsmOptions() & (Assembler::kOptionAlignBranches | Assembler::kOptionShortestEncoding)) != 0;
+  size_t instSize = padded ? size_t(kX86PaddedInstMaxSize) : size_t(kX86InstMaxSize);
+
+  // Reserve space for the whole batch at once, so `X86Assembler_encode()`
+  // can be called without checking the code-buffer capacity each time.
+  if (ASMJIT_UNLIKELY(count > IntTraits<size_t>::maxValue() / instSize))
+    return self->setLastError(kErrorNoHeapMemory);
+
+  size_t size = count * instSize;
+  if (self->getRemainingSpace() < size) {
+    // A fixed code-buffer can't grow, check the space of each instruction
+    // instead, so the batch only fails if the code really doesn't fit.
+    if (self->isFixedBuffer())
+      slow = true;
+    else
+      ASMJIT_PROPAGATE_ERROR(self->_grow(size));
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const InstRecord& record = records[i];
+
+    if (ASMJIT_UNLIKELY(slow))
+      ASMJIT_PROPAGATE_ERROR(X86Assembler_emitSlow<Arch>(self, record.instId, record.options,
+        &record.o0, &record.o1, &record.o2, &record.o3));
+    else
+      ASMJIT_PROPAGATE_ERROR(X86Assembler_encode<Arch>(self, record.instId, record.options,
+        &record.o0, &record.o1, &record.o2, &record.o3));
+  }
+
+  return kErrorOk;
+}
+
+Error X86Assembler::_emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3) {
+#if defined(ASMJIT_BUILD_X86) && !defined(ASMJIT_BUILD_X64)
+  ASMJIT_ASSERT(_arch == kArchX86);
+  return X86Assembler_emit<kArchX86>(this, code, &o0, &o1, &o2, &o3);
+#elif !defined(ASMJIT_BUILD_X86) && defined(ASMJIT_BUILD_X64)
+  ASMJIT_ASSERT(_arch == kArchX64);
+  return X86Assembler_emit<kArchX64>(this, code, &o0, &o1, &o2, &o3);
+#else
+  if (_arch == kArchX86)
+    return X86Assembler_emit<kArchX86>(this, code, &o0, &o1, &o2, &o3);
+  else
+    return X86Assembler_emit<kArchX64>(this, code, &o0, &o1, &o2, &o3);
+#endif
+}
+
+Error X86Assembler::_emitBatch(const InstRecord* records, size_t count) {
+#if defined(ASMJIT_BUILD_X86) && !defined(ASMJIT_BUILD_X64)
+  ASMJIT_ASSERT(_arch == kArchX86);
+  return X86Assembler_emitBatch<kArchX86>(this, records, count);
+#elif !defined(ASMJIT_BUILD_X86) && defined(ASMJIT_BUILD_X64)
+  ASMJIT_ASSERT(_arch == kArchX64);
+  return X86Assembler_emitBatch<kArchX64>(this, records, count);
+#else
+  if (_arch == kArchX86)
+    return X86Assembler_emitBatch<kArchX86>(this, records, count);
+  else
+    return X86Assembler_emitBatch<kArchX64>(this, records, count);
+#endif
+}
+
+// ============================================================================
+// [asmjit::X86Assembler - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+//! Expect that `a` emitted the same code as the reference assembler `b`.
+static void X86Assembler_expectSameCode(X86Assembler& a, X86Assembler& b, const char* name) {
+  EXPECT(a.getLastError() == kErrorOk && b.getLastError() == kErrorOk,
+    "Emitting failed (%s).", name);
+  EXPECT(a.getCodeSize() == b.getCodeSize(),
+    "Code size mismatch (%s %u, expected %u).", name,
+    static_cast<unsigned int>(a.getCodeSize()),
+    static_cast<unsigned int>(b.getCodeSize()));
+
+  size_t size = a.getOffset();
+  for (size_t pos = 0; pos < size; pos++) {
+    EXPECT(a.readU8At(pos) == b.readU8At(pos),
+      "Byte mismatch at offset %u (%s).", static_cast<unsigned int>(pos), name);
+  }
+}
+
+UNIT(x86_assembler_relax) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+
+  a.addAsmOptions(Assembler::kOptionRelaxBranches);
+
+  Label L_Loop = a.newLabel();
+  Label L_Start = a.newLabel();
+  Label L_Skip = a.newLabel();
+  Label L_Done = a.newLabel();
+  Label L_Func = a.newLabel();
+
+  uint8_t trap[200];
+  ::memset(trap, 0xCC, sizeof(trap));
+
+  a.xor_(x86::eax, x86::eax);
+  a.mov(x86::ecx, 10);
+  a.call(L_Func);
+  a.jmp(L_Start);
+  a.add(x86::eax, 1000);
+
+  a.bind(L_Loop);
+  a.add(x86::eax, 3);
+  a.dec(x86::ecx);
+  a.jz(L_Done);
+
+  a.bind(L_Start);
+  a.test(x86::ecx, x86::ecx);
+  a.jnz(L_Loop);
+
+  a.align(kAlignCode, 16);
+  a.bind(L_Done);
+  a.ret();
+
+  // Doesn't fit into rel8, has to be enlarged.
+  a.short_().jmp(L_Skip);
+  a.embed(trap, sizeof(trap));
+  a.bind(L_Skip);
+  a.ret();
+
+  a.bind(L_Func);
+  a.add(x86::eax, 1);
+  a.ret();
+
+  size_t before = a.getCodeSize();
+  EXPECT(a.relax() == kErrorOk,
+    "X86Assembler::relax() failed.");
+
+  size_t after = a.getCodeSize();
+  INFO("Code size %u -> %u.",
+    static_cast<unsigned int>(before),
+    static_cast<unsigned int>(after));
+  EXPECT(after < before,
+    "Relaxation should have shrunk the code.");
+  EXPECT(a.getLabelOffset(L_Func) - a.getLabelOffset(L_Skip) == 1,
+    "Label offsets should have been updated.");
+
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  int result = func();
+  EXPECT(result == 31,
+    "Relaxed function returned %d instead of 31.", result);
+
+  runtime.release((void*)func);
+}
+
+UNIT(x86_assembler_sections) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+
+  a.addAsmOptions(Assembler::kOptionRelaxBranches);
+
+  uint32_t rodata = a.newSection(".rodata", Assembler::kSectionFlagConst, 16);
+  uint32_t cold = a.newSection(".text.cold", Assembler::kSectionFlagExec, 64);
+
+  EXPECT(rodata == 1 && cold == 2 && a.getSectionsCount() == 3,
+    "Couldn't create sections.");
+
+  Label L_Const = a.newLabel();
+  Label L_Cold = a.newLabel();
+  Label L_ColdTail = a.newLabel();
+  Label L_Ret = a.newLabel();
+
+  uint32_t value = 40;
+
+  a.mov(x86::eax, x86::ptr(L_Const));
+  a.call(L_Cold);
+  a.jmp(L_ColdTail);
+  a.bind(L_Ret);
+  a.ret();
+
+  a.section(rodata);
+  a.align(kAlignData, 16);
+  a.bind(L_Const);
+  a.embed(&value, sizeof(value));
+
+  a.section(cold);
+  a.bind(L_Cold);
+  a.add(x86::eax, 2);
+  a.ret();
+  a.bind(L_ColdTail);
+  a.add(x86::eax, 100);
+  a.jmp(L_Ret);
+
+  a.section(Assembler::kSectionDefault);
+
+  INFO("Sections .text=%u .rodata=%u .text.cold=%u bytes.",
+    static_cast<unsigned int>(a.getSectionLength(Assembler::kSectionDefault)),
+    static_cast<unsigned int>(a.getSectionLength(rodata)),
+    static_cast<unsigned int>(a.getSectionLength(cold)));
+
+  EXPECT(a.getSectionLength(rodata) == sizeof(value),
+    "Data should have been emitted to .rodata only.");
+
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  int result = func();
+  EXPECT(result == 142,
+    "Function returned %d instead of 142.", result);
+
+  runtime.release((void*)func);
+}
+
+UNIT(x86_assembler_chunks) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+
+  a.addAsmOptions(Assembler::kOptionChunkedBuffer);
+
+  Label L_Loop = a.newLabel();
+  Label L_Body = a.newLabel();
+
+  a.xor_(x86::eax, x86::eax);
+  a.mov(x86::ecx, 10);
+
+  // Both jumps cross chunk boundaries.
+  a.bind(L_Loop);
+  a.jmp(L_Body);
+  for (uint32_t i = 0; i < 30000; i++)
+    a.add(x86::edx, 1);
+  a.bind(L_Body);
+  a.add(x86::eax, 1);
+  a.dec(x86::ecx);
+  a.jnz(L_Loop);
+  a.ret();
+
+  size_t chunkCount = 0;
+  for (const CodeChunk* chunk = a._chunk; chunk != nullptr; chunk = chunk->prev)
+    chunkCount++;
+
+  INFO("Code size %u bytes in %u chunks.",
+    static_cast<unsigned int>(a.getCodeSize()),
+    static_cast<unsigned int>(chunkCount));
+  EXPECT(chunkCount > 1,
+    "Code should have been split into multiple chunks.");
+
+  // Opcode of `jmp rel32`, which is in the first chunk.
+  EXPECT(a.readU8At(static_cast<size_t>(a.getLabelOffset(L_Loop))) == 0xE9,
+    "Couldn't read the first chunk.");
+
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  int result = func();
+  EXPECT(result == 10,
+    "Function returned %d instead of 10.", result);
+
+  runtime.release((void*)func);
+}
+
+UNIT(x86_assembler_align_branches) {
+  typedef int (*Func)(void);
+
+  static const uint32_t optionsList[] = {
+    0,
+    Assembler::kOptionRelaxBranches
+  };
+
+  enum { kNopCount = 40 };
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(optionsList); i++) {
+    uint32_t options = optionsList[i] | Assembler::kOptionAlignBranches;
+    INFO("Aligning branches (options 0x%X).", options);
+
+    JitRuntime runtime;
+    X86Assembler a(&runtime);
+    a.addAsmOptions(options);
+
+    Label after[kNopCount];
+    Label L_Loop = a.newLabel();
+    Label L_Done = a.newLabel();
+
+    a.xor_(x86::eax, x86::eax);
+    a.bind(L_Loop);
+
+    // Each `cmp+jz` pair is preceded by a different number of bytes, so
+    // it has to be padded at least once for every possible position.
+    for (uint32_t n = 0; n < kNopCount; n++) {
+      after[n] = a.newLabel();
+      for (uint32_t j = 0; j < n; j++)
+        a.nop();
+
+      a.cmp(x86::eax, 60 + n);
+      a.jz(L_Done);
+      a.bind(after[n]);
+    }
+
+    a.inc(x86::eax);
+    a.jmp(L_Loop);
+
+    a.bind(L_Done);
+    a.sub(x86::eax, kNopCount);
+    a.ret();
+
+    if (options & Assembler::kOptionRelaxBranches) {
+      EXPECT(a.relax() == kErrorOk,
+        "Relaxation failed.");
+    }
+
+    const uint8_t* buffer = a.getBuffer();
+    for (uint32_t n = 0; n < kNopCount; n++) {
+      intptr_t end = a.getLabelOffset(after[n]);
+
+      // `cmp eax, imm8` followed by either `jz rel8` or `jz rel32`.
+      intptr_t jzSize = buffer[end - 2] == 0x74 ? 2 : 6;
+      intptr_t start = end - jzSize - 3;
+
+      EXPECT(buffer[start] == 0x83 && buffer[start + 1] == 0xF8,
+        "Cmp and jz #%u should have been kept together.", n);
+      EXPECT((start >> 5) == (end >> 5),
+        "Cmp and jz #%u [%d:%d] cross or end on a 32-byte boundary.", n,
+        static_cast<int>(start),
+        static_cast<int>(end));
+    }
+
+    Func func = asmjit_cast<Func>(a.make());
+    EXPECT(func != nullptr,
+      "Couldn't make the function.");
+
+    int result = func();
+    EXPECT(result == 20,
+      "Function returned %d instead of 20.", result);
+
+    runtime.release((void*)func);
+
+    // Jecxz has its label in the second operand, the link added by the first
+    // encode must be removed before it's padded and encoded again.
+    X86Assembler c(&runtime);
+    c.addAsmOptions(options);
+
+    Label L_Zero = c.newLabel();
+    c.xor_(x86::ecx, x86::ecx);
+    for (uint32_t n = 0; n < 29; n++)
+      c.nop();
+    c.jecxz(x86::ecx, L_Zero);
+    c.mov(x86::eax, 1);
+    c.ret();
+    c.bind(L_Zero);
+    c.mov(x86::eax, 2);
+    c.ret();
+
+    if (options & Assembler::kOptionRelaxBranches) {
+      EXPECT(c.relax() == kErrorOk,
+        "Relaxation failed.");
+    }
+
+    func = asmjit_cast<Func>(c.make());
+    EXPECT(func != nullptr,
+      "Couldn't make the jecxz function.");
+
+    result = func();
+    EXPECT(result == 2,
+      "Jecxz function returned %d instead of 2.", result);
+
+    runtime.release((void*)func);
+  }
+}
+
+UNIT(x86_assembler_auto_align) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  a.addAsmOptions(Assembler::kOptionOptimizedAlign);
+
+  Label L_Loop0 = a.newLabel();
+  Label L_Loop1 = a.newLabel();
+  Label L_Loop2 = a.newLabel();
+  Label L_Func = a.newLabel();
+
+  // Disabled by default.
+  a.nop();
+  a.bindLoop(L_Loop0);
+
+  EXPECT(a.setAutoAlign(16, 32, 10) == kErrorOk,
+    "Couldn't set the alignment policy.");
+  EXPECT(a.setAutoAlign(24, 32, 10) == kErrorInvalidArgument,
+    "Alignment must be a power of 2.");
+  a.resetLastError();
+
+  // Padding of 29 bytes exceeds the limit, 8 bytes doesn't.
+  a.nop();
+  a.nop();
+  a.bindLoop(L_Loop1);
+  while (a.getOffset() < 24)
+    a.nop();
+  a.bindLoop(L_Loop2);
+
+  a.nop();
+  a.bindFunc(L_Func);
+
+  EXPECT(a.getLabelOffset(L_Loop0) == 1,
+    "Loop head shouldn't be aligned by default.");
+  EXPECT(a.getLabelOffset(L_Loop1) == 3,
+    "Loop head padding should be limited.");
+  EXPECT(a.getLabelOffset(L_Loop2) == 32,
+    "Loop head should be aligned to 32.");
+  EXPECT(a.getLabelOffset(L_Func) == 48,
+    "Function entry should be aligned to 16.");
+
+  // AMD NOPs of 10 and 11 bytes.
+  static const uint8_t amdNops[] = {
+    0x66, 0x66, 0x2E, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0F, 0x1F, 0x40, 0x00
+  };
+
+  a.nop();
+  EXPECT(a.setNopMaxSize(11) == kErrorOk,
+    "Couldn't set the NOP size.");
+  a.align(kAlignCode, 16);
+  EXPECT(a.getOffset() == 64 && ::memcmp(a.getBuffer() + 49, amdNops, sizeof(amdNops)) == 0,
+    "Alignment should use NOPs of 11 bytes.");
+
+  // The limit is checked again after relaxation, jmp is shrunk by 3 bytes,
+  // so the padding would need 13 bytes.
+  X86Assembler b(&runtime);
+  b.addAsmOptions(Assembler::kOptionRelaxBranches);
+  b.setAutoAlign(0, 32, 10);
+
+  Label L_Loop = b.newLabel();
+  Label L_Done = b.newLabel();
+
+  b.jmp(L_Done);
+  while (b.getOffset() < 54)
+    b.nop();
+  b.bindLoop(L_Loop);
+  b.dec(x86::ecx);
+  b.jnz(L_Loop);
+  b.bind(L_Done);
+  b.ret();
+
+  EXPECT(b.getLabelOffset(L_Loop) == 64,
+    "Loop head should be aligned to 32.");
+  EXPECT(b.relax() == kErrorOk,
+    "Relaxation failed.");
+  EXPECT(b.getLabelOffset(L_Loop) == 51,
+    "Loop head shouldn't be aligned after relaxation, offset %d.",
+    static_cast<int>(b.getLabelOffset(L_Loop)));
+}
+
+UNIT(x86_assembler_tune) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Assembler b(&runtime);
+
+  a.tuneFor(CpuInfo::getHost());
+  EXPECT(a.hasAsmOption(Assembler::kOptionOptimizedAlign),
+    "Tuned assembler should use multi-byte NOPs.");
+
+  uint32_t funcAlign = a.getFuncAlign();
+  EXPECT(funcAlign >= 16,
+    "Tuned assembler should align function entries.");
+
+  Label L_Func = a.newLabel();
+  a.nop();
+  a.bindFunc(L_Func);
+
+  b.addAsmOptions(Assembler::kOptionOptimizedAlign);
+  b.setNopMaxSize(a.getNopMaxSize());
+  b.nop();
+  b.align(kAlignCode, funcAlign);
+
+  X86Assembler_expectSameCode(a, b, "tune");
+  EXPECT(a.getLabelOffset(L_Func) == static_cast<intptr_t>(funcAlign),
+    "Function entry should be aligned to %u.", funcAlign);
+  EXPECT(a.readU8At(1) != 0x90,
+    "Function entry should be padded by multi-byte NOPs.");
+}
+
+#if defined(ASMJIT_BUILD_X64)
+UNIT(x86_assembler_shortest) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime, kArchX64);
+  X86Assembler b(&runtime, kArchX64);
+
+  a.addAsmOptions(Assembler::kOptionShortestEncoding);
+
+  // Shortened by the optimizer (a) and written explicitly (b).
+  a.mov(x86::rax, Imm(ASMJIT_INT64_C(0xFFFFFFFF)));      b.mov(x86::eax, Imm(ASMJIT_INT64_C(0xFFFFFFFF)));
+  a.mov(x86::rcx, 1);                                    b.mov(x86::ecx, 1);
+  a.mov(x86::r9, 1);                                     b.mov(x86::r9d, 1);
+  a.xor_(x86::rax, x86::rax);                            b.xor_(x86::eax, x86::eax);
+  a.and_(x86::rdx, 0xFF);                                b.and_(x86::edx, 0xFF);
+  a.test(x86::rax, 0x10);                                b.test(x86::eax, 0x10);
+  a.and_(x86::eax, Imm(ASMJIT_INT64_C(0xFFFFFFF0)));     b.and_(x86::eax, -16);
+  a.mov(x86::eax, x86::ptr(x86::rbp, x86::rcx));         b.mov(x86::eax, x86::ptr(x86::rcx, x86::rbp));
+  a.movzx(x86::rax, x86::byte_ptr(x86::rsi));            b.movzx(x86::eax, x86::byte_ptr(x86::rsi));
+
+  // Not shortened, flags or the result would differ.
+  a.mov(x86::rax, -1);                                   b.mov(x86::rax, -1);
+  a.and_(x86::rax, -16);                                 b.and_(x86::rax, -16);
+  a.add(x86::rax, 1);                                    b.add(x86::rax, 1);
+  a.xor_(x86::rax, x86::rcx);                            b.xor_(x86::rax, x86::rcx);
+  a.mov(x86::eax, x86::ptr(x86::rbp, x86::rcx, 1));      b.mov(x86::eax, x86::ptr(x86::rbp, x86::rcx, 1));
+
+  // Not shortened, they reference a label that is bound later.
+  Label aL = a.newLabel();                               Label bL = b.newLabel();
+  a.movzx(x86::rax, x86::byte_ptr(aL));                  b.movzx(x86::rax, x86::byte_ptr(bL));
+  a.and_(x86::dword_ptr(aL), 0xFFFFFFF0);                b.and_(x86::dword_ptr(bL), 0xFFFFFFF0);
+  a.bind(aL);                                            b.bind(bL);
+  a.dd(0);                                               b.dd(0);
+
+  X86Assembler_expectSameCode(a, b, "shortest");
+  EXPECT(a.getBytesSaved() == 15,
+    "Reported %u bytes saved instead of 15.", static_cast<unsigned int>(a.getBytesSaved()));
+
+  a.reset();
+  EXPECT(a.getBytesSaved() == 0,
+    "Count of bytes saved should be cleared by reset().");
+}
+#endif // ASMJIT_BUILD_X64
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+static void X86Assembler_emitFastForms(X86Assembler& a, uint32_t arch) {
+  enum {
+    kFormR  = 0x01,
+    kFormRR = 0x02,
+    kFormRI = 0x04,
+    kFormRM = 0x08,
+    kFormMR = 0x10,
+    kFormArith = kFormRR | kFormRI | kFormRM | kFormMR
+  };
+
+  static const struct {
+    uint32_t instId;
+    uint32_t forms;
+  } instList[] = {
+    { kX86InstIdAdd , kFormArith },
+    { kX86InstIdAnd , kFormArith },
+    { kX86InstIdCmp , kFormArith },
+    { kX86InstIdSub , kFormArith },
+    { kX86InstIdXor , kFormArith },
+    { kX86InstIdMov , kFormArith },
+    { kX86InstIdLea , kFormRM    },
+    { kX86InstIdTest, kFormRR | kFormRI | kFormMR },
+    { kX86InstIdPush, kFormR     },
+    { kX86InstIdPop , kFormR     }
+  };
+
+  static const int64_t immList[] = {
+    0, 1, -1, 127, 128, -128, -129, 0x7FFFFFFF, -ASMJIT_INT64_C(0x80000000),
+    ASMJIT_INT64_C(0x80000000), ASMJIT_INT64_C(0x123456789)
+  };
+  static const int32_t dispList[] = { 0, 1, -128, 128, 0x12345678 };
+
+  uint32_t regCount = arch == kArchX86 ? 8 : 16;
+  uint32_t sizeCount = arch == kArchX86 ? 1 : 2;
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(instList); i++) {
+    uint32_t instId = instList[i].instId;
+    uint32_t forms = instList[i].forms;
+
+    for (uint32_t s = 0; s < sizeCount; s++) {
+      for (uint32_t r0 = 0; r0 < regCount; r0++) {
+        X86GpReg g0 = s == 0 ? x86::gpd(r0) : x86::gpq(r0);
+        X86GpReg index = arch == kArchX86 ? x86::gpd(r0) : x86::gpq(r0);
+
+        if (forms & kFormR)
+          a.emit(instId, g0);
+
+        if (forms & kFormRI) {
+          for (uint32_t k = 0; k < ASMJIT_ARRAY_SIZE(immList); k++)
+            a.emit(instId, g0, Imm(immList[k]));
+        }
+
+        for (uint32_t r1 = 0; r1 < regCount; r1++) {
+          X86GpReg g1 = s == 0 ? x86::gpd(r1) : x86::gpq(r1);
+          X86GpReg base = arch == kArchX86 ? x86::gpd(r1) : x86::gpq(r1);
+
+          if (forms & kFormRR)
+            a.emit(instId, g0, g1);
+
+          for (uint32_t k = 0; k < ASMJIT_ARRAY_SIZE(dispList); k++) {
+            X86Mem m0 = x86::ptr(base, dispList[k]);
+            if (forms & kFormRM) a.emit(instId, g0, m0);
+            if (forms & kFormMR) a.emit(instId, m0, g0);
+
+            // Esp/Rsp can't be used as an index.
+            if ((r0 & 0x07) == kX86RegIndexSp)
+              continue;
+
+            X86Mem m1 = x86::ptr(base, index, k & 0x3, dispList[k]);
+            if (forms & kFormRM) a.emit(instId, g1, m1);
+            if (forms & kFormMR) a.emit(instId, m1, g1);
+          }
+        }
+      }
+    }
+  }
+}
+
+UNIT(x86_assembler_fast_path) {
+  static const uint32_t archList[] = {
+#if defined(ASMJIT_BUILD_X86)
+    kArchX86,
+#endif // ASMJIT_BUILD_X86
+#if defined(ASMJIT_BUILD_X64)
+    kArchX64
+#endif // ASMJIT_BUILD_X64
+  };
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(archList); i++) {
+    uint32_t arch = archList[i];
+    INFO("Comparing fast and generic encoders (%s).", arch == kArchX86 ? "X86" : "X64");
+
+    JitRuntime runtime;
+    StringLogger logger;
+
+    // The fast path is not used if a logger is attached.
+    X86Assembler a(&runtime, arch);
+    X86Assembler b(&runtime, arch);
+    b.setLogger(&logger);
+
+    X86Assembler_emitFastForms(a, arch);
+    X86Assembler_emitFastForms(b, arch);
+    X86Assembler_expectSameCode(a, b, "fast");
+  }
+}
+
+UNIT(x86_assembler_fixed) {
+  typedef X86FixedGpd<kX86RegIndexAx> Eax;
+  typedef X86FixedGpd<kX86RegIndexCx> Ecx;
+  typedef X86FixedGpd<kX86RegIndexDx> Edx;
+  typedef X86FixedGpd<kX86RegIndexSi> Esi;
+  typedef X86FixedGpd<kX86RegIndexDi> Edi;
+
+  JitRuntime runtime;
+  StringLogger logger;
+
+  // The generic encoder is used if a logger is attached.
+  X86Assembler a(&runtime);
+  X86Assembler b(&runtime);
+  b.setLogger(&logger);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    X86Assembler& x = i == 0 ? a : b;
+
+    X86Fixed::emit<X86FixedSeq<X86FixedPush<Esi>, X86FixedPush<Edi> > >(x);
+    X86Fixed::emit<X86FixedMov<Esi, Ecx> >(x);
+    X86Fixed::emit<X86FixedMov<Edi, Edx> >(x);
+    X86Fixed::emit<X86FixedXor<Eax, Eax> >(x);
+    X86Fixed::emit<X86FixedAdd<Eax, Esi> >(x);
+    X86Fixed::emit<X86FixedImul<Eax, Edi> >(x);
+    X86Fixed::emit<X86FixedAddI8<Eax> >(x, 3);
+    X86Fixed::emit<X86FixedAddI32<Eax> >(x, 1000);
+    X86Fixed::emit<X86FixedSubI32<Ecx> >(x, 1000);
+    X86Fixed::emit<X86FixedMovI32<Edx> >(x, 1000);
+    X86Fixed::emit<X86FixedSub<Eax, Edx> >(x);
+    X86Fixed::emit<X86FixedTest<Eax, Ecx> >(x);
+    X86Fixed::emit<X86FixedSeq<X86FixedPop<Edi>, X86FixedPop<Esi> > >(x);
+
+#if ASMJIT_ARCH_X64
+    typedef X86FixedGpq<kX86RegIndexAx> Rax;
+    typedef X86FixedGpq<kX86RegIndexCx> Rcx;
+    typedef X86FixedGpq<kX86RegIndexR9> R9;
+    typedef X86FixedGpq<kX86RegIndexR12> R12;
+
+    X86Fixed::emit<X86FixedSeq<X86FixedPush<R12>, X86FixedPop<R12> > >(x);
+    X86Fixed::emit<X86FixedMov<R12, R9> >(x);
+    X86Fixed::emit<X86FixedCmp<R9, Rax> >(x);
+    X86Fixed::emit<X86FixedTest<Rcx, R12> >(x);
+    X86Fixed::emit<X86FixedMovI32<R12> >(x, -1);
+    X86Fixed::emit<X86FixedSubI8<R9> >(x, -8);
+    X86Fixed::emit<X86FixedCmpI32<Rax> >(x, 0x12345678);
+    X86Fixed::emit<X86FixedMovI32<X86FixedGpd<kX86RegIndexR9> > >(x, 7);
+#endif // ASMJIT_ARCH_X64
+
+    X86Fixed::emit<X86FixedRet>(x);
+  }
+
+  INFO("Comparing fixed and generic encoders (%u bytes).",
+    static_cast<unsigned int>(a.getCodeSize()));
+  X86Assembler_expectSameCode(a, b, "fixed");
+}
+#endif // !ASMJIT_DISABLE_LOGGER
+
+UNIT(x86_assembler_fixed_options) {
+  typedef X86FixedGpd<kX86RegIndexAx> Eax;
+  typedef X86FixedGpd<kX86RegIndexCx> Ecx;
+  typedef X86FixedGpd<kX86RegIndexDx> Edx;
+
+  JitRuntime runtime;
+
+  // Fixed instructions have to be padded the same way as generic ones.
+  {
+    INFO("Fixed instructions with kOptionAlignBranches.");
+
+    X86Assembler a(&runtime);
+    X86Assembler b(&runtime);
+
+    a.addAsmOptions(Assembler::kOptionAlignBranches);
+    b.addAsmOptions(Assembler::kOptionAlignBranches);
+
+    for (uint32_t k = 0; k < 2; k++) {
+      X86Assembler& x = k == 0 ? a : b;
+      Label L_Done = x.newLabel();
+      uint32_t i;
+
+      // `ret` would end on a 32-byte boundary.
+      for (i = 0; i < 31; i++)
+        x.nop();
+
+      if (k == 0)
+        X86Fixed::emit<X86FixedRet>(x);
+      else
+        x.ret();
+
+      // `cmp+jne` would cross a 32-byte boundary, padded as a pair.
+      for (i = 0; i < 29; i++)
+        x.nop();
+
+      if (k == 0)
+        X86Fixed::emit<X86FixedCmp<Eax, Ecx> >(x);
+      else
+        x.cmp(x86::eax, x86::ecx);
+
+      x.jne(L_Done);
+      x.bind(L_Done);
+    }
+
+    X86Assembler_expectSameCode(a, b, "fixed-align");
+    EXPECT(a.readU8At(32) == 0xC3,
+      "Fixed `ret` should have been moved to the next 32-byte boundary.");
+    EXPECT(a.readU8At(64) == b.readU8At(64) && a.readU8At(64) != 0x90,
+      "Fixed `cmp` should have been padded together with `jne`.");
+  }
+
+  // Fixed instructions have to be shortened the same way as generic ones.
+  {
+    INFO("Fixed instructions with kOptionShortestEncoding.");
+
+    X86Assembler a(&runtime);
+    X86Assembler b(&runtime);
+
+    a.addAsmOptions(Assembler::kOptionShortestEncoding);
+    b.addAsmOptions(Assembler::kOptionShortestEncoding);
+
+    X86Fixed::emit<X86FixedSubI32<Eax> >(a, 0xFFFFFFF0);
+    X86Fixed::emit<X86FixedMovI32<Edx> >(a, 1000);
+    X86Fixed::emit<X86FixedRet>(a);
+
+    b.sub(x86::eax, 0xFFFFFFF0);
+    b.mov(x86::edx, 1000);
+    b.ret();
+
+    X86Assembler_expectSameCode(a, b, "fixed-shortest");
+    EXPECT(a.getBytesSaved() == b.getBytesSaved() && a.getBytesSaved() != 0,
+      "Fixed instructions should have been shortened.");
+
+#if ASMJIT_ARCH_X64
+    typedef X86FixedGpq<kX86RegIndexAx> Rax;
+
+    a.reset();
+    b.reset();
+
+    a.addAsmOptions(Assembler::kOptionShortestEncoding);
+    b.addAsmOptions(Assembler::kOptionShortestEncoding);
+
+    X86Fixed::emit<X86FixedMovI32<Rax> >(a, 1000);
+    b.mov(x86::rax, 1000);
+
+    X86Assembler_expectSameCode(a, b, "fixed-shortest-x64");
+    EXPECT(a.getCodeSize() == 5,
+      "Fixed `mov rax, imm32` should have been encoded without REX.W.");
+#endif // ASMJIT_ARCH_X64
+  }
+}
+
+UNIT(x86_assembler_labels) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+
+  enum { kLabelCount = 1000 };
+  uint32_t i;
+
+  // Every label is referenced twice before it's bound, links of bound labels
+  // are returned to the pool and reused by labels created later.
+  for (uint32_t round = 0; round < 2; round++) {
+    Label labels[kLabelCount];
+
+    for (i = 0; i < kLabelCount; i++)
+      labels[i] = a.newLabel();
+
+    for (i = 0; i < kLabelCount; i++) {
+      a.jmp(labels[i]);
+      a.jmp(labels[kLabelCount - 1 - i]);
+    }
+
+    for (i = 0; i < kLabelCount; i++) {
+      a.bind(labels[i]);
+      a.nop();
+    }
+
+    EXPECT(a.getLastError() == kErrorOk,
+      "Emitting failed.");
+    EXPECT(a._labelLinks.getLength() == kLabelCount * 2,
+      "Expected %u label links, got %u (round %u).", kLabelCount * 2, static_cast<unsigned int>(a._labelLinks.getLength()), round);
+
+    for (i = 0; i < kLabelCount; i++) {
+      intptr_t offset = a.getLabelOffset(labels[i]);
+      intptr_t expected = static_cast<intptr_t>(a.getOffset()) - (kLabelCount - i);
+
+      EXPECT(offset == expected,
+        "Label #%u is bound at %d instead of %d.", i, static_cast<int>(offset), static_cast<int>(expected));
+    }
+  }
+
+  EXPECT(a.getLabelsCount() == kLabelCount * 2,
+    "Expected %u labels, got %u.", kLabelCount * 2, static_cast<unsigned int>(a.getLabelsCount()));
+
+  // Forward jumps of the last function go to `ret`.
+  a.reset();
+  Label L = a.newLabel();
+
+  a.mov(x86::eax, 42);
+  a.jmp(L);
+  a.mov(x86::eax, 0);
+  a.bind(L);
+  a.ret();
+
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  int result = func();
+  EXPECT(result == 42,
+    "Function returned %d instead of 42.", result);
+
+  runtime.release((void*)func);
+}
+
+UNIT(x86_assembler_batch) {
+  JitRuntime runtime;
+
+  X86Assembler a(&runtime);
+  X86Assembler b(&runtime);
+
+  const X86GpReg& zax = a.zax;
+  const X86GpReg& zcx = a.zcx;
+  const X86GpReg& zsi = a.zsi;
+
+  Label La = a.newLabel();
+  Label Lb = b.newLabel();
+
+  a.bind(La);
+  b.bind(Lb);
+
+  a.mov(zax, zcx);
+  a.add(zax, x86::ptr(zsi, zcx, 2, 16));
+  a.short_().jnz(La);
+  a.vpaddd(x86::ymm0, x86::ymm1, x86::ymm2);
+  a.shufps(x86::xmm0, x86::xmm1, 0x1B);
+  a.ret();
+
+  InstRecord records[] = {
+    InstRecord(kX86InstIdMov, zax, zcx),
+    InstRecord(kX86InstIdAdd, zax, x86::ptr(zsi, zcx, 2, 16)),
+    InstRecord(kX86InstIdJnz, Lb, noOperand, noOperand, noOperand, kInstOptionShortForm),
+    InstRecord(kX86InstIdVpaddd, x86::ymm0, x86::ymm1, x86::ymm2),
+    InstRecord(kX86InstIdShufps, x86::xmm0, x86::xmm1, Imm(0x1B)),
+    InstRecord(kX86InstIdRet)
+  };
+
+  // Options set before `emitBatch()` must not leak into the first record.
+  b.lock();
+  EXPECT(b.emitBatch(records, ASMJIT_ARRAY_SIZE(records)) == kErrorOk,
+    "Batch emitting failed.");
+
+  INFO("Comparing batch and generic encoders (%u bytes).",
+    static_cast<unsigned int>(a.getCodeSize()));
+  X86Assembler_expectSameCode(b, a, "batch");
+
+  // Emitting stops at the first invalid record.
+  X86Assembler c(&runtime);
+  InstRecord invalid[] = {
+    InstRecord(kX86InstIdNop),
+    InstRecord(_kX86InstIdCount),
+    InstRecord(kX86InstIdNop)
+  };
+
+  EXPECT(c.emitBatch(invalid, ASMJIT_ARRAY_SIZE(invalid)) == kErrorUnknownInst,
+    "Batch emitting should fail on an unknown instruction.");
+  EXPECT(c.getOffset() == 1,
+    "Batch emitting should stop at the first error.");
+}
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+UNIT(x86_assembler_binary_log) {
+  JitRuntime runtime;
+
+  StringLogger textLogger;
+  BinaryLogger binLogger(64);
+
+  textLogger.addOptions(Logger::kOptionBinaryForm);
+  binLogger.addOptions(Logger::kOptionBinaryForm);
+
+  X86Assembler* assemblers[2];
+  X86Assembler a(&runtime);
+  X86Assembler b(&runtime);
+
+  a.setLogger(&textLogger);
+  b.setLogger(&binLogger);
+
+  assemblers[0] = &a;
+  assemblers[1] = &b;
+
+  for (uint32_t i = 0; i < 2; i++) {
+    X86Assembler& x = *assemblers[i];
+    Label L = x.newLabel();
+
+    x.bind(L);
+    x.mov(x.zax, x.zcx);
+    x.add(x.zax, x86::ptr(x.zsi, x.zcx, 2, 16));
+    x.lock().inc(x86::dword_ptr(x.zdx));
+    x.vpaddd(x86::ymm0, x86::ymm1, x86::ymm2);
+    x.align(kAlignCode, 16);
+    x.jnz(L);
+    x._comment = "Done.";
+    x.ret();
+  }
+
+  StringBuilder sb;
+  EXPECT(binLogger.format(sb) == kErrorOk,
+    "Formatting the binary log failed.");
+
+  INFO("Binary log formatted to:\n%s", sb.getData());
+  EXPECT(binLogger.getDroppedCount() == 0,
+    "No records should be dropped.");
+  EXPECT(sb.eq(textLogger.getString()),
+    "Binary log should be formatted the same way as text log:\n%s", textLogger.getString());
+
+  // The ring buffer keeps only the most recent records, the fast path is used
+  // for instructions that don't need a binary form.
+  StringLogger tailText;
+  BinaryLogger tailBin(3);
+
+  X86Assembler c(&runtime);
+  X86Assembler d(&runtime);
+
+  c.setLogger(&tailText);
+  d.setLogger(&tailBin);
+
+  assemblers[0] = &c;
+  assemblers[1] = &d;
+
+  for (uint32_t i = 0; i < 2; i++) {
+    X86Assembler& x = *assemblers[i];
+    for (int j = 0; j < 10; j++)
+      x.add(x86::eax, j);
+  }
+
+  EXPECT(tailBin.getCapacity() == 4,
+    "Capacity should be rounded up to 4, not %u.", static_cast<unsigned int>(tailBin.getCapacity()));
+  EXPECT(tailBin.getCount() == 4 && tailBin.getDroppedCount() == 6,
+    "Ring buffer should keep 4 and drop 6 records, not %u and %u.",
+    static_cast<unsigned int>(tailBin.getCount()),
+    static_cast<unsigned int>(tailBin.getDroppedCount()));
+  EXPECT(tailBin.getRecord(0).offset == 6 * 3,
+    "The oldest record should be at offset 18, not %u.",
+    static_cast<unsigned int>(tailBin.getRecord(0).offset));
+
+  sb.clear();
+  tailBin.format(sb);
+
+  const char* tail = tailText.getString();
+  for (uint32_t i = 0; i < 6; i++)
+    tail = strchr(tail, '\n') + 1;
+
+  EXPECT(sb.eq(tail),
+    "Binary log should keep the last 4 instructions:\n%s", sb.getData());
+}
+#endif // !ASMJIT_DISABLE_LOGGER
+
+#if ASMJIT_ARCH_X64
+static int X86Assembler_picHelper() { return 20; }
+
+UNIT(x86_assembler_pic) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime, kArchX64);
+  a.addAsmOptions(Assembler::kOptionPositionIndependent);
+
+  Label L_Const = a.newLabel();
+  Imm helper((intptr_t)(void*)X86Assembler_picHelper);
+
+  a.push(x86::rbx);
+  a.sub(x86::rsp, 32);
+  a.call(helper);
+  a.mov(x86::ebx, x86::eax);
+  a.call(helper);
+  a.add(x86::eax, x86::ebx);
+  a.add(x86::eax, x86::dword_ptr(L_Const));
+  a.add(x86::rsp, 32);
+  a.pop(x86::rbx);
+  a.ret();
+  a.align(kAlignData, 4);
+  a.bind(L_Const);
+  a.dd(2);
+
+  EXPECT(a.getLastError() == kErrorOk,
+    "Emitting failed.");
+  EXPECT(a.getTrampolinesSize() == 8,
+    "Both calls should share a single GOT entry.");
+
+  size_t codeSize = a.getCodeSize();
+  uint8_t* code = static_cast<uint8_t*>(ASMJIT_ALLOC(codeSize * 2));
+  EXPECT(code != nullptr,
+    "Couldn't allocate the code-buffer.");
+
+  // The relocated code must not depend on the base address.
+  EXPECT(a.relocCode(code, 0x10000) == codeSize && a.relocCode(code + codeSize, 0x7FFF00000000) == codeSize,
+    "Couldn't relocate the code.");
+  EXPECT(::memcmp(code, code + codeSize, codeSize) == 0,
+    "Position independent code depends on its base address.");
+
+  INFO("Copying %u bytes of position independent code.",
+    static_cast<unsigned int>(codeSize));
+
+  VMemMgr* memMgr = runtime.getMemMgr();
+  for (uint32_t i = 0; i < 2; i++) {
+    void* p = memMgr->alloc(codeSize + i * 64);
+    EXPECT(p != nullptr,
+      "Couldn't allocate virtual memory.");
+
+    ::memcpy(static_cast<uint8_t*>(p) + i * 64, code, codeSize);
+    Func func = asmjit_cast<Func>(static_cast<uint8_t*>(p) + i * 64);
+
+    int result = func();
+    EXPECT(result == 42,
+      "Function copy #%u returned %d instead of 42.", i, result);
+
+    memMgr->release(p);
+  }
+
+  ASMJIT_FREE(code);
+
+  X86Assembler b(&runtime, kArchX64);
+  b.addAsmOptions(Assembler::kOptionPositionIndependent);
+
+  Label L_Data = b.newLabel();
+  b.bind(L_Data);
+  EXPECT(b.embedLabel(L_Data) == kErrorIllegalAddresing,
+    "Embedding an absolute address should fail in position independent code.");
+}
+
+UNIT(x86_assembler_reloc_shared) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime, kArchX64);
+
+  static const Ptr targets[3] = { 0x10000, 0x20000, 0x30000 };
+  enum { kCallCount = 300 };
+
+  uint32_t i;
+  for (i = 0; i < kCallCount; i++)
+    a.call(Imm(static_cast<int64_t>(targets[i % 3])));
+
+  EXPECT(a.getLastError() == kErrorOk,
+    "Emitting failed.");
+  EXPECT(a.getTrampolinesSize() == 3 * 8,
+    "Trampolines should be reserved once per target, not per call.");
+
+  size_t codeSize = a.getCodeSize();
+  size_t minCodeSize = a.getOffset();
+
+  uint8_t* code = static_cast<uint8_t*>(ASMJIT_ALLOC(codeSize));
+  EXPECT(code != nullptr,
+    "Couldn't allocate the code-buffer.");
+
+  // Targets are reachable, no trampolines are needed.
+  EXPECT(a.relocCode(code, 0x40000) == minCodeSize,
+    "Relocation to a near address shouldn't use trampolines.");
+
+  // Targets are not reachable, calls to the same target share a trampoline.
+  EXPECT(a.relocCode(code, ASMJIT_UINT64_C(0x7FFF00000000)) == minCodeSize + 3 * 8,
+    "Calls to the same target should share a single trampoline.");
+
+  for (i = 0; i < kCallCount; i++) {
+    size_t offset = i * 6 + 2;
+
+    EXPECT(code[offset - 2] == 0xFF && code[offset - 1] == 0x15,
+      "Call #%u should be patched to use a trampoline.", i);
+
+    size_t entry = offset + 4 + Utils::readI32u(code + offset);
+    EXPECT(entry + 8 <= codeSize && Utils::readU64u(code + entry) == static_cast<uint64_t>(targets[i % 3]),
+      "Call #%u reads a wrong trampoline.", i);
+  }
+
+  ASMJIT_FREE(code);
+
+  // An entry reserved by a call that was rolled back has to be reserved
+  // again, calls emitted after `reset()` reserve their own entries.
+  Assembler::Checkpoint cp;
+  EXPECT(a.checkpoint(cp) == kErrorOk,
+    "Couldn't create a checkpoint.");
+  a.call(Imm(0x40000));
+  EXPECT(a.getTrampolinesSize() == 4 * 8 && a.rollback(cp) == kErrorOk && a.getTrampolinesSize() == 3 * 8,
+    "Rollback should release the trampoline.");
+
+  a.call(Imm(0x40000));
+  a.call(Imm(0x40000));
+  EXPECT(a.getTrampolinesSize() == 4 * 8,
+    "Trampoline should be reserved again after rollback.");
+
+  a.reset();
+  a.call(Imm(static_cast<int64_t>(targets[0])));
+  EXPECT(a.getTrampolinesSize() == 8,
+    "Trampoline should be reserved again after reset().");
+
+  // GOT entries of position independent code are shared the same way, in
+  // each section separately.
+  X86Assembler b(&runtime, kArchX64);
+  b.addAsmOptions(Assembler::kOptionPositionIndependent);
+
+  for (i = 0; i < kCallCount; i++)
+    b.call(Imm(static_cast<int64_t>(targets[i % 3])));
+
+  uint32_t cold = b.newSection(".text.cold", Assembler::kSectionFlagExec);
+  EXPECT(b.section(cold) == kErrorOk,
+    "Couldn't switch to the section.");
+  b.call(Imm(static_cast<int64_t>(targets[0])));
+  b.call(Imm(static_cast<int64_t>(targets[0])));
+
+  EXPECT(b.getLastError() == kErrorOk,
+    "Emitting failed.");
+  EXPECT(b.getTrampolinesSize() == 4 * 8,
+    "GOT entries should be reserved once per target and section.");
+}
+#endif // ASMJIT_ARCH_X64
+
+UNIT(x86_assembler_checkpoint) {
+  typedef int (*Func)(void);
+
+  static const uint32_t options[] = {
+    0,
+    Assembler::kOptionChunkedBuffer
+  };
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Assembler r(&runtime);
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(options); i++) {
+    uint32_t option = options[i];
+
+    INFO("Checkpoint with options 0x%08X.", option);
+
+    a.reset();
+    r.reset();
+    a.addAsmOptions(option);
+    r.addAsmOptions(option);
+
+    uint32_t dataSection = 0;
+    Label L_Exit[2];
+    X86Assembler* both[2] = { &a, &r };
+
+    // Both assemblers emit the same code, `r` never speculates.
+    for (uint32_t j = 0; j < 2; j++) {
+      X86Assembler* x = both[j];
+      dataSection = x->newSection(".data", Assembler::kSectionFlagConst);
+
+      L_Exit[j] = x->newLabel();
+      x->mov(x86::eax, 0);
+      x->mov(x86::ecx, 1);
+      x->test(x86::ecx, x86::ecx);
+      x->jz(L_Exit[j]);
+      x->add(x86::eax, 1);
+    }
+
+    Assembler::Checkpoint cp1;
+    Assembler::Checkpoint cp2;
+    Assembler::Checkpoint cp3;
+
+    EXPECT(a.checkpoint(cp1) == kErrorOk && a.getCheckpointDepth() == 1,
+      "Couldn't create a checkpoint.");
+
+    size_t labelCount = a.getLabelsCount();
+    a.add(x86::eax, 2);
+
+    EXPECT(a.checkpoint(cp2) == kErrorOk && a.getCheckpointDepth() == 2,
+      "Couldn't create a nested checkpoint.");
+
+    // Speculative code binds a label referenced before the checkpoint, links
+    // to labels of its own, and grows the buffer.
+    Label L_Spec = a.newLabel();
+    a.jmp(L_Spec);
+    for (uint32_t j = 0; j < 30000; j++)
+      a.add(x86::edx, 1);
+    a.bind(L_Spec);
+    a.bind(L_Exit[0]);
+    a.jmp(L_Spec);
+    a.call(imm_ptr(reinterpret_cast<void*>(0x1234)));
+
+    a.section(dataSection);
+    a.dd(0x11223344);
+    a.section(Assembler::kSectionDefault);
+
+    EXPECT(a.rollback(cp1) == kErrorInvalidState,
+      "Only the innermost checkpoint can be rolled back.");
+
+    EXPECT(a.rollback(cp2) == kErrorOk,
+      "Couldn't roll back the nested checkpoint.");
+    EXPECT(a.getLabelsCount() == labelCount && a.getLabelOffset(L_Exit[0]) == -1,
+      "Labels were not restored.");
+
+    EXPECT(a.commit(cp1) == kErrorOk && a.getCheckpointDepth() == 0,
+      "Couldn't commit the checkpoint.");
+
+    // An empty checkpoint rolled back doesn't change anything.
+    a.checkpoint(cp3);
+    a.rollback(cp3);
+
+    r.add(x86::eax, 2);
+
+    for (uint32_t j = 0; j < 2; j++) {
+      X86Assembler* x = both[j];
+      x->bind(L_Exit[j]);
+      x->ret();
+    }
+
+    // Rollback clears the error, the code of the default section matches.
+    X86Assembler_expectSameCode(a, r, "rollback");
+
+    size_t codeSize = a.getCodeSize();
+
+    uint8_t* code = static_cast<uint8_t*>(ASMJIT_ALLOC(codeSize * 2));
+    EXPECT(code != nullptr,
+      "Couldn't allocate the buffer.");
+
+    size_t aSize = a.relocCode(code, 0x10000);
+    size_t rSize = r.relocCode(code + codeSize, 0x10000);
+    EXPECT(aSize == rSize && ::memcmp(code, code + codeSize, aSize) == 0,
+      "Code after rollback doesn't match code emitted without speculation.");
+    ASMJIT_FREE(code);
+
+    Func func = asmjit_cast<Func>(a.make());
+    EXPECT(func != nullptr,
+      "Couldn't make the function.");
+
+    int result = func();
+    EXPECT(result == 3,
+      "Function returned %d instead of 3.", result);
+
+    runtime.release((void*)func);
+  }
+}
+
+UNIT(x86_assembler_fixed_buffer) {
+  uint8_t buffer[256];
+  uint8_t code[256];
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Assembler r(&runtime);
+
+  EXPECT(a.setFixedBuffer(buffer, sizeof(buffer)) == kErrorOk && a.isFixedBuffer(),
+    "Couldn't set the fixed buffer.");
+
+  // A thunk with forward and backward jumps and a relocation.
+  for (uint32_t i = 0; i < 2; i++) {
+    X86Assembler& x = i == 0 ? a : r;
+
+    Label L_Loop = x.newLabel();
+    Label L_Exit = x.newLabel();
+
+    x.xor_(x86::eax, x86::eax);
+    x.test(x86::ecx, x86::ecx);
+    x.jz(L_Exit);
+    x.bind(L_Loop);
+    x.add(x86::eax, x86::ecx);
+    x.dec(x86::ecx);
+    x.jnz(L_Loop);
+    x.bind(L_Exit);
+    x.call(imm_ptr(reinterpret_cast<void*>(0x1000)));
+    x.ret();
+  }
+
+  X86Assembler_expectSameCode(a, r, "fixed buffer");
+  EXPECT(a.getBuffer() == buffer && a.getCodeSize() <= sizeof(code),
+    "Thunk should have been emitted to the fixed buffer.");
+
+  // Relocation in place.
+  size_t relocSize = a.relocCode(buffer, 0x2000);
+  EXPECT(relocSize == r.relocCode(code, 0x2000) && ::memcmp(buffer, code, relocSize) == 0,
+    "Code relocated in place doesn't match.");
+
+  a.reset();
+  EXPECT(!a.isFixedBuffer() && a.getBuffer() == nullptr,
+    "Reset should detach the fixed buffer.");
+
+  // The code-buffer doesn't grow.
+  a.setFixedBuffer(buffer, 32);
+  for (uint32_t i = 0; i < 32 && a.getLastError() == kErrorOk; i++)
+    a.nop();
+
+  EXPECT(a.getLastError() == kErrorCodeTooLarge && a.getBuffer() == buffer && a.getOffset() <= 32,
+    "Code should have been limited by the fixed buffer.");
+
+  // Labels and links don't grow either.
+  a.reset();
+  a.setFixedBuffer(buffer, sizeof(buffer));
+
+  for (uint32_t i = 0; i < 16; i++)
+    a.newLabel();
+  EXPECT(a.getLastError() == kErrorOk && !a.newLabel().isInitialized() && a.getLastError() == kErrorCodeTooLarge,
+    "Count of labels should have been limited.");
+
+  a.reset();
+  a.setFixedBuffer(buffer, sizeof(buffer));
+
+  Label L = a.newLabel();
+  for (uint32_t i = 0; i < 16; i++)
+    a.jmp(L);
+  EXPECT(a.getLastError() == kErrorOk && a.jmp(L) == kErrorCodeTooLarge,
+    "Count of links should have been limited.");
+
+  // Embedded arrays are used again after grown arrays are released.
+  a.reset();
+  for (uint32_t i = 0; i < 100; i++)
+    a.newLabel();
+
+  a.reset(true);
+  a.setFixedBuffer(buffer, sizeof(buffer));
+  EXPECT(a.newLabel().isInitialized(),
+    "Embedded arrays should be used after the memory was released.");
+
+  // A batch fits if its code fits, even if the worst case of each record
+  // wouldn't fit.
+  enum { kBatchCount = 64 };
+  InstRecord records[kBatchCount];
+
+  for (uint32_t i = 0; i < kBatchCount; i++)
+    records[i] = InstRecord(kX86InstIdNop);
+
+  a.reset();
+  a.setFixedBuffer(buffer, 32 + kBatchCount);
+  EXPECT(a.emitBatch(records, kBatchCount) == kErrorOk && a.getOffset() == kBatchCount,
+    "Batch should have been emitted to the fixed buffer.");
+  EXPECT(a.emitBatch(records, kBatchCount) == kErrorCodeTooLarge && a.getBuffer() == buffer,
+    "Batch should have been limited by the fixed buffer.");
 }
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
 
 } // asmjit namespace
 
@@ -18,9 +18,81 @@
 
 namespace asmjit {
 
+// ============================================================================
+// [Forward Declarations]
+// ============================================================================
+
+struct X86RelocEntryMap;
+
 //! \addtogroup asmjit_x86
 //! \{
 
+// ============================================================================
+// [asmjit::X86RelaxType]
+// ============================================================================
+
+//! \internal
+//!
+//! Type of `X86RelaxItem`.
+ASMJIT_ENUM(X86RelaxType) {
+  //! Unconditional jump to a label (`EB rel8` or `E9 rel32`).
+  kX86RelaxJmp = 0,
+  //! Conditional jump to a label (`7x rel8` or `0F 8x rel32`).
+  kX86RelaxJcc = 1,
+  //! Label-relative displacement that has a fixed size (call, jecxz, [rip]).
+  kX86RelaxDisp = 2,
+  //! Alignment sequence, its size depends on the offset.
+  kX86RelaxAlign = 3,
+  //! Padding before a branch, see `Assembler::kOptionAlignBranches`.
+  kX86RelaxPad = 4
+};
+
+// ============================================================================
+// [asmjit::X86RelaxItem]
+// ============================================================================
+
+//! \internal
+//!
+//! Span-dependent item recorded by `X86Assembler` if `kOptionRelaxBranches`
+//! option is enabled, see `X86Assembler::relax()`.
+struct X86RelaxItem {
+  //! Item type, see \ref X86RelaxType.
+  uint8_t type;
+  //! Size of the item in bytes (jump size, displacement size, or padding).
+  uint8_t size;
+  //! Short-form opcode of jmp/jcc, align mode of the alignment, or size of
+  //! the macro-fused instruction between the padding and the branch.
+  uint8_t opCode;
+  //! \internal
+  uint8_t reserved;
+  //! Label id (jmp/jcc/displacement), alignment, or size of the padded code.
+  uint32_t id;
+  //! Section that contains the item.
+  uint32_t sectionId;
+  //! Offset of the instruction (jmp/jcc), displacement, or padding.
+  intptr_t offset;
+  //! Displacement added to the label-relative value (displacement), or the
+  //! maximum padding of the alignment.
+  intptr_t displacement;
+};
+
+// ============================================================================
+// [asmjit::X86RefSite]
+// ============================================================================
+
+//! \internal
+//!
+//! Relative reference to a label or a RIP relative displacement recorded by
+//! `X86Assembler` if `X86Assembler::_refSites` is set, see `X86StencilBuilder`.
+struct X86RefSite {
+  //! Label id, `kInvalidValue` if the displacement is not label-relative.
+  uint32_t labelId;
+  //! Section that contains the instruction.
+  uint32_t sectionId;
+  //! Offset of the end of the instruction.
+  intptr_t end;
+};
+
 // ============================================================================
 // [asmjit::X86Assembler]
 // ============================================================================
@@ -69,12 +141,31 @@ namespace asmjit {
     return *this; \
   } \
   \
+  /*! Force REX2 prefix (X64 & APX). */ \
+  ASMJIT_INLINE T& rex2() noexcept { \
+    _instOptions |= kX86InstOptionRex2; \
+    return *this; \
+  } \
+  \
+  /*! Do not update flags, only `add`, `sub`, etc... (X64 & APX). */ \
+  ASMJIT_INLINE T& nf() noexcept { \
+    _instOptions |= kX86InstOptionNf; \
+    return *this; \
+  } \
+  \
   /*! Force 4-byte EVEX prefix (AVX512+). */ \
   ASMJIT_INLINE T& evex() noexcept { \
     _instOptions |= kX86InstOptionEvex; \
     return *this; \
   } \
   \
+  /*! Use opmask register `kreg` to select the elements written (AVX512+). */ \
+  ASMJIT_INLINE T& k(const X86KReg& kreg) noexcept { \
+    _instOptions = (_instOptions & ~static_cast<uint32_t>(kX86InstOptionEvexK_Mask)) | \
+                   (kreg.getRegIndex() << kX86InstOptionEvexK_Shift); \
+    return *this; \
+  } \
+  \
   /*! Use zeroing instead of merging (AVX512+). */ \
   ASMJIT_INLINE T& z() noexcept { \
     _instOptions |= kX86InstOptionEvexZero; \
@@ -392,6 +483,33 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   );
   ASMJIT_API virtual ~X86Assembler();
 
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_API virtual void reset(bool releaseMemory = false) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Memory]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_API virtual size_t getMemorySize() const noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Tune]
+  // --------------------------------------------------------------------------
+
+  //! Enable assembler options recommended for `cpuInfo`.
+  //!
+  //! Enables `kOptionAlignBranches` if the CPU is affected by the JCC erratum,
+  //! see `CpuInfo::hasX86JccErratum()`, enables `kOptionOptimizedAlign` and
+  //! selects the longest NOP the vendor recommends for code alignment, and
+  //! sets the automatic alignment policy
+  //! used by `bindFunc()` and `bindLoop()`. Assembler options and the policy
+  //! are cleared by `reset()`, so this function has to be called again after
+  //! it.
+  ASMJIT_API void tuneFor(const CpuInfo& cpuInfo) noexcept;
+
   // --------------------------------------------------------------------------
   // [Arch]
   // --------------------------------------------------------------------------
@@ -488,23 +606,105 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! Embed absolute label pointer (4 or 8 bytes).
   ASMJIT_API Error embedLabel(const Label& op);
 
+  // --------------------------------------------------------------------------
+  // [Label]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_API virtual Error bind(const Label& label) noexcept;
+
+  //! Bind `label` as a function entry.
+  //!
+  //! The code is aligned to `getFuncAlign()` before the label is bound, see
+  //! `setAutoAlign()`.
+  ASMJIT_API Error bindFunc(const Label& label) noexcept;
+
+  //! Bind `label` as a loop head (a target of a backward jump).
+  //!
+  //! The code is aligned to `getLoopAlign()` before the label is bound, but
+  //! only if it doesn't need more than `getMaxAlignPadding()` bytes, because
+  //! the padding is executed each time the loop is entered.
+  ASMJIT_API Error bindLoop(const Label& label) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Checkpoint]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_API virtual Error checkpoint(Checkpoint& cp) noexcept;
+  ASMJIT_API virtual Error rollback(const Checkpoint& cp) noexcept;
+
   // --------------------------------------------------------------------------
   // [Align]
   // --------------------------------------------------------------------------
 
   ASMJIT_API virtual Error align(uint32_t alignMode, uint32_t offset) noexcept;
 
+  //! \internal
+  //!
+  //! Align the code to `offset`, but emit at most `maxSize` bytes, otherwise
+  //! don't align at all.
+  ASMJIT_API Error _align(uint32_t alignMode, uint32_t offset, uint32_t maxSize) noexcept;
+
+  //! Set the automatic alignment policy.
+  //!
+  //! Function entries bound by `bindFunc()` are aligned to `funcAlign` and
+  //! loop heads bound by `bindLoop()` are aligned to `loopAlign`, if it needs
+  //! at most `maxPadding` bytes. `X86Compiler` binds function entries and
+  //! targets of backward jumps this way. Alignment 0 or 1 disables it, which
+  //! is the default.
+  ASMJIT_API Error setAutoAlign(uint32_t funcAlign, uint32_t loopAlign, uint32_t maxPadding) noexcept;
+
+  //! Get alignment of function entries, see `setAutoAlign()`.
+  ASMJIT_INLINE uint32_t getFuncAlign() const noexcept { return _funcAlign; }
+  //! Get alignment of loop heads, see `setAutoAlign()`.
+  ASMJIT_INLINE uint32_t getLoopAlign() const noexcept { return _loopAlign; }
+  //! Get maximum padding of loop heads, see `setAutoAlign()`.
+  ASMJIT_INLINE uint32_t getMaxAlignPadding() const noexcept { return _maxAlignPadding; }
+
+  //! Set the size of the longest NOP instruction used by code alignment.
+  //!
+  //! Only used if `kOptionOptimizedAlign` is enabled, can be between 1 and 11
+  //! (default 9, the longest form listed by Intel). AMD processors decode NOPs
+  //! of 10 and 11 bytes (prefixed by 0x66 and 0x2E) as efficiently.
+  ASMJIT_API Error setNopMaxSize(uint32_t nopMaxSize) noexcept;
+
+  //! Get the size of the longest NOP instruction used by code alignment.
+  ASMJIT_INLINE uint32_t getNopMaxSize() const noexcept { return _nopMaxSize; }
+
+  // --------------------------------------------------------------------------
+  // [Stats]
+  // --------------------------------------------------------------------------
+
+  //! Get count of bytes saved by `kOptionShortestEncoding` since `reset()`.
+  ASMJIT_INLINE size_t getBytesSaved() const noexcept { return _bytesSaved; }
+
+  // --------------------------------------------------------------------------
+  // [Relax]
+  // --------------------------------------------------------------------------
+
+  //! \internal
+  //!
+  //! Record a span-dependent item, used if `kOptionRelaxBranches` is enabled.
+  ASMJIT_API Error _addRelaxItem(uint32_t type, uint32_t size, uint32_t opCode, uint32_t id, intptr_t offset, intptr_t displacement) noexcept;
+
+  ASMJIT_API virtual Error relax() noexcept;
+
+  //! \internal
+  //!
+  //! Relax `items` of the current section.
+  ASMJIT_API Error _relaxSection(X86RelaxItem* items, size_t count) noexcept;
+
   // --------------------------------------------------------------------------
   // [Reloc]
   // --------------------------------------------------------------------------
 
-  ASMJIT_API virtual size_t _relocCode(void* dst, Ptr baseAddress) const noexcept;
+  ASMJIT_API virtual size_t _relocSection(uint32_t id, void* dst, const Ptr* baseAddresses) const noexcept;
 
   // --------------------------------------------------------------------------
   // [Emit]
   // --------------------------------------------------------------------------
 
   ASMJIT_API virtual Error _emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3);
+  ASMJIT_API virtual Error _emitBatch(const InstRecord* records, size_t count);
 
   // -------------------------------------------------------------------------
   // [Options]
@@ -519,6 +719,33 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! Count of registers depending on the architecture selected.
   X86RegCount _regCount;
 
+  //! Span-dependent items, see `relax()`.
+  PodVector<X86RelaxItem> _relaxItems;
+  //! Relative references emitted, recorded only if not null.
+  PodVector<X86RefSite>* _refSites;
+  //! GOT entries and trampolines reserved per target, allocated on demand.
+  X86RelocEntryMap* _relocEntries;
+
+  //! Offset of the last instruction if it can be macro-fused with a following
+  //! jcc, -1 otherwise, see `kOptionAlignBranches`.
+  intptr_t _fusibleOffset;
+  //! Size of the last instruction that can be macro-fused.
+  uint32_t _fusibleSize;
+  //! Section of the last instruction that can be macro-fused.
+  uint32_t _fusibleSectionId;
+
+  //! Alignment of function entries, see `setAutoAlign()`.
+  uint8_t _funcAlign;
+  //! Alignment of loop heads, see `setAutoAlign()`.
+  uint8_t _loopAlign;
+  //! Maximum padding of loop heads, see `setAutoAlign()`.
+  uint8_t _maxAlignPadding;
+  //! Size of the longest NOP used by code alignment, see `setNopMaxSize()`.
+  uint8_t _nopMaxSize;
+
+  //! Count of bytes saved by `kOptionShortestEncoding`.
+  size_t _bytesSaved;
+
   //! EAX or RAX register depending on the architecture selected.
   X86GpReg zax;
   //! ECX or RCX register depending on the architecture selected.
@@ -1838,6 +2065,91 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_1x(wrfsbase, kX86InstIdWrfsbase, X86GpReg)
   INST_1x(wrgsbase, kX86InstIdWrgsbase, X86GpReg)
 
+  // --------------------------------------------------------------------------
+  // [APX]
+  // --------------------------------------------------------------------------
+
+  // NOTE: R16..R31 registers can be used by all legacy instructions that can
+  // be encoded by REX2 prefix. Three operand forms below write the result to
+  // a new destination `o0` (NDD) and are always EVEX encoded.
+
+  //! Add with carry to a new destination (APX).
+  INST_3x(adc, kX86InstIdAdc, X86GpReg, X86GpReg, X86GpReg)
+  //! \overload
+  INST_3x(adc, kX86InstIdAdc, X86GpReg, X86GpReg, X86Mem)
+  //! \overload
+  INST_3x(adc, kX86InstIdAdc, X86GpReg, X86Mem, X86GpReg)
+  //! \overload
+  INST_3i(adc, kX86InstIdAdc, X86GpReg, X86GpReg, Imm)
+  //! \overload
+  INST_3i(adc, kX86InstIdAdc, X86GpReg, X86Mem, Imm)
+
+  //! Add to a new destination (APX).
+  INST_3x(add, kX86InstIdAdd, X86GpReg, X86GpReg, X86GpReg)
+  //! \overload
+  INST_3x(add, kX86InstIdAdd, X86GpReg, X86GpReg, X86Mem)
+  //! \overload
+  INST_3x(add, kX86InstIdAdd, X86GpReg, X86Mem, X86GpReg)
+  //! \overload
+  INST_3i(add, kX86InstIdAdd, X86GpReg, X86GpReg, Imm)
+  //! \overload
+  INST_3i(add, kX86InstIdAdd, X86GpReg, X86Mem, Imm)
+
+  //! And to a new destination (APX).
+  INST_3x(and_, kX86InstIdAnd, X86GpReg, X86GpReg, X86GpReg)
+  //! \overload
+  INST_3x(and_, kX86InstIdAnd, X86GpReg, X86GpReg, X86Mem)
+  //! \overload
+  INST_3x(and_, kX86InstIdAnd, X86GpReg, X86Mem, X86GpReg)
+  //! \overload
+  INST_3i(and_, kX86InstIdAnd, X86GpReg, X86GpReg, Imm)
+  //! \overload
+  INST_3i(and_, kX86InstIdAnd, X86GpReg, X86Mem, Imm)
+
+  //! Or to a new destination (APX).
+  INST_3x(or_, kX86InstIdOr, X86GpReg, X86GpReg, X86GpReg)
+  //! \overload
+  INST_3x(or_, kX86InstIdOr, X86GpReg, X86GpReg, X86Mem)
+  //! \overload
+  INST_3x(or_, kX86InstIdOr, X86GpReg, X86Mem, X86GpReg)
+  //! \overload
+  INST_3i(or_, kX86InstIdOr, X86GpReg, X86GpReg, Imm)
+  //! \overload
+  INST_3i(or_, kX86InstIdOr, X86GpReg, X86Mem, Imm)
+
+  //! Subtract with borrow to a new destination (APX).
+  INST_3x(sbb, kX86InstIdSbb, X86GpReg, X86GpReg, X86GpReg)
+  //! \overload
+  INST_3x(sbb, kX86InstIdSbb, X86GpReg, X86GpReg, X86Mem)
+  //! \overload
+  INST_3x(sbb, kX86InstIdSbb, X86GpReg, X86Mem, X86GpReg)
+  //! \overload
+  INST_3i(sbb, kX86InstIdSbb, X86GpReg, X86GpReg, Imm)
+  //! \overload
+  INST_3i(sbb, kX86InstIdSbb, X86GpReg, X86Mem, Imm)
+
+  //! Subtract to a new destination (APX).
+  INST_3x(sub, kX86InstIdSub, X86GpReg, X86GpReg, X86GpReg)
+  //! \overload
+  INST_3x(sub, kX86InstIdSub, X86GpReg, X86GpReg, X86Mem)
+  //! \overload
+  INST_3x(sub, kX86InstIdSub, X86GpReg, X86Mem, X86GpReg)
+  //! \overload
+  INST_3i(sub, kX86InstIdSub, X86GpReg, X86GpReg, Imm)
+  //! \overload
+  INST_3i(sub, kX86InstIdSub, X86GpReg, X86Mem, Imm)
+
+  //! Xor to a new destination (APX).
+  INST_3x(xor_, kX86InstIdXor, X86GpReg, X86GpReg, X86GpReg)
+  //! \overload
+  INST_3x(xor_, kX86InstIdXor, X86GpReg, X86GpReg, X86Mem)
+  //! \overload
+  INST_3x(xor_, kX86InstIdXor, X86GpReg, X86Mem, X86GpReg)
+  //! \overload
+  INST_3i(xor_, kX86InstIdXor, X86GpReg, X86GpReg, Imm)
+  //! \overload
+  INST_3i(xor_, kX86InstIdXor, X86GpReg, X86Mem, Imm)
+
   // --------------------------------------------------------------------------
   // [MMX]
   // --------------------------------------------------------------------------
@@ -6687,6 +6999,431 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_3i(vcvtps2ph, kX86InstIdVcvtps2ph, X86Mem, X86YmmReg, Imm)
 
+  // --------------------------------------------------------------------------
+  // [AVX_VNNI]
+  // --------------------------------------------------------------------------
+
+  //! Multiply unsigned and signed BYTEs, add quadruples to packed DWORDs.
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86YmmReg, X86YmmReg, X86Mem)
+
+  //! Multiply unsigned and signed BYTEs, add quadruples to packed DWORDs with saturation.
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86YmmReg, X86YmmReg, X86Mem)
+
+  //! Multiply signed WORDs, add pairs to packed DWORDs.
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86YmmReg, X86YmmReg, X86Mem)
+
+  //! Multiply signed WORDs, add pairs to packed DWORDs with saturation.
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86YmmReg, X86YmmReg, X86Mem)
+
+  // --------------------------------------------------------------------------
+  // [AVX512]
+  // --------------------------------------------------------------------------
+
+  // NOTE: Only ZMM forms are listed here, XMM/YMM forms are provided by AVX.
+  // EVEX prefix is used automatically if any AVX-512 option is specified, see
+  // `k()`, `z()`, `_1ToN()`, `sae()`, etc..., or if any operand is a ZMM or
+  // one of XMM16-31/YMM16-31 registers.
+
+  //! Packed DP-FP add (AVX512).
+  INST_3x(vaddpd, kX86InstIdVaddpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vaddpd, kX86InstIdVaddpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP add (AVX512).
+  INST_3x(vaddps, kX86InstIdVaddps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vaddps, kX86InstIdVaddps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP bitwise and-not (AVX512).
+  INST_3x(vandnpd, kX86InstIdVandnpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vandnpd, kX86InstIdVandnpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP bitwise and-not (AVX512).
+  INST_3x(vandnps, kX86InstIdVandnps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vandnps, kX86InstIdVandnps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP bitwise and (AVX512).
+  INST_3x(vandpd, kX86InstIdVandpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vandpd, kX86InstIdVandpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP bitwise and (AVX512).
+  INST_3x(vandps, kX86InstIdVandps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vandps, kX86InstIdVandps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Broadcast DP-FP element in `o1` to eight locations in `o0` (AVX512).
+  INST_2x(vbroadcastsd, kX86InstIdVbroadcastsd, X86ZmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vbroadcastsd, kX86InstIdVbroadcastsd, X86ZmmReg, X86Mem)
+
+  //! Broadcast SP-FP element in `o1` to sixteen locations in `o0` (AVX512).
+  INST_2x(vbroadcastss, kX86InstIdVbroadcastss, X86ZmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vbroadcastss, kX86InstIdVbroadcastss, X86ZmmReg, X86Mem)
+
+  //! Convert packed QWORDs to packed SP-FP (AVX512).
+  INST_2x(vcvtdq2ps, kX86InstIdVcvtdq2ps, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vcvtdq2ps, kX86InstIdVcvtdq2ps, X86ZmmReg, X86Mem)
+
+  //! Convert packed SP-FP to packed DWORDs (AVX512).
+  INST_2x(vcvtps2dq, kX86InstIdVcvtps2dq, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vcvtps2dq, kX86InstIdVcvtps2dq, X86ZmmReg, X86Mem)
+
+  //! Convert with truncation packed SP-FP to packed DWORDs (AVX512).
+  INST_2x(vcvttps2dq, kX86InstIdVcvttps2dq, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vcvttps2dq, kX86InstIdVcvttps2dq, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP divide (AVX512).
+  INST_3x(vdivpd, kX86InstIdVdivpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vdivpd, kX86InstIdVdivpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP divide (AVX512).
+  INST_3x(vdivps, kX86InstIdVdivps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vdivps, kX86InstIdVdivps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP fused multiply-add (AVX512).
+  INST_3x(vfmadd132pd, kX86InstIdVfmadd132pd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vfmadd132pd, kX86InstIdVfmadd132pd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP fused multiply-add (AVX512).
+  INST_3x(vfmadd132ps, kX86InstIdVfmadd132ps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vfmadd132ps, kX86InstIdVfmadd132ps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP fused multiply-add (AVX512).
+  INST_3x(vfmadd213pd, kX86InstIdVfmadd213pd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vfmadd213pd, kX86InstIdVfmadd213pd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP fused multiply-add (AVX512).
+  INST_3x(vfmadd213ps, kX86InstIdVfmadd213ps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vfmadd213ps, kX86InstIdVfmadd213ps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP fused multiply-add (AVX512).
+  INST_3x(vfmadd231pd, kX86InstIdVfmadd231pd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vfmadd231pd, kX86InstIdVfmadd231pd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP fused multiply-add (AVX512).
+  INST_3x(vfmadd231ps, kX86InstIdVfmadd231ps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vfmadd231ps, kX86InstIdVfmadd231ps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP maximum (AVX512).
+  INST_3x(vmaxpd, kX86InstIdVmaxpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmaxpd, kX86InstIdVmaxpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP maximum (AVX512).
+  INST_3x(vmaxps, kX86InstIdVmaxps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmaxps, kX86InstIdVmaxps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP minimum (AVX512).
+  INST_3x(vminpd, kX86InstIdVminpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vminpd, kX86InstIdVminpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP minimum (AVX512).
+  INST_3x(vminps, kX86InstIdVminps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vminps, kX86InstIdVminps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Move 512-bits of aligned packed DP-FP (AVX512).
+  INST_2x(vmovapd, kX86InstIdVmovapd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovapd, kX86InstIdVmovapd, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovapd, kX86InstIdVmovapd, X86Mem, X86ZmmReg)
+
+  //! Move 512-bits of aligned packed SP-FP (AVX512).
+  INST_2x(vmovaps, kX86InstIdVmovaps, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovaps, kX86InstIdVmovaps, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovaps, kX86InstIdVmovaps, X86Mem, X86ZmmReg)
+
+  //! Move 512-bits of unaligned packed DP-FP (AVX512).
+  INST_2x(vmovupd, kX86InstIdVmovupd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovupd, kX86InstIdVmovupd, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovupd, kX86InstIdVmovupd, X86Mem, X86ZmmReg)
+
+  //! Move 512-bits of unaligned packed SP-FP (AVX512).
+  INST_2x(vmovups, kX86InstIdVmovups, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovups, kX86InstIdVmovups, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovups, kX86InstIdVmovups, X86Mem, X86ZmmReg)
+
+  //! Packed DP-FP multiply (AVX512).
+  INST_3x(vmulpd, kX86InstIdVmulpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmulpd, kX86InstIdVmulpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP multiply (AVX512).
+  INST_3x(vmulps, kX86InstIdVmulps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmulps, kX86InstIdVmulps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP bitwise or (AVX512).
+  INST_3x(vorpd, kX86InstIdVorpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vorpd, kX86InstIdVorpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP bitwise or (AVX512).
+  INST_3x(vorps, kX86InstIdVorps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vorps, kX86InstIdVorps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed BYTE add (AVX512).
+  INST_3x(vpaddb, kX86InstIdVpaddb, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpaddb, kX86InstIdVpaddb, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD add (AVX512).
+  INST_3x(vpaddd, kX86InstIdVpaddd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpaddd, kX86InstIdVpaddd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD add (AVX512).
+  INST_3x(vpaddq, kX86InstIdVpaddq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpaddq, kX86InstIdVpaddq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed WORD add (AVX512).
+  INST_3x(vpaddw, kX86InstIdVpaddw, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpaddw, kX86InstIdVpaddw, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed BYTE average (AVX512).
+  INST_3x(vpavgb, kX86InstIdVpavgb, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpavgb, kX86InstIdVpavgb, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed WORD average (AVX512).
+  INST_3x(vpavgw, kX86InstIdVpavgw, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpavgw, kX86InstIdVpavgw, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD maximum (AVX512).
+  INST_3x(vpmaxsd, kX86InstIdVpmaxsd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpmaxsd, kX86InstIdVpmaxsd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD unsigned maximum (AVX512).
+  INST_3x(vpmaxud, kX86InstIdVpmaxud, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpmaxud, kX86InstIdVpmaxud, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD minimum (AVX512).
+  INST_3x(vpminsd, kX86InstIdVpminsd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpminsd, kX86InstIdVpminsd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD unsigned minimum (AVX512).
+  INST_3x(vpminud, kX86InstIdVpminud, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpminud, kX86InstIdVpminud, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD multiply low (AVX512).
+  INST_3x(vpmulld, kX86InstIdVpmulld, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpmulld, kX86InstIdVpmulld, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed WORDs multiply low (AVX512).
+  INST_3x(vpmullw, kX86InstIdVpmullw, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpmullw, kX86InstIdVpmullw, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD multiply to QWORD (AVX512).
+  INST_3x(vpmuludq, kX86InstIdVpmuludq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpmuludq, kX86InstIdVpmuludq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed BYTE shuffle (AVX512).
+  INST_3x(vpshufb, kX86InstIdVpshufb, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpshufb, kX86InstIdVpshufb, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed BYTE subtract (AVX512).
+  INST_3x(vpsubb, kX86InstIdVpsubb, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpsubb, kX86InstIdVpsubb, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD subtract (AVX512).
+  INST_3x(vpsubd, kX86InstIdVpsubd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpsubd, kX86InstIdVpsubd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD subtract (AVX512).
+  INST_3x(vpsubq, kX86InstIdVpsubq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpsubq, kX86InstIdVpsubq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed WORD subtract (AVX512).
+  INST_3x(vpsubw, kX86InstIdVpsubw, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpsubw, kX86InstIdVpsubw, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP square root (AVX512).
+  INST_2x(vsqrtpd, kX86InstIdVsqrtpd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vsqrtpd, kX86InstIdVsqrtpd, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP square root (AVX512).
+  INST_2x(vsqrtps, kX86InstIdVsqrtps, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vsqrtps, kX86InstIdVsqrtps, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP subtract (AVX512).
+  INST_3x(vsubpd, kX86InstIdVsubpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vsubpd, kX86InstIdVsubpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP subtract (AVX512).
+  INST_3x(vsubps, kX86InstIdVsubps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vsubps, kX86InstIdVsubps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Unpack and interleave high packed DP-FP (AVX512).
+  INST_3x(vunpckhpd, kX86InstIdVunpckhpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vunpckhpd, kX86InstIdVunpckhpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Unpack high packed SP-FP data (AVX512).
+  INST_3x(vunpckhps, kX86InstIdVunpckhps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vunpckhps, kX86InstIdVunpckhps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Unpack and interleave low packed DP-FP (AVX512).
+  INST_3x(vunpcklpd, kX86InstIdVunpcklpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vunpcklpd, kX86InstIdVunpcklpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Unpack low packed SP-FP data (AVX512).
+  INST_3x(vunpcklps, kX86InstIdVunpcklps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vunpcklps, kX86InstIdVunpcklps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP bitwise xor (AVX512).
+  INST_3x(vxorpd, kX86InstIdVxorpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vxorpd, kX86InstIdVxorpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP bitwise xor (AVX512).
+  INST_3x(vxorps, kX86InstIdVxorps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vxorps, kX86InstIdVxorps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  // --------------------------------------------------------------------------
+  // [AVX512_VNNI]
+  // --------------------------------------------------------------------------
+
+  // NOTE: Only ZMM forms are listed here, XMM/YMM forms are provided by AVX_VNNI
+  // and are promoted to EVEX the same way as AVX instructions are.
+
+  //! Multiply unsigned and signed BYTEs, add quadruples to packed DWORDs (AVX512).
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Multiply unsigned and signed BYTEs, add quadruples to packed DWORDs with saturation (AVX512).
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Multiply signed WORDs, add pairs to packed DWORDs (AVX512).
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Multiply signed WORDs, add pairs to packed DWORDs with saturation (AVX512).
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  // --------------------------------------------------------------------------
+  // [AVX512_BF16]
+  // --------------------------------------------------------------------------
+
+  // NOTE: These instructions have no VEX form and are always EVEX encoded.
+
+  //! Convert two packed SP-FP to packed BF16.
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Convert packed SP-FP to packed BF16.
+  //!
+  //! The vector length of a memory source is given by its size, use `oword_ptr`,
+  //! `yword_ptr`, or `zword_ptr` to select it.
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86XmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86YmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86XmmReg, X86Mem)
+  //! \overload
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86YmmReg, X86Mem)
+
+  //! Dot product of BF16 pairs accumulated into packed SP-FP.
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86ZmmReg, X86ZmmReg, X86Mem)
+
 #undef INST_0x
 
 #undef INST_1x
@@ -851,6 +851,73 @@ _OnError:
   return error;
 }
 
+// ============================================================================
+// [asmjit::X86Compiler - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+UNIT(x86_compiler_auto_align) {
+  typedef int (*Func)(int);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+
+  a.setAutoAlign(16, 32, 31);
+
+  // Function that is not called, just moves the next one.
+  c.addFunc(FuncBuilder0<int>(kCallConvHost));
+  X86GpVar x = c.newInt32("x");
+  c.mov(x, 1);
+  c.ret(x);
+  c.endFunc();
+
+  X86FuncNode* func = c.addFunc(FuncBuilder1<int, int>(kCallConvHost));
+  X86GpVar n = c.newInt32("n");
+  X86GpVar r = c.newInt32("r");
+  c.setArg(0, n);
+
+  Label L_Loop = c.newLabel();
+  Label L_Done = c.newLabel();
+
+  c.xor_(r, r);
+  c.test(n, n);
+  c.jz(L_Done);
+
+  c.bind(L_Loop);
+  c.add(r, 3);
+  c.dec(n);
+  c.jnz(L_Loop);
+
+  c.bind(L_Done);
+  c.ret(r);
+  c.endFunc();
+
+  Label L_Func = func->getEntryLabel();
+  EXPECT(c.finalize() == kErrorOk,
+    "Compilation failed.");
+
+  intptr_t funcOffset = a.getLabelOffset(L_Func);
+  intptr_t loopOffset = a.getLabelOffset(L_Loop);
+
+  EXPECT(funcOffset != 0 && (funcOffset & 15) == 0,
+    "Function entry should be aligned to 16, offset %d.", static_cast<int>(funcOffset));
+  EXPECT((loopOffset & 31) == 0,
+    "Loop head should be aligned to 32, offset %d.", static_cast<int>(loopOffset));
+
+  uint8_t* base = static_cast<uint8_t*>(a.make());
+  EXPECT(base != nullptr,
+    "Couldn't make the function.");
+
+  Func fn = asmjit_cast<Func>(base + funcOffset);
+  int result = fn(5);
+  EXPECT(result == 15,
+    "Function returned %d instead of 15.", result);
+
+  runtime.release(base);
+}
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+
 } // asmjit namespace
 
 // [Api-End]
@@ -7461,6 +7461,75 @@ class ASMJIT_VIRTAPI X86Compiler : public Compiler {
   //! \overload
   INST_3i(vcvtps2ph, kX86InstIdVcvtps2ph, X86Mem, X86YmmVar, Imm)
 
+  // --------------------------------------------------------------------------
+  // [AVX_VNNI]
+  // --------------------------------------------------------------------------
+
+  //! Multiply unsigned and signed BYTEs, add quadruples to packed DWORDs.
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86XmmVar, X86XmmVar, X86XmmVar)
+  //! \overload
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86XmmVar, X86XmmVar, X86Mem)
+  //! \overload
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86YmmVar, X86YmmVar, X86YmmVar)
+  //! \overload
+  INST_3x(vpdpbusd, kX86InstIdVpdpbusd, X86YmmVar, X86YmmVar, X86Mem)
+
+  //! Multiply unsigned and signed BYTEs, add quadruples to packed DWORDs with saturation.
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86XmmVar, X86XmmVar, X86XmmVar)
+  //! \overload
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86XmmVar, X86XmmVar, X86Mem)
+  //! \overload
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86YmmVar, X86YmmVar, X86YmmVar)
+  //! \overload
+  INST_3x(vpdpbusds, kX86InstIdVpdpbusds, X86YmmVar, X86YmmVar, X86Mem)
+
+  //! Multiply signed WORDs, add pairs to packed DWORDs.
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86XmmVar, X86XmmVar, X86XmmVar)
+  //! \overload
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86XmmVar, X86XmmVar, X86Mem)
+  //! \overload
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86YmmVar, X86YmmVar, X86YmmVar)
+  //! \overload
+  INST_3x(vpdpwssd, kX86InstIdVpdpwssd, X86YmmVar, X86YmmVar, X86Mem)
+
+  //! Multiply signed WORDs, add pairs to packed DWORDs with saturation.
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86XmmVar, X86XmmVar, X86XmmVar)
+  //! \overload
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86XmmVar, X86XmmVar, X86Mem)
+  //! \overload
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86YmmVar, X86YmmVar, X86YmmVar)
+  //! \overload
+  INST_3x(vpdpwssds, kX86InstIdVpdpwssds, X86YmmVar, X86YmmVar, X86Mem)
+
+  // --------------------------------------------------------------------------
+  // [AVX512_BF16]
+  // --------------------------------------------------------------------------
+
+  //! Convert two packed SP-FP to packed BF16.
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86XmmVar, X86XmmVar, X86XmmVar)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86XmmVar, X86XmmVar, X86Mem)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86YmmVar, X86YmmVar, X86YmmVar)
+  //! \overload
+  INST_3x(vcvtne2ps2bf16, kX86InstIdVcvtne2ps2bf16, X86YmmVar, X86YmmVar, X86Mem)
+
+  //! Convert packed SP-FP to packed BF16.
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86XmmVar, X86XmmVar)
+  //! \overload
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86XmmVar, X86YmmVar)
+  //! \overload
+  INST_2x(vcvtneps2bf16, kX86InstIdVcvtneps2bf16, X86XmmVar, X86Mem)
+
+  //! Dot product of BF16 pairs accumulated into packed SP-FP.
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86XmmVar, X86XmmVar, X86XmmVar)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86XmmVar, X86XmmVar, X86Mem)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86YmmVar, X86YmmVar, X86YmmVar)
+  //! \overload
+  INST_3x(vdpbf16ps, kX86InstIdVdpbf16ps, X86YmmVar, X86YmmVar, X86Mem)
+
   // --------------------------------------------------------------------------
   // [Cleanup]
   // --------------------------------------------------------------------------
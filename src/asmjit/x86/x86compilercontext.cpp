@@ -5679,10 +5679,49 @@ _Done:
 // [asmjit::X86Context - Serialize]
 // ============================================================================
 
+//! \internal
+ASMJIT_ENUM(X86LabelState) {
+  //! Label has been bound.
+  kX86LabelStateBound = 0x01,
+  //! Label is a target of a backward jump.
+  kX86LabelStateLoop = 0x02
+};
+
+//! \internal
+//!
+//! Find labels between `start` and `stop` that are targets of backward jumps
+//! (loop heads), `state` is indexed by label id.
+static void X86Context_markLoops(uint8_t* state, HLNode* start, HLNode* stop) {
+  for (HLNode* node_ = start; node_ != stop; node_ = node_->getNext()) {
+    if (node_->getType() == HLNode::kTypeLabel) {
+      state[static_cast<HLLabel*>(node_)->getLabelId()] |= kX86LabelStateBound;
+    }
+    else if (node_->getType() == HLNode::kTypeInst && node_->isJmpOrJcc()) {
+      HLLabel* target = static_cast<HLJump*>(node_)->getTarget();
+      if (target != nullptr && (state[target->getLabelId()] & kX86LabelStateBound))
+        state[target->getLabelId()] |= kX86LabelStateLoop;
+    }
+  }
+}
+
 Error X86Context::serialize(Assembler* assembler_, HLNode* start, HLNode* stop) {
   X86Assembler* assembler = static_cast<X86Assembler*>(assembler_);
   HLNode* node_ = start;
 
+  // Automatic alignment of the function entry and loop heads.
+  HLLabel* funcEntry = nullptr;
+  uint8_t* labelState = nullptr;
+
+  if (start->getType() == HLNode::kTypeFunc && assembler->getFuncAlign() > 1)
+    funcEntry = static_cast<HLFunc*>(start)->getEntryNode();
+
+  if (assembler->getLoopAlign() > 1) {
+    labelState = _zoneAllocator.allocZeroedT<uint8_t>(assembler->getLabelsCount());
+    if (labelState == nullptr)
+      return kErrorNoHeapMemory;
+    X86Context_markLoops(labelState, start, stop);
+  }
+
 #if !defined(ASMJIT_DISABLE_LOGGER)
   Logger* logger = assembler->getLogger();
 #endif // !ASMJIT_DISABLE_LOGGER
@@ -5725,7 +5764,13 @@ Error X86Context::serialize(Assembler* assembler_, HLNode* start, HLNode* stop)
 
       case HLNode::kTypeLabel: {
         HLLabel* node = static_cast<HLLabel*>(node_);
-        assembler->bind(node->getLabel());
+
+        if (node == funcEntry)
+          assembler->bindFunc(node->getLabel());
+        else if (labelState != nullptr && (labelState[node->getLabelId()] & kX86LabelStateLoop))
+          assembler->bindLoop(node->getLabel());
+        else
+          assembler->bind(node->getLabel());
         break;
       }
 
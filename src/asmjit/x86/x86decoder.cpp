@@ -0,0 +1,2348 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Export]
+#define ASMJIT_EXPORTS
+
+// [Guard]
+#include "../build.h"
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+
+// [Dependencies]
+#include "../base/utils.h"
+#include "../x86/x86assembler.h"
+#include "../x86/x86decoder.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+// ============================================================================
+// [asmjit::X86Decoder - Enums]
+// ============================================================================
+
+//! \internal
+//!
+//! Length of the instruction after the opcode byte.
+ASMJIT_ENUM(X86DecoderLen) {
+  kX86DecoderLenN        = 0,            //!< Nothing.
+  kX86DecoderLenM        = 1,            //!< ModR/M.
+  kX86DecoderLenB        = 2,            //!< Imm8.
+  kX86DecoderLenMB       = 3,            //!< ModR/M and imm8.
+  kX86DecoderLenZ        = 4,            //!< Imm16 or imm32 (operand size).
+  kX86DecoderLenMZ       = 5,            //!< ModR/M and imm16 or imm32.
+  kX86DecoderLenV        = 6,            //!< Imm16, imm32, or imm64 (`mov r, imm`).
+  kX86DecoderLenO        = 7,            //!< Absolute address (address size).
+  kX86DecoderLenW        = 8,            //!< Imm16.
+  kX86DecoderLenE        = 9,            //!< Imm16 and imm8 (`enter`).
+  kX86DecoderLenF        = 10,           //!< Far pointer (X86 only).
+  kX86DecoderLenJ        = 11,           //!< Rel8.
+  kX86DecoderLenJZ       = 12,           //!< Rel16 or rel32.
+  kX86DecoderLenG8       = 13,           //!< ModR/M and imm8 if `/0` or `/1` (group 3).
+  kX86DecoderLenGZ       = 14,           //!< ModR/M and imm16/32 if `/0` or `/1` (group 3).
+  kX86DecoderLenMD       = 15,           //!< ModR/M and imm32 (XOP map 10).
+  kX86DecoderLenEsc      = 16,           //!< Escape to another opcode map.
+  kX86DecoderLenInvalid  = 17,           //!< Invalid opcode.
+
+  kX86DecoderLenMask     = 0x1F,         //!< Mask of the length.
+  kX86DecoderLenNo64     = 0x80          //!< Invalid in 64-bit mode.
+};
+
+//! \internal
+//!
+//! Opcode spaces, each has its own table of pattern chains.
+ASMJIT_ENUM(X86DecoderSpace) {
+  kX86DecoderSpaceLegacy = 0,            //!< Legacy map 0.
+  kX86DecoderSpace0F     = 1,            //!< Legacy map 1 (0F).
+  kX86DecoderSpace0F38   = 2,            //!< Legacy map 2 (0F 38).
+  kX86DecoderSpace0F3A   = 3,            //!< Legacy map 3 (0F 3A).
+  kX86DecoderSpace3dNow  = 4,            //!< 3dNow (0F 0F), indexed by the suffix.
+  kX86DecoderSpaceVex    = 4,            //!< VEX map 1..3 (added to the map).
+  kX86DecoderSpaceXop    = 0,            //!< XOP map 8..10 (added to the map).
+  kX86DecoderSpaceEvex   = 10,           //!< EVEX map 1..3 (added to the map).
+  kX86DecoderSpaceApx    = 14            //!< EVEX map 4 (APX promoted legacy).
+};
+
+//! \internal
+//!
+//! Kind of the instruction prefix.
+ASMJIT_ENUM(X86DecoderKind) {
+  kX86DecoderKindLegacy  = 0,            //!< No prefix or REX.
+  kX86DecoderKindRex2    = 1,            //!< REX2.
+  kX86DecoderKindVex2    = 2,            //!< 2-byte VEX.
+  kX86DecoderKindVex3    = 3,            //!< 3-byte VEX.
+  kX86DecoderKindXop     = 4,            //!< XOP.
+  kX86DecoderKindEvex    = 5,            //!< EVEX (AVX-512).
+  kX86DecoderKindApx     = 6             //!< EVEX map 4 (APX).
+};
+
+//! \internal
+//!
+//! Instruction prefixes, also used as mandatory prefixes of patterns.
+ASMJIT_ENUM(X86DecoderPrefix) {
+  kX86DecoderPrefix66    = 0x01,         //!< Operand size or mandatory 66.
+  kX86DecoderPrefixF3    = 0x02,         //!< REP or mandatory F3.
+  kX86DecoderPrefixF2    = 0x04,         //!< REPNE or mandatory F2.
+  kX86DecoderPrefix9B    = 0x08,         //!< FWAIT (FPU instructions only).
+  kX86DecoderPrefixF0    = 0x10,         //!< LOCK.
+  kX86DecoderPrefix67    = 0x20          //!< Address size.
+};
+
+//! \internal
+//!
+//! Pattern flags.
+ASMJIT_ENUM(X86DecoderFlags) {
+  kX86DecoderFlagW       = 0x01,         //!< Requires REX.W or VEX/EVEX.W.
+  kX86DecoderFlagL       = 0x02,         //!< Requires VEX.L.
+  kX86DecoderFlagReg     = 0x04,         //!< Requires ModR/M with a register.
+  kX86DecoderFlagMem     = 0x08,         //!< Requires ModR/M with a memory.
+  kX86DecoderFlagNotNop  = 0x10,         //!< Requires REX.B, REX.W or 66 (`xchg` is not `nop`).
+
+  kX86DecoderFlagAddO    = 0x100         //!< Builder only - match `/O` of the opcode.
+};
+
+//! \internal
+//!
+//! Operand layout of a pattern.
+ASMJIT_ENUM(X86DecoderForm) {
+  kX86DecoderFormNone = 0,               //!< No operands.
+
+  kX86DecoderFormGpRm,                   //!< [R|M].
+  kX86DecoderFormGpRmReg,                //!< [R|M, R].
+  kX86DecoderFormGpRegRm,                //!< [R, R|M].
+  kX86DecoderFormGpRmImm,                //!< [R|M, Imm].
+  kX86DecoderFormGpAccImm,               //!< [Acc, Imm].
+  kX86DecoderFormGpRmOne,                //!< [R|M, 1].
+  kX86DecoderFormGpRmCl,                 //!< [R|M, CL].
+  kX86DecoderFormGpRegRmImm,             //!< [R, R|M, Imm].
+  kX86DecoderFormGpRmRegImm,             //!< [R|M, R, Imm].
+  kX86DecoderFormGpRmRegCl,              //!< [R|M, R, CL].
+  kX86DecoderFormGpOpReg,                //!< [Opcode+R].
+  kX86DecoderFormGpOpRegImm,             //!< [Opcode+R, Imm].
+  kX86DecoderFormGpAccOpReg,             //!< [Acc, Opcode+R].
+  kX86DecoderFormGpAccMoffs,             //!< [Acc, Moffs].
+  kX86DecoderFormGpMoffsAcc,             //!< [Moffs, Acc].
+  kX86DecoderFormGpRegRmSrc,             //!< [R, R|M], `data` is the size of the source.
+  kX86DecoderFormSegRm,                  //!< [Seg, R|M].
+  kX86DecoderFormRmSeg,                  //!< [R|M, Seg].
+  kX86DecoderFormSeg,                    //!< [Seg], `data` is the segment.
+  kX86DecoderFormImm,                    //!< [Imm].
+  kX86DecoderFormImmConst,               //!< [Imm], `data` is the immediate.
+  kX86DecoderFormRel,                    //!< [Target].
+  kX86DecoderFormCxRel,                  //!< [CX|ECX|RCX, Target].
+  kX86DecoderFormEnter,                  //!< [Imm8, Imm16].
+  kX86DecoderFormMem,                    //!< [M], `data` is the size of the memory.
+  kX86DecoderFormPrefetch,               //!< [M, Hint].
+  kX86DecoderFormFpSt,                   //!< [St(i)].
+  kX86DecoderFormFpSt0StI,               //!< [St(0), St(i)].
+  kX86DecoderFormFpStISt0,               //!< [St(i), St(0)].
+  kX86DecoderFormFpAx,                   //!< [AX].
+
+  kX86DecoderFormRegRm,                  //!< [R, R|M].
+  kX86DecoderFormRmReg,                  //!< [R|M, R].
+  kX86DecoderFormRegRmImm,               //!< [R, R|M, Imm].
+  kX86DecoderFormRmRegImm,               //!< [R|M, R, Imm].
+  kX86DecoderFormRmImm,                  //!< [R|M, Imm].
+  kX86DecoderFormRegImm2,                //!< [R, Imm, Imm] (extrq).
+  kX86DecoderFormRegRmImm2,              //!< [R, R, Imm, Imm] (insertq).
+  kX86DecoderFormRegVvvvRm,              //!< [R, V, R|M].
+  kX86DecoderFormRegVvvvRmIs4,           //!< [R, V, R|M, Is4].
+  kX86DecoderFormRegVvvvRmImm,           //!< [R, V, R|M, Imm].
+  kX86DecoderFormRegRmVvvv,              //!< [R, R|M, V].
+  kX86DecoderFormRegRmVvvvImm,           //!< [R, R|M, V, Imm].
+  kX86DecoderFormRmVvvvReg,              //!< [M, V, R].
+  kX86DecoderFormVvvvRm,                 //!< [V, R|M].
+  kX86DecoderFormVvvvRmImm,              //!< [V, R|M, Imm].
+  kX86DecoderFormFma4,                   //!< [R, V, R|M, Is4] (W0) or [R, V, Is4, R|M] (W1).
+  kX86DecoderFormXopRmv,                 //!< [R, R|M, V] (W0) or [R, V, R|M] (W1).
+  kX86DecoderFormGather                  //!< [R, VSIB, V], `data` is non-zero if the index is wider.
+};
+
+//! \internal
+//!
+//! Form data of GP forms.
+ASMJIT_ENUM(X86DecoderData) {
+  kX86DecoderDataByte    = 0x01,         //!< Operand size is 8 bits.
+  kX86DecoderDataNative  = 0x02,         //!< Operand size is 16 bits or native (push, pop, call, jmp).
+  kX86DecoderDataImmSx   = 0x04          //!< Sign-extend the 8-bit immediate.
+};
+
+//! \internal
+//!
+//! Register class of a SIMD operand (form data, 4 bits per operand).
+ASMJIT_ENUM(X86DecoderClass) {
+  kX86DecoderClassAuto   = 0,            //!< Given by `X86InstExtendedInfo` operand flags.
+  kX86DecoderClassGp     = 1,            //!< GPD or GPQ (by W).
+  kX86DecoderClassMm     = 2,            //!< MM.
+  kX86DecoderClassXmm    = 3,            //!< XMM.
+  kX86DecoderClassMmXmm  = 4             //!< MM or XMM (by 66 prefix).
+};
+
+#define X86_DECODER_CLASS(c0, c1) ((kX86DecoderClass##c0) | (kX86DecoderClass##c1 << 4))
+
+// ============================================================================
+// [asmjit::X86Decoder - Tables]
+// ============================================================================
+
+#define N  kX86DecoderLenN
+#define M  kX86DecoderLenM
+#define B  kX86DecoderLenB
+#define MB kX86DecoderLenMB
+#define Z  kX86DecoderLenZ
+#define MZ kX86DecoderLenMZ
+#define V  kX86DecoderLenV
+#define O  kX86DecoderLenO
+#define W  kX86DecoderLenW
+#define E  kX86DecoderLenE
+#define J  kX86DecoderLenJ
+#define JZ kX86DecoderLenJZ
+#define G8 kX86DecoderLenG8
+#define GZ kX86DecoderLenGZ
+#define ES kX86DecoderLenEsc
+#define NX (kX86DecoderLenN  | kX86DecoderLenNo64)
+#define MX (kX86DecoderLenM  | kX86DecoderLenNo64)
+#define BX (kX86DecoderLenB  | kX86DecoderLenNo64)
+#define FX (kX86DecoderLenF  | kX86DecoderLenNo64)
+#define MBX (kX86DecoderLenMB | kX86DecoderLenNo64)
+
+//! \internal
+//!
+//! Length of legacy map 0 instructions.
+static const uint8_t x86DecoderLenMap0[256] = {
+  M , M , M , M , B , Z , NX, NX, M , M , M , M , B , Z , NX, ES, // 0x00
+  M , M , M , M , B , Z , NX, NX, M , M , M , M , B , Z , NX, NX, // 0x10
+  M , M , M , M , B , Z , N , NX, M , M , M , M , B , Z , N , NX, // 0x20
+  M , M , M , M , B , Z , N , NX, M , M , M , M , B , Z , N , NX, // 0x30
+  N , N , N , N , N , N , N , N , N , N , N , N , N , N , N , N , // 0x40
+  N , N , N , N , N , N , N , N , N , N , N , N , N , N , N , N , // 0x50
+  NX, NX, MX, M , N , N , N , N , Z , MZ, B , MB, N , N , N , N , // 0x60
+  J , J , J , J , J , J , J , J , J , J , J , J , J , J , J , J , // 0x70
+  MB, MZ, MBX,MB, M , M , M , M , M , M , M , M , M , M , M , M , // 0x80
+  N , N , N , N , N , N , N , N , N , N , FX, N , N , N , N , N , // 0x90
+  O , O , O , O , N , N , N , N , B , Z , N , N , N , N , N , N , // 0xA0
+  B , B , B , B , B , B , B , B , V , V , V , V , V , V , V , V , // 0xB0
+  MB, MB, W , N , MX, MX, MB, MZ, E , N , W , N , N , B , NX, N , // 0xC0
+  M , M , M , M , BX, BX, NX, N , M , M , M , M , M , M , M , M , // 0xD0
+  J , J , J , J , B , B , B , B , JZ, JZ, FX, J , N , N , N , N , // 0xE0
+  N , N , N , N , N , N , G8, GZ, N , N , N , N , N , N , M , M   // 0xF0
+};
+
+//! \internal
+//!
+//! Length of legacy map 1 (0F) instructions.
+static const uint8_t x86DecoderLenMap1[256] = {
+  M , M , M , M , N , N , N , N , N , N , N , N , N , M , N , MB, // 0x00
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0x10
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0x20
+  N , N , N , N , N , N , N , N , ES, N , ES, N , N , N , N , N , // 0x30
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0x40
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0x50
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0x60
+  MB, MB, MB, MB, M , M , M , N , M , M , M , M , M , M , M , M , // 0x70
+  JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, JZ, // 0x80
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0x90
+  N , N , N , M , MB, M , N , N , N , N , N , M , MB, M , M , M , // 0xA0
+  M , M , M , M , M , M , M , M , M , M , MB, M , M , M , M , M , // 0xB0
+  M , M , MB, M , MB, MB, MB, M , N , N , N , N , N , N , N , N , // 0xC0
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0xD0
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , // 0xE0
+  M , M , M , M , M , M , M , M , M , M , M , M , M , M , M , M   // 0xF0
+};
+
+#undef MBX
+#undef FX
+#undef BX
+#undef MX
+#undef NX
+#undef ES
+#undef GZ
+#undef G8
+#undef JZ
+#undef J
+#undef E
+#undef W
+#undef O
+#undef V
+#undef MZ
+#undef Z
+#undef MB
+#undef B
+#undef M
+#undef N
+
+//! \internal
+//!
+//! Mandatory prefixes indexed by the `PP` field of the opcode.
+static const uint8_t x86DecoderPrefixFromPP[8] = {
+  0, kX86DecoderPrefix66, kX86DecoderPrefixF3, kX86DecoderPrefixF2, 0, 0, 0, kX86DecoderPrefix9B
+};
+
+//! \internal
+//!
+//! Segment registers indexed by a segment override prefix (`(prefix >> 3) & 3`
+//! of 26, 2E, 36, 3E).
+static const uint8_t x86DecoderSegFromPrefix[4] = {
+  kX86SegEs, kX86SegCs, kX86SegSs, kX86SegDs
+};
+
+//! \internal
+//!
+//! Size of a register indexed by its type (`type >> 4`).
+static const uint8_t x86DecoderRegSize[16] = {
+  1, 2, 4, 8, 10, 8, 8, 16, 32, 64, 0, 0, 0, 0, 0, 2
+};
+
+//! \internal
+//!
+//! 16-bit addressing, base and index of each `rm` (`0xFF` if none).
+static const uint8_t x86DecoderAddr16[8][2] = {
+  { kX86RegIndexBx, kX86RegIndexSi }, { kX86RegIndexBx, kX86RegIndexDi },
+  { kX86RegIndexBp, kX86RegIndexSi }, { kX86RegIndexBp, kX86RegIndexDi },
+  { kX86RegIndexSi, 0xFF           }, { kX86RegIndexDi, 0xFF           },
+  { kX86RegIndexBp, 0xFF           }, { kX86RegIndexBx, 0xFF           }
+};
+
+// ============================================================================
+// [asmjit::X86Decoder - State]
+// ============================================================================
+
+//! \internal
+//!
+//! Instruction parsed by `x86DecoderParse()`.
+struct X86DecoderState {
+  //! Kind of the prefix, see \ref X86DecoderKind.
+  uint32_t kind;
+  //! Opcode space, see \ref X86DecoderSpace.
+  uint32_t space;
+  //! Opcode byte (or 3dNow suffix).
+  uint32_t opCode;
+  //! Prefixes, see \ref X86DecoderPrefix (including VEX/EVEX `pp`).
+  uint32_t prefixes;
+  //! Segment override, see \ref X86Seg.
+  uint32_t segment;
+  //! REX prefix, zero if not present.
+  uint32_t rex;
+  //! REX2 / VEX / EVEX payload that can't be derived from the fields below
+  //! (REX2 payload or the map of 3-byte VEX).
+  uint32_t payload;
+
+  //! REX.W or VEX/EVEX.W.
+  uint32_t w;
+  //! VEX.L or EVEX.L'L.
+  uint32_t l;
+  //! Extension of ModR/M.reg (0, 8, 16, or 24).
+  uint32_t rExt;
+  //! Extension of SIB.index (0, 8, 16, or 24).
+  uint32_t xExt;
+  //! Extension of ModR/M.rm, SIB.base, or opcode register (0, 8, 16, or 24).
+  uint32_t bExt;
+  //! Extension of ModR/M.rm if it's a register (EVEX uses X instead of B4).
+  uint32_t rmExt;
+  //! VEX/EVEX.vvvv (including V').
+  uint32_t vvvv;
+  //! EVEX.aaa.
+  uint32_t aaa;
+  //! EVEX.z.
+  uint32_t z;
+  //! EVEX.b.
+  uint32_t b;
+  //! APX new data destination.
+  uint32_t nd;
+  //! APX no flags.
+  uint32_t nf;
+
+  //! Whether the instruction has ModR/M byte.
+  uint32_t hasModRm;
+  //! ModR/M byte.
+  uint32_t modRm;
+  //! SIB byte (valid only if used).
+  uint32_t sib;
+  //! Address size (2, 4, or 8).
+  uint32_t addrSize;
+
+  //! Displacement (or relative target) offset.
+  uint32_t dispOffset;
+  //! Displacement (or relative target) size.
+  uint32_t dispSize;
+  //! Immediate offset.
+  uint32_t immOffset;
+  //! Immediate size.
+  uint32_t immSize;
+  //! Instruction size.
+  uint32_t size;
+};
+
+// ============================================================================
+// [asmjit::X86Decoder - Parse]
+// ============================================================================
+
+//! \internal
+//!
+//! Get whether `9B` at `p[i]` is a prefix of a `9B` FPU instruction (`fsave`,
+//! `fstcw`, `fstenv`, `fstsw`, `fclex`, and `finit`), it's `fwait` otherwise.
+static ASMJIT_INLINE bool x86DecoderIsFwaitPrefix(uint32_t arch, const uint8_t* p, uint32_t i, uint32_t limit) noexcept {
+  i++;
+  if (arch == kArchX64 && i < limit && (p[i] & 0xF0) == 0x40)
+    i++;
+
+  if (i + 1 >= limit)
+    return false;
+
+  uint32_t op = p[i];
+  uint32_t modRm = p[i + 1];
+
+  if (op == 0xD9 || op == 0xDD)
+    return modRm < 0xC0 && ((modRm >> 3) & 0x7) >= 6;
+
+  if (op == 0xDB)
+    return modRm == 0xE2 || modRm == 0xE3;
+
+  if (op == 0xDF)
+    return modRm == 0xE0;
+
+  return false;
+}
+
+//! \internal
+//!
+//! Parse prefixes, opcode, ModR/M, SIB, displacement and immediate of the
+//! instruction at `p`. Doesn't need the patterns, so it's shared by `decode()`
+//! and `getLength()`.
+static Error x86DecoderParse(X86DecoderState& s, uint32_t arch, const uint8_t* p, size_t size) noexcept {
+  uint32_t limit = static_cast<uint32_t>(Utils::iMin<size_t>(size, 15));
+  uint32_t i = 0;
+
+  ::memset(&s, 0, sizeof(X86DecoderState));
+  s.addrSize = arch == kArchX64 ? 8 : 4;
+
+  // --------------------------------------------------------------------------
+  // [Legacy Prefixes]
+  // --------------------------------------------------------------------------
+
+  for (;;) {
+    if (i >= limit)
+      return kErrorIllegalInst;
+
+    uint32_t c = p[i];
+    uint32_t prefix = 0;
+
+    switch (c) {
+      case 0x66: prefix = kX86DecoderPrefix66; break;
+      case 0x67: prefix = kX86DecoderPrefix67; break;
+      case 0xF0: prefix = kX86DecoderPrefixF0; break;
+      case 0xF2: prefix = kX86DecoderPrefixF2; break;
+      case 0xF3: prefix = kX86DecoderPrefixF3; break;
+
+      case 0x26:
+      case 0x2E:
+      case 0x36:
+      case 0x3E:
+        s.segment = x86DecoderSegFromPrefix[(c >> 3) & 0x3];
+        break;
+
+      case 0x64: s.segment = kX86SegFs; break;
+      case 0x65: s.segment = kX86SegGs; break;
+
+      case 0x9B:
+        if (!x86DecoderIsFwaitPrefix(arch, p, i, limit))
+          goto _Opcode;
+        prefix = kX86DecoderPrefix9B;
+        break;
+
+      default:
+        // REX must be the last prefix, it's ignored otherwise.
+        if (arch == kArchX64 && (c & 0xF0) == 0x40) {
+          s.rex = c;
+          i++;
+          continue;
+        }
+        goto _Opcode;
+    }
+
+    s.prefixes |= prefix;
+    s.rex = 0;
+    i++;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Opcode]
+  // --------------------------------------------------------------------------
+
+_Opcode:
+  {
+    uint32_t c = p[i];
+    uint32_t next = i + 1 < limit ? p[i + 1] : 0;
+    uint32_t len;
+
+    if (s.rex != 0) {
+      s.w    = (s.rex >> 3) & 0x1;
+      s.rExt = (s.rex << 1) & 0x8;
+      s.xExt = (s.rex << 2) & 0x8;
+      s.bExt = (s.rex << 3) & 0x8;
+    }
+
+    if (arch == kArchX64 && c == 0xD5) {
+      // REX2 - [M0 R4 X4 B4 W R3 X3 B3].
+      if (s.rex != 0 || i + 2 >= limit)
+        return kErrorIllegalInst;
+
+      s.kind = kX86DecoderKindRex2;
+      s.payload = next;
+      s.w    = (next >> 3) & 0x1;
+      s.rExt = ((next << 1) & 0x08) | ((next >> 2) & 0x10);
+      s.xExt = ((next << 2) & 0x08) | ((next >> 1) & 0x10);
+      s.bExt = ((next << 3) & 0x08) | ((next     ) & 0x10);
+      s.space = next >> 7;
+
+      i += 2;
+      s.opCode = p[i++];
+      len = s.space == kX86DecoderSpaceLegacy ? x86DecoderLenMap0[s.opCode] : x86DecoderLenMap1[s.opCode];
+
+      if ((len & kX86DecoderLenMask) == kX86DecoderLenEsc)
+        return kErrorIllegalInst;
+    }
+    else if ((c == 0xC4 || c == 0xC5 || c == 0x62 || (c == 0x8F && (next & 0x1F) >= 8)) &&
+             (arch == kArchX64 || (next & 0xC0) == 0xC0)) {
+      // VEX, XOP, and EVEX can't be combined with 66, F2, F3, LOCK, and REX.
+      if ((s.prefixes & (kX86DecoderPrefix66 | kX86DecoderPrefixF2 | kX86DecoderPrefixF3 | kX86DecoderPrefixF0)) != 0 || s.rex != 0)
+        return kErrorIllegalInst;
+
+      uint32_t map;
+      uint32_t pp;
+
+      if (c == 0xC5) {
+        // VEX2 - [R vvvv L pp].
+        if (i + 2 >= limit)
+          return kErrorIllegalInst;
+
+        s.kind = kX86DecoderKindVex2;
+        s.rExt = (~next >> 4) & 0x8;
+        s.vvvv = (~next >> 3) & 0xF;
+        s.l    = (next >> 2) & 0x1;
+        pp     = next & 0x3;
+        map    = 1;
+        i += 2;
+      }
+      else if (c != 0x62) {
+        // VEX3 / XOP - [R X B mmmmm] [W vvvv L pp].
+        if (i + 3 >= limit)
+          return kErrorIllegalInst;
+
+        uint32_t v2 = p[i + 2];
+
+        s.kind = c == 0xC4 ? kX86DecoderKindVex3 : kX86DecoderKindXop;
+        s.payload = next;
+        s.rExt = (~next >> 4) & 0x8;
+        s.xExt = (~next >> 3) & 0x8;
+        s.bExt = (~next >> 2) & 0x8;
+        s.w    = (v2 >> 7) & 0x1;
+        s.vvvv = (~v2 >> 3) & 0xF;
+        s.l    = (v2 >> 2) & 0x1;
+        pp     = v2 & 0x3;
+        map    = next & 0x1F;
+        i += 3;
+
+        if (s.kind == kX86DecoderKindVex3 ? (map < 1 || map > 3) : (map > 10))
+          return kErrorIllegalInst;
+      }
+      else {
+        // EVEX - [R X B R' B4 mmm] [W vvvv X4 pp] [z L'L b V' aaa].
+        if (i + 4 >= limit)
+          return kErrorIllegalInst;
+
+        uint32_t p1 = p[i + 2];
+        uint32_t p2 = p[i + 3];
+
+        map    = next & 0x7;
+        s.rExt = ((~next >> 4) & 0x08) | (~next & 0x10);
+        s.xExt = ((~next >> 3) & 0x08) | ((~p1 << 2) & 0x10);
+        s.bExt = ((~next >> 2) & 0x08) | ((next << 1) & 0x10);
+        s.w    = (p1 >> 7) & 0x1;
+        s.vvvv = ((~p1 >> 3) & 0xF) | ((~p2 << 1) & 0x10);
+        pp     = p1 & 0x3;
+        i += 4;
+
+        if (map == 4) {
+          // APX - [0 0 0 ND V4 NF 0 0], B4 extends both the base and `rm`.
+          s.kind  = kX86DecoderKindApx;
+          s.nd    = (p2 >> 4) & 0x1;
+          s.nf    = (p2 >> 2) & 0x1;
+          s.rmExt = s.bExt;
+        }
+        else {
+          if (map < 1 || map > 3)
+            return kErrorIllegalInst;
+
+          s.kind  = kX86DecoderKindEvex;
+          s.z     = (p2 >> 7) & 0x1;
+          s.l     = (p2 >> 5) & 0x3;
+          s.b     = (p2 >> 4) & 0x1;
+          s.aaa   = p2 & 0x7;
+          s.rmExt = (s.bExt & 0x08) | ((~next >> 2) & 0x10);
+        }
+      }
+
+      if (arch != kArchX64) {
+        s.rExt = 0;
+        s.xExt = 0;
+        s.bExt = 0;
+        s.rmExt = 0;
+        s.vvvv &= 0x7;
+      }
+
+      s.prefixes |= x86DecoderPrefixFromPP[pp];
+      s.opCode = p[i++];
+
+      switch (s.kind) {
+        case kX86DecoderKindVex2:
+        case kX86DecoderKindVex3:
+        case kX86DecoderKindEvex:
+          s.space = (s.kind == kX86DecoderKindEvex ? kX86DecoderSpaceEvex : kX86DecoderSpaceVex) + map;
+          if (map == 1)
+            len = s.opCode == 0x77 ? kX86DecoderLenN :
+                  x86DecoderLenMap1[s.opCode] == kX86DecoderLenMB ? kX86DecoderLenMB : kX86DecoderLenM;
+          else
+            len = map == 3 ? kX86DecoderLenMB : kX86DecoderLenM;
+          break;
+
+        case kX86DecoderKindXop:
+          s.space = kX86DecoderSpaceXop + map;
+          len = map == 8 ? kX86DecoderLenMB :
+                map == 9 ? kX86DecoderLenM  : kX86DecoderLenMD;
+          break;
+
+        default:
+          s.space = kX86DecoderSpaceApx;
+          len = x86DecoderLenMap0[s.opCode] & kX86DecoderLenMask;
+          if (len == kX86DecoderLenB || len == kX86DecoderLenMB || s.opCode == 0x24 || s.opCode == 0x2C)
+            len = kX86DecoderLenMB;
+          else if (len == kX86DecoderLenZ || len == kX86DecoderLenMZ)
+            len = kX86DecoderLenMZ;
+          else if (len != kX86DecoderLenG8 && len != kX86DecoderLenGZ)
+            len = kX86DecoderLenM;
+          break;
+      }
+    }
+    else {
+      i++;
+      s.opCode = c;
+      len = x86DecoderLenMap0[c];
+
+      if (c == 0x0F) {
+        if (i >= limit)
+          return kErrorIllegalInst;
+
+        c = p[i++];
+        s.opCode = c;
+        s.space = kX86DecoderSpace0F;
+        len = x86DecoderLenMap1[c];
+
+        if (c == 0x38 || c == 0x3A) {
+          if (i >= limit)
+            return kErrorIllegalInst;
+
+          s.opCode = p[i++];
+          s.space = c == 0x38 ? kX86DecoderSpace0F38 : kX86DecoderSpace0F3A;
+          len = c == 0x38 ? kX86DecoderLenM : kX86DecoderLenMB;
+        }
+        else if (c == 0x0F) {
+          s.space = kX86DecoderSpace3dNow;
+        }
+      }
+    }
+
+    if (arch == kArchX64 && (len & kX86DecoderLenNo64) != 0)
+      return kErrorIllegalInst;
+    len &= kX86DecoderLenMask;
+
+    // ------------------------------------------------------------------------
+    // [Operand and Address Size]
+    // ------------------------------------------------------------------------
+
+    uint32_t opSize = s.w ? 8 : (s.prefixes & kX86DecoderPrefix66) ? 2 : 4;
+    uint32_t zSize = opSize == 2 ? 2 : 4;
+
+    if (s.prefixes & kX86DecoderPrefix67)
+      s.addrSize >>= 1;
+
+    // ------------------------------------------------------------------------
+    // [ModR/M, SIB, and Displacement]
+    // ------------------------------------------------------------------------
+
+    switch (len) {
+      case kX86DecoderLenM:
+      case kX86DecoderLenMB:
+      case kX86DecoderLenMZ:
+      case kX86DecoderLenG8:
+      case kX86DecoderLenGZ:
+      case kX86DecoderLenMD: {
+        if (i >= limit)
+          return kErrorIllegalInst;
+
+        uint32_t modRm = p[i++];
+        uint32_t mod = modRm >> 6;
+        uint32_t rm = modRm & 0x7;
+
+        s.hasModRm = 1;
+        s.modRm = modRm;
+
+        if (mod != 3) {
+          if (s.addrSize == 2) {
+            if (mod == 1)
+              s.dispSize = 1;
+            else if (mod == 2 || rm == 6)
+              s.dispSize = 2;
+          }
+          else {
+            if (rm == 4) {
+              if (i >= limit)
+                return kErrorIllegalInst;
+              s.sib = p[i++];
+              rm = s.sib & 0x7;
+            }
+
+            if (mod == 1)
+              s.dispSize = 1;
+            else if (mod == 2 || rm == 5)
+              s.dispSize = 4;
+          }
+
+          s.dispOffset = i;
+          i += s.dispSize;
+        }
+
+        if (len == kX86DecoderLenMB)
+          s.immSize = 1;
+        else if (len == kX86DecoderLenMZ)
+          s.immSize = zSize;
+        else if (len == kX86DecoderLenMD)
+          s.immSize = 4;
+        else if (len == kX86DecoderLenG8 && ((modRm >> 3) & 0x7) <= 1)
+          s.immSize = 1;
+        else if (len == kX86DecoderLenGZ && ((modRm >> 3) & 0x7) <= 1)
+          s.immSize = zSize;
+
+        // 3dNow suffix is the opcode, not an immediate.
+        if (s.space == kX86DecoderSpace3dNow) {
+          if (i >= limit)
+            return kErrorIllegalInst;
+
+          s.opCode = p[i++];
+          s.immSize = 0;
+        }
+
+        // SSE4A `extrq` and `insertq` have two 8-bit immediates.
+        if (s.space == kX86DecoderSpace0F && s.opCode == 0x78 && s.kind == kX86DecoderKindLegacy &&
+            (s.prefixes & (kX86DecoderPrefix66 | kX86DecoderPrefixF2)) != 0) {
+          s.immSize = 2;
+        }
+        break;
+      }
+
+      case kX86DecoderLenB : s.immSize = 1; break;
+      case kX86DecoderLenZ : s.immSize = zSize; break;
+      case kX86DecoderLenV : s.immSize = s.w ? 8 : zSize; break;
+      case kX86DecoderLenW : s.immSize = 2; break;
+      case kX86DecoderLenE : s.immSize = 3; break;
+      case kX86DecoderLenF : s.immSize = zSize + 2; break;
+
+      case kX86DecoderLenO:
+        s.dispOffset = i;
+        s.dispSize = s.addrSize;
+        i += s.dispSize;
+        break;
+
+      case kX86DecoderLenJ:
+        s.dispOffset = i;
+        s.dispSize = 1;
+        i += 1;
+        break;
+
+      case kX86DecoderLenJZ:
+        s.dispOffset = i;
+        s.dispSize = arch == kArchX64 ? 4 : zSize;
+        i += s.dispSize;
+        break;
+
+      case kX86DecoderLenN:
+        break;
+
+      default:
+        return kErrorIllegalInst;
+    }
+
+    if (s.immSize != 0) {
+      s.immOffset = i;
+      i += s.immSize;
+    }
+
+    if (i > limit)
+      return kErrorIllegalInst;
+
+    s.size = i;
+  }
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Decoder - Builder]
+// ============================================================================
+
+//! \internal
+//!
+//! State used by `X86Decoder` constructor to build patterns.
+struct X86DecoderBuilder {
+  //! Decoder.
+  X86Decoder* self;
+  //! Instruction id of added patterns.
+  uint32_t instId;
+  //! Set if out of memory.
+  Error error;
+};
+
+//! \internal
+//!
+//! Index of the operand encoded by ModR/M.rm of SIMD `form`, -1 if none.
+static int x86DecoderRmIndex(uint32_t form) noexcept {
+  switch (form) {
+    case kX86DecoderFormRmReg:
+    case kX86DecoderFormRmRegImm:
+    case kX86DecoderFormRmImm:
+    case kX86DecoderFormRmVvvvReg:
+      return 0;
+
+    case kX86DecoderFormRegRm:
+    case kX86DecoderFormRegRmImm:
+    case kX86DecoderFormRegRmImm2:
+    case kX86DecoderFormRegRmVvvv:
+    case kX86DecoderFormRegRmVvvvImm:
+    case kX86DecoderFormVvvvRm:
+    case kX86DecoderFormVvvvRmImm:
+      return 1;
+
+    case kX86DecoderFormRegVvvvRm:
+    case kX86DecoderFormRegVvvvRmIs4:
+    case kX86DecoderFormRegVvvvRmImm:
+      return 2;
+
+    default:
+      return -1;
+  }
+}
+
+//! \internal
+//!
+//! Add a pattern to the chain of `op` in `space`.
+static void x86DecoderAdd(X86DecoderBuilder& b,
+  uint32_t space, uint32_t op, uint32_t form, uint32_t data,
+  uint32_t prefixes, uint32_t flags, uint32_t modRmMask, uint32_t modRmValue) noexcept {
+
+  X86Decoder* self = b.self;
+  uint32_t index = static_cast<uint32_t>(self->_patterns.getLength());
+
+  ASMJIT_ASSERT(space < X86Decoder::kSpaceCount);
+  ASMJIT_ASSERT(op < 256);
+
+  if (b.error != kErrorOk)
+    return;
+
+  // SIMD instructions that share an opcode are often distinguished only by
+  // ModR/M.mod (`movlps` and `movhlps`), so restrict patterns of operands
+  // that are either a register or a memory.
+  int rmIndex = x86DecoderRmIndex(form);
+  if (rmIndex >= 0 && (flags & (kX86DecoderFlagReg | kX86DecoderFlagMem)) == 0) {
+    uint32_t opFlags = X86Util::getInstInfo(b.instId).getExtendedInfo().getOperandFlags(static_cast<uint32_t>(rmIndex));
+    uint32_t regFlags = kX86InstOpGb | kX86InstOpGw | kX86InstOpGd | kX86InstOpGq |
+                        kX86InstOpFp | kX86InstOpMm | kX86InstOpK  | kX86InstOpXmm |
+                        kX86InstOpYmm | kX86InstOpZmm;
+
+    if ((opFlags & kX86InstOpMem) == 0 && (opFlags & regFlags) != 0)
+      flags |= kX86DecoderFlagReg;
+    else if ((opFlags & kX86InstOpMem) != 0 && (opFlags & regFlags) == 0)
+      flags |= kX86DecoderFlagMem;
+  }
+
+  X86DecoderPattern pattern;
+  pattern.instId = static_cast<uint16_t>(b.instId);
+  pattern.next = self->_heads[space][op];
+  pattern.form = static_cast<uint8_t>(form);
+  pattern.data = static_cast<uint8_t>(data);
+  pattern.prefixes = static_cast<uint8_t>(prefixes);
+  pattern.flags = static_cast<uint8_t>(flags);
+  pattern.modRmMask = static_cast<uint8_t>(modRmMask);
+  pattern.modRmValue = static_cast<uint8_t>(modRmValue & modRmMask);
+  pattern.score = static_cast<uint8_t>(
+    Utils::bitCount(prefixes) * 16 +
+    ((flags & kX86DecoderFlagW) != 0) * 4 +
+    ((flags & (kX86DecoderFlagReg | kX86DecoderFlagMem)) != 0) * 2 +
+    ((flags & (kX86DecoderFlagL | kX86DecoderFlagNotNop)) != 0) +
+    Utils::bitCount(modRmMask));
+  pattern.reserved = 0;
+
+  b.error = self->_patterns.append(pattern);
+  if (b.error == kErrorOk)
+    self->_heads[space][op] = static_cast<uint16_t>(index);
+}
+
+//! \internal
+//!
+//! Add a pattern of a legacy `opCode` (as stored in `X86InstInfo`).
+static void x86DecoderAddLegacy(X86DecoderBuilder& b, uint32_t opCode,
+  uint32_t form, uint32_t data = 0, uint32_t flags = 0, uint32_t prefixes = 0) noexcept {
+
+  uint32_t mm = (opCode & kX86InstOpCode_MM_Mask) >> kX86InstOpCode_MM_Shift;
+  uint32_t pp = (opCode & kX86InstOpCode_PP_Mask) >> kX86InstOpCode_PP_Shift;
+
+  uint32_t space = mm;
+  uint32_t op = opCode & 0xFF;
+  uint32_t modRmMask = 0;
+  uint32_t modRmValue = 0;
+
+  if (opCode & kX86InstOpCode_W) {
+    // REX.W is not available in 32-bit mode.
+    if (b.self->getArch() == kArchX86)
+      return;
+    flags |= kX86DecoderFlagW;
+  }
+
+  if (flags & kX86DecoderFlagAddO) {
+    modRmMask = 0x38;
+    modRmValue = ((opCode & kX86InstOpCode_O_Mask) >> kX86InstOpCode_O_Shift) << 3;
+  }
+
+  // 0F 01 instructions are encoded by ModR/M of 0F 01.
+  if (mm == (kX86InstOpCode_MM_0F01 >> kX86InstOpCode_MM_Shift)) {
+    space = kX86DecoderSpace0F;
+    op = 0x01;
+    modRmMask = 0xFF;
+    modRmValue = opCode & 0xFF;
+  }
+
+  x86DecoderAdd(b, space, op, form, data, prefixes | x86DecoderPrefixFromPP[pp],
+    flags & 0xFF, modRmMask, modRmValue);
+}
+
+//! \internal
+//!
+//! Add a pattern of an FPU instruction `op0 op1`, `mask` is applied to `op1`.
+static void x86DecoderAddFpu(X86DecoderBuilder& b, uint32_t opCode, uint32_t form, uint32_t mask = 0xFF) noexcept {
+  uint32_t pp = (opCode & kX86InstOpCode_PP_Mask) >> kX86InstOpCode_PP_Shift;
+  x86DecoderAdd(b, kX86DecoderSpaceLegacy, (opCode >> 8) & 0xFF, form, 0,
+    x86DecoderPrefixFromPP[pp], kX86DecoderFlagReg, mask, opCode & 0xFF);
+}
+
+//! \internal
+//!
+//! Add a pattern of a VEX or XOP `opCode`, and also EVEX pattern if the
+//! instruction is supported by AVX-512.
+static void x86DecoderAddVex(X86DecoderBuilder& b, const X86InstExtendedInfo& extendedInfo,
+  uint32_t opCode, uint32_t form, uint32_t data = 0, uint32_t flags = 0) noexcept {
+
+  uint32_t mm = (opCode & kX86InstOpCode_MM_Mask) >> kX86InstOpCode_MM_Shift;
+  uint32_t pp = (opCode & kX86InstOpCode_PP_Mask) >> kX86InstOpCode_PP_Shift;
+  uint32_t op = opCode & 0xFF;
+
+  uint32_t modRmMask = 0;
+  uint32_t modRmValue = 0;
+
+  if (flags & kX86DecoderFlagAddO) {
+    modRmMask = 0x38;
+    modRmValue = ((opCode & kX86InstOpCode_O_Mask) >> kX86InstOpCode_O_Shift) << 3;
+  }
+  flags &= 0xFF;
+
+  if (!extendedInfo.hasFlag(kX86InstFlagEvex)) {
+    uint32_t vexFlags = flags;
+    if (opCode & kX86InstOpCode_W)
+      vexFlags |= kX86DecoderFlagW;
+    if (opCode & kX86InstOpCode_L_Mask)
+      vexFlags |= kX86DecoderFlagL;
+
+    x86DecoderAdd(b, mm <= 3 ? kX86DecoderSpaceVex + mm : kX86DecoderSpaceXop + mm, op,
+      form, data, x86DecoderPrefixFromPP[pp], vexFlags, modRmMask, modRmValue);
+  }
+
+  if (extendedInfo.isAvx512() && mm >= 1 && mm <= 3) {
+    uint32_t evexFlags = flags;
+    if (opCode & (kX86InstOpCode_W | kX86InstOpCode_EW))
+      evexFlags |= kX86DecoderFlagW;
+
+    x86DecoderAdd(b, kX86DecoderSpaceEvex + mm, op,
+      form, data, x86DecoderPrefixFromPP[pp], evexFlags, modRmMask, modRmValue);
+  }
+}
+
+//! \internal
+//!
+//! Add patterns of instruction `instId`.
+static void x86DecoderAddInst(X86DecoderBuilder& b, uint32_t instId) noexcept {
+  const X86InstInfo& info = X86Util::getInstInfo(instId);
+  const X86InstExtendedInfo& extendedInfo = info.getExtendedInfo();
+
+  uint32_t arch = b.self->getArch();
+  uint32_t opCode = info.getPrimaryOpCode();
+  uint32_t opCode2 = extendedInfo.getSecondaryOpCode();
+
+  uint32_t opCodeNoO = opCode & ~static_cast<uint32_t>(kX86InstOpCode_O_Mask);
+  uint32_t opCodeO = opCode & kX86InstOpCode_O_Mask;
+
+  b.instId = instId;
+
+  switch (extendedInfo.getEncoding()) {
+    case kX86InstEncodingX86Op:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormNone);
+      break;
+
+    case kX86InstEncodingX86Op_66H:
+      x86DecoderAddLegacy(b, opCode | kX86InstOpCode_PP_66, kX86DecoderFormNone);
+      break;
+
+    case kX86InstEncodingX86Rm_B:
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRm, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingX86Rm:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingX86RmReg:
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRmReg, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRmReg);
+      break;
+
+    case kX86InstEncodingX86RegRm:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRegRm);
+      break;
+
+    case kX86InstEncodingX86M:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormMem, 0, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingX86Arith: {
+      x86DecoderAddLegacy(b, opCodeNoO + 0, kX86DecoderFormGpRmReg , kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCodeNoO + 1, kX86DecoderFormGpRmReg );
+      x86DecoderAddLegacy(b, opCodeNoO + 2, kX86DecoderFormGpRegRm , kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCodeNoO + 3, kX86DecoderFormGpRegRm );
+      x86DecoderAddLegacy(b, opCodeNoO + 4, kX86DecoderFormGpAccImm, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCodeNoO + 5, kX86DecoderFormGpAccImm);
+      x86DecoderAddLegacy(b, opCodeO | 0x80, kX86DecoderFormGpRmImm, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCodeO | 0x81, kX86DecoderFormGpRmImm, 0, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCodeO | 0x83, kX86DecoderFormGpRmImm, kX86DecoderDataImmSx, kX86DecoderFlagAddO);
+
+      // APX - NDD and NF forms (CMP has neither).
+      if (arch == kArchX64 && (opCodeO >> kX86InstOpCode_O_Shift) != 7) {
+        uint32_t op = opCode & 0xF8;
+        uint32_t o = (opCodeO >> kX86InstOpCode_O_Shift) << 3;
+
+        x86DecoderAdd(b, kX86DecoderSpaceApx, op + 0, kX86DecoderFormGpRmReg, kX86DecoderDataByte, 0, 0, 0, 0);
+        x86DecoderAdd(b, kX86DecoderSpaceApx, op + 1, kX86DecoderFormGpRmReg, 0, 0, 0, 0, 0);
+        x86DecoderAdd(b, kX86DecoderSpaceApx, op + 2, kX86DecoderFormGpRegRm, kX86DecoderDataByte, 0, 0, 0, 0);
+        x86DecoderAdd(b, kX86DecoderSpaceApx, op + 3, kX86DecoderFormGpRegRm, 0, 0, 0, 0, 0);
+        x86DecoderAdd(b, kX86DecoderSpaceApx, 0x80, kX86DecoderFormGpRmImm, kX86DecoderDataByte, 0, 0, 0x38, o);
+        x86DecoderAdd(b, kX86DecoderSpaceApx, 0x81, kX86DecoderFormGpRmImm, 0, 0, 0, 0x38, o);
+        x86DecoderAdd(b, kX86DecoderSpaceApx, 0x83, kX86DecoderFormGpRmImm, kX86DecoderDataImmSx, 0, 0, 0x38, o);
+      }
+      break;
+    }
+
+    case kX86InstEncodingX86BSwap:
+      for (uint32_t r = 0; r < 8; r++)
+        x86DecoderAddLegacy(b, opCode + r, kX86DecoderFormGpOpReg);
+      break;
+
+    case kX86InstEncodingX86BTest:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRmReg);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormGpRmImm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingX86Call:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRm, kX86DecoderDataNative, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRel);
+      break;
+
+    case kX86InstEncodingX86Enter:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormEnter);
+      break;
+
+    case kX86InstEncodingX86Imul:
+      x86DecoderAddLegacy(b, 0xF6 | (5 << kX86InstOpCode_O_Shift), kX86DecoderFormGpRm, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, 0xF7 | (5 << kX86InstOpCode_O_Shift), kX86DecoderFormGpRm, 0, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, kX86InstOpCode_MM_0F | 0xAF, kX86DecoderFormGpRegRm);
+      x86DecoderAddLegacy(b, 0x6B, kX86DecoderFormGpRegRmImm, kX86DecoderDataImmSx);
+      x86DecoderAddLegacy(b, 0x69, kX86DecoderFormGpRegRmImm);
+      break;
+
+    case kX86InstEncodingX86IncDec:
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRm, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRm, 0, kX86DecoderFlagAddO);
+
+      // INC/DEC r16|r32 is only encodable in 32-bit mode (REX in 64-bit mode).
+      if (arch == kArchX86) {
+        for (uint32_t r = 0; r < 8; r++)
+          x86DecoderAddLegacy(b, opCode2 + r, kX86DecoderFormGpOpReg);
+      }
+      break;
+
+    case kX86InstEncodingX86Int:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormImmConst, 3);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormImm);
+      break;
+
+    case kX86InstEncodingX86Jcc:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRel);
+      x86DecoderAddLegacy(b, kX86InstOpCode_MM_0F | (opCode + 0x10), kX86DecoderFormRel);
+      break;
+
+    case kX86InstEncodingX86Jecxz:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormCxRel);
+      break;
+
+    case kX86InstEncodingX86Jmp:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRm, kX86DecoderDataNative, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRel);
+      x86DecoderAddLegacy(b, 0xEB, kX86DecoderFormRel);
+      break;
+
+    case kX86InstEncodingX86Lea:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRegRm, 0, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingX86Mov:
+      x86DecoderAddLegacy(b, 0x88, kX86DecoderFormGpRmReg, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, 0x89, kX86DecoderFormGpRmReg);
+      x86DecoderAddLegacy(b, 0x8A, kX86DecoderFormGpRegRm, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, 0x8B, kX86DecoderFormGpRegRm);
+      x86DecoderAddLegacy(b, 0x8C, kX86DecoderFormRmSeg);
+      x86DecoderAddLegacy(b, 0x8E, kX86DecoderFormSegRm);
+
+      for (uint32_t r = 0; r < 8; r++) {
+        x86DecoderAddLegacy(b, 0xB0 + r, kX86DecoderFormGpOpRegImm, kX86DecoderDataByte);
+        x86DecoderAddLegacy(b, 0xB8 + r, kX86DecoderFormGpOpRegImm);
+      }
+
+      x86DecoderAddLegacy(b, 0xC6, kX86DecoderFormGpRmImm, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, 0xC7, kX86DecoderFormGpRmImm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingX86MovsxMovzx:
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRegRmSrc, 1);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRegRmSrc, 2);
+      break;
+
+    case kX86InstEncodingX86Movsxd:
+      x86DecoderAddLegacy(b, opCode | kX86InstOpCode_W, kX86DecoderFormGpRegRmSrc, 4);
+      break;
+
+    case kX86InstEncodingX86MovPtr:
+      x86DecoderAddLegacy(b, opCode     , kX86DecoderFormGpAccMoffs, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCode  + 1, kX86DecoderFormGpAccMoffs);
+      x86DecoderAddLegacy(b, opCode2    , kX86DecoderFormGpMoffsAcc, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCode2 + 1, kX86DecoderFormGpMoffsAcc);
+      break;
+
+    case kX86InstEncodingX86Push:
+      if (arch == kArchX86) {
+        x86DecoderAddLegacy(b, 0x06, kX86DecoderFormSeg, kX86SegEs);
+        x86DecoderAddLegacy(b, 0x0E, kX86DecoderFormSeg, kX86SegCs);
+        x86DecoderAddLegacy(b, 0x16, kX86DecoderFormSeg, kX86SegSs);
+        x86DecoderAddLegacy(b, 0x1E, kX86DecoderFormSeg, kX86SegDs);
+      }
+      x86DecoderAddLegacy(b, kX86InstOpCode_MM_0F | 0xA0, kX86DecoderFormSeg, kX86SegFs);
+      x86DecoderAddLegacy(b, kX86InstOpCode_MM_0F | 0xA8, kX86DecoderFormSeg, kX86SegGs);
+      x86DecoderAddLegacy(b, 0x6A, kX86DecoderFormImm, kX86DecoderDataNative | kX86DecoderDataImmSx);
+      x86DecoderAddLegacy(b, 0x68, kX86DecoderFormImm, kX86DecoderDataNative);
+
+      for (uint32_t r = 0; r < 8; r++)
+        x86DecoderAddLegacy(b, opCode2 + r, kX86DecoderFormGpOpReg, kX86DecoderDataNative);
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRm, kX86DecoderDataNative, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingX86Pop:
+      if (arch == kArchX86) {
+        x86DecoderAddLegacy(b, 0x07, kX86DecoderFormSeg, kX86SegEs);
+        x86DecoderAddLegacy(b, 0x17, kX86DecoderFormSeg, kX86SegSs);
+        x86DecoderAddLegacy(b, 0x1F, kX86DecoderFormSeg, kX86SegDs);
+      }
+      x86DecoderAddLegacy(b, kX86InstOpCode_MM_0F | 0xA1, kX86DecoderFormSeg, kX86SegFs);
+      x86DecoderAddLegacy(b, kX86InstOpCode_MM_0F | 0xA9, kX86DecoderFormSeg, kX86SegGs);
+
+      for (uint32_t r = 0; r < 8; r++)
+        x86DecoderAddLegacy(b, opCode2 + r, kX86DecoderFormGpOpReg, kX86DecoderDataNative);
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRm, kX86DecoderDataNative, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingX86Rep: {
+      uint32_t rep = (opCodeO >> kX86InstOpCode_O_Shift) != 0 ? kX86DecoderPrefixF3 : kX86DecoderPrefixF2;
+      x86DecoderAddLegacy(b, opCodeNoO, kX86DecoderFormNone, 0, 0, rep);
+      break;
+    }
+
+    case kX86InstEncodingX86Ret:
+      x86DecoderAddLegacy(b, 0xC3, kX86DecoderFormNone);
+      x86DecoderAddLegacy(b, 0xC2, kX86DecoderFormImm);
+      break;
+
+    case kX86InstEncodingX86Rot:
+      x86DecoderAddLegacy(b, opCode + 0x00, kX86DecoderFormGpRmOne, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode + 0x01, kX86DecoderFormGpRmOne, 0, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode + 0x02, kX86DecoderFormGpRmCl, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode + 0x03, kX86DecoderFormGpRmCl, 0, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode - 0x10, kX86DecoderFormGpRmImm, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode - 0x0F, kX86DecoderFormGpRmImm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingX86Set:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRm, kX86DecoderDataByte);
+      break;
+
+    case kX86InstEncodingX86ShldShrd:
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRmRegImm);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRmRegCl);
+      break;
+
+    case kX86InstEncodingX86Test:
+      x86DecoderAddLegacy(b, opCode     , kX86DecoderFormGpRmReg, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCode  + 1, kX86DecoderFormGpRmReg);
+      x86DecoderAddLegacy(b, opCode2    , kX86DecoderFormGpRmImm, kX86DecoderDataByte, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, opCode2 + 1, kX86DecoderFormGpRmImm, 0, kX86DecoderFlagAddO);
+      x86DecoderAddLegacy(b, 0xA8, kX86DecoderFormGpAccImm, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, 0xA9, kX86DecoderFormGpAccImm);
+      break;
+
+    case kX86InstEncodingX86Xchg:
+      for (uint32_t r = 0; r < 8; r++)
+        x86DecoderAddLegacy(b, 0x90 + r, kX86DecoderFormGpAccOpReg, 0, r == 0 ? kX86DecoderFlagNotNop : 0);
+
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRmReg, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRmReg);
+      break;
+
+    case kX86InstEncodingX86Xadd:
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRmReg, kX86DecoderDataByte);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRmReg);
+      break;
+
+    case kX86InstEncodingX86Crc:
+      x86DecoderAddLegacy(b, opCode    , kX86DecoderFormGpRegRmSrc, 1);
+      x86DecoderAddLegacy(b, opCode + 1, kX86DecoderFormGpRegRm);
+      break;
+
+    case kX86InstEncodingX86Prefetch:
+      x86DecoderAdd(b, kX86DecoderSpace0F, opCode & 0xFF, kX86DecoderFormPrefetch, 0, 0, kX86DecoderFlagMem, 0x20, 0x00);
+      break;
+
+    case kX86InstEncodingX86Fence: {
+      uint32_t o = (opCodeO >> kX86InstOpCode_O_Shift) << 3;
+      uint32_t flags = 0;
+
+      if ((opCode & kX86InstOpCode_W) && arch == kArchX64)
+        flags |= kX86DecoderFlagW;
+      x86DecoderAdd(b, kX86DecoderSpace0F, opCode & 0xFF, kX86DecoderFormNone, 0, 0, flags, 0xFF, 0xC0 | o);
+      break;
+    }
+
+    case kX86InstEncodingFpuOp:
+      x86DecoderAddFpu(b, opCode, kX86DecoderFormNone);
+      break;
+
+    case kX86InstEncodingFpuArith:
+      x86DecoderAddFpu(b, 0xD800 | ((opCode >> 8) & 0xF8), kX86DecoderFormFpSt0StI, 0xF8);
+      x86DecoderAddFpu(b, 0xDC00 | ((opCode     ) & 0xF8), kX86DecoderFormFpStISt0, 0xF8);
+      x86DecoderAddLegacy(b, opCodeO | 0xD8, kX86DecoderFormMem, 4, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      x86DecoderAddLegacy(b, opCodeO | 0xDC, kX86DecoderFormMem, 8, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingFpuCom:
+      x86DecoderAddFpu(b, 0xD800 | ((opCode >> 8) & 0xF8), kX86DecoderFormFpSt, 0xF8);
+      x86DecoderAddLegacy(b, opCodeO | 0xD8, kX86DecoderFormMem, 4, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      x86DecoderAddLegacy(b, opCodeO | 0xDC, kX86DecoderFormMem, 8, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingFpuFldFst:
+      if (info.hasFlag(kX86InstFlagMem4))
+        x86DecoderAddLegacy(b, opCode, kX86DecoderFormMem, 4, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      if (info.hasFlag(kX86InstFlagMem8))
+        x86DecoderAddLegacy(b, opCode + 4, kX86DecoderFormMem, 8, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      if (info.hasFlag(kX86InstFlagMem10))
+        x86DecoderAddLegacy(b, opCode2, kX86DecoderFormMem, 10, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+
+      if (instId == kX86InstIdFld)
+        x86DecoderAddFpu(b, 0xD9C0, kX86DecoderFormFpSt, 0xF8);
+      else if (instId == kX86InstIdFst)
+        x86DecoderAddFpu(b, 0xDDD0, kX86DecoderFormFpSt, 0xF8);
+      else if (instId == kX86InstIdFstp)
+        x86DecoderAddFpu(b, 0xDDD8, kX86DecoderFormFpSt, 0xF8);
+      break;
+
+    case kX86InstEncodingFpuM:
+      if (info.hasFlag(kX86InstFlagMem2))
+        x86DecoderAddLegacy(b, opCode + 4, kX86DecoderFormMem, 2, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      if (info.hasFlag(kX86InstFlagMem4))
+        x86DecoderAddLegacy(b, opCode, kX86DecoderFormMem, 4, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      if (info.hasFlag(kX86InstFlagMem8))
+        x86DecoderAddLegacy(b, opCode2, kX86DecoderFormMem, 8, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingFpuR:
+    case kX86InstEncodingFpuRDef:
+      x86DecoderAddFpu(b, opCode, kX86DecoderFormFpSt, 0xF8);
+      break;
+
+    case kX86InstEncodingFpuStsw:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormMem, 2, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      x86DecoderAddFpu(b, opCode2, kX86DecoderFormFpAx);
+      break;
+
+    case kX86InstEncodingSimdRm:
+    case kX86InstEncodingSimdRm_P:
+    case kX86InstEncodingSimdRm_Q:
+    case kX86InstEncodingSimdRm_PQ:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRm);
+      break;
+
+    case kX86InstEncodingSimdRmRi:
+    case kX86InstEncodingSimdRmRi_P:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRm);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRmImm, 0, kX86DecoderFlagAddO | kX86DecoderFlagReg);
+      break;
+
+    case kX86InstEncodingSimdRmi:
+    case kX86InstEncodingSimdRmi_P:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRmImm);
+      break;
+
+    case kX86InstEncodingSimdPextrw:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRmImm, X86_DECODER_CLASS(Gp, MmXmm), kX86DecoderFlagReg);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRmRegImm, X86_DECODER_CLASS(Gp, MmXmm), kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingSimdExtract:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRmRegImm, X86_DECODER_CLASS(Gp, MmXmm));
+      break;
+
+    case kX86InstEncodingSimdMov:
+    case kX86InstEncodingSimdMovNoRexW:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRm);
+      if (opCode2 != 0)
+        x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRmReg, 0, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingSimdMovBe:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormGpRegRm, 0, kX86DecoderFlagMem);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormGpRmReg, 0, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingSimdMovD:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRm, X86_DECODER_CLASS(MmXmm, Gp));
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRmReg, X86_DECODER_CLASS(Gp, MmXmm));
+      break;
+
+    case kX86InstEncodingSimdMovQ:
+      x86DecoderAddLegacy(b, kX86InstOpCode_PP_00 | kX86InstOpCode_MM_0F | 0x6F, kX86DecoderFormRegRm, X86_DECODER_CLASS(Mm , Mm ));
+      x86DecoderAddLegacy(b, kX86InstOpCode_PP_F3 | kX86InstOpCode_MM_0F | 0x7E, kX86DecoderFormRegRm, X86_DECODER_CLASS(Xmm, Xmm));
+      x86DecoderAddLegacy(b, kX86InstOpCode_PP_F2 | kX86InstOpCode_MM_0F | 0xD6, kX86DecoderFormRegRm, X86_DECODER_CLASS(Mm , Xmm), kX86DecoderFlagReg);
+      x86DecoderAddLegacy(b, kX86InstOpCode_PP_F3 | kX86InstOpCode_MM_0F | 0xD6, kX86DecoderFormRegRm, X86_DECODER_CLASS(Xmm, Mm ), kX86DecoderFlagReg);
+      x86DecoderAddLegacy(b, kX86InstOpCode_PP_00 | kX86InstOpCode_MM_0F | 0x7F, kX86DecoderFormRmReg, X86_DECODER_CLASS(Mm , Mm ), kX86DecoderFlagMem);
+      x86DecoderAddLegacy(b, kX86InstOpCode_PP_66 | kX86InstOpCode_MM_0F | 0xD6, kX86DecoderFormRmReg, X86_DECODER_CLASS(Xmm, Xmm), kX86DecoderFlagMem);
+
+      // MOVD promoted to 64-bit.
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRm, X86_DECODER_CLASS(MmXmm, Gp), kX86DecoderFlagReg);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRmReg, X86_DECODER_CLASS(Gp, MmXmm), kX86DecoderFlagReg);
+      break;
+
+    case kX86InstEncodingSimdExtrq:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRm);
+      x86DecoderAdd(b, kX86DecoderSpace0F, opCode2 & 0xFF, kX86DecoderFormRegImm2, 0, kX86DecoderPrefix66,
+        kX86DecoderFlagReg, 0xC7, 0xC0 | ((opCode2 & kX86InstOpCode_O_Mask) >> kX86InstOpCode_O_Shift));
+      break;
+
+    case kX86InstEncodingSimdInsertq:
+      x86DecoderAddLegacy(b, opCode, kX86DecoderFormRegRm);
+      x86DecoderAddLegacy(b, opCode2, kX86DecoderFormRegRmImm2, 0, kX86DecoderFlagReg);
+      break;
+
+    case kX86InstEncodingSimd3dNow:
+      x86DecoderAdd(b, kX86DecoderSpace3dNow, opCode & 0xFF, kX86DecoderFormRegRm, X86_DECODER_CLASS(Mm, Mm), 0, 0, 0, 0);
+      break;
+
+    case kX86InstEncodingAvxOp:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormNone);
+      break;
+
+    case kX86InstEncodingAvxM:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormMem, 0, kX86DecoderFlagAddO | kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingAvxMr:
+    case kX86InstEncodingAvxMr_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRmReg);
+      break;
+
+    case kX86InstEncodingAvxMri:
+    case kX86InstEncodingAvxMri_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRmRegImm);
+      break;
+
+    case kX86InstEncodingAvxRm:
+    case kX86InstEncodingAvxRm_OptL:
+    case kX86InstEncodingXopRm:
+    case kX86InstEncodingXopRm_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegRm);
+      break;
+
+    case kX86InstEncodingAvxRmi:
+    case kX86InstEncodingAvxRmi_OptW:
+    case kX86InstEncodingAvxRmi_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegRmImm);
+      break;
+
+    case kX86InstEncodingAvxRvm:
+    case kX86InstEncodingAvxRvm_OptW:
+    case kX86InstEncodingAvxRvm_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRm);
+      break;
+
+    case kX86InstEncodingAvxRvmr:
+    case kX86InstEncodingAvxRvmr_OptL:
+    case kX86InstEncodingXopRvmr:
+    case kX86InstEncodingXopRvmr_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRmIs4);
+      break;
+
+    case kX86InstEncodingAvxRvmi:
+    case kX86InstEncodingAvxRvmi_OptL:
+    case kX86InstEncodingXopRvmi:
+    case kX86InstEncodingXopRvmi_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRmImm);
+      break;
+
+    case kX86InstEncodingAvxRmv:
+    case kX86InstEncodingAvxRmv_OptW:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegRmVvvv);
+      break;
+
+    case kX86InstEncodingAvxRmvi:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegRmVvvvImm);
+      break;
+
+    case kX86InstEncodingAvxMovDQ:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegRm, X86_DECODER_CLASS(Xmm, Gp));
+      x86DecoderAddVex(b, extendedInfo, opCode2, kX86DecoderFormRmReg, X86_DECODER_CLASS(Gp, Xmm));
+      break;
+
+    case kX86InstEncodingAvxRmMr:
+    case kX86InstEncodingAvxRmMr_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegRm);
+      x86DecoderAddVex(b, extendedInfo, (opCode & kX86InstOpCode_L_Mask) | opCode2, kX86DecoderFormRmReg, 0, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingAvxRvmRmi:
+    case kX86InstEncodingAvxRvmRmi_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRm);
+      x86DecoderAddVex(b, extendedInfo, (opCode & kX86InstOpCode_L_Mask) | opCode2, kX86DecoderFormRegRmImm);
+      break;
+
+    case kX86InstEncodingAvxRvmMr:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRm);
+      x86DecoderAddVex(b, extendedInfo, opCode2, kX86DecoderFormRmReg);
+      break;
+
+    case kX86InstEncodingAvxRvmMvr:
+    case kX86InstEncodingAvxRvmMvr_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRm);
+      x86DecoderAddVex(b, extendedInfo, (opCode & kX86InstOpCode_L_Mask) | opCode2, kX86DecoderFormRmVvvvReg, 0, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingAvxRvmVmi:
+    case kX86InstEncodingAvxRvmVmi_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRm);
+      x86DecoderAddVex(b, extendedInfo, (opCode & kX86InstOpCode_L_Mask) | opCode2, kX86DecoderFormVvvvRmImm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingAvxVm:
+    case kX86InstEncodingAvxVm_OptW:
+    case kX86InstEncodingXopVm_OptW:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormVvvvRm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingAvxVmi:
+    case kX86InstEncodingAvxVmi_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormVvvvRmImm, 0, kX86DecoderFlagAddO);
+      break;
+
+    case kX86InstEncodingAvxRvrmRvmr:
+    case kX86InstEncodingAvxRvrmRvmr_OptL:
+    case kX86InstEncodingFma4:
+    case kX86InstEncodingFma4_OptL:
+    case kX86InstEncodingXopRvrmRvmr:
+    case kX86InstEncodingXopRvrmRvmr_OptL:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormFma4);
+      break;
+
+    case kX86InstEncodingAvxMovSsSd:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegVvvvRm, 0, kX86DecoderFlagReg);
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormRegRm, 0, kX86DecoderFlagMem);
+      x86DecoderAddVex(b, extendedInfo, opCode2, kX86DecoderFormRmReg, 0, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingAvxGather:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormGather, 0, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingAvxGatherEx:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormGather, 1, kX86DecoderFlagMem);
+      break;
+
+    case kX86InstEncodingXopRvmRmv:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormXopRmv);
+      break;
+
+    case kX86InstEncodingXopRvmRmi:
+      x86DecoderAddVex(b, extendedInfo, opCode, kX86DecoderFormXopRmv);
+      x86DecoderAddVex(b, extendedInfo, opCode2, kX86DecoderFormRegRmImm);
+      break;
+
+    default:
+      break;
+  }
+}
+
+// ============================================================================
+// [asmjit::X86Decoder - Construction / Destruction]
+// ============================================================================
+
+X86Decoder::X86Decoder(uint32_t arch) noexcept
+  : _arch(arch) {
+
+  ::memset(_heads, 0xFF, sizeof(_heads));
+
+  if (arch != kArchX86 && arch != kArchX64)
+    return;
+
+  X86DecoderBuilder b;
+  b.self = this;
+  b.instId = kInstIdNone;
+  b.error = _patterns._reserve(4096);
+
+  // Patterns are added to the front of their chain, so the chain starts with
+  // the lowest instruction id (that wins if there are more equal patterns).
+  for (uint32_t instId = _kX86InstIdCount - 1; instId != kInstIdNone; instId--)
+    x86DecoderAddInst(b, instId);
+
+  if (b.error != kErrorOk) {
+    ::memset(_heads, 0xFF, sizeof(_heads));
+    _patterns.reset(true);
+  }
+}
+
+X86Decoder::~X86Decoder() noexcept {}
+
+// ============================================================================
+// [asmjit::X86Decoder - Operands]
+// ============================================================================
+
+//! \internal
+static ASMJIT_INLINE X86Reg x86DecoderReg(uint32_t type, uint32_t index) noexcept {
+  return X86Reg(type, index, x86DecoderRegSize[type >> 4]);
+}
+
+//! \internal
+//!
+//! Get GP register of `size` and `index`, `SPL..DIL` are `AH..BH` without REX.
+static ASMJIT_INLINE X86Reg x86DecoderGpReg(const X86DecoderState& s, uint32_t size, uint32_t index) noexcept {
+  switch (size) {
+    case 1:
+      if (index >= 4 && index < 8 && s.rex == 0 && s.kind == kX86DecoderKindLegacy)
+        return x86DecoderReg(kX86RegTypeGpbHi, index - 4);
+      return x86DecoderReg(kX86RegTypeGpbLo, index);
+
+    case 2: return x86DecoderReg(kX86RegTypeGpw, index);
+    case 4: return x86DecoderReg(kX86RegTypeGpd, index);
+    default: return x86DecoderReg(kX86RegTypeGpq, index);
+  }
+}
+
+//! \internal
+//!
+//! Get type of a SIMD operand of `cls` (see \ref X86DecoderClass), `opFlags`
+//! are flags of the operand as stored in `X86InstExtendedInfo`.
+static uint32_t x86DecoderRegType(const X86DecoderState& s, uint32_t arch, uint32_t cls, uint32_t opFlags, bool extra66) noexcept {
+  uint32_t gpType = s.w && arch == kArchX64 ? kX86RegTypeGpq : kX86RegTypeGpd;
+
+  switch (cls) {
+    case kX86DecoderClassGp   : return gpType;
+    case kX86DecoderClassMm   : return kX86RegTypeMm;
+    case kX86DecoderClassXmm  : return kX86RegTypeXmm;
+    case kX86DecoderClassMmXmm: return extra66 ? kX86RegTypeXmm : kX86RegTypeMm;
+  }
+
+  if (s.kind <= kX86DecoderKindRex2) {
+    if ((opFlags & (kX86InstOpMm | kX86InstOpXmm)) == (kX86InstOpMm | kX86InstOpXmm))
+      return extra66 ? kX86RegTypeXmm : kX86RegTypeMm;
+
+    if (opFlags & kX86InstOpXmm) return kX86RegTypeXmm;
+    if (opFlags & kX86InstOpMm ) return kX86RegTypeMm;
+  }
+  else if (opFlags & (kX86InstOpXmm | kX86InstOpYmm | kX86InstOpZmm)) {
+    static const uint32_t vecFlags[3] = { kX86InstOpXmm , kX86InstOpYmm , kX86InstOpZmm  };
+    static const uint32_t vecTypes[3] = { kX86RegTypeXmm, kX86RegTypeYmm, kX86RegTypeZmm };
+
+    // Use the vector length of the instruction, a smaller or a bigger vector
+    // if the operand doesn't support it (conversions and extractions).
+    uint32_t l = s.l;
+    if (s.kind == kX86DecoderKindEvex && s.b && s.modRm >= 0xC0)
+      l = 2;
+    else if (l > 2)
+      l = 2;
+
+    for (uint32_t i = l + 1; i != 0; i--)
+      if (opFlags & vecFlags[i - 1])
+        return vecTypes[i - 1];
+
+    for (uint32_t i = l + 1; i < 3; i++)
+      if (opFlags & vecFlags[i])
+        return vecTypes[i];
+  }
+
+  if (opFlags & (kX86InstOpGd | kX86InstOpGq)) return gpType;
+  if (opFlags & kX86InstOpK) return kX86RegTypeK;
+  if (opFlags & kX86InstOpMm) return kX86RegTypeMm;
+
+  return kX86RegTypeXmm;
+}
+
+//! \internal
+//!
+//! Read an immediate value of `size` bytes from `p`.
+static ASMJIT_INLINE int64_t x86DecoderReadImm(const uint8_t* p, uint32_t size, bool signExtend) noexcept {
+  switch (size) {
+    case 1: return signExtend ? static_cast<int64_t>(Utils::readI8(p)) : static_cast<int64_t>(Utils::readU8(p));
+    case 2: return signExtend ? static_cast<int64_t>(Utils::readI16uLE(p)) : static_cast<int64_t>(Utils::readU16uLE(p));
+    case 4: return signExtend ? static_cast<int64_t>(Utils::readI32uLE(p)) : static_cast<int64_t>(Utils::readU32uLE(p));
+    case 8: return Utils::readI64uLE(p);
+    default: return 0;
+  }
+}
+
+//! \internal
+//!
+//! Create a memory operand of `size` described by ModR/M and SIB. The index
+//! is a vector register of `vsibType` if non-zero and the displacement is
+//! scaled by `1 << dispShift` if it's 8-bit (EVEX compressed displacement).
+static X86Mem x86DecoderMem(const X86DecoderState& s, uint32_t arch, const uint8_t* p,
+  uint32_t size, uint32_t vsibType, uint32_t dispShift) noexcept {
+
+  uint32_t mod = s.modRm >> 6;
+  uint32_t rm = s.modRm & 0x7;
+
+  int32_t disp = 0;
+  if (s.dispSize == 1)
+    disp = static_cast<int32_t>(Utils::readI8(p + s.dispOffset)) * (static_cast<int32_t>(1) << dispShift);
+  else if (s.dispSize == 2)
+    disp = Utils::readI16uLE(p + s.dispOffset);
+  else if (s.dispSize == 4)
+    disp = Utils::readI32uLE(p + s.dispOffset);
+
+  X86Mem m;
+
+  if (s.addrSize == 2) {
+    // 16-bit addressing (32-bit mode with 67 prefix).
+    uint32_t base = x86DecoderAddr16[rm][0];
+    uint32_t index = x86DecoderAddr16[rm][1];
+
+    if (mod == 0 && rm == 6)
+      m = x86::ptr_abs(0, disp, size);
+    else if (index == 0xFF)
+      m = X86Mem(X86GpReg(kX86RegTypeGpw, base, 2), disp, size);
+    else
+      m = X86Mem(X86GpReg(kX86RegTypeGpw, base, 2), X86GpReg(kX86RegTypeGpw, index, 2), 0, disp, size);
+  }
+  else {
+    uint32_t gpType = s.addrSize == 8 ? kX86RegTypeGpq : kX86RegTypeGpd;
+    uint32_t gpSize = s.addrSize;
+
+    if (rm == 4) {
+      uint32_t shift = s.sib >> 6;
+      uint32_t index = ((s.sib >> 3) & 0x7) | s.xExt;
+      uint32_t base = s.sib & 0x7;
+
+      bool hasIndex = vsibType != 0 || index != kX86RegIndexSp;
+      X86Reg indexReg(vsibType != 0 ? vsibType : gpType, index, vsibType != 0 ? x86DecoderRegSize[vsibType >> 4] : gpSize);
+
+      if (mod == 0 && base == 5) {
+        if (hasIndex)
+          m = x86::ptr_abs(0, indexReg, shift, disp, size);
+        else
+          m = x86::ptr_abs(0, disp, size);
+      }
+      else {
+        X86GpReg baseReg(gpType, base | s.bExt, gpSize);
+
+        if (!hasIndex)
+          m = X86Mem(baseReg, disp, size);
+        else if (vsibType == kX86RegTypeXmm)
+          m = X86Mem(baseReg, static_cast<const X86XmmReg&>(indexReg), shift, disp, size);
+        else if (vsibType == kX86RegTypeYmm)
+          m = X86Mem(baseReg, static_cast<const X86YmmReg&>(indexReg), shift, disp, size);
+        else
+          m = X86Mem(baseReg, static_cast<const X86GpReg&>(indexReg), shift, disp, size);
+      }
+    }
+    else if (mod == 0 && rm == 5) {
+      if (arch == kArchX64)
+        m = X86Mem(x86::rip, disp, size);
+      else
+        m = x86::ptr_abs(0, disp, size);
+    }
+    else {
+      m = X86Mem(X86GpReg(gpType, rm | s.bExt, gpSize), disp, size);
+    }
+  }
+
+  if (s.segment != kX86SegDefault)
+    m.setSegment(s.segment);
+  return m;
+}
+
+// ============================================================================
+// [asmjit::X86Decoder - Decode]
+// ============================================================================
+
+//! \internal
+//!
+//! Find the most specific pattern that matches the instruction.
+static const X86DecoderPattern* x86DecoderMatch(const X86Decoder* self, const X86DecoderState& s) noexcept {
+  const X86DecoderPattern* patterns = self->_patterns.getData();
+  const X86DecoderPattern* best = nullptr;
+
+  uint32_t index = self->_heads[s.space][s.opCode];
+  uint32_t mod3 = s.hasModRm && s.modRm >= 0xC0;
+  bool legacy = s.kind <= kX86DecoderKindRex2;
+
+  while (index != 0xFFFF) {
+    const X86DecoderPattern& pattern = patterns[index];
+    index = pattern.next;
+
+    // Legacy mandatory prefixes are a subset of prefixes (66 also changes the
+    // operand size), VEX, XOP, and EVEX `pp` must match exactly.
+    uint32_t prefixes = s.prefixes & (kX86DecoderPrefix66 | kX86DecoderPrefixF3 | kX86DecoderPrefixF2 | kX86DecoderPrefix9B);
+    if (legacy ? (pattern.prefixes & ~prefixes) != 0 : pattern.prefixes != prefixes)
+      continue;
+
+    if ((pattern.flags & kX86DecoderFlagW) && !s.w)
+      continue;
+
+    if ((pattern.flags & kX86DecoderFlagL) && !s.l)
+      continue;
+
+    if ((pattern.flags & kX86DecoderFlagReg) && !mod3)
+      continue;
+
+    if ((pattern.flags & kX86DecoderFlagMem) && (!s.hasModRm || mod3))
+      continue;
+
+    if ((s.modRm & pattern.modRmMask) != pattern.modRmValue)
+      continue;
+
+    if ((pattern.flags & kX86DecoderFlagNotNop) && !s.bExt && !s.w && !(s.prefixes & kX86DecoderPrefix66))
+      continue;
+
+    if (best == nullptr || pattern.score > best->score)
+      best = &pattern;
+  }
+
+  return best;
+}
+
+Error X86Decoder::decode(X86DecodedInst& inst, const void* data, size_t size, Ptr address) const noexcept {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  uint32_t arch = _arch;
+
+  X86DecoderState s;
+  inst.reset();
+
+  Error err = x86DecoderParse(s, arch, p, size);
+  if (err != kErrorOk)
+    return err;
+
+  inst.size = s.size;
+  inst.dispOffset = static_cast<uint8_t>(s.dispOffset);
+  inst.dispSize = static_cast<uint8_t>(s.dispSize);
+  inst.immOffset = static_cast<uint8_t>(s.immOffset);
+  inst.immSize = static_cast<uint8_t>(s.immSize);
+
+  const X86DecoderPattern* pattern = x86DecoderMatch(this, s);
+  if (pattern == nullptr)
+    return kErrorUnknownInst;
+
+  const X86InstInfo& info = X86Util::getInstInfo(pattern->instId);
+  const X86InstExtendedInfo& extendedInfo = info.getExtendedInfo();
+
+  uint32_t form = pattern->form;
+  uint32_t fData = pattern->data;
+  uint32_t options = 0;
+
+  bool extra66 = (s.prefixes & kX86DecoderPrefix66) != 0 && (pattern->prefixes & kX86DecoderPrefix66) == 0;
+
+  uint32_t regIndex = ((s.modRm >> 3) & 0x7) | s.rExt;
+  uint32_t rmIndex = (s.modRm & 0x7) | (s.kind >= kX86DecoderKindEvex ? s.rmExt : s.bExt);
+  uint32_t opRegIndex = (s.opCode & 0x7) | s.bExt;
+  bool rmIsReg = s.hasModRm && s.modRm >= 0xC0;
+
+  // Operand size of GP forms, other forms use `data` for something else.
+  uint32_t gpData = form <= kX86DecoderFormGpMoffsAcc || form == kX86DecoderFormImm ? fData : 0;
+  uint32_t opSize = s.w ? 8 : extra66 ? 2 : 4;
+
+  if (gpData & kX86DecoderDataByte)
+    opSize = 1;
+  else if (gpData & kX86DecoderDataNative)
+    opSize = (s.prefixes & kX86DecoderPrefix66) ? 2 : getRegSize();
+
+  // Size of the memory operand and EVEX compressed displacement.
+  uint32_t memSize = 0;
+  uint32_t dispShift = 0;
+
+  if (s.kind == kX86DecoderKindEvex) {
+    if (s.b || extendedInfo.hasFlag(kX86InstFlagAvx512T1S)) {
+      memSize = 4 << s.w;
+      dispShift = 2 + s.w;
+    }
+    else {
+      memSize = 16 << s.l;
+      dispShift = 4 + s.l;
+    }
+  }
+  else if (extendedInfo.getEncoding() == kX86InstEncodingSimdRm_Q && s.w) {
+    memSize = 8;
+  }
+
+  Operand* ops = inst.operands;
+  uint32_t count = 0;
+
+  switch (form) {
+    case kX86DecoderFormNone:
+      break;
+
+    // ------------------------------------------------------------------------
+    // [GP]
+    // ------------------------------------------------------------------------
+
+#define X86_DECODER_GP(index) x86DecoderGpReg(s, opSize, index)
+#define X86_DECODER_RM() (rmIsReg ? static_cast<Operand>(X86_DECODER_GP(rmIndex)) \
+                                  : static_cast<Operand>(x86DecoderMem(s, arch, p, opSize, 0, 0)))
+#define X86_DECODER_IMM() Imm(x86DecoderReadImm(p + s.immOffset, s.immSize, \
+                                (gpData & kX86DecoderDataImmSx) != 0 || (opSize == 8 && s.immSize == 4)))
+
+    case kX86DecoderFormGpRm:
+      ops[count++] = X86_DECODER_RM();
+      break;
+
+    case kX86DecoderFormGpRmReg:
+      ops[count++] = X86_DECODER_RM();
+      ops[count++] = X86_DECODER_GP(regIndex);
+      break;
+
+    case kX86DecoderFormGpRegRm:
+      ops[count++] = X86_DECODER_GP(regIndex);
+      ops[count++] = X86_DECODER_RM();
+      break;
+
+    case kX86DecoderFormGpRmImm:
+      ops[count++] = X86_DECODER_RM();
+      ops[count++] = X86_DECODER_IMM();
+      break;
+
+    case kX86DecoderFormGpAccImm:
+      ops[count++] = X86_DECODER_GP(kX86RegIndexAx);
+      ops[count++] = X86_DECODER_IMM();
+      break;
+
+    case kX86DecoderFormGpRmOne:
+      ops[count++] = X86_DECODER_RM();
+      ops[count++] = Imm(1);
+      break;
+
+    case kX86DecoderFormGpRmCl:
+      ops[count++] = X86_DECODER_RM();
+      ops[count++] = x86DecoderReg(kX86RegTypeGpbLo, kX86RegIndexCx);
+      break;
+
+    case kX86DecoderFormGpRegRmImm:
+      ops[count++] = X86_DECODER_GP(regIndex);
+      ops[count++] = X86_DECODER_RM();
+      ops[count++] = X86_DECODER_IMM();
+      break;
+
+    case kX86DecoderFormGpRmRegImm:
+      ops[count++] = X86_DECODER_RM();
+      ops[count++] = X86_DECODER_GP(regIndex);
+      ops[count++] = X86_DECODER_IMM();
+      break;
+
+    case kX86DecoderFormGpRmRegCl:
+      ops[count++] = X86_DECODER_RM();
+      ops[count++] = X86_DECODER_GP(regIndex);
+      ops[count++] = x86DecoderReg(kX86RegTypeGpbLo, kX86RegIndexCx);
+      break;
+
+    case kX86DecoderFormGpOpReg:
+      ops[count++] = X86_DECODER_GP(opRegIndex);
+      break;
+
+    case kX86DecoderFormGpOpRegImm:
+      ops[count++] = X86_DECODER_GP(opRegIndex);
+      ops[count++] = X86_DECODER_IMM();
+      break;
+
+    case kX86DecoderFormGpAccOpReg:
+      ops[count++] = X86_DECODER_GP(kX86RegIndexAx);
+      ops[count++] = X86_DECODER_GP(opRegIndex);
+      break;
+
+    case kX86DecoderFormGpAccMoffs:
+    case kX86DecoderFormGpMoffsAcc: {
+      Imm moffs(x86DecoderReadImm(p + s.dispOffset, s.dispSize, false));
+      if (form == kX86DecoderFormGpMoffsAcc)
+        ops[count++] = moffs;
+      ops[count++] = X86_DECODER_GP(kX86RegIndexAx);
+      if (form == kX86DecoderFormGpAccMoffs)
+        ops[count++] = moffs;
+      break;
+    }
+
+    case kX86DecoderFormGpRegRmSrc:
+      ops[count++] = X86_DECODER_GP(regIndex);
+      if (rmIsReg)
+        ops[count++] = x86DecoderGpReg(s, fData, rmIndex);
+      else
+        ops[count++] = x86DecoderMem(s, arch, p, fData, 0, 0);
+      break;
+
+    case kX86DecoderFormSegRm:
+    case kX86DecoderFormRmSeg: {
+      uint32_t seg = (regIndex & 0x7) + 1;
+      if (seg >= kX86SegCount)
+        return kErrorUnknownInst;
+
+      if (form == kX86DecoderFormRmSeg)
+        ops[count++] = X86_DECODER_RM();
+      ops[count++] = x86DecoderReg(kX86RegTypeSeg, seg);
+      if (form == kX86DecoderFormSegRm)
+        ops[count++] = X86_DECODER_RM();
+      break;
+    }
+
+    case kX86DecoderFormSeg:
+      ops[count++] = x86DecoderReg(kX86RegTypeSeg, fData);
+      break;
+
+    case kX86DecoderFormImm:
+      ops[count++] = X86_DECODER_IMM();
+      break;
+
+    case kX86DecoderFormImmConst:
+      ops[count++] = Imm(fData);
+      break;
+
+    case kX86DecoderFormRel:
+    case kX86DecoderFormCxRel: {
+      int64_t rel = x86DecoderReadImm(p + s.dispOffset, s.dispSize, true);
+
+      if (form == kX86DecoderFormCxRel)
+        ops[count++] = X86_DECODER_GP(kX86RegIndexCx).setSize(s.addrSize);
+      ops[count++] = Imm(static_cast<int64_t>(address + s.size + static_cast<uint64_t>(rel)));
+
+      options |= s.dispSize == 1 ? kInstOptionShortForm : kInstOptionLongForm;
+      if (extendedInfo.getEncoding() == kX86InstEncodingX86Jcc) {
+        if (s.segment == kX86SegDs) options |= kInstOptionTaken;
+        if (s.segment == kX86SegCs) options |= kInstOptionNotTaken;
+      }
+
+      // The REX prefix that precedes `jmp` or `call` to an absolute target
+      // marks an instruction that can be patched to use a trampoline.
+      if (s.rex != 0)
+        options |= kX86InstOptionRex;
+      break;
+    }
+
+    case kX86DecoderFormEnter:
+      ops[count++] = Imm(Utils::readU8(p + s.immOffset + 2));
+      ops[count++] = Imm(Utils::readU16uLE(p + s.immOffset));
+      break;
+
+    case kX86DecoderFormMem:
+      ops[count++] = x86DecoderMem(s, arch, p, fData, 0, dispShift);
+      break;
+
+    case kX86DecoderFormPrefetch:
+      ops[count++] = x86DecoderMem(s, arch, p, 0, 0, 0);
+      ops[count++] = Imm((s.modRm >> 3) & 0x3);
+      break;
+
+    case kX86DecoderFormFpSt:
+    case kX86DecoderFormFpSt0StI:
+    case kX86DecoderFormFpStISt0: {
+      X86Reg st0 = x86DecoderReg(kX86RegTypeFp, 0);
+      X86Reg sti = x86DecoderReg(kX86RegTypeFp, s.modRm & 0x7);
+
+      if (form == kX86DecoderFormFpSt0StI)
+        ops[count++] = st0;
+      ops[count++] = sti;
+      if (form == kX86DecoderFormFpStISt0)
+        ops[count++] = st0;
+      break;
+    }
+
+    case kX86DecoderFormFpAx:
+      ops[count++] = x86DecoderReg(kX86RegTypeGpw, kX86RegIndexAx);
+      break;
+
+#undef X86_DECODER_IMM
+#undef X86_DECODER_RM
+#undef X86_DECODER_GP
+
+    // ------------------------------------------------------------------------
+    // [SIMD / AVX / XOP]
+    // ------------------------------------------------------------------------
+
+    default: {
+      // Operand layout, one byte per operand:
+      //   'R' - ModR/M.reg, 'M' - ModR/M.rm, 'V' - VEX.vvvv, 'I' - imm8,
+      //   'J' - two imm8, 'S' - is4 register, 'O' - `/O` register (none).
+      const char* layout = "";
+      uint32_t vsibType = 0;
+
+      switch (form) {
+        case kX86DecoderFormRegRm           : layout = "RM"  ; break;
+        case kX86DecoderFormRmReg           : layout = "MR"  ; break;
+        case kX86DecoderFormRegRmImm        : layout = "RMI" ; break;
+        case kX86DecoderFormRmRegImm        : layout = "MRI" ; break;
+        case kX86DecoderFormRmImm           : layout = "MI"  ; break;
+        case kX86DecoderFormRegImm2         : layout = "RJ"  ; break;
+        case kX86DecoderFormRegRmImm2       : layout = "RMJ" ; break;
+        case kX86DecoderFormRegVvvvRm       : layout = "RVM" ; break;
+        case kX86DecoderFormRegVvvvRmIs4    : layout = "RVMS"; break;
+        case kX86DecoderFormRegVvvvRmImm    : layout = "RVMI"; break;
+        case kX86DecoderFormRegRmVvvv       : layout = "RMV" ; break;
+        case kX86DecoderFormRegRmVvvvImm    : layout = "RMVI"; break;
+        case kX86DecoderFormRmVvvvReg       : layout = "MVR" ; break;
+        case kX86DecoderFormVvvvRm          : layout = "VM"  ; break;
+        case kX86DecoderFormVvvvRmImm       : layout = "VMI" ; break;
+        case kX86DecoderFormFma4            : layout = s.w ? "RVSM" : "RVMS"; break;
+        case kX86DecoderFormXopRmv          : layout = s.w ? "RVM" : "RMV"; break;
+
+        case kX86DecoderFormGather: {
+          uint32_t lType = s.l ? kX86RegTypeYmm : kX86RegTypeXmm;
+          uint32_t dType = fData ? static_cast<uint32_t>(kX86RegTypeXmm) : lType;
+
+          vsibType = (s.opCode & 0x1) || !s.w ? lType : static_cast<uint32_t>(kX86RegTypeXmm);
+          ops[count++] = x86DecoderReg(dType, regIndex);
+          ops[count++] = x86DecoderMem(s, arch, p, 0, vsibType, 0);
+          ops[count++] = x86DecoderReg(dType, s.vvvv);
+          break;
+        }
+
+        default:
+          return kErrorUnknownInst;
+      }
+
+      uint32_t imm = s.immSize != 0 ? Utils::readU8(p + s.immOffset) : 0;
+      for (uint32_t i = 0; layout[i] != '\0'; i++) {
+        uint32_t cls = i < 2 ? static_cast<uint32_t>((fData >> (i * 4)) & 0xF) : static_cast<uint32_t>(kX86DecoderClassAuto);
+        uint32_t opFlags = i < 5 ? extendedInfo.getOperandFlags(i) : 0;
+
+        switch (layout[i]) {
+          case 'R':
+            ops[count++] = x86DecoderReg(x86DecoderRegType(s, arch, cls, opFlags, extra66), regIndex);
+            break;
+
+          case 'V':
+            ops[count++] = x86DecoderReg(x86DecoderRegType(s, arch, cls, opFlags, extra66), s.vvvv);
+            break;
+
+          case 'M':
+            if (rmIsReg)
+              ops[count++] = x86DecoderReg(x86DecoderRegType(s, arch, cls, opFlags, extra66), rmIndex);
+            else
+              ops[count++] = x86DecoderMem(s, arch, p, memSize, 0, dispShift);
+            break;
+
+          case 'S':
+            ops[count++] = x86DecoderReg(x86DecoderRegType(s, arch, cls, opFlags, extra66), arch == kArchX64 ? imm >> 4 : (imm >> 4) & 0x7);
+            break;
+
+          case 'I':
+            ops[count++] = Imm(imm);
+            break;
+
+          case 'J':
+            ops[count++] = Imm(imm);
+            ops[count++] = Imm(Utils::readU8(p + s.immOffset + 1));
+            break;
+        }
+      }
+      break;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Options]
+  // --------------------------------------------------------------------------
+
+  switch (s.kind) {
+    case kX86DecoderKindLegacy:
+      if (s.rex == 0x40 && form != kX86DecoderFormRel)
+        options |= kX86InstOptionRex;
+      break;
+
+    case kX86DecoderKindRex2:
+      if ((s.payload & 0x70) == 0)
+        options |= kX86InstOptionRex2;
+      break;
+
+    case kX86DecoderKindVex3:
+      if (s.space == kX86DecoderSpaceVex + 1 && !s.w && (s.payload & 0x60) == 0x60)
+        options |= kX86InstOptionVex3;
+      break;
+
+    case kX86DecoderKindEvex: {
+      uint32_t evexOptions = (s.aaa << kX86InstOptionEvexK_Shift) | (s.z ? kX86InstOptionEvexZero : 0);
+
+      if (s.b) {
+        if (!rmIsReg) {
+          evexOptions |= kX86InstOptionEvexOneN;
+        }
+        else if (extendedInfo.hasFlag(kX86InstFlagAvx512Rnd)) {
+          static const uint32_t rounding[4] = {
+            kX86InstOptionEvexRnSae, kX86InstOptionEvexRdSae, kX86InstOptionEvexRuSae, kX86InstOptionEvexRzSae
+          };
+          evexOptions |= rounding[s.l];
+        }
+        else {
+          evexOptions |= kX86InstOptionEvexSae;
+        }
+      }
+
+      // EVEX is implied by masking, broadcast, rounding, ZMM, and registers
+      // that VEX can't encode.
+      bool implied = evexOptions != 0 || extendedInfo.hasFlag(kX86InstFlagEvex) || (s.rExt | s.vvvv) >= 16 ||
+                     (rmIsReg ? (s.rmExt & 0x10) != 0 : ((s.bExt | s.xExt) & 0x10) != 0);
+
+      for (uint32_t i = 0; i < count && !implied; i++)
+        implied = ops[i].isRegType(kX86RegTypeZmm);
+
+      if (!implied)
+        evexOptions |= kX86InstOptionEvex;
+
+      options |= evexOptions;
+      break;
+    }
+
+    case kX86DecoderKindApx:
+      if (s.nf)
+        options |= kX86InstOptionNf;
+
+      // NDD form - the destination is `vvvv`.
+      if (s.nd && count < 4) {
+        for (uint32_t i = count; i != 0; i--)
+          ops[i] = ops[i - 1];
+        ops[0] = x86DecoderGpReg(s, opSize, s.vvvv);
+        count++;
+      }
+      break;
+  }
+
+  if (s.prefixes & kX86DecoderPrefixF0)
+    options |= kX86InstOptionLock;
+
+  inst.instId = pattern->instId;
+  inst.options = options;
+  inst.opCount = count;
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Decoder - GetLength]
+// ============================================================================
+
+size_t X86Decoder::getLength(uint32_t arch, const void* data, size_t size) noexcept {
+  X86DecoderState s;
+
+  if (x86DecoderParse(s, arch, static_cast<const uint8_t*>(data), size) != kErrorOk)
+    return 0;
+
+  return s.size;
+}
+
+// ============================================================================
+// [asmjit::X86Decoder - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+UNIT(x86_decoder) {
+  X86DecodedInst inst;
+
+  INFO("Checking X86Decoder::getLength().");
+  {
+    static const struct {
+      uint32_t arch;
+      uint8_t size;
+      uint8_t length;
+      uint8_t data[15];
+    } lengths[] = {
+      { kArchX64, 1 , 1 , { 0xC3 } },                                        // ret
+      { kArchX64, 5 , 5 , { 0x48, 0x8B, 0x44, 0x24, 0x08 } },                // mov rax, [rsp+8]
+      { kArchX64, 6 , 6 , { 0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00 } },          // nop word [rax+rax]
+      { kArchX64, 10, 10, { 0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8 } },          // mov rax, imm64
+      { kArchX64, 10, 10, { 0x66, 0x81, 0x84, 0x88, 1, 2, 3, 4, 5, 6 } },    // add word [rax+rcx*4+disp32], imm16
+      { kArchX64, 7 , 0 , { 0x48, 0xF7, 0x05, 1, 2, 3, 4 } },                // test qword [rip+disp32], imm32 (truncated)
+      { kArchX64, 5 , 0 , { 0xC4, 0xE3, 0x79, 0x14, 0xC0 } },                // vpextrb eax, xmm0, imm8 (truncated)
+      { kArchX64, 7 , 7 , { 0x62, 0xF1, 0x74, 0x48, 0x58, 0x42, 0x01 } },    // vaddps zmm0, zmm1, [rdx+64]
+      { kArchX64, 6 , 6 , { 0x62, 0xF4, 0x7C, 0x18, 0x01, 0xC8 } },          // add eax, eax, ecx (APX)
+      { kArchX64, 4 , 4 , { 0xD5, 0x10, 0xFF, 0xC0 } },                      // inc r24d (REX2)
+      { kArchX86, 5 , 5 , { 0xE8, 1, 2, 3, 4 } },                            // call rel32
+      { kArchX86, 5 , 5 , { 0x67, 0x8B, 0x87, 1, 2 } },                      // mov eax, [bx+disp16]
+      { kArchX86, 6 , 6 , { 0xDD, 0x05, 1, 2, 3, 4 } },                      // fld qword [disp32]
+      { kArchX86, 2 , 1 , { 0x9B, 0x90 } }                                   // fwait (not a prefix)
+    };
+
+    for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(lengths); i++) {
+      size_t length = X86Decoder::getLength(lengths[i].arch, lengths[i].data, lengths[i].size);
+      EXPECT(length == lengths[i].length,
+        "Length of instruction #%u is %u, expected %u.", i, static_cast<unsigned int>(length), static_cast<unsigned int>(lengths[i].length));
+    }
+  }
+
+  INFO("Checking X86Decoder::decode() of 64-bit instructions.");
+  {
+    X86Decoder decoder(kArchX64);
+    EXPECT(decoder.isInitialized(),
+      "X86Decoder should be initialized.");
+
+    static const uint8_t code[] = {
+      0x48, 0x8B, 0x44, 0x24, 0x08,                                          // mov rax, [rsp+8]
+      0x83, 0xC1, 0xFF,                                                      // add ecx, -1
+      0x40, 0x88, 0xF0,                                                      // mov al, sil
+      0x88, 0xF0,                                                            // mov al, dh
+      0xE8, 0x00, 0x01, 0x00, 0x00,                                          // call +256
+      0xC5, 0xF4, 0x58, 0xC2,                                                // vaddps ymm0, ymm1, ymm2
+      0x62, 0xF1, 0x74, 0xC9, 0x58, 0xC2,                                    // vaddps zmm0 {k1}{z}, zmm1, zmm2
+      0x0F, 0x04                                                             // (unknown)
+    };
+
+    size_t offset = 0;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'mov'.");
+    EXPECT(inst.instId == kX86InstIdMov && inst.size == 5 && inst.opCount == 2, "Invalid 'mov' instruction.");
+    EXPECT(inst.operands[0].isRegCode(kX86RegTypeGpq, kX86RegIndexAx), "Invalid 'mov' destination.");
+    EXPECT(inst.operands[1].isMem() && static_cast<X86Mem&>(inst.operands[1]).getBase() == kX86RegIndexSp &&
+           static_cast<X86Mem&>(inst.operands[1]).getDisplacement() == 8 &&
+           inst.operands[1].getSize() == 8, "Invalid 'mov' source.");
+    EXPECT(inst.dispOffset == 4 && inst.dispSize == 1, "Invalid 'mov' displacement.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'add'.");
+    EXPECT(inst.instId == kX86InstIdAdd && inst.size == 3, "Invalid 'add' instruction.");
+    EXPECT(inst.operands[0].isRegCode(kX86RegTypeGpd, kX86RegIndexCx), "Invalid 'add' destination.");
+    EXPECT(inst.operands[1].isImm() && static_cast<Imm&>(inst.operands[1]).getInt64() == -1, "Invalid 'add' immediate.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'mov al, sil'.");
+    EXPECT(inst.operands[1].isRegCode(kX86RegTypeGpbLo, kX86RegIndexSi) && inst.options == kX86InstOptionRex,
+      "Invalid 'mov al, sil' source.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'mov al, dh'.");
+    EXPECT(inst.operands[1].isRegCode(kX86RegTypeGpbHi, kX86RegIndexDx), "Invalid 'mov al, dh' source.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset, 0x1000) == kErrorOk, "Failed to decode 'call'.");
+    EXPECT(inst.instId == kX86InstIdCall && inst.operands[0].isImm() &&
+           static_cast<Imm&>(inst.operands[0]).getUInt64() == 0x1000 + 5 + 256, "Invalid 'call' target.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'vaddps' (VEX).");
+    EXPECT(inst.instId == kX86InstIdVaddps && inst.opCount == 3 && inst.options == 0, "Invalid 'vaddps' (VEX) instruction.");
+    EXPECT(inst.operands[0].isRegCode(kX86RegTypeYmm, 0) &&
+           inst.operands[1].isRegCode(kX86RegTypeYmm, 1) &&
+           inst.operands[2].isRegCode(kX86RegTypeYmm, 2), "Invalid 'vaddps' (VEX) operands.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'vaddps' (EVEX).");
+    EXPECT(inst.instId == kX86InstIdVaddps && inst.operands[0].isRegCode(kX86RegTypeZmm, 0), "Invalid 'vaddps' (EVEX) instruction.");
+    EXPECT(inst.options == ((1 << kX86InstOptionEvexK_Shift) | kX86InstOptionEvexZero), "Invalid 'vaddps' (EVEX) options.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorUnknownInst && inst.size == 2,
+      "Unknown instruction should be reported with its size.");
+  }
+
+  INFO("Checking X86Decoder::decode() of 32-bit instructions.");
+  {
+    X86Decoder decoder(kArchX86);
+
+    static const uint8_t code[] = {
+      0x41,                                                                  // inc ecx
+      0x66, 0x50,                                                            // push ax
+      0x9B, 0xDD, 0x30                                                       // fsave [eax]
+    };
+
+    size_t offset = 0;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'inc'.");
+    EXPECT(inst.instId == kX86InstIdInc && inst.operands[0].isRegCode(kX86RegTypeGpd, kX86RegIndexCx), "Invalid 'inc' instruction.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'push'.");
+    EXPECT(inst.instId == kX86InstIdPush && inst.operands[0].isRegCode(kX86RegTypeGpw, kX86RegIndexAx), "Invalid 'push' instruction.");
+
+    offset += inst.size;
+    EXPECT(decoder.decode(inst, code + offset, sizeof(code) - offset) == kErrorOk, "Failed to decode 'fsave'.");
+    EXPECT(inst.instId == kX86InstIdFsave && inst.size == 3, "Invalid 'fsave' instruction.");
+  }
+
+  INFO("Checking X86Decoder::decode() of assembled code.");
+  {
+    JitRuntime runtime;
+    X86Assembler a(&runtime, kArchX64);
+    X86Decoder decoder(kArchX64);
+
+    a.mov(x86::r12, x86::qword_ptr(x86::r13, x86::r14, 3, 0x1000));
+    a.imul(x86::esi, x86::dword_ptr(x86::rbp, -4), 1000);
+    a.sar(x86::word_ptr(x86::rax), 3);
+    a.movdqa(x86::xmm9, x86::xmm1);
+    a.vpshufd(x86::ymm3, x86::yword_ptr(x86::rcx, 32), 0x1B);
+
+    static const uint32_t ids[] = {
+      kX86InstIdMov, kX86InstIdImul, kX86InstIdSar, kX86InstIdMovdqa, kX86InstIdVpshufd
+    };
+
+    const uint8_t* code = a.getBuffer();
+    size_t codeSize = a.getOffset();
+    size_t offset = 0;
+
+    for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(ids); i++) {
+      EXPECT(decoder.decode(inst, code + offset, codeSize - offset) == kErrorOk,
+        "Failed to decode instruction #%u.", i);
+      EXPECT(inst.instId == ids[i],
+        "Instruction #%u decoded as %u, expected %u.", i, inst.instId, ids[i]);
+      offset += inst.size;
+    }
+
+    EXPECT(offset == codeSize,
+      "Decoded %u bytes, expected %u.", static_cast<unsigned int>(offset), static_cast<unsigned int>(codeSize));
+  }
+}
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64
@@ -0,0 +1,227 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Guard]
+#ifndef _ASMJIT_X86_X86DECODER_H
+#define _ASMJIT_X86_X86DECODER_H
+
+// [Dependencies]
+#include "../base/podvector.h"
+#include "../x86/x86inst.h"
+#include "../x86/x86operand.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+//! \addtogroup asmjit_x86
+//! \{
+
+// ============================================================================
+// [asmjit::X86DecodedInst]
+// ============================================================================
+
+//! X86/X64 instruction decoded by `X86Decoder`.
+//!
+//! Operands use the same order and the same operand types as `X86Assembler`,
+//! so the instruction can be passed back to `X86Assembler::emit()`. Relative
+//! targets of jumps and calls are resolved to absolute addresses and stored
+//! as immediate operands.
+struct X86DecodedInst {
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE X86DecodedInst() noexcept { reset(); }
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  //! Reset the instruction to its initial state.
+  ASMJIT_INLINE void reset() noexcept {
+    instId = kInstIdNone;
+    options = 0;
+    size = 0;
+    opCount = 0;
+    dispOffset = 0;
+    dispSize = 0;
+    immOffset = 0;
+    immSize = 0;
+
+    for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(operands); i++)
+      operands[i] = noOperand;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Instruction id, `kInstIdNone` if the instruction is unknown.
+  uint32_t instId;
+  //! Instruction options, see \ref InstOptions and \ref X86InstOptions.
+  //!
+  //! Only options that change the encoding and can't be derived from the
+  //! operands are reported, for example `kX86InstOptionVex3` if the 3-byte
+  //! VEX prefix was used where the 2-byte one would do.
+  uint32_t options;
+  //! Instruction length in bytes, including all prefixes.
+  uint32_t size;
+  //! Count of operands.
+  uint32_t opCount;
+
+  //! Offset of the displacement or relative target (zero if none).
+  uint8_t dispOffset;
+  //! Size of the displacement or relative target (zero if none).
+  uint8_t dispSize;
+  //! Offset of the immediate value (zero if none).
+  uint8_t immOffset;
+  //! Size of the immediate value (zero if none).
+  uint8_t immSize;
+
+  //! Operands.
+  Operand operands[4];
+};
+
+// ============================================================================
+// [asmjit::X86DecoderPattern]
+// ============================================================================
+
+//! \internal
+//!
+//! Opcode pattern matched by `X86Decoder`, see x86decoder.cpp.
+struct X86DecoderPattern {
+  //! Instruction id.
+  uint16_t instId;
+  //! Index of the next pattern of the same opcode, `0xFFFF` terminates.
+  uint16_t next;
+  //! Operand layout.
+  uint8_t form;
+  //! Form specific data.
+  uint8_t data;
+  //! Mandatory prefixes.
+  uint8_t prefixes;
+  //! Matching flags.
+  uint8_t flags;
+  //! ModR/M mask, zero if the ModR/M byte is not matched.
+  uint8_t modRmMask;
+  //! ModR/M value (after applying `modRmMask`).
+  uint8_t modRmValue;
+  //! Score, the most specific pattern that matches wins.
+  uint8_t score;
+  //! Reserved.
+  uint8_t reserved;
+};
+
+// ============================================================================
+// [asmjit::X86Decoder]
+// ============================================================================
+
+//! X86/X64 instruction decoder.
+//!
+//! Decoder recovers the length, instruction id, options and operands of
+//! instructions from a byte stream. It's table-driven - the length is given
+//! by a few small tables indexed by the opcode, and the instruction id is
+//! matched against patterns generated from the `X86InstInfo` table when the
+//! decoder is created, so the decoder knows exactly the instructions the
+//! assembler can emit.
+//!
+//! The decoder is intended for tools that inspect or patch machine code, for
+//! example to find instruction boundaries, displacements and immediates. If
+//! only the length is needed use the static `getLength()`, which doesn't need
+//! the patterns at all.
+//!
+//! Decoded operands are equivalent to the encoding, but not necessarily the
+//! same as the operands passed to the assembler. Aliases (like `sal` and
+//! `shl`) always decode to the instruction with the lowest id, and register
+//! and memory sizes are only recovered if the encoding defines them.
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! X86Decoder decoder(kArchX64);
+//! X86DecodedInst inst;
+//!
+//! const uint8_t code[] = { 0x48, 0x8B, 0x44, 0x24, 0x08, 0xC3 };
+//! size_t offset = 0;
+//!
+//! while (offset < sizeof(code)) {
+//!   if (decoder.decode(inst, code + offset, sizeof(code) - offset) != kErrorOk)
+//!     break;
+//!
+//!   // inst.instId == kX86InstIdMov, then kX86InstIdRet.
+//!   offset += inst.size;
+//! }
+//! ~~~
+class X86Decoder {
+ public:
+  ASMJIT_NO_COPY(X86Decoder)
+
+  //! Count of opcode spaces (legacy maps, VEX, XOP, and EVEX maps).
+  enum { kSpaceCount = 15 };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a `X86Decoder` instance for `arch`, either `kArchX86` or `kArchX64`.
+  ASMJIT_API X86Decoder(uint32_t arch = kArchHost) noexcept;
+  //! Destroy the `X86Decoder` instance.
+  ASMJIT_API ~X86Decoder() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the target architecture.
+  ASMJIT_INLINE uint32_t getArch() const noexcept { return _arch; }
+  //! Get the size of a general purpose register of the target architecture.
+  ASMJIT_INLINE uint32_t getRegSize() const noexcept { return _arch == kArchX64 ? 8 : 4; }
+
+  //! Get whether the decoder was initialized, it can only fail if the system
+  //! runs out of memory or `arch` is not an X86 architecture.
+  ASMJIT_INLINE bool isInitialized() const noexcept { return _patterns.getLength() != 0; }
+
+  // --------------------------------------------------------------------------
+  // [Decode]
+  // --------------------------------------------------------------------------
+
+  //! Decode a single instruction from `data` of `size` bytes and store it
+  //! into `inst`. The `address` is the address of the instruction, used to
+  //! resolve targets of relative jumps and calls.
+  //!
+  //! Returns `kErrorIllegalInst` if the instruction is truncated or malformed
+  //! and `kErrorUnknownInst` if the instruction is well-formed, but the
+  //! assembler doesn't know it - the `size` member is valid in that case so
+  //! the caller can skip the instruction.
+  ASMJIT_API Error decode(X86DecodedInst& inst, const void* data, size_t size, Ptr address = 0) const noexcept;
+
+  //! Get the length of a single instruction stored in `data` of `size` bytes,
+  //! returns zero if the instruction is truncated or malformed.
+  static ASMJIT_API size_t getLength(uint32_t arch, const void* data, size_t size) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Target architecture.
+  uint32_t _arch;
+  //! First pattern of each opcode of each space, `0xFFFF` if none.
+  uint16_t _heads[kSpaceCount][256];
+  //! Patterns.
+  PodVector<X86DecoderPattern> _patterns;
+};
+
+//! \}
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // _ASMJIT_X86_X86DECODER_H
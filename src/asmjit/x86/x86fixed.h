@@ -0,0 +1,345 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Guard]
+#ifndef _ASMJIT_X86_X86FIXED_H
+#define _ASMJIT_X86_X86FIXED_H
+
+// [Dependencies]
+#include "../base/utils.h"
+#include "../x86/x86assembler.h"
+#include "../x86/x86inst.h"
+#include "../x86/x86operand.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+//! \addtogroup asmjit_x86
+//! \{
+
+// ============================================================================
+// [asmjit::X86FixedReg]
+// ============================================================================
+
+//! Register known at compile-time, used by fixed instructions.
+//!
+//! Only 32-bit and 64-bit GP registers are supported. The 64-bit registers
+//! and registers R8..R15 can only be used in 64-bit mode, R16..R31 (APX) are
+//! not supported.
+template<uint32_t Type, uint32_t Index>
+struct X86FixedReg {
+  enum {
+    //! Register type, see \ref X86RegType.
+    kType = Type,
+    //! Register index.
+    kIndex = Index,
+    //! Register size.
+    kSize = Type == kX86RegTypeGpq ? 8 : 4,
+    //! Whether the register is only available in 64-bit mode.
+    kX64Only = Type == kX86RegTypeGpq || Index >= 8
+  };
+
+  //! Get the register as `X86GpReg`.
+  static ASMJIT_INLINE X86GpReg toReg() noexcept { return X86GpReg(Type, Index, kSize); }
+};
+
+//! 32-bit GP register known at compile-time.
+template<uint32_t Index>
+struct X86FixedGpd : public X86FixedReg<kX86RegTypeGpd, Index> {};
+
+//! 64-bit GP register known at compile-time.
+template<uint32_t Index>
+struct X86FixedGpq : public X86FixedReg<kX86RegTypeGpq, Index> {};
+
+// ============================================================================
+// [asmjit::X86FixedBytes]
+// ============================================================================
+
+//! \internal
+//!
+//! Encode `[REX] [0F] OpCode [ModR/M]` at compile-time. `OpCode` uses the same
+//! format as opcodes stored in `X86InstInfo`, only `kX86InstOpCode_W` and
+//! `kX86InstOpCode_MM_0F` flags are allowed. `ModRM` greater than 0xFF means
+//! that the instruction has no ModR/M byte.
+template<uint32_t OpCode, uint32_t Rex, uint32_t ModRM>
+struct X86FixedBytes {
+  enum {
+    kRex = Rex | ((OpCode & kX86InstOpCode_W) ? 0x08 : 0x00),
+    kRexSize = kRex != 0,
+    kMMSize = (OpCode & kX86InstOpCode_MM_Mask) == kX86InstOpCode_MM_0F,
+    kModSize = ModRM <= 0xFF,
+
+    //! Size of the encoded instruction, without immediate.
+    kSize = kRexSize + kMMSize + 1 + kModSize
+  };
+
+  //! Encoded instruction packed into 32-bit integer (little-endian).
+  static const uint32_t kPacked =
+    (kRexSize ? static_cast<uint32_t>(0x40 | kRex) : 0u) |
+    (kMMSize ? static_cast<uint32_t>(0x0F) << (kRexSize * 8) : 0u) |
+    (static_cast<uint32_t>(OpCode & 0xFF) << ((kRexSize + kMMSize) * 8)) |
+    (kModSize ? static_cast<uint32_t>(ModRM & 0xFF) << ((kRexSize + kMMSize + 1) * 8) : 0u);
+
+  //! Write the instruction to `cursor`, there must be at least 4 bytes available.
+  static ASMJIT_INLINE uint8_t* encode(uint8_t* cursor) noexcept {
+    Utils::writeU32uLE(cursor, kPacked);
+    return cursor + kSize;
+  }
+};
+
+// ============================================================================
+// [asmjit::X86FixedInst]
+// ============================================================================
+
+//! \internal
+//!
+//! Common base of fixed instructions.
+template<uint32_t InstId, typename Bytes, uint32_t ImmSize, bool X64Only>
+struct X86FixedInst {
+  enum {
+    //! Instruction id, see \ref X86InstId.
+    kInstId = InstId,
+    //! Size of the encoded instruction, without immediate.
+    kSize = Bytes::kSize,
+    //! Size of the immediate patched at runtime (0, 1, or 4).
+    kImmSize = ImmSize,
+    //! Number of bytes that must be available in the code-buffer.
+    kMaxSize = Bytes::kSize + ImmSize + 4,
+    //! Whether the instruction can only be encoded in 64-bit mode.
+    kX64Only = X64Only
+  };
+
+  static ASMJIT_INLINE uint8_t* encode(uint8_t* cursor) noexcept {
+    return Bytes::encode(cursor);
+  }
+
+  static ASMJIT_INLINE uint8_t* encode(uint8_t* cursor, int64_t imm) noexcept {
+    cursor = Bytes::encode(cursor);
+    if (ImmSize == 1)
+      cursor[0] = static_cast<uint8_t>(imm & 0xFF);
+    else
+      Utils::writeU32uLE(cursor, static_cast<uint32_t>(imm));
+    return cursor + ImmSize;
+  }
+};
+
+//! Fixed instruction without operands.
+template<uint32_t InstId, uint32_t OpCode>
+struct X86FixedOp
+  : public X86FixedInst<InstId, X86FixedBytes<OpCode, 0, 0x100>, 0, false> {
+
+  static ASMJIT_INLINE Error emitGeneric(X86Assembler& a) noexcept {
+    return a.emit(InstId);
+  }
+};
+
+//! Fixed instruction that encodes register in the opcode (push, pop, ...).
+template<uint32_t InstId, uint32_t OpCode, typename R0>
+struct X86FixedO
+  : public X86FixedInst<InstId, X86FixedBytes<(OpCode + (R0::kIndex & 0x07)), (R0::kIndex >> 3), 0x100>, 0, (R0::kIndex >= 8)> {
+
+  static ASMJIT_INLINE Error emitGeneric(X86Assembler& a) noexcept {
+    return a.emit(InstId, R0::toReg());
+  }
+};
+
+//! Fixed instruction with two register operands, `R0` is encoded in ModR/M.reg
+//! and `R1` in ModR/M.rm, unless `Swap` is true.
+template<uint32_t InstId, uint32_t OpCode, typename R0, typename R1, bool Swap = false>
+struct X86FixedRR
+  : public X86FixedInst<InstId,
+      X86FixedBytes<(OpCode | (R0::kType == kX86RegTypeGpq ? kX86InstOpCode_W : 0)),
+        ((((Swap ? R1::kIndex : R0::kIndex) & 0x08) >> 1) | ((Swap ? R0::kIndex : R1::kIndex) >> 3)),
+        (0xC0 | (((Swap ? R1::kIndex : R0::kIndex) & 0x07) << 3) | ((Swap ? R0::kIndex : R1::kIndex) & 0x07))>,
+      0, (R0::kX64Only || R1::kX64Only)> {
+
+  static ASMJIT_INLINE Error emitGeneric(X86Assembler& a) noexcept {
+    return a.emit(InstId, R0::toReg(), R1::toReg());
+  }
+};
+
+//! Fixed instruction with a register operand and an immediate patched at
+//! runtime. `OpReg` is ModR/M.reg (`/digit`). If `AltOpCode` is non-zero it's
+//! used instead of `OpCode` when `R0` is EAX/RAX and the immediate is 32-bit.
+template<uint32_t InstId, uint32_t OpCode, uint32_t OpReg, typename R0, uint32_t ImmSize, uint32_t AltOpCode = 0>
+struct X86FixedRI
+  : public X86FixedInst<InstId,
+      X86FixedBytes<((AltOpCode != 0 && ImmSize == 4 && R0::kIndex == 0 ? AltOpCode : OpCode) | (R0::kType == kX86RegTypeGpq ? kX86InstOpCode_W : 0)),
+        (R0::kIndex >> 3),
+        ((AltOpCode != 0 && ImmSize == 4 && R0::kIndex == 0) ? 0x100 : (0xC0 | (OpReg << 3) | (R0::kIndex & 0x07)))>,
+      ImmSize, R0::kX64Only> {
+
+  static ASMJIT_INLINE Error emitGeneric(X86Assembler& a, int64_t imm) noexcept {
+    return a.emit(InstId, R0::toReg(), Imm(imm));
+  }
+};
+
+//! Sequence of two fixed instructions without immediates, sequences can be
+//! nested to form longer sequences.
+template<typename I0, typename I1>
+struct X86FixedSeq {
+  enum {
+    kSize = I0::kSize + I1::kSize,
+    kImmSize = 0,
+    kMaxSize = I0::kSize + I1::kSize + 4,
+    kX64Only = I0::kX64Only || I1::kX64Only
+  };
+
+  static ASMJIT_INLINE uint8_t* encode(uint8_t* cursor) noexcept {
+    return I1::encode(I0::encode(cursor));
+  }
+
+  static ASMJIT_INLINE Error emitGeneric(X86Assembler& a) noexcept {
+    ASMJIT_PROPAGATE_ERROR(I0::emitGeneric(a));
+    return I1::emitGeneric(a);
+  }
+};
+
+// ============================================================================
+// [asmjit::X86Fixed - Instructions]
+// ============================================================================
+
+template<typename D, typename S> struct X86FixedAdd  : public X86FixedRR<kX86InstIdAdd , 0x03, D, S> {};
+template<typename D, typename S> struct X86FixedAnd  : public X86FixedRR<kX86InstIdAnd , 0x23, D, S> {};
+template<typename D, typename S> struct X86FixedCmp  : public X86FixedRR<kX86InstIdCmp , 0x3B, D, S> {};
+template<typename D, typename S> struct X86FixedImul : public X86FixedRR<kX86InstIdImul, kX86InstOpCode_MM_0F | 0xAF, D, S> {};
+template<typename D, typename S> struct X86FixedMov  : public X86FixedRR<kX86InstIdMov , 0x8B, D, S> {};
+template<typename D, typename S> struct X86FixedOr   : public X86FixedRR<kX86InstIdOr  , 0x0B, D, S> {};
+template<typename D, typename S> struct X86FixedSub  : public X86FixedRR<kX86InstIdSub , 0x2B, D, S> {};
+template<typename D, typename S> struct X86FixedTest : public X86FixedRR<kX86InstIdTest, 0x85, D, S, true> {};
+template<typename D, typename S> struct X86FixedXor  : public X86FixedRR<kX86InstIdXor , 0x33, D, S> {};
+
+template<typename R> struct X86FixedPush : public X86FixedO<kX86InstIdPush, 0x50, R> {};
+template<typename R> struct X86FixedPop  : public X86FixedO<kX86InstIdPop , 0x58, R> {};
+
+template<typename R> struct X86FixedAddI8  : public X86FixedRI<kX86InstIdAdd, 0x83, 0, R, 1> {};
+template<typename R> struct X86FixedAddI32 : public X86FixedRI<kX86InstIdAdd, 0x81, 0, R, 4, 0x05> {};
+template<typename R> struct X86FixedSubI8  : public X86FixedRI<kX86InstIdSub, 0x83, 5, R, 1> {};
+template<typename R> struct X86FixedSubI32 : public X86FixedRI<kX86InstIdSub, 0x81, 5, R, 4, 0x2D> {};
+template<typename R> struct X86FixedCmpI8  : public X86FixedRI<kX86InstIdCmp, 0x83, 7, R, 1> {};
+template<typename R> struct X86FixedCmpI32 : public X86FixedRI<kX86InstIdCmp, 0x81, 7, R, 4, 0x3D> {};
+
+//! \internal
+//!
+//! MOV r64, imm32 (sign-extended) uses ModR/M, MOV r32, imm32 encodes the
+//! register in the opcode.
+template<typename R, bool IsGpq>
+struct X86FixedMovI32Impl : public X86FixedRI<kX86InstIdMov, 0xC7, 0, R, 4> {};
+
+template<typename R>
+struct X86FixedMovI32Impl<R, false>
+  : public X86FixedInst<kX86InstIdMov, X86FixedBytes<(0xB8 + (R::kIndex & 0x07)), (R::kIndex >> 3), 0x100>, 4, R::kX64Only> {
+
+  static ASMJIT_INLINE Error emitGeneric(X86Assembler& a, int64_t imm) noexcept {
+    return a.emit(kX86InstIdMov, R::toReg(), Imm(imm));
+  }
+};
+
+//! Move 32-bit immediate, sign-extended if `R` is a 64-bit register.
+template<typename R>
+struct X86FixedMovI32 : public X86FixedMovI32Impl<R, (R::kType == kX86RegTypeGpq)> {};
+
+struct X86FixedInt3 : public X86FixedInst<kX86InstIdInt, X86FixedBytes<0xCC, 0, 0x100>, 0, false> {
+  static ASMJIT_INLINE Error emitGeneric(X86Assembler& a) noexcept {
+    return a.emit(kX86InstIdInt, Imm(3));
+  }
+};
+
+struct X86FixedLeave : public X86FixedOp<kX86InstIdLeave, 0xC9> {};
+struct X86FixedNop   : public X86FixedOp<kX86InstIdNop  , 0x90> {};
+struct X86FixedRet   : public X86FixedOp<kX86InstIdRet  , 0xC3> {};
+
+// ============================================================================
+// [asmjit::X86Fixed]
+// ============================================================================
+
+//! Emitter of instructions and sequences encoded at compile-time.
+//!
+//! Fixed instructions are templates having instruction and register operands
+//! as template arguments, their bytes are computed by the compiler and stored
+//! directly at `Assembler::_cursor`. Only immediates are written at runtime.
+//! For example the following emits `push rbp; mov rbp, rsp; sub rsp, 64`:
+//!
+//! ~~~
+//! typedef X86FixedGpq<kX86RegIndexBp> Rbp;
+//! typedef X86FixedGpq<kX86RegIndexSp> Rsp;
+//!
+//! X86Fixed::emit<X86FixedSeq<X86FixedPush<Rbp>, X86FixedMov<Rbp, Rsp> > >(a);
+//! X86Fixed::emit<X86FixedSubI8<Rsp> >(a, 64);
+//! ~~~
+//!
+//! NOTE: If the assembler has a logger, there are instruction options set,
+//! or `kOptionAlignBranches` or `kOptionShortestEncoding` is enabled, the
+//! instruction is emitted through `X86Assembler::emit()` so it's logged,
+//! validated, and padded or shortened the same way as any other instruction.
+//! The generic encoder may pick a shorter form of `I32` instructions in that
+//! case.
+struct X86Fixed {
+  //! Assembler options that must be handled by `X86Assembler::emit()`.
+  static const uint32_t kGenericAsmOptions =
+    Assembler::kOptionAlignBranches |
+    Assembler::kOptionShortestEncoding;
+
+  //! Get whether the instruction must be emitted through the generic path.
+  static ASMJIT_INLINE bool needsGeneric(const X86Assembler& a) noexcept {
+    return a._logger != nullptr ||
+           a.getInstOptions() != 0 ||
+           (a.getAsmOptions() & kGenericAsmOptions) != 0;
+  }
+
+  //! Emit instruction or sequence `Inst`, which has no immediate.
+  template<typename Inst>
+  static ASMJIT_INLINE Error emit(X86Assembler& a) noexcept {
+    ASMJIT_ASSERT(Inst::kImmSize == 0);
+    ASMJIT_ASSERT(!Inst::kX64Only || a.getArch() == kArchX64);
+
+    if (ASMJIT_UNLIKELY(needsGeneric(a)))
+      return Inst::emitGeneric(a);
+
+    uint8_t* cursor = a.getCursor();
+    if (ASMJIT_UNLIKELY((size_t)(a._end - cursor) < static_cast<size_t>(Inst::kMaxSize))) {
+      ASMJIT_PROPAGATE_ERROR(a._grow(Inst::kMaxSize));
+      cursor = a.getCursor();
+    }
+
+    a._comment = nullptr;
+    a.setCursor(Inst::encode(cursor));
+    return kErrorOk;
+  }
+
+  //! Emit instruction `Inst` having immediate `imm`, which must fit into the
+  //! immediate size of the instruction.
+  template<typename Inst>
+  static ASMJIT_INLINE Error emit(X86Assembler& a, int64_t imm) noexcept {
+    ASMJIT_ASSERT(Inst::kImmSize == 1 ? Utils::isInt8(imm) : Utils::isInt32(imm) || Utils::isUInt32(imm));
+    ASMJIT_ASSERT(!Inst::kX64Only || a.getArch() == kArchX64);
+
+    if (ASMJIT_UNLIKELY(needsGeneric(a)))
+      return Inst::emitGeneric(a, imm);
+
+    uint8_t* cursor = a.getCursor();
+    if (ASMJIT_UNLIKELY((size_t)(a._end - cursor) < static_cast<size_t>(Inst::kMaxSize))) {
+      ASMJIT_PROPAGATE_ERROR(a._grow(Inst::kMaxSize));
+      cursor = a.getCursor();
+    }
+
+    a._comment = nullptr;
+    a.setCursor(Inst::encode(cursor, imm));
+    return kErrorOk;
+  }
+};
+
+//! \}
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // _ASMJIT_X86_X86FIXED_H
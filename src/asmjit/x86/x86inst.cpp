@@ -91,7 +91,23 @@ ASMJIT_ENUM(X86InstFlagsInternal) {
   kX86InstFlagMem2_4           = kX86InstFlagMem2        | kX86InstFlagMem4,
   kX86InstFlagMem2_4_8         = kX86InstFlagMem2_4      | kX86InstFlagMem8,
   kX86InstFlagMem4_8           = kX86InstFlagMem4        | kX86InstFlagMem8,
-  kX86InstFlagMem4_8_10        = kX86InstFlagMem4_8      | kX86InstFlagMem10
+  kX86InstFlagMem4_8_10        = kX86InstFlagMem4_8      | kX86InstFlagMem10,
+
+  // AVX-512 - Packed (full vector), broadcast, SAE, and rounding control.
+  kX86InstFlagAvx512FV         = kX86InstFlagAvx512F     | kX86InstFlagAvx512VL | kX86InstFlagAvx512KMask | kX86InstFlagAvx512KZero,
+  kX86InstFlagAvx512FVB        = kX86InstFlagAvx512FV    | kX86InstFlagAvx512BCast,
+  kX86InstFlagAvx512FVBS       = kX86InstFlagAvx512FVB   | kX86InstFlagAvx512Sae,
+  kX86InstFlagAvx512FVBR       = kX86InstFlagAvx512FVBS  | kX86InstFlagAvx512Rnd,
+  kX86InstFlagAvx512FVT1       = kX86InstFlagAvx512FV    | kX86InstFlagAvx512T1S,
+
+  // AVX-512 - Scalar, SAE, and rounding control.
+  kX86InstFlagAvx512FS         = kX86InstFlagAvx512F     | kX86InstFlagAvx512KMask | kX86InstFlagAvx512KZero | kX86InstFlagAvx512T1S,
+  kX86InstFlagAvx512FSS        = kX86InstFlagAvx512FS    | kX86InstFlagAvx512Sae,
+  kX86InstFlagAvx512FSR        = kX86InstFlagAvx512FSS   | kX86InstFlagAvx512Rnd,
+
+  // AVX-512 - BW and DQ extensions.
+  kX86InstFlagAvx512BWV        = kX86InstFlagAvx512BW    | kX86InstFlagAvx512VL | kX86InstFlagAvx512KMask | kX86InstFlagAvx512KZero,
+  kX86InstFlagAvx512DQVB       = kX86InstFlagAvx512DQ    | kX86InstFlagAvx512VL | kX86InstFlagAvx512KMask | kX86InstFlagAvx512KZero | kX86InstFlagAvx512BCast
 };
 
 // ============================================================================
@@ -204,202 +220,311 @@ static const char _x86InstNameData[] =
   "vandnps\0" "vandpd\0" "vandps\0" "vblendpd\0" "vblendps\0" "vblendvpd\0"
   "vblendvps\0" "vbroadcastf128\0" "vbroadcasti128\0" "vbroadcastsd\0"
   "vbroadcastss\0" "vcmppd\0" "vcmpps\0" "vcmpsd\0" "vcmpss\0" "vcomisd\0"
-  "vcomiss\0" "vcvtdq2pd\0" "vcvtdq2ps\0" "vcvtpd2dq\0" "vcvtpd2ps\0"
-  "vcvtph2ps\0" "vcvtps2dq\0" "vcvtps2pd\0" "vcvtps2ph\0" "vcvtsd2si\0"
-  "vcvtsd2ss\0" "vcvtsi2sd\0" "vcvtsi2ss\0" "vcvtss2sd\0" "vcvtss2si\0"
-  "vcvttpd2dq\0" "vcvttps2dq\0" "vcvttsd2si\0" "vcvttss2si\0" "vdivpd\0"
-  "vdivps\0" "vdivsd\0" "vdivss\0" "vdppd\0" "vdpps\0" "vextractf128\0"
-  "vextracti128\0" "vextractps\0" "vfmadd132pd\0" "vfmadd132ps\0"
-  "vfmadd132sd\0" "vfmadd132ss\0" "vfmadd213pd\0" "vfmadd213ps\0"
-  "vfmadd213sd\0" "vfmadd213ss\0" "vfmadd231pd\0" "vfmadd231ps\0"
-  "vfmadd231sd\0" "vfmadd231ss\0" "vfmaddpd\0" "vfmaddps\0" "vfmaddsd\0"
-  "vfmaddss\0" "vfmaddsub132pd\0" "vfmaddsub132ps\0" "vfmaddsub213pd\0"
-  "vfmaddsub213ps\0" "vfmaddsub231pd\0" "vfmaddsub231ps\0" "vfmaddsubpd\0"
-  "vfmaddsubps\0" "vfmsub132pd\0" "vfmsub132ps\0" "vfmsub132sd\0"
-  "vfmsub132ss\0" "vfmsub213pd\0" "vfmsub213ps\0" "vfmsub213sd\0"
-  "vfmsub213ss\0" "vfmsub231pd\0" "vfmsub231ps\0" "vfmsub231sd\0"
-  "vfmsub231ss\0" "vfmsubadd132pd\0" "vfmsubadd132ps\0" "vfmsubadd213pd\0"
-  "vfmsubadd213ps\0" "vfmsubadd231pd\0" "vfmsubadd231ps\0" "vfmsubaddpd\0"
-  "vfmsubaddps\0" "vfmsubpd\0" "vfmsubps\0" "vfmsubsd\0" "vfmsubss\0"
-  "vfnmadd132pd\0" "vfnmadd132ps\0" "vfnmadd132sd\0" "vfnmadd132ss\0"
-  "vfnmadd213pd\0" "vfnmadd213ps\0" "vfnmadd213sd\0" "vfnmadd213ss\0"
-  "vfnmadd231pd\0" "vfnmadd231ps\0" "vfnmadd231sd\0" "vfnmadd231ss\0"
-  "vfnmaddpd\0" "vfnmaddps\0" "vfnmaddsd\0" "vfnmaddss\0" "vfnmsub132pd\0"
-  "vfnmsub132ps\0" "vfnmsub132sd\0" "vfnmsub132ss\0" "vfnmsub213pd\0"
-  "vfnmsub213ps\0" "vfnmsub213sd\0" "vfnmsub213ss\0" "vfnmsub231pd\0"
-  "vfnmsub231ps\0" "vfnmsub231sd\0" "vfnmsub231ss\0" "vfnmsubpd\0"
-  "vfnmsubps\0" "vfnmsubsd\0" "vfnmsubss\0" "vfrczpd\0" "vfrczps\0" "vfrczsd\0"
-  "vfrczss\0" "vgatherdpd\0" "vgatherdps\0" "vgatherqpd\0" "vgatherqps\0"
-  "vhaddpd\0" "vhaddps\0" "vhsubpd\0" "vhsubps\0" "vinsertf128\0"
-  "vinserti128\0" "vinsertps\0" "vlddqu\0" "vldmxcsr\0" "vmaskmovdqu\0"
-  "vmaskmovpd\0" "vmaskmovps\0" "vmaxpd\0" "vmaxps\0" "vmaxsd\0" "vmaxss\0"
-  "vminpd\0" "vminps\0" "vminsd\0" "vminss\0" "vmovapd\0" "vmovaps\0" "vmovd\0"
-  "vmovddup\0" "vmovdqa\0" "vmovdqu\0" "vmovhlps\0" "vmovhpd\0" "vmovhps\0"
-  "vmovlhps\0" "vmovlpd\0" "vmovlps\0" "vmovmskpd\0" "vmovmskps\0" "vmovntdq\0"
-  "vmovntdqa\0" "vmovntpd\0" "vmovntps\0" "vmovq\0" "vmovsd\0" "vmovshdup\0"
-  "vmovsldup\0" "vmovss\0" "vmovupd\0" "vmovups\0" "vmpsadbw\0" "vmulpd\0"
-  "vmulps\0" "vmulsd\0" "vmulss\0" "vorpd\0" "vorps\0" "vpabsb\0" "vpabsd\0"
-  "vpabsw\0" "vpackssdw\0" "vpacksswb\0" "vpackusdw\0" "vpackuswb\0" "vpaddb\0"
-  "vpaddd\0" "vpaddq\0" "vpaddsb\0" "vpaddsw\0" "vpaddusb\0" "vpaddusw\0"
-  "vpaddw\0" "vpalignr\0" "vpand\0" "vpandn\0" "vpavgb\0" "vpavgw\0"
-  "vpblendd\0" "vpblendvb\0" "vpblendw\0" "vpbroadcastb\0" "vpbroadcastd\0"
-  "vpbroadcastq\0" "vpbroadcastw\0" "vpclmulqdq\0" "vpcmov\0" "vpcmpeqb\0"
-  "vpcmpeqd\0" "vpcmpeqq\0" "vpcmpeqw\0" "vpcmpestri\0" "vpcmpestrm\0"
-  "vpcmpgtb\0" "vpcmpgtd\0" "vpcmpgtq\0" "vpcmpgtw\0" "vpcmpistri\0"
-  "vpcmpistrm\0" "vpcomb\0" "vpcomd\0" "vpcomq\0" "vpcomub\0" "vpcomud\0"
-  "vpcomuq\0" "vpcomuw\0" "vpcomw\0" "vperm2f128\0" "vperm2i128\0" "vpermd\0"
-  "vpermil2pd\0" "vpermil2ps\0" "vpermilpd\0" "vpermilps\0" "vpermpd\0"
-  "vpermps\0" "vpermq\0" "vpextrb\0" "vpextrd\0" "vpextrq\0" "vpextrw\0"
-  "vpgatherdd\0" "vpgatherdq\0" "vpgatherqd\0" "vpgatherqq\0" "vphaddbd\0"
-  "vphaddbq\0" "vphaddbw\0" "vphaddd\0" "vphadddq\0" "vphaddsw\0" "vphaddubd\0"
-  "vphaddubq\0" "vphaddubw\0" "vphaddudq\0" "vphadduwd\0" "vphadduwq\0"
-  "vphaddw\0" "vphaddwd\0" "vphaddwq\0" "vphminposuw\0" "vphsubbw\0"
-  "vphsubd\0" "vphsubdq\0" "vphsubsw\0" "vphsubw\0" "vphsubwd\0" "vpinsrb\0"
-  "vpinsrd\0" "vpinsrq\0" "vpinsrw\0" "vpmacsdd\0" "vpmacsdqh\0" "vpmacsdql\0"
-  "vpmacssdd\0" "vpmacssdqh\0" "vpmacssdql\0" "vpmacsswd\0" "vpmacssww\0"
-  "vpmacswd\0" "vpmacsww\0" "vpmadcsswd\0" "vpmadcswd\0" "vpmaddubsw\0"
-  "vpmaddwd\0" "vpmaskmovd\0" "vpmaskmovq\0" "vpmaxsb\0" "vpmaxsd\0"
-  "vpmaxsw\0" "vpmaxub\0" "vpmaxud\0" "vpmaxuw\0" "vpminsb\0" "vpminsd\0"
-  "vpminsw\0" "vpminub\0" "vpminud\0" "vpminuw\0" "vpmovmskb\0" "vpmovsxbd\0"
-  "vpmovsxbq\0" "vpmovsxbw\0" "vpmovsxdq\0" "vpmovsxwd\0" "vpmovsxwq\0"
-  "vpmovzxbd\0" "vpmovzxbq\0" "vpmovzxbw\0" "vpmovzxdq\0" "vpmovzxwd\0"
-  "vpmovzxwq\0" "vpmuldq\0" "vpmulhrsw\0" "vpmulhuw\0" "vpmulhw\0" "vpmulld\0"
-  "vpmullw\0" "vpmuludq\0" "vpor\0" "vpperm\0" "vprotb\0" "vprotd\0" "vprotq\0"
-  "vprotw\0" "vpsadbw\0" "vpshab\0" "vpshad\0" "vpshaq\0" "vpshaw\0" "vpshlb\0"
-  "vpshld\0" "vpshlq\0" "vpshlw\0" "vpshufb\0" "vpshufd\0" "vpshufhw\0"
-  "vpshuflw\0" "vpsignb\0" "vpsignd\0" "vpsignw\0" "vpslld\0" "vpslldq\0"
-  "vpsllq\0" "vpsllvd\0" "vpsllvq\0" "vpsllw\0" "vpsrad\0" "vpsravd\0"
-  "vpsraw\0" "vpsrld\0" "vpsrldq\0" "vpsrlq\0" "vpsrlvd\0" "vpsrlvq\0"
-  "vpsrlw\0" "vpsubb\0" "vpsubd\0" "vpsubq\0" "vpsubsb\0" "vpsubsw\0"
-  "vpsubusb\0" "vpsubusw\0" "vpsubw\0" "vptest\0" "vpunpckhbw\0" "vpunpckhdq\0"
-  "vpunpckhqdq\0" "vpunpckhwd\0" "vpunpcklbw\0" "vpunpckldq\0" "vpunpcklqdq\0"
-  "vpunpcklwd\0" "vpxor\0" "vrcpps\0" "vrcpss\0" "vroundpd\0" "vroundps\0"
-  "vroundsd\0" "vroundss\0" "vrsqrtps\0" "vrsqrtss\0" "vshufpd\0" "vshufps\0"
-  "vsqrtpd\0" "vsqrtps\0" "vsqrtsd\0" "vsqrtss\0" "vstmxcsr\0" "vsubpd\0"
-  "vsubps\0" "vsubsd\0" "vsubss\0" "vtestpd\0" "vtestps\0" "vucomisd\0"
-  "vucomiss\0" "vunpckhpd\0" "vunpckhps\0" "vunpcklpd\0" "vunpcklps\0"
-  "vxorpd\0" "vxorps\0" "vzeroall\0" "vzeroupper\0" "wrfsbase\0" "wrgsbase\0"
-  "xadd\0" "xgetbv\0" "xsaveopt\0" "xsaveopt64\0" "xsetbv";
+  "vcomiss\0" "vcvtdq2pd\0" "vcvtdq2ps\0" "vcvtne2ps2bf16\0" "vcvtneps2bf16\0"
+  "vcvtpd2dq\0" "vcvtpd2ps\0" "vcvtph2ps\0" "vcvtps2dq\0" "vcvtps2pd\0"
+  "vcvtps2ph\0" "vcvtsd2si\0" "vcvtsd2ss\0" "vcvtsi2sd\0" "vcvtsi2ss\0"
+  "vcvtss2sd\0" "vcvtss2si\0" "vcvttpd2dq\0" "vcvttps2dq\0" "vcvttsd2si\0"
+  "vcvttss2si\0" "vdivpd\0" "vdivps\0" "vdivsd\0" "vdivss\0" "vdpbf16ps\0"
+  "vdppd\0" "vdpps\0" "vextractf128\0" "vextracti128\0" "vextractps\0"
+  "vfmadd132pd\0" "vfmadd132ps\0" "vfmadd132sd\0" "vfmadd132ss\0"
+  "vfmadd213pd\0" "vfmadd213ps\0" "vfmadd213sd\0" "vfmadd213ss\0"
+  "vfmadd231pd\0" "vfmadd231ps\0" "vfmadd231sd\0" "vfmadd231ss\0" "vfmaddpd\0"
+  "vfmaddps\0" "vfmaddsd\0" "vfmaddss\0" "vfmaddsub132pd\0" "vfmaddsub132ps\0"
+  "vfmaddsub213pd\0" "vfmaddsub213ps\0" "vfmaddsub231pd\0" "vfmaddsub231ps\0"
+  "vfmaddsubpd\0" "vfmaddsubps\0" "vfmsub132pd\0" "vfmsub132ps\0"
+  "vfmsub132sd\0" "vfmsub132ss\0" "vfmsub213pd\0" "vfmsub213ps\0"
+  "vfmsub213sd\0" "vfmsub213ss\0" "vfmsub231pd\0" "vfmsub231ps\0"
+  "vfmsub231sd\0" "vfmsub231ss\0" "vfmsubadd132pd\0" "vfmsubadd132ps\0"
+  "vfmsubadd213pd\0" "vfmsubadd213ps\0" "vfmsubadd231pd\0" "vfmsubadd231ps\0"
+  "vfmsubaddpd\0" "vfmsubaddps\0" "vfmsubpd\0" "vfmsubps\0" "vfmsubsd\0"
+  "vfmsubss\0" "vfnmadd132pd\0" "vfnmadd132ps\0" "vfnmadd132sd\0"
+  "vfnmadd132ss\0" "vfnmadd213pd\0" "vfnmadd213ps\0" "vfnmadd213sd\0"
+  "vfnmadd213ss\0" "vfnmadd231pd\0" "vfnmadd231ps\0" "vfnmadd231sd\0"
+  "vfnmadd231ss\0" "vfnmaddpd\0" "vfnmaddps\0" "vfnmaddsd\0" "vfnmaddss\0"
+  "vfnmsub132pd\0" "vfnmsub132ps\0" "vfnmsub132sd\0" "vfnmsub132ss\0"
+  "vfnmsub213pd\0" "vfnmsub213ps\0" "vfnmsub213sd\0" "vfnmsub213ss\0"
+  "vfnmsub231pd\0" "vfnmsub231ps\0" "vfnmsub231sd\0" "vfnmsub231ss\0"
+  "vfnmsubpd\0" "vfnmsubps\0" "vfnmsubsd\0" "vfnmsubss\0" "vfrczpd\0"
+  "vfrczps\0" "vfrczsd\0" "vfrczss\0" "vgatherdpd\0" "vgatherdps\0"
+  "vgatherqpd\0" "vgatherqps\0" "vhaddpd\0" "vhaddps\0" "vhsubpd\0" "vhsubps\0"
+  "vinsertf128\0" "vinserti128\0" "vinsertps\0" "vlddqu\0" "vldmxcsr\0"
+  "vmaskmovdqu\0" "vmaskmovpd\0" "vmaskmovps\0" "vmaxpd\0" "vmaxps\0"
+  "vmaxsd\0" "vmaxss\0" "vminpd\0" "vminps\0" "vminsd\0" "vminss\0" "vmovapd\0"
+  "vmovaps\0" "vmovd\0" "vmovddup\0" "vmovdqa\0" "vmovdqu\0" "vmovhlps\0"
+  "vmovhpd\0" "vmovhps\0" "vmovlhps\0" "vmovlpd\0" "vmovlps\0" "vmovmskpd\0"
+  "vmovmskps\0" "vmovntdq\0" "vmovntdqa\0" "vmovntpd\0" "vmovntps\0" "vmovq\0"
+  "vmovsd\0" "vmovshdup\0" "vmovsldup\0" "vmovss\0" "vmovupd\0" "vmovups\0"
+  "vmpsadbw\0" "vmulpd\0" "vmulps\0" "vmulsd\0" "vmulss\0" "vorpd\0" "vorps\0"
+  "vpabsb\0" "vpabsd\0" "vpabsw\0" "vpackssdw\0" "vpacksswb\0" "vpackusdw\0"
+  "vpackuswb\0" "vpaddb\0" "vpaddd\0" "vpaddq\0" "vpaddsb\0" "vpaddsw\0"
+  "vpaddusb\0" "vpaddusw\0" "vpaddw\0" "vpalignr\0" "vpand\0" "vpandn\0"
+  "vpavgb\0" "vpavgw\0" "vpblendd\0" "vpblendvb\0" "vpblendw\0"
+  "vpbroadcastb\0" "vpbroadcastd\0" "vpbroadcastq\0" "vpbroadcastw\0"
+  "vpclmulqdq\0" "vpcmov\0" "vpcmpeqb\0" "vpcmpeqd\0" "vpcmpeqq\0" "vpcmpeqw\0"
+  "vpcmpestri\0" "vpcmpestrm\0" "vpcmpgtb\0" "vpcmpgtd\0" "vpcmpgtq\0"
+  "vpcmpgtw\0" "vpcmpistri\0" "vpcmpistrm\0" "vpcomb\0" "vpcomd\0" "vpcomq\0"
+  "vpcomub\0" "vpcomud\0" "vpcomuq\0" "vpcomuw\0" "vpcomw\0" "vpdpbusd\0"
+  "vpdpbusds\0" "vpdpwssd\0" "vpdpwssds\0" "vperm2f128\0" "vperm2i128\0"
+  "vpermd\0" "vpermil2pd\0" "vpermil2ps\0" "vpermilpd\0" "vpermilps\0"
+  "vpermpd\0" "vpermps\0" "vpermq\0" "vpextrb\0" "vpextrd\0" "vpextrq\0"
+  "vpextrw\0" "vpgatherdd\0" "vpgatherdq\0" "vpgatherqd\0" "vpgatherqq\0"
+  "vphaddbd\0" "vphaddbq\0" "vphaddbw\0" "vphaddd\0" "vphadddq\0" "vphaddsw\0"
+  "vphaddubd\0" "vphaddubq\0" "vphaddubw\0" "vphaddudq\0" "vphadduwd\0"
+  "vphadduwq\0" "vphaddw\0" "vphaddwd\0" "vphaddwq\0" "vphminposuw\0"
+  "vphsubbw\0" "vphsubd\0" "vphsubdq\0" "vphsubsw\0" "vphsubw\0" "vphsubwd\0"
+  "vpinsrb\0" "vpinsrd\0" "vpinsrq\0" "vpinsrw\0" "vpmacsdd\0" "vpmacsdqh\0"
+  "vpmacsdql\0" "vpmacssdd\0" "vpmacssdqh\0" "vpmacssdql\0" "vpmacsswd\0"
+  "vpmacssww\0" "vpmacswd\0" "vpmacsww\0" "vpmadcsswd\0" "vpmadcswd\0"
+  "vpmaddubsw\0" "vpmaddwd\0" "vpmaskmovd\0" "vpmaskmovq\0" "vpmaxsb\0"
+  "vpmaxsd\0" "vpmaxsw\0" "vpmaxub\0" "vpmaxud\0" "vpmaxuw\0" "vpminsb\0"
+  "vpminsd\0" "vpminsw\0" "vpminub\0" "vpminud\0" "vpminuw\0" "vpmovmskb\0"
+  "vpmovsxbd\0" "vpmovsxbq\0" "vpmovsxbw\0" "vpmovsxdq\0" "vpmovsxwd\0"
+  "vpmovsxwq\0" "vpmovzxbd\0" "vpmovzxbq\0" "vpmovzxbw\0" "vpmovzxdq\0"
+  "vpmovzxwd\0" "vpmovzxwq\0" "vpmuldq\0" "vpmulhrsw\0" "vpmulhuw\0"
+  "vpmulhw\0" "vpmulld\0" "vpmullw\0" "vpmuludq\0" "vpor\0" "vpperm\0"
+  "vprotb\0" "vprotd\0" "vprotq\0" "vprotw\0" "vpsadbw\0" "vpshab\0" "vpshad\0"
+  "vpshaq\0" "vpshaw\0" "vpshlb\0" "vpshld\0" "vpshlq\0" "vpshlw\0" "vpshufb\0"
+  "vpshufd\0" "vpshufhw\0" "vpshuflw\0" "vpsignb\0" "vpsignd\0" "vpsignw\0"
+  "vpslld\0" "vpslldq\0" "vpsllq\0" "vpsllvd\0" "vpsllvq\0" "vpsllw\0"
+  "vpsrad\0" "vpsravd\0" "vpsraw\0" "vpsrld\0" "vpsrldq\0" "vpsrlq\0"
+  "vpsrlvd\0" "vpsrlvq\0" "vpsrlw\0" "vpsubb\0" "vpsubd\0" "vpsubq\0"
+  "vpsubsb\0" "vpsubsw\0" "vpsubusb\0" "vpsubusw\0" "vpsubw\0" "vptest\0"
+  "vpunpckhbw\0" "vpunpckhdq\0" "vpunpckhqdq\0" "vpunpckhwd\0" "vpunpcklbw\0"
+  "vpunpckldq\0" "vpunpcklqdq\0" "vpunpcklwd\0" "vpxor\0" "vrcpps\0" "vrcpss\0"
+  "vroundpd\0" "vroundps\0" "vroundsd\0" "vroundss\0" "vrsqrtps\0" "vrsqrtss\0"
+  "vshufpd\0" "vshufps\0" "vsqrtpd\0" "vsqrtps\0" "vsqrtsd\0" "vsqrtss\0"
+  "vstmxcsr\0" "vsubpd\0" "vsubps\0" "vsubsd\0" "vsubss\0" "vtestpd\0"
+  "vtestps\0" "vucomisd\0" "vucomiss\0" "vunpckhpd\0" "vunpckhps\0"
+  "vunpcklpd\0" "vunpcklps\0" "vxorpd\0" "vxorps\0" "vzeroall\0" "vzeroupper\0"
+  "wrfsbase\0" "wrgsbase\0" "xadd\0" "xgetbv\0" "xsaveopt\0" "xsaveopt64\0"
+  "xsetbv";
 // ----------------------------------------------------------------------------
 
 static const uint16_t _x86InstNameIndex[] = {
-  0, 1, 5, 640, 3418, 3430, 3652, 3662, 3157, 3169, 10, 2391, 2399, 2411, 2419,
-  2431, 2439, 1644, 4511, 2456, 2464, 2472, 2479, 15, 21, 29, 34, 40, 47, 2486,
+  0, 1, 5, 640, 3457, 3469, 3691, 3701, 3196, 3208, 10, 2391, 2399, 2411, 2419,
+  2431, 2439, 1644, 4550, 2456, 2464, 2472, 2479, 15, 21, 29, 34, 40, 47, 2486,
   2495, 2504, 2514, 52, 60, 65, 71, 78, 83, 87, 91, 97, 100, 104, 108, 112,
   117, 122, 126, 130, 135, 139, 143, 151, 162, 166, 172, 497, 504, 179, 512,
   185, 191, 198, 204, 211, 218, 519, 527, 226, 536, 233, 240, 248, 255, 263,
   270, 277, 284, 291, 297, 303, 310, 317, 323, 329, 2580, 2587, 1902, 1915,
-  1928, 1941, 2594, 2601, 333, 341, 352, 6267, 6276, 362, 368, 372, 2624, 2634,
-  2644, 378, 2654, 387, 396, 2674, 2684, 405, 2704, 2714, 2724, 2734, 2744,
-  2754, 2764, 414, 2775, 424, 2786, 2797, 434, 438, 443, 447, 2394, 659, 2808,
-  2815, 2822, 2829, 2836, 2842, 627, 451, 2874, 4916, 457, 463, 1382, 468, 474,
+  1928, 1941, 2594, 2601, 333, 341, 352, 6344, 6353, 362, 368, 372, 2624, 2634,
+  2673, 378, 2683, 387, 396, 2703, 2713, 405, 2733, 2743, 2753, 2763, 2773,
+  2783, 2793, 414, 2804, 424, 2815, 2826, 434, 438, 443, 447, 2394, 659, 2837,
+  2844, 2851, 2858, 2875, 2881, 627, 451, 2913, 4993, 457, 463, 1382, 468, 474,
   479, 485, 490, 496, 503, 511, 518, 526, 535, 543, 551, 558, 563, 569, 576,
   582, 589, 594, 602, 607, 613, 619, 626, 632, 638, 644, 650, 657, 663, 670,
   675, 681, 689, 695, 700, 706, 713, 719, 726, 730, 735, 741, 748, 755, 762,
   769, 776, 782, 1424, 787, 793, 800, 807, 812, 819, 826, 834, 841, 848, 854,
   861, 867, 875, 882, 888, 895, 900, 908, 914, 918, 924, 931, 936, 1486, 942,
   1492, 948, 955, 960, 966, 973, 981, 988, 996, 1002, 1007, 1012, 1020, 1030,
-  1037, 1046, 1054, 1060, 3941, 3949, 3957, 3965, 658, 676, 1068, 3997, 1072,
+  1037, 1046, 1054, 1060, 3980, 3988, 3996, 4004, 658, 676, 1068, 4036, 1072,
   871, 1080, 1083, 1087, 1090, 1094, 1097, 1106, 1109, 1113, 1116, 1124, 1128,
   1133, 1137, 1142, 1146, 1150, 1154, 1159, 1163, 1168, 1172, 1176, 1180, 1184,
-  1187, 1190, 1194, 1198, 1201, 1100, 1120, 1204, 4007, 4014, 1209, 1213, 1219,
-  1672, 1683, 1694, 1705, 1226, 4023, 5362, 4057, 4064, 5381, 4078, 1232, 4085,
-  4092, 5429, 4106, 1239, 4624, 1247, 4113, 4121, 505, 5355, 4135, 1255, 4144,
-  4027, 4160, 4169, 4177, 4185, 4194, 4202, 4210, 4220, 4230, 4239, 1263, 4249,
-  4258, 1270, 1277, 1285, 5366, 1293, 1716, 1727, 1738, 1749, 4273, 4280, 4290,
-  4300, 1301, 1307, 4307, 4315, 1314, 4323, 677, 4332, 4339, 4346, 4353, 1320,
-  1325, 1331, 808, 1335, 1017, 6325, 6332, 4372, 4379, 4386, 4393, 4403, 4413,
-  4423, 4433, 4440, 4447, 4454, 4462, 4470, 4479, 4488, 4495, 4504, 4510, 1339,
-  4517, 1345, 4524, 4540, 4550, 4611, 4629, 4638, 4647, 4656, 4665, 4676, 4687,
-  4696, 4705, 4714, 4723, 4734, 1353, 1358, 4899, 4907, 4915, 4923, 1363, 1369,
+  1187, 1190, 1194, 1198, 1201, 1100, 1120, 1204, 4046, 4053, 1209, 1213, 1219,
+  1672, 1683, 1694, 1705, 1226, 4062, 5439, 4096, 4103, 5458, 4117, 1232, 4124,
+  4131, 5506, 4145, 1239, 4663, 1247, 4152, 4160, 505, 5432, 4174, 1255, 4183,
+  4066, 4199, 4208, 4216, 4224, 4233, 4241, 4249, 4259, 4269, 4278, 1263, 4288,
+  4297, 1270, 1277, 1285, 5443, 1293, 1716, 1727, 1738, 1749, 4312, 4319, 4329,
+  4339, 1301, 1307, 4346, 4354, 1314, 4362, 677, 4371, 4378, 4385, 4392, 1320,
+  1325, 1331, 808, 1335, 1017, 6402, 6409, 4411, 4418, 4425, 4432, 4442, 4452,
+  4462, 4472, 4479, 4486, 4493, 4501, 4509, 4518, 4527, 4534, 4543, 4549, 1339,
+  4556, 1345, 4563, 4579, 4589, 4650, 4668, 4677, 4686, 4695, 4704, 4715, 4726,
+  4735, 4744, 4753, 4762, 4773, 1353, 1358, 4976, 4984, 4992, 5000, 1363, 1369,
   1375, 1381, 1387, 1395, 1403, 1411, 1417, 1423, 1429, 1436, 1444, 1450, 1459,
-  1468, 1477, 1485, 1491, 5002, 5019, 5088, 5114, 5135, 5152, 5161, 1498, 1504,
-  5178, 5186, 5194, 5202, 5330, 5341, 5372, 5380, 5388, 5396, 5404, 5412, 5420,
-  5428, 5436, 5444, 5452, 5460, 5468, 5478, 5488, 5498, 5508, 5518, 5528, 5538,
-  5548, 5558, 5568, 5578, 5588, 5598, 5606, 1510, 5616, 5625, 5633, 5641, 5649,
-  1518, 1522, 1527, 1534, 5658, 1539, 1548, 1562, 1572, 4324, 5762, 5770, 5778,
-  5787, 1584, 5796, 5804, 5812, 5820, 5827, 5835, 5858, 5865, 5880, 5887, 5894,
-  5902, 5925, 5932, 5939, 5946, 5953, 5961, 5969, 5978, 5987, 1591, 5994, 6001,
-  6012, 6023, 6035, 6046, 6057, 6068, 6080, 1598, 1603, 1609, 6091, 1615, 6097,
-  6104, 1619, 1623, 1632, 1641, 1648, 1655, 1661, 1668, 1679, 1690, 1701, 1712,
+  1468, 1477, 1485, 1491, 5079, 5096, 5165, 5191, 5212, 5229, 5238, 1498, 1504,
+  5255, 5263, 5271, 5279, 5407, 5418, 5449, 5457, 5465, 5473, 5481, 5489, 5497,
+  5505, 5513, 5521, 5529, 5537, 5545, 5555, 5565, 5575, 5585, 5595, 5605, 5615,
+  5625, 5635, 5645, 5655, 5665, 5675, 5683, 1510, 5693, 5702, 5710, 5718, 5726,
+  1518, 1522, 1527, 1534, 5735, 1539, 1548, 1562, 1572, 4363, 5839, 5847, 5855,
+  5864, 1584, 5873, 5881, 5889, 5897, 5904, 5912, 5935, 5942, 5957, 5964, 5971,
+  5979, 6002, 6009, 6016, 6023, 6030, 6038, 6046, 6055, 6064, 1591, 6071, 6078,
+  6089, 6100, 6112, 6123, 6134, 6145, 6157, 1598, 1603, 1609, 6168, 1615, 6174,
+  6181, 1619, 1623, 1632, 1641, 1648, 1655, 1661, 1668, 1679, 1690, 1701, 1712,
   1723, 1734, 1745, 1756, 1767, 1778, 1789, 1800, 1812, 1824, 1836, 1848, 1860,
   1872, 1884, 1896, 1909, 1922, 1935, 1948, 1961, 1974, 1987, 2000, 2004, 2008,
-  2012, 6111, 6120, 6129, 6138, 6147, 6156, 2017, 2022, 2026, 2030, 2035, 1954,
+  2012, 6188, 6197, 6206, 6215, 6224, 6233, 2017, 2022, 2026, 2030, 2035, 1954,
   1967, 1980, 1993, 2039, 2044, 2050, 2055, 2061, 2066, 2071, 2076, 2082, 2087,
   2093, 2099, 2106, 2112, 2119, 2125, 2131, 2137, 2144, 2150, 2157, 2163, 2169,
   2175, 2181, 2186, 2191, 2197, 2203, 2208, 2213, 2220, 2229, 2238, 2248, 2258,
-  2269, 2280, 2292, 5742, 2296, 2301, 2305, 2310, 6165, 6173, 6181, 6148, 6197,
-  6157, 2315, 4580, 6213, 1760, 1771, 1782, 1793, 715, 3160, 3172, 3848, 3858,
-  2319, 5995, 2326, 2332, 6266, 6275, 2338, 6284, 6294, 6304, 6314, 2342, 2349,
+  2269, 2280, 2292, 5819, 2296, 2301, 2305, 2310, 6242, 6250, 6258, 6225, 6274,
+  6234, 2315, 4619, 6290, 1760, 1771, 1782, 1793, 715, 3199, 3211, 3887, 3897,
+  2319, 6072, 2326, 2332, 6343, 6352, 2338, 6361, 6371, 6381, 6391, 2342, 2349,
   2356, 2363, 2370, 2380, 2390, 2398, 2410, 2418, 2430, 2438, 2455, 2463, 2471,
   2478, 2485, 2494, 2503, 2513, 2523, 2538, 2553, 2566, 2579, 2586, 2593, 2600,
-  2607, 2615, 2623, 2633, 2643, 2653, 2663, 2673, 2683, 2693, 2703, 2713, 2723,
-  2733, 2743, 2753, 2763, 2774, 2785, 2796, 2807, 2814, 2821, 2828, 2835, 2841,
-  2847, 2860, 2873, 2884, 2896, 2908, 2920, 2932, 2944, 2956, 2968, 2980, 2992,
-  3004, 3016, 3028, 3037, 3046, 3055, 3064, 3079, 3094, 3109, 3124, 3139, 3154,
-  3166, 3178, 3190, 3202, 3214, 3226, 3238, 3250, 3262, 3274, 3286, 3298, 3310,
-  3322, 3337, 3352, 3367, 3382, 3397, 3412, 3424, 3436, 3445, 3454, 3463, 3472,
-  3485, 3498, 3511, 3524, 3537, 3550, 3563, 3576, 3589, 3602, 3615, 3628, 3638,
-  3648, 3658, 3668, 3681, 3694, 3707, 3720, 3733, 3746, 3759, 3772, 3785, 3798,
-  3811, 3824, 3834, 3844, 3854, 3864, 3872, 3880, 3888, 3896, 3907, 3918, 3929,
-  3940, 3948, 3956, 3964, 3972, 3984, 3996, 4006, 4013, 4022, 4034, 4045, 4056,
-  4063, 4070, 4077, 4084, 4091, 4098, 4105, 4112, 4120, 4128, 4134, 4143, 4151,
-  4159, 4168, 4176, 4184, 4193, 4201, 4209, 4219, 4229, 4238, 4248, 4257, 4266,
-  4272, 4279, 4289, 4299, 4306, 4314, 4322, 4331, 4338, 4345, 4352, 4359, 4365,
-  4371, 4378, 4385, 4392, 4402, 4412, 4422, 4432, 4439, 4446, 4453, 4461, 4469,
-  4478, 4487, 4494, 4503, 4509, 4516, 4523, 4530, 4539, 4549, 4558, 4571, 4584,
-  4597, 4610, 4621, 4628, 4637, 4646, 4655, 4664, 4675, 4686, 4695, 4704, 4713,
-  4722, 4733, 4744, 4751, 4758, 4765, 4773, 4781, 4789, 4797, 4804, 4815, 4826,
-  4833, 4844, 4855, 4865, 4875, 4883, 4891, 4898, 4906, 4914, 4922, 4930, 4941,
-  4952, 4963, 4974, 4983, 4992, 5001, 5009, 5018, 5027, 5037, 5047, 5057, 5067,
-  5077, 5087, 5095, 5104, 5113, 5125, 5134, 5142, 5151, 5160, 5168, 5177, 5185,
-  5193, 5201, 5209, 5218, 5228, 5238, 5248, 5259, 5270, 5280, 5290, 5299, 5308,
-  5319, 5329, 5340, 5349, 5360, 5371, 5379, 5387, 5395, 5403, 5411, 5419, 5427,
-  5435, 5443, 5451, 5459, 5467, 5477, 5487, 5497, 5507, 5517, 5527, 5537, 5547,
-  5557, 5567, 5577, 5587, 5597, 5605, 5615, 5624, 5632, 5640, 5648, 5657, 5662,
-  5669, 5676, 5683, 5690, 5697, 5705, 5712, 5719, 5726, 5733, 5740, 5747, 5754,
-  5761, 5769, 5777, 5786, 5795, 5803, 5811, 5819, 5826, 5834, 5841, 5849, 5857,
-  5864, 5871, 5879, 5886, 5893, 5901, 5908, 5916, 5924, 5931, 5938, 5945, 5952,
-  5960, 5968, 5977, 5986, 5993, 6000, 6011, 6022, 6034, 6045, 6056, 6067, 6079,
-  6090, 6096, 6103, 6110, 6119, 6128, 6137, 6146, 6155, 6164, 6172, 6180, 6188,
-  6196, 6204, 6212, 6221, 6228, 6235, 6242, 6249, 6257, 6265, 6274, 6283, 6293,
-  6303, 6313, 6323, 6330, 6337, 6346, 6357, 6366, 6375, 336, 6380, 6092, 6324,
-  6331, 1013, 1021, 1031, 1038, 6387, 6396, 6407
+  2607, 2615, 2623, 2633, 2643, 2658, 2672, 2682, 2692, 2702, 2712, 2722, 2732,
+  2742, 2752, 2762, 2772, 2782, 2792, 2803, 2814, 2825, 2836, 2843, 2850, 2857,
+  2864, 2874, 2880, 2886, 2899, 2912, 2923, 2935, 2947, 2959, 2971, 2983, 2995,
+  3007, 3019, 3031, 3043, 3055, 3067, 3076, 3085, 3094, 3103, 3118, 3133, 3148,
+  3163, 3178, 3193, 3205, 3217, 3229, 3241, 3253, 3265, 3277, 3289, 3301, 3313,
+  3325, 3337, 3349, 3361, 3376, 3391, 3406, 3421, 3436, 3451, 3463, 3475, 3484,
+  3493, 3502, 3511, 3524, 3537, 3550, 3563, 3576, 3589, 3602, 3615, 3628, 3641,
+  3654, 3667, 3677, 3687, 3697, 3707, 3720, 3733, 3746, 3759, 3772, 3785, 3798,
+  3811, 3824, 3837, 3850, 3863, 3873, 3883, 3893, 3903, 3911, 3919, 3927, 3935,
+  3946, 3957, 3968, 3979, 3987, 3995, 4003, 4011, 4023, 4035, 4045, 4052, 4061,
+  4073, 4084, 4095, 4102, 4109, 4116, 4123, 4130, 4137, 4144, 4151, 4159, 4167,
+  4173, 4182, 4190, 4198, 4207, 4215, 4223, 4232, 4240, 4248, 4258, 4268, 4277,
+  4287, 4296, 4305, 4311, 4318, 4328, 4338, 4345, 4353, 4361, 4370, 4377, 4384,
+  4391, 4398, 4404, 4410, 4417, 4424, 4431, 4441, 4451, 4461, 4471, 4478, 4485,
+  4492, 4500, 4508, 4517, 4526, 4533, 4542, 4548, 4555, 4562, 4569, 4578, 4588,
+  4597, 4610, 4623, 4636, 4649, 4660, 4667, 4676, 4685, 4694, 4703, 4714, 4725,
+  4734, 4743, 4752, 4761, 4772, 4783, 4790, 4797, 4804, 4812, 4820, 4828, 4836,
+  4843, 4852, 4862, 4871, 4881, 4892, 4903, 4910, 4921, 4932, 4942, 4952, 4960,
+  4968, 4975, 4983, 4991, 4999, 5007, 5018, 5029, 5040, 5051, 5060, 5069, 5078,
+  5086, 5095, 5104, 5114, 5124, 5134, 5144, 5154, 5164, 5172, 5181, 5190, 5202,
+  5211, 5219, 5228, 5237, 5245, 5254, 5262, 5270, 5278, 5286, 5295, 5305, 5315,
+  5325, 5336, 5347, 5357, 5367, 5376, 5385, 5396, 5406, 5417, 5426, 5437, 5448,
+  5456, 5464, 5472, 5480, 5488, 5496, 5504, 5512, 5520, 5528, 5536, 5544, 5554,
+  5564, 5574, 5584, 5594, 5604, 5614, 5624, 5634, 5644, 5654, 5664, 5674, 5682,
+  5692, 5701, 5709, 5717, 5725, 5734, 5739, 5746, 5753, 5760, 5767, 5774, 5782,
+  5789, 5796, 5803, 5810, 5817, 5824, 5831, 5838, 5846, 5854, 5863, 5872, 5880,
+  5888, 5896, 5903, 5911, 5918, 5926, 5934, 5941, 5948, 5956, 5963, 5970, 5978,
+  5985, 5993, 6001, 6008, 6015, 6022, 6029, 6037, 6045, 6054, 6063, 6070, 6077,
+  6088, 6099, 6111, 6122, 6133, 6144, 6156, 6167, 6173, 6180, 6187, 6196, 6205,
+  6214, 6223, 6232, 6241, 6249, 6257, 6265, 6273, 6281, 6289, 6298, 6305, 6312,
+  6319, 6326, 6334, 6342, 6351, 6360, 6370, 6380, 6390, 6400, 6407, 6414, 6423,
+  6434, 6443, 6452, 336, 6457, 6169, 6401, 6408, 1013, 1021, 1031, 1038, 6464,
+  6473, 6484
 };
 
-enum X86InstAlphaIndex {
-  kX86InstAlphaIndexFirst = 'a',
-  kX86InstAlphaIndexLast = 'z',
-  kX86InstAlphaIndexInvalid = 0xFFFF
+enum X86InstHash {
+  kX86InstHashSeed = 0,
+  kX86InstHashSize = 2048,
+  kX86InstHashBucketShift = 23
 };
 
-static const uint16_t _x86InstAlphaIndex[26] = {
-  kX86InstIdAdc,
-  kX86InstIdBextr,
-  kX86InstIdCall,
-  kX86InstIdDaa,
-  kX86InstIdEmms,
-  kX86InstIdF2xm1,
-  0xFFFF,
-  kX86InstIdHaddpd,
-  kX86InstIdIdiv,
-  kX86InstIdJa,
-  0xFFFF,
-  kX86InstIdLahf,
-  kX86InstIdMaskmovdqu,
-  kX86InstIdNeg,
-  kX86InstIdOr,
-  kX86InstIdPabsb,
-  0xFFFF,
-  kX86InstIdRcl,
-  kX86InstIdSahf,
-  kX86InstIdT1mskc,
-  kX86InstIdUcomisd,
-  kX86InstIdVaddpd,
-  kX86InstIdWrfsbase,
-  kX86InstIdXadd,
-  0xFFFF,
-  0xFFFF
+static const uint16_t _x86InstHashDisp[512] = {
+  1, 4, 1, 6, 1, 0, 0, 0, 2, 0, 0, 3, 0, 0, 1, 4, 0, 0, 2, 0, 0, 7, 0, 0, 2, 0,
+  0, 1, 1, 0, 1, 0, 0, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 3,
+  1, 0, 0, 2, 0, 2, 1, 0, 0, 0, 0, 1, 12, 0, 0, 0, 4, 14, 0, 0, 0, 0, 17, 0, 1,
+  1, 2, 1, 0, 1, 1, 0, 0, 0, 0, 5, 0, 0, 0, 2, 4, 2, 0, 3, 0, 1, 0, 3, 0, 0, 1,
+  0, 2, 0, 0, 0, 1, 0, 0, 1, 0, 1, 8, 1, 0, 8, 1, 1, 2, 0, 0, 0, 0, 0, 0, 0, 1,
+  0, 0, 0, 2, 1, 0, 2, 0, 0, 4, 1, 0, 0, 0, 0, 7, 0, 2, 7, 2, 1, 1, 0, 1, 2, 8,
+  0, 0, 0, 0, 0, 2, 0, 3, 0, 2, 0, 1, 0, 0, 0, 1, 1, 2, 3, 0, 2, 0, 0, 0, 4, 0,
+  0, 0, 0, 0, 5, 1, 0, 0, 5, 0, 7, 4, 3, 2, 1, 2, 3, 3, 0, 2, 0, 4, 3, 1, 1, 1,
+  4, 0, 0, 0, 1, 3, 0, 0, 0, 0, 1, 3, 0, 0, 1, 0, 2, 0, 0, 2, 0, 2, 11, 5, 1,
+  5, 3, 0, 8, 0, 0, 1, 4, 0, 0, 2, 1, 1, 1, 4, 7, 0, 1, 0, 0, 1, 0, 2, 0, 1, 1,
+  1, 0, 0, 0, 2, 0, 1, 1, 3, 1, 0, 1, 0, 3, 1, 0, 0, 1, 1, 3, 3, 1, 0, 0, 4, 0,
+  0, 0, 3, 0, 0, 2, 0, 3, 2, 0, 9, 14, 1, 0, 3, 1, 0, 4, 0, 0, 1, 3, 1, 0, 1,
+  0, 0, 6, 1, 0, 0, 5, 0, 6, 0, 1, 0, 0, 1, 2, 0, 0, 2, 1, 3, 1, 1, 0, 0, 5, 2,
+  0, 0, 1, 0, 2, 4, 1, 4, 2, 0, 0, 1, 0, 1, 0, 3, 0, 0, 5, 0, 1, 1, 1, 1, 5, 2,
+  4, 0, 4, 1, 0, 1, 0, 5, 0, 0, 0, 0, 0, 7, 3, 0, 0, 15, 0, 0, 0, 4, 3, 0, 0,
+  0, 0, 1, 0, 2, 0, 0, 0, 0, 6, 0, 9, 0, 6, 1, 1, 1, 0, 2, 0, 0, 0, 0, 0, 2, 0,
+  2, 0, 0, 2, 0, 2, 2, 6, 3, 8, 0, 1, 1, 0, 0, 2, 3, 2, 0, 2, 0, 2, 0, 2, 0, 2,
+  4, 0, 0, 1, 1, 5, 4, 0, 0, 0, 2, 0, 6, 0, 0, 2, 4, 2, 0, 1, 0, 1, 0, 5, 4, 0,
+  0, 0, 1, 0, 0, 1, 0, 0, 0, 5, 2, 0, 8, 0, 4, 0, 0, 0, 8, 5, 0, 3, 1, 17, 11,
+  0, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 2, 0, 0, 3, 9, 0
+};
+
+static const uint16_t _x86InstHashTable[2048] = {
+  914, 464, 243, 0, 0, 724, 241, 601, 0, 48, 938, 0, 0, 661, 0, 0, 1046, 903,
+  946, 185, 189, 0, 833, 0, 374, 476, 197, 0, 1042, 0, 589, 0, 0, 0, 0, 0, 0,
+  1020, 0, 0, 0, 0, 216, 0, 398, 0, 335, 0, 215, 1082, 0, 987, 0, 0, 0, 98, 0,
+  446, 513, 0, 846, 265, 0, 814, 80, 188, 0, 708, 0, 0, 278, 648, 0, 782, 0,
+  212, 201, 669, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 770, 0, 0, 824, 0, 132, 0, 811,
+  617, 895, 0, 0, 0, 455, 0, 0, 436, 351, 706, 271, 1027, 1090, 827, 27, 1036,
+  703, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 309, 438, 0, 0, 844, 605, 902, 331, 825,
+  0, 0, 0, 0, 0, 264, 0, 0, 0, 0, 0, 0, 0, 0, 629, 415, 0, 0, 0, 925, 997, 329,
+  0, 0, 0, 0, 0, 0, 0, 0, 700, 0, 47, 961, 0, 1080, 949, 14, 207, 0, 864, 553,
+  0, 563, 291, 339, 0, 848, 574, 0, 775, 0, 0, 713, 0, 0, 0, 1032, 0, 284, 256,
+  161, 485, 0, 177, 936, 900, 0, 0, 683, 0, 0, 461, 0, 529, 0, 0, 0, 1091, 0,
+  0, 0, 0, 0, 0, 152, 2, 0, 18, 0, 0, 0, 1, 340, 0, 0, 0, 333, 973, 0, 0, 0, 0,
+  0, 0, 0, 307, 1061, 789, 0, 932, 0, 0, 609, 0, 486, 365, 0, 642, 588, 151,
+  140, 995, 0, 364, 390, 0, 346, 277, 652, 673, 137, 0, 0, 0, 0, 79, 663, 525,
+  1049, 0, 0, 749, 0, 632, 401, 1016, 0, 0, 0, 0, 654, 503, 213, 0, 0, 1072,
+  64, 0, 292, 0, 0, 0, 484, 0, 939, 122, 16, 0, 0, 0, 28, 531, 87, 522, 674, 0,
+  0, 0, 816, 384, 0, 0, 0, 0, 425, 742, 124, 0, 97, 381, 395, 0, 557, 0, 0,
+  786, 0, 564, 60, 431, 267, 0, 20, 225, 30, 501, 0, 0, 314, 730, 871, 0, 868,
+  783, 670, 0, 491, 0, 0, 832, 992, 1058, 193, 781, 171, 865, 0, 223, 569, 930,
+  0, 282, 175, 892, 941, 0, 0, 985, 0, 0, 0, 0, 0, 0, 0, 0, 417, 1003, 956,
+  790, 520, 0, 0, 0, 1071, 355, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1039, 56, 310,
+  0, 183, 238, 0, 0, 0, 1010, 831, 0, 0, 0, 0, 523, 0, 0, 0, 0, 308, 696, 1069,
+  317, 0, 0, 405, 787, 750, 587, 0, 0, 494, 0, 0, 227, 463, 0, 963, 0, 0, 0,
+  1008, 0, 0, 0, 0, 279, 0, 375, 0, 0, 0, 0, 259, 135, 92, 993, 0, 295, 0, 233,
+  679, 591, 0, 128, 894, 659, 0, 0, 626, 0, 269, 477, 435, 685, 0, 325, 0, 0,
+  0, 0, 800, 206, 638, 0, 0, 328, 630, 337, 728, 280, 0, 0, 0, 0, 714, 625,
+  735, 0, 332, 890, 0, 0, 0, 0, 886, 82, 0, 1022, 0, 0, 0, 0, 0, 49, 0, 488,
+  372, 822, 0, 737, 600, 110, 998, 37, 0, 0, 214, 0, 829, 248, 0, 0, 0, 0, 302,
+  219, 0, 912, 0, 725, 851, 0, 210, 0, 0, 369, 0, 0, 0, 294, 218, 0, 1085, 0,
+  0, 0, 0, 0, 396, 876, 921, 558, 0, 0, 262, 0, 0, 1079, 0, 0, 953, 81, 127, 0,
+  131, 1033, 0, 616, 0, 0, 0, 0, 0, 0, 0, 327, 753, 835, 120, 0, 0, 1081, 519,
+  272, 0, 0, 274, 349, 198, 0, 226, 0, 884, 0, 266, 0, 0, 731, 0, 0, 0, 0, 874,
+  0, 0, 366, 0, 164, 581, 736, 813, 0, 763, 232, 798, 839, 3, 273, 344, 409,
+  251, 0, 689, 918, 658, 0, 0, 142, 0, 408, 86, 960, 0, 0, 0, 710, 58, 0, 410,
+  0, 0, 457, 607, 0, 440, 1029, 23, 986, 0, 0, 534, 0, 0, 0, 15, 0, 0, 0, 0,
+  88, 217, 0, 0, 1012, 130, 71, 17, 25, 0, 0, 540, 0, 0, 336, 726, 623, 11, 0,
+  34, 0, 203, 1075, 141, 745, 877, 318, 546, 199, 0, 404, 0, 0, 0, 0, 100, 0,
+  0, 166, 702, 67, 114, 872, 0, 572, 0, 0, 155, 0, 1031, 0, 0, 0, 0, 462, 852,
+  0, 0, 0, 0, 0, 0, 0, 0, 693, 0, 196, 915, 0, 945, 242, 416, 0, 698, 958, 451,
+  0, 0, 0, 760, 0, 0, 0, 478, 0, 0, 0, 472, 4, 729, 0, 0, 0, 0, 0, 707, 412, 0,
+  548, 55, 231, 224, 691, 0, 0, 0, 0, 0, 0, 777, 0, 0, 0, 1062, 0, 0, 0, 178,
+  0, 10, 391, 0, 0, 0, 1006, 879, 320, 544, 593, 741, 828, 0, 467, 179, 662,
+  913, 0, 1074, 77, 764, 115, 1009, 717, 0, 0, 0, 496, 636, 704, 0, 0, 0, 0,
+  719, 0, 0, 0, 0, 0, 0, 734, 41, 0, 720, 0, 0, 585, 756, 129, 0, 0, 0, 1083,
+  304, 0, 0, 0, 0, 0, 0, 0, 754, 0, 0, 0, 0, 631, 0, 0, 0, 0, 158, 42, 516, 0,
+  0, 0, 0, 550, 0, 24, 621, 0, 1065, 270, 885, 40, 898, 0, 0, 0, 0, 562, 0, 0,
+  0, 0, 0, 0, 604, 0, 0, 1084, 1086, 0, 0, 799, 471, 740, 0, 1059, 676, 911,
+  13, 784, 881, 820, 376, 0, 917, 979, 0, 1000, 0, 0, 0, 614, 0, 0, 836, 838,
+  93, 134, 36, 863, 112, 229, 0, 469, 0, 920, 596, 0, 0, 0, 0, 0, 0, 125, 0,
+  906, 0, 1060, 281, 6, 338, 613, 788, 923, 419, 1068, 418, 428, 195, 682, 583,
+  1070, 922, 981, 449, 0, 0, 0, 715, 0, 0, 253, 481, 275, 908, 962, 0, 1064, 0,
+  9, 552, 0, 983, 234, 517, 0, 260, 94, 0, 148, 660, 414, 0, 0, 0, 0, 0, 0, 0,
+  101, 0, 0, 0, 897, 533, 518, 0, 66, 0, 0, 916, 437, 420, 268, 860, 647, 705,
+  826, 371, 460, 150, 379, 818, 293, 802, 0, 999, 186, 899, 891, 145, 194,
+  1026, 288, 358, 527, 301, 276, 433, 38, 334, 118, 594, 0, 0, 0, 821, 19, 29,
+  465, 854, 0, 576, 875, 458, 176, 0, 858, 837, 579, 0, 0, 221, 996, 0, 434, 0,
+  582, 0, 0, 560, 665, 878, 511, 547, 0, 0, 0, 0, 0, 0, 0, 0, 0, 443, 765, 190,
+  0, 966, 1048, 774, 162, 447, 635, 26, 0, 0, 244, 470, 0, 0, 482, 0, 0, 0, 0,
+  0, 1034, 905, 0, 0, 63, 0, 0, 627, 862, 970, 69, 235, 565, 711, 261, 383,
+  752, 538, 0, 0, 0, 1025, 0, 107, 0, 157, 695, 807, 0, 0, 0, 0, 1005, 0, 0, 0,
+  549, 618, 0, 61, 290, 622, 393, 138, 474, 205, 0, 303, 0, 0, 0, 423, 0, 624,
+  0, 0, 0, 0, 354, 0, 0, 113, 0, 771, 0, 0, 0, 778, 0, 942, 57, 44, 512, 119,
+  0, 959, 1015, 0, 442, 0, 0, 0, 399, 0, 497, 1040, 32, 0, 0, 686, 0, 1021, 46,
+  0, 191, 0, 297, 146, 445, 0, 0, 0, 0, 0, 90, 830, 139, 856, 0, 0, 76, 699,
+  306, 542, 7, 611, 0, 0, 0, 727, 413, 808, 0, 0, 655, 0, 160, 980, 0, 255, 0,
+  495, 0, 0, 0, 133, 454, 33, 785, 909, 0, 0, 1054, 407, 0, 1028, 8, 0, 0, 500,
+  0, 738, 1055, 680, 0, 0, 0, 0, 0, 0, 0, 192, 21, 0, 969, 792, 919, 590, 0, 0,
+  0, 0, 515, 83, 0, 0, 0, 526, 78, 0, 0, 1001, 761, 397, 976, 0, 584, 0, 403,
+  0, 0, 0, 927, 181, 123, 0, 0, 598, 0, 805, 0, 688, 0, 0, 0, 0, 0, 239, 0, 0,
+  0, 0, 305, 656, 0, 0, 0, 809, 644, 0, 803, 170, 236, 459, 1051, 62, 982, 388,
+  762, 509, 0, 0, 0, 362, 252, 106, 882, 0, 456, 0, 0, 220, 1018, 0, 0, 0, 0,
+  0, 0, 341, 230, 615, 0, 370, 323, 0, 603, 0, 257, 0, 678, 296, 439, 1024, 0,
+  172, 532, 989, 0, 53, 757, 721, 0, 619, 0, 0, 0, 263, 0, 0, 0, 96, 747, 759,
+  723, 0, 972, 817, 766, 0, 628, 0, 859, 35, 382, 0, 815, 847, 751, 187, 0,
+  896, 0, 0, 0, 345, 0, 0, 883, 1067, 0, 0, 732, 0, 0, 0, 99, 819, 0, 0, 964,
+  237, 165, 580, 0, 0, 111, 298, 0, 0, 0, 0, 1063, 0, 0, 0, 0, 0, 0, 779, 0, 0,
+  559, 0, 528, 144, 0, 978, 0, 0, 0, 149, 386, 577, 174, 797, 0, 0, 743, 1089,
+  0, 0, 0, 0, 0, 0, 0, 0, 948, 657, 204, 430, 954, 89, 650, 1011, 1057, 1052,
+  940, 857, 722, 70, 541, 315, 0, 0, 373, 612, 606, 620, 0, 671, 0, 0, 0, 841,
+  52, 758, 0, 0, 943, 0, 1004, 0, 0, 0, 0, 0, 356, 0, 121, 0, 555, 0, 791, 240,
+  0, 0, 498, 0, 1030, 0, 0, 812, 0, 0, 0, 0, 718, 910, 0, 867, 0, 0, 0, 853,
+  888, 0, 0, 0, 801, 0, 180, 211, 0, 0, 75, 0, 1092, 283, 377, 768, 228, 400,
+  1045, 861, 286, 0, 0, 246, 0, 0, 0, 0, 43, 182, 990, 167, 432, 12, 773, 444,
+  0, 59, 957, 0, 394, 105, 0, 91, 543, 0, 0, 0, 0, 0, 499, 0, 806, 608, 159,
+  154, 392, 1087, 353, 1076, 880, 994, 793, 22, 804, 545, 0, 74, 967, 842, 0,
+  893, 0, 0, 561, 0, 0, 0, 1002, 402, 0, 748, 0, 68, 0, 0, 610, 0, 947, 0, 0,
+  247, 45, 0, 0, 0, 0, 586, 0, 570, 595, 0, 0, 0, 0, 0, 0, 951, 666, 928, 639,
+  103, 0, 675, 200, 475, 473, 0, 536, 202, 0, 975, 108, 0, 926, 1093, 1050,
+  427, 504, 378, 991, 937, 0, 0, 0, 0, 772, 551, 0, 0, 0, 0, 0, 602, 0, 126,
+  490, 870, 0, 0, 368, 0, 0, 0, 0, 452, 794, 0, 299, 424, 843, 0, 0, 136, 0, 0,
+  0, 0, 0, 209, 0, 0, 0, 0, 0, 1017, 646, 312, 0, 716, 0, 104, 0, 510, 0, 0,
+  31, 0, 0, 0, 0, 0, 0, 0, 796, 0, 0, 0, 222, 116, 889, 250, 0, 0, 0, 0, 952,
+  0, 524, 348, 0, 0, 776, 0, 51, 466, 933, 0, 0, 0, 507, 955, 489, 450, 184,
+  367, 0, 387, 0, 744, 321, 653, 597, 254, 117, 672, 169, 493, 1066, 709, 950,
+  39, 1077, 0, 1073, 0, 0, 50, 350, 645, 739, 0, 795, 633, 1078, 965, 599, 363,
+  426, 0, 411, 0, 810, 0, 0, 866, 0, 0, 521, 0, 0, 0, 163, 904, 0, 677, 258, 0,
+  0, 0, 0, 342, 0, 1035, 668, 245, 769, 1014, 0, 289, 0, 385, 755, 0, 0, 0, 0,
+  5, 359, 977, 347, 0, 421, 147, 95, 690, 907, 429, 0, 311, 0, 505, 502, 0, 0,
+  746, 352, 573, 873, 849, 931, 575, 684, 767, 1037, 823, 508, 448, 313, 0, 0,
+  0, 0, 0, 701, 109, 929, 0, 0, 692, 984, 1019, 640, 944, 733, 554, 934, 1044,
+  85, 0, 0, 0, 72, 634, 0, 0, 0, 153, 0, 567, 637, 1023, 330, 1038, 535, 1047,
+  0, 845, 0, 0, 0, 0, 988, 422, 0, 0, 0, 506, 0, 0, 65, 0, 1013, 0, 834, 971,
+  326, 539, 924, 0, 173, 287, 0, 687, 0, 0, 389, 869, 694, 360, 697, 780, 319,
+  380, 0, 0, 492, 0, 0, 1056, 1053, 566, 0, 73, 168, 406, 0, 850, 1041, 571, 0,
+  0, 712, 487, 901, 556, 208, 0, 568, 0, 0, 0, 0, 840, 887, 0, 0, 0, 483, 968,
+  0, 357, 285, 0, 102, 530, 0, 667, 441, 0, 0, 324, 0, 0, 54, 0, 0, 0, 974, 0,
+  143, 681, 343, 468, 0, 0, 0, 0, 300, 0, 0, 0, 651, 514, 479, 0, 0, 249, 935,
+  578, 0, 855, 0, 0, 361, 649, 643, 537, 592, 0, 0, 641, 453, 0, 0, 0, 316,
+  1043, 322, 480, 1007, 664, 0, 156, 0, 0, 84, 1088
 };
 #endif // !ASMJIT_DISABLE_NAMES
 // ----------------------------------------------------------------------------
@@ -617,29 +742,39 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(X86Op)           , 0 , 0 , 0x40, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(RW)|F(Volatile)|F(Special)       , U                    },
   { Enc(X86Op_66H)       , 0 , 0 , 0x40, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(RW)|F(Volatile)|F(Special)       , U                    },
   { Enc(X86Test)         , 0 , 0 , 0x00, 0x3F, 0, { O(GqdwbMem)       , O(Gqdwb)|O(Imm)   , U                 , U                 , U                  }, F(RO)                              , O_000000(F6,U,_,_,_) },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(FVBR)               , U                    },
+  { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                  }, F(WO)|F(Avx)|A(FSR)                , U                    },
   { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRmi)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(DQVB)               , U                    },
   { Enc(AvxRvmi_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvmr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(Mem)            , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
-  { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
-  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)|O(Zmm)     , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FVT1)               , U                    },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FVT1)               , U                    },
   { Enc(AvxRvmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x3F, 0, { O(Xmm)            , O(XmmMem)         , U                 , U                 , U                  }, F(RO)|F(Avx)                       , U                    },
-  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FVBR)               , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|F(Evex)|A(FVB)        , U                    },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|F(Evex)|A(FVB)        , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxMri_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Xy)             , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Gqd)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(GqdMem)         , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FVBS)               , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(RW)|F(Avx)|F(Evex)|A(FVB)        , U                    },
   { Enc(AvxMri)          , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Ymm)            , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxMri)          , 0 , 0 , 0x00, 0x00, 0, { O(GqdMem)         , O(Xmm)            , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
-  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                  }, F(RW)|F(Avx)                       , U                    },
-  { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                  }, F(RW)|F(Avx)                       , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(RW)|F(Avx)|A(FVBR)               , U                    },
+  { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                  }, F(RW)|F(Avx)|A(FSR)                , U                    },
   { Enc(Fma4_OptL)       , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(Fma4)            , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                  }, F(RW)|F(Avx)                       , U                    },
+  { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                  }, F(RW)|F(Avx)                       , U                    },
   { Enc(XopRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(XopRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxGather)       , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Mem)            , O(Xy)             , U                 , U                  }, F(RW)|F(Avx)                       , U                    },
@@ -650,9 +785,12 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , U                 , U                 , U                  }, F(RO)|F(Avx)|F(Special)            , U                    },
   { Enc(AvxRvmMvr_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                  }, F(RW)|F(Avx)                       , O_660F38(2F,U,_,_,_) },
   { Enc(AvxRvmMvr_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                  }, F(RW)|F(Avx)                       , O_660F38(2E,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(29,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_000F00(29,U,_,_,_) },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(FVBS)               , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                  }, F(WO)|F(Avx)|A(FSS)                , U                    },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FV)                 , O_660F00(29,U,_,_,1) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FV)                 , O_000F00(29,U,_,_,0) },
   { Enc(AvxMovDQ)        , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(7E,U,_,_,_) },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(7F,U,_,_,_) },
   { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_F30F00(7F,U,_,_,_) },
   { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(Xmm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
@@ -664,12 +802,16 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(AvxMr_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Mem)            , O(Xy)             , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxMovSsSd)      , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(XmmMem)         , O(Xmm)            , U                 , U                  }, F(WO)|F(Avx)                       , O_F20F00(11,U,_,_,_) },
   { Enc(AvxMovSsSd)      , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Xmm)            , O(Xmm)            , U                 , U                  }, F(WO)|F(Avx)                       , O_F30F00(11,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(11,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_000F00(11,U,_,_,_) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FV)                 , O_660F00(11,U,_,_,1) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(FV)                 , O_000F00(11,U,_,_,0) },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                  }, F(WO)|F(Avx)|A(FSR)                , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(BWV)                , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(FVB)                , U                    },
   { Enc(AvxRvmr)         , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(XopRvrmRvmr_OptL), 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRmi)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)|F(Special)            , U                    },
   { Enc(XopRvmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(RW)|F(Avx)|A(FVB)                , U                    },
   { Enc(AvxRvmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(Ymm)            , O(YmmMem)         , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(Ymm)            , O(YmmMem)         , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvrmRvmr_OptL), 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                  }, F(WO)|F(Avx)                       , U                    },
@@ -1366,440 +1508,447 @@ enum X86InstData_ExtendedIndex {
     kX86InstIdVaddps_ExtendedIndex = 211,
     kX86InstIdVaddsd_ExtendedIndex = 212,
     kX86InstIdVaddss_ExtendedIndex = 212,
-    kX86InstIdVaddsubpd_ExtendedIndex = 211,
-    kX86InstIdVaddsubps_ExtendedIndex = 211,
-    kX86InstIdVaesdec_ExtendedIndex = 212,
-    kX86InstIdVaesdeclast_ExtendedIndex = 212,
-    kX86InstIdVaesenc_ExtendedIndex = 212,
-    kX86InstIdVaesenclast_ExtendedIndex = 212,
-    kX86InstIdVaesimc_ExtendedIndex = 213,
-    kX86InstIdVaeskeygenassist_ExtendedIndex = 214,
-    kX86InstIdVandnpd_ExtendedIndex = 211,
-    kX86InstIdVandnps_ExtendedIndex = 211,
-    kX86InstIdVandpd_ExtendedIndex = 211,
-    kX86InstIdVandps_ExtendedIndex = 211,
-    kX86InstIdVblendpd_ExtendedIndex = 215,
-    kX86InstIdVblendps_ExtendedIndex = 215,
-    kX86InstIdVblendvpd_ExtendedIndex = 216,
-    kX86InstIdVblendvps_ExtendedIndex = 216,
-    kX86InstIdVbroadcastf128_ExtendedIndex = 217,
-    kX86InstIdVbroadcasti128_ExtendedIndex = 217,
-    kX86InstIdVbroadcastsd_ExtendedIndex = 218,
-    kX86InstIdVbroadcastss_ExtendedIndex = 219,
-    kX86InstIdVcmppd_ExtendedIndex = 215,
-    kX86InstIdVcmpps_ExtendedIndex = 215,
-    kX86InstIdVcmpsd_ExtendedIndex = 220,
-    kX86InstIdVcmpss_ExtendedIndex = 220,
-    kX86InstIdVcomisd_ExtendedIndex = 221,
-    kX86InstIdVcomiss_ExtendedIndex = 221,
-    kX86InstIdVcvtdq2pd_ExtendedIndex = 219,
-    kX86InstIdVcvtdq2ps_ExtendedIndex = 222,
-    kX86InstIdVcvtpd2dq_ExtendedIndex = 223,
-    kX86InstIdVcvtpd2ps_ExtendedIndex = 223,
-    kX86InstIdVcvtph2ps_ExtendedIndex = 219,
-    kX86InstIdVcvtps2dq_ExtendedIndex = 222,
-    kX86InstIdVcvtps2pd_ExtendedIndex = 219,
-    kX86InstIdVcvtps2ph_ExtendedIndex = 224,
-    kX86InstIdVcvtsd2si_ExtendedIndex = 225,
-    kX86InstIdVcvtsd2ss_ExtendedIndex = 212,
-    kX86InstIdVcvtsi2sd_ExtendedIndex = 226,
-    kX86InstIdVcvtsi2ss_ExtendedIndex = 226,
-    kX86InstIdVcvtss2sd_ExtendedIndex = 212,
-    kX86InstIdVcvtss2si_ExtendedIndex = 225,
-    kX86InstIdVcvttpd2dq_ExtendedIndex = 227,
-    kX86InstIdVcvttps2dq_ExtendedIndex = 222,
-    kX86InstIdVcvttsd2si_ExtendedIndex = 225,
-    kX86InstIdVcvttss2si_ExtendedIndex = 225,
+    kX86InstIdVaddsubpd_ExtendedIndex = 213,
+    kX86InstIdVaddsubps_ExtendedIndex = 213,
+    kX86InstIdVaesdec_ExtendedIndex = 214,
+    kX86InstIdVaesdeclast_ExtendedIndex = 214,
+    kX86InstIdVaesenc_ExtendedIndex = 214,
+    kX86InstIdVaesenclast_ExtendedIndex = 214,
+    kX86InstIdVaesimc_ExtendedIndex = 215,
+    kX86InstIdVaeskeygenassist_ExtendedIndex = 216,
+    kX86InstIdVandnpd_ExtendedIndex = 217,
+    kX86InstIdVandnps_ExtendedIndex = 217,
+    kX86InstIdVandpd_ExtendedIndex = 217,
+    kX86InstIdVandps_ExtendedIndex = 217,
+    kX86InstIdVblendpd_ExtendedIndex = 218,
+    kX86InstIdVblendps_ExtendedIndex = 218,
+    kX86InstIdVblendvpd_ExtendedIndex = 219,
+    kX86InstIdVblendvps_ExtendedIndex = 219,
+    kX86InstIdVbroadcastf128_ExtendedIndex = 220,
+    kX86InstIdVbroadcasti128_ExtendedIndex = 220,
+    kX86InstIdVbroadcastsd_ExtendedIndex = 221,
+    kX86InstIdVbroadcastss_ExtendedIndex = 222,
+    kX86InstIdVcmppd_ExtendedIndex = 218,
+    kX86InstIdVcmpps_ExtendedIndex = 218,
+    kX86InstIdVcmpsd_ExtendedIndex = 223,
+    kX86InstIdVcmpss_ExtendedIndex = 223,
+    kX86InstIdVcomisd_ExtendedIndex = 224,
+    kX86InstIdVcomiss_ExtendedIndex = 224,
+    kX86InstIdVcvtdq2pd_ExtendedIndex = 225,
+    kX86InstIdVcvtdq2ps_ExtendedIndex = 226,
+    kX86InstIdVcvtne2ps2bf16_ExtendedIndex = 227,
+    kX86InstIdVcvtneps2bf16_ExtendedIndex = 228,
+    kX86InstIdVcvtpd2dq_ExtendedIndex = 229,
+    kX86InstIdVcvtpd2ps_ExtendedIndex = 229,
+    kX86InstIdVcvtph2ps_ExtendedIndex = 225,
+    kX86InstIdVcvtps2dq_ExtendedIndex = 226,
+    kX86InstIdVcvtps2pd_ExtendedIndex = 225,
+    kX86InstIdVcvtps2ph_ExtendedIndex = 230,
+    kX86InstIdVcvtsd2si_ExtendedIndex = 231,
+    kX86InstIdVcvtsd2ss_ExtendedIndex = 214,
+    kX86InstIdVcvtsi2sd_ExtendedIndex = 232,
+    kX86InstIdVcvtsi2ss_ExtendedIndex = 232,
+    kX86InstIdVcvtss2sd_ExtendedIndex = 214,
+    kX86InstIdVcvtss2si_ExtendedIndex = 231,
+    kX86InstIdVcvttpd2dq_ExtendedIndex = 233,
+    kX86InstIdVcvttps2dq_ExtendedIndex = 234,
+    kX86InstIdVcvttsd2si_ExtendedIndex = 231,
+    kX86InstIdVcvttss2si_ExtendedIndex = 231,
     kX86InstIdVdivpd_ExtendedIndex = 211,
     kX86InstIdVdivps_ExtendedIndex = 211,
     kX86InstIdVdivsd_ExtendedIndex = 212,
     kX86InstIdVdivss_ExtendedIndex = 212,
-    kX86InstIdVdppd_ExtendedIndex = 220,
-    kX86InstIdVdpps_ExtendedIndex = 215,
-    kX86InstIdVextractf128_ExtendedIndex = 228,
-    kX86InstIdVextracti128_ExtendedIndex = 228,
-    kX86InstIdVextractps_ExtendedIndex = 229,
-    kX86InstIdVfmadd132pd_ExtendedIndex = 230,
-    kX86InstIdVfmadd132ps_ExtendedIndex = 230,
-    kX86InstIdVfmadd132sd_ExtendedIndex = 231,
-    kX86InstIdVfmadd132ss_ExtendedIndex = 231,
-    kX86InstIdVfmadd213pd_ExtendedIndex = 230,
-    kX86InstIdVfmadd213ps_ExtendedIndex = 230,
-    kX86InstIdVfmadd213sd_ExtendedIndex = 231,
-    kX86InstIdVfmadd213ss_ExtendedIndex = 231,
-    kX86InstIdVfmadd231pd_ExtendedIndex = 230,
-    kX86InstIdVfmadd231ps_ExtendedIndex = 230,
-    kX86InstIdVfmadd231sd_ExtendedIndex = 231,
-    kX86InstIdVfmadd231ss_ExtendedIndex = 231,
-    kX86InstIdVfmaddpd_ExtendedIndex = 232,
-    kX86InstIdVfmaddps_ExtendedIndex = 232,
-    kX86InstIdVfmaddsd_ExtendedIndex = 233,
-    kX86InstIdVfmaddss_ExtendedIndex = 233,
-    kX86InstIdVfmaddsub132pd_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub132ps_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub213pd_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub213ps_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub231pd_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub231ps_ExtendedIndex = 230,
-    kX86InstIdVfmaddsubpd_ExtendedIndex = 232,
-    kX86InstIdVfmaddsubps_ExtendedIndex = 232,
-    kX86InstIdVfmsub132pd_ExtendedIndex = 230,
-    kX86InstIdVfmsub132ps_ExtendedIndex = 230,
-    kX86InstIdVfmsub132sd_ExtendedIndex = 231,
-    kX86InstIdVfmsub132ss_ExtendedIndex = 231,
-    kX86InstIdVfmsub213pd_ExtendedIndex = 230,
-    kX86InstIdVfmsub213ps_ExtendedIndex = 230,
-    kX86InstIdVfmsub213sd_ExtendedIndex = 231,
-    kX86InstIdVfmsub213ss_ExtendedIndex = 231,
-    kX86InstIdVfmsub231pd_ExtendedIndex = 230,
-    kX86InstIdVfmsub231ps_ExtendedIndex = 230,
-    kX86InstIdVfmsub231sd_ExtendedIndex = 231,
-    kX86InstIdVfmsub231ss_ExtendedIndex = 231,
-    kX86InstIdVfmsubadd132pd_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd132ps_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd213pd_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd213ps_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd231pd_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd231ps_ExtendedIndex = 230,
-    kX86InstIdVfmsubaddpd_ExtendedIndex = 232,
-    kX86InstIdVfmsubaddps_ExtendedIndex = 232,
-    kX86InstIdVfmsubpd_ExtendedIndex = 232,
-    kX86InstIdVfmsubps_ExtendedIndex = 232,
-    kX86InstIdVfmsubsd_ExtendedIndex = 233,
-    kX86InstIdVfmsubss_ExtendedIndex = 233,
-    kX86InstIdVfnmadd132pd_ExtendedIndex = 230,
-    kX86InstIdVfnmadd132ps_ExtendedIndex = 230,
-    kX86InstIdVfnmadd132sd_ExtendedIndex = 231,
-    kX86InstIdVfnmadd132ss_ExtendedIndex = 231,
-    kX86InstIdVfnmadd213pd_ExtendedIndex = 230,
-    kX86InstIdVfnmadd213ps_ExtendedIndex = 230,
-    kX86InstIdVfnmadd213sd_ExtendedIndex = 231,
-    kX86InstIdVfnmadd213ss_ExtendedIndex = 231,
-    kX86InstIdVfnmadd231pd_ExtendedIndex = 230,
-    kX86InstIdVfnmadd231ps_ExtendedIndex = 230,
-    kX86InstIdVfnmadd231sd_ExtendedIndex = 231,
-    kX86InstIdVfnmadd231ss_ExtendedIndex = 231,
-    kX86InstIdVfnmaddpd_ExtendedIndex = 232,
-    kX86InstIdVfnmaddps_ExtendedIndex = 232,
-    kX86InstIdVfnmaddsd_ExtendedIndex = 233,
-    kX86InstIdVfnmaddss_ExtendedIndex = 233,
-    kX86InstIdVfnmsub132pd_ExtendedIndex = 230,
-    kX86InstIdVfnmsub132ps_ExtendedIndex = 230,
-    kX86InstIdVfnmsub132sd_ExtendedIndex = 231,
-    kX86InstIdVfnmsub132ss_ExtendedIndex = 231,
-    kX86InstIdVfnmsub213pd_ExtendedIndex = 230,
-    kX86InstIdVfnmsub213ps_ExtendedIndex = 230,
-    kX86InstIdVfnmsub213sd_ExtendedIndex = 231,
-    kX86InstIdVfnmsub213ss_ExtendedIndex = 231,
-    kX86InstIdVfnmsub231pd_ExtendedIndex = 230,
-    kX86InstIdVfnmsub231ps_ExtendedIndex = 230,
-    kX86InstIdVfnmsub231sd_ExtendedIndex = 231,
-    kX86InstIdVfnmsub231ss_ExtendedIndex = 231,
-    kX86InstIdVfnmsubpd_ExtendedIndex = 232,
-    kX86InstIdVfnmsubps_ExtendedIndex = 232,
-    kX86InstIdVfnmsubsd_ExtendedIndex = 233,
-    kX86InstIdVfnmsubss_ExtendedIndex = 233,
-    kX86InstIdVfrczpd_ExtendedIndex = 234,
-    kX86InstIdVfrczps_ExtendedIndex = 234,
-    kX86InstIdVfrczsd_ExtendedIndex = 235,
-    kX86InstIdVfrczss_ExtendedIndex = 235,
-    kX86InstIdVgatherdpd_ExtendedIndex = 236,
-    kX86InstIdVgatherdps_ExtendedIndex = 236,
-    kX86InstIdVgatherqpd_ExtendedIndex = 236,
-    kX86InstIdVgatherqps_ExtendedIndex = 237,
-    kX86InstIdVhaddpd_ExtendedIndex = 211,
-    kX86InstIdVhaddps_ExtendedIndex = 211,
-    kX86InstIdVhsubpd_ExtendedIndex = 211,
-    kX86InstIdVhsubps_ExtendedIndex = 211,
-    kX86InstIdVinsertf128_ExtendedIndex = 238,
-    kX86InstIdVinserti128_ExtendedIndex = 238,
-    kX86InstIdVinsertps_ExtendedIndex = 220,
-    kX86InstIdVlddqu_ExtendedIndex = 239,
-    kX86InstIdVldmxcsr_ExtendedIndex = 240,
-    kX86InstIdVmaskmovdqu_ExtendedIndex = 241,
-    kX86InstIdVmaskmovpd_ExtendedIndex = 242,
-    kX86InstIdVmaskmovps_ExtendedIndex = 243,
-    kX86InstIdVmaxpd_ExtendedIndex = 211,
-    kX86InstIdVmaxps_ExtendedIndex = 211,
-    kX86InstIdVmaxsd_ExtendedIndex = 211,
-    kX86InstIdVmaxss_ExtendedIndex = 211,
-    kX86InstIdVminpd_ExtendedIndex = 211,
-    kX86InstIdVminps_ExtendedIndex = 211,
-    kX86InstIdVminsd_ExtendedIndex = 211,
-    kX86InstIdVminss_ExtendedIndex = 211,
-    kX86InstIdVmovapd_ExtendedIndex = 244,
-    kX86InstIdVmovaps_ExtendedIndex = 245,
-    kX86InstIdVmovd_ExtendedIndex = 246,
-    kX86InstIdVmovddup_ExtendedIndex = 222,
-    kX86InstIdVmovdqa_ExtendedIndex = 247,
-    kX86InstIdVmovdqu_ExtendedIndex = 248,
-    kX86InstIdVmovhlps_ExtendedIndex = 249,
-    kX86InstIdVmovhpd_ExtendedIndex = 250,
-    kX86InstIdVmovhps_ExtendedIndex = 251,
-    kX86InstIdVmovlhps_ExtendedIndex = 249,
-    kX86InstIdVmovlpd_ExtendedIndex = 252,
-    kX86InstIdVmovlps_ExtendedIndex = 253,
-    kX86InstIdVmovmskpd_ExtendedIndex = 254,
-    kX86InstIdVmovmskps_ExtendedIndex = 254,
-    kX86InstIdVmovntdq_ExtendedIndex = 255,
-    kX86InstIdVmovntdqa_ExtendedIndex = 239,
-    kX86InstIdVmovntpd_ExtendedIndex = 255,
-    kX86InstIdVmovntps_ExtendedIndex = 255,
-    kX86InstIdVmovq_ExtendedIndex = 246,
-    kX86InstIdVmovsd_ExtendedIndex = 256,
-    kX86InstIdVmovshdup_ExtendedIndex = 222,
-    kX86InstIdVmovsldup_ExtendedIndex = 222,
-    kX86InstIdVmovss_ExtendedIndex = 257,
-    kX86InstIdVmovupd_ExtendedIndex = 258,
-    kX86InstIdVmovups_ExtendedIndex = 259,
-    kX86InstIdVmpsadbw_ExtendedIndex = 215,
+    kX86InstIdVdpbf16ps_ExtendedIndex = 235,
+    kX86InstIdVdppd_ExtendedIndex = 223,
+    kX86InstIdVdpps_ExtendedIndex = 218,
+    kX86InstIdVextractf128_ExtendedIndex = 236,
+    kX86InstIdVextracti128_ExtendedIndex = 236,
+    kX86InstIdVextractps_ExtendedIndex = 237,
+    kX86InstIdVfmadd132pd_ExtendedIndex = 238,
+    kX86InstIdVfmadd132ps_ExtendedIndex = 238,
+    kX86InstIdVfmadd132sd_ExtendedIndex = 239,
+    kX86InstIdVfmadd132ss_ExtendedIndex = 239,
+    kX86InstIdVfmadd213pd_ExtendedIndex = 238,
+    kX86InstIdVfmadd213ps_ExtendedIndex = 238,
+    kX86InstIdVfmadd213sd_ExtendedIndex = 239,
+    kX86InstIdVfmadd213ss_ExtendedIndex = 239,
+    kX86InstIdVfmadd231pd_ExtendedIndex = 238,
+    kX86InstIdVfmadd231ps_ExtendedIndex = 238,
+    kX86InstIdVfmadd231sd_ExtendedIndex = 239,
+    kX86InstIdVfmadd231ss_ExtendedIndex = 239,
+    kX86InstIdVfmaddpd_ExtendedIndex = 240,
+    kX86InstIdVfmaddps_ExtendedIndex = 240,
+    kX86InstIdVfmaddsd_ExtendedIndex = 241,
+    kX86InstIdVfmaddss_ExtendedIndex = 241,
+    kX86InstIdVfmaddsub132pd_ExtendedIndex = 242,
+    kX86InstIdVfmaddsub132ps_ExtendedIndex = 242,
+    kX86InstIdVfmaddsub213pd_ExtendedIndex = 242,
+    kX86InstIdVfmaddsub213ps_ExtendedIndex = 242,
+    kX86InstIdVfmaddsub231pd_ExtendedIndex = 242,
+    kX86InstIdVfmaddsub231ps_ExtendedIndex = 242,
+    kX86InstIdVfmaddsubpd_ExtendedIndex = 240,
+    kX86InstIdVfmaddsubps_ExtendedIndex = 240,
+    kX86InstIdVfmsub132pd_ExtendedIndex = 242,
+    kX86InstIdVfmsub132ps_ExtendedIndex = 242,
+    kX86InstIdVfmsub132sd_ExtendedIndex = 243,
+    kX86InstIdVfmsub132ss_ExtendedIndex = 243,
+    kX86InstIdVfmsub213pd_ExtendedIndex = 242,
+    kX86InstIdVfmsub213ps_ExtendedIndex = 242,
+    kX86InstIdVfmsub213sd_ExtendedIndex = 243,
+    kX86InstIdVfmsub213ss_ExtendedIndex = 243,
+    kX86InstIdVfmsub231pd_ExtendedIndex = 242,
+    kX86InstIdVfmsub231ps_ExtendedIndex = 242,
+    kX86InstIdVfmsub231sd_ExtendedIndex = 243,
+    kX86InstIdVfmsub231ss_ExtendedIndex = 243,
+    kX86InstIdVfmsubadd132pd_ExtendedIndex = 242,
+    kX86InstIdVfmsubadd132ps_ExtendedIndex = 242,
+    kX86InstIdVfmsubadd213pd_ExtendedIndex = 242,
+    kX86InstIdVfmsubadd213ps_ExtendedIndex = 242,
+    kX86InstIdVfmsubadd231pd_ExtendedIndex = 242,
+    kX86InstIdVfmsubadd231ps_ExtendedIndex = 242,
+    kX86InstIdVfmsubaddpd_ExtendedIndex = 240,
+    kX86InstIdVfmsubaddps_ExtendedIndex = 240,
+    kX86InstIdVfmsubpd_ExtendedIndex = 240,
+    kX86InstIdVfmsubps_ExtendedIndex = 240,
+    kX86InstIdVfmsubsd_ExtendedIndex = 241,
+    kX86InstIdVfmsubss_ExtendedIndex = 241,
+    kX86InstIdVfnmadd132pd_ExtendedIndex = 242,
+    kX86InstIdVfnmadd132ps_ExtendedIndex = 242,
+    kX86InstIdVfnmadd132sd_ExtendedIndex = 243,
+    kX86InstIdVfnmadd132ss_ExtendedIndex = 243,
+    kX86InstIdVfnmadd213pd_ExtendedIndex = 242,
+    kX86InstIdVfnmadd213ps_ExtendedIndex = 242,
+    kX86InstIdVfnmadd213sd_ExtendedIndex = 243,
+    kX86InstIdVfnmadd213ss_ExtendedIndex = 243,
+    kX86InstIdVfnmadd231pd_ExtendedIndex = 242,
+    kX86InstIdVfnmadd231ps_ExtendedIndex = 242,
+    kX86InstIdVfnmadd231sd_ExtendedIndex = 243,
+    kX86InstIdVfnmadd231ss_ExtendedIndex = 243,
+    kX86InstIdVfnmaddpd_ExtendedIndex = 240,
+    kX86InstIdVfnmaddps_ExtendedIndex = 240,
+    kX86InstIdVfnmaddsd_ExtendedIndex = 241,
+    kX86InstIdVfnmaddss_ExtendedIndex = 241,
+    kX86InstIdVfnmsub132pd_ExtendedIndex = 242,
+    kX86InstIdVfnmsub132ps_ExtendedIndex = 242,
+    kX86InstIdVfnmsub132sd_ExtendedIndex = 243,
+    kX86InstIdVfnmsub132ss_ExtendedIndex = 243,
+    kX86InstIdVfnmsub213pd_ExtendedIndex = 242,
+    kX86InstIdVfnmsub213ps_ExtendedIndex = 242,
+    kX86InstIdVfnmsub213sd_ExtendedIndex = 243,
+    kX86InstIdVfnmsub213ss_ExtendedIndex = 243,
+    kX86InstIdVfnmsub231pd_ExtendedIndex = 242,
+    kX86InstIdVfnmsub231ps_ExtendedIndex = 242,
+    kX86InstIdVfnmsub231sd_ExtendedIndex = 243,
+    kX86InstIdVfnmsub231ss_ExtendedIndex = 243,
+    kX86InstIdVfnmsubpd_ExtendedIndex = 240,
+    kX86InstIdVfnmsubps_ExtendedIndex = 240,
+    kX86InstIdVfnmsubsd_ExtendedIndex = 241,
+    kX86InstIdVfnmsubss_ExtendedIndex = 241,
+    kX86InstIdVfrczpd_ExtendedIndex = 244,
+    kX86InstIdVfrczps_ExtendedIndex = 244,
+    kX86InstIdVfrczsd_ExtendedIndex = 245,
+    kX86InstIdVfrczss_ExtendedIndex = 245,
+    kX86InstIdVgatherdpd_ExtendedIndex = 246,
+    kX86InstIdVgatherdps_ExtendedIndex = 246,
+    kX86InstIdVgatherqpd_ExtendedIndex = 246,
+    kX86InstIdVgatherqps_ExtendedIndex = 247,
+    kX86InstIdVhaddpd_ExtendedIndex = 213,
+    kX86InstIdVhaddps_ExtendedIndex = 213,
+    kX86InstIdVhsubpd_ExtendedIndex = 213,
+    kX86InstIdVhsubps_ExtendedIndex = 213,
+    kX86InstIdVinsertf128_ExtendedIndex = 248,
+    kX86InstIdVinserti128_ExtendedIndex = 248,
+    kX86InstIdVinsertps_ExtendedIndex = 223,
+    kX86InstIdVlddqu_ExtendedIndex = 249,
+    kX86InstIdVldmxcsr_ExtendedIndex = 250,
+    kX86InstIdVmaskmovdqu_ExtendedIndex = 251,
+    kX86InstIdVmaskmovpd_ExtendedIndex = 252,
+    kX86InstIdVmaskmovps_ExtendedIndex = 253,
+    kX86InstIdVmaxpd_ExtendedIndex = 254,
+    kX86InstIdVmaxps_ExtendedIndex = 254,
+    kX86InstIdVmaxsd_ExtendedIndex = 255,
+    kX86InstIdVmaxss_ExtendedIndex = 255,
+    kX86InstIdVminpd_ExtendedIndex = 254,
+    kX86InstIdVminps_ExtendedIndex = 254,
+    kX86InstIdVminsd_ExtendedIndex = 255,
+    kX86InstIdVminss_ExtendedIndex = 255,
+    kX86InstIdVmovapd_ExtendedIndex = 256,
+    kX86InstIdVmovaps_ExtendedIndex = 257,
+    kX86InstIdVmovd_ExtendedIndex = 258,
+    kX86InstIdVmovddup_ExtendedIndex = 259,
+    kX86InstIdVmovdqa_ExtendedIndex = 260,
+    kX86InstIdVmovdqu_ExtendedIndex = 261,
+    kX86InstIdVmovhlps_ExtendedIndex = 262,
+    kX86InstIdVmovhpd_ExtendedIndex = 263,
+    kX86InstIdVmovhps_ExtendedIndex = 264,
+    kX86InstIdVmovlhps_ExtendedIndex = 262,
+    kX86InstIdVmovlpd_ExtendedIndex = 265,
+    kX86InstIdVmovlps_ExtendedIndex = 266,
+    kX86InstIdVmovmskpd_ExtendedIndex = 267,
+    kX86InstIdVmovmskps_ExtendedIndex = 267,
+    kX86InstIdVmovntdq_ExtendedIndex = 268,
+    kX86InstIdVmovntdqa_ExtendedIndex = 249,
+    kX86InstIdVmovntpd_ExtendedIndex = 268,
+    kX86InstIdVmovntps_ExtendedIndex = 268,
+    kX86InstIdVmovq_ExtendedIndex = 258,
+    kX86InstIdVmovsd_ExtendedIndex = 269,
+    kX86InstIdVmovshdup_ExtendedIndex = 259,
+    kX86InstIdVmovsldup_ExtendedIndex = 259,
+    kX86InstIdVmovss_ExtendedIndex = 270,
+    kX86InstIdVmovupd_ExtendedIndex = 271,
+    kX86InstIdVmovups_ExtendedIndex = 272,
+    kX86InstIdVmpsadbw_ExtendedIndex = 218,
     kX86InstIdVmulpd_ExtendedIndex = 211,
     kX86InstIdVmulps_ExtendedIndex = 211,
-    kX86InstIdVmulsd_ExtendedIndex = 211,
-    kX86InstIdVmulss_ExtendedIndex = 211,
-    kX86InstIdVorpd_ExtendedIndex = 211,
-    kX86InstIdVorps_ExtendedIndex = 211,
-    kX86InstIdVpabsb_ExtendedIndex = 222,
-    kX86InstIdVpabsd_ExtendedIndex = 222,
-    kX86InstIdVpabsw_ExtendedIndex = 222,
-    kX86InstIdVpackssdw_ExtendedIndex = 211,
-    kX86InstIdVpacksswb_ExtendedIndex = 211,
-    kX86InstIdVpackusdw_ExtendedIndex = 211,
-    kX86InstIdVpackuswb_ExtendedIndex = 211,
-    kX86InstIdVpaddb_ExtendedIndex = 211,
-    kX86InstIdVpaddd_ExtendedIndex = 211,
-    kX86InstIdVpaddq_ExtendedIndex = 211,
-    kX86InstIdVpaddsb_ExtendedIndex = 211,
-    kX86InstIdVpaddsw_ExtendedIndex = 211,
-    kX86InstIdVpaddusb_ExtendedIndex = 211,
-    kX86InstIdVpaddusw_ExtendedIndex = 211,
-    kX86InstIdVpaddw_ExtendedIndex = 211,
-    kX86InstIdVpalignr_ExtendedIndex = 215,
-    kX86InstIdVpand_ExtendedIndex = 211,
-    kX86InstIdVpandn_ExtendedIndex = 211,
-    kX86InstIdVpavgb_ExtendedIndex = 211,
-    kX86InstIdVpavgw_ExtendedIndex = 211,
-    kX86InstIdVpblendd_ExtendedIndex = 215,
-    kX86InstIdVpblendvb_ExtendedIndex = 260,
-    kX86InstIdVpblendw_ExtendedIndex = 215,
-    kX86InstIdVpbroadcastb_ExtendedIndex = 219,
-    kX86InstIdVpbroadcastd_ExtendedIndex = 219,
-    kX86InstIdVpbroadcastq_ExtendedIndex = 219,
-    kX86InstIdVpbroadcastw_ExtendedIndex = 219,
-    kX86InstIdVpclmulqdq_ExtendedIndex = 220,
-    kX86InstIdVpcmov_ExtendedIndex = 261,
-    kX86InstIdVpcmpeqb_ExtendedIndex = 211,
-    kX86InstIdVpcmpeqd_ExtendedIndex = 211,
-    kX86InstIdVpcmpeqq_ExtendedIndex = 211,
-    kX86InstIdVpcmpeqw_ExtendedIndex = 211,
-    kX86InstIdVpcmpestri_ExtendedIndex = 262,
-    kX86InstIdVpcmpestrm_ExtendedIndex = 262,
-    kX86InstIdVpcmpgtb_ExtendedIndex = 211,
-    kX86InstIdVpcmpgtd_ExtendedIndex = 211,
-    kX86InstIdVpcmpgtq_ExtendedIndex = 211,
-    kX86InstIdVpcmpgtw_ExtendedIndex = 211,
-    kX86InstIdVpcmpistri_ExtendedIndex = 262,
-    kX86InstIdVpcmpistrm_ExtendedIndex = 262,
-    kX86InstIdVpcomb_ExtendedIndex = 263,
-    kX86InstIdVpcomd_ExtendedIndex = 263,
-    kX86InstIdVpcomq_ExtendedIndex = 263,
-    kX86InstIdVpcomub_ExtendedIndex = 263,
-    kX86InstIdVpcomud_ExtendedIndex = 263,
-    kX86InstIdVpcomuq_ExtendedIndex = 263,
-    kX86InstIdVpcomuw_ExtendedIndex = 263,
-    kX86InstIdVpcomw_ExtendedIndex = 263,
-    kX86InstIdVperm2f128_ExtendedIndex = 264,
-    kX86InstIdVperm2i128_ExtendedIndex = 264,
-    kX86InstIdVpermd_ExtendedIndex = 265,
-    kX86InstIdVpermil2pd_ExtendedIndex = 266,
-    kX86InstIdVpermil2ps_ExtendedIndex = 266,
-    kX86InstIdVpermilpd_ExtendedIndex = 267,
-    kX86InstIdVpermilps_ExtendedIndex = 268,
-    kX86InstIdVpermpd_ExtendedIndex = 269,
-    kX86InstIdVpermps_ExtendedIndex = 265,
-    kX86InstIdVpermq_ExtendedIndex = 269,
-    kX86InstIdVpextrb_ExtendedIndex = 270,
-    kX86InstIdVpextrd_ExtendedIndex = 229,
-    kX86InstIdVpextrq_ExtendedIndex = 271,
-    kX86InstIdVpextrw_ExtendedIndex = 272,
-    kX86InstIdVpgatherdd_ExtendedIndex = 236,
-    kX86InstIdVpgatherdq_ExtendedIndex = 236,
-    kX86InstIdVpgatherqd_ExtendedIndex = 237,
-    kX86InstIdVpgatherqq_ExtendedIndex = 236,
-    kX86InstIdVphaddbd_ExtendedIndex = 235,
-    kX86InstIdVphaddbq_ExtendedIndex = 235,
-    kX86InstIdVphaddbw_ExtendedIndex = 235,
-    kX86InstIdVphaddd_ExtendedIndex = 211,
-    kX86InstIdVphadddq_ExtendedIndex = 235,
-    kX86InstIdVphaddsw_ExtendedIndex = 211,
-    kX86InstIdVphaddubd_ExtendedIndex = 235,
-    kX86InstIdVphaddubq_ExtendedIndex = 235,
-    kX86InstIdVphaddubw_ExtendedIndex = 235,
-    kX86InstIdVphaddudq_ExtendedIndex = 235,
-    kX86InstIdVphadduwd_ExtendedIndex = 235,
-    kX86InstIdVphadduwq_ExtendedIndex = 235,
-    kX86InstIdVphaddw_ExtendedIndex = 211,
-    kX86InstIdVphaddwd_ExtendedIndex = 235,
-    kX86InstIdVphaddwq_ExtendedIndex = 235,
-    kX86InstIdVphminposuw_ExtendedIndex = 213,
-    kX86InstIdVphsubbw_ExtendedIndex = 235,
-    kX86InstIdVphsubd_ExtendedIndex = 211,
-    kX86InstIdVphsubdq_ExtendedIndex = 235,
-    kX86InstIdVphsubsw_ExtendedIndex = 211,
-    kX86InstIdVphsubw_ExtendedIndex = 211,
-    kX86InstIdVphsubwd_ExtendedIndex = 235,
-    kX86InstIdVpinsrb_ExtendedIndex = 273,
-    kX86InstIdVpinsrd_ExtendedIndex = 274,
-    kX86InstIdVpinsrq_ExtendedIndex = 275,
-    kX86InstIdVpinsrw_ExtendedIndex = 276,
-    kX86InstIdVpmacsdd_ExtendedIndex = 277,
-    kX86InstIdVpmacsdqh_ExtendedIndex = 277,
-    kX86InstIdVpmacsdql_ExtendedIndex = 277,
-    kX86InstIdVpmacssdd_ExtendedIndex = 277,
-    kX86InstIdVpmacssdqh_ExtendedIndex = 277,
-    kX86InstIdVpmacssdql_ExtendedIndex = 277,
-    kX86InstIdVpmacsswd_ExtendedIndex = 277,
-    kX86InstIdVpmacssww_ExtendedIndex = 277,
-    kX86InstIdVpmacswd_ExtendedIndex = 277,
-    kX86InstIdVpmacsww_ExtendedIndex = 277,
-    kX86InstIdVpmadcsswd_ExtendedIndex = 277,
-    kX86InstIdVpmadcswd_ExtendedIndex = 277,
-    kX86InstIdVpmaddubsw_ExtendedIndex = 211,
-    kX86InstIdVpmaddwd_ExtendedIndex = 211,
-    kX86InstIdVpmaskmovd_ExtendedIndex = 278,
-    kX86InstIdVpmaskmovq_ExtendedIndex = 278,
-    kX86InstIdVpmaxsb_ExtendedIndex = 211,
-    kX86InstIdVpmaxsd_ExtendedIndex = 211,
-    kX86InstIdVpmaxsw_ExtendedIndex = 211,
-    kX86InstIdVpmaxub_ExtendedIndex = 211,
-    kX86InstIdVpmaxud_ExtendedIndex = 211,
-    kX86InstIdVpmaxuw_ExtendedIndex = 211,
-    kX86InstIdVpminsb_ExtendedIndex = 211,
-    kX86InstIdVpminsd_ExtendedIndex = 211,
-    kX86InstIdVpminsw_ExtendedIndex = 211,
-    kX86InstIdVpminub_ExtendedIndex = 211,
-    kX86InstIdVpminud_ExtendedIndex = 211,
-    kX86InstIdVpminuw_ExtendedIndex = 211,
-    kX86InstIdVpmovmskb_ExtendedIndex = 254,
-    kX86InstIdVpmovsxbd_ExtendedIndex = 222,
-    kX86InstIdVpmovsxbq_ExtendedIndex = 222,
-    kX86InstIdVpmovsxbw_ExtendedIndex = 222,
-    kX86InstIdVpmovsxdq_ExtendedIndex = 222,
-    kX86InstIdVpmovsxwd_ExtendedIndex = 222,
-    kX86InstIdVpmovsxwq_ExtendedIndex = 222,
-    kX86InstIdVpmovzxbd_ExtendedIndex = 222,
-    kX86InstIdVpmovzxbq_ExtendedIndex = 222,
-    kX86InstIdVpmovzxbw_ExtendedIndex = 222,
-    kX86InstIdVpmovzxdq_ExtendedIndex = 222,
-    kX86InstIdVpmovzxwd_ExtendedIndex = 222,
-    kX86InstIdVpmovzxwq_ExtendedIndex = 222,
-    kX86InstIdVpmuldq_ExtendedIndex = 211,
-    kX86InstIdVpmulhrsw_ExtendedIndex = 211,
-    kX86InstIdVpmulhuw_ExtendedIndex = 211,
-    kX86InstIdVpmulhw_ExtendedIndex = 211,
-    kX86InstIdVpmulld_ExtendedIndex = 211,
-    kX86InstIdVpmullw_ExtendedIndex = 211,
-    kX86InstIdVpmuludq_ExtendedIndex = 211,
-    kX86InstIdVpor_ExtendedIndex = 211,
-    kX86InstIdVpperm_ExtendedIndex = 279,
-    kX86InstIdVprotb_ExtendedIndex = 280,
-    kX86InstIdVprotd_ExtendedIndex = 281,
-    kX86InstIdVprotq_ExtendedIndex = 282,
-    kX86InstIdVprotw_ExtendedIndex = 283,
-    kX86InstIdVpsadbw_ExtendedIndex = 211,
-    kX86InstIdVpshab_ExtendedIndex = 284,
-    kX86InstIdVpshad_ExtendedIndex = 284,
-    kX86InstIdVpshaq_ExtendedIndex = 284,
-    kX86InstIdVpshaw_ExtendedIndex = 284,
-    kX86InstIdVpshlb_ExtendedIndex = 284,
-    kX86InstIdVpshld_ExtendedIndex = 284,
-    kX86InstIdVpshlq_ExtendedIndex = 284,
-    kX86InstIdVpshlw_ExtendedIndex = 284,
-    kX86InstIdVpshufb_ExtendedIndex = 211,
-    kX86InstIdVpshufd_ExtendedIndex = 285,
-    kX86InstIdVpshufhw_ExtendedIndex = 285,
-    kX86InstIdVpshuflw_ExtendedIndex = 285,
-    kX86InstIdVpsignb_ExtendedIndex = 211,
-    kX86InstIdVpsignd_ExtendedIndex = 211,
-    kX86InstIdVpsignw_ExtendedIndex = 211,
-    kX86InstIdVpslld_ExtendedIndex = 286,
-    kX86InstIdVpslldq_ExtendedIndex = 287,
-    kX86InstIdVpsllq_ExtendedIndex = 288,
-    kX86InstIdVpsllvd_ExtendedIndex = 211,
-    kX86InstIdVpsllvq_ExtendedIndex = 211,
-    kX86InstIdVpsllw_ExtendedIndex = 289,
-    kX86InstIdVpsrad_ExtendedIndex = 290,
-    kX86InstIdVpsravd_ExtendedIndex = 211,
-    kX86InstIdVpsraw_ExtendedIndex = 291,
-    kX86InstIdVpsrld_ExtendedIndex = 292,
-    kX86InstIdVpsrldq_ExtendedIndex = 287,
-    kX86InstIdVpsrlq_ExtendedIndex = 293,
-    kX86InstIdVpsrlvd_ExtendedIndex = 211,
-    kX86InstIdVpsrlvq_ExtendedIndex = 211,
-    kX86InstIdVpsrlw_ExtendedIndex = 294,
-    kX86InstIdVpsubb_ExtendedIndex = 211,
-    kX86InstIdVpsubd_ExtendedIndex = 211,
-    kX86InstIdVpsubq_ExtendedIndex = 211,
-    kX86InstIdVpsubsb_ExtendedIndex = 211,
-    kX86InstIdVpsubsw_ExtendedIndex = 211,
-    kX86InstIdVpsubusb_ExtendedIndex = 211,
-    kX86InstIdVpsubusw_ExtendedIndex = 211,
-    kX86InstIdVpsubw_ExtendedIndex = 211,
-    kX86InstIdVptest_ExtendedIndex = 295,
-    kX86InstIdVpunpckhbw_ExtendedIndex = 211,
-    kX86InstIdVpunpckhdq_ExtendedIndex = 211,
-    kX86InstIdVpunpckhqdq_ExtendedIndex = 211,
-    kX86InstIdVpunpckhwd_ExtendedIndex = 211,
-    kX86InstIdVpunpcklbw_ExtendedIndex = 211,
-    kX86InstIdVpunpckldq_ExtendedIndex = 211,
-    kX86InstIdVpunpcklqdq_ExtendedIndex = 211,
-    kX86InstIdVpunpcklwd_ExtendedIndex = 211,
-    kX86InstIdVpxor_ExtendedIndex = 211,
-    kX86InstIdVrcpps_ExtendedIndex = 222,
-    kX86InstIdVrcpss_ExtendedIndex = 212,
-    kX86InstIdVroundpd_ExtendedIndex = 285,
-    kX86InstIdVroundps_ExtendedIndex = 285,
-    kX86InstIdVroundsd_ExtendedIndex = 220,
-    kX86InstIdVroundss_ExtendedIndex = 220,
-    kX86InstIdVrsqrtps_ExtendedIndex = 222,
-    kX86InstIdVrsqrtss_ExtendedIndex = 212,
-    kX86InstIdVshufpd_ExtendedIndex = 215,
-    kX86InstIdVshufps_ExtendedIndex = 215,
-    kX86InstIdVsqrtpd_ExtendedIndex = 222,
-    kX86InstIdVsqrtps_ExtendedIndex = 222,
+    kX86InstIdVmulsd_ExtendedIndex = 273,
+    kX86InstIdVmulss_ExtendedIndex = 273,
+    kX86InstIdVorpd_ExtendedIndex = 217,
+    kX86InstIdVorps_ExtendedIndex = 217,
+    kX86InstIdVpabsb_ExtendedIndex = 259,
+    kX86InstIdVpabsd_ExtendedIndex = 259,
+    kX86InstIdVpabsw_ExtendedIndex = 259,
+    kX86InstIdVpackssdw_ExtendedIndex = 213,
+    kX86InstIdVpacksswb_ExtendedIndex = 213,
+    kX86InstIdVpackusdw_ExtendedIndex = 213,
+    kX86InstIdVpackuswb_ExtendedIndex = 213,
+    kX86InstIdVpaddb_ExtendedIndex = 274,
+    kX86InstIdVpaddd_ExtendedIndex = 275,
+    kX86InstIdVpaddq_ExtendedIndex = 275,
+    kX86InstIdVpaddsb_ExtendedIndex = 213,
+    kX86InstIdVpaddsw_ExtendedIndex = 213,
+    kX86InstIdVpaddusb_ExtendedIndex = 213,
+    kX86InstIdVpaddusw_ExtendedIndex = 213,
+    kX86InstIdVpaddw_ExtendedIndex = 274,
+    kX86InstIdVpalignr_ExtendedIndex = 218,
+    kX86InstIdVpand_ExtendedIndex = 213,
+    kX86InstIdVpandn_ExtendedIndex = 213,
+    kX86InstIdVpavgb_ExtendedIndex = 274,
+    kX86InstIdVpavgw_ExtendedIndex = 274,
+    kX86InstIdVpblendd_ExtendedIndex = 218,
+    kX86InstIdVpblendvb_ExtendedIndex = 276,
+    kX86InstIdVpblendw_ExtendedIndex = 218,
+    kX86InstIdVpbroadcastb_ExtendedIndex = 225,
+    kX86InstIdVpbroadcastd_ExtendedIndex = 225,
+    kX86InstIdVpbroadcastq_ExtendedIndex = 225,
+    kX86InstIdVpbroadcastw_ExtendedIndex = 225,
+    kX86InstIdVpclmulqdq_ExtendedIndex = 223,
+    kX86InstIdVpcmov_ExtendedIndex = 277,
+    kX86InstIdVpcmpeqb_ExtendedIndex = 213,
+    kX86InstIdVpcmpeqd_ExtendedIndex = 213,
+    kX86InstIdVpcmpeqq_ExtendedIndex = 213,
+    kX86InstIdVpcmpeqw_ExtendedIndex = 213,
+    kX86InstIdVpcmpestri_ExtendedIndex = 278,
+    kX86InstIdVpcmpestrm_ExtendedIndex = 278,
+    kX86InstIdVpcmpgtb_ExtendedIndex = 213,
+    kX86InstIdVpcmpgtd_ExtendedIndex = 213,
+    kX86InstIdVpcmpgtq_ExtendedIndex = 213,
+    kX86InstIdVpcmpgtw_ExtendedIndex = 213,
+    kX86InstIdVpcmpistri_ExtendedIndex = 278,
+    kX86InstIdVpcmpistrm_ExtendedIndex = 278,
+    kX86InstIdVpcomb_ExtendedIndex = 279,
+    kX86InstIdVpcomd_ExtendedIndex = 279,
+    kX86InstIdVpcomq_ExtendedIndex = 279,
+    kX86InstIdVpcomub_ExtendedIndex = 279,
+    kX86InstIdVpcomud_ExtendedIndex = 279,
+    kX86InstIdVpcomuq_ExtendedIndex = 279,
+    kX86InstIdVpcomuw_ExtendedIndex = 279,
+    kX86InstIdVpcomw_ExtendedIndex = 279,
+    kX86InstIdVpdpbusd_ExtendedIndex = 280,
+    kX86InstIdVpdpbusds_ExtendedIndex = 280,
+    kX86InstIdVpdpwssd_ExtendedIndex = 280,
+    kX86InstIdVpdpwssds_ExtendedIndex = 280,
+    kX86InstIdVperm2f128_ExtendedIndex = 281,
+    kX86InstIdVperm2i128_ExtendedIndex = 281,
+    kX86InstIdVpermd_ExtendedIndex = 282,
+    kX86InstIdVpermil2pd_ExtendedIndex = 283,
+    kX86InstIdVpermil2ps_ExtendedIndex = 283,
+    kX86InstIdVpermilpd_ExtendedIndex = 284,
+    kX86InstIdVpermilps_ExtendedIndex = 285,
+    kX86InstIdVpermpd_ExtendedIndex = 286,
+    kX86InstIdVpermps_ExtendedIndex = 282,
+    kX86InstIdVpermq_ExtendedIndex = 286,
+    kX86InstIdVpextrb_ExtendedIndex = 287,
+    kX86InstIdVpextrd_ExtendedIndex = 237,
+    kX86InstIdVpextrq_ExtendedIndex = 288,
+    kX86InstIdVpextrw_ExtendedIndex = 289,
+    kX86InstIdVpgatherdd_ExtendedIndex = 246,
+    kX86InstIdVpgatherdq_ExtendedIndex = 246,
+    kX86InstIdVpgatherqd_ExtendedIndex = 247,
+    kX86InstIdVpgatherqq_ExtendedIndex = 246,
+    kX86InstIdVphaddbd_ExtendedIndex = 245,
+    kX86InstIdVphaddbq_ExtendedIndex = 245,
+    kX86InstIdVphaddbw_ExtendedIndex = 245,
+    kX86InstIdVphaddd_ExtendedIndex = 213,
+    kX86InstIdVphadddq_ExtendedIndex = 245,
+    kX86InstIdVphaddsw_ExtendedIndex = 213,
+    kX86InstIdVphaddubd_ExtendedIndex = 245,
+    kX86InstIdVphaddubq_ExtendedIndex = 245,
+    kX86InstIdVphaddubw_ExtendedIndex = 245,
+    kX86InstIdVphaddudq_ExtendedIndex = 245,
+    kX86InstIdVphadduwd_ExtendedIndex = 245,
+    kX86InstIdVphadduwq_ExtendedIndex = 245,
+    kX86InstIdVphaddw_ExtendedIndex = 213,
+    kX86InstIdVphaddwd_ExtendedIndex = 245,
+    kX86InstIdVphaddwq_ExtendedIndex = 245,
+    kX86InstIdVphminposuw_ExtendedIndex = 215,
+    kX86InstIdVphsubbw_ExtendedIndex = 245,
+    kX86InstIdVphsubd_ExtendedIndex = 213,
+    kX86InstIdVphsubdq_ExtendedIndex = 245,
+    kX86InstIdVphsubsw_ExtendedIndex = 213,
+    kX86InstIdVphsubw_ExtendedIndex = 213,
+    kX86InstIdVphsubwd_ExtendedIndex = 245,
+    kX86InstIdVpinsrb_ExtendedIndex = 290,
+    kX86InstIdVpinsrd_ExtendedIndex = 291,
+    kX86InstIdVpinsrq_ExtendedIndex = 292,
+    kX86InstIdVpinsrw_ExtendedIndex = 293,
+    kX86InstIdVpmacsdd_ExtendedIndex = 294,
+    kX86InstIdVpmacsdqh_ExtendedIndex = 294,
+    kX86InstIdVpmacsdql_ExtendedIndex = 294,
+    kX86InstIdVpmacssdd_ExtendedIndex = 294,
+    kX86InstIdVpmacssdqh_ExtendedIndex = 294,
+    kX86InstIdVpmacssdql_ExtendedIndex = 294,
+    kX86InstIdVpmacsswd_ExtendedIndex = 294,
+    kX86InstIdVpmacssww_ExtendedIndex = 294,
+    kX86InstIdVpmacswd_ExtendedIndex = 294,
+    kX86InstIdVpmacsww_ExtendedIndex = 294,
+    kX86InstIdVpmadcsswd_ExtendedIndex = 294,
+    kX86InstIdVpmadcswd_ExtendedIndex = 294,
+    kX86InstIdVpmaddubsw_ExtendedIndex = 213,
+    kX86InstIdVpmaddwd_ExtendedIndex = 213,
+    kX86InstIdVpmaskmovd_ExtendedIndex = 295,
+    kX86InstIdVpmaskmovq_ExtendedIndex = 295,
+    kX86InstIdVpmaxsb_ExtendedIndex = 213,
+    kX86InstIdVpmaxsd_ExtendedIndex = 275,
+    kX86InstIdVpmaxsw_ExtendedIndex = 213,
+    kX86InstIdVpmaxub_ExtendedIndex = 213,
+    kX86InstIdVpmaxud_ExtendedIndex = 275,
+    kX86InstIdVpmaxuw_ExtendedIndex = 213,
+    kX86InstIdVpminsb_ExtendedIndex = 213,
+    kX86InstIdVpminsd_ExtendedIndex = 275,
+    kX86InstIdVpminsw_ExtendedIndex = 213,
+    kX86InstIdVpminub_ExtendedIndex = 213,
+    kX86InstIdVpminud_ExtendedIndex = 275,
+    kX86InstIdVpminuw_ExtendedIndex = 213,
+    kX86InstIdVpmovmskb_ExtendedIndex = 267,
+    kX86InstIdVpmovsxbd_ExtendedIndex = 259,
+    kX86InstIdVpmovsxbq_ExtendedIndex = 259,
+    kX86InstIdVpmovsxbw_ExtendedIndex = 259,
+    kX86InstIdVpmovsxdq_ExtendedIndex = 259,
+    kX86InstIdVpmovsxwd_ExtendedIndex = 259,
+    kX86InstIdVpmovsxwq_ExtendedIndex = 259,
+    kX86InstIdVpmovzxbd_ExtendedIndex = 259,
+    kX86InstIdVpmovzxbq_ExtendedIndex = 259,
+    kX86InstIdVpmovzxbw_ExtendedIndex = 259,
+    kX86InstIdVpmovzxdq_ExtendedIndex = 259,
+    kX86InstIdVpmovzxwd_ExtendedIndex = 259,
+    kX86InstIdVpmovzxwq_ExtendedIndex = 259,
+    kX86InstIdVpmuldq_ExtendedIndex = 213,
+    kX86InstIdVpmulhrsw_ExtendedIndex = 213,
+    kX86InstIdVpmulhuw_ExtendedIndex = 213,
+    kX86InstIdVpmulhw_ExtendedIndex = 213,
+    kX86InstIdVpmulld_ExtendedIndex = 275,
+    kX86InstIdVpmullw_ExtendedIndex = 274,
+    kX86InstIdVpmuludq_ExtendedIndex = 275,
+    kX86InstIdVpor_ExtendedIndex = 213,
+    kX86InstIdVpperm_ExtendedIndex = 296,
+    kX86InstIdVprotb_ExtendedIndex = 297,
+    kX86InstIdVprotd_ExtendedIndex = 298,
+    kX86InstIdVprotq_ExtendedIndex = 299,
+    kX86InstIdVprotw_ExtendedIndex = 300,
+    kX86InstIdVpsadbw_ExtendedIndex = 213,
+    kX86InstIdVpshab_ExtendedIndex = 301,
+    kX86InstIdVpshad_ExtendedIndex = 301,
+    kX86InstIdVpshaq_ExtendedIndex = 301,
+    kX86InstIdVpshaw_ExtendedIndex = 301,
+    kX86InstIdVpshlb_ExtendedIndex = 301,
+    kX86InstIdVpshld_ExtendedIndex = 301,
+    kX86InstIdVpshlq_ExtendedIndex = 301,
+    kX86InstIdVpshlw_ExtendedIndex = 301,
+    kX86InstIdVpshufb_ExtendedIndex = 274,
+    kX86InstIdVpshufd_ExtendedIndex = 302,
+    kX86InstIdVpshufhw_ExtendedIndex = 302,
+    kX86InstIdVpshuflw_ExtendedIndex = 302,
+    kX86InstIdVpsignb_ExtendedIndex = 213,
+    kX86InstIdVpsignd_ExtendedIndex = 213,
+    kX86InstIdVpsignw_ExtendedIndex = 213,
+    kX86InstIdVpslld_ExtendedIndex = 303,
+    kX86InstIdVpslldq_ExtendedIndex = 304,
+    kX86InstIdVpsllq_ExtendedIndex = 305,
+    kX86InstIdVpsllvd_ExtendedIndex = 213,
+    kX86InstIdVpsllvq_ExtendedIndex = 213,
+    kX86InstIdVpsllw_ExtendedIndex = 306,
+    kX86InstIdVpsrad_ExtendedIndex = 307,
+    kX86InstIdVpsravd_ExtendedIndex = 213,
+    kX86InstIdVpsraw_ExtendedIndex = 308,
+    kX86InstIdVpsrld_ExtendedIndex = 309,
+    kX86InstIdVpsrldq_ExtendedIndex = 304,
+    kX86InstIdVpsrlq_ExtendedIndex = 310,
+    kX86InstIdVpsrlvd_ExtendedIndex = 213,
+    kX86InstIdVpsrlvq_ExtendedIndex = 213,
+    kX86InstIdVpsrlw_ExtendedIndex = 311,
+    kX86InstIdVpsubb_ExtendedIndex = 274,
+    kX86InstIdVpsubd_ExtendedIndex = 275,
+    kX86InstIdVpsubq_ExtendedIndex = 275,
+    kX86InstIdVpsubsb_ExtendedIndex = 213,
+    kX86InstIdVpsubsw_ExtendedIndex = 213,
+    kX86InstIdVpsubusb_ExtendedIndex = 213,
+    kX86InstIdVpsubusw_ExtendedIndex = 213,
+    kX86InstIdVpsubw_ExtendedIndex = 274,
+    kX86InstIdVptest_ExtendedIndex = 312,
+    kX86InstIdVpunpckhbw_ExtendedIndex = 213,
+    kX86InstIdVpunpckhdq_ExtendedIndex = 213,
+    kX86InstIdVpunpckhqdq_ExtendedIndex = 213,
+    kX86InstIdVpunpckhwd_ExtendedIndex = 213,
+    kX86InstIdVpunpcklbw_ExtendedIndex = 213,
+    kX86InstIdVpunpckldq_ExtendedIndex = 213,
+    kX86InstIdVpunpcklqdq_ExtendedIndex = 213,
+    kX86InstIdVpunpcklwd_ExtendedIndex = 213,
+    kX86InstIdVpxor_ExtendedIndex = 213,
+    kX86InstIdVrcpps_ExtendedIndex = 259,
+    kX86InstIdVrcpss_ExtendedIndex = 214,
+    kX86InstIdVroundpd_ExtendedIndex = 302,
+    kX86InstIdVroundps_ExtendedIndex = 302,
+    kX86InstIdVroundsd_ExtendedIndex = 223,
+    kX86InstIdVroundss_ExtendedIndex = 223,
+    kX86InstIdVrsqrtps_ExtendedIndex = 259,
+    kX86InstIdVrsqrtss_ExtendedIndex = 214,
+    kX86InstIdVshufpd_ExtendedIndex = 218,
+    kX86InstIdVshufps_ExtendedIndex = 218,
+    kX86InstIdVsqrtpd_ExtendedIndex = 226,
+    kX86InstIdVsqrtps_ExtendedIndex = 226,
     kX86InstIdVsqrtsd_ExtendedIndex = 212,
     kX86InstIdVsqrtss_ExtendedIndex = 212,
-    kX86InstIdVstmxcsr_ExtendedIndex = 296,
+    kX86InstIdVstmxcsr_ExtendedIndex = 313,
     kX86InstIdVsubpd_ExtendedIndex = 211,
     kX86InstIdVsubps_ExtendedIndex = 211,
     kX86InstIdVsubsd_ExtendedIndex = 212,
     kX86InstIdVsubss_ExtendedIndex = 212,
-    kX86InstIdVtestpd_ExtendedIndex = 295,
-    kX86InstIdVtestps_ExtendedIndex = 295,
-    kX86InstIdVucomisd_ExtendedIndex = 221,
-    kX86InstIdVucomiss_ExtendedIndex = 221,
-    kX86InstIdVunpckhpd_ExtendedIndex = 211,
-    kX86InstIdVunpckhps_ExtendedIndex = 211,
-    kX86InstIdVunpcklpd_ExtendedIndex = 211,
-    kX86InstIdVunpcklps_ExtendedIndex = 211,
-    kX86InstIdVxorpd_ExtendedIndex = 211,
-    kX86InstIdVxorps_ExtendedIndex = 211,
-    kX86InstIdVzeroall_ExtendedIndex = 297,
-    kX86InstIdVzeroupper_ExtendedIndex = 297,
-    kX86InstIdWrfsbase_ExtendedIndex = 298,
-    kX86InstIdWrgsbase_ExtendedIndex = 298,
-    kX86InstIdXadd_ExtendedIndex = 299,
-    kX86InstIdXchg_ExtendedIndex = 300,
+    kX86InstIdVtestpd_ExtendedIndex = 312,
+    kX86InstIdVtestps_ExtendedIndex = 312,
+    kX86InstIdVucomisd_ExtendedIndex = 224,
+    kX86InstIdVucomiss_ExtendedIndex = 224,
+    kX86InstIdVunpckhpd_ExtendedIndex = 275,
+    kX86InstIdVunpckhps_ExtendedIndex = 275,
+    kX86InstIdVunpcklpd_ExtendedIndex = 275,
+    kX86InstIdVunpcklps_ExtendedIndex = 275,
+    kX86InstIdVxorpd_ExtendedIndex = 217,
+    kX86InstIdVxorps_ExtendedIndex = 217,
+    kX86InstIdVzeroall_ExtendedIndex = 314,
+    kX86InstIdVzeroupper_ExtendedIndex = 314,
+    kX86InstIdWrfsbase_ExtendedIndex = 315,
+    kX86InstIdWrgsbase_ExtendedIndex = 315,
+    kX86InstIdXadd_ExtendedIndex = 316,
+    kX86InstIdXchg_ExtendedIndex = 317,
     kX86InstIdXgetbv_ExtendedIndex = 135,
     kX86InstIdXor_ExtendedIndex = 3,
-    kX86InstIdXorpd_ExtendedIndex = 301,
-    kX86InstIdXorps_ExtendedIndex = 301,
-    kX86InstIdXrstor_ExtendedIndex = 302,
-    kX86InstIdXrstor64_ExtendedIndex = 302,
-    kX86InstIdXsave_ExtendedIndex = 302,
-    kX86InstIdXsave64_ExtendedIndex = 302,
-    kX86InstIdXsaveopt_ExtendedIndex = 302,
-    kX86InstIdXsaveopt64_ExtendedIndex = 302,
+    kX86InstIdXorpd_ExtendedIndex = 318,
+    kX86InstIdXorps_ExtendedIndex = 318,
+    kX86InstIdXrstor_ExtendedIndex = 319,
+    kX86InstIdXrstor64_ExtendedIndex = 319,
+    kX86InstIdXsave_ExtendedIndex = 319,
+    kX86InstIdXsave64_ExtendedIndex = 319,
+    kX86InstIdXsaveopt_ExtendedIndex = 319,
+    kX86InstIdXsaveopt64_ExtendedIndex = 319,
     kX86InstIdXsetbv_ExtendedIndex = 107
 };
 // ----------------------------------------------------------------------------
@@ -2040,7 +2189,7 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Fucomip         , "fucomip"         , Enc(FpuR)            , O_00_X(DFE8,U)      , U                   , F(Fp)                              , EF(WWWWWW__), 0 , 0 , O(Fp)             , U                 , U                 , U                 , U                 ),
   INST(Fucomp          , "fucomp"          , Enc(FpuRDef)         , O_00_X(DDE8,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , O(Fp)             , U                 , U                 , U                 , U                 ),
   INST(Fucompp         , "fucompp"         , Enc(FpuOp)           , O_00_X(DAE9,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
-  INST(Fwait           , "fwait"           , Enc(X86Op)           , O_000000(DB,U,_,_,_), U                   , F(Fp)|F(Volatile)                  , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
+  INST(Fwait           , "fwait"           , Enc(X86Op)           , O_000000(9B,U,_,_,_), U                   , F(Fp)|F(Volatile)                  , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Fxam            , "fxam"            , Enc(FpuOp)           , O_00_X(D9E5,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Fxch            , "fxch"            , Enc(FpuR)            , O_00_X(D9C8,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , O(Fp)             , U                 , U                 , U                 , U                 ),
   INST(Fxrstor         , "fxrstor"         , Enc(X86M)            , O_000F00(AE,1,_,_,_), U                   , F(Fp)                              , EF(________), 0 , 0 , O(Mem)            , U                 , U                 , U                 , U                 ),
@@ -2460,10 +2609,10 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Unpckhps        , "unpckhps"        , Enc(SimdRm)          , O_000F00(15,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Unpcklpd        , "unpcklpd"        , Enc(SimdRm)          , O_660F00(14,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Unpcklps        , "unpcklps"        , Enc(SimdRm)          , O_000F00(14,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vaddpd          , "vaddpd"          , Enc(AvxRvm_OptL)     , O_660F00(58,U,_,I,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vaddps          , "vaddps"          , Enc(AvxRvm_OptL)     , O_000F00(58,U,_,I,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vaddsd          , "vaddsd"          , Enc(AvxRvm)          , O_F20F00(58,U,0,I,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vaddss          , "vaddss"          , Enc(AvxRvm)          , O_F30F00(58,U,0,I,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vaddpd          , "vaddpd"          , Enc(AvxRvm_OptL)     , O_660F00(58,U,_,I,1), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vaddps          , "vaddps"          , Enc(AvxRvm_OptL)     , O_000F00(58,U,_,I,0), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vaddsd          , "vaddsd"          , Enc(AvxRvm)          , O_F20F00(58,U,0,I,1), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vaddss          , "vaddss"          , Enc(AvxRvm)          , O_F30F00(58,U,0,I,0), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vaddsubpd       , "vaddsubpd"       , Enc(AvxRvm_OptL)     , O_660F00(D0,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vaddsubps       , "vaddsubps"       , Enc(AvxRvm_OptL)     , O_F20F00(D0,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vaesdec         , "vaesdec"         , Enc(AvxRvm)          , O_660F38(DE,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
@@ -2472,18 +2621,18 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vaesenclast     , "vaesenclast"     , Enc(AvxRvm)          , O_660F38(DD,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vaesimc         , "vaesimc"         , Enc(AvxRm)           , O_660F38(DB,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vaeskeygenassist, "vaeskeygenassist", Enc(AvxRmi)          , O_660F3A(DF,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
-  INST(Vandnpd         , "vandnpd"         , Enc(AvxRvm_OptL)     , O_660F00(55,U,_,_,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vandnps         , "vandnps"         , Enc(AvxRvm_OptL)     , O_000F00(55,U,_,_,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vandpd          , "vandpd"          , Enc(AvxRvm_OptL)     , O_660F00(54,U,_,_,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vandps          , "vandps"          , Enc(AvxRvm_OptL)     , O_000F00(54,U,_,_,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vandnpd         , "vandnpd"         , Enc(AvxRvm_OptL)     , O_660F00(55,U,_,_,1), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vandnps         , "vandnps"         , Enc(AvxRvm_OptL)     , O_000F00(55,U,_,_,0), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vandpd          , "vandpd"          , Enc(AvxRvm_OptL)     , O_660F00(54,U,_,_,1), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vandps          , "vandps"          , Enc(AvxRvm_OptL)     , O_000F00(54,U,_,_,0), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vblendpd        , "vblendpd"        , Enc(AvxRvmi_OptL)    , O_660F3A(0D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vblendps        , "vblendps"        , Enc(AvxRvmi_OptL)    , O_660F3A(0C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vblendvpd       , "vblendvpd"       , Enc(AvxRvmr_OptL)    , O_660F3A(4B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                 ),
   INST(Vblendvps       , "vblendvps"       , Enc(AvxRvmr_OptL)    , O_660F3A(4A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                 ),
   INST(Vbroadcastf128  , "vbroadcastf128"  , Enc(AvxRm)           , O_660F38(1A,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Mem)            , U                 , U                 , U                 ),
   INST(Vbroadcasti128  , "vbroadcasti128"  , Enc(AvxRm)           , O_660F38(5A,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Mem)            , U                 , U                 , U                 ),
-  INST(Vbroadcastsd    , "vbroadcastsd"    , Enc(AvxRm)           , O_660F38(19,U,L,0,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vbroadcastss    , "vbroadcastss"    , Enc(AvxRm_OptL)      , O_660F38(18,U,_,0,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vbroadcastsd    , "vbroadcastsd"    , Enc(AvxRm)           , O_660F38(19,U,L,0,1), U                   , F(WO)|F(Avx)|A(FVT1)               , EF(________), 0 , 0 , O(Ymm)|O(Zmm)     , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vbroadcastss    , "vbroadcastss"    , Enc(AvxRm_OptL)      , O_660F38(18,U,_,0,0), U                   , F(WO)|F(Avx)|A(FVT1)               , EF(________), 0 , 0 , O(Xyz)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcmppd          , "vcmppd"          , Enc(AvxRvmi_OptL)    , O_660F00(C2,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vcmpps          , "vcmpps"          , Enc(AvxRvmi_OptL)    , O_000F00(C2,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vcmpsd          , "vcmpsd"          , Enc(AvxRvmi)         , O_F20F00(C2,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
@@ -2491,11 +2640,13 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vcomisd         , "vcomisd"         , Enc(AvxRm)           , O_660F00(2F,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcomiss         , "vcomiss"         , Enc(AvxRm)           , O_000F00(2F,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcvtdq2pd       , "vcvtdq2pd"       , Enc(AvxRm_OptL)      , O_F30F00(E6,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vcvtdq2ps       , "vcvtdq2ps"       , Enc(AvxRm_OptL)      , O_000F00(5B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vcvtdq2ps       , "vcvtdq2ps"       , Enc(AvxRm_OptL)      , O_000F00(5B,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vcvtne2ps2bf16  , "vcvtne2ps2bf16"  , Enc(AvxRvm_OptL)     , O_F20F38(72,U,_,0,0), U                   , F(WO)|F(Avx)|F(Evex)|A(FVB)        , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vcvtneps2bf16   , "vcvtneps2bf16"   , Enc(AvxRm_OptL)      , O_F30F38(72,U,_,0,0), U                   , F(WO)|F(Avx)|F(Evex)|A(FVB)        , EF(________), 0 , 0 , O(Xy)             , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vcvtpd2dq       , "vcvtpd2dq"       , Enc(AvxRm)           , O_F20F00(E6,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vcvtpd2ps       , "vcvtpd2ps"       , Enc(AvxRm)           , O_660F00(5A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vcvtph2ps       , "vcvtph2ps"       , Enc(AvxRm_OptL)      , O_660F38(13,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vcvtps2dq       , "vcvtps2dq"       , Enc(AvxRm_OptL)      , O_660F00(5B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vcvtps2dq       , "vcvtps2dq"       , Enc(AvxRm_OptL)      , O_660F00(5B,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vcvtps2pd       , "vcvtps2pd"       , Enc(AvxRm_OptL)      , O_000F00(5A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcvtps2ph       , "vcvtps2ph"       , Enc(AvxMri_OptL)     , O_660F3A(1D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(Xy)             , O(Imm)            , U                 , U                 ),
   INST(Vcvtsd2si       , "vcvtsd2si"       , Enc(AvxRm)           , O_F20F00(2D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(XmmMem)         , U                 , U                 , U                 ),
@@ -2505,30 +2656,31 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vcvtss2sd       , "vcvtss2sd"       , Enc(AvxRvm)          , O_F30F00(5A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vcvtss2si       , "vcvtss2si"       , Enc(AvxRm)           , O_F20F00(2D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcvttpd2dq      , "vcvttpd2dq"      , Enc(AvxRm_OptL)      , O_660F00(E6,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vcvttps2dq      , "vcvttps2dq"      , Enc(AvxRm_OptL)      , O_F30F00(5B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vcvttps2dq      , "vcvttps2dq"      , Enc(AvxRm_OptL)      , O_F30F00(5B,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBS)               , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vcvttsd2si      , "vcvttsd2si"      , Enc(AvxRm)           , O_F20F00(2C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcvttss2si      , "vcvttss2si"      , Enc(AvxRm)           , O_F30F00(2C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vdivpd          , "vdivpd"          , Enc(AvxRvm_OptL)     , O_660F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vdivps          , "vdivps"          , Enc(AvxRvm_OptL)     , O_000F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vdivsd          , "vdivsd"          , Enc(AvxRvm)          , O_F20F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vdivss          , "vdivss"          , Enc(AvxRvm)          , O_F30F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vdivpd          , "vdivpd"          , Enc(AvxRvm_OptL)     , O_660F00(5E,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vdivps          , "vdivps"          , Enc(AvxRvm_OptL)     , O_000F00(5E,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vdivsd          , "vdivsd"          , Enc(AvxRvm)          , O_F20F00(5E,U,_,_,1), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vdivss          , "vdivss"          , Enc(AvxRvm)          , O_F30F00(5E,U,_,_,0), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vdpbf16ps       , "vdpbf16ps"       , Enc(AvxRvm_OptL)     , O_F30F38(52,U,_,0,0), U                   , F(RW)|F(Avx)|F(Evex)|A(FVB)        , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vdppd           , "vdppd"           , Enc(AvxRvmi)         , O_660F3A(41,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
   INST(Vdpps           , "vdpps"           , Enc(AvxRvmi_OptL)    , O_660F3A(40,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vextractf128    , "vextractf128"    , Enc(AvxMri)          , O_660F3A(19,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(Ymm)            , O(Imm)            , U                 , U                 ),
   INST(Vextracti128    , "vextracti128"    , Enc(AvxMri)          , O_660F3A(39,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(Ymm)            , O(Imm)            , U                 , U                 ),
   INST(Vextractps      , "vextractps"      , Enc(AvxMri)          , O_660F3A(17,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(GqdMem)         , O(Xmm)            , O(Imm)            , U                 , U                 ),
-  INST(Vfmadd132pd     , "vfmadd132pd"     , Enc(AvxRvm_OptL)     , O_660F38(98,U,_,W,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vfmadd132ps     , "vfmadd132ps"     , Enc(AvxRvm_OptL)     , O_660F38(98,U,_,_,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vfmadd132sd     , "vfmadd132sd"     , Enc(AvxRvm)          , O_660F38(99,U,_,W,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vfmadd132ss     , "vfmadd132ss"     , Enc(AvxRvm)          , O_660F38(99,U,_,_,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vfmadd213pd     , "vfmadd213pd"     , Enc(AvxRvm_OptL)     , O_660F38(A8,U,_,W,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vfmadd213ps     , "vfmadd213ps"     , Enc(AvxRvm_OptL)     , O_660F38(A8,U,_,_,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vfmadd213sd     , "vfmadd213sd"     , Enc(AvxRvm)          , O_660F38(A9,U,_,W,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vfmadd213ss     , "vfmadd213ss"     , Enc(AvxRvm)          , O_660F38(A9,U,_,_,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vfmadd231pd     , "vfmadd231pd"     , Enc(AvxRvm_OptL)     , O_660F38(B8,U,_,W,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vfmadd231ps     , "vfmadd231ps"     , Enc(AvxRvm_OptL)     , O_660F38(B8,U,_,_,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vfmadd231sd     , "vfmadd231sd"     , Enc(AvxRvm)          , O_660F38(B9,U,_,W,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vfmadd231ss     , "vfmadd231ss"     , Enc(AvxRvm)          , O_660F38(B9,U,_,_,_), U                   , F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vfmadd132pd     , "vfmadd132pd"     , Enc(AvxRvm_OptL)     , O_660F38(98,U,_,W,1), U                   , F(RW)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vfmadd132ps     , "vfmadd132ps"     , Enc(AvxRvm_OptL)     , O_660F38(98,U,_,_,0), U                   , F(RW)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vfmadd132sd     , "vfmadd132sd"     , Enc(AvxRvm)          , O_660F38(99,U,_,W,1), U                   , F(RW)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vfmadd132ss     , "vfmadd132ss"     , Enc(AvxRvm)          , O_660F38(99,U,_,_,0), U                   , F(RW)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vfmadd213pd     , "vfmadd213pd"     , Enc(AvxRvm_OptL)     , O_660F38(A8,U,_,W,1), U                   , F(RW)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vfmadd213ps     , "vfmadd213ps"     , Enc(AvxRvm_OptL)     , O_660F38(A8,U,_,_,0), U                   , F(RW)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vfmadd213sd     , "vfmadd213sd"     , Enc(AvxRvm)          , O_660F38(A9,U,_,W,1), U                   , F(RW)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vfmadd213ss     , "vfmadd213ss"     , Enc(AvxRvm)          , O_660F38(A9,U,_,_,0), U                   , F(RW)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vfmadd231pd     , "vfmadd231pd"     , Enc(AvxRvm_OptL)     , O_660F38(B8,U,_,W,1), U                   , F(RW)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vfmadd231ps     , "vfmadd231ps"     , Enc(AvxRvm_OptL)     , O_660F38(B8,U,_,_,0), U                   , F(RW)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vfmadd231sd     , "vfmadd231sd"     , Enc(AvxRvm)          , O_660F38(B9,U,_,W,1), U                   , F(RW)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vfmadd231ss     , "vfmadd231ss"     , Enc(AvxRvm)          , O_660F38(B9,U,_,_,0), U                   , F(RW)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vfmaddpd        , "vfmaddpd"        , Enc(Fma4_OptL)       , O_660F3A(69,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                 ),
   INST(Vfmaddps        , "vfmaddps"        , Enc(Fma4_OptL)       , O_660F3A(68,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                 ),
   INST(Vfmaddsd        , "vfmaddsd"        , Enc(Fma4)            , O_660F3A(6B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 ),
@@ -2617,16 +2769,16 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vmaskmovdqu     , "vmaskmovdqu"     , Enc(AvxRm)           , O_660F00(F7,U,_,_,_), U                   , F(RO)|F(Avx)|F(Special)            , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , U                 , U                 , U                 ),
   INST(Vmaskmovpd      , "vmaskmovpd"      , Enc(AvxRvmMvr_OptL)  , O_660F38(2D,U,_,_,_), O_660F38(2F,U,_,_,_), F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vmaskmovps      , "vmaskmovps"      , Enc(AvxRvmMvr_OptL)  , O_660F38(2C,U,_,_,_), O_660F38(2E,U,_,_,_), F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmaxpd          , "vmaxpd"          , Enc(AvxRvm_OptL)     , O_660F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmaxps          , "vmaxps"          , Enc(AvxRvm_OptL)     , O_000F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmaxsd          , "vmaxsd"          , Enc(AvxRvm_OptL)     , O_F20F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmaxss          , "vmaxss"          , Enc(AvxRvm_OptL)     , O_F30F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vminpd          , "vminpd"          , Enc(AvxRvm_OptL)     , O_660F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vminps          , "vminps"          , Enc(AvxRvm_OptL)     , O_000F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vminsd          , "vminsd"          , Enc(AvxRvm_OptL)     , O_F20F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vminss          , "vminss"          , Enc(AvxRvm_OptL)     , O_F30F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmovapd         , "vmovapd"         , Enc(AvxRmMr_OptL)    , O_660F00(28,U,_,_,_), O_660F00(29,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vmovaps         , "vmovaps"         , Enc(AvxRmMr_OptL)    , O_000F00(28,U,_,_,_), O_000F00(29,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vmaxpd          , "vmaxpd"          , Enc(AvxRvm_OptL)     , O_660F00(5F,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVBS)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vmaxps          , "vmaxps"          , Enc(AvxRvm_OptL)     , O_000F00(5F,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBS)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vmaxsd          , "vmaxsd"          , Enc(AvxRvm_OptL)     , O_F20F00(5F,U,_,_,1), U                   , F(WO)|F(Avx)|A(FSS)                , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vmaxss          , "vmaxss"          , Enc(AvxRvm_OptL)     , O_F30F00(5F,U,_,_,0), U                   , F(WO)|F(Avx)|A(FSS)                , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vminpd          , "vminpd"          , Enc(AvxRvm_OptL)     , O_660F00(5D,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVBS)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vminps          , "vminps"          , Enc(AvxRvm_OptL)     , O_000F00(5D,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBS)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vminsd          , "vminsd"          , Enc(AvxRvm_OptL)     , O_F20F00(5D,U,_,_,1), U                   , F(WO)|F(Avx)|A(FSS)                , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vminss          , "vminss"          , Enc(AvxRvm_OptL)     , O_F30F00(5D,U,_,_,0), U                   , F(WO)|F(Avx)|A(FSS)                , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vmovapd         , "vmovapd"         , Enc(AvxRmMr_OptL)    , O_660F00(28,U,_,_,1), O_660F00(29,U,_,_,1), F(WO)|F(Avx)|A(FV)                 , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vmovaps         , "vmovaps"         , Enc(AvxRmMr_OptL)    , O_000F00(28,U,_,_,0), O_000F00(29,U,_,_,0), F(WO)|F(Avx)|A(FV)                 , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vmovd           , "vmovd"           , Enc(AvxMovDQ)        , O_660F00(6E,U,_,_,_), O_660F00(7E,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vmovddup        , "vmovddup"        , Enc(AvxRm_OptL)      , O_F20F00(12,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vmovdqa         , "vmovdqa"         , Enc(AvxRmMr_OptL)    , O_660F00(6F,U,_,_,_), O_660F00(7F,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
@@ -2648,15 +2800,15 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vmovshdup       , "vmovshdup"       , Enc(AvxRm_OptL)      , O_F30F00(16,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vmovsldup       , "vmovsldup"       , Enc(AvxRm_OptL)      , O_F30F00(12,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vmovss          , "vmovss"          , Enc(AvxMovSsSd)      , O_F30F00(10,U,_,_,_), O_F30F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(Xmm)            , O(Xmm)            , U                 , U                 ),
-  INST(Vmovupd         , "vmovupd"         , Enc(AvxRmMr_OptL)    , O_660F00(10,U,_,_,_), O_660F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vmovups         , "vmovups"         , Enc(AvxRmMr_OptL)    , O_000F00(10,U,_,_,_), O_000F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vmovupd         , "vmovupd"         , Enc(AvxRmMr_OptL)    , O_660F00(10,U,_,_,1), O_660F00(11,U,_,_,1), F(WO)|F(Avx)|A(FV)                 , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vmovups         , "vmovups"         , Enc(AvxRmMr_OptL)    , O_000F00(10,U,_,_,0), O_000F00(11,U,_,_,0), F(WO)|F(Avx)|A(FV)                 , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vmpsadbw        , "vmpsadbw"        , Enc(AvxRvmi_OptL)    , O_660F3A(42,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
-  INST(Vmulpd          , "vmulpd"          , Enc(AvxRvm_OptL)     , O_660F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmulps          , "vmulps"          , Enc(AvxRvm_OptL)     , O_000F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmulsd          , "vmulsd"          , Enc(AvxRvm_OptL)     , O_F20F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmulss          , "vmulss"          , Enc(AvxRvm_OptL)     , O_F30F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vorpd           , "vorpd"           , Enc(AvxRvm_OptL)     , O_660F00(56,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vorps           , "vorps"           , Enc(AvxRvm_OptL)     , O_000F00(56,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vmulpd          , "vmulpd"          , Enc(AvxRvm_OptL)     , O_660F00(59,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vmulps          , "vmulps"          , Enc(AvxRvm_OptL)     , O_000F00(59,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vmulsd          , "vmulsd"          , Enc(AvxRvm_OptL)     , O_F20F00(59,U,_,_,1), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vmulss          , "vmulss"          , Enc(AvxRvm_OptL)     , O_F30F00(59,U,_,_,0), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vorpd           , "vorpd"           , Enc(AvxRvm_OptL)     , O_660F00(56,U,_,_,1), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vorps           , "vorps"           , Enc(AvxRvm_OptL)     , O_000F00(56,U,_,_,0), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpabsb          , "vpabsb"          , Enc(AvxRm_OptL)      , O_660F38(1C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vpabsd          , "vpabsd"          , Enc(AvxRm_OptL)      , O_660F38(1E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vpabsw          , "vpabsw"          , Enc(AvxRm_OptL)      , O_660F38(1D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
@@ -2664,19 +2816,19 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpacksswb       , "vpacksswb"       , Enc(AvxRvm_OptL)     , O_660F00(63,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpackusdw       , "vpackusdw"       , Enc(AvxRvm_OptL)     , O_660F38(2B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpackuswb       , "vpackuswb"       , Enc(AvxRvm_OptL)     , O_660F00(67,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpaddb          , "vpaddb"          , Enc(AvxRvm_OptL)     , O_660F00(FC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpaddd          , "vpaddd"          , Enc(AvxRvm_OptL)     , O_660F00(FE,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpaddq          , "vpaddq"          , Enc(AvxRvm_OptL)     , O_660F00(D4,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpaddb          , "vpaddb"          , Enc(AvxRvm_OptL)     , O_660F00(FC,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpaddd          , "vpaddd"          , Enc(AvxRvm_OptL)     , O_660F00(FE,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpaddq          , "vpaddq"          , Enc(AvxRvm_OptL)     , O_660F00(D4,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpaddsb         , "vpaddsb"         , Enc(AvxRvm_OptL)     , O_660F00(EC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpaddsw         , "vpaddsw"         , Enc(AvxRvm_OptL)     , O_660F00(ED,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpaddusb        , "vpaddusb"        , Enc(AvxRvm_OptL)     , O_660F00(DC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpaddusw        , "vpaddusw"        , Enc(AvxRvm_OptL)     , O_660F00(DD,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpaddw          , "vpaddw"          , Enc(AvxRvm_OptL)     , O_660F00(FD,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpaddw          , "vpaddw"          , Enc(AvxRvm_OptL)     , O_660F00(FD,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpalignr        , "vpalignr"        , Enc(AvxRvmi_OptL)    , O_660F3A(0F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vpand           , "vpand"           , Enc(AvxRvm_OptL)     , O_660F00(DB,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpandn          , "vpandn"          , Enc(AvxRvm_OptL)     , O_660F00(DF,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpavgb          , "vpavgb"          , Enc(AvxRvm_OptL)     , O_660F00(E0,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpavgw          , "vpavgw"          , Enc(AvxRvm_OptL)     , O_660F00(E3,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpavgb          , "vpavgb"          , Enc(AvxRvm_OptL)     , O_660F00(E0,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpavgw          , "vpavgw"          , Enc(AvxRvm_OptL)     , O_660F00(E3,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpblendd        , "vpblendd"        , Enc(AvxRvmi_OptL)    , O_660F3A(02,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vpblendvb       , "vpblendvb"       , Enc(AvxRvmr)         , O_660F3A(4C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                 ),
   INST(Vpblendw        , "vpblendw"        , Enc(AvxRvmi_OptL)    , O_660F3A(0E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
@@ -2706,6 +2858,10 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpcomuq         , "vpcomuq"         , Enc(XopRvmi)         , O_00_M08(EF,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
   INST(Vpcomuw         , "vpcomuw"         , Enc(XopRvmi)         , O_00_M08(ED,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
   INST(Vpcomw          , "vpcomw"          , Enc(XopRvmi)         , O_00_M08(CD,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
+  INST(Vpdpbusd        , "vpdpbusd"        , Enc(AvxRvm_OptL)     , O_660F38(50,U,_,0,0), U                   , F(RW)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpdpbusds       , "vpdpbusds"       , Enc(AvxRvm_OptL)     , O_660F38(51,U,_,0,0), U                   , F(RW)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpdpwssd        , "vpdpwssd"        , Enc(AvxRvm_OptL)     , O_660F38(52,U,_,0,0), U                   , F(RW)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpdpwssds       , "vpdpwssds"       , Enc(AvxRvm_OptL)     , O_660F38(53,U,_,0,0), U                   , F(RW)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vperm2f128      , "vperm2f128"      , Enc(AvxRvmi)         , O_660F3A(06,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Ymm)            , O(YmmMem)         , O(Imm)            , U                 ),
   INST(Vperm2i128      , "vperm2i128"      , Enc(AvxRvmi)         , O_660F3A(46,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Ymm)            , O(YmmMem)         , O(Imm)            , U                 ),
   INST(Vpermd          , "vpermd"          , Enc(AvxRvm)          , O_660F38(36,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Ymm)            , O(YmmMem)         , U                 , U                 ),
@@ -2767,16 +2923,16 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpmaskmovd      , "vpmaskmovd"      , Enc(AvxRvmMvr_OptL)  , O_660F38(8C,U,_,_,_), O_660F38(8E,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmaskmovq      , "vpmaskmovq"      , Enc(AvxRvmMvr_OptL)  , O_660F38(8C,U,_,W,_), O_660F38(8E,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmaxsb         , "vpmaxsb"         , Enc(AvxRvm_OptL)     , O_660F38(3C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpmaxsd         , "vpmaxsd"         , Enc(AvxRvm_OptL)     , O_660F38(3D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpmaxsd         , "vpmaxsd"         , Enc(AvxRvm_OptL)     , O_660F38(3D,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpmaxsw         , "vpmaxsw"         , Enc(AvxRvm_OptL)     , O_660F00(EE,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmaxub         , "vpmaxub"         , Enc(AvxRvm_OptL)     , O_660F00(DE,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpmaxud         , "vpmaxud"         , Enc(AvxRvm_OptL)     , O_660F38(3F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpmaxud         , "vpmaxud"         , Enc(AvxRvm_OptL)     , O_660F38(3F,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpmaxuw         , "vpmaxuw"         , Enc(AvxRvm_OptL)     , O_660F38(3E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpminsb         , "vpminsb"         , Enc(AvxRvm_OptL)     , O_660F38(38,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpminsd         , "vpminsd"         , Enc(AvxRvm_OptL)     , O_660F38(39,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpminsd         , "vpminsd"         , Enc(AvxRvm_OptL)     , O_660F38(39,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpminsw         , "vpminsw"         , Enc(AvxRvm_OptL)     , O_660F00(EA,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpminub         , "vpminub"         , Enc(AvxRvm_OptL)     , O_660F00(DA,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpminud         , "vpminud"         , Enc(AvxRvm_OptL)     , O_660F38(3B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpminud         , "vpminud"         , Enc(AvxRvm_OptL)     , O_660F38(3B,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpminuw         , "vpminuw"         , Enc(AvxRvm_OptL)     , O_660F38(3A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmovmskb       , "vpmovmskb"       , Enc(AvxRm_OptL)      , O_660F00(D7,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(Xy)             , U                 , U                 , U                 ),
   INST(Vpmovsxbd       , "vpmovsxbd"       , Enc(AvxRm_OptL)      , O_660F38(21,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
@@ -2795,9 +2951,9 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpmulhrsw       , "vpmulhrsw"       , Enc(AvxRvm_OptL)     , O_660F38(0B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmulhuw        , "vpmulhuw"        , Enc(AvxRvm_OptL)     , O_660F00(E4,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmulhw         , "vpmulhw"         , Enc(AvxRvm_OptL)     , O_660F00(E5,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpmulld         , "vpmulld"         , Enc(AvxRvm_OptL)     , O_660F38(40,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpmullw         , "vpmullw"         , Enc(AvxRvm_OptL)     , O_660F00(D5,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpmuludq        , "vpmuludq"        , Enc(AvxRvm_OptL)     , O_660F00(F4,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpmulld         , "vpmulld"         , Enc(AvxRvm_OptL)     , O_660F38(40,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpmullw         , "vpmullw"         , Enc(AvxRvm_OptL)     , O_660F00(D5,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpmuludq        , "vpmuludq"        , Enc(AvxRvm_OptL)     , O_660F00(F4,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpor            , "vpor"            , Enc(AvxRvm_OptL)     , O_660F00(EB,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpperm          , "vpperm"          , Enc(XopRvrmRvmr)     , O_00_M08(A3,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 ),
   INST(Vprotb          , "vprotb"          , Enc(XopRvmRmi)       , O_00_M09(90,U,_,_,_), O_00_M08(C0,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)|O(Imm)  , U                 , U                 ),
@@ -2813,7 +2969,7 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpshld          , "vpshld"          , Enc(XopRvmRmv)       , O_00_M09(96,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 , U                 ),
   INST(Vpshlq          , "vpshlq"          , Enc(XopRvmRmv)       , O_00_M09(97,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 , U                 ),
   INST(Vpshlw          , "vpshlw"          , Enc(XopRvmRmv)       , O_00_M09(95,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 , U                 ),
-  INST(Vpshufb         , "vpshufb"         , Enc(AvxRvm_OptL)     , O_660F38(00,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpshufb         , "vpshufb"         , Enc(AvxRvm_OptL)     , O_660F38(00,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpshufd         , "vpshufd"         , Enc(AvxRmi_OptL)     , O_660F00(70,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
   INST(Vpshufhw        , "vpshufhw"        , Enc(AvxRmi_OptL)     , O_F30F00(70,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
   INST(Vpshuflw        , "vpshuflw"        , Enc(AvxRmi_OptL)     , O_F20F00(70,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
@@ -2835,14 +2991,14 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpsrlvd         , "vpsrlvd"         , Enc(AvxRvm_OptL)     , O_660F38(45,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsrlvq         , "vpsrlvq"         , Enc(AvxRvm_OptL)     , O_660F38(45,U,_,W,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsrlw          , "vpsrlw"          , Enc(AvxRvmVmi_OptL)  , O_660F00(D1,U,_,_,_), O_660F00(71,2,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
-  INST(Vpsubb          , "vpsubb"          , Enc(AvxRvm_OptL)     , O_660F00(F8,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsubd          , "vpsubd"          , Enc(AvxRvm_OptL)     , O_660F00(FA,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsubq          , "vpsubq"          , Enc(AvxRvm_OptL)     , O_660F00(FB,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpsubb          , "vpsubb"          , Enc(AvxRvm_OptL)     , O_660F00(F8,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpsubd          , "vpsubd"          , Enc(AvxRvm_OptL)     , O_660F00(FA,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpsubq          , "vpsubq"          , Enc(AvxRvm_OptL)     , O_660F00(FB,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpsubsb         , "vpsubsb"         , Enc(AvxRvm_OptL)     , O_660F00(E8,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsubsw         , "vpsubsw"         , Enc(AvxRvm_OptL)     , O_660F00(E9,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsubusb        , "vpsubusb"        , Enc(AvxRvm_OptL)     , O_660F00(D8,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsubusw        , "vpsubusw"        , Enc(AvxRvm_OptL)     , O_660F00(D9,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsubw          , "vpsubw"          , Enc(AvxRvm_OptL)     , O_660F00(F9,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpsubw          , "vpsubw"          , Enc(AvxRvm_OptL)     , O_660F00(F9,U,_,_,I), U                   , F(WO)|F(Avx)|A(BWV)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vptest          , "vptest"          , Enc(AvxRm_OptL)      , O_660F38(17,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vpunpckhbw      , "vpunpckhbw"      , Enc(AvxRvm_OptL)     , O_660F00(68,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpunpckhdq      , "vpunpckhdq"      , Enc(AvxRvm_OptL)     , O_660F00(6A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
@@ -2863,25 +3019,25 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vrsqrtss        , "vrsqrtss"        , Enc(AvxRvm)          , O_F30F00(52,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vshufpd         , "vshufpd"         , Enc(AvxRvmi_OptL)    , O_660F00(C6,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vshufps         , "vshufps"         , Enc(AvxRvmi_OptL)    , O_000F00(C6,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
-  INST(Vsqrtpd         , "vsqrtpd"         , Enc(AvxRm_OptL)      , O_660F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vsqrtps         , "vsqrtps"         , Enc(AvxRm_OptL)      , O_000F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vsqrtsd         , "vsqrtsd"         , Enc(AvxRvm)          , O_F20F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vsqrtss         , "vsqrtss"         , Enc(AvxRvm)          , O_F30F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vsqrtpd         , "vsqrtpd"         , Enc(AvxRm_OptL)      , O_660F00(51,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vsqrtps         , "vsqrtps"         , Enc(AvxRm_OptL)      , O_000F00(51,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vsqrtsd         , "vsqrtsd"         , Enc(AvxRvm)          , O_F20F00(51,U,_,_,1), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vsqrtss         , "vsqrtss"         , Enc(AvxRvm)          , O_F30F00(51,U,_,_,0), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vstmxcsr        , "vstmxcsr"        , Enc(AvxM)            , O_000F00(AE,3,_,_,_), U                   , F(Volatile)|F(Avx)                 , EF(________), 0 , 0 , O(Mem)            , U                 , U                 , U                 , U                 ),
-  INST(Vsubpd          , "vsubpd"          , Enc(AvxRvm_OptL)     , O_660F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vsubps          , "vsubps"          , Enc(AvxRvm_OptL)     , O_000F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vsubsd          , "vsubsd"          , Enc(AvxRvm)          , O_F20F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
-  INST(Vsubss          , "vsubss"          , Enc(AvxRvm)          , O_F30F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vsubpd          , "vsubpd"          , Enc(AvxRvm_OptL)     , O_660F00(5C,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vsubps          , "vsubps"          , Enc(AvxRvm_OptL)     , O_000F00(5C,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVBR)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vsubsd          , "vsubsd"          , Enc(AvxRvm)          , O_F20F00(5C,U,_,_,1), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
+  INST(Vsubss          , "vsubss"          , Enc(AvxRvm)          , O_F30F00(5C,U,_,_,0), U                   , F(WO)|F(Avx)|A(FSR)                , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vtestpd         , "vtestpd"         , Enc(AvxRm_OptL)      , O_660F38(0F,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vtestps         , "vtestps"         , Enc(AvxRm_OptL)      , O_660F38(0E,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vucomisd        , "vucomisd"        , Enc(AvxRm)           , O_660F00(2E,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vucomiss        , "vucomiss"        , Enc(AvxRm)           , O_000F00(2E,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vunpckhpd       , "vunpckhpd"       , Enc(AvxRvm_OptL)     , O_660F00(15,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vunpckhps       , "vunpckhps"       , Enc(AvxRvm_OptL)     , O_000F00(15,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vunpcklpd       , "vunpcklpd"       , Enc(AvxRvm_OptL)     , O_660F00(14,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vunpcklps       , "vunpcklps"       , Enc(AvxRvm_OptL)     , O_000F00(14,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vxorpd          , "vxorpd"          , Enc(AvxRvm_OptL)     , O_660F00(57,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vxorps          , "vxorps"          , Enc(AvxRvm_OptL)     , O_000F00(57,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vunpckhpd       , "vunpckhpd"       , Enc(AvxRvm_OptL)     , O_660F00(15,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vunpckhps       , "vunpckhps"       , Enc(AvxRvm_OptL)     , O_000F00(15,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vunpcklpd       , "vunpcklpd"       , Enc(AvxRvm_OptL)     , O_660F00(14,U,_,_,1), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vunpcklps       , "vunpcklps"       , Enc(AvxRvm_OptL)     , O_000F00(14,U,_,_,0), U                   , F(WO)|F(Avx)|A(FVB)                , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vxorpd          , "vxorpd"          , Enc(AvxRvm_OptL)     , O_660F00(57,U,_,_,1), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vxorps          , "vxorps"          , Enc(AvxRvm_OptL)     , O_000F00(57,U,_,_,0), U                   , F(WO)|F(Avx)|A(DQVB)               , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vzeroall        , "vzeroall"        , Enc(AvxOp)           , O_000F00(77,U,L,_,_), U                   , F(Volatile)|F(Avx)                 , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Vzeroupper      , "vzeroupper"      , Enc(AvxOp)           , O_000F00(77,U,_,_,_), U                   , F(Volatile)|F(Avx)                 , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Wrfsbase        , "wrfsbase"        , Enc(X86Rm)           , O_F30F00(AE,2,_,_,_), U                   , F(RO)|F(Volatile)                  , EF(________), 0 , 0 , O(Gqd)            , U                 , U                 , U                 , U                 ),
@@ -2984,6 +3140,16 @@ static ASMJIT_INLINE int X86Util_cmpInstName(const char* a, const char* b, size_
   return static_cast<int>(a[len]);
 }
 
+//! \internal
+//!
+//! Hash an instruction name, must match `hashName()` in "tools/src-gendefs.js".
+static ASMJIT_INLINE uint32_t X86Util_hashInstName(const char* name, size_t len) noexcept {
+  uint32_t hash = static_cast<uint32_t>(kX86InstHashSeed) ^ 0x811C9DC5U;
+  for (size_t i = 0; i < len; i++)
+    hash = (hash ^ static_cast<uint8_t>(name[i])) * 0x01000193U;
+  return hash;
+}
+
 uint32_t X86Util::getInstIdByName(const char* name, size_t len) noexcept {
   if (name == nullptr)
     return kInstIdNone;
@@ -2994,54 +3160,14 @@ uint32_t X86Util::getInstIdByName(const char* name, size_t len) noexcept {
   if (len == 0)
     return kInstIdNone;
 
-  uint32_t prefix = name[0] - kX86InstAlphaIndexFirst;
-  if (prefix > kX86InstAlphaIndexLast - kX86InstAlphaIndexFirst)
-    return kInstIdNone;
-
-  uint32_t index = _x86InstAlphaIndex[prefix];
-  if (index == kX86InstAlphaIndexInvalid)
-    return kInstIdNone;
+  // The perfect hash maps every instruction name to a unique slot, so it's
+  // only needed to check whether `name` matches the instruction in the slot.
+  uint32_t hash = X86Util_hashInstName(name, len);
+  uint32_t disp = _x86InstHashDisp[hash >> kX86InstHashBucketShift];
+  uint32_t id = _x86InstHashTable[(hash ^ disp) & (kX86InstHashSize - 1)];
 
-  const uint16_t* base = _x86InstNameIndex + index;
-  const uint16_t* end = _x86InstNameIndex + _kX86InstIdCount;
-
-  // Handle instructions starting with 'j' specially. `jcc` instruction breaks
-  // the sorting, because of the suffixes (it's considered as one instruction),
-  // so basically `jecxz` and `jmp` are stored after all `jcc` instructions.
-  bool linearSearch = prefix == ('j' - kX86InstAlphaIndexFirst);
-
-  while (++prefix <= kX86InstAlphaIndexLast - kX86InstAlphaIndexFirst) {
-    index = _x86InstAlphaIndex[prefix];
-    if (index == kX86InstAlphaIndexInvalid)
-      continue;
-    end = _x86InstNameIndex + index;
-    break;
-  }
-
-  if (linearSearch) {
-    while (base != end) {
-      if (X86Util_cmpInstName(_x86InstNameData + base[0], name, len) == 0)
-        return static_cast<uint32_t>((size_t)(base - _x86InstNameIndex));
-      base++;
-    }
-  }
-  else {
-    for (size_t lim = (size_t)(end - base); lim != 0; lim >>= 1) {
-      const uint16_t* cur = base + (lim >> 1);
-      int result = X86Util_cmpInstName(_x86InstNameData + cur[0], name, len);
-
-      if (result < 0) {
-        base = cur + 1;
-        lim--;
-        continue;
-      }
-
-      if (result > 0)
-        continue;
-
-      return static_cast<uint32_t>((size_t)(cur - _x86InstNameIndex));
-    }
-  }
+  if (X86Util_cmpInstName(_x86InstNameData + _x86InstNameIndex[id], name, len) == 0)
+    return id;
 
   return kInstIdNone;
 }
@@ -3082,6 +3208,15 @@ UNIT(x86_inst_name) {
 
   EXPECT(X86Util::getInstIdByName("123xyz") == kInstIdNone,
     "Should return kInstIdNone for unknown instruction.");
+
+  EXPECT(X86Util::getInstIdByName("movx") == kInstIdNone,
+    "Should return kInstIdNone for an instruction name followed by garbage.");
+
+  EXPECT(X86Util::getInstIdByName("MOV") == kInstIdNone,
+    "Should return kInstIdNone for an upper-case instruction name.");
+
+  EXPECT(X86Util::getInstIdByName("movsxd", 3) == kX86InstIdMov,
+    "Should only use the first `len` characters of the instruction name.");
 }
 #endif // ASMJIT_TEST && !ASMJIT_DISABLE_TEXT
 
@@ -758,6 +758,8 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVcomiss,                     // AVX
   kX86InstIdVcvtdq2pd,                   // AVX
   kX86InstIdVcvtdq2ps,                   // AVX
+  kX86InstIdVcvtne2ps2bf16,              // AVX512_BF16
+  kX86InstIdVcvtneps2bf16,               // AVX512_BF16
   kX86InstIdVcvtpd2dq,                   // AVX
   kX86InstIdVcvtpd2ps,                   // AVX
   kX86InstIdVcvtph2ps,                   // F16C
@@ -778,6 +780,7 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVdivps,                      // AVX
   kX86InstIdVdivsd,                      // AVX
   kX86InstIdVdivss,                      // AVX
+  kX86InstIdVdpbf16ps,                   // AVX512_BF16
   kX86InstIdVdppd,                       // AVX
   kX86InstIdVdpps,                       // AVX
   kX86InstIdVextractf128,                // AVX
@@ -972,6 +975,10 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpcomuq,                     // XOP
   kX86InstIdVpcomuw,                     // XOP
   kX86InstIdVpcomw,                      // XOP
+  kX86InstIdVpdpbusd,                    // AVX_VNNI/AVX512_VNNI
+  kX86InstIdVpdpbusds,                   // AVX_VNNI/AVX512_VNNI
+  kX86InstIdVpdpwssd,                    // AVX_VNNI/AVX512_VNNI
+  kX86InstIdVpdpwssds,                   // AVX_VNNI/AVX512_VNNI
   kX86InstIdVperm2f128,                  // AVX
   kX86InstIdVperm2i128,                  // AVX2
   kX86InstIdVpermd,                      // AVX2
@@ -1186,6 +1193,8 @@ ASMJIT_ENUM(X86InstOptions) {
   _kX86InstOptionNoRex    = 0x00000080,  //!< Do not use, internal of `X86Assembler`.
   kX86InstOptionLock      = 0x00000100,  //!< Force LOCK prefix (lock-enabled instructions).
   kX86InstOptionVex3      = 0x00000200,  //!< Force 3-byte VEX prefix (AVX)
+  kX86InstOptionRex2      = 0x00000400,  //!< Force REX2 prefix (X64 & APX).
+  kX86InstOptionNf        = 0x00000800,  //!< Do not update flags, EVEX encoded (X64 & APX).
   kX86InstOptionEvex      = 0x00010000,  //!< Force 4-byte EVEX prefix (AVX-512).
   kX86InstOptionEvexZero  = 0x00020000,  //!< EVEX use zeroing instead of merging.
   kX86InstOptionEvexOneN  = 0x00040000,  //!< EVEX broadcast the first element to all.
@@ -1193,7 +1202,10 @@ ASMJIT_ENUM(X86InstOptions) {
   kX86InstOptionEvexRnSae = 0x00100000,  //!< EVEX 'round-to-nearest' (even) and `SAE`.
   kX86InstOptionEvexRdSae = 0x00200000,  //!< EVEX 'round-down' (toward -inf) and 'SAE'.
   kX86InstOptionEvexRuSae = 0x00400000,  //!< EVEX 'round-up' (toward +inf) and 'SAE'.
-  kX86InstOptionEvexRzSae = 0x00800000   //!< EVEX 'round-toward-zero' (truncate) and 'SAE'.
+  kX86InstOptionEvexRzSae = 0x00800000,  //!< EVEX 'round-toward-zero' (truncate) and 'SAE'.
+
+  kX86InstOptionEvexK_Shift = 24,        //!< EVEX opmask register index shift.
+  kX86InstOptionEvexK_Mask = 0x07000000  //!< EVEX opmask register {k1..k7}, zero if not masked.
 };
 
 // ============================================================================
@@ -1480,6 +1492,8 @@ ASMJIT_ENUM(X86InstFlags) {
 
   kX86InstFlagZeroIfMem   = 0x00001000,  //!< Cleans the rest of destination if source is memory (movss, movsd).
   kX86InstFlagVolatile    = 0x00002000,  //!< Hint for instruction scheduler to not reorder this instruction.
+  kX86InstFlagAvx512T1S   = 0x00004000,  //!< EVEX disp8*N is scaled by the element size (Tuple1 Scalar).
+  kX86InstFlagEvex        = 0x00008000,  //!< Instruction has no VEX form, always encoded by EVEX prefix.
 
   kX86InstFlagAvx         = 0x00010000,  //!< AVX/AVX2 instruction.
   kX86InstFlagXop         = 0x00020000,  //!< XOP instruction.
@@ -1863,6 +1877,13 @@ struct X86InstExtendedInfo {
     return hasFlag(kX86InstFlagSpecialMem);
   }
 
+  //! Get whether the instruction has an AVX-512 form (EVEX encodable).
+  ASMJIT_INLINE bool isAvx512() const noexcept {
+    return hasFlag(kX86InstFlagAvx512F  | kX86InstFlagAvx512CD |
+                   kX86InstFlagAvx512PF | kX86InstFlagAvx512ER |
+                   kX86InstFlagAvx512DQ | kX86InstFlagAvx512BW);
+  }
+
   //! Get whether the move instruction zeroes the rest of the register
   //! if the source is memory operand.
   //!
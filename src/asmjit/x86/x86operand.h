@@ -2129,12 +2129,12 @@ ASMJIT_INLINE X86ZmmVar X86YmmVar::zmm() const noexcept { return X86ZmmVar(*this
 // ============================================================================
 
 struct X86RegData {
-  X86GpReg gpd[16];
-  X86GpReg gpq[16];
+  X86GpReg gpd[32];
+  X86GpReg gpq[32];
 
-  X86GpReg gpbLo[16];
+  X86GpReg gpbLo[32];
   X86GpReg gpbHi[4];
-  X86GpReg gpw[16];
+  X86GpReg gpw[32];
 
   X86XmmReg xmm[32];
   X86YmmReg ymm[32];
@@ -2183,6 +2183,22 @@ ASMJIT_DEF_REG(X86GpReg , r12d , gpd[12])  //!< 32-bit GPD register (X64).
 ASMJIT_DEF_REG(X86GpReg , r13d , gpd[13])  //!< 32-bit GPD register (X64).
 ASMJIT_DEF_REG(X86GpReg , r14d , gpd[14])  //!< 32-bit GPD register (X64).
 ASMJIT_DEF_REG(X86GpReg , r15d , gpd[15])  //!< 32-bit GPD register (X64).
+ASMJIT_DEF_REG(X86GpReg , r16d , gpd[16])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r17d , gpd[17])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r18d , gpd[18])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r19d , gpd[19])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r20d , gpd[20])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r21d , gpd[21])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r22d , gpd[22])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r23d , gpd[23])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r24d , gpd[24])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r25d , gpd[25])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r26d , gpd[26])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r27d , gpd[27])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r28d , gpd[28])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r29d , gpd[29])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r30d , gpd[30])  //!< 32-bit GPD register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r31d , gpd[31])  //!< 32-bit GPD register (X64 & APX).
 
 ASMJIT_DEF_REG(X86GpReg , rax  , gpq[0])   //!< 64-bit GPQ register (X64).
 ASMJIT_DEF_REG(X86GpReg , rcx  , gpq[1])   //!< 64-bit GPQ register (X64).
@@ -2200,6 +2216,22 @@ ASMJIT_DEF_REG(X86GpReg , r12  , gpq[12])  //!< 64-bit GPQ register (X64).
 ASMJIT_DEF_REG(X86GpReg , r13  , gpq[13])  //!< 64-bit GPQ register (X64).
 ASMJIT_DEF_REG(X86GpReg , r14  , gpq[14])  //!< 64-bit GPQ register (X64).
 ASMJIT_DEF_REG(X86GpReg , r15  , gpq[15])  //!< 64-bit GPQ register (X64).
+ASMJIT_DEF_REG(X86GpReg , r16  , gpq[16])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r17  , gpq[17])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r18  , gpq[18])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r19  , gpq[19])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r20  , gpq[20])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r21  , gpq[21])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r22  , gpq[22])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r23  , gpq[23])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r24  , gpq[24])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r25  , gpq[25])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r26  , gpq[26])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r27  , gpq[27])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r28  , gpq[28])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r29  , gpq[29])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r30  , gpq[30])  //!< 64-bit GPQ register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r31  , gpq[31])  //!< 64-bit GPQ register (X64 & APX).
 
 ASMJIT_DEF_REG(X86GpReg , al   , gpbLo[0]) //!< 8-bit low GPB register.
 ASMJIT_DEF_REG(X86GpReg , cl   , gpbLo[1]) //!< 8-bit low GPB register.
@@ -2217,6 +2249,22 @@ ASMJIT_DEF_REG(X86GpReg , r12b , gpbLo[12])//!< 8-bit low GPB register (X64).
 ASMJIT_DEF_REG(X86GpReg , r13b , gpbLo[13])//!< 8-bit low GPB register (X64).
 ASMJIT_DEF_REG(X86GpReg , r14b , gpbLo[14])//!< 8-bit low GPB register (X64).
 ASMJIT_DEF_REG(X86GpReg , r15b , gpbLo[15])//!< 8-bit low GPB register (X64).
+ASMJIT_DEF_REG(X86GpReg , r16b , gpbLo[16])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r17b , gpbLo[17])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r18b , gpbLo[18])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r19b , gpbLo[19])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r20b , gpbLo[20])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r21b , gpbLo[21])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r22b , gpbLo[22])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r23b , gpbLo[23])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r24b , gpbLo[24])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r25b , gpbLo[25])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r26b , gpbLo[26])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r27b , gpbLo[27])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r28b , gpbLo[28])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r29b , gpbLo[29])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r30b , gpbLo[30])//!< 8-bit low GPB register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r31b , gpbLo[31])//!< 8-bit low GPB register (X64 & APX).
 
 ASMJIT_DEF_REG(X86GpReg , ah   , gpbHi[0]) //!< 8-bit high GPB register.
 ASMJIT_DEF_REG(X86GpReg , ch   , gpbHi[1]) //!< 8-bit high GPB register.
@@ -2239,6 +2287,22 @@ ASMJIT_DEF_REG(X86GpReg , r12w , gpw[12])  //!< 16-bit GPW register (X64).
 ASMJIT_DEF_REG(X86GpReg , r13w , gpw[13])  //!< 16-bit GPW register (X64).
 ASMJIT_DEF_REG(X86GpReg , r14w , gpw[14])  //!< 16-bit GPW register (X64).
 ASMJIT_DEF_REG(X86GpReg , r15w , gpw[15])  //!< 16-bit GPW register (X64).
+ASMJIT_DEF_REG(X86GpReg , r16w , gpw[16])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r17w , gpw[17])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r18w , gpw[18])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r19w , gpw[19])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r20w , gpw[20])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r21w , gpw[21])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r22w , gpw[22])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r23w , gpw[23])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r24w , gpw[24])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r25w , gpw[25])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r26w , gpw[26])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r27w , gpw[27])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r28w , gpw[28])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r29w , gpw[29])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r30w , gpw[30])  //!< 16-bit GPW register (X64 & APX).
+ASMJIT_DEF_REG(X86GpReg , r31w , gpw[31])  //!< 16-bit GPW register (X64 & APX).
 
 ASMJIT_DEF_REG(X86XmmReg, xmm0 , xmm[0])   //!< 128-bit XMM register.
 ASMJIT_DEF_REG(X86XmmReg, xmm1 , xmm[1])   //!< 128-bit XMM register.
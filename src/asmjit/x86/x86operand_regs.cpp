@@ -43,11 +43,11 @@ namespace asmjit {
   REG_LIST_16(type, start + 16, size)
 
 const X86RegData x86RegData = {
-  { REG_LIST_16(kX86RegTypeGpd  , 0,  4) },
-  { REG_LIST_16(kX86RegTypeGpq  , 0,  8) },
-  { REG_LIST_16(kX86RegTypeGpbLo, 0,  1) },
+  { REG_LIST_32(kX86RegTypeGpd  , 0,  4) },
+  { REG_LIST_32(kX86RegTypeGpq  , 0,  8) },
+  { REG_LIST_32(kX86RegTypeGpbLo, 0,  1) },
   { REG_LIST_04(kX86RegTypeGpbHi, 0,  1) },
-  { REG_LIST_16(kX86RegTypeGpw  , 0,  2) },
+  { REG_LIST_32(kX86RegTypeGpw  , 0,  2) },
   { REG_LIST_32(kX86RegTypeXmm  , 0, 16) },
   { REG_LIST_32(kX86RegTypeYmm  , 0, 32) },
   { REG_LIST_32(kX86RegTypeZmm  , 0, 64) },
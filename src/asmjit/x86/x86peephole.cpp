@@ -0,0 +1,384 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Export]
+#define ASMJIT_EXPORTS
+
+// [Guard]
+#include "../build.h"
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+
+// [Dependencies]
+#include "../x86/x86inst.h"
+#include "../x86/x86operand.h"
+#include "../x86/x86peephole.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+// ============================================================================
+// [asmjit::X86Peephole - Construction / Destruction]
+// ============================================================================
+
+X86Peephole::X86Peephole(X86Assembler* assembler) noexcept
+  : ExternalTool(),
+    _count(0),
+    _rules(kRuleAll),
+    _instOptions(0),
+    _removedCount(0) {
+
+  if (assembler != nullptr)
+    attach(assembler);
+}
+
+X86Peephole::~X86Peephole() noexcept {
+  reset(true);
+}
+
+// ============================================================================
+// [asmjit::X86Peephole - Attach / Reset]
+// ============================================================================
+
+Error X86Peephole::attach(Assembler* assembler) noexcept {
+  ASMJIT_ASSERT(assembler != nullptr);
+
+  if (_assembler != nullptr)
+    return kErrorInvalidState;
+
+  uint32_t arch = assembler->getArch();
+  if (arch != kArchX86 && arch != kArchX64)
+    return kErrorInvalidArch;
+
+  assembler->_attached(this);
+
+  _arch = static_cast<uint8_t>(arch);
+  _regSize = static_cast<uint8_t>(assembler->getRegSize());
+  _finalized = false;
+  _lastError = kErrorOk;
+
+  return kErrorOk;
+}
+
+void X86Peephole::reset(bool releaseMemory) noexcept {
+  // The window is stored inline, there is no memory to release.
+  ASMJIT_UNUSED(releaseMemory);
+
+  Assembler* assembler = getAssembler();
+  if (assembler != nullptr)
+    assembler->_detached(this);
+
+  _arch = kArchNone;
+  _regSize = 0;
+  _finalized = false;
+  _lastError = kErrorNotInitialized;
+
+  _count = 0;
+  _rules = kRuleAll;
+  _instOptions = 0;
+  _removedCount = 0;
+}
+
+// ============================================================================
+// [asmjit::X86Peephole - Finalize]
+// ============================================================================
+
+Error X86Peephole::finalize() noexcept {
+  if (_assembler == nullptr)
+    return kErrorOk;
+
+  Error error = flush();
+
+  Assembler* assembler = getAssembler();
+  assembler->_detached(this);
+
+  _arch = kArchNone;
+  _regSize = 0;
+  _finalized = true;
+
+  return error;
+}
+
+Error X86Peephole::flush() noexcept {
+  if (_assembler == nullptr)
+    return kErrorNotInitialized;
+
+  uint32_t count = _count;
+  _count = 0;
+
+  if (count == 0)
+    return kErrorOk;
+
+  return _assembler->emitBatch(_window, count);
+}
+
+// ============================================================================
+// [asmjit::X86Peephole - Helpers]
+// ============================================================================
+
+//! \internal
+//!
+//! Get whether `a` and `b` are the same GP register (type and index).
+static ASMJIT_INLINE bool X86Peephole_isSameGp(const Operand& a, const Operand& b) noexcept {
+  return a.isReg() && b.isReg() &&
+         static_cast<const X86Reg&>(a).isGp() &&
+         a._vreg.type == b._vreg.type &&
+         a._vreg.index == b._vreg.index;
+}
+
+//! \internal
+//!
+//! Get whether `op` reads a GP register of the given `index`.
+static ASMJIT_INLINE bool X86Peephole_readsGp(const Operand& op, uint32_t index) noexcept {
+  if (op.isReg())
+    return static_cast<const X86Reg&>(op).isGp() && op._vreg.index == index;
+
+  if (op.isMem()) {
+    const X86Mem& m = static_cast<const X86Mem&>(op);
+    if (!m.isBaseIndexType())
+      return false;
+    return m.getBase() == index || (m.getVSib() == kX86MemVSibGpz && m.getIndex() == index);
+  }
+
+  return false;
+}
+
+//! \internal
+//!
+//! Get whether `record` is a two operand instruction without options.
+static ASMJIT_INLINE bool X86Peephole_isPlain(const InstRecord& record, uint32_t instId) noexcept {
+  return record.instId == instId && record.options == 0 && record.o2.isNone();
+}
+
+//! \internal
+//!
+//! Get whether `record` is a `jmp` or `jcc` to the label `labelId`.
+static ASMJIT_INLINE bool X86Peephole_isJumpTo(const InstRecord& record, uint32_t labelId) noexcept {
+  if (record.instId >= _kX86InstIdCount || !record.o0.isLabel() || record.o0.getId() != labelId)
+    return false;
+
+  uint32_t encoding = X86Util::getInstInfo(record.instId).getEncoding();
+  return encoding == kX86InstEncodingX86Jmp || encoding == kX86InstEncodingX86Jcc;
+}
+
+// ============================================================================
+// [asmjit::X86Peephole - Label]
+// ============================================================================
+
+Error X86Peephole::bind(const Label& label) noexcept {
+  if (_assembler == nullptr)
+    return kErrorNotInitialized;
+
+  if (_rules & kRuleJmpNext) {
+    while (_count != 0 && X86Peephole_isJumpTo(_window[_count - 1], label.getId())) {
+      _count--;
+      _removedCount++;
+    }
+  }
+
+  ASMJIT_PROPAGATE_ERROR(flush());
+  return _assembler->bind(label);
+}
+
+// ============================================================================
+// [asmjit::X86Peephole - Align / Embed]
+// ============================================================================
+
+Error X86Peephole::align(uint32_t alignMode, uint32_t offset) noexcept {
+  if (_assembler == nullptr)
+    return kErrorNotInitialized;
+
+  ASMJIT_PROPAGATE_ERROR(flush());
+  return _assembler->align(alignMode, offset);
+}
+
+Error X86Peephole::embed(const void* data, uint32_t size) noexcept {
+  if (_assembler == nullptr)
+    return kErrorNotInitialized;
+
+  ASMJIT_PROPAGATE_ERROR(flush());
+  return _assembler->embed(data, size);
+}
+
+// ============================================================================
+// [asmjit::X86Peephole - Emit]
+// ============================================================================
+
+Error X86Peephole::_emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3) noexcept {
+  if (_assembler == nullptr)
+    return kErrorNotInitialized;
+
+  InstRecord cur(code, o0, o1, o2, o3, _instOptions);
+  _instOptions = 0;
+
+  uint32_t rules = _rules;
+  bool isX64 = _arch == kArchX64;
+
+  // mov r32, r32 clears the upper half of the register in 64-bit mode.
+  bool isMov = X86Peephole_isPlain(cur, kX86InstIdMov) &&
+               o0.isReg() && static_cast<const X86Reg&>(o0).isGp() &&
+               !(isX64 && o0.isRegType(kX86RegTypeGpd));
+
+  if ((rules & kRuleMovSelf) && isMov && X86Peephole_isSameGp(o0, o1)) {
+    _removedCount++;
+    return kErrorOk;
+  }
+
+  while (_count != 0) {
+    const InstRecord& prev = _window[_count - 1];
+
+    // mov a, b
+    // mov b, a <- Removed.
+    if ((rules & kRuleMovBack) && isMov &&
+        X86Peephole_isPlain(prev, kX86InstIdMov) &&
+        X86Peephole_isSameGp(prev.o0, o1) &&
+        X86Peephole_isSameGp(prev.o1, o0)) {
+      _removedCount++;
+      return kErrorOk;
+    }
+
+    // and/or/xor r, x
+    // test r, r <- Removed.
+    if ((rules & kRuleTestAfterLogic) &&
+        X86Peephole_isPlain(cur, kX86InstIdTest) &&
+        X86Peephole_isSameGp(o0, o1) &&
+        (X86Peephole_isPlain(prev, kX86InstIdAnd) ||
+         X86Peephole_isPlain(prev, kX86InstIdOr ) ||
+         X86Peephole_isPlain(prev, kX86InstIdXor)) &&
+        X86Peephole_isSameGp(prev.o0, o0)) {
+      _removedCount++;
+      return kErrorOk;
+    }
+
+    // mov r, x <- Removed.
+    // mov r, y
+    //
+    // The second mov must write the whole register (32-bit writes are zero
+    // extended in 64-bit mode) and must not read it.
+    if ((rules & kRuleMovDead) &&
+        X86Peephole_isPlain(cur, kX86InstIdMov) &&
+        o0.isReg() && static_cast<const X86Reg&>(o0).isGp() && o0.getSize() >= 4 &&
+        X86Peephole_isPlain(prev, kX86InstIdMov) &&
+        prev.o0.isReg() && static_cast<const X86Reg&>(prev.o0).isGp() &&
+        prev.o0._vreg.index == o0._vreg.index &&
+        (prev.o1.isReg() || prev.o1.isImm()) &&
+        !X86Peephole_readsGp(o1, o0._vreg.index)) {
+      _count--;
+      _removedCount++;
+      continue;
+    }
+
+    break;
+  }
+
+  // The window is full, pass the oldest instruction to the assembler.
+  if (_count == kWindowSize) {
+    ASMJIT_PROPAGATE_ERROR(_assembler->emitBatch(_window, 1));
+
+    for (uint32_t i = 1; i < kWindowSize; i++)
+      _window[i - 1] = _window[i];
+    _count--;
+  }
+
+  _window[_count++] = cur;
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Peephole - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+UNIT(x86_peephole) {
+  typedef int (*Func)(int);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Assembler b(&runtime);
+  X86Peephole p(&a);
+
+  X86GpReg arg = a.zcx;
+  X86GpReg tmp = a.zdx;
+
+#if ASMJIT_ARCH_X86
+  // The argument is passed on the stack (cdecl).
+  p.emit(kX86InstIdMov, x86::ecx, x86::ptr(x86::esp, 4));
+  b.emit(kX86InstIdMov, x86::ecx, x86::ptr(x86::esp, 4));
+#elif defined(_WIN64)
+  // The argument is passed in ECX.
+#else
+  p.emit(kX86InstIdMov, x86::ecx, x86::edi);
+  b.emit(kX86InstIdMov, x86::ecx, x86::edi);
+#endif
+
+  Label aNext = p.newLabel();
+  Label aDone = p.newLabel();
+  Label bDone = b.newLabel();
+
+  // Removed.
+  p.emit(kX86InstIdMov, arg, arg);
+  p.emit(kX86InstIdMov, tmp, arg);
+  p.emit(kX86InstIdMov, arg, tmp);
+  p.emit(kX86InstIdMov, x86::eax, 100);
+  p.emit(kX86InstIdMov, x86::eax, 200);
+  p.emit(kX86InstIdJmp, aNext);
+  p.bind(aNext);
+
+  b.emit(kX86InstIdMov, tmp, arg);
+  b.emit(kX86InstIdMov, x86::eax, 200);
+
+  // `test` removed, `jz` kept.
+  p.emit(kX86InstIdAnd, x86::ecx, 1);
+  p.emit(kX86InstIdTest, x86::ecx, x86::ecx);
+  p.emit(kX86InstIdJz, aDone);
+  p.emit(kX86InstIdAdd, x86::eax, x86::edx);
+  p.bind(aDone);
+
+  b.emit(kX86InstIdAnd, x86::ecx, 1);
+  b.emit(kX86InstIdJz, bDone);
+  b.emit(kX86InstIdAdd, x86::eax, x86::edx);
+  b.bind(bDone);
+
+  // Kept - the second mov reads the register, the test follows add.
+  p.emit(kX86InstIdMov, x86::edx, 1);
+  p.emit(kX86InstIdMov, x86::edx, x86::ptr(a.zsp, a.zdx));
+  p.emit(kX86InstIdAdd, x86::eax, 0);
+  p.emit(kX86InstIdTest, x86::eax, x86::eax);
+  p.emit(kX86InstIdRet);
+
+  b.emit(kX86InstIdMov, x86::edx, 1);
+  b.emit(kX86InstIdMov, x86::edx, x86::ptr(b.zsp, b.zdx));
+  b.emit(kX86InstIdAdd, x86::eax, 0);
+  b.emit(kX86InstIdTest, x86::eax, x86::eax);
+  b.emit(kX86InstIdRet);
+
+  EXPECT(p.finalize() == kErrorOk && p.getAssembler() == nullptr,
+    "Peephole optimizer should be detached by finalize().");
+  EXPECT(p.getRemovedCount() == 5,
+    "Removed %u instructions instead of 5.", static_cast<unsigned int>(p.getRemovedCount()));
+  EXPECT(a.getCodeSize() == b.getCodeSize() && ::memcmp(a.getBuffer(), b.getBuffer(), a.getCodeSize()) == 0,
+    "Optimized code doesn't match the expected code.");
+
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  int result = func(3);
+  EXPECT(result == 203,
+    "Function returned %d instead of 203.", result);
+
+  runtime.release((void*)func);
+}
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64
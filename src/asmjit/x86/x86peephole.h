@@ -0,0 +1,236 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Guard]
+#ifndef _ASMJIT_X86_X86PEEPHOLE_H
+#define _ASMJIT_X86_X86PEEPHOLE_H
+
+// [Dependencies]
+#include "../base/assembler.h"
+#include "../x86/x86assembler.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+//! \addtogroup asmjit_x86
+//! \{
+
+// ============================================================================
+// [asmjit::X86Peephole]
+// ============================================================================
+
+//! X86/X64 peephole optimizer.
+//!
+//! Peephole optimizer is an `ExternalTool` that is attached to `X86Assembler`
+//! and placed in front of it. Instructions emitted through it are kept in a
+//! small window and rewritten by simple rules before they are passed to the
+//! assembler. The rules never change the observable state of the machine,
+//! including flags, so only instructions that have no effect are removed:
+//!
+//!   - `mov r, r` - Except `mov r32, r32` in 64-bit mode, which clears the
+//!     upper half of the register.
+//!   - `mov b, a` right after `mov a, b` - GP registers of the same size, not
+//!     32-bit in 64-bit mode.
+//!   - `mov r, x` overwritten by the next `mov r, y` - If `x` is a register
+//!     or an immediate (a load could fault), `y` doesn't read `r`, and the
+//!     second `mov` writes the whole register.
+//!   - `test r, r` right after `and`, `or`, or `xor` of `r` - They set the
+//!     flags exactly the same way.
+//!   - `jmp` or `jcc` to a label that is bound right after it.
+//!
+//! A label, an alignment, and embedded data always flush the window, so the
+//! rules never look across them. `finalize()` flushes the window and detaches
+//! the optimizer from the assembler.
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! JitRuntime runtime;
+//! X86Assembler a(&runtime);
+//! X86Peephole p(&a);
+//!
+//! p.emit(kX86InstIdMov, x86::eax, x86::ecx);
+//! p.emit(kX86InstIdMov, x86::ecx, x86::eax); // Removed.
+//! p.emit(kX86InstIdRet);
+//! p.finalize();
+//! ~~~
+class ASMJIT_VIRTAPI X86Peephole : public ExternalTool {
+ public:
+  ASMJIT_NO_COPY(X86Peephole)
+
+  //! Count of instructions kept in the window.
+  enum { kWindowSize = 4 };
+
+  //! Peephole rules, all enabled by default.
+  ASMJIT_ENUM(Rules) {
+    //! Remove `mov r, r`.
+    kRuleMovSelf = 0x00000001,
+    //! Remove `mov b, a` after `mov a, b`.
+    kRuleMovBack = 0x00000002,
+    //! Remove `mov r, x` overwritten by the next `mov r, y`.
+    kRuleMovDead = 0x00000004,
+    //! Remove `test r, r` after `and`, `or`, or `xor` of `r`.
+    kRuleTestAfterLogic = 0x00000008,
+    //! Remove `jmp` or `jcc` to the next instruction.
+    kRuleJmpNext = 0x00000010,
+    //! All rules.
+    kRuleAll = 0x0000001F
+  };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a `X86Peephole` instance and attach it to `assembler` (optional).
+  ASMJIT_API X86Peephole(X86Assembler* assembler = nullptr) noexcept;
+  //! Destroy the `X86Peephole` instance.
+  ASMJIT_API virtual ~X86Peephole() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Attach / Reset]
+  // --------------------------------------------------------------------------
+
+  //! \override
+  ASMJIT_API virtual Error attach(Assembler* assembler) noexcept;
+  //! \override
+  //!
+  //! The window and rules are stored inline, `releaseMemory` has no effect.
+  ASMJIT_API virtual void reset(bool releaseMemory = false) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Finalize]
+  // --------------------------------------------------------------------------
+
+  //! \override
+  ASMJIT_API virtual Error finalize() noexcept;
+
+  //! Pass all instructions kept in the window to the assembler.
+  ASMJIT_API Error flush() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Assembler]
+  // --------------------------------------------------------------------------
+
+  //! Get the `X86Assembler` the optimizer is attached to.
+  ASMJIT_INLINE X86Assembler* getAssembler() const noexcept {
+    return static_cast<X86Assembler*>(_assembler);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Rules]
+  // --------------------------------------------------------------------------
+
+  //! Get enabled rules, see \ref Rules.
+  ASMJIT_INLINE uint32_t getRules() const noexcept { return _rules; }
+  //! Set enabled rules, see \ref Rules.
+  ASMJIT_INLINE void setRules(uint32_t rules) noexcept { _rules = rules; }
+
+  //! Get count of instructions removed since `reset()`.
+  ASMJIT_INLINE size_t getRemovedCount() const noexcept { return _removedCount; }
+
+  // --------------------------------------------------------------------------
+  // [Options]
+  // --------------------------------------------------------------------------
+
+  //! Get options of the next instruction.
+  ASMJIT_INLINE uint32_t getInstOptions() const noexcept { return _instOptions; }
+  //! Set options of the next instruction.
+  ASMJIT_INLINE void setInstOptions(uint32_t instOptions) noexcept { _instOptions = instOptions; }
+
+  // --------------------------------------------------------------------------
+  // [Label]
+  // --------------------------------------------------------------------------
+
+  //! Create a new label.
+  ASMJIT_INLINE Label newLabel() noexcept {
+    return _assembler != nullptr ? _assembler->newLabel() : Label();
+  }
+
+  //! Bind the `label` to the current offset.
+  ASMJIT_API Error bind(const Label& label) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Align / Embed]
+  // --------------------------------------------------------------------------
+
+  //! Align the code, see `Assembler::align()`.
+  ASMJIT_API Error align(uint32_t alignMode, uint32_t offset) noexcept;
+
+  //! Embed raw data, see `Assembler::embed()`.
+  ASMJIT_API Error embed(const void* data, uint32_t size) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Emit]
+  // --------------------------------------------------------------------------
+
+  //! Emit an instruction (virtual).
+  ASMJIT_API virtual Error _emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3) noexcept;
+
+  //! Emit an instruction.
+  ASMJIT_INLINE Error emit(uint32_t code) noexcept {
+    return _emit(code, noOperand, noOperand, noOperand, noOperand);
+  }
+  //! \overload
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0) noexcept {
+    return _emit(code, o0, noOperand, noOperand, noOperand);
+  }
+  //! \overload
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0, const Operand& o1) noexcept {
+    return _emit(code, o0, o1, noOperand, noOperand);
+  }
+  //! \overload
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2) noexcept {
+    return _emit(code, o0, o1, o2, noOperand);
+  }
+  //! \overload
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3) noexcept {
+    return _emit(code, o0, o1, o2, o3);
+  }
+
+  //! Emit an instruction with integer immediate operand.
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0, int o1) noexcept {
+    return _emit(code, o0, Imm(o1), noOperand, noOperand);
+  }
+  //! \overload
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0, int64_t o1) noexcept {
+    return _emit(code, o0, Imm(o1), noOperand, noOperand);
+  }
+  //! \overload
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0, const Operand& o1, int o2) noexcept {
+    return _emit(code, o0, o1, Imm(o2), noOperand);
+  }
+  //! \overload
+  ASMJIT_INLINE Error emit(uint32_t code, const Operand& o0, const Operand& o1, int64_t o2) noexcept {
+    return _emit(code, o0, o1, Imm(o2), noOperand);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Instructions kept in the window, the oldest first.
+  InstRecord _window[kWindowSize];
+  //! Count of instructions in the window.
+  uint32_t _count;
+  //! Enabled rules.
+  uint32_t _rules;
+  //! Options of the next instruction.
+  uint32_t _instOptions;
+  //! Count of removed instructions.
+  size_t _removedCount;
+};
+
+//! \}
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // _ASMJIT_X86_X86PEEPHOLE_H
@@ -0,0 +1,696 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Export]
+#define ASMJIT_EXPORTS
+
+// [Guard]
+#include "../build.h"
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+
+// [Dependencies]
+#include "../base/utils.h"
+#include "../x86/x86inst.h"
+#include "../x86/x86stencil.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+// ============================================================================
+// [asmjit::X86Stencil - Construction / Destruction]
+// ============================================================================
+
+X86Stencil::X86Stencil() noexcept
+  : _code(nullptr),
+    _holes(nullptr),
+    _arch(kArchNone),
+    _codeSize(0),
+    _holeCount(0),
+    _argCount(0),
+    _tailArg(kInvalidValue) {}
+
+X86Stencil::~X86Stencil() noexcept {
+  reset();
+}
+
+// ============================================================================
+// [asmjit::X86Stencil - Reset]
+// ============================================================================
+
+void X86Stencil::reset() noexcept {
+  if (_code != nullptr)
+    ASMJIT_FREE(_code);
+
+  _code = nullptr;
+  _holes = nullptr;
+  _arch = kArchNone;
+  _codeSize = 0;
+  _holeCount = 0;
+  _argCount = 0;
+  _tailArg = kInvalidValue;
+}
+
+// ============================================================================
+// [asmjit::X86StencilBuilder - Construction / Destruction]
+// ============================================================================
+
+X86StencilBuilder::X86StencilBuilder(X86Assembler* assembler) noexcept
+  : _assembler(assembler),
+    _decoder(assembler->getArch()),
+    _start(assembler->getOffset()),
+    _decoded(_start),
+    _last(kInvalidIndex) {
+
+  assembler->_refSites = &_refSites;
+}
+
+X86StencilBuilder::~X86StencilBuilder() noexcept {
+  if (_assembler->_refSites == &_refSites)
+    _assembler->_refSites = nullptr;
+}
+
+// ============================================================================
+// [asmjit::X86StencilBuilder - Holes]
+// ============================================================================
+
+static ASMJIT_INLINE bool X86StencilBuilder_hasFlatBuffer(const X86Assembler* a) noexcept {
+  return !a->hasAsmOption(Assembler::kOptionChunkedBuffer);
+}
+
+Error X86StencilBuilder::addHole(uint32_t type, uint32_t arg) noexcept {
+  X86Assembler* a = _assembler;
+
+  if (type > kX86StencilHoleBlock || arg > 0xFF)
+    return kErrorInvalidArgument;
+
+  if (!X86StencilBuilder_hasFlatBuffer(a))
+    return kErrorInvalidState;
+
+  if (!_decoder.isInitialized())
+    return kErrorNoHeapMemory;
+
+  // Decode everything emitted since the last hole, only the last instruction
+  // is interesting, but instructions can't be decoded backwards.
+  const uint8_t* buffer = a->getBuffer();
+  size_t end = a->getOffset();
+
+  X86DecodedInst inst;
+  while (_decoded < end) {
+    Error err = _decoder.decode(inst, buffer + _decoded, end - _decoded);
+    if (err != kErrorOk && (err != kErrorUnknownInst || inst.size == 0))
+      return err;
+
+    _last = _decoded;
+    _decoded += inst.size;
+  }
+
+  // There is no instruction in this stencil.
+  if (_last == kInvalidIndex || _last < _start)
+    return kErrorInvalidState;
+
+  // Decoded again if the instruction has more holes.
+  if (inst.size == 0)
+    _decoder.decode(inst, buffer + _last, end - _last);
+
+  X86StencilHole hole;
+  uint32_t holeOffset;
+
+  if (type == kX86StencilHoleImm) {
+    if (inst.immSize == 0)
+      return kErrorInvalidArgument;
+
+    holeOffset = inst.immOffset;
+    hole.size = inst.immSize;
+  }
+  else {
+    if (inst.dispSize == 0 || (type != kX86StencilHoleDisp && inst.dispSize != 4))
+      return kErrorInvalidArgument;
+
+    holeOffset = inst.dispOffset;
+    hole.size = inst.dispSize;
+  }
+
+  hole.offset = static_cast<uint32_t>(_last - _start) + holeOffset;
+  hole.type = static_cast<uint8_t>(type);
+  hole.tail = static_cast<uint8_t>(inst.size - holeOffset - hole.size);
+  hole.arg = static_cast<uint8_t>(arg);
+
+  return _holes.append(hole);
+}
+
+Error X86StencilBuilder::branch(uint32_t instId, uint32_t type, uint32_t arg) noexcept {
+  X86Assembler* a = _assembler;
+
+  if ((type != kX86StencilHoleAbs && type != kX86StencilHoleBlock) || arg > 0xFF || instId >= _kX86InstIdCount)
+    return kErrorInvalidArgument;
+
+  if (!X86StencilBuilder_hasFlatBuffer(a))
+    return kErrorInvalidState;
+
+  // Always the long form, the target is not known.
+  uint8_t code[6];
+  uint32_t opSize;
+
+  const X86InstInfo& info = X86Util::getInstInfo(instId);
+  if (info.getEncoding() == kX86InstEncodingX86Jcc) {
+    code[0] = 0x0F;
+    code[1] = static_cast<uint8_t>(0x80 | (info.getPrimaryOpCode() & 0x0F));
+    opSize = 2;
+  }
+  else if (instId == kX86InstIdJmp) {
+    code[0] = 0xE9;
+    opSize = 1;
+  }
+  else if (instId == kX86InstIdCall) {
+    code[0] = 0xE8;
+    opSize = 1;
+  }
+  else {
+    return kErrorInvalidArgument;
+  }
+
+  Utils::writeU32u(code + opSize, 0);
+
+  size_t offset = a->getOffset();
+  if (offset < _decoded)
+    return kErrorInvalidState;
+
+  ASMJIT_PROPAGATE_ERROR(a->embed(code, opSize + 4));
+
+  X86StencilHole hole;
+  hole.offset = static_cast<uint32_t>(offset - _start) + opSize;
+  hole.type = static_cast<uint8_t>(type);
+  hole.size = 4;
+  hole.tail = 0;
+  hole.arg = static_cast<uint8_t>(arg);
+
+  // The embedded data is never decoded, but it's the last instruction.
+  _last = offset;
+  _decoded = a->getOffset();
+
+  return _holes.append(hole);
+}
+
+// ============================================================================
+// [asmjit::X86StencilBuilder - Finish]
+// ============================================================================
+
+Error X86StencilBuilder::finish(X86Stencil& stencil) noexcept {
+  X86Assembler* a = _assembler;
+  ASMJIT_PROPAGATE_ERROR(a->getLastError());
+
+  if (!X86StencilBuilder_hasFlatBuffer(a) || a->getSectionsCount() != 1)
+    return kErrorInvalidState;
+
+  size_t start = _start;
+  size_t end = a->getOffset();
+
+  if (end == start)
+    return kErrorNoCodeGenerated;
+
+  if (end - start > static_cast<size_t>(0x7FFFFFFF))
+    return kErrorCodeTooLarge;
+
+  X86StencilHole* holes = _holes.getData();
+  size_t holeCount = _holes.getLength();
+  size_t i, j;
+
+  // Holes of a single instruction can be added in any order.
+  for (i = 1; i < holeCount; i++) {
+    X86StencilHole hole = holes[i];
+    for (j = i; j > 0 && holes[j - 1].offset > hole.offset; j--)
+      holes[j] = holes[j - 1];
+    holes[j] = hole;
+  }
+
+  // Labels must be resolved within the stencil.
+  size_t labelCount = a->getLabelsCount();
+  for (i = 0; i < labelCount; i++) {
+    if (!a->isLabelBound(static_cast<uint32_t>(i)) && a->_labelLinkHeads[i] != kInvalidValue)
+      return kErrorInvalidState;
+  }
+
+  // Relative references must target the stencil, the code is copied and the
+  // displacements would point to the original buffer otherwise. Sites beyond
+  // `end` were rolled back.
+  const X86RefSite* sites = _refSites.getData();
+  size_t siteCount = _refSites.getLength();
+
+  for (i = 0; i < siteCount; i++) {
+    const X86RefSite& site = sites[i];
+    if (site.end <= static_cast<intptr_t>(start) || site.end > static_cast<intptr_t>(end))
+      continue;
+
+    if (site.labelId == kInvalidValue) {
+      // RIP relative displacement has to be a relative hole.
+      uint32_t siteEnd = static_cast<uint32_t>(site.end - static_cast<intptr_t>(start));
+      for (j = 0; j < holeCount; j++)
+        if (holes[j].type >= kX86StencilHoleAbs && holes[j].offset + holes[j].size + holes[j].tail == siteEnd)
+          break;
+
+      if (j == holeCount)
+        return kErrorInvalidState;
+    }
+    else {
+      // Labels not bound yet are checked above.
+      intptr_t target = a->getLabelOffset(site.labelId);
+      if (target != -1 && (target < static_cast<intptr_t>(start) || target >= static_cast<intptr_t>(end)))
+        return kErrorInvalidState;
+    }
+  }
+
+  // The only relocations allowed are `jmp` and `call` marked as holes, the
+  // linker patches them instead of `relocCode()`.
+  const RelocData* rdList = a->_relocations.getData();
+  size_t relocCount = a->_relocations.getLength();
+
+  for (i = 0; i < relocCount; i++) {
+    const RelocData& rd = rdList[i];
+    if (rd.from < start)
+      continue;
+
+    if (rd.type != kRelocAbsToRel && rd.type != kRelocTrampoline)
+      return kErrorInvalidState;
+
+    uint32_t offset = static_cast<uint32_t>(rd.from - start);
+    for (j = 0; j < holeCount; j++)
+      if (holes[j].offset == offset && holes[j].type == kX86StencilHoleAbs)
+        break;
+
+    if (j == holeCount)
+      return kErrorInvalidState;
+  }
+
+  uint32_t codeSize = static_cast<uint32_t>(end - start);
+  uint32_t holesOffset = Utils::alignTo<uint32_t>(codeSize, 4);
+
+  uint8_t* code = static_cast<uint8_t*>(
+    ASMJIT_ALLOC(holesOffset + holeCount * sizeof(X86StencilHole)));
+
+  if (code == nullptr)
+    return kErrorNoHeapMemory;
+
+  ::memcpy(code, a->getBuffer() + start, codeSize);
+  ::memcpy(code + holesOffset, holes, holeCount * sizeof(X86StencilHole));
+
+  uint32_t argCount = 0;
+  for (i = 0; i < holeCount; i++)
+    argCount = Utils::iMax<uint32_t>(argCount, holes[i].arg + 1);
+
+  // A `jmp` emitted by `branch()` at the end of the stencil can be dropped
+  // if it jumps to the next block.
+  uint32_t tailArg = kInvalidValue;
+  if (holeCount != 0 && _last + 5 == end && code[_last - start] == 0xE9) {
+    const X86StencilHole& hole = holes[holeCount - 1];
+    if (hole.type == kX86StencilHoleBlock && hole.offset + 4 == codeSize)
+      tailArg = hole.arg;
+  }
+
+  stencil.reset();
+  stencil._code = code;
+  stencil._holes = reinterpret_cast<X86StencilHole*>(code + holesOffset);
+  stencil._arch = a->getArch();
+  stencil._codeSize = codeSize;
+  stencil._holeCount = static_cast<uint32_t>(holeCount);
+  stencil._argCount = argCount;
+  stencil._tailArg = tailArg;
+
+  // Start a new stencil.
+  _start = end;
+  _decoded = end;
+  _last = kInvalidIndex;
+  _holes.reset();
+  _refSites.reset();
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86StencilLinker - Construction / Destruction]
+// ============================================================================
+
+X86StencilLinker::X86StencilLinker() noexcept
+  : _buffer(nullptr),
+    _capacity(0),
+    _codeSize(0) {}
+
+X86StencilLinker::~X86StencilLinker() noexcept {
+  reset(true);
+}
+
+// ============================================================================
+// [asmjit::X86StencilLinker - Reset]
+// ============================================================================
+
+void X86StencilLinker::reset(bool releaseMemory) noexcept {
+  if (releaseMemory && _buffer != nullptr) {
+    ASMJIT_FREE(_buffer);
+    _buffer = nullptr;
+    _capacity = 0;
+  }
+
+  _codeSize = 0;
+  _blockOffsets.reset(releaseMemory);
+  _fixups.reset(releaseMemory);
+}
+
+// ============================================================================
+// [asmjit::X86StencilLinker - Add]
+// ============================================================================
+
+static Error X86StencilLinker_grow(X86StencilLinker* self, size_t n) noexcept {
+  size_t capacity = Utils::iMax<size_t>(self->_capacity * 2, 256);
+  if (capacity - self->_codeSize < n)
+    capacity = self->_codeSize + n;
+
+  uint8_t* buffer = static_cast<uint8_t*>(ASMJIT_REALLOC(self->_buffer, capacity));
+  if (buffer == nullptr)
+    return kErrorNoHeapMemory;
+
+  self->_buffer = buffer;
+  self->_capacity = capacity;
+  return kErrorOk;
+}
+
+Error X86StencilLinker::add(const X86Stencil& stencil, const uint64_t* args) noexcept {
+  uint32_t argCount = stencil.getArgCount();
+
+  if (!stencil.isInitialized() || (argCount != 0 && args == nullptr))
+    return kErrorInvalidArgument;
+
+  size_t index = _blockOffsets.getLength();
+  size_t fixupIndex = _fixups.getLength();
+
+  uint32_t codeSize = stencil.getCodeSize();
+  uint32_t holeCount = stencil.getHoleCount();
+
+  // Drop the tail jump if it jumps to the next block, it's the last hole.
+  uint32_t tailArg = stencil.getTailArg();
+  if (tailArg != kInvalidValue && args[tailArg] == static_cast<uint64_t>(index + 1)) {
+    codeSize -= 5;
+    holeCount--;
+  }
+
+  if (_capacity - _codeSize < codeSize)
+    ASMJIT_PROPAGATE_ERROR(X86StencilLinker_grow(this, codeSize));
+
+  if (_codeSize + codeSize > static_cast<size_t>(0xFFFFFFFF))
+    return kErrorCodeTooLarge;
+
+  ASMJIT_PROPAGATE_ERROR(_blockOffsets.append(static_cast<uint32_t>(_codeSize)));
+
+  uint8_t* p = _buffer + _codeSize;
+  ::memcpy(p, stencil.getCode(), codeSize);
+
+  const X86StencilHole* holes = stencil.getHoles();
+  for (uint32_t i = 0; i < holeCount; i++) {
+    const X86StencilHole& hole = holes[i];
+    uint64_t value = args[hole.arg];
+
+    switch (hole.type) {
+      case kX86StencilHoleImm:
+      case kX86StencilHoleDisp:
+        if (hole.size == 1)
+          Utils::writeU8(p + hole.offset, static_cast<uint32_t>(value & 0xFF));
+        else if (hole.size == 2)
+          Utils::writeU16u(p + hole.offset, static_cast<uint32_t>(value & 0xFFFF));
+        else if (hole.size == 4)
+          Utils::writeU32u(p + hole.offset, static_cast<uint32_t>(value & 0xFFFFFFFF));
+        else
+          Utils::writeU64u(p + hole.offset, value);
+        break;
+
+      case kX86StencilHoleAbs:
+      case kX86StencilHoleBlock: {
+        // Depends on the address of the code, patched by `relocCode()`.
+        Fixup fixup;
+        fixup.offset = static_cast<uint32_t>(_codeSize) + hole.offset;
+        fixup.type = hole.type;
+        fixup.tail = hole.tail;
+        fixup.x64 = stencil.getArch() == kArchX64;
+        fixup.reserved = 0;
+        fixup.value = value;
+
+        Error err = _fixups.append(fixup);
+        if (err != kErrorOk) {
+          _blockOffsets.truncate(index);
+          _fixups.truncate(fixupIndex);
+          return err;
+        }
+        break;
+      }
+
+      default:
+        ASMJIT_NOT_REACHED();
+    }
+  }
+
+  _codeSize += codeSize;
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86StencilLinker - Link]
+// ============================================================================
+
+size_t X86StencilLinker::relocCode(void* _dst, Ptr baseAddress) const noexcept {
+  uint8_t* dst = static_cast<uint8_t*>(_dst);
+
+  if (baseAddress == kNoBaseAddress)
+    baseAddress = static_cast<Ptr>((uintptr_t)dst);
+
+  ::memcpy(dst, _buffer, _codeSize);
+
+  const uint32_t* blockOffsets = _blockOffsets.getData();
+  size_t blockCount = _blockOffsets.getLength();
+
+  const Fixup* fixups = _fixups.getData();
+  size_t fixupCount = _fixups.getLength();
+
+  for (size_t i = 0; i < fixupCount; i++) {
+    const Fixup& fixup = fixups[i];
+    Ptr target = static_cast<Ptr>(fixup.value);
+
+    if (fixup.type == kX86StencilHoleBlock) {
+      if (fixup.value >= static_cast<uint64_t>(blockCount))
+        return 0;
+      target = baseAddress + blockOffsets[static_cast<size_t>(fixup.value)];
+    }
+
+    Ptr next = baseAddress + fixup.offset + 4 + fixup.tail;
+    SignedPtr rel = static_cast<SignedPtr>(target - next);
+
+    // 32-bit code wraps around, everything is reachable.
+    if (fixup.x64 && !Utils::isInt32(rel))
+      return 0;
+
+    Utils::writeI32u(dst + fixup.offset, static_cast<int32_t>(rel));
+  }
+
+  return _codeSize;
+}
+
+Error X86StencilLinker::make(JitRuntime* runtime, void** dst) const noexcept {
+  size_t codeSize = _codeSize;
+  if (codeSize == 0) {
+    *dst = nullptr;
+    return kErrorNoCodeGenerated;
+  }
+
+  VMemMgr* memMgr = runtime->getMemMgr();
+  void* p = memMgr->alloc(codeSize, runtime->getAllocType());
+
+  if (p == nullptr) {
+    *dst = nullptr;
+    return kErrorNoVirtualMemory;
+  }
+
+  if (relocCode(p) == 0) {
+    memMgr->release(p);
+    *dst = nullptr;
+    return kErrorInvalidState;
+  }
+
+  runtime->flush(p, codeSize);
+  *dst = p;
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Stencil - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST) && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+UNIT(x86_stencil) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86StencilBuilder builder(&a);
+
+  X86Stencil sLoadEax, sLoadEcx, sAddEax, sLoop, sRet, sCall;
+
+  INFO("Building stencils.");
+
+  // eax = #0, jmp block #1.
+  a.mov(x86::eax, 0x7FFFFFFF);
+  EXPECT(builder.addHole(kX86StencilHoleImm, 0) == kErrorOk, "Couldn't add a hole.");
+  EXPECT(builder.branch(kX86InstIdJmp, kX86StencilHoleBlock, 1) == kErrorOk, "Couldn't add a branch.");
+  EXPECT(builder.finish(sLoadEax) == kErrorOk, "Couldn't finish sLoadEax.");
+
+  // ecx = #0, jmp block #1.
+  a.mov(x86::ecx, 0x7FFFFFFF);
+  EXPECT(builder.addHole(kX86StencilHoleImm, 0) == kErrorOk, "Couldn't add a hole.");
+  EXPECT(builder.branch(kX86InstIdJmp, kX86StencilHoleBlock, 1) == kErrorOk, "Couldn't add a branch.");
+  EXPECT(builder.finish(sLoadEcx) == kErrorOk, "Couldn't finish sLoadEcx.");
+
+  // eax += #0, jmp block #1.
+  a.add(x86::eax, 0x7FFFFFFF);
+  EXPECT(builder.addHole(kX86StencilHoleImm, 0) == kErrorOk, "Couldn't add a hole.");
+  EXPECT(builder.branch(kX86InstIdJmp, kX86StencilHoleBlock, 1) == kErrorOk, "Couldn't add a branch.");
+  EXPECT(builder.finish(sAddEax) == kErrorOk, "Couldn't finish sAddEax.");
+
+  // if (--ecx) jmp block #0, jmp block #1.
+  a.dec(x86::ecx);
+  EXPECT(builder.branch(kX86InstIdJnz, kX86StencilHoleBlock, 0) == kErrorOk, "Couldn't add a branch.");
+  EXPECT(builder.branch(kX86InstIdJmp, kX86StencilHoleBlock, 1) == kErrorOk, "Couldn't add a branch.");
+  EXPECT(builder.finish(sLoop) == kErrorOk, "Couldn't finish sLoop.");
+
+  a.ret();
+  EXPECT(builder.finish(sRet) == kErrorOk, "Couldn't finish sRet.");
+
+  // call #0 (emitted by the assembler).
+  a.call(Imm(0x1000));
+  EXPECT(builder.addHole(kX86StencilHoleAbs, 0) == kErrorOk, "Couldn't add a hole.");
+  EXPECT(builder.finish(sCall) == kErrorOk, "Couldn't finish sCall.");
+
+  EXPECT(sAddEax.getHoleCount() == 2 && sAddEax.getHoles()[0].size == 4,
+    "The immediate of sAddEax should be a 32-bit hole.");
+  EXPECT(sLoop.getArgCount() == 2 && sLoop.hasTailJump() && sLoop.getTailArg() == 1,
+    "sLoop should end with a jump to block #1.");
+  EXPECT(!sRet.hasTailJump() && sRet.getArgCount() == 0,
+    "sRet has no holes.");
+
+  INFO("Rejecting a call that is not marked as a hole.");
+  X86Stencil sInvalid;
+  a.call(Imm(0x1000));
+  EXPECT(builder.finish(sInvalid) == kErrorInvalidState && !sInvalid.isInitialized(),
+    "A relocation not covered by a hole must be rejected.");
+
+  INFO("Rejecting references to labels bound before the stencil.");
+  for (uint32_t i = 0; i < 3; i++) {
+    X86Assembler b(&runtime);
+    Label L_Before = b.newLabel();
+
+    b.bind(L_Before);
+    b.dd(0);
+
+    X86StencilBuilder bBuilder(&b);
+    X86Stencil sBefore;
+
+    if (i == 0)
+      b.jmp(L_Before);
+    else if (i == 1)
+      b.jnz(L_Before);
+    else
+      b.mov(x86::eax, x86::dword_ptr(L_Before));
+
+    EXPECT(bBuilder.finish(sBefore) == kErrorInvalidState && !sBefore.isInitialized(),
+      "Reference #%u to a label bound before the stencil must be rejected.", i);
+  }
+
+  INFO("Accepting a backward branch within the stencil.");
+  {
+    X86Assembler b(&runtime);
+    X86StencilBuilder bBuilder(&b);
+    X86Stencil sWithin;
+
+    Label L_Loop = b.newLabel();
+    b.bind(L_Loop);
+    b.dec(x86::ecx);
+    b.jnz(L_Loop);
+    b.ret();
+
+    EXPECT(bBuilder.finish(sWithin) == kErrorOk,
+      "A branch to a label bound within the stencil must be accepted.");
+  }
+
+  if (a.getArch() == kArchX64) {
+    INFO("Rejecting a RIP relative displacement that is not a hole.");
+    X86Assembler b(&runtime);
+    X86StencilBuilder bBuilder(&b);
+    X86Stencil sRip;
+
+    b.mov(x86::eax, x86::dword_ptr(x86::rip, 0x100));
+    EXPECT(bBuilder.finish(sRip) == kErrorInvalidState,
+      "A RIP relative displacement not covered by a hole must be rejected.");
+
+    EXPECT(bBuilder.addHole(kX86StencilHoleAbs, 0) == kErrorOk && bBuilder.finish(sRip) == kErrorOk,
+      "A RIP relative displacement covered by a hole must be accepted.");
+  }
+
+  INFO("Linking eax = 0, ecx = 10, do { eax += 3 } while (--ecx), ret.");
+  X86StencilLinker linker;
+
+  EXPECT(linker.add(sLoadEax, 0, 1) == kErrorOk &&
+         linker.add(sLoadEcx, 10, 2) == kErrorOk &&
+         linker.add(sAddEax, 3, 3) == kErrorOk &&
+         linker.add(sLoop, 2, 4) == kErrorOk &&
+         linker.add(sRet) == kErrorOk,
+    "X86StencilLinker::add() failed.");
+
+  size_t fullSize = sLoadEax.getCodeSize() + sLoadEcx.getCodeSize() +
+                    sAddEax.getCodeSize() + sLoop.getCodeSize() + sRet.getCodeSize();
+  EXPECT(linker.getCodeSize() == fullSize - 4 * 5,
+    "Jumps to the next block should be dropped.");
+
+  void* p;
+  EXPECT(linker.make(&runtime, &p) == kErrorOk,
+    "X86StencilLinker::make() failed.");
+
+  int result = asmjit_cast<Func>(p)();
+  EXPECT(result == 30,
+    "Linked function returned %d, expected 30.", result);
+  runtime.release(p);
+
+  INFO("Linking an absolute call target.");
+  uint8_t code[32];
+
+  linker.reset();
+  EXPECT(linker.add(sCall, 0x20000) == kErrorOk,
+    "X86StencilLinker::add() failed.");
+
+  size_t callSize = sCall.getCodeSize();
+  EXPECT(linker.relocCode(code, 0x10000) == callSize,
+    "X86StencilLinker::relocCode() failed.");
+  EXPECT(Utils::readI32u(code + callSize - 4) == static_cast<int32_t>(0x20000 - (0x10000 + callSize)),
+    "Wrong displacement of the call.");
+
+  if (sCall.getArch() == kArchX64) {
+    linker.reset();
+    linker.add(sCall, ASMJIT_UINT64_C(0x7FFF00000000));
+    EXPECT(linker.relocCode(code, 0x10000) == 0,
+      "A target out of reach must fail.");
+  }
+
+  INFO("Rejecting a block out of range.");
+  linker.reset();
+  linker.add(sAddEax, 1, 5);
+  EXPECT(linker.relocCode(code, 0x10000) == 0,
+    "A block out of range must fail.");
+}
+#endif // ASMJIT_TEST && (ASMJIT_ARCH_X86 || ASMJIT_ARCH_X64)
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64
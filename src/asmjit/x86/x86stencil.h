@@ -0,0 +1,393 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Guard]
+#ifndef _ASMJIT_X86_X86STENCIL_H
+#define _ASMJIT_X86_X86STENCIL_H
+
+// [Dependencies]
+#include "../base/podvector.h"
+#include "../base/runtime.h"
+#include "../x86/x86assembler.h"
+#include "../x86/x86decoder.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+//! \addtogroup asmjit_x86
+//! \{
+
+// ============================================================================
+// [asmjit::X86StencilHoleType]
+// ============================================================================
+
+//! Type of a hole in `X86Stencil`.
+ASMJIT_ENUM(X86StencilHoleType) {
+  //! Immediate value of the instruction, truncated to its size.
+  kX86StencilHoleImm = 0,
+  //! Displacement of the memory operand, truncated to its size.
+  kX86StencilHoleDisp = 1,
+  //! 32-bit relative target (branch or RIP relative memory) given as an
+  //! absolute address. It must be within 2GB of the code in 64-bit mode.
+  kX86StencilHoleAbs = 2,
+  //! 32-bit relative target given as an index of a stencil added to the same
+  //! `X86StencilLinker`.
+  kX86StencilHoleBlock = 3
+};
+
+// ============================================================================
+// [asmjit::X86StencilHole]
+// ============================================================================
+
+//! Hole in `X86Stencil`, patched by `X86StencilLinker`.
+struct X86StencilHole {
+  //! Offset of the hole in the stencil.
+  uint32_t offset;
+  //! Type of the hole, see \ref X86StencilHoleType.
+  uint8_t type;
+  //! Size of the hole (1, 2, 4, or 8 bytes).
+  uint8_t size;
+  //! Count of bytes that follow the hole in the instruction, relative targets
+  //! are relative to the end of the instruction.
+  uint8_t tail;
+  //! Index of the argument that provides the value.
+  uint8_t arg;
+};
+
+// ============================================================================
+// [asmjit::X86Stencil]
+// ============================================================================
+
+//! Pre-assembled code snippet with holes, see `X86StencilBuilder`.
+//!
+//! Stencil is immutable once built and can be shared by any number of
+//! `X86StencilLinker` instances, including ones used by other threads.
+class X86Stencil {
+ public:
+  ASMJIT_NO_COPY(X86Stencil)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create an empty `X86Stencil`.
+  ASMJIT_API X86Stencil() noexcept;
+  //! Destroy the `X86Stencil` instance.
+  ASMJIT_API ~X86Stencil() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  //! Release the code and holes.
+  ASMJIT_API void reset() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get whether the stencil was built.
+  ASMJIT_INLINE bool isInitialized() const noexcept { return _code != nullptr; }
+
+  //! Get the target architecture.
+  ASMJIT_INLINE uint32_t getArch() const noexcept { return _arch; }
+
+  //! Get the code.
+  ASMJIT_INLINE const uint8_t* getCode() const noexcept { return _code; }
+  //! Get the code size.
+  ASMJIT_INLINE uint32_t getCodeSize() const noexcept { return _codeSize; }
+
+  //! Get holes, sorted by their offset.
+  ASMJIT_INLINE const X86StencilHole* getHoles() const noexcept { return _holes; }
+  //! Get count of holes.
+  ASMJIT_INLINE uint32_t getHoleCount() const noexcept { return _holeCount; }
+
+  //! Get count of arguments, which is the highest argument index plus one.
+  ASMJIT_INLINE uint32_t getArgCount() const noexcept { return _argCount; }
+
+  //! Get whether the stencil ends with `jmp` to a block.
+  //!
+  //! The jump is dropped by `X86StencilLinker` if the block is the one added
+  //! right after the stencil, so stencils can be concatenated without jumps.
+  ASMJIT_INLINE bool hasTailJump() const noexcept { return _tailArg != kInvalidValue; }
+  //! Get the argument of the tail jump, `kInvalidValue` if there is none.
+  ASMJIT_INLINE uint32_t getTailArg() const noexcept { return _tailArg; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Code, followed by holes in the same memory block.
+  uint8_t* _code;
+  //! Holes.
+  X86StencilHole* _holes;
+
+  //! Target architecture.
+  uint32_t _arch;
+  //! Code size.
+  uint32_t _codeSize;
+  //! Count of holes.
+  uint32_t _holeCount;
+  //! Count of arguments.
+  uint32_t _argCount;
+  //! Argument of the tail jump.
+  uint32_t _tailArg;
+};
+
+// ============================================================================
+// [asmjit::X86StencilBuilder]
+// ============================================================================
+
+//! Builds `X86Stencil` from code emitted by `X86Assembler`.
+//!
+//! Code is emitted by the assembler as usual. Immediates and displacements
+//! that become holes are emitted with a placeholder value and marked by
+//! `addHole()`, which decodes the last emitted instruction to find where its
+//! immediate or displacement is. The size of the hole is the size chosen by
+//! the assembler, so the placeholder must need the wanted size, for example
+//! `add eax, 0` uses an 8-bit immediate, but `add eax, 0x7FFFFFFF` doesn't.
+//! Branches to other stencils are emitted by `branch()`, as the assembler can
+//! only branch to labels and absolute addresses. `finish()` copies the code
+//! emitted since the builder was created (or since the last `finish()`) into
+//! the stencil.
+//!
+//! The stencil must be self-contained, the following is rejected by
+//! `finish()` with `kErrorInvalidState`:
+//!
+//!   - Labels that are used, but not bound.
+//!   - Jumps, calls and RIP relative operands that use labels bound outside
+//!     of the stencil, and RIP relative displacements that are not holes.
+//!   - Relocations other than `jmp` and `call` to an immediate marked as
+//!     `kX86StencilHoleAbs`, for example references to labels in 32-bit mode
+//!     or GOT entries of position independent code.
+//!   - Code emitted to sections other than the default one, and assemblers
+//!     that use `Assembler::kOptionChunkedBuffer`.
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! JitRuntime runtime;
+//! X86Assembler a(&runtime);
+//!
+//! X86Stencil addImm;
+//! X86StencilBuilder builder(&a);
+//!
+//! a.add(x86::eax, 0x7FFFFFFF);                      // Placeholder.
+//! builder.addHole(kX86StencilHoleImm, 0);           // Argument #0.
+//! builder.branch(kX86InstIdJmp, kX86StencilHoleBlock, 1);
+//! builder.finish(addImm);
+//! ~~~
+class X86StencilBuilder {
+ public:
+  ASMJIT_NO_COPY(X86StencilBuilder)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a `X86StencilBuilder` that uses code emitted by `assembler`
+  //! from its current offset.
+  ASMJIT_API X86StencilBuilder(X86Assembler* assembler) noexcept;
+  //! Destroy the `X86StencilBuilder` instance.
+  ASMJIT_API ~X86StencilBuilder() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the assembler.
+  ASMJIT_INLINE X86Assembler* getAssembler() const noexcept { return _assembler; }
+
+  // --------------------------------------------------------------------------
+  // [Holes]
+  // --------------------------------------------------------------------------
+
+  //! Mark the immediate (`kX86StencilHoleImm`) or the displacement (all other
+  //! types) of the last emitted instruction as a hole patched by argument
+  //! `arg`. Relative targets must be 32-bit.
+  ASMJIT_API Error addHole(uint32_t type, uint32_t arg) noexcept;
+
+  //! Emit `jmp`, `call`, or `jcc` with a 32-bit relative target patched by
+  //! argument `arg`, `type` is either `kX86StencilHoleAbs` or
+  //! `kX86StencilHoleBlock`.
+  ASMJIT_API Error branch(uint32_t instId, uint32_t type, uint32_t arg) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Finish]
+  // --------------------------------------------------------------------------
+
+  //! Store the code and holes to `stencil` and start a new stencil at the
+  //! current offset of the assembler.
+  ASMJIT_API Error finish(X86Stencil& stencil) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Assembler.
+  X86Assembler* _assembler;
+  //! Decoder used to find immediates and displacements.
+  X86Decoder _decoder;
+  //! Offset where the stencil starts.
+  size_t _start;
+  //! Offset of the next instruction to decode.
+  size_t _decoded;
+  //! Offset of the last instruction, `kInvalidIndex` if none.
+  size_t _last;
+  //! Holes.
+  PodVector<X86StencilHole> _holes;
+  //! Relative references recorded by the assembler.
+  PodVector<X86RefSite> _refSites;
+};
+
+// ============================================================================
+// [asmjit::X86StencilLinker]
+// ============================================================================
+
+//! Concatenates stencils and patches their holes.
+//!
+//! Linking is a copy of each stencil followed by writing its holes, no
+//! instruction is encoded, so it's much faster than `X86Assembler` and
+//! `X86Compiler`, and it doesn't allocate memory once the linker has been
+//! used (`reset()` keeps the memory by default).
+//!
+//! Each `add()` appends a block, blocks are indexed from zero and can be the
+//! targets of `kX86StencilHoleBlock` holes. The stencil is copied and its
+//! immediates and displacements are patched by `add()` right away, relative
+//! targets are patched by `relocCode()` when the address of the code is known.
+//! If a stencil ends with a jump to the next block the jump is not copied.
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! // Stencils `loadImm`, `addImm` (both followed by a jump to the block given
+//! // by argument #1) and `ret` were built by `X86StencilBuilder`.
+//! X86StencilLinker linker;
+//!
+//! linker.add(loadImm, 10, 1);
+//! linker.add(addImm, 20, 2);
+//! linker.add(ret);
+//!
+//! void* func;
+//! Error err = linker.make(&runtime, &func);
+//! ~~~
+class X86StencilLinker {
+ public:
+  ASMJIT_NO_COPY(X86StencilLinker)
+
+  //! \internal
+  //!
+  //! Relative target patched by `relocCode()`.
+  struct Fixup {
+    //! Offset of the displacement in the code.
+    uint32_t offset;
+    //! Type of the hole, either `kX86StencilHoleAbs` or `kX86StencilHoleBlock`.
+    uint8_t type;
+    //! Count of bytes that follow the displacement in the instruction.
+    uint8_t tail;
+    //! Whether the code is 64-bit.
+    uint8_t x64;
+    //! \internal
+    uint8_t reserved;
+    //! Absolute address or block index.
+    uint64_t value;
+  };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a `X86StencilLinker` instance.
+  ASMJIT_API X86StencilLinker() noexcept;
+  //! Destroy the `X86StencilLinker` instance.
+  ASMJIT_API ~X86StencilLinker() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  //! Remove all blocks.
+  ASMJIT_API void reset(bool releaseMemory = false) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get count of blocks.
+  ASMJIT_INLINE size_t getBlockCount() const noexcept { return _blockOffsets.getLength(); }
+  //! Get the size of the linked code.
+  ASMJIT_INLINE size_t getCodeSize() const noexcept { return _codeSize; }
+
+  // --------------------------------------------------------------------------
+  // [Add]
+  // --------------------------------------------------------------------------
+
+  //! Append `stencil` as a new block, `args` must provide at least
+  //! `stencil.getArgCount()` values.
+  ASMJIT_API Error add(const X86Stencil& stencil, const uint64_t* args) noexcept;
+
+  //! \overload
+  ASMJIT_INLINE Error add(const X86Stencil& stencil) noexcept {
+    return add(stencil, nullptr);
+  }
+  //! \overload
+  ASMJIT_INLINE Error add(const X86Stencil& stencil, uint64_t a0) noexcept {
+    return add(stencil, &a0);
+  }
+  //! \overload
+  ASMJIT_INLINE Error add(const X86Stencil& stencil, uint64_t a0, uint64_t a1) noexcept {
+    uint64_t args[2] = { a0, a1 };
+    return add(stencil, args);
+  }
+  //! \overload
+  ASMJIT_INLINE Error add(const X86Stencil& stencil, uint64_t a0, uint64_t a1, uint64_t a2) noexcept {
+    uint64_t args[3] = { a0, a1, a2 };
+    return add(stencil, args);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Link]
+  // --------------------------------------------------------------------------
+
+  //! Link all blocks to `dst` that must have at least `getCodeSize()` bytes.
+  //! If `baseAddress` is `kNoBaseAddress` the code is linked to `dst`.
+  //!
+  //! Returns the size of the code or zero on failure, which happens if a
+  //! block index is out of range or an absolute target is out of reach.
+  ASMJIT_API size_t relocCode(void* dst, Ptr baseAddress = kNoBaseAddress) const noexcept;
+
+  //! Allocate memory by `runtime`, link all blocks to it, and flush it. The
+  //! code is released by `runtime->release()`.
+  ASMJIT_API Error make(JitRuntime* runtime, void** dst) const noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Code of all blocks.
+  uint8_t* _buffer;
+  //! Capacity of `_buffer`.
+  size_t _capacity;
+  //! Size of the code in `_buffer`.
+  size_t _codeSize;
+
+  //! Offset of each block.
+  PodVector<uint32_t> _blockOffsets;
+  //! Relative targets.
+  PodVector<Fixup> _fixups;
+};
+
+//! \}
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // _ASMJIT_X86_X86STENCIL_H
@@ -113,6 +113,124 @@ static double mbps(uint32_t time, size_t outputSize) {
   return (bytesTotal * 1000) / (static_cast<double>(time) * 1024 * 1024);
 }
 
+// ============================================================================
+// [GpForms]
+// ============================================================================
+
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+// Emit a stream of the most common GP forms (reg/reg, reg/imm, reg/mem).
+static void benchGpForms(asmjit::X86Assembler& a) {
+  using namespace asmjit;
+
+  const X86GpReg& zax = a.zax;
+  const X86GpReg& zcx = a.zcx;
+  const X86GpReg& zdx = a.zdx;
+  const X86GpReg& zsi = a.zsi;
+  const X86GpReg& zdi = a.zdi;
+
+  for (uint32_t i = 0; i < 64; i++) {
+    a.push(zsi);
+    a.mov(zax, zcx);
+    a.mov(x86::ecx, 1234);
+    a.mov(zdx, x86::ptr(zsi, 16));
+    a.mov(x86::ptr(zdi, zcx, 2, 8), zdx);
+    a.add(zax, zdx);
+    a.add(zax, 1);
+    a.sub(zcx, 1000);
+    a.and_(x86::eax, 0xFF);
+    a.xor_(x86::edx, x86::edx);
+    a.cmp(zax, x86::ptr(zsi, zcx, 0, -8));
+    a.lea(zdi, x86::ptr(zsi, zdx, 3, 64));
+    a.test(zax, zax);
+    a.pop(zsi);
+  }
+  a.ret();
+}
+
+// Emit a small block of GP instructions `i`, used to benchmark speculative
+// emission.
+static void benchGpBlock(asmjit::X86Assembler& a, uint32_t i) {
+  using namespace asmjit;
+
+  a.mov(a.zax, x86::ptr(a.zsi, static_cast<int32_t>(i * 8)));
+  a.add(a.zax, static_cast<int>(0x1000 + i));
+  a.cmp(a.zax, a.zdx);
+  a.cmovg(a.zax, a.zdx);
+  a.mov(x86::ptr(a.zdi, static_cast<int32_t>(i * 8)), a.zax);
+}
+
+// Emit a small thunk that fits into 256 bytes.
+static void benchThunk(asmjit::X86Assembler& a, uint32_t i) {
+  using namespace asmjit;
+
+  Label L_Skip = a.newLabel();
+
+  a.push(a.zbx);
+  a.mov(a.zbx, a.zdi);
+  a.mov(x86::eax, x86::ptr(a.zbx, 8));
+  a.cmp(x86::eax, static_cast<int>(i));
+  a.jne(L_Skip);
+  a.add(x86::eax, 0x1000);
+  a.mov(x86::ptr(a.zbx, 8), x86::eax);
+  a.bind(L_Skip);
+  a.pop(a.zbx);
+  a.ret();
+}
+
+// Emit a label-heavy stream, every label is referenced before it's bound and
+// `count` must be a power of 2.
+static void benchLabels(asmjit::X86Assembler& a, asmjit::Label* labels, uint32_t count) {
+  using namespace asmjit;
+
+  uint32_t i;
+  for (i = 0; i < count; i++)
+    labels[i] = a.newLabel();
+
+  for (i = 0; i < count; i++) {
+    a.cmp(x86::eax, static_cast<int>(i));
+    a.je(labels[i]);
+    a.jb(labels[(i * 7919) & (count - 1)]);
+  }
+
+  for (i = 0; i < count; i++) {
+    a.bind(labels[i]);
+    a.inc(x86::eax);
+  }
+  a.ret();
+}
+
+// Create the same stream as `benchGpForms()` as an array of `InstRecord`s.
+static size_t makeGpRecords(asmjit::InstRecord* records, const asmjit::X86Assembler& a) {
+  using namespace asmjit;
+
+  const X86GpReg& zax = a.zax;
+  const X86GpReg& zcx = a.zcx;
+  const X86GpReg& zdx = a.zdx;
+  const X86GpReg& zsi = a.zsi;
+  const X86GpReg& zdi = a.zdi;
+
+  size_t n = 0;
+  for (uint32_t i = 0; i < 64; i++) {
+    records[n++] = InstRecord(kX86InstIdPush, zsi);
+    records[n++] = InstRecord(kX86InstIdMov , zax, zcx);
+    records[n++] = InstRecord(kX86InstIdMov , x86::ecx, Imm(1234));
+    records[n++] = InstRecord(kX86InstIdMov , zdx, x86::ptr(zsi, 16));
+    records[n++] = InstRecord(kX86InstIdMov , x86::ptr(zdi, zcx, 2, 8), zdx);
+    records[n++] = InstRecord(kX86InstIdAdd , zax, zdx);
+    records[n++] = InstRecord(kX86InstIdAdd , zax, Imm(1));
+    records[n++] = InstRecord(kX86InstIdSub , zcx, Imm(1000));
+    records[n++] = InstRecord(kX86InstIdAnd , x86::eax, Imm(0xFF));
+    records[n++] = InstRecord(kX86InstIdXor , x86::edx, x86::edx);
+    records[n++] = InstRecord(kX86InstIdCmp , zax, x86::ptr(zsi, zcx, 0, -8));
+    records[n++] = InstRecord(kX86InstIdLea , zdi, x86::ptr(zsi, zdx, 3, 64));
+    records[n++] = InstRecord(kX86InstIdTest, zax, zax);
+    records[n++] = InstRecord(kX86InstIdPop , zsi);
+  }
+  records[n++] = InstRecord(kX86InstIdRet);
+  return n;
+}
+#endif
+
 // ============================================================================
 // [Main]
 // ============================================================================
@@ -157,6 +275,475 @@ static void benchX86(uint32_t arch, uint32_t callConv) {
   printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
     "X86Assembler", archName, perf.best, mbps(perf.best, asmOutputSize));
 
+  // --------------------------------------------------------------------------
+  // [Bench - Decoder]
+  // --------------------------------------------------------------------------
+
+  {
+    asmgen::opcode(a);
+
+    size_t codeSize = a.getOffset();
+    uint8_t* code = static_cast<uint8_t*>(::malloc(codeSize));
+
+    if (code != NULL) {
+      ::memcpy(code, a.getBuffer(), codeSize);
+
+      X86Decoder decoder(arch);
+      X86DecodedInst inst;
+      size_t decOutputSize = 0;
+
+      perf.reset();
+      for (r = 0; r < kNumRepeats; r++) {
+        decOutputSize = 0;
+        perf.start();
+        for (i = 0; i < kNumIterations; i++) {
+          size_t offset = 0;
+          while (offset < codeSize) {
+            decoder.decode(inst, code + offset, codeSize - offset);
+            // Skip a single byte if the decoder couldn't consume anything.
+            offset += inst.size != 0 ? inst.size : 1;
+          }
+          decOutputSize += codeSize;
+        }
+        perf.end();
+      }
+
+      printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+        "X86Decoder", archName, perf.best, mbps(perf.best, decOutputSize));
+
+      ::free(code);
+    }
+
+    a.reset();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Bench - GpForms]
+  // --------------------------------------------------------------------------
+
+  perf.reset();
+  for (r = 0; r < kNumRepeats; r++) {
+    asmOutputSize = 0;
+    perf.start();
+    for (i = 0; i < kNumIterations; i++) {
+      benchGpForms(a);
+
+      void *p = a.make();
+      runtime.release(p);
+
+      asmOutputSize += a.getCodeSize();
+      a.reset();
+    }
+    perf.end();
+  }
+
+  printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+    "X86AsmGp", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  // --------------------------------------------------------------------------
+  // [Bench - GpForms (Logging)]
+  // --------------------------------------------------------------------------
+
+  StringLogger textLogger;
+  BinaryLogger binLogger;
+
+  Logger* loggers[2] = { &textLogger, &binLogger };
+  const char* loggerNames[2] = { "X86AsmLog", "X86AsmBinLog" };
+
+  for (uint32_t l = 0; l < 2; l++) {
+    a.setLogger(loggers[l]);
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations; i++) {
+        benchGpForms(a);
+
+        void *p = a.make();
+        runtime.release(p);
+
+        asmOutputSize += a.getCodeSize();
+        a.reset();
+
+        textLogger.clearString();
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      loggerNames[l], archName, perf.best, mbps(perf.best, asmOutputSize));
+  }
+
+  a.setLogger(NULL);
+
+  // --------------------------------------------------------------------------
+  // [Bench - GpForms (Parsing)]
+  // --------------------------------------------------------------------------
+
+  // The speed is the throughput of the parsed text, not of the machine code.
+  textLogger.clearString();
+  a.setLogger(&textLogger);
+  benchGpForms(a);
+  a.setLogger(NULL);
+  a.reset();
+
+  StringBuilder gpText;
+  gpText.setString(textLogger.getString(), textLogger.getLength());
+
+  size_t textSize = 0;
+  X86AsmParser parser(&a);
+
+  perf.reset();
+  for (r = 0; r < kNumRepeats; r++) {
+    textSize = 0;
+    perf.start();
+    for (i = 0; i < kNumIterations; i++) {
+      Error err = parser.parse(gpText.getData(), gpText.getLength());
+      if (err != kErrorOk) {
+        printf("%-12s (%s) | Failed at line %u: %s\n",
+          "X86AsmParser", archName, parser.getErrorLine(), DebugUtils::errorAsString(err));
+        return;
+      }
+
+      void *p = a.make();
+      runtime.release(p);
+
+      textSize += gpText.getLength();
+      a.reset();
+      parser.reset();
+    }
+    perf.end();
+  }
+
+  printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+    "X86AsmParser", archName, perf.best, mbps(perf.best, textSize));
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  // --------------------------------------------------------------------------
+  // [Bench - GpBatch]
+  // --------------------------------------------------------------------------
+
+  InstRecord gpRecords[64 * 14 + 1];
+  size_t gpCount = makeGpRecords(gpRecords, a);
+
+  perf.reset();
+  for (r = 0; r < kNumRepeats; r++) {
+    asmOutputSize = 0;
+    perf.start();
+    for (i = 0; i < kNumIterations; i++) {
+      a.emitBatch(gpRecords, gpCount);
+
+      void *p = a.make();
+      runtime.release(p);
+
+      asmOutputSize += a.getCodeSize();
+      a.reset();
+    }
+    perf.end();
+  }
+
+  printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+    "X86AsmBatch", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+  // --------------------------------------------------------------------------
+  // [Bench - Labels]
+  // --------------------------------------------------------------------------
+
+  // 64K labels per function, 1.6M labels per repeat.
+  const uint32_t kLabelCount = 65536;
+  Label* labels = new Label[kLabelCount];
+
+  perf.reset();
+  for (r = 0; r < kNumRepeats; r++) {
+    asmOutputSize = 0;
+    perf.start();
+    for (i = 0; i < kNumIterations / 200; i++) {
+      benchLabels(a, labels, kLabelCount);
+
+      void *p = a.make();
+      runtime.release(p);
+
+      asmOutputSize += a.getCodeSize();
+      a.reset();
+    }
+    perf.end();
+  }
+
+  printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+    "X86AsmLabels", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+  delete[] labels;
+
+  // --------------------------------------------------------------------------
+  // [Bench - Reloc]
+  // --------------------------------------------------------------------------
+
+  // 100K calls to 16 helpers relocated to an address out of their reach, so
+  // 64-bit code needs trampolines (or GOT entries if position independent).
+  const char* relocNames[2] = { "X86AsmReloc", "X86RelocPic" };
+
+  for (uint32_t pic = 0; pic < 2; pic++) {
+    X86Assembler ra(&runtime, arch);
+    if (pic)
+      ra.addAsmOptions(Assembler::kOptionPositionIndependent);
+
+    for (i = 0; i < 100000; i++)
+      ra.call(Imm(static_cast<int64_t>(0x10000 + (i & 15) * 0x100)));
+
+    size_t relocSize = ra.getCodeSize();
+    uint8_t* relocBuffer = new uint8_t[relocSize];
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < 100; i++) {
+        ra.relocCode(relocBuffer, static_cast<Ptr>(ASMJIT_UINT64_C(0x7FFF00000000)));
+        asmOutputSize += relocSize;
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      relocNames[pic], archName, perf.best, mbps(perf.best, asmOutputSize));
+
+    delete[] relocBuffer;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Bench - Stencil]
+  // --------------------------------------------------------------------------
+
+  // 50K functions of 64 `slot[disp] += imm` (load, add, and store) followed
+  // by `ret`, either assembled or linked from stencils built once.
+  {
+    X86Assembler sa(&runtime, arch);
+    X86StencilBuilder builder(&sa);
+    X86Stencil sAdd, sRet;
+
+    sa.mov(x86::eax, x86::ptr(sa.zdi, 0x7FFFFFF0));
+    builder.addHole(kX86StencilHoleDisp, 0);
+    sa.add(x86::eax, 0x7FFFFFFF);
+    builder.addHole(kX86StencilHoleImm, 1);
+    sa.mov(x86::ptr(sa.zdi, 0x7FFFFFF0), x86::eax);
+    builder.addHole(kX86StencilHoleDisp, 0);
+    builder.branch(kX86InstIdJmp, kX86StencilHoleBlock, 2);
+    builder.finish(sAdd);
+
+    sa.ret();
+    builder.finish(sRet);
+
+    X86Assembler fa(&runtime, arch);
+    X86StencilLinker linker;
+    uint8_t* funcBuffer = new uint8_t[8192];
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations * 10; i++) {
+        for (uint32_t j = 0; j < 64; j++) {
+          fa.mov(x86::eax, x86::ptr(fa.zdi, static_cast<int32_t>(0x1000 + j * 4)));
+          fa.add(x86::eax, static_cast<int>(0x10000 + j));
+          fa.mov(x86::ptr(fa.zdi, static_cast<int32_t>(0x1000 + j * 4)), x86::eax);
+        }
+        fa.ret();
+
+        asmOutputSize += fa.relocCode(funcBuffer);
+        fa.reset();
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      "X86AsmFunc", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations * 10; i++) {
+        for (uint32_t j = 0; j < 64; j++)
+          linker.add(sAdd, 0x1000 + j * 4, 0x10000 + j, j + 1);
+        linker.add(sRet);
+
+        asmOutputSize += linker.relocCode(funcBuffer);
+        linker.reset();
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      "X86Stencil", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+    delete[] funcBuffer;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Bench - Checkpoint]
+  // --------------------------------------------------------------------------
+
+  // 50K functions of 64 speculatively emitted blocks, every other block is
+  // discarded. Blocks are either emitted by a scratch assembler and copied if
+  // kept, or emitted in place and rolled back if discarded.
+  {
+    X86Assembler fa(&runtime, arch);
+    X86Assembler sa(&runtime, arch);
+    uint8_t* funcBuffer = new uint8_t[8192];
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations * 10; i++) {
+        for (uint32_t j = 0; j < 64; j++) {
+          benchGpBlock(sa, j);
+          if ((j & 1) == 0)
+            fa.embed(sa.getBuffer(), static_cast<uint32_t>(sa.getOffset()));
+          sa.reset();
+        }
+        fa.ret();
+
+        asmOutputSize += fa.relocCode(funcBuffer);
+        fa.reset();
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      "X86AsmScratch", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations * 10; i++) {
+        for (uint32_t j = 0; j < 64; j++) {
+          Assembler::Checkpoint cp;
+          fa.checkpoint(cp);
+          benchGpBlock(fa, j);
+          if ((j & 1) == 0)
+            fa.commit(cp);
+          else
+            fa.rollback(cp);
+        }
+        fa.ret();
+
+        asmOutputSize += fa.relocCode(funcBuffer);
+        fa.reset();
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      "X86AsmCkpt", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+    delete[] funcBuffer;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Bench - Thunk]
+  // --------------------------------------------------------------------------
+
+  // 500K thunks, either emitted and copied to the destination or emitted
+  // directly to the destination by using a fixed buffer.
+  {
+    X86Assembler ta(&runtime, arch);
+    uint8_t* thunkBuffer = new uint8_t[256];
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations * 100; i++) {
+        benchThunk(ta, i);
+        asmOutputSize += ta.relocCode(thunkBuffer);
+        ta.reset();
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      "X86AsmThunk", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      asmOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations * 100; i++) {
+        ta.setFixedBuffer(thunkBuffer, 256);
+        benchThunk(ta, i);
+        asmOutputSize += ta.relocCode(thunkBuffer);
+        ta.reset();
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      "X86AsmFixed", archName, perf.best, mbps(perf.best, asmOutputSize));
+
+    delete[] thunkBuffer;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Bench - Pool]
+  // --------------------------------------------------------------------------
+
+  // Compile jobs, each either creates its own assembler and compiler or gets
+  // them from a pool.
+  perf.reset();
+  for (r = 0; r < kNumRepeats; r++) {
+    cmpOutputSize = 0;
+    perf.start();
+    for (i = 0; i < kNumIterations; i++) {
+      X86Assembler ja(&runtime, arch);
+      X86Compiler jc(&ja);
+
+      asmgen::blend(jc);
+      jc.finalize();
+
+      void* p = ja.make();
+      runtime.release(p);
+
+      cmpOutputSize += ja.getCodeSize();
+    }
+    perf.end();
+  }
+
+  printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+    "X86CmpNew", archName, perf.best, mbps(perf.best, cmpOutputSize));
+
+  {
+    X86AsmPool pool(&runtime, arch);
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      cmpOutputSize = 0;
+      perf.start();
+      for (i = 0; i < kNumIterations; i++) {
+        X86AsmPool::Entry* entry = pool.acquire();
+        X86Assembler& ja = entry->assembler;
+        X86Compiler& jc = entry->compiler;
+
+        jc.attach(&ja);
+        asmgen::blend(jc);
+        jc.finalize();
+
+        void* p = ja.make();
+        runtime.release(p);
+
+        cmpOutputSize += ja.getCodeSize();
+        pool.release(entry);
+      }
+      perf.end();
+    }
+
+    printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
+      "X86CmpPool", archName, perf.best, mbps(perf.best, cmpOutputSize));
+  }
+
   // --------------------------------------------------------------------------
   // [Bench - Blend]
   // --------------------------------------------------------------------------
@@ -35,6 +35,257 @@ static const char* archIdToString(uint32_t archId) {
   }
 }
 
+// Assembler that records each emitted instruction so the generated code can
+// be decoded back and compared with what was requested.
+class RecordingAssembler : public asmjit::X86Assembler {
+ public:
+  // Plain data, `PodVector` copies records by memcpy.
+  struct Record {
+    uint32_t code;
+    uint32_t offset;
+    uint32_t size;
+    bool hasLabel;
+    bool hasImm;
+  };
+
+  RecordingAssembler(asmjit::Runtime* runtime, uint32_t arch)
+    : asmjit::X86Assembler(runtime, arch),
+      _depth(0) {}
+
+  virtual asmjit::Error _emit(uint32_t code, const asmjit::Operand& o0, const asmjit::Operand& o1, const asmjit::Operand& o2, const asmjit::Operand& o3) {
+    uint32_t offset = static_cast<uint32_t>(getOffset());
+
+    _depth++;
+    asmjit::Error err = asmjit::X86Assembler::_emit(code, o0, o1, o2, o3);
+    _depth--;
+
+    if (err == asmjit::kErrorOk && _depth == 0 && getOffset() != offset) {
+      Record record;
+      record.code = code;
+      record.offset = offset;
+      record.size = static_cast<uint32_t>(getOffset()) - offset;
+      record.hasLabel = o0.isLabel() || o1.isLabel() || o2.isLabel() || o3.isLabel();
+      record.hasImm = o0.isImm() || o1.isImm() || o2.isImm() || o3.isImm();
+      _records.append(record);
+    }
+    return err;
+  }
+
+  uint32_t _depth;
+  asmjit::PodVector<Record> _records;
+};
+
+// Decode each instruction recorded by `a` and check that the decoded length
+// matches. Instructions that don't use labels or absolute targets are also
+// encoded again from the decoded operands and must produce the same bytes.
+static int checkDecoder(RecordingAssembler& a) {
+  using namespace asmjit;
+
+  X86Decoder decoder(a.getArch());
+  X86DecodedInst inst;
+
+  const uint8_t* code = a.getBuffer();
+  size_t count = a._records.getLength();
+  int failures = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    const RecordingAssembler::Record& record = a._records[i];
+    const X86InstInfo& info = X86Util::getInstInfo(record.code);
+    const char* name = X86Util::getInstNameById(record.code);
+
+    Error err = decoder.decode(inst, code + record.offset, record.size);
+    if (err != kErrorOk || inst.size != record.size) {
+      printf("Decoder failure: %s at 0x%X (error %u, size %u, expected %u)\n",
+        name, record.offset, err, inst.size, record.size);
+      failures++;
+      continue;
+    }
+
+    // Label and absolute targets are resolved by the assembler, so only the
+    // instruction is compared (aliases share their opcode).
+    bool hasTarget = record.hasLabel || (record.hasImm && (info.getEncoding() == kX86InstEncodingX86Call ||
+                                                           info.getEncoding() == kX86InstEncodingX86Jmp));
+
+    if (hasTarget) {
+      const X86InstInfo& decodedInfo = X86Util::getInstInfo(inst.instId);
+      if (inst.instId != record.code && (decodedInfo.getPrimaryOpCode() != info.getPrimaryOpCode() ||
+                                         decodedInfo.getEncoding() != info.getEncoding())) {
+        printf("Decoder mismatch: %s at 0x%X decoded as %s\n", name, record.offset, X86Util::getInstNameById(inst.instId));
+        failures++;
+      }
+      continue;
+    }
+
+    JitRuntime runtime;
+    X86Assembler b(&runtime, a.getArch());
+
+    b.setInstOptions(inst.options);
+    b.emit(inst.instId, inst.operands[0], inst.operands[1], inst.operands[2], inst.operands[3]);
+
+    if (b.getOffset() != record.size || ::memcmp(b.getBuffer(), code + record.offset, record.size) != 0) {
+      char expected[64];
+      char actual[64];
+
+      for (size_t j = 0; j < record.size && j < 31; j++)
+        sprintf(expected + j * 2, "%02X", code[record.offset + j]);
+      expected[Utils::iMin<size_t>(record.size, 31) * 2] = '\0';
+
+      for (size_t j = 0; j < b.getOffset() && j < 31; j++)
+        sprintf(actual + j * 2, "%02X", b.getBuffer()[j]);
+      actual[Utils::iMin<size_t>(b.getOffset(), 31) * 2] = '\0';
+
+      printf("Decoder round-trip mismatch: %s decoded as %s\n  Expected: %s\n  Actual  : %s\n",
+        name, X86Util::getInstNameById(inst.instId), expected, actual);
+      failures++;
+    }
+  }
+
+  return failures;
+}
+
+#if defined(ASMJIT_BUILD_X64)
+// Compare the code emitted by `a` with `expected` hex string.
+static bool checkEncoding(asmjit::X86Assembler& a, const char* text, const char* expected) {
+  char actual[64];
+  size_t size = a.getOffset();
+
+  if (size > 31)
+    size = 31;
+
+  for (size_t i = 0; i < size; i++)
+    sprintf(actual + i * 2, "%02X", a.getBuffer()[i]);
+  actual[size * 2] = '\0';
+
+  if (strcmp(actual, expected) == 0)
+    return true;
+
+  printf("Encoding mismatch: %s\n  Expected: %s\n  Actual  : %s\n", text, expected, actual);
+  return false;
+}
+
+// Check EVEX (AVX-512) encodings byte-for-byte. Expected bytes were produced
+// by GNU AS and cover register extensions (R', V', X), opmask and zeroing,
+// broadcast, static rounding, SAE, and disp8*N compression.
+static int checkEvex() {
+  using namespace asmjit;
+  using namespace asmjit::x86;
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime, kArchX64);
+  int failures = 0;
+
+#define CHECK_ENCODING(INST, EXPECTED) \
+  do { \
+    a.reset(); \
+    a.INST; \
+    failures += !checkEncoding(a, #INST, EXPECTED); \
+  } while (0)
+
+  CHECK_ENCODING(vaddps(zmm0, zmm1, zmm2)                      , "62F1744858C2");
+  CHECK_ENCODING(vaddpd(zmm31, zmm30, zmm29)                   , "62018D4058FD");
+  CHECK_ENCODING(vaddps(ymm16, ymm17, ymm18)                   , "62A1742058C2");
+  CHECK_ENCODING(evex().vaddps(xmm0, xmm1, xmm2)               , "62F1740858C2");
+  CHECK_ENCODING(k(k1).z().vaddps(zmm0, zmm1, zmm2)            , "62F174C958C2");
+  CHECK_ENCODING(vaddps(zmm0, zmm1, ptr(rax, 64))              , "62F17448584001");
+  CHECK_ENCODING(vaddps(zmm0, zmm1, ptr(rax, 128))             , "62F17448584002");
+  CHECK_ENCODING(vaddps(zmm0, zmm1, ptr(rax, 100))             , "62F17448588064000000");
+  CHECK_ENCODING(_1ToN().vaddps(zmm0, zmm1, ptr(rax, 8))       , "62F17458584002");
+  CHECK_ENCODING(_1ToN().vaddpd(zmm0, zmm1, ptr(rax, 8))       , "62F1F558584001");
+  CHECK_ENCODING(rz_sae().vaddps(zmm0, zmm1, zmm2)             , "62F1747858C2");
+  CHECK_ENCODING(rd_sae().vaddsd(xmm0, xmm1, xmm2)             , "62F1F73858C2");
+  CHECK_ENCODING(sae().vminps(zmm0, zmm1, zmm2)                , "62F174185DC2");
+  CHECK_ENCODING(vaddss(xmm16, xmm1, ptr(rax, 8))              , "62E17608584002");
+  CHECK_ENCODING(vaddsd(xmm0, xmm17, ptr(rax, 16))             , "62F1F700584002");
+  CHECK_ENCODING(vsqrtss(xmm1, xmm2, xmm31)                    , "62916E0851CF");
+  CHECK_ENCODING(vmovaps(zmm8, ptr(r9, r10, 2, -128))          , "62117C48284491FE");
+  CHECK_ENCODING(vmovups(ptr(rsp, 256), zmm20)                 , "62E17C4811642404");
+  CHECK_ENCODING(k(k7).vmovupd(ptr(rax), zmm1)                 , "62F1FD4F1108");
+  CHECK_ENCODING(vpaddb(zmm0, zmm1, zmm2)                      , "62F17548FCC2");
+  CHECK_ENCODING(vpaddq(zmm24, zmm25, ptr(r15, 1024))          , "6241B540D44710");
+  CHECK_ENCODING(vpshufb(zmm1, zmm2, ptr(rip, 0))              , "62F26D48000D00000000");
+  CHECK_ENCODING(vxorps(zmm0, zmm0, zmm0)                      , "62F17C4857C0");
+  CHECK_ENCODING(vsqrtpd(zmm1, zmm2)                           , "62F1FD4851CA");
+  CHECK_ENCODING(vcvtdq2ps(zmm1, ptr(rax))                     , "62F17C485B08");
+  CHECK_ENCODING(vbroadcastss(zmm1, xmm2)                      , "62F27D4818CA");
+  CHECK_ENCODING(vbroadcastsd(zmm1, ptr(rax, 8))               , "62F2FD48194801");
+  CHECK_ENCODING(vfmadd231ps(zmm1, zmm2, zmm3)                 , "62F26D48B8CB");
+  CHECK_ENCODING(vfmadd231pd(zmm1, zmm2, zmm3)                 , "62F2ED48B8CB");
+  CHECK_ENCODING(vpdpbusd(zmm1, zmm2, zmm3)                   , "62F26D4850CB");
+  CHECK_ENCODING(k(k1).z()._1ToN().vpdpbusds(zmm1, zmm2, ptr(rax)), "62F26DD95108");
+  CHECK_ENCODING(vpdpwssd(xmm17, xmm2, xmm3)                  , "62E26D0852CB");
+  CHECK_ENCODING(vpdpwssd(zmm1, zmm2, ptr(rax, 128))          , "62F26D48524802");
+  CHECK_ENCODING(vdpbf16ps(xmm1, xmm2, xmm3)                  , "62F26E0852CB");
+  CHECK_ENCODING(vdpbf16ps(zmm1, zmm2, zmm3)                  , "62F26E4852CB");
+  CHECK_ENCODING(vcvtne2ps2bf16(ymm1, ymm2, ymm3)             , "62F26F2872CB");
+  CHECK_ENCODING(vcvtneps2bf16(xmm1, xmm2)                    , "62F27E0872CA");
+  CHECK_ENCODING(vcvtneps2bf16(xmm1, ymm2)                    , "62F27E2872CA");
+  CHECK_ENCODING(vcvtneps2bf16(ymm1, zmm2)                    , "62F27E4872CA");
+  CHECK_ENCODING(vcvtneps2bf16(ymm1, zword_ptr(rax))          , "62F27E487208");
+  CHECK_ENCODING(vcvtneps2bf16(xmm1, yword_ptr(rax))          , "62F27E287208");
+
+  // VEX is still used if no AVX-512 feature is required.
+  CHECK_ENCODING(vfmadd213sd(xmm1, xmm2, ptr(rax, 8))          , "C4E2E9A94808");
+  CHECK_ENCODING(vaddps(ymm0, ymm1, ymm2)                      , "C5F458C2");
+  CHECK_ENCODING(vpdpbusd(xmm1, xmm2, xmm3)                   , "C4E26950CB");
+  CHECK_ENCODING(vpdpbusd(ymm1, ymm2, ptr(rax))               , "C4E26D5008");
+  CHECK_ENCODING(vpdpwssds(xmm9, xmm10, xmm11)                , "C4422953CB");
+
+#undef CHECK_ENCODING
+
+  printf("EVEX encodings [%s]\n", failures ? "FAILED" : "OK");
+  return failures;
+}
+
+// Check APX encodings byte-for-byte, they don't require APX hardware. Expected
+// bytes follow the REX2 and extended EVEX layouts of the APX specification.
+static int checkApx() {
+  using namespace asmjit;
+  using namespace asmjit::x86;
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime, kArchX64);
+  int failures = 0;
+
+#define CHECK_ENCODING(INST, EXPECTED) \
+  do { \
+    a.reset(); \
+    a.INST; \
+    failures += !checkEncoding(a, #INST, EXPECTED); \
+  } while (0)
+
+  // REX2 - R16..R31 in ModR/M, SIB, and opcode, `0F` map is a part of REX2.
+  CHECK_ENCODING(mov(r16, rax)                                , "D5488BC0");
+  CHECK_ENCODING(mov(rax, r31)                                , "D5198BC7");
+  CHECK_ENCODING(add(r17d, r18d)                              , "D55003CA");
+  CHECK_ENCODING(mov(r20, ptr(r21, r22, 1, 8))                , "D5788B647508");
+  CHECK_ENCODING(mov(ptr(r24), rax)                           , "D5198900");
+  CHECK_ENCODING(push(r16)                                    , "D51050");
+  CHECK_ENCODING(movzx(r16d, byte_ptr(rax))                   , "D5C0B600");
+  CHECK_ENCODING(rex2().mov(eax, ecx)                         , "D5008BC1");
+
+  // EVEX - R16..R31 base and index of AVX-512 memory operands (B4 and X4).
+  CHECK_ENCODING(vaddps(zmm0, zmm1, ptr(r16))                 , "62F974485800");
+  CHECK_ENCODING(vaddps(zmm0, zmm1, ptr(rax, r17))            , "62F17048580408");
+  CHECK_ENCODING(vaddps(xmm0, xmm1, ptr(r16))                 , "62F974085800");
+
+  // EVEX map 4 - NDD and NF forms.
+  CHECK_ENCODING(add(r10, r11, r12)                           , "6254AC1803DC");
+  CHECK_ENCODING(add(r16, rax, ptr(rbx))                      , "62F4FC100303");
+  CHECK_ENCODING(add(rax, ptr(rbx), rcx)                      , "62F4FC18010B");
+  CHECK_ENCODING(sub(rax, r16, 5)                             , "62FCFC1883E805");
+  CHECK_ENCODING(and_(ecx, edx, 0x12345678)                   , "62F4741881E278563412");
+  CHECK_ENCODING(xor_(r16w, r17w, r18w)                       , "62EC7D1033CA");
+  CHECK_ENCODING(nf().add(rax, rbx)                           , "62F4FC0C03C3");
+  CHECK_ENCODING(nf().add(r8, r9)                             , "6254FC0C03C1");
+  CHECK_ENCODING(nf().sub(qword_ptr(r20, 8), 1)               , "62FCFC0C836C240801");
+
+#undef CHECK_ENCODING
+
+  printf("APX encodings [%s]\n", failures ? "FAILED" : "OK");
+  return failures;
+}
+#endif // ASMJIT_BUILD_X64
+
 int main(int argc, char* argv[]) {
   asmjit::FileLogger logger(stdout);
   logger.addOptions(asmjit::Logger::kOptionBinaryForm);
@@ -51,6 +302,8 @@ int main(int argc, char* argv[]) {
 # endif // ASMJIT_BUILD_X64
   };
 
+  int decoderFailures = 0;
+
   for (int i = 0; i < ASMJIT_ARRAY_SIZE(infoList); i++) {
     const OpcodeDumpInfo& info = infoList[i];
 
@@ -60,10 +313,12 @@ int main(int argc, char* argv[]) {
       info.useRex2 ? "true" : "false");
 
     asmjit::JitRuntime runtime;
-    asmjit::X86Assembler a(&runtime, info.arch);
+    RecordingAssembler a(&runtime, info.arch);
     a.setLogger(&logger);
 
     asmgen::opcode(a, info.useRex1, info.useRex2);
+    decoderFailures += checkDecoder(a);
+
     VoidFunc p = asmjit_cast<VoidFunc>(a.make());
 
     // Only run if disassembly makes sense.
@@ -73,5 +328,14 @@ int main(int argc, char* argv[]) {
     runtime.release((void*)p);
   }
 
+  printf("Decoder round-trip [%s]\n", decoderFailures ? "FAILED" : "OK");
+  if (decoderFailures != 0)
+    return 1;
+
+#if defined(ASMJIT_BUILD_X64)
+  if ((checkEvex() | checkApx()) != 0)
+    return 1;
+#endif // ASMJIT_BUILD_X64
+
   return 0;
 }
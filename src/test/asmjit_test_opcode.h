@@ -59,6 +59,10 @@ static void opcode(asmjit::X86Assembler& a, bool useRex1 = false, bool useRex2 =
   X86YmmReg ymmC = useRex2 ? ymm10 : ymm2;
   X86YmmReg ymmD = useRex2 ? ymm11 : ymm3;
 
+  X86ZmmReg zmmA = useRex1 ? zmm8  : zmm0;
+  X86ZmmReg zmmB = useRex2 ? zmm9  : zmm1;
+  X86ZmmReg zmmC = useRex2 ? zmm10 : zmm2;
+
   X86Mem anyptr_gpA = ptr(gzA);
   X86Mem anyptr_gpB = ptr(gzB);
   X86Mem anyptr_gpC = ptr(gzC);
@@ -3009,6 +3013,60 @@ static void opcode(asmjit::X86Assembler& a, bool useRex1 = false, bool useRex2 =
   a.vcvtps2ph(xmmA, ymmB, 0);
   a.vcvtps2ph(anyptr_gpA, ymmB, 0);
 
+  // AVX512.
+  a.nop();
+
+  a.vaddpd(zmmA, zmmB, zmmC);
+  a.vaddpd(zmmA, zmmB, anyptr_gpC);
+  a.vaddps(zmmA, zmmB, zmmC);
+  a.vaddps(zmmA, zmmB, anyptr_gpC);
+  a.k(k1).vaddps(zmmA, zmmB, zmmC);
+  a.k(k2).z().vaddps(zmmA, zmmB, anyptr_gpC);
+  a._1ToN().vaddps(zmmA, zmmB, anyptr_gpC);
+  a.rn_sae().vaddps(zmmA, zmmB, zmmC);
+  a.rz_sae().vaddss(xmmA, xmmB, xmmC);
+  a.evex().vaddss(xmmA, xmmB, anyptr_gpC);
+  a.vbroadcastsd(zmmA, xmmB);
+  a.vbroadcastsd(zmmA, anyptr_gpB);
+  a.vbroadcastss(zmmA, xmmB);
+  a.vbroadcastss(zmmA, anyptr_gpB);
+  a.vcvtdq2ps(zmmA, zmmB);
+  a.vcvtdq2ps(zmmA, anyptr_gpB);
+  a.sae().vcvttps2dq(zmmA, zmmB);
+  a.vfmadd231pd(zmmA, zmmB, zmmC);
+  a.vfmadd231ps(zmmA, zmmB, anyptr_gpC);
+  a.sae().vmaxps(zmmA, zmmB, zmmC);
+  a.vminpd(zmmA, zmmB, anyptr_gpC);
+  a.vmovapd(zmmA, zmmB);
+  a.vmovaps(zmmA, anyptr_gpB);
+  a.vmovupd(anyptr_gpA, zmmB);
+  a.k(k3).vmovups(anyptr_gpA, zmmB);
+  a.vpaddb(zmmA, zmmB, zmmC);
+  a.vpaddd(zmmA, zmmB, anyptr_gpC);
+  a.vpaddq(zmmA, zmmB, zmmC);
+  a.vpmulld(zmmA, zmmB, zmmC);
+  a.vpshufb(zmmA, zmmB, anyptr_gpC);
+  a.vpsubw(zmmA, zmmB, zmmC);
+  a.vsqrtpd(zmmA, zmmB);
+  a.vsqrtps(zmmA, anyptr_gpB);
+  a.vunpcklps(zmmA, zmmB, zmmC);
+  a.vxorpd(zmmA, zmmB, zmmC);
+  a._1ToN().vxorps(zmmA, zmmB, anyptr_gpC);
+
+  // AVX_VNNI / AVX512_VNNI.
+  a.vpdpbusd(xmmA, xmmB, xmmC);
+  a.vpdpbusd(ymmA, ymmB, anyptr_gpC);
+  a.vpdpbusds(zmmA, zmmB, zmmC);
+  a.vpdpwssd(zmmA, zmmB, anyptr_gpC);
+  a.k(k1).vpdpwssds(zmmA, zmmB, zmmC);
+
+  // AVX512_BF16.
+  a.vcvtne2ps2bf16(zmmA, zmmB, zmmC);
+  a.vcvtneps2bf16(xmmA, ymmB);
+  a.vcvtneps2bf16(ymmA, zmmB);
+  a.vdpbf16ps(ymmA, ymmB, anyptr_gpC);
+  a._1ToN().vdpbf16ps(zmmA, zmmB, anyptr_gpC);
+
   // Mark the end of the stream.
   a.nop();
 }
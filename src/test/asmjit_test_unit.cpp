@@ -134,7 +134,11 @@ static void dumpCpu(void) {
     { asmjit::CpuInfo::kX86FeatureAVX512BW      , "AVX512BW"              },
     { asmjit::CpuInfo::kX86FeatureAVX512VL      , "AVX512VL"              },
     { asmjit::CpuInfo::kX86FeatureAVX512IFMA    , "AVX512IFMA"            },
-    { asmjit::CpuInfo::kX86FeatureAVX512VBMI    , "AVX512VBMI"            }
+    { asmjit::CpuInfo::kX86FeatureAVX512VBMI    , "AVX512VBMI"            },
+    { asmjit::CpuInfo::kX86FeatureAVX512VNNI    , "AVX512VNNI"            },
+    { asmjit::CpuInfo::kX86FeatureAVX512BF16    , "AVX512BF16"            },
+    { asmjit::CpuInfo::kX86FeatureAVX_VNNI      , "AVX_VNNI"              },
+    { asmjit::CpuInfo::kX86FeatureAPX_F         , "APX_F"                 }
   };
 
   INFO("X86 Specific:");
@@ -177,7 +181,8 @@ static void dumpSizeOf(void) {
   INFO("SizeOf Base:");
   DUMP_TYPE(asmjit::Assembler);
   DUMP_TYPE(asmjit::ConstPool);
-  DUMP_TYPE(asmjit::LabelData);
+  DUMP_TYPE(asmjit::LabelExData);
+  DUMP_TYPE(asmjit::LabelLink);
   DUMP_TYPE(asmjit::RelocData);
   DUMP_TYPE(asmjit::Runtime);
   DUMP_TYPE(asmjit::Zone);
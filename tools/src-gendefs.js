@@ -173,7 +173,6 @@ class Database {
     this.instArray = [];
 
     this.instNames = new IndexedString();
-    this.instAlpha = new Array(26);
 
     this.extendedData = [];
     this.extendedMap = {};
@@ -198,7 +197,6 @@ class Database {
   index() {
     const instMap = this.instMap;
     const instNames = this.instNames;
-    const instAlpha = this.instAlpha;
 
     var extendedData = this.extendedData;
     var extendedMap = this.extendedMap;
@@ -219,13 +217,6 @@ class Database {
 
       inst.nameIndex = nameIndex;
       inst.extendedIndex = extendedIndex;
-
-      var aIndex = name.charCodeAt(0) - 'a'.charCodeAt(0);
-      if (aIndex < 0 || aIndex >= 26)
-        throw new Error("Alphabetical index error");
-
-      if (instAlpha[aIndex] === undefined)
-        instAlpha[aIndex] = inst.enum;
     }
   }
 
@@ -266,6 +257,111 @@ class Database {
   }
 }
 
+// ----------------------------------------------------------------------------
+// [NameHash]
+// ----------------------------------------------------------------------------
+
+// Perfect hash of instruction names (hash and displace). The name hash selects
+// a bucket (high bits) and a slot (low bits), the slot is then displaced by a
+// per-bucket value so all names end up in distinct slots. The hash function
+// must match `X86Util_hashInstName()` in "x86inst.cpp".
+const kHashBucketsLog2 = 9;
+const kHashSizeLog2 = 11;
+
+function hashName(name, seed) {
+  var h = (seed ^ 0x811C9DC5) >>> 0;
+  for (var i = 0; i < name.length; i++)
+    h = Math.imul(h ^ name.charCodeAt(i), 0x01000193) >>> 0;
+  return h;
+}
+
+function generateNameHash(instArray) {
+  const bucketCount = 1 << kHashBucketsLog2;
+  const hashSize = 1 << kHashSizeLog2;
+  const shift = 32 - kHashBucketsLog2;
+
+  for (var seed = 0; seed < 0x10000; seed++) {
+    var buckets = [];
+    var i, j;
+
+    for (i = 0; i < bucketCount; i++)
+      buckets.push([]);
+
+    for (i = 0; i < instArray.length; i++) {
+      const inst = instArray[i];
+      if (!inst.name)
+        continue;
+
+      const h = hashName(inst.name, seed);
+      buckets[h >>> shift].push({ id: inst.id, h: h });
+    }
+
+    // Place the biggest buckets first.
+    var order = [];
+    for (i = 0; i < bucketCount; i++)
+      order.push(i);
+    order.sort(function(a, b) { return buckets[b].length - buckets[a].length || a - b; });
+
+    var disp = new Array(bucketCount).fill(0);
+    var table = new Array(hashSize).fill(0);
+    var ok = true;
+
+    for (i = 0; i < bucketCount && ok; i++) {
+      const bucket = buckets[order[i]];
+      if (!bucket.length)
+        break;
+
+      var d;
+      for (d = 0; d < hashSize; d++) {
+        var slots = [];
+        for (j = 0; j < bucket.length; j++) {
+          const slot = ((bucket[j].h ^ d) & (hashSize - 1)) >>> 0;
+          if (table[slot] !== 0 || slots.indexOf(slot) !== -1)
+            break;
+          slots.push(slot);
+        }
+
+        if (j === bucket.length) {
+          for (j = 0; j < bucket.length; j++)
+            table[slots[j]] = bucket[j].id;
+          disp[order[i]] = d;
+          break;
+        }
+      }
+
+      if (d === hashSize)
+        ok = false;
+    }
+
+    if (ok)
+      return { seed: seed, disp: disp, table: table };
+  }
+
+  throw new Error("NameHash - couldn't find a perfect hash");
+}
+
+function formatNumbers(array, indent, justify) {
+  var s = "";
+  var line = "";
+
+  for (var i = 0; i < array.length; i++) {
+    const item = String(array[i]) + ((i !== array.length - 1) ? "," : "");
+    const newl = line + (line ? " " : indent) + item;
+
+    if (newl.length <= justify) {
+      line = newl;
+      continue;
+    }
+    else {
+      s += line + "\n";
+      line = indent + item;
+    }
+  }
+
+  s += line + "\n";
+  return s;
+}
+
 // ----------------------------------------------------------------------------
 // [Generate]
 // ----------------------------------------------------------------------------
@@ -380,24 +476,24 @@ function generate(fileName, arch) {
   code += `};\n`;
   code += `\n`;
 
-  // Generate AlphaIndex.
-  code += `enum ${Arch}InstAlphaIndex {\n`;
-  code += `  k${Arch}InstAlphaIndexFirst = 'a',\n`;
-  code += `  k${Arch}InstAlphaIndexLast = 'z',\n`;
-  code += `  k${Arch}InstAlphaIndexInvalid = 0xFFFF\n`;
+  // Generate NameHash.
+  const nameHash = generateNameHash(db.instArray);
+
+  code += `enum ${Arch}InstHash {\n`;
+  code += `  k${Arch}InstHashSeed = ${nameHash.seed},\n`;
+  code += `  k${Arch}InstHashSize = ${1 << kHashSizeLog2},\n`;
+  code += `  k${Arch}InstHashBucketShift = ${32 - kHashBucketsLog2}\n`;
   code += `};\n`;
   code += `\n`;
 
-  code += `static const uint16_t _${arch}InstAlphaIndex[26] = {\n`;
-  for (i = 0; i < db.instAlpha.length; i++) {
-    var id = db.instAlpha[i];
-    code += kIndent + (id === undefined ? "0xFFFF" : id);
-    if (i !== db.instAlpha.length - 1)
-      code += `,`;
-    code += `\n`;
-  }
+  code += `static const uint16_t _${arch}InstHashDisp[${1 << kHashBucketsLog2}] = {\n`;
+  code += formatNumbers(nameHash.disp, kIndent, kJustify);
   code += `};\n`;
+  code += `\n`;
 
+  code += `static const uint16_t _${arch}InstHashTable[${1 << kHashSizeLog2}] = {\n`;
+  code += formatNumbers(nameHash.table, kIndent, kJustify);
+  code += `};\n`;
   code += `#endif // !ASMJIT_DISABLE_NAMES\n`;
   code += kDisclaimerEnd;
   code += `\n`;